@@ -51,17 +51,17 @@ OBJECTDIR=build/${CND_CONF}/${IMAGE_TYPE}
 DISTDIR=dist/${CND_CONF}/${IMAGE_TYPE}
 
 # Source Files Quoted if spaced
-SOURCEFILES_QUOTED_IF_SPACED=../src/config/sam_e51_cnano/peripheral/can/plib_can1.c ../src/config/sam_e51_cnano/peripheral/clock/plib_clock.c ../src/config/sam_e51_cnano/peripheral/cmcc/plib_cmcc.c ../src/config/sam_e51_cnano/peripheral/dmac/plib_dmac.c ../src/config/sam_e51_cnano/peripheral/eic/plib_eic.c ../src/config/sam_e51_cnano/peripheral/evsys/plib_evsys.c ../src/config/sam_e51_cnano/peripheral/nvic/plib_nvic.c ../src/config/sam_e51_cnano/peripheral/nvmctrl/plib_nvmctrl.c ../src/config/sam_e51_cnano/peripheral/port/plib_port.c ../src/config/sam_e51_cnano/peripheral/rtc/plib_rtc_timer.c ../src/config/sam_e51_cnano/peripheral/sercom/usart/plib_sercom5_usart.c ../src/config/sam_e51_cnano/peripheral/sercom/usart/plib_sercom0_usart.c ../src/config/sam_e51_cnano/stdio/xc32_monitor.c ../src/config/sam_e51_cnano/startup_xc32.c ../src/config/sam_e51_cnano/initialization.c ../src/config/sam_e51_cnano/exceptions.c ../src/config/sam_e51_cnano/libc_syscalls.c ../src/config/sam_e51_cnano/interrupts.c ../src/main_sam_e51_cnano.c
+SOURCEFILES_QUOTED_IF_SPACED=../src/config/sam_e51_cnano/peripheral/can/plib_can1.c ../src/config/sam_e51_cnano/peripheral/clock/plib_clock.c ../src/config/sam_e51_cnano/peripheral/cmcc/plib_cmcc.c ../src/config/sam_e51_cnano/peripheral/dmac/plib_dmac.c ../src/config/sam_e51_cnano/peripheral/eic/plib_eic.c ../src/config/sam_e51_cnano/peripheral/evsys/plib_evsys.c ../src/config/sam_e51_cnano/peripheral/nvic/plib_nvic.c ../src/config/sam_e51_cnano/peripheral/nvmctrl/plib_nvmctrl.c ../src/config/sam_e51_cnano/peripheral/port/plib_port.c ../src/config/sam_e51_cnano/peripheral/rtc/plib_rtc_timer.c ../src/config/sam_e51_cnano/peripheral/sercom/usart/plib_sercom5_usart.c ../src/config/sam_e51_cnano/peripheral/sercom/usart/plib_sercom0_usart.c ../src/config/sam_e51_cnano/stdio/xc32_monitor.c ../src/config/sam_e51_cnano/startup_xc32.c ../src/config/sam_e51_cnano/initialization.c ../src/config/sam_e51_cnano/exceptions.c ../src/config/sam_e51_cnano/libc_syscalls.c ../src/config/sam_e51_cnano/interrupts.c ../src/main_sam_e51_cnano.c ../src/app_can_ring.c ../src/app_can_record.c ../src/app_uart_queue.c ../src/app_can_format.c ../src/app_can_change.c ../src/app_can_stats.c ../src/app_can_load.c ../src/app_can_filter.c ../src/app_can_idfilter.c ../src/app_can_trigger.c ../src/app_can_flashlog.c ../src/app_can_bitrate.c ../src/app_can_config.c ../src/app_fw_update.c ../src/config/sam_e51_cnano/peripheral/tc/plib_tc0.c ../src/app_can_replay.c ../src/app_can_txevent.c ../src/config/sam_e51_cnano/peripheral/tc/plib_tc1.c ../src/app_can_cyclic.c
 
 # Object Files Quoted if spaced
-OBJECTFILES_QUOTED_IF_SPACED=${OBJECTDIR}/_ext/1220117510/plib_can1.o ${OBJECTDIR}/_ext/7187140/plib_clock.o ${OBJECTDIR}/_ext/831051564/plib_cmcc.o ${OBJECTDIR}/_ext/831021835/plib_dmac.o ${OBJECTDIR}/_ext/1220119669/plib_eic.o ${OBJECTDIR}/_ext/9336626/plib_evsys.o ${OBJECTDIR}/_ext/830715028/plib_nvic.o ${OBJECTDIR}/_ext/226030394/plib_nvmctrl.o ${OBJECTDIR}/_ext/830661877/plib_port.o ${OBJECTDIR}/_ext/1220132503/plib_rtc_timer.o ${OBJECTDIR}/_ext/314480351/plib_sercom5_usart.o ${OBJECTDIR}/_ext/314480351/plib_sercom0_usart.o ${OBJECTDIR}/_ext/865175840/xc32_monitor.o ${OBJECTDIR}/_ext/570918426/startup_xc32.o ${OBJECTDIR}/_ext/570918426/initialization.o ${OBJECTDIR}/_ext/570918426/exceptions.o ${OBJECTDIR}/_ext/570918426/libc_syscalls.o ${OBJECTDIR}/_ext/570918426/interrupts.o ${OBJECTDIR}/_ext/1360937237/main_sam_e51_cnano.o
-POSSIBLE_DEPFILES=${OBJECTDIR}/_ext/1220117510/plib_can1.o.d ${OBJECTDIR}/_ext/7187140/plib_clock.o.d ${OBJECTDIR}/_ext/831051564/plib_cmcc.o.d ${OBJECTDIR}/_ext/831021835/plib_dmac.o.d ${OBJECTDIR}/_ext/1220119669/plib_eic.o.d ${OBJECTDIR}/_ext/9336626/plib_evsys.o.d ${OBJECTDIR}/_ext/830715028/plib_nvic.o.d ${OBJECTDIR}/_ext/226030394/plib_nvmctrl.o.d ${OBJECTDIR}/_ext/830661877/plib_port.o.d ${OBJECTDIR}/_ext/1220132503/plib_rtc_timer.o.d ${OBJECTDIR}/_ext/314480351/plib_sercom5_usart.o.d ${OBJECTDIR}/_ext/314480351/plib_sercom0_usart.o.d ${OBJECTDIR}/_ext/865175840/xc32_monitor.o.d ${OBJECTDIR}/_ext/570918426/startup_xc32.o.d ${OBJECTDIR}/_ext/570918426/initialization.o.d ${OBJECTDIR}/_ext/570918426/exceptions.o.d ${OBJECTDIR}/_ext/570918426/libc_syscalls.o.d ${OBJECTDIR}/_ext/570918426/interrupts.o.d ${OBJECTDIR}/_ext/1360937237/main_sam_e51_cnano.o.d
+OBJECTFILES_QUOTED_IF_SPACED=${OBJECTDIR}/_ext/1220117510/plib_can1.o ${OBJECTDIR}/_ext/7187140/plib_clock.o ${OBJECTDIR}/_ext/831051564/plib_cmcc.o ${OBJECTDIR}/_ext/831021835/plib_dmac.o ${OBJECTDIR}/_ext/1220119669/plib_eic.o ${OBJECTDIR}/_ext/9336626/plib_evsys.o ${OBJECTDIR}/_ext/830715028/plib_nvic.o ${OBJECTDIR}/_ext/226030394/plib_nvmctrl.o ${OBJECTDIR}/_ext/830661877/plib_port.o ${OBJECTDIR}/_ext/1220132503/plib_rtc_timer.o ${OBJECTDIR}/_ext/314480351/plib_sercom5_usart.o ${OBJECTDIR}/_ext/314480351/plib_sercom0_usart.o ${OBJECTDIR}/_ext/865175840/xc32_monitor.o ${OBJECTDIR}/_ext/570918426/startup_xc32.o ${OBJECTDIR}/_ext/570918426/initialization.o ${OBJECTDIR}/_ext/570918426/exceptions.o ${OBJECTDIR}/_ext/570918426/libc_syscalls.o ${OBJECTDIR}/_ext/570918426/interrupts.o ${OBJECTDIR}/_ext/1360937237/main_sam_e51_cnano.o ${OBJECTDIR}/_ext/1360937237/app_can_ring.o ${OBJECTDIR}/_ext/1360937237/app_can_record.o ${OBJECTDIR}/_ext/1360937237/app_uart_queue.o ${OBJECTDIR}/_ext/1360937237/app_can_format.o ${OBJECTDIR}/_ext/1360937237/app_can_change.o ${OBJECTDIR}/_ext/1360937237/app_can_stats.o ${OBJECTDIR}/_ext/1360937237/app_can_load.o ${OBJECTDIR}/_ext/1360937237/app_can_filter.o ${OBJECTDIR}/_ext/1360937237/app_can_idfilter.o ${OBJECTDIR}/_ext/1360937237/app_can_trigger.o ${OBJECTDIR}/_ext/1360937237/app_can_flashlog.o ${OBJECTDIR}/_ext/1360937237/app_can_bitrate.o ${OBJECTDIR}/_ext/1360937237/app_can_config.o ${OBJECTDIR}/_ext/1360937237/app_fw_update.o ${OBJECTDIR}/_ext/1900303495/plib_tc0.o ${OBJECTDIR}/_ext/1360937237/app_can_replay.o ${OBJECTDIR}/_ext/1360937237/app_can_txevent.o ${OBJECTDIR}/_ext/1900303495/plib_tc1.o ${OBJECTDIR}/_ext/1360937237/app_can_cyclic.o
+POSSIBLE_DEPFILES=${OBJECTDIR}/_ext/1220117510/plib_can1.o.d ${OBJECTDIR}/_ext/7187140/plib_clock.o.d ${OBJECTDIR}/_ext/831051564/plib_cmcc.o.d ${OBJECTDIR}/_ext/831021835/plib_dmac.o.d ${OBJECTDIR}/_ext/1220119669/plib_eic.o.d ${OBJECTDIR}/_ext/9336626/plib_evsys.o.d ${OBJECTDIR}/_ext/830715028/plib_nvic.o.d ${OBJECTDIR}/_ext/226030394/plib_nvmctrl.o.d ${OBJECTDIR}/_ext/830661877/plib_port.o.d ${OBJECTDIR}/_ext/1220132503/plib_rtc_timer.o.d ${OBJECTDIR}/_ext/314480351/plib_sercom5_usart.o.d ${OBJECTDIR}/_ext/314480351/plib_sercom0_usart.o.d ${OBJECTDIR}/_ext/865175840/xc32_monitor.o.d ${OBJECTDIR}/_ext/570918426/startup_xc32.o.d ${OBJECTDIR}/_ext/570918426/initialization.o.d ${OBJECTDIR}/_ext/570918426/exceptions.o.d ${OBJECTDIR}/_ext/570918426/libc_syscalls.o.d ${OBJECTDIR}/_ext/570918426/interrupts.o.d ${OBJECTDIR}/_ext/1360937237/main_sam_e51_cnano.o.d ${OBJECTDIR}/_ext/1360937237/app_can_ring.o.d ${OBJECTDIR}/_ext/1360937237/app_can_record.o.d ${OBJECTDIR}/_ext/1360937237/app_uart_queue.o.d ${OBJECTDIR}/_ext/1360937237/app_can_format.o.d ${OBJECTDIR}/_ext/1360937237/app_can_change.o.d ${OBJECTDIR}/_ext/1360937237/app_can_stats.o.d ${OBJECTDIR}/_ext/1360937237/app_can_load.o.d ${OBJECTDIR}/_ext/1360937237/app_can_filter.o.d ${OBJECTDIR}/_ext/1360937237/app_can_idfilter.o.d ${OBJECTDIR}/_ext/1360937237/app_can_trigger.o.d ${OBJECTDIR}/_ext/1360937237/app_can_flashlog.o.d ${OBJECTDIR}/_ext/1360937237/app_can_bitrate.o.d ${OBJECTDIR}/_ext/1360937237/app_can_config.o.d ${OBJECTDIR}/_ext/1360937237/app_fw_update.o.d ${OBJECTDIR}/_ext/1900303495/plib_tc0.o.d ${OBJECTDIR}/_ext/1360937237/app_can_replay.o.d ${OBJECTDIR}/_ext/1360937237/app_can_txevent.o.d ${OBJECTDIR}/_ext/1900303495/plib_tc1.o.d ${OBJECTDIR}/_ext/1360937237/app_can_cyclic.o.d
 
 # Object Files
-OBJECTFILES=${OBJECTDIR}/_ext/1220117510/plib_can1.o ${OBJECTDIR}/_ext/7187140/plib_clock.o ${OBJECTDIR}/_ext/831051564/plib_cmcc.o ${OBJECTDIR}/_ext/831021835/plib_dmac.o ${OBJECTDIR}/_ext/1220119669/plib_eic.o ${OBJECTDIR}/_ext/9336626/plib_evsys.o ${OBJECTDIR}/_ext/830715028/plib_nvic.o ${OBJECTDIR}/_ext/226030394/plib_nvmctrl.o ${OBJECTDIR}/_ext/830661877/plib_port.o ${OBJECTDIR}/_ext/1220132503/plib_rtc_timer.o ${OBJECTDIR}/_ext/314480351/plib_sercom5_usart.o ${OBJECTDIR}/_ext/314480351/plib_sercom0_usart.o ${OBJECTDIR}/_ext/865175840/xc32_monitor.o ${OBJECTDIR}/_ext/570918426/startup_xc32.o ${OBJECTDIR}/_ext/570918426/initialization.o ${OBJECTDIR}/_ext/570918426/exceptions.o ${OBJECTDIR}/_ext/570918426/libc_syscalls.o ${OBJECTDIR}/_ext/570918426/interrupts.o ${OBJECTDIR}/_ext/1360937237/main_sam_e51_cnano.o
+OBJECTFILES=${OBJECTDIR}/_ext/1220117510/plib_can1.o ${OBJECTDIR}/_ext/7187140/plib_clock.o ${OBJECTDIR}/_ext/831051564/plib_cmcc.o ${OBJECTDIR}/_ext/831021835/plib_dmac.o ${OBJECTDIR}/_ext/1220119669/plib_eic.o ${OBJECTDIR}/_ext/9336626/plib_evsys.o ${OBJECTDIR}/_ext/830715028/plib_nvic.o ${OBJECTDIR}/_ext/226030394/plib_nvmctrl.o ${OBJECTDIR}/_ext/830661877/plib_port.o ${OBJECTDIR}/_ext/1220132503/plib_rtc_timer.o ${OBJECTDIR}/_ext/314480351/plib_sercom5_usart.o ${OBJECTDIR}/_ext/314480351/plib_sercom0_usart.o ${OBJECTDIR}/_ext/865175840/xc32_monitor.o ${OBJECTDIR}/_ext/570918426/startup_xc32.o ${OBJECTDIR}/_ext/570918426/initialization.o ${OBJECTDIR}/_ext/570918426/exceptions.o ${OBJECTDIR}/_ext/570918426/libc_syscalls.o ${OBJECTDIR}/_ext/570918426/interrupts.o ${OBJECTDIR}/_ext/1360937237/main_sam_e51_cnano.o ${OBJECTDIR}/_ext/1360937237/app_can_ring.o ${OBJECTDIR}/_ext/1360937237/app_can_record.o ${OBJECTDIR}/_ext/1360937237/app_uart_queue.o ${OBJECTDIR}/_ext/1360937237/app_can_format.o ${OBJECTDIR}/_ext/1360937237/app_can_change.o ${OBJECTDIR}/_ext/1360937237/app_can_stats.o ${OBJECTDIR}/_ext/1360937237/app_can_load.o ${OBJECTDIR}/_ext/1360937237/app_can_filter.o ${OBJECTDIR}/_ext/1360937237/app_can_idfilter.o ${OBJECTDIR}/_ext/1360937237/app_can_trigger.o ${OBJECTDIR}/_ext/1360937237/app_can_flashlog.o ${OBJECTDIR}/_ext/1360937237/app_can_bitrate.o ${OBJECTDIR}/_ext/1360937237/app_can_config.o ${OBJECTDIR}/_ext/1360937237/app_fw_update.o ${OBJECTDIR}/_ext/1900303495/plib_tc0.o ${OBJECTDIR}/_ext/1360937237/app_can_replay.o ${OBJECTDIR}/_ext/1360937237/app_can_txevent.o ${OBJECTDIR}/_ext/1900303495/plib_tc1.o ${OBJECTDIR}/_ext/1360937237/app_can_cyclic.o
 
 # Source Files
-SOURCEFILES=../src/config/sam_e51_cnano/peripheral/can/plib_can1.c ../src/config/sam_e51_cnano/peripheral/clock/plib_clock.c ../src/config/sam_e51_cnano/peripheral/cmcc/plib_cmcc.c ../src/config/sam_e51_cnano/peripheral/dmac/plib_dmac.c ../src/config/sam_e51_cnano/peripheral/eic/plib_eic.c ../src/config/sam_e51_cnano/peripheral/evsys/plib_evsys.c ../src/config/sam_e51_cnano/peripheral/nvic/plib_nvic.c ../src/config/sam_e51_cnano/peripheral/nvmctrl/plib_nvmctrl.c ../src/config/sam_e51_cnano/peripheral/port/plib_port.c ../src/config/sam_e51_cnano/peripheral/rtc/plib_rtc_timer.c ../src/config/sam_e51_cnano/peripheral/sercom/usart/plib_sercom5_usart.c ../src/config/sam_e51_cnano/peripheral/sercom/usart/plib_sercom0_usart.c ../src/config/sam_e51_cnano/stdio/xc32_monitor.c ../src/config/sam_e51_cnano/startup_xc32.c ../src/config/sam_e51_cnano/initialization.c ../src/config/sam_e51_cnano/exceptions.c ../src/config/sam_e51_cnano/libc_syscalls.c ../src/config/sam_e51_cnano/interrupts.c ../src/main_sam_e51_cnano.c
+SOURCEFILES=../src/config/sam_e51_cnano/peripheral/can/plib_can1.c ../src/config/sam_e51_cnano/peripheral/clock/plib_clock.c ../src/config/sam_e51_cnano/peripheral/cmcc/plib_cmcc.c ../src/config/sam_e51_cnano/peripheral/dmac/plib_dmac.c ../src/config/sam_e51_cnano/peripheral/eic/plib_eic.c ../src/config/sam_e51_cnano/peripheral/evsys/plib_evsys.c ../src/config/sam_e51_cnano/peripheral/nvic/plib_nvic.c ../src/config/sam_e51_cnano/peripheral/nvmctrl/plib_nvmctrl.c ../src/config/sam_e51_cnano/peripheral/port/plib_port.c ../src/config/sam_e51_cnano/peripheral/rtc/plib_rtc_timer.c ../src/config/sam_e51_cnano/peripheral/sercom/usart/plib_sercom5_usart.c ../src/config/sam_e51_cnano/peripheral/sercom/usart/plib_sercom0_usart.c ../src/config/sam_e51_cnano/stdio/xc32_monitor.c ../src/config/sam_e51_cnano/startup_xc32.c ../src/config/sam_e51_cnano/initialization.c ../src/config/sam_e51_cnano/exceptions.c ../src/config/sam_e51_cnano/libc_syscalls.c ../src/config/sam_e51_cnano/interrupts.c ../src/main_sam_e51_cnano.c ../src/app_can_ring.c ../src/app_can_record.c ../src/app_uart_queue.c ../src/app_can_format.c ../src/app_can_change.c ../src/app_can_stats.c ../src/app_can_load.c ../src/app_can_filter.c ../src/app_can_idfilter.c ../src/app_can_trigger.c ../src/app_can_flashlog.c ../src/app_can_bitrate.c ../src/app_can_config.c ../src/app_fw_update.c ../src/config/sam_e51_cnano/peripheral/tc/plib_tc0.c ../src/app_can_replay.c ../src/app_can_txevent.c ../src/config/sam_e51_cnano/peripheral/tc/plib_tc1.c ../src/app_can_cyclic.c
 
 # Pack Options 
 PACK_COMMON_OPTIONS=-I "${CMSIS_DIR}/CMSIS/Core/Include"
@@ -238,6 +238,120 @@ ${OBJECTDIR}/_ext/1360937237/main_sam_e51_cnano.o: ../src/main_sam_e51_cnano.c
 	@${RM} ${OBJECTDIR}/_ext/1360937237/main_sam_e51_cnano.o 
 	${MP_CC}  $(MP_EXTRA_CC_PRE) -g -D__DEBUG   -x c -c -mprocessor=$(MP_PROCESSOR_OPTION)  -ffunction-sections -fdata-sections -O1 -fno-common -I"../src" -I"../src/config/sam_e51_cnano" -I"../src/packs/ATSAME51J20A_DFP" -I"../src/packs/CMSIS/" -I"../src/packs/CMSIS/CMSIS/Core/Include" -Werror -Wall -MP -MMD -MF "${OBJECTDIR}/_ext/1360937237/main_sam_e51_cnano.o.d" -o ${OBJECTDIR}/_ext/1360937237/main_sam_e51_cnano.o ../src/main_sam_e51_cnano.c    -DXPRJ_sam_e51_cnano=$(CND_CONF)    $(COMPARISON_BUILD)  -mdfp="${DFP_DIR}" ${PACK_COMMON_OPTIONS} 
 	
+${OBJECTDIR}/_ext/1360937237/app_can_ring.o: ../src/app_can_ring.c  .generated_files/flags/sam_e51_cnano/6693c187a00531ac4f28788bf3c1d92626013efa .generated_files/flags/sam_e51_cnano/da39a3ee5e6b4b0d3255bfef95601890afd80709
+	@${MKDIR} "${OBJECTDIR}/_ext/1360937237" 
+	@${RM} ${OBJECTDIR}/_ext/1360937237/app_can_ring.o.d 
+	@${RM} ${OBJECTDIR}/_ext/1360937237/app_can_ring.o 
+	${MP_CC}  $(MP_EXTRA_CC_PRE) -g -D__DEBUG   -x c -c -mprocessor=$(MP_PROCESSOR_OPTION)  -ffunction-sections -fdata-sections -O1 -fno-common -I"../src" -I"../src/config/sam_e51_cnano" -I"../src/packs/ATSAME51J20A_DFP" -I"../src/packs/CMSIS/" -I"../src/packs/CMSIS/CMSIS/Core/Include" -Werror -Wall -MP -MMD -MF "${OBJECTDIR}/_ext/1360937237/app_can_ring.o.d" -o ${OBJECTDIR}/_ext/1360937237/app_can_ring.o ../src/app_can_ring.c    -DXPRJ_sam_e51_cnano=$(CND_CONF)    $(COMPARISON_BUILD)  -mdfp="${DFP_DIR}" ${PACK_COMMON_OPTIONS} 
+	
+${OBJECTDIR}/_ext/1360937237/app_can_record.o: ../src/app_can_record.c  .generated_files/flags/sam_e51_cnano/170f2d07e045be7d6d5b3b07350cbe85f1f40d3c .generated_files/flags/sam_e51_cnano/da39a3ee5e6b4b0d3255bfef95601890afd80709
+	@${MKDIR} "${OBJECTDIR}/_ext/1360937237" 
+	@${RM} ${OBJECTDIR}/_ext/1360937237/app_can_record.o.d 
+	@${RM} ${OBJECTDIR}/_ext/1360937237/app_can_record.o 
+	${MP_CC}  $(MP_EXTRA_CC_PRE) -g -D__DEBUG   -x c -c -mprocessor=$(MP_PROCESSOR_OPTION)  -ffunction-sections -fdata-sections -O1 -fno-common -I"../src" -I"../src/config/sam_e51_cnano" -I"../src/packs/ATSAME51J20A_DFP" -I"../src/packs/CMSIS/" -I"../src/packs/CMSIS/CMSIS/Core/Include" -Werror -Wall -MP -MMD -MF "${OBJECTDIR}/_ext/1360937237/app_can_record.o.d" -o ${OBJECTDIR}/_ext/1360937237/app_can_record.o ../src/app_can_record.c    -DXPRJ_sam_e51_cnano=$(CND_CONF)    $(COMPARISON_BUILD)  -mdfp="${DFP_DIR}" ${PACK_COMMON_OPTIONS} 
+	
+${OBJECTDIR}/_ext/1360937237/app_uart_queue.o: ../src/app_uart_queue.c  .generated_files/flags/sam_e51_cnano/9ebc9e76b230c99360abaedc1e6b532acb6c33ec .generated_files/flags/sam_e51_cnano/da39a3ee5e6b4b0d3255bfef95601890afd80709
+	@${MKDIR} "${OBJECTDIR}/_ext/1360937237" 
+	@${RM} ${OBJECTDIR}/_ext/1360937237/app_uart_queue.o.d 
+	@${RM} ${OBJECTDIR}/_ext/1360937237/app_uart_queue.o 
+	${MP_CC}  $(MP_EXTRA_CC_PRE) -g -D__DEBUG   -x c -c -mprocessor=$(MP_PROCESSOR_OPTION)  -ffunction-sections -fdata-sections -O1 -fno-common -I"../src" -I"../src/config/sam_e51_cnano" -I"../src/packs/ATSAME51J20A_DFP" -I"../src/packs/CMSIS/" -I"../src/packs/CMSIS/CMSIS/Core/Include" -Werror -Wall -MP -MMD -MF "${OBJECTDIR}/_ext/1360937237/app_uart_queue.o.d" -o ${OBJECTDIR}/_ext/1360937237/app_uart_queue.o ../src/app_uart_queue.c    -DXPRJ_sam_e51_cnano=$(CND_CONF)    $(COMPARISON_BUILD)  -mdfp="${DFP_DIR}" ${PACK_COMMON_OPTIONS} 
+	
+${OBJECTDIR}/_ext/1360937237/app_can_format.o: ../src/app_can_format.c  .generated_files/flags/sam_e51_cnano/4802c2483746c83ef933c005b57d6a0268b9578d .generated_files/flags/sam_e51_cnano/da39a3ee5e6b4b0d3255bfef95601890afd80709
+	@${MKDIR} "${OBJECTDIR}/_ext/1360937237" 
+	@${RM} ${OBJECTDIR}/_ext/1360937237/app_can_format.o.d 
+	@${RM} ${OBJECTDIR}/_ext/1360937237/app_can_format.o 
+	${MP_CC}  $(MP_EXTRA_CC_PRE) -g -D__DEBUG   -x c -c -mprocessor=$(MP_PROCESSOR_OPTION)  -ffunction-sections -fdata-sections -O1 -fno-common -I"../src" -I"../src/config/sam_e51_cnano" -I"../src/packs/ATSAME51J20A_DFP" -I"../src/packs/CMSIS/" -I"../src/packs/CMSIS/CMSIS/Core/Include" -Werror -Wall -MP -MMD -MF "${OBJECTDIR}/_ext/1360937237/app_can_format.o.d" -o ${OBJECTDIR}/_ext/1360937237/app_can_format.o ../src/app_can_format.c    -DXPRJ_sam_e51_cnano=$(CND_CONF)    $(COMPARISON_BUILD)  -mdfp="${DFP_DIR}" ${PACK_COMMON_OPTIONS} 
+	
+${OBJECTDIR}/_ext/1360937237/app_can_change.o: ../src/app_can_change.c  .generated_files/flags/sam_e51_cnano/2665c7d0bc51b208ced86d8e22f11485dc85e686 .generated_files/flags/sam_e51_cnano/da39a3ee5e6b4b0d3255bfef95601890afd80709
+	@${MKDIR} "${OBJECTDIR}/_ext/1360937237" 
+	@${RM} ${OBJECTDIR}/_ext/1360937237/app_can_change.o.d 
+	@${RM} ${OBJECTDIR}/_ext/1360937237/app_can_change.o 
+	${MP_CC}  $(MP_EXTRA_CC_PRE) -g -D__DEBUG   -x c -c -mprocessor=$(MP_PROCESSOR_OPTION)  -ffunction-sections -fdata-sections -O1 -fno-common -I"../src" -I"../src/config/sam_e51_cnano" -I"../src/packs/ATSAME51J20A_DFP" -I"../src/packs/CMSIS/" -I"../src/packs/CMSIS/CMSIS/Core/Include" -Werror -Wall -MP -MMD -MF "${OBJECTDIR}/_ext/1360937237/app_can_change.o.d" -o ${OBJECTDIR}/_ext/1360937237/app_can_change.o ../src/app_can_change.c    -DXPRJ_sam_e51_cnano=$(CND_CONF)    $(COMPARISON_BUILD)  -mdfp="${DFP_DIR}" ${PACK_COMMON_OPTIONS} 
+	
+${OBJECTDIR}/_ext/1360937237/app_can_stats.o: ../src/app_can_stats.c  .generated_files/flags/sam_e51_cnano/b95609d4696d89b5c4d94891418a027a4554b96d .generated_files/flags/sam_e51_cnano/da39a3ee5e6b4b0d3255bfef95601890afd80709
+	@${MKDIR} "${OBJECTDIR}/_ext/1360937237" 
+	@${RM} ${OBJECTDIR}/_ext/1360937237/app_can_stats.o.d 
+	@${RM} ${OBJECTDIR}/_ext/1360937237/app_can_stats.o 
+	${MP_CC}  $(MP_EXTRA_CC_PRE) -g -D__DEBUG   -x c -c -mprocessor=$(MP_PROCESSOR_OPTION)  -ffunction-sections -fdata-sections -O1 -fno-common -I"../src" -I"../src/config/sam_e51_cnano" -I"../src/packs/ATSAME51J20A_DFP" -I"../src/packs/CMSIS/" -I"../src/packs/CMSIS/CMSIS/Core/Include" -Werror -Wall -MP -MMD -MF "${OBJECTDIR}/_ext/1360937237/app_can_stats.o.d" -o ${OBJECTDIR}/_ext/1360937237/app_can_stats.o ../src/app_can_stats.c    -DXPRJ_sam_e51_cnano=$(CND_CONF)    $(COMPARISON_BUILD)  -mdfp="${DFP_DIR}" ${PACK_COMMON_OPTIONS} 
+	
+${OBJECTDIR}/_ext/1360937237/app_can_load.o: ../src/app_can_load.c  .generated_files/flags/sam_e51_cnano/3d8d2ed540b7609da1d4f2c12676128011128efb .generated_files/flags/sam_e51_cnano/da39a3ee5e6b4b0d3255bfef95601890afd80709
+	@${MKDIR} "${OBJECTDIR}/_ext/1360937237" 
+	@${RM} ${OBJECTDIR}/_ext/1360937237/app_can_load.o.d 
+	@${RM} ${OBJECTDIR}/_ext/1360937237/app_can_load.o 
+	${MP_CC}  $(MP_EXTRA_CC_PRE) -g -D__DEBUG   -x c -c -mprocessor=$(MP_PROCESSOR_OPTION)  -ffunction-sections -fdata-sections -O1 -fno-common -I"../src" -I"../src/config/sam_e51_cnano" -I"../src/packs/ATSAME51J20A_DFP" -I"../src/packs/CMSIS/" -I"../src/packs/CMSIS/CMSIS/Core/Include" -Werror -Wall -MP -MMD -MF "${OBJECTDIR}/_ext/1360937237/app_can_load.o.d" -o ${OBJECTDIR}/_ext/1360937237/app_can_load.o ../src/app_can_load.c    -DXPRJ_sam_e51_cnano=$(CND_CONF)    $(COMPARISON_BUILD)  -mdfp="${DFP_DIR}" ${PACK_COMMON_OPTIONS} 
+	
+${OBJECTDIR}/_ext/1360937237/app_can_filter.o: ../src/app_can_filter.c  .generated_files/flags/sam_e51_cnano/881d5cb239809d22acf7f6d8856baaf66f10b2ca .generated_files/flags/sam_e51_cnano/da39a3ee5e6b4b0d3255bfef95601890afd80709
+	@${MKDIR} "${OBJECTDIR}/_ext/1360937237" 
+	@${RM} ${OBJECTDIR}/_ext/1360937237/app_can_filter.o.d 
+	@${RM} ${OBJECTDIR}/_ext/1360937237/app_can_filter.o 
+	${MP_CC}  $(MP_EXTRA_CC_PRE) -g -D__DEBUG   -x c -c -mprocessor=$(MP_PROCESSOR_OPTION)  -ffunction-sections -fdata-sections -O1 -fno-common -I"../src" -I"../src/config/sam_e51_cnano" -I"../src/packs/ATSAME51J20A_DFP" -I"../src/packs/CMSIS/" -I"../src/packs/CMSIS/CMSIS/Core/Include" -Werror -Wall -MP -MMD -MF "${OBJECTDIR}/_ext/1360937237/app_can_filter.o.d" -o ${OBJECTDIR}/_ext/1360937237/app_can_filter.o ../src/app_can_filter.c    -DXPRJ_sam_e51_cnano=$(CND_CONF)    $(COMPARISON_BUILD)  -mdfp="${DFP_DIR}" ${PACK_COMMON_OPTIONS} 
+	
+${OBJECTDIR}/_ext/1360937237/app_can_idfilter.o: ../src/app_can_idfilter.c  .generated_files/flags/sam_e51_cnano/7d14fb005d12365a8290cf40804f1521780c853c .generated_files/flags/sam_e51_cnano/da39a3ee5e6b4b0d3255bfef95601890afd80709
+	@${MKDIR} "${OBJECTDIR}/_ext/1360937237" 
+	@${RM} ${OBJECTDIR}/_ext/1360937237/app_can_idfilter.o.d 
+	@${RM} ${OBJECTDIR}/_ext/1360937237/app_can_idfilter.o 
+	${MP_CC}  $(MP_EXTRA_CC_PRE) -g -D__DEBUG   -x c -c -mprocessor=$(MP_PROCESSOR_OPTION)  -ffunction-sections -fdata-sections -O1 -fno-common -I"../src" -I"../src/config/sam_e51_cnano" -I"../src/packs/ATSAME51J20A_DFP" -I"../src/packs/CMSIS/" -I"../src/packs/CMSIS/CMSIS/Core/Include" -Werror -Wall -MP -MMD -MF "${OBJECTDIR}/_ext/1360937237/app_can_idfilter.o.d" -o ${OBJECTDIR}/_ext/1360937237/app_can_idfilter.o ../src/app_can_idfilter.c    -DXPRJ_sam_e51_cnano=$(CND_CONF)    $(COMPARISON_BUILD)  -mdfp="${DFP_DIR}" ${PACK_COMMON_OPTIONS} 
+	
+${OBJECTDIR}/_ext/1360937237/app_can_trigger.o: ../src/app_can_trigger.c  .generated_files/flags/sam_e51_cnano/c00cf38003f8074c44d93534c60599d05ade93cd .generated_files/flags/sam_e51_cnano/da39a3ee5e6b4b0d3255bfef95601890afd80709
+	@${MKDIR} "${OBJECTDIR}/_ext/1360937237" 
+	@${RM} ${OBJECTDIR}/_ext/1360937237/app_can_trigger.o.d 
+	@${RM} ${OBJECTDIR}/_ext/1360937237/app_can_trigger.o 
+	${MP_CC}  $(MP_EXTRA_CC_PRE) -g -D__DEBUG   -x c -c -mprocessor=$(MP_PROCESSOR_OPTION)  -ffunction-sections -fdata-sections -O1 -fno-common -I"../src" -I"../src/config/sam_e51_cnano" -I"../src/packs/ATSAME51J20A_DFP" -I"../src/packs/CMSIS/" -I"../src/packs/CMSIS/CMSIS/Core/Include" -Werror -Wall -MP -MMD -MF "${OBJECTDIR}/_ext/1360937237/app_can_trigger.o.d" -o ${OBJECTDIR}/_ext/1360937237/app_can_trigger.o ../src/app_can_trigger.c    -DXPRJ_sam_e51_cnano=$(CND_CONF)    $(COMPARISON_BUILD)  -mdfp="${DFP_DIR}" ${PACK_COMMON_OPTIONS} 
+	
+${OBJECTDIR}/_ext/1360937237/app_can_flashlog.o: ../src/app_can_flashlog.c  .generated_files/flags/sam_e51_cnano/9c22647bdced967eb77afd79ba8fdadf73bd72bf .generated_files/flags/sam_e51_cnano/da39a3ee5e6b4b0d3255bfef95601890afd80709
+	@${MKDIR} "${OBJECTDIR}/_ext/1360937237" 
+	@${RM} ${OBJECTDIR}/_ext/1360937237/app_can_flashlog.o.d 
+	@${RM} ${OBJECTDIR}/_ext/1360937237/app_can_flashlog.o 
+	${MP_CC}  $(MP_EXTRA_CC_PRE) -g -D__DEBUG   -x c -c -mprocessor=$(MP_PROCESSOR_OPTION)  -ffunction-sections -fdata-sections -O1 -fno-common -I"../src" -I"../src/config/sam_e51_cnano" -I"../src/packs/ATSAME51J20A_DFP" -I"../src/packs/CMSIS/" -I"../src/packs/CMSIS/CMSIS/Core/Include" -Werror -Wall -MP -MMD -MF "${OBJECTDIR}/_ext/1360937237/app_can_flashlog.o.d" -o ${OBJECTDIR}/_ext/1360937237/app_can_flashlog.o ../src/app_can_flashlog.c    -DXPRJ_sam_e51_cnano=$(CND_CONF)    $(COMPARISON_BUILD)  -mdfp="${DFP_DIR}" ${PACK_COMMON_OPTIONS} 
+	
+${OBJECTDIR}/_ext/1360937237/app_can_bitrate.o: ../src/app_can_bitrate.c  .generated_files/flags/sam_e51_cnano/4e62e69350ad800b9a7cabef17aa6d2f4e534575 .generated_files/flags/sam_e51_cnano/da39a3ee5e6b4b0d3255bfef95601890afd80709
+	@${MKDIR} "${OBJECTDIR}/_ext/1360937237" 
+	@${RM} ${OBJECTDIR}/_ext/1360937237/app_can_bitrate.o.d 
+	@${RM} ${OBJECTDIR}/_ext/1360937237/app_can_bitrate.o 
+	${MP_CC}  $(MP_EXTRA_CC_PRE) -g -D__DEBUG   -x c -c -mprocessor=$(MP_PROCESSOR_OPTION)  -ffunction-sections -fdata-sections -O1 -fno-common -I"../src" -I"../src/config/sam_e51_cnano" -I"../src/packs/ATSAME51J20A_DFP" -I"../src/packs/CMSIS/" -I"../src/packs/CMSIS/CMSIS/Core/Include" -Werror -Wall -MP -MMD -MF "${OBJECTDIR}/_ext/1360937237/app_can_bitrate.o.d" -o ${OBJECTDIR}/_ext/1360937237/app_can_bitrate.o ../src/app_can_bitrate.c    -DXPRJ_sam_e51_cnano=$(CND_CONF)    $(COMPARISON_BUILD)  -mdfp="${DFP_DIR}" ${PACK_COMMON_OPTIONS} 
+	
+${OBJECTDIR}/_ext/1360937237/app_can_config.o: ../src/app_can_config.c  .generated_files/flags/sam_e51_cnano/7fe159128dda41018ead6a02d8b5e3c3829b31fb .generated_files/flags/sam_e51_cnano/da39a3ee5e6b4b0d3255bfef95601890afd80709
+	@${MKDIR} "${OBJECTDIR}/_ext/1360937237" 
+	@${RM} ${OBJECTDIR}/_ext/1360937237/app_can_config.o.d 
+	@${RM} ${OBJECTDIR}/_ext/1360937237/app_can_config.o 
+	${MP_CC}  $(MP_EXTRA_CC_PRE) -g -D__DEBUG   -x c -c -mprocessor=$(MP_PROCESSOR_OPTION)  -ffunction-sections -fdata-sections -O1 -fno-common -I"../src" -I"../src/config/sam_e51_cnano" -I"../src/packs/ATSAME51J20A_DFP" -I"../src/packs/CMSIS/" -I"../src/packs/CMSIS/CMSIS/Core/Include" -Werror -Wall -MP -MMD -MF "${OBJECTDIR}/_ext/1360937237/app_can_config.o.d" -o ${OBJECTDIR}/_ext/1360937237/app_can_config.o ../src/app_can_config.c    -DXPRJ_sam_e51_cnano=$(CND_CONF)    $(COMPARISON_BUILD)  -mdfp="${DFP_DIR}" ${PACK_COMMON_OPTIONS} 
+	
+${OBJECTDIR}/_ext/1360937237/app_fw_update.o: ../src/app_fw_update.c  .generated_files/flags/sam_e51_cnano/174f30b559b6dd5b7e14f578947266573999dd0c .generated_files/flags/sam_e51_cnano/da39a3ee5e6b4b0d3255bfef95601890afd80709
+	@${MKDIR} "${OBJECTDIR}/_ext/1360937237" 
+	@${RM} ${OBJECTDIR}/_ext/1360937237/app_fw_update.o.d 
+	@${RM} ${OBJECTDIR}/_ext/1360937237/app_fw_update.o 
+	${MP_CC}  $(MP_EXTRA_CC_PRE) -g -D__DEBUG   -x c -c -mprocessor=$(MP_PROCESSOR_OPTION)  -ffunction-sections -fdata-sections -O1 -fno-common -I"../src" -I"../src/config/sam_e51_cnano" -I"../src/packs/ATSAME51J20A_DFP" -I"../src/packs/CMSIS/" -I"../src/packs/CMSIS/CMSIS/Core/Include" -Werror -Wall -MP -MMD -MF "${OBJECTDIR}/_ext/1360937237/app_fw_update.o.d" -o ${OBJECTDIR}/_ext/1360937237/app_fw_update.o ../src/app_fw_update.c    -DXPRJ_sam_e51_cnano=$(CND_CONF)    $(COMPARISON_BUILD)  -mdfp="${DFP_DIR}" ${PACK_COMMON_OPTIONS} 
+	
+${OBJECTDIR}/_ext/1900303495/plib_tc0.o: ../src/config/sam_e51_cnano/peripheral/tc/plib_tc0.c  .generated_files/flags/sam_e51_cnano/97d6995e6ae20832a471e184dff193663280be04 .generated_files/flags/sam_e51_cnano/da39a3ee5e6b4b0d3255bfef95601890afd80709
+	@${MKDIR} "${OBJECTDIR}/_ext/1900303495" 
+	@${RM} ${OBJECTDIR}/_ext/1900303495/plib_tc0.o.d 
+	@${RM} ${OBJECTDIR}/_ext/1900303495/plib_tc0.o 
+	${MP_CC}  $(MP_EXTRA_CC_PRE) -g -D__DEBUG   -x c -c -mprocessor=$(MP_PROCESSOR_OPTION)  -ffunction-sections -fdata-sections -O1 -fno-common -I"../src" -I"../src/config/sam_e51_cnano" -I"../src/packs/ATSAME51J20A_DFP" -I"../src/packs/CMSIS/" -I"../src/packs/CMSIS/CMSIS/Core/Include" -Werror -Wall -MP -MMD -MF "${OBJECTDIR}/_ext/1900303495/plib_tc0.o.d" -o ${OBJECTDIR}/_ext/1900303495/plib_tc0.o ../src/config/sam_e51_cnano/peripheral/tc/plib_tc0.c    -DXPRJ_sam_e51_cnano=$(CND_CONF)    $(COMPARISON_BUILD)  -mdfp="${DFP_DIR}" ${PACK_COMMON_OPTIONS} 
+	
+${OBJECTDIR}/_ext/1360937237/app_can_replay.o: ../src/app_can_replay.c  .generated_files/flags/sam_e51_cnano/ecb88f03efe05de2a540a4340943183daf17716b .generated_files/flags/sam_e51_cnano/da39a3ee5e6b4b0d3255bfef95601890afd80709
+	@${MKDIR} "${OBJECTDIR}/_ext/1360937237" 
+	@${RM} ${OBJECTDIR}/_ext/1360937237/app_can_replay.o.d 
+	@${RM} ${OBJECTDIR}/_ext/1360937237/app_can_replay.o 
+	${MP_CC}  $(MP_EXTRA_CC_PRE) -g -D__DEBUG   -x c -c -mprocessor=$(MP_PROCESSOR_OPTION)  -ffunction-sections -fdata-sections -O1 -fno-common -I"../src" -I"../src/config/sam_e51_cnano" -I"../src/packs/ATSAME51J20A_DFP" -I"../src/packs/CMSIS/" -I"../src/packs/CMSIS/CMSIS/Core/Include" -Werror -Wall -MP -MMD -MF "${OBJECTDIR}/_ext/1360937237/app_can_replay.o.d" -o ${OBJECTDIR}/_ext/1360937237/app_can_replay.o ../src/app_can_replay.c    -DXPRJ_sam_e51_cnano=$(CND_CONF)    $(COMPARISON_BUILD)  -mdfp="${DFP_DIR}" ${PACK_COMMON_OPTIONS} 
+	
+${OBJECTDIR}/_ext/1360937237/app_can_txevent.o: ../src/app_can_txevent.c  .generated_files/flags/sam_e51_cnano/282963eaa318b4af30306b0d271ae481b21172dd .generated_files/flags/sam_e51_cnano/da39a3ee5e6b4b0d3255bfef95601890afd80709
+	@${MKDIR} "${OBJECTDIR}/_ext/1360937237" 
+	@${RM} ${OBJECTDIR}/_ext/1360937237/app_can_txevent.o.d 
+	@${RM} ${OBJECTDIR}/_ext/1360937237/app_can_txevent.o 
+	${MP_CC}  $(MP_EXTRA_CC_PRE) -g -D__DEBUG   -x c -c -mprocessor=$(MP_PROCESSOR_OPTION)  -ffunction-sections -fdata-sections -O1 -fno-common -I"../src" -I"../src/config/sam_e51_cnano" -I"../src/packs/ATSAME51J20A_DFP" -I"../src/packs/CMSIS/" -I"../src/packs/CMSIS/CMSIS/Core/Include" -Werror -Wall -MP -MMD -MF "${OBJECTDIR}/_ext/1360937237/app_can_txevent.o.d" -o ${OBJECTDIR}/_ext/1360937237/app_can_txevent.o ../src/app_can_txevent.c    -DXPRJ_sam_e51_cnano=$(CND_CONF)    $(COMPARISON_BUILD)  -mdfp="${DFP_DIR}" ${PACK_COMMON_OPTIONS} 
+	
+${OBJECTDIR}/_ext/1900303495/plib_tc1.o: ../src/config/sam_e51_cnano/peripheral/tc/plib_tc1.c  .generated_files/flags/sam_e51_cnano/491d56ddc8024df904443bd615d96997156ae8e4 .generated_files/flags/sam_e51_cnano/da39a3ee5e6b4b0d3255bfef95601890afd80709
+	@${MKDIR} "${OBJECTDIR}/_ext/1900303495" 
+	@${RM} ${OBJECTDIR}/_ext/1900303495/plib_tc1.o.d 
+	@${RM} ${OBJECTDIR}/_ext/1900303495/plib_tc1.o 
+	${MP_CC}  $(MP_EXTRA_CC_PRE) -g -D__DEBUG   -x c -c -mprocessor=$(MP_PROCESSOR_OPTION)  -ffunction-sections -fdata-sections -O1 -fno-common -I"../src" -I"../src/config/sam_e51_cnano" -I"../src/packs/ATSAME51J20A_DFP" -I"../src/packs/CMSIS/" -I"../src/packs/CMSIS/CMSIS/Core/Include" -Werror -Wall -MP -MMD -MF "${OBJECTDIR}/_ext/1900303495/plib_tc1.o.d" -o ${OBJECTDIR}/_ext/1900303495/plib_tc1.o ../src/config/sam_e51_cnano/peripheral/tc/plib_tc1.c    -DXPRJ_sam_e51_cnano=$(CND_CONF)    $(COMPARISON_BUILD)  -mdfp="${DFP_DIR}" ${PACK_COMMON_OPTIONS} 
+	
+${OBJECTDIR}/_ext/1360937237/app_can_cyclic.o: ../src/app_can_cyclic.c  .generated_files/flags/sam_e51_cnano/a3647a172754c6c291b328eff1cbcb837e862b16 .generated_files/flags/sam_e51_cnano/da39a3ee5e6b4b0d3255bfef95601890afd80709
+	@${MKDIR} "${OBJECTDIR}/_ext/1360937237" 
+	@${RM} ${OBJECTDIR}/_ext/1360937237/app_can_cyclic.o.d 
+	@${RM} ${OBJECTDIR}/_ext/1360937237/app_can_cyclic.o 
+	${MP_CC}  $(MP_EXTRA_CC_PRE) -g -D__DEBUG   -x c -c -mprocessor=$(MP_PROCESSOR_OPTION)  -ffunction-sections -fdata-sections -O1 -fno-common -I"../src" -I"../src/config/sam_e51_cnano" -I"../src/packs/ATSAME51J20A_DFP" -I"../src/packs/CMSIS/" -I"../src/packs/CMSIS/CMSIS/Core/Include" -Werror -Wall -MP -MMD -MF "${OBJECTDIR}/_ext/1360937237/app_can_cyclic.o.d" -o ${OBJECTDIR}/_ext/1360937237/app_can_cyclic.o ../src/app_can_cyclic.c    -DXPRJ_sam_e51_cnano=$(CND_CONF)    $(COMPARISON_BUILD)  -mdfp="${DFP_DIR}" ${PACK_COMMON_OPTIONS} 
+	
 else
 ${OBJECTDIR}/_ext/1220117510/plib_can1.o: ../src/config/sam_e51_cnano/peripheral/can/plib_can1.c  .generated_files/flags/sam_e51_cnano/b237d90f5690515ec3d1779bae6ab3245ccf97d6 .generated_files/flags/sam_e51_cnano/da39a3ee5e6b4b0d3255bfef95601890afd80709
 	@${MKDIR} "${OBJECTDIR}/_ext/1220117510" 
@@ -353,6 +467,120 @@ ${OBJECTDIR}/_ext/1360937237/main_sam_e51_cnano.o: ../src/main_sam_e51_cnano.c
 	@${RM} ${OBJECTDIR}/_ext/1360937237/main_sam_e51_cnano.o 
 	${MP_CC}  $(MP_EXTRA_CC_PRE)  -g -x c -c -mprocessor=$(MP_PROCESSOR_OPTION)  -ffunction-sections -fdata-sections -O1 -fno-common -I"../src" -I"../src/config/sam_e51_cnano" -I"../src/packs/ATSAME51J20A_DFP" -I"../src/packs/CMSIS/" -I"../src/packs/CMSIS/CMSIS/Core/Include" -Werror -Wall -MP -MMD -MF "${OBJECTDIR}/_ext/1360937237/main_sam_e51_cnano.o.d" -o ${OBJECTDIR}/_ext/1360937237/main_sam_e51_cnano.o ../src/main_sam_e51_cnano.c    -DXPRJ_sam_e51_cnano=$(CND_CONF)    $(COMPARISON_BUILD)  -mdfp="${DFP_DIR}" ${PACK_COMMON_OPTIONS} 
 	
+${OBJECTDIR}/_ext/1360937237/app_can_ring.o: ../src/app_can_ring.c  .generated_files/flags/sam_e51_cnano/c51b45bcf409a5020d9ca57ecfd364c98495551a .generated_files/flags/sam_e51_cnano/da39a3ee5e6b4b0d3255bfef95601890afd80709
+	@${MKDIR} "${OBJECTDIR}/_ext/1360937237" 
+	@${RM} ${OBJECTDIR}/_ext/1360937237/app_can_ring.o.d 
+	@${RM} ${OBJECTDIR}/_ext/1360937237/app_can_ring.o 
+	${MP_CC}  $(MP_EXTRA_CC_PRE)  -g -x c -c -mprocessor=$(MP_PROCESSOR_OPTION)  -ffunction-sections -fdata-sections -O1 -fno-common -I"../src" -I"../src/config/sam_e51_cnano" -I"../src/packs/ATSAME51J20A_DFP" -I"../src/packs/CMSIS/" -I"../src/packs/CMSIS/CMSIS/Core/Include" -Werror -Wall -MP -MMD -MF "${OBJECTDIR}/_ext/1360937237/app_can_ring.o.d" -o ${OBJECTDIR}/_ext/1360937237/app_can_ring.o ../src/app_can_ring.c    -DXPRJ_sam_e51_cnano=$(CND_CONF)    $(COMPARISON_BUILD)  -mdfp="${DFP_DIR}" ${PACK_COMMON_OPTIONS} 
+	
+${OBJECTDIR}/_ext/1360937237/app_can_record.o: ../src/app_can_record.c  .generated_files/flags/sam_e51_cnano/d4973f5d883200be640bd4488da86ea9e065a80d .generated_files/flags/sam_e51_cnano/da39a3ee5e6b4b0d3255bfef95601890afd80709
+	@${MKDIR} "${OBJECTDIR}/_ext/1360937237" 
+	@${RM} ${OBJECTDIR}/_ext/1360937237/app_can_record.o.d 
+	@${RM} ${OBJECTDIR}/_ext/1360937237/app_can_record.o 
+	${MP_CC}  $(MP_EXTRA_CC_PRE)  -g -x c -c -mprocessor=$(MP_PROCESSOR_OPTION)  -ffunction-sections -fdata-sections -O1 -fno-common -I"../src" -I"../src/config/sam_e51_cnano" -I"../src/packs/ATSAME51J20A_DFP" -I"../src/packs/CMSIS/" -I"../src/packs/CMSIS/CMSIS/Core/Include" -Werror -Wall -MP -MMD -MF "${OBJECTDIR}/_ext/1360937237/app_can_record.o.d" -o ${OBJECTDIR}/_ext/1360937237/app_can_record.o ../src/app_can_record.c    -DXPRJ_sam_e51_cnano=$(CND_CONF)    $(COMPARISON_BUILD)  -mdfp="${DFP_DIR}" ${PACK_COMMON_OPTIONS} 
+	
+${OBJECTDIR}/_ext/1360937237/app_uart_queue.o: ../src/app_uart_queue.c  .generated_files/flags/sam_e51_cnano/1412ae08267dc74b2da3d713c237d630c698e164 .generated_files/flags/sam_e51_cnano/da39a3ee5e6b4b0d3255bfef95601890afd80709
+	@${MKDIR} "${OBJECTDIR}/_ext/1360937237" 
+	@${RM} ${OBJECTDIR}/_ext/1360937237/app_uart_queue.o.d 
+	@${RM} ${OBJECTDIR}/_ext/1360937237/app_uart_queue.o 
+	${MP_CC}  $(MP_EXTRA_CC_PRE)  -g -x c -c -mprocessor=$(MP_PROCESSOR_OPTION)  -ffunction-sections -fdata-sections -O1 -fno-common -I"../src" -I"../src/config/sam_e51_cnano" -I"../src/packs/ATSAME51J20A_DFP" -I"../src/packs/CMSIS/" -I"../src/packs/CMSIS/CMSIS/Core/Include" -Werror -Wall -MP -MMD -MF "${OBJECTDIR}/_ext/1360937237/app_uart_queue.o.d" -o ${OBJECTDIR}/_ext/1360937237/app_uart_queue.o ../src/app_uart_queue.c    -DXPRJ_sam_e51_cnano=$(CND_CONF)    $(COMPARISON_BUILD)  -mdfp="${DFP_DIR}" ${PACK_COMMON_OPTIONS} 
+	
+${OBJECTDIR}/_ext/1360937237/app_can_format.o: ../src/app_can_format.c  .generated_files/flags/sam_e51_cnano/15b9653b232189fe6b7eaa2544cf67032021f4f6 .generated_files/flags/sam_e51_cnano/da39a3ee5e6b4b0d3255bfef95601890afd80709
+	@${MKDIR} "${OBJECTDIR}/_ext/1360937237" 
+	@${RM} ${OBJECTDIR}/_ext/1360937237/app_can_format.o.d 
+	@${RM} ${OBJECTDIR}/_ext/1360937237/app_can_format.o 
+	${MP_CC}  $(MP_EXTRA_CC_PRE)  -g -x c -c -mprocessor=$(MP_PROCESSOR_OPTION)  -ffunction-sections -fdata-sections -O1 -fno-common -I"../src" -I"../src/config/sam_e51_cnano" -I"../src/packs/ATSAME51J20A_DFP" -I"../src/packs/CMSIS/" -I"../src/packs/CMSIS/CMSIS/Core/Include" -Werror -Wall -MP -MMD -MF "${OBJECTDIR}/_ext/1360937237/app_can_format.o.d" -o ${OBJECTDIR}/_ext/1360937237/app_can_format.o ../src/app_can_format.c    -DXPRJ_sam_e51_cnano=$(CND_CONF)    $(COMPARISON_BUILD)  -mdfp="${DFP_DIR}" ${PACK_COMMON_OPTIONS} 
+	
+${OBJECTDIR}/_ext/1360937237/app_can_change.o: ../src/app_can_change.c  .generated_files/flags/sam_e51_cnano/c36f30fa18dc52808b55a626165123c441632b4a .generated_files/flags/sam_e51_cnano/da39a3ee5e6b4b0d3255bfef95601890afd80709
+	@${MKDIR} "${OBJECTDIR}/_ext/1360937237" 
+	@${RM} ${OBJECTDIR}/_ext/1360937237/app_can_change.o.d 
+	@${RM} ${OBJECTDIR}/_ext/1360937237/app_can_change.o 
+	${MP_CC}  $(MP_EXTRA_CC_PRE)  -g -x c -c -mprocessor=$(MP_PROCESSOR_OPTION)  -ffunction-sections -fdata-sections -O1 -fno-common -I"../src" -I"../src/config/sam_e51_cnano" -I"../src/packs/ATSAME51J20A_DFP" -I"../src/packs/CMSIS/" -I"../src/packs/CMSIS/CMSIS/Core/Include" -Werror -Wall -MP -MMD -MF "${OBJECTDIR}/_ext/1360937237/app_can_change.o.d" -o ${OBJECTDIR}/_ext/1360937237/app_can_change.o ../src/app_can_change.c    -DXPRJ_sam_e51_cnano=$(CND_CONF)    $(COMPARISON_BUILD)  -mdfp="${DFP_DIR}" ${PACK_COMMON_OPTIONS} 
+	
+${OBJECTDIR}/_ext/1360937237/app_can_stats.o: ../src/app_can_stats.c  .generated_files/flags/sam_e51_cnano/16489921802d9271b66e9a96414441886401225e .generated_files/flags/sam_e51_cnano/da39a3ee5e6b4b0d3255bfef95601890afd80709
+	@${MKDIR} "${OBJECTDIR}/_ext/1360937237" 
+	@${RM} ${OBJECTDIR}/_ext/1360937237/app_can_stats.o.d 
+	@${RM} ${OBJECTDIR}/_ext/1360937237/app_can_stats.o 
+	${MP_CC}  $(MP_EXTRA_CC_PRE)  -g -x c -c -mprocessor=$(MP_PROCESSOR_OPTION)  -ffunction-sections -fdata-sections -O1 -fno-common -I"../src" -I"../src/config/sam_e51_cnano" -I"../src/packs/ATSAME51J20A_DFP" -I"../src/packs/CMSIS/" -I"../src/packs/CMSIS/CMSIS/Core/Include" -Werror -Wall -MP -MMD -MF "${OBJECTDIR}/_ext/1360937237/app_can_stats.o.d" -o ${OBJECTDIR}/_ext/1360937237/app_can_stats.o ../src/app_can_stats.c    -DXPRJ_sam_e51_cnano=$(CND_CONF)    $(COMPARISON_BUILD)  -mdfp="${DFP_DIR}" ${PACK_COMMON_OPTIONS} 
+	
+${OBJECTDIR}/_ext/1360937237/app_can_load.o: ../src/app_can_load.c  .generated_files/flags/sam_e51_cnano/5ffd1c04cf1611fa8066d6c3251803417f04cb8c .generated_files/flags/sam_e51_cnano/da39a3ee5e6b4b0d3255bfef95601890afd80709
+	@${MKDIR} "${OBJECTDIR}/_ext/1360937237" 
+	@${RM} ${OBJECTDIR}/_ext/1360937237/app_can_load.o.d 
+	@${RM} ${OBJECTDIR}/_ext/1360937237/app_can_load.o 
+	${MP_CC}  $(MP_EXTRA_CC_PRE)  -g -x c -c -mprocessor=$(MP_PROCESSOR_OPTION)  -ffunction-sections -fdata-sections -O1 -fno-common -I"../src" -I"../src/config/sam_e51_cnano" -I"../src/packs/ATSAME51J20A_DFP" -I"../src/packs/CMSIS/" -I"../src/packs/CMSIS/CMSIS/Core/Include" -Werror -Wall -MP -MMD -MF "${OBJECTDIR}/_ext/1360937237/app_can_load.o.d" -o ${OBJECTDIR}/_ext/1360937237/app_can_load.o ../src/app_can_load.c    -DXPRJ_sam_e51_cnano=$(CND_CONF)    $(COMPARISON_BUILD)  -mdfp="${DFP_DIR}" ${PACK_COMMON_OPTIONS} 
+	
+${OBJECTDIR}/_ext/1360937237/app_can_filter.o: ../src/app_can_filter.c  .generated_files/flags/sam_e51_cnano/aadf3efe3aa53a4893e831709e4570c282a9ce1f .generated_files/flags/sam_e51_cnano/da39a3ee5e6b4b0d3255bfef95601890afd80709
+	@${MKDIR} "${OBJECTDIR}/_ext/1360937237" 
+	@${RM} ${OBJECTDIR}/_ext/1360937237/app_can_filter.o.d 
+	@${RM} ${OBJECTDIR}/_ext/1360937237/app_can_filter.o 
+	${MP_CC}  $(MP_EXTRA_CC_PRE)  -g -x c -c -mprocessor=$(MP_PROCESSOR_OPTION)  -ffunction-sections -fdata-sections -O1 -fno-common -I"../src" -I"../src/config/sam_e51_cnano" -I"../src/packs/ATSAME51J20A_DFP" -I"../src/packs/CMSIS/" -I"../src/packs/CMSIS/CMSIS/Core/Include" -Werror -Wall -MP -MMD -MF "${OBJECTDIR}/_ext/1360937237/app_can_filter.o.d" -o ${OBJECTDIR}/_ext/1360937237/app_can_filter.o ../src/app_can_filter.c    -DXPRJ_sam_e51_cnano=$(CND_CONF)    $(COMPARISON_BUILD)  -mdfp="${DFP_DIR}" ${PACK_COMMON_OPTIONS} 
+	
+${OBJECTDIR}/_ext/1360937237/app_can_idfilter.o: ../src/app_can_idfilter.c  .generated_files/flags/sam_e51_cnano/a133bfdb5c5821744321df096679ea7907fdf0a0 .generated_files/flags/sam_e51_cnano/da39a3ee5e6b4b0d3255bfef95601890afd80709
+	@${MKDIR} "${OBJECTDIR}/_ext/1360937237" 
+	@${RM} ${OBJECTDIR}/_ext/1360937237/app_can_idfilter.o.d 
+	@${RM} ${OBJECTDIR}/_ext/1360937237/app_can_idfilter.o 
+	${MP_CC}  $(MP_EXTRA_CC_PRE)  -g -x c -c -mprocessor=$(MP_PROCESSOR_OPTION)  -ffunction-sections -fdata-sections -O1 -fno-common -I"../src" -I"../src/config/sam_e51_cnano" -I"../src/packs/ATSAME51J20A_DFP" -I"../src/packs/CMSIS/" -I"../src/packs/CMSIS/CMSIS/Core/Include" -Werror -Wall -MP -MMD -MF "${OBJECTDIR}/_ext/1360937237/app_can_idfilter.o.d" -o ${OBJECTDIR}/_ext/1360937237/app_can_idfilter.o ../src/app_can_idfilter.c    -DXPRJ_sam_e51_cnano=$(CND_CONF)    $(COMPARISON_BUILD)  -mdfp="${DFP_DIR}" ${PACK_COMMON_OPTIONS} 
+	
+${OBJECTDIR}/_ext/1360937237/app_can_trigger.o: ../src/app_can_trigger.c  .generated_files/flags/sam_e51_cnano/d319fbb223ee5ce97c6e5e7b2835206cc13647ca .generated_files/flags/sam_e51_cnano/da39a3ee5e6b4b0d3255bfef95601890afd80709
+	@${MKDIR} "${OBJECTDIR}/_ext/1360937237" 
+	@${RM} ${OBJECTDIR}/_ext/1360937237/app_can_trigger.o.d 
+	@${RM} ${OBJECTDIR}/_ext/1360937237/app_can_trigger.o 
+	${MP_CC}  $(MP_EXTRA_CC_PRE)  -g -x c -c -mprocessor=$(MP_PROCESSOR_OPTION)  -ffunction-sections -fdata-sections -O1 -fno-common -I"../src" -I"../src/config/sam_e51_cnano" -I"../src/packs/ATSAME51J20A_DFP" -I"../src/packs/CMSIS/" -I"../src/packs/CMSIS/CMSIS/Core/Include" -Werror -Wall -MP -MMD -MF "${OBJECTDIR}/_ext/1360937237/app_can_trigger.o.d" -o ${OBJECTDIR}/_ext/1360937237/app_can_trigger.o ../src/app_can_trigger.c    -DXPRJ_sam_e51_cnano=$(CND_CONF)    $(COMPARISON_BUILD)  -mdfp="${DFP_DIR}" ${PACK_COMMON_OPTIONS} 
+	
+${OBJECTDIR}/_ext/1360937237/app_can_flashlog.o: ../src/app_can_flashlog.c  .generated_files/flags/sam_e51_cnano/9f025e170332c837cc66c538f6d045979cb6a830 .generated_files/flags/sam_e51_cnano/da39a3ee5e6b4b0d3255bfef95601890afd80709
+	@${MKDIR} "${OBJECTDIR}/_ext/1360937237" 
+	@${RM} ${OBJECTDIR}/_ext/1360937237/app_can_flashlog.o.d 
+	@${RM} ${OBJECTDIR}/_ext/1360937237/app_can_flashlog.o 
+	${MP_CC}  $(MP_EXTRA_CC_PRE)  -g -x c -c -mprocessor=$(MP_PROCESSOR_OPTION)  -ffunction-sections -fdata-sections -O1 -fno-common -I"../src" -I"../src/config/sam_e51_cnano" -I"../src/packs/ATSAME51J20A_DFP" -I"../src/packs/CMSIS/" -I"../src/packs/CMSIS/CMSIS/Core/Include" -Werror -Wall -MP -MMD -MF "${OBJECTDIR}/_ext/1360937237/app_can_flashlog.o.d" -o ${OBJECTDIR}/_ext/1360937237/app_can_flashlog.o ../src/app_can_flashlog.c    -DXPRJ_sam_e51_cnano=$(CND_CONF)    $(COMPARISON_BUILD)  -mdfp="${DFP_DIR}" ${PACK_COMMON_OPTIONS} 
+	
+${OBJECTDIR}/_ext/1360937237/app_can_bitrate.o: ../src/app_can_bitrate.c  .generated_files/flags/sam_e51_cnano/28d87cb341579962e2a04041e6d3410a82211611 .generated_files/flags/sam_e51_cnano/da39a3ee5e6b4b0d3255bfef95601890afd80709
+	@${MKDIR} "${OBJECTDIR}/_ext/1360937237" 
+	@${RM} ${OBJECTDIR}/_ext/1360937237/app_can_bitrate.o.d 
+	@${RM} ${OBJECTDIR}/_ext/1360937237/app_can_bitrate.o 
+	${MP_CC}  $(MP_EXTRA_CC_PRE)  -g -x c -c -mprocessor=$(MP_PROCESSOR_OPTION)  -ffunction-sections -fdata-sections -O1 -fno-common -I"../src" -I"../src/config/sam_e51_cnano" -I"../src/packs/ATSAME51J20A_DFP" -I"../src/packs/CMSIS/" -I"../src/packs/CMSIS/CMSIS/Core/Include" -Werror -Wall -MP -MMD -MF "${OBJECTDIR}/_ext/1360937237/app_can_bitrate.o.d" -o ${OBJECTDIR}/_ext/1360937237/app_can_bitrate.o ../src/app_can_bitrate.c    -DXPRJ_sam_e51_cnano=$(CND_CONF)    $(COMPARISON_BUILD)  -mdfp="${DFP_DIR}" ${PACK_COMMON_OPTIONS} 
+	
+${OBJECTDIR}/_ext/1360937237/app_can_config.o: ../src/app_can_config.c  .generated_files/flags/sam_e51_cnano/4216390f674ccdc74122b97368528f2821baf8d9 .generated_files/flags/sam_e51_cnano/da39a3ee5e6b4b0d3255bfef95601890afd80709
+	@${MKDIR} "${OBJECTDIR}/_ext/1360937237" 
+	@${RM} ${OBJECTDIR}/_ext/1360937237/app_can_config.o.d 
+	@${RM} ${OBJECTDIR}/_ext/1360937237/app_can_config.o 
+	${MP_CC}  $(MP_EXTRA_CC_PRE)  -g -x c -c -mprocessor=$(MP_PROCESSOR_OPTION)  -ffunction-sections -fdata-sections -O1 -fno-common -I"../src" -I"../src/config/sam_e51_cnano" -I"../src/packs/ATSAME51J20A_DFP" -I"../src/packs/CMSIS/" -I"../src/packs/CMSIS/CMSIS/Core/Include" -Werror -Wall -MP -MMD -MF "${OBJECTDIR}/_ext/1360937237/app_can_config.o.d" -o ${OBJECTDIR}/_ext/1360937237/app_can_config.o ../src/app_can_config.c    -DXPRJ_sam_e51_cnano=$(CND_CONF)    $(COMPARISON_BUILD)  -mdfp="${DFP_DIR}" ${PACK_COMMON_OPTIONS} 
+	
+${OBJECTDIR}/_ext/1360937237/app_fw_update.o: ../src/app_fw_update.c  .generated_files/flags/sam_e51_cnano/89912ad8182e4eeddbea7041c659ad6066171c57 .generated_files/flags/sam_e51_cnano/da39a3ee5e6b4b0d3255bfef95601890afd80709
+	@${MKDIR} "${OBJECTDIR}/_ext/1360937237" 
+	@${RM} ${OBJECTDIR}/_ext/1360937237/app_fw_update.o.d 
+	@${RM} ${OBJECTDIR}/_ext/1360937237/app_fw_update.o 
+	${MP_CC}  $(MP_EXTRA_CC_PRE)  -g -x c -c -mprocessor=$(MP_PROCESSOR_OPTION)  -ffunction-sections -fdata-sections -O1 -fno-common -I"../src" -I"../src/config/sam_e51_cnano" -I"../src/packs/ATSAME51J20A_DFP" -I"../src/packs/CMSIS/" -I"../src/packs/CMSIS/CMSIS/Core/Include" -Werror -Wall -MP -MMD -MF "${OBJECTDIR}/_ext/1360937237/app_fw_update.o.d" -o ${OBJECTDIR}/_ext/1360937237/app_fw_update.o ../src/app_fw_update.c    -DXPRJ_sam_e51_cnano=$(CND_CONF)    $(COMPARISON_BUILD)  -mdfp="${DFP_DIR}" ${PACK_COMMON_OPTIONS} 
+	
+${OBJECTDIR}/_ext/1900303495/plib_tc0.o: ../src/config/sam_e51_cnano/peripheral/tc/plib_tc0.c  .generated_files/flags/sam_e51_cnano/0e3a49b40fb4e9182b01db9fc7a0895c9b522ac6 .generated_files/flags/sam_e51_cnano/da39a3ee5e6b4b0d3255bfef95601890afd80709
+	@${MKDIR} "${OBJECTDIR}/_ext/1900303495" 
+	@${RM} ${OBJECTDIR}/_ext/1900303495/plib_tc0.o.d 
+	@${RM} ${OBJECTDIR}/_ext/1900303495/plib_tc0.o 
+	${MP_CC}  $(MP_EXTRA_CC_PRE)  -g -x c -c -mprocessor=$(MP_PROCESSOR_OPTION)  -ffunction-sections -fdata-sections -O1 -fno-common -I"../src" -I"../src/config/sam_e51_cnano" -I"../src/packs/ATSAME51J20A_DFP" -I"../src/packs/CMSIS/" -I"../src/packs/CMSIS/CMSIS/Core/Include" -Werror -Wall -MP -MMD -MF "${OBJECTDIR}/_ext/1900303495/plib_tc0.o.d" -o ${OBJECTDIR}/_ext/1900303495/plib_tc0.o ../src/config/sam_e51_cnano/peripheral/tc/plib_tc0.c    -DXPRJ_sam_e51_cnano=$(CND_CONF)    $(COMPARISON_BUILD)  -mdfp="${DFP_DIR}" ${PACK_COMMON_OPTIONS} 
+	
+${OBJECTDIR}/_ext/1360937237/app_can_replay.o: ../src/app_can_replay.c  .generated_files/flags/sam_e51_cnano/253f73a4ce7edc76988f2e649f09acefbdbeb511 .generated_files/flags/sam_e51_cnano/da39a3ee5e6b4b0d3255bfef95601890afd80709
+	@${MKDIR} "${OBJECTDIR}/_ext/1360937237" 
+	@${RM} ${OBJECTDIR}/_ext/1360937237/app_can_replay.o.d 
+	@${RM} ${OBJECTDIR}/_ext/1360937237/app_can_replay.o 
+	${MP_CC}  $(MP_EXTRA_CC_PRE)  -g -x c -c -mprocessor=$(MP_PROCESSOR_OPTION)  -ffunction-sections -fdata-sections -O1 -fno-common -I"../src" -I"../src/config/sam_e51_cnano" -I"../src/packs/ATSAME51J20A_DFP" -I"../src/packs/CMSIS/" -I"../src/packs/CMSIS/CMSIS/Core/Include" -Werror -Wall -MP -MMD -MF "${OBJECTDIR}/_ext/1360937237/app_can_replay.o.d" -o ${OBJECTDIR}/_ext/1360937237/app_can_replay.o ../src/app_can_replay.c    -DXPRJ_sam_e51_cnano=$(CND_CONF)    $(COMPARISON_BUILD)  -mdfp="${DFP_DIR}" ${PACK_COMMON_OPTIONS} 
+	
+${OBJECTDIR}/_ext/1360937237/app_can_txevent.o: ../src/app_can_txevent.c  .generated_files/flags/sam_e51_cnano/3b1119a4e65ab6d86153dec807893ff4f40fc022 .generated_files/flags/sam_e51_cnano/da39a3ee5e6b4b0d3255bfef95601890afd80709
+	@${MKDIR} "${OBJECTDIR}/_ext/1360937237" 
+	@${RM} ${OBJECTDIR}/_ext/1360937237/app_can_txevent.o.d 
+	@${RM} ${OBJECTDIR}/_ext/1360937237/app_can_txevent.o 
+	${MP_CC}  $(MP_EXTRA_CC_PRE)  -g -x c -c -mprocessor=$(MP_PROCESSOR_OPTION)  -ffunction-sections -fdata-sections -O1 -fno-common -I"../src" -I"../src/config/sam_e51_cnano" -I"../src/packs/ATSAME51J20A_DFP" -I"../src/packs/CMSIS/" -I"../src/packs/CMSIS/CMSIS/Core/Include" -Werror -Wall -MP -MMD -MF "${OBJECTDIR}/_ext/1360937237/app_can_txevent.o.d" -o ${OBJECTDIR}/_ext/1360937237/app_can_txevent.o ../src/app_can_txevent.c    -DXPRJ_sam_e51_cnano=$(CND_CONF)    $(COMPARISON_BUILD)  -mdfp="${DFP_DIR}" ${PACK_COMMON_OPTIONS} 
+	
+${OBJECTDIR}/_ext/1900303495/plib_tc1.o: ../src/config/sam_e51_cnano/peripheral/tc/plib_tc1.c  .generated_files/flags/sam_e51_cnano/3a9c240cd485debe2edbdcab1817f6e9989a6917 .generated_files/flags/sam_e51_cnano/da39a3ee5e6b4b0d3255bfef95601890afd80709
+	@${MKDIR} "${OBJECTDIR}/_ext/1900303495" 
+	@${RM} ${OBJECTDIR}/_ext/1900303495/plib_tc1.o.d 
+	@${RM} ${OBJECTDIR}/_ext/1900303495/plib_tc1.o 
+	${MP_CC}  $(MP_EXTRA_CC_PRE)  -g -x c -c -mprocessor=$(MP_PROCESSOR_OPTION)  -ffunction-sections -fdata-sections -O1 -fno-common -I"../src" -I"../src/config/sam_e51_cnano" -I"../src/packs/ATSAME51J20A_DFP" -I"../src/packs/CMSIS/" -I"../src/packs/CMSIS/CMSIS/Core/Include" -Werror -Wall -MP -MMD -MF "${OBJECTDIR}/_ext/1900303495/plib_tc1.o.d" -o ${OBJECTDIR}/_ext/1900303495/plib_tc1.o ../src/config/sam_e51_cnano/peripheral/tc/plib_tc1.c    -DXPRJ_sam_e51_cnano=$(CND_CONF)    $(COMPARISON_BUILD)  -mdfp="${DFP_DIR}" ${PACK_COMMON_OPTIONS} 
+	
+${OBJECTDIR}/_ext/1360937237/app_can_cyclic.o: ../src/app_can_cyclic.c  .generated_files/flags/sam_e51_cnano/04cf0ce3a4e9ccd86b2ea77813843253069fc970 .generated_files/flags/sam_e51_cnano/da39a3ee5e6b4b0d3255bfef95601890afd80709
+	@${MKDIR} "${OBJECTDIR}/_ext/1360937237" 
+	@${RM} ${OBJECTDIR}/_ext/1360937237/app_can_cyclic.o.d 
+	@${RM} ${OBJECTDIR}/_ext/1360937237/app_can_cyclic.o 
+	${MP_CC}  $(MP_EXTRA_CC_PRE)  -g -x c -c -mprocessor=$(MP_PROCESSOR_OPTION)  -ffunction-sections -fdata-sections -O1 -fno-common -I"../src" -I"../src/config/sam_e51_cnano" -I"../src/packs/ATSAME51J20A_DFP" -I"../src/packs/CMSIS/" -I"../src/packs/CMSIS/CMSIS/Core/Include" -Werror -Wall -MP -MMD -MF "${OBJECTDIR}/_ext/1360937237/app_can_cyclic.o.d" -o ${OBJECTDIR}/_ext/1360937237/app_can_cyclic.o ../src/app_can_cyclic.c    -DXPRJ_sam_e51_cnano=$(CND_CONF)    $(COMPARISON_BUILD)  -mdfp="${DFP_DIR}" ${PACK_COMMON_OPTIONS} 
+	
 endif
 
 # ------------------------------------------------------------------------------------
@@ -0,0 +1,472 @@
+/*******************************************************************************
+  CAN Bit Rate Profiles Source File
+
+  Company:
+    Microchip Technology Inc.
+
+  File Name:
+    app_can_bitrate.c
+
+  Summary:
+    CAN1 bit timing profiles, implementation.
+
+  Description:
+    This file implements the bit rate profiles. All profiles use the 60 MHz CAN1
+    core clock, with the sample point at 75 % in the nominal phase and between
+    73 % and 83 % in the data phase. The automatic detection listens with one
+    profile after the other and scores each by the frames received against
+    the protocol errors seen.
+*******************************************************************************/
+
+//DOM-IGNORE-BEGIN
+/*******************************************************************************
+* Copyright (C) 2024 Microchip Technology Inc. and its subsidiaries.
+*
+* Subject to your compliance with these terms, you may use Microchip software
+* and any derivatives exclusively with Microchip products. It is your
+* responsibility to comply with third party license terms applicable to your
+* use of third party software (including open source software) that may
+* accompany Microchip software.
+*
+* THIS SOFTWARE IS SUPPLIED BY MICROCHIP "AS IS". NO WARRANTIES, WHETHER
+* EXPRESS, IMPLIED OR STATUTORY, APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED
+* WARRANTIES OF NON-INFRINGEMENT, MERCHANTABILITY, AND FITNESS FOR A
+* PARTICULAR PURPOSE.
+*
+* IN NO EVENT WILL MICROCHIP BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE,
+* INCIDENTAL OR CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND
+* WHATSOEVER RELATED TO THE SOFTWARE, HOWEVER CAUSED, EVEN IF MICROCHIP HAS
+* BEEN ADVISED OF THE POSSIBILITY OR THE DAMAGES ARE FORESEEABLE. TO THE
+* FULLEST EXTENT ALLOWED BY LAW, MICROCHIP'S TOTAL LIABILITY ON ALL CLAIMS IN
+* ANY WAY RELATED TO THIS SOFTWARE WILL NOT EXCEED THE AMOUNT OF FEES, IF ANY,
+* THAT YOU HAVE PAID DIRECTLY TO MICROCHIP FOR THIS SOFTWARE.
+*******************************************************************************/
+//DOM-IGNORE-END
+
+
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Included Files
+// *****************************************************************************
+// *****************************************************************************
+
+#include <string.h>
+#include "app_can_bitrate.h"
+#include "app_can_format.h"
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Global Data
+// *****************************************************************************
+// *****************************************************************************
+
+/* Nominal phase: 20 time quanta, NTSEG1 = 14, NTSEG2 = 5, NSJW = 4. Only the
+   prescaler (clocks per time quantum) differs. */
+static const uint16_t bitRateNominalPrescaler[APP_CAN_BITRATE_NOMINAL_RATES] =
+{
+    24U, 12U, 6U, 3U
+};
+
+/* Data phase register field values, fields are value - 1 */
+static const CAN_DATA_BIT_TIMING bitRateData[APP_CAN_BITRATE_DATA_RATES] =
+{
+    /* 1 Mbit/s: 2 clocks per quantum, 30 quanta */
+    { 1U, 20U, 7U, 6U },
+    /* 2 Mbit/s: 30 quanta */
+    { 0U, 20U, 7U, 6U },
+    /* 4 Mbit/s: 15 quanta */
+    { 0U, 10U, 2U, 2U },
+    /* 5 Mbit/s: 12 quanta */
+    { 0U, 8U, 1U, 1U }
+};
+
+static uint32_t bitRateProfile = APP_CAN_BITRATE_PROFILE_DEFAULT;
+
+#define APP_CAN_BITRATE_AUTO_DWELL_TICKS        (APP_CAN_BITRATE_AUTO_DWELL_MS * (APP_CAN_FORMAT_TICKS_PER_SECOND / 1000U))
+/* A data bit rate is listened to for up to this many dwell times until
+   frames with bit rate switching come */
+#define APP_CAN_BITRATE_AUTO_DWELL_DATA_MAX     3U
+/* An error outweighs this many frames */
+#define APP_CAN_BITRATE_AUTO_ERROR_WEIGHT       1
+
+static volatile APP_CAN_BITRATE_AUTO_STATE bitRateAutoState = APP_CAN_BITRATE_AUTO_STATE_IDLE;
+static APP_CAN_BITRATE_AUTO_RESULT bitRateAutoResult = APP_CAN_BITRATE_AUTO_RESULT_NONE;
+static APP_CAN_BITRATE_SCORE bitRateAutoNominal[APP_CAN_BITRATE_NOMINAL_RATES];
+static APP_CAN_BITRATE_SCORE bitRateAutoData[APP_CAN_BITRATE_DATA_RATES];
+/* Profile and bus monitoring mode before the detection */
+static uint32_t bitRateAutoProfile = 0U;
+static bool bitRateAutoMonitoring = false;
+/* Nominal or data bit rate index listened to, and candidates done */
+static uint32_t bitRateAutoIndex = 0U;
+static uint32_t bitRateAutoDone = 0U;
+static uint32_t bitRateAutoNominalIndex = 0U;
+/* Start of listening to the candidate, counted by the CAN1 interrupt from
+   then on and error counters at the start */
+static uint32_t bitRateAutoStart = 0U;
+static volatile uint32_t bitRateAutoFrames = 0U;
+static volatile uint32_t bitRateAutoBrsFrames = 0U;
+static uint32_t bitRateAutoNominalErrors = 0U;
+static uint32_t bitRateAutoDataErrors = 0U;
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: CAN Bit Rate Routines
+// *****************************************************************************
+// *****************************************************************************
+
+uint32_t APP_CAN_BitRateNominalGet(uint32_t profile)
+{
+    if (profile >= APP_CAN_BITRATE_PROFILES)
+    {
+        return 0U;
+    }
+    return APP_CAN_BITRATE_CLOCK_HZ / ((uint32_t)bitRateNominalPrescaler[profile / APP_CAN_BITRATE_DATA_RATES] * 20U);
+}
+
+uint32_t APP_CAN_BitRateDataGet(uint32_t profile)
+{
+    const CAN_DATA_BIT_TIMING *data = NULL;
+
+    if (profile >= APP_CAN_BITRATE_PROFILES)
+    {
+        return 0U;
+    }
+    data = &bitRateData[profile % APP_CAN_BITRATE_DATA_RATES];
+    return APP_CAN_BITRATE_CLOCK_HZ / (((uint32_t)data->dataBaudRatePrescaler + 1U) *
+                                       ((uint32_t)data->dataTimeSegment1 + (uint32_t)data->dataTimeSegment2 + 3U));
+}
+
+bool APP_CAN_BitRateTimingGet(uint32_t profile, CAN_BIT_TIMING *bitTiming)
+{
+    if (profile >= APP_CAN_BITRATE_PROFILES)
+    {
+        return false;
+    }
+
+    bitTiming->nominalBitTimingSet = true;
+    bitTiming->nominalBitTiming.nominalBaudRatePrescaler = bitRateNominalPrescaler[profile / APP_CAN_BITRATE_DATA_RATES] - 1U;
+    bitTiming->nominalBitTiming.nominalTimeSegment1 = 13U;
+    bitTiming->nominalBitTiming.nominalTimeSegment2 = 4U;
+    bitTiming->nominalBitTiming.nominalSJW = 3U;
+    bitTiming->dataBitTimingSet = true;
+    bitTiming->dataBitTiming = bitRateData[profile % APP_CAN_BITRATE_DATA_RATES];
+    return true;
+}
+
+bool APP_CAN_BitRateProfileSet(uint32_t profile)
+{
+    CAN_BIT_TIMING bitTiming;
+
+    if ((APP_CAN_BitRateTimingGet(profile, &bitTiming) == false) || (CAN1_BitTimingSet(&bitTiming) == false))
+    {
+        return false;
+    }
+    bitRateProfile = profile;
+    return true;
+}
+
+uint32_t APP_CAN_BitRateProfileGet(void)
+{
+    return bitRateProfile;
+}
+
+/* Sets a candidate profile and starts counting for it */
+static void APP_CAN_BitRateAutoListen(uint32_t profile)
+{
+    (void)APP_CAN_BitRateProfileSet(profile);
+
+    __disable_irq();
+    bitRateAutoFrames = 0U;
+    bitRateAutoBrsFrames = 0U;
+    CAN1_ProtocolErrorCountGet(&bitRateAutoNominalErrors, &bitRateAutoDataErrors);
+    /* The timestamp counter restarted with the bit timing */
+    bitRateAutoStart = CAN1_RxTimestampExtend((uint16_t)CAN1_REGS->CAN_TSCV);
+    __enable_irq();
+}
+
+static void APP_CAN_BitRateAutoScoreUpdate(APP_CAN_BITRATE_SCORE *score)
+{
+    uint32_t nominalErrors = 0U;
+    uint32_t dataErrors = 0U;
+
+    __disable_irq();
+    CAN1_ProtocolErrorCountGet(&nominalErrors, &dataErrors);
+    score->frames = bitRateAutoFrames;
+    score->brsFrames = bitRateAutoBrsFrames;
+    __enable_irq();
+    score->tried = true;
+    score->nominalErrors = nominalErrors - bitRateAutoNominalErrors;
+    score->dataErrors = dataErrors - bitRateAutoDataErrors;
+}
+
+/* Frames received for a candidate, and for a nominal bit rate the frames
+   which failed in the data phase, as their arbitration phase was received.
+   The data bit rate only decides about frames with bit rate switching. */
+static uint32_t APP_CAN_BitRateAutoEvidenceGet(const APP_CAN_BITRATE_SCORE *score, bool data)
+{
+    return (data == true) ? score->brsFrames : (score->frames + score->dataErrors);
+}
+
+static int32_t APP_CAN_BitRateAutoRankGet(const APP_CAN_BITRATE_SCORE *score, bool data)
+{
+    uint32_t errors = (data == true) ? score->dataErrors : score->nominalErrors;
+
+    return (int32_t)APP_CAN_BitRateAutoEvidenceGet(score, data) - (APP_CAN_BITRATE_AUTO_ERROR_WEIGHT * (int32_t)errors);
+}
+
+/* Index of the best candidate, count when there is none. The best one has
+   to receive frames, and more than its errors outweigh. Frames rejected by
+   the acceptance filter are not seen, so the only candidate without errors
+   on a bus which gave the others errors is taken as well. */
+static uint32_t APP_CAN_BitRateAutoBestGet(const APP_CAN_BITRATE_SCORE *scores, uint32_t count, bool data)
+{
+    uint32_t best = count;
+    uint32_t index = 0U;
+    uint32_t errorFree = 0U;
+    bool errors = false;
+
+    for (index = 0U; index < count; index++)
+    {
+        if (scores[index].tried == false)
+        {
+            continue;
+        }
+        if (((data == true) ? scores[index].dataErrors : (scores[index].nominalErrors + scores[index].dataErrors)) == 0U)
+        {
+            errorFree++;
+        }
+        else
+        {
+            errors = true;
+        }
+        if ((best == count) || (APP_CAN_BitRateAutoRankGet(&scores[index], data) > APP_CAN_BitRateAutoRankGet(&scores[best], data)))
+        {
+            best = index;
+        }
+    }
+    if (best == count)
+    {
+        return count;
+    }
+    if ((APP_CAN_BitRateAutoEvidenceGet(&scores[best], data) != 0U) && (APP_CAN_BitRateAutoRankGet(&scores[best], data) > 0))
+    {
+        return best;
+    }
+    if ((errors == true) && (errorFree == 1U) &&
+        (((data == true) ? scores[best].dataErrors : (scores[best].nominalErrors + scores[best].dataErrors)) == 0U))
+    {
+        return best;
+    }
+    return count;
+}
+
+/* Keeps a profile and leaves bus monitoring mode unless it was set before */
+static void APP_CAN_BitRateAutoEnd(APP_CAN_BITRATE_AUTO_RESULT result, uint32_t profile)
+{
+    (void)APP_CAN_BitRateProfileSet(profile);
+    if (bitRateAutoMonitoring == false)
+    {
+        CAN1_BusMonitoringSet(false);
+    }
+    bitRateAutoResult = result;
+    bitRateAutoState = APP_CAN_BITRATE_AUTO_STATE_IDLE;
+}
+
+/* The nominal bit rate is known. Frames with bit rate switching received
+   without data phase errors confirm the data bit rate, errors in the data
+   phase start the search for it. Without such frames the data bit rate in
+   use keeps being listened to, the counts go on. */
+static void APP_CAN_BitRateAutoNominalEnd(uint32_t best)
+{
+    uint32_t dataIndex = bitRateAutoProfile % APP_CAN_BITRATE_DATA_RATES;
+    const APP_CAN_BITRATE_SCORE *score = NULL;
+
+    if (best >= APP_CAN_BITRATE_NOMINAL_RATES)
+    {
+        APP_CAN_BitRateAutoEnd(APP_CAN_BITRATE_AUTO_RESULT_FAILED, bitRateAutoProfile);
+        return;
+    }
+    score = &bitRateAutoNominal[best];
+    if ((score->dataErrors == 0U) && (score->brsFrames != 0U))
+    {
+        APP_CAN_BitRateAutoEnd(APP_CAN_BITRATE_AUTO_RESULT_DETECTED, (best * APP_CAN_BITRATE_DATA_RATES) + dataIndex);
+        return;
+    }
+
+    bitRateAutoNominalIndex = best;
+    bitRateAutoState = APP_CAN_BITRATE_AUTO_STATE_DATA;
+    if (score->dataErrors == 0U)
+    {
+        /* Still counting when the best one was listened to last */
+        if (best != bitRateAutoIndex)
+        {
+            APP_CAN_BitRateAutoListen((best * APP_CAN_BITRATE_DATA_RATES) + dataIndex);
+        }
+        bitRateAutoDone = 0U;
+        bitRateAutoIndex = dataIndex;
+        return;
+    }
+
+    /* The data bit rate used so far was scored with the nominal one */
+    bitRateAutoData[dataIndex] = *score;
+    bitRateAutoDone = 1U;
+    bitRateAutoIndex = (dataIndex + 1U) % APP_CAN_BITRATE_DATA_RATES;
+    APP_CAN_BitRateAutoListen((bitRateAutoNominalIndex * APP_CAN_BITRATE_DATA_RATES) + bitRateAutoIndex);
+}
+
+static void APP_CAN_BitRateAutoDataEnd(uint32_t best)
+{
+    if (best >= APP_CAN_BITRATE_DATA_RATES)
+    {
+        APP_CAN_BitRateAutoEnd(APP_CAN_BITRATE_AUTO_RESULT_NOMINAL,
+                               (bitRateAutoNominalIndex * APP_CAN_BITRATE_DATA_RATES) + (bitRateAutoProfile % APP_CAN_BITRATE_DATA_RATES));
+        return;
+    }
+    APP_CAN_BitRateAutoEnd(APP_CAN_BITRATE_AUTO_RESULT_DETECTED, (bitRateAutoNominalIndex * APP_CAN_BITRATE_DATA_RATES) + best);
+}
+
+bool APP_CAN_BitRateAutoStart(void)
+{
+    if (bitRateAutoState != APP_CAN_BITRATE_AUTO_STATE_IDLE)
+    {
+        return false;
+    }
+    memset(bitRateAutoNominal, 0, sizeof(bitRateAutoNominal));
+    memset(bitRateAutoData, 0, sizeof(bitRateAutoData));
+    bitRateAutoResult = APP_CAN_BITRATE_AUTO_RESULT_NONE;
+    bitRateAutoProfile = bitRateProfile;
+    bitRateAutoMonitoring = CAN1_BusMonitoringGet();
+    if (bitRateAutoMonitoring == false)
+    {
+        CAN1_BusMonitoringSet(true);
+    }
+
+    /* The nominal bit rate in use first, it is the likely one */
+    bitRateAutoIndex = bitRateProfile / APP_CAN_BITRATE_DATA_RATES;
+    bitRateAutoDone = 0U;
+    bitRateAutoState = APP_CAN_BITRATE_AUTO_STATE_NOMINAL;
+    APP_CAN_BitRateAutoListen(bitRateProfile);
+    return true;
+}
+
+void APP_CAN_BitRateAutoTasks(void)
+{
+    bool data = (bitRateAutoState == APP_CAN_BITRATE_AUTO_STATE_DATA);
+    uint32_t rates = data ? APP_CAN_BITRATE_DATA_RATES : APP_CAN_BITRATE_NOMINAL_RATES;
+    APP_CAN_BITRATE_SCORE *scores = data ? bitRateAutoData : bitRateAutoNominal;
+    APP_CAN_BITRATE_SCORE *score = &scores[bitRateAutoIndex];
+    uint32_t now = 0U;
+    uint32_t observed = 0U;
+    uint32_t best = rates;
+    bool clean = false;
+    bool waiting = false;
+
+    if (bitRateAutoState == APP_CAN_BITRATE_AUTO_STATE_IDLE)
+    {
+        return;
+    }
+    APP_CAN_BitRateAutoScoreUpdate(score);
+    __disable_irq();
+    now = CAN1_RxTimestampExtend((uint16_t)CAN1_REGS->CAN_TSCV);
+    __enable_irq();
+
+    /* Enough frames without an error settle it. A nominal bit rate waits
+       for the dwell time unless frames with bit rate switching confirmed
+       the data bit rate as well, they may just not have been sent yet. A
+       data bit rate is only tried by frames with bit rate switching, it
+       waits longer while none was received, data phase errors alone may
+       come from disturbed frames, and stops at enough of them. */
+    if (data == true)
+    {
+        observed = score->brsFrames + score->dataErrors;
+        clean = ((score->brsFrames >= APP_CAN_BITRATE_AUTO_FRAMES) && (score->dataErrors == 0U));
+        waiting = ((clean == false) && (observed < APP_CAN_BITRATE_AUTO_FRAMES) &&
+                   ((now - bitRateAutoStart) < (APP_CAN_BITRATE_AUTO_DWELL_TICKS * ((score->brsFrames == 0U) ? APP_CAN_BITRATE_AUTO_DWELL_DATA_MAX : 1U))));
+    }
+    else
+    {
+        clean = ((score->frames >= APP_CAN_BITRATE_AUTO_FRAMES) && ((score->nominalErrors + score->dataErrors) == 0U));
+        waiting = (((clean == false) || (score->brsFrames == 0U)) && ((now - bitRateAutoStart) < APP_CAN_BITRATE_AUTO_DWELL_TICKS));
+    }
+    if (waiting == true)
+    {
+        return;
+    }
+
+    bitRateAutoDone++;
+    if (clean == true)
+    {
+        best = bitRateAutoIndex;
+    }
+    else if ((data == true) && (observed == 0U) && (bitRateAutoDone == 1U))
+    {
+        /* No frames with bit rate switching on the bus to confirm the data
+           bit rate in use */
+        best = rates;
+    }
+    else if (bitRateAutoDone < rates)
+    {
+        bitRateAutoIndex = (bitRateAutoIndex + 1U) % rates;
+        APP_CAN_BitRateAutoListen(data ? ((bitRateAutoNominalIndex * APP_CAN_BITRATE_DATA_RATES) + bitRateAutoIndex)
+                                       : ((bitRateAutoIndex * APP_CAN_BITRATE_DATA_RATES) + (bitRateAutoProfile % APP_CAN_BITRATE_DATA_RATES)));
+        return;
+    }
+    else
+    {
+        best = APP_CAN_BitRateAutoBestGet(scores, rates, data);
+    }
+
+    if (data == true)
+    {
+        APP_CAN_BitRateAutoDataEnd(best);
+    }
+    else
+    {
+        APP_CAN_BitRateAutoNominalEnd(best);
+    }
+}
+
+void APP_CAN_BitRateAutoFrameAdd(const CAN_RX_BUFFER *rxBuf)
+{
+    if (bitRateAutoState == APP_CAN_BITRATE_AUTO_STATE_IDLE)
+    {
+        return;
+    }
+    bitRateAutoFrames++;
+    if (rxBuf->brs != 0U)
+    {
+        bitRateAutoBrsFrames++;
+    }
+}
+
+APP_CAN_BITRATE_AUTO_STATE APP_CAN_BitRateAutoStateGet(void)
+{
+    return bitRateAutoState;
+}
+
+APP_CAN_BITRATE_AUTO_RESULT APP_CAN_BitRateAutoResultGet(void)
+{
+    return bitRateAutoResult;
+}
+
+void APP_CAN_BitRateAutoScoreGet(bool data, uint32_t index, APP_CAN_BITRATE_SCORE *score)
+{
+    memset(score, 0, sizeof(*score));
+    if ((data == false) && (index < APP_CAN_BITRATE_NOMINAL_RATES))
+    {
+        *score = bitRateAutoNominal[index];
+    }
+    else if ((data == true) && (index < APP_CAN_BITRATE_DATA_RATES))
+    {
+        *score = bitRateAutoData[index];
+    }
+    else
+    {
+        /* No such bit rate */
+    }
+}
+
+/*******************************************************************************
+ End of File
+*/
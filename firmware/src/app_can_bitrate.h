@@ -0,0 +1,181 @@
+/*******************************************************************************
+  CAN Bit Rate Profiles Header File
+
+  Company:
+    Microchip Technology Inc.
+
+  File Name:
+    app_can_bitrate.h
+
+  Summary:
+    CAN1 bit timing profiles, interface.
+
+  Description:
+    This file declares the bit rate profiles, the nominal and data bit rate
+    pairs the sniffer can be switched to at run time without rebuilding.
+*******************************************************************************/
+
+//DOM-IGNORE-BEGIN
+/*******************************************************************************
+* Copyright (C) 2024 Microchip Technology Inc. and its subsidiaries.
+*
+* Subject to your compliance with these terms, you may use Microchip software
+* and any derivatives exclusively with Microchip products. It is your
+* responsibility to comply with third party license terms applicable to your
+* use of third party software (including open source software) that may
+* accompany Microchip software.
+*
+* THIS SOFTWARE IS SUPPLIED BY MICROCHIP "AS IS". NO WARRANTIES, WHETHER
+* EXPRESS, IMPLIED OR STATUTORY, APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED
+* WARRANTIES OF NON-INFRINGEMENT, MERCHANTABILITY, AND FITNESS FOR A
+* PARTICULAR PURPOSE.
+*
+* IN NO EVENT WILL MICROCHIP BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE,
+* INCIDENTAL OR CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND
+* WHATSOEVER RELATED TO THE SOFTWARE, HOWEVER CAUSED, EVEN IF MICROCHIP HAS
+* BEEN ADVISED OF THE POSSIBILITY OR THE DAMAGES ARE FORESEEABLE. TO THE
+* FULLEST EXTENT ALLOWED BY LAW, MICROCHIP'S TOTAL LIABILITY ON ALL CLAIMS IN
+* ANY WAY RELATED TO THIS SOFTWARE WILL NOT EXCEED THE AMOUNT OF FEES, IF ANY,
+* THAT YOU HAVE PAID DIRECTLY TO MICROCHIP FOR THIS SOFTWARE.
+*******************************************************************************/
+//DOM-IGNORE-END
+
+
+
+#ifndef APP_CAN_BITRATE_H
+#define APP_CAN_BITRATE_H
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Included Files
+// *****************************************************************************
+// *****************************************************************************
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "definitions.h"
+
+// DOM-IGNORE-BEGIN
+#ifdef __cplusplus  // Provide C++ Compatibility
+    extern "C" {
+#endif
+// DOM-IGNORE-END
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Data Types
+// *****************************************************************************
+// *****************************************************************************
+
+/* CAN1 core clock (GCLK1) */
+#ifndef APP_CAN_BITRATE_CLOCK_HZ
+#define APP_CAN_BITRATE_CLOCK_HZ                60000000UL
+#endif
+
+/* Profiles are numbered nominal index * APP_CAN_BITRATE_DATA_RATES + data
+   index, nominal 125k/250k/500k/1M and data 1M/2M/4M/5M bit/s */
+#define APP_CAN_BITRATE_NOMINAL_RATES           4U
+#define APP_CAN_BITRATE_DATA_RATES              4U
+#define APP_CAN_BITRATE_PROFILES                (APP_CAN_BITRATE_NOMINAL_RATES * APP_CAN_BITRATE_DATA_RATES)
+
+/* Bit timing generated for CAN1, 500 kbit/s nominal and 2 Mbit/s data */
+#define APP_CAN_BITRATE_PROFILE_DEFAULT         9U
+
+/* Automatic detection: time each candidate bit rate is listened to, and
+   error free frames after which a candidate is taken at once */
+#ifndef APP_CAN_BITRATE_AUTO_DWELL_MS
+#define APP_CAN_BITRATE_AUTO_DWELL_MS           100U
+#endif
+#ifndef APP_CAN_BITRATE_AUTO_FRAMES
+#define APP_CAN_BITRATE_AUTO_FRAMES             8U
+#endif
+
+typedef enum
+{
+    APP_CAN_BITRATE_AUTO_STATE_IDLE,
+    /* Listening with each nominal bit rate */
+    APP_CAN_BITRATE_AUTO_STATE_NOMINAL,
+    /* Listening with each data bit rate at the detected nominal bit rate */
+    APP_CAN_BITRATE_AUTO_STATE_DATA
+} APP_CAN_BITRATE_AUTO_STATE;
+
+typedef enum
+{
+    APP_CAN_BITRATE_AUTO_RESULT_NONE,
+    /* Nominal and data bit rate detected */
+    APP_CAN_BITRATE_AUTO_RESULT_DETECTED,
+    /* Nominal bit rate detected, the data bit rate was kept as no frames
+       with bit rate switching confirmed one */
+    APP_CAN_BITRATE_AUTO_RESULT_NOMINAL,
+    /* No bit rate received frames without errors, the profile was restored */
+    APP_CAN_BITRATE_AUTO_RESULT_FAILED
+} APP_CAN_BITRATE_AUTO_RESULT;
+
+/* What was received while listening with one candidate bit rate */
+typedef struct
+{
+    bool tried;
+    /* Frames received, and those with bit rate switching */
+    uint32_t frames;
+    uint32_t brsFrames;
+    /* Protocol errors in the arbitration and data phase (PSR LEC/DLEC) */
+    uint32_t nominalErrors;
+    uint32_t dataErrors;
+} APP_CAN_BITRATE_SCORE;
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Interface Routines
+// *****************************************************************************
+// *****************************************************************************
+
+/* Nominal and data bit rates of a profile in bit/s, 0 when there is no such
+   profile */
+uint32_t APP_CAN_BitRateNominalGet(uint32_t profile);
+uint32_t APP_CAN_BitRateDataGet(uint32_t profile);
+
+/* Bit timing of a profile, false when there is no such profile */
+bool APP_CAN_BitRateTimingGet(uint32_t profile, CAN_BIT_TIMING *bitTiming);
+
+/* Sets the bit timing of a profile with CAN1_BitTimingSet. Before
+   CAN1_Initialize it is only recorded, afterwards the controller restarts
+   with it and APP_CAN_LoadInitialize must be called again. */
+bool APP_CAN_BitRateProfileSet(uint32_t profile);
+
+/* Profile last set, APP_CAN_BITRATE_PROFILE_DEFAULT initially */
+uint32_t APP_CAN_BitRateProfileGet(void);
+
+/* Starts the automatic detection of the bit rates. CAN1 listens in bus
+   monitoring mode with the nominal bit rates one after the other, then with
+   the data bit rates, and keeps the profile which received frames with the
+   fewest errors. Returns false when a detection is running. Nothing may be
+   transmitted until it ends. */
+bool APP_CAN_BitRateAutoStart(void);
+
+/* Advances the detection, call from the main loop */
+void APP_CAN_BitRateAutoTasks(void);
+
+/* Accounts a received frame, call from the CAN1 interrupt for every frame */
+void APP_CAN_BitRateAutoFrameAdd(const CAN_RX_BUFFER *rxBuf);
+
+APP_CAN_BITRATE_AUTO_STATE APP_CAN_BitRateAutoStateGet(void);
+
+/* Result of the last detection, after which APP_CAN_LoadInitialize must be
+   called again as for APP_CAN_BitRateProfileSet */
+APP_CAN_BITRATE_AUTO_RESULT APP_CAN_BitRateAutoResultGet(void);
+
+/* Score of a nominal (data false) or data bit rate index in the last
+   detection */
+void APP_CAN_BitRateAutoScoreGet(bool data, uint32_t index, APP_CAN_BITRATE_SCORE *score);
+
+// DOM-IGNORE-BEGIN
+#ifdef __cplusplus  // Provide C++ Compatibility
+    }
+#endif
+// DOM-IGNORE-END
+
+#endif // APP_CAN_BITRATE_H
+
+/*******************************************************************************
+ End of File
+*/
@@ -0,0 +1,194 @@
+/*******************************************************************************
+  CAN Change Filter Source File
+
+  Company:
+    Microchip Technology Inc.
+
+  File Name:
+    app_can_change.c
+
+  Summary:
+    Changed-only forwarding filter implementation.
+
+  Description:
+    This file implements the per-ID last-value cache. Standard IDs use a direct
+    table indexed by the 11-bit ID, extended IDs a bounded open addressing
+    hash table. Each entry keeps a 32-bit fingerprint of DLC, flags and
+    payload rather than the payload itself to keep the RAM footprint small.
+*******************************************************************************/
+
+//DOM-IGNORE-BEGIN
+/*******************************************************************************
+* Copyright (C) 2024 Microchip Technology Inc. and its subsidiaries.
+*
+* Subject to your compliance with these terms, you may use Microchip software
+* and any derivatives exclusively with Microchip products. It is your
+* responsibility to comply with third party license terms applicable to your
+* use of third party software (including open source software) that may
+* accompany Microchip software.
+*
+* THIS SOFTWARE IS SUPPLIED BY MICROCHIP "AS IS". NO WARRANTIES, WHETHER
+* EXPRESS, IMPLIED OR STATUTORY, APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED
+* WARRANTIES OF NON-INFRINGEMENT, MERCHANTABILITY, AND FITNESS FOR A
+* PARTICULAR PURPOSE.
+*
+* IN NO EVENT WILL MICROCHIP BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE,
+* INCIDENTAL OR CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND
+* WHATSOEVER RELATED TO THE SOFTWARE, HOWEVER CAUSED, EVEN IF MICROCHIP HAS
+* BEEN ADVISED OF THE POSSIBILITY OR THE DAMAGES ARE FORESEEABLE. TO THE
+* FULLEST EXTENT ALLOWED BY LAW, MICROCHIP'S TOTAL LIABILITY ON ALL CLAIMS IN
+* ANY WAY RELATED TO THIS SOFTWARE WILL NOT EXCEED THE AMOUNT OF FEES, IF ANY,
+* THAT YOU HAVE PAID DIRECTLY TO MICROCHIP FOR THIS SOFTWARE.
+*******************************************************************************/
+//DOM-IGNORE-END
+
+
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Included Files
+// *****************************************************************************
+// *****************************************************************************
+
+#include <string.h>
+#include "app_can_change.h"
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Global Data
+// *****************************************************************************
+// *****************************************************************************
+
+#define APP_CAN_CHANGE_STD_IDS                  2048U
+#define APP_CAN_CHANGE_EXT_MASK                 (APP_CAN_CHANGE_EXT_IDS - 1U)
+/* Slots probed before an extended ID is left untracked */
+#define APP_CAN_CHANGE_EXT_PROBES               8U
+#define APP_CAN_CHANGE_EXT_EMPTY                0xFFFFFFFFUL
+
+typedef struct
+{
+    /* Fingerprint of DLC, flags and payload of the last frame */
+    uint32_t fingerprint;
+    uint32_t suppressed;
+    bool valid;
+} APP_CAN_CHANGE_ENTRY;
+
+typedef struct
+{
+    /* 29-bit ID, APP_CAN_CHANGE_EXT_EMPTY when unused */
+    uint32_t id;
+    APP_CAN_CHANGE_ENTRY entry;
+} APP_CAN_CHANGE_EXT_ENTRY;
+
+static const uint8_t changeDlcLength[16] = {0U, 1U, 2U, 3U, 4U, 5U, 6U, 7U, 8U, 12U, 16U, 20U, 24U, 32U, 48U, 64U};
+
+static APP_CAN_CHANGE_ENTRY changeStd[APP_CAN_CHANGE_STD_IDS];
+static APP_CAN_CHANGE_EXT_ENTRY changeExt[APP_CAN_CHANGE_EXT_IDS];
+static uint32_t changeSuppressedTotal = 0U;
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: CAN Change Filter Routines
+// *****************************************************************************
+// *****************************************************************************
+
+/* FNV-1a over the DLC/flags and the valid payload bytes */
+static uint32_t APP_CAN_ChangeFingerprint(const CAN_RX_BUFFER *rxBuf)
+{
+    uint32_t hash = 2166136261UL;
+    uint32_t length = rxBuf->rtr ? 0U : changeDlcLength[rxBuf->dlc];
+    uint32_t index = 0U;
+
+    hash = (hash ^ (rxBuf->dlc | (rxBuf->rtr << 4) | (rxBuf->fdf << 5) | (rxBuf->brs << 6))) * 16777619UL;
+    for (index = 0U; index < length; index++)
+    {
+        hash = (hash ^ rxBuf->data[index]) * 16777619UL;
+    }
+    return hash;
+}
+
+static APP_CAN_CHANGE_ENTRY *APP_CAN_ChangeEntryGet(uint32_t id, bool xtd, bool allocate)
+{
+    APP_CAN_CHANGE_EXT_ENTRY *slot = NULL;
+    uint32_t index = 0U;
+    uint32_t probe = 0U;
+
+    if (xtd == false)
+    {
+        return &changeStd[id & (APP_CAN_CHANGE_STD_IDS - 1U)];
+    }
+
+    index = (id * 2654435761UL) >> 16;
+    for (probe = 0U; probe < APP_CAN_CHANGE_EXT_PROBES; probe++)
+    {
+        slot = &changeExt[(index + probe) & APP_CAN_CHANGE_EXT_MASK];
+        if (slot->id == id)
+        {
+            return &slot->entry;
+        }
+        if (slot->id == APP_CAN_CHANGE_EXT_EMPTY)
+        {
+            if (allocate == false)
+            {
+                return NULL;
+            }
+            slot->id = id;
+            return &slot->entry;
+        }
+    }
+    return NULL;
+}
+
+void APP_CAN_ChangeReset(void)
+{
+    uint32_t index = 0U;
+
+    memset(changeStd, 0, sizeof(changeStd));
+    memset(changeExt, 0, sizeof(changeExt));
+    for (index = 0U; index < APP_CAN_CHANGE_EXT_IDS; index++)
+    {
+        changeExt[index].id = APP_CAN_CHANGE_EXT_EMPTY;
+    }
+    changeSuppressedTotal = 0U;
+}
+
+bool APP_CAN_ChangeCheck(const CAN_RX_BUFFER *rxBuf)
+{
+    APP_CAN_CHANGE_ENTRY *entry = NULL;
+    uint32_t fingerprint = 0U;
+    uint32_t id = rxBuf->xtd ? rxBuf->id : (rxBuf->id >> 18);
+
+    entry = APP_CAN_ChangeEntryGet(id, rxBuf->xtd, true);
+    if (entry == NULL)
+    {
+        return true;
+    }
+
+    fingerprint = APP_CAN_ChangeFingerprint(rxBuf);
+    if ((entry->valid == true) && (entry->fingerprint == fingerprint))
+    {
+        entry->suppressed++;
+        changeSuppressedTotal++;
+        return false;
+    }
+
+    entry->fingerprint = fingerprint;
+    entry->valid = true;
+    return true;
+}
+
+uint32_t APP_CAN_ChangeSuppressedGet(uint32_t id, bool xtd)
+{
+    APP_CAN_CHANGE_ENTRY *entry = APP_CAN_ChangeEntryGet(id, xtd, false);
+
+    return (entry != NULL) ? entry->suppressed : 0U;
+}
+
+uint32_t APP_CAN_ChangeSuppressedTotalGet(void)
+{
+    return changeSuppressedTotal;
+}
+
+/*******************************************************************************
+ End of File
+*/
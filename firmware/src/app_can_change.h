@@ -0,0 +1,110 @@
+/*******************************************************************************
+  CAN Change Filter Header File
+
+  Company:
+    Microchip Technology Inc.
+
+  File Name:
+    app_can_change.h
+
+  Summary:
+    Changed-only forwarding filter interface.
+
+  Description:
+    This file declares the per-ID last-value cache used to forward only frames
+    whose payload or DLC changed since the previous frame with the same ID.
+*******************************************************************************/
+
+//DOM-IGNORE-BEGIN
+/*******************************************************************************
+* Copyright (C) 2024 Microchip Technology Inc. and its subsidiaries.
+*
+* Subject to your compliance with these terms, you may use Microchip software
+* and any derivatives exclusively with Microchip products. It is your
+* responsibility to comply with third party license terms applicable to your
+* use of third party software (including open source software) that may
+* accompany Microchip software.
+*
+* THIS SOFTWARE IS SUPPLIED BY MICROCHIP "AS IS". NO WARRANTIES, WHETHER
+* EXPRESS, IMPLIED OR STATUTORY, APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED
+* WARRANTIES OF NON-INFRINGEMENT, MERCHANTABILITY, AND FITNESS FOR A
+* PARTICULAR PURPOSE.
+*
+* IN NO EVENT WILL MICROCHIP BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE,
+* INCIDENTAL OR CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND
+* WHATSOEVER RELATED TO THE SOFTWARE, HOWEVER CAUSED, EVEN IF MICROCHIP HAS
+* BEEN ADVISED OF THE POSSIBILITY OR THE DAMAGES ARE FORESEEABLE. TO THE
+* FULLEST EXTENT ALLOWED BY LAW, MICROCHIP'S TOTAL LIABILITY ON ALL CLAIMS IN
+* ANY WAY RELATED TO THIS SOFTWARE WILL NOT EXCEED THE AMOUNT OF FEES, IF ANY,
+* THAT YOU HAVE PAID DIRECTLY TO MICROCHIP FOR THIS SOFTWARE.
+*******************************************************************************/
+//DOM-IGNORE-END
+
+
+
+#ifndef APP_CAN_CHANGE_H
+#define APP_CAN_CHANGE_H
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Included Files
+// *****************************************************************************
+// *****************************************************************************
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "definitions.h"
+
+// DOM-IGNORE-BEGIN
+#ifdef __cplusplus  // Provide C++ Compatibility
+    extern "C" {
+#endif
+// DOM-IGNORE-END
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Data Types
+// *****************************************************************************
+// *****************************************************************************
+
+/* Extended IDs tracked at once, must be a power of two */
+#ifndef APP_CAN_CHANGE_EXT_IDS
+#define APP_CAN_CHANGE_EXT_IDS                  256U
+#endif
+
+#if ((APP_CAN_CHANGE_EXT_IDS & (APP_CAN_CHANGE_EXT_IDS - 1U)) != 0U)
+#error "APP_CAN_CHANGE_EXT_IDS must be a power of two"
+#endif
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Interface Routines
+// *****************************************************************************
+// *****************************************************************************
+
+/* Forgets all IDs and clears the suppressed counters */
+void APP_CAN_ChangeReset(void);
+
+/* Returns true when the frame differs from the last frame seen with the same
+   ID (or the ID is new) and should be forwarded. Returns false, and counts
+   the frame as suppressed, for a duplicate. Extended IDs which do not fit
+   into the hash table are always reported as changed. */
+bool APP_CAN_ChangeCheck(const CAN_RX_BUFFER *rxBuf);
+
+/* Duplicates suppressed for one ID, 0 for IDs which are not tracked */
+uint32_t APP_CAN_ChangeSuppressedGet(uint32_t id, bool xtd);
+
+/* Duplicates suppressed for all IDs */
+uint32_t APP_CAN_ChangeSuppressedTotalGet(void);
+
+// DOM-IGNORE-BEGIN
+#ifdef __cplusplus  // Provide C++ Compatibility
+    }
+#endif
+// DOM-IGNORE-END
+
+#endif // APP_CAN_CHANGE_H
+
+/*******************************************************************************
+ End of File
+*/
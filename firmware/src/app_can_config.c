@@ -0,0 +1,197 @@
+/*******************************************************************************
+  CAN Sniffer Configuration Source File
+
+  Company:
+    Microchip Technology Inc.
+
+  File Name:
+    app_can_config.c
+
+  Summary:
+    Persistent sniffer configuration, implementation.
+
+  Description:
+    This file keeps the sniffer configuration record in the SmartEEPROM. The
+    SmartEEPROM spreads the writes over its flash sectors, a save only writes
+    the words of the record which changed.
+*******************************************************************************/
+
+//DOM-IGNORE-BEGIN
+/*******************************************************************************
+* Copyright (C) 2024 Microchip Technology Inc. and its subsidiaries.
+*
+* Subject to your compliance with these terms, you may use Microchip software
+* and any derivatives exclusively with Microchip products. It is your
+* responsibility to comply with third party license terms applicable to your
+* use of third party software (including open source software) that may
+* accompany Microchip software.
+*
+* THIS SOFTWARE IS SUPPLIED BY MICROCHIP "AS IS". NO WARRANTIES, WHETHER
+* EXPRESS, IMPLIED OR STATUTORY, APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED
+* WARRANTIES OF NON-INFRINGEMENT, MERCHANTABILITY, AND FITNESS FOR A
+* PARTICULAR PURPOSE.
+*
+* IN NO EVENT WILL MICROCHIP BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE,
+* INCIDENTAL OR CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND
+* WHATSOEVER RELATED TO THE SOFTWARE, HOWEVER CAUSED, EVEN IF MICROCHIP HAS
+* BEEN ADVISED OF THE POSSIBILITY OR THE DAMAGES ARE FORESEEABLE. TO THE
+* FULLEST EXTENT ALLOWED BY LAW, MICROCHIP'S TOTAL LIABILITY ON ALL CLAIMS IN
+* ANY WAY RELATED TO THIS SOFTWARE WILL NOT EXCEED THE AMOUNT OF FEES, IF ANY,
+* THAT YOU HAVE PAID DIRECTLY TO MICROCHIP FOR THIS SOFTWARE.
+*******************************************************************************/
+//DOM-IGNORE-END
+
+
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Included Files
+// *****************************************************************************
+// *****************************************************************************
+
+#include <string.h>
+#include <stddef.h>
+#include "app_can_config.h"
+#include "app_can_bitrate.h"
+#include "app_can_record.h"
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Global Data
+// *****************************************************************************
+// *****************************************************************************
+
+#define APP_CAN_CONFIG_WORDS                    (sizeof(APP_CAN_CONFIG) / 4U)
+
+/* The record is at the start of the SmartEEPROM address space */
+static volatile uint32_t * const configEeprom = (volatile uint32_t *)SEEPROM_ADDR;
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: CAN Configuration Routines
+// *****************************************************************************
+// *****************************************************************************
+
+/* Waits for the SmartEEPROM to be ready, false when the fuses leave it
+   disabled or writes are locked */
+static bool APP_CAN_ConfigEepromReady(void)
+{
+    uint32_t status = 0U;
+
+    while (NVMCTRL_SmartEEPROM_IsBusy())
+    {
+        /* Wait for the SmartEEPROM to be initialized or the last write */
+    }
+    status = NVMCTRL_SmartEEPROMStatusGet();
+    return (((status & NVMCTRL_SEESTAT_SBLK_Msk) != 0U) && ((status & NVMCTRL_SEESTAT_LOCK_Msk) == 0U));
+}
+
+static uint16_t APP_CAN_ConfigCrc(const APP_CAN_CONFIG *config)
+{
+    return APP_CAN_RecordCrc16((const uint8_t *)config, offsetof(APP_CAN_CONFIG, crc));
+}
+
+void APP_CAN_ConfigDefaultGet(APP_CAN_CONFIG *config)
+{
+    memset(config, 0, sizeof(*config));
+    config->magic = APP_CAN_CONFIG_MAGIC;
+    config->version = APP_CAN_CONFIG_VERSION;
+    config->length = (uint16_t)sizeof(APP_CAN_CONFIG);
+    config->bitRateProfile = (uint8_t)APP_CAN_BITRATE_PROFILE_DEFAULT;
+}
+
+bool APP_CAN_ConfigLoad(APP_CAN_CONFIG *config)
+{
+    uint32_t *words = (uint32_t *)config;
+    uint32_t index = 0U;
+
+    if (APP_CAN_ConfigEepromReady() == true)
+    {
+        for (index = 0U; index < APP_CAN_CONFIG_WORDS; index++)
+        {
+            words[index] = configEeprom[index];
+        }
+        if ((config->magic == APP_CAN_CONFIG_MAGIC) && (config->version == APP_CAN_CONFIG_VERSION) &&
+            (config->length == sizeof(APP_CAN_CONFIG)) && (config->crc == APP_CAN_ConfigCrc(config)) &&
+            (config->bitRateProfile < APP_CAN_BITRATE_PROFILES))
+        {
+            /* Lines are run as they are, make sure they end */
+            config->hwFilter[APP_CAN_CONFIG_LINE_SIZE - 1U] = '\0';
+            config->swFilter[APP_CAN_CONFIG_LINE_SIZE - 1U] = '\0';
+            config->trigger[APP_CAN_CONFIG_LINE_SIZE - 1U] = '\0';
+            return true;
+        }
+    }
+
+    APP_CAN_ConfigDefaultGet(config);
+    return false;
+}
+
+bool APP_CAN_ConfigSave(const APP_CAN_CONFIG *config)
+{
+    APP_CAN_CONFIG record;
+    const uint32_t *words = (const uint32_t *)&record;
+    uint32_t index = 0U;
+
+    if (APP_CAN_ConfigEepromReady() == false)
+    {
+        return false;
+    }
+
+    memcpy(&record, config, sizeof(record));
+    record.magic = APP_CAN_CONFIG_MAGIC;
+    record.version = APP_CAN_CONFIG_VERSION;
+    record.length = (uint16_t)sizeof(APP_CAN_CONFIG);
+    record.crc = APP_CAN_ConfigCrc(&record);
+
+    /* A reset during the save leaves a record whose CRC does not match, the
+       next boot then uses the defaults */
+    for (index = 0U; index < APP_CAN_CONFIG_WORDS; index++)
+    {
+        if (configEeprom[index] != words[index])
+        {
+            /* The flash recorder does not hold the NVM page buffer across
+               calls, but may have a page write or block erase running */
+            while (NVMCTRL_IsBusy() || NVMCTRL_SmartEEPROM_IsBusy())
+            {
+                /* Wait for the NVM */
+            }
+            configEeprom[index] = words[index];
+        }
+    }
+    while (NVMCTRL_SmartEEPROM_IsBusy())
+    {
+        /* Wait for the last write */
+    }
+
+    for (index = 0U; index < APP_CAN_CONFIG_WORDS; index++)
+    {
+        if (configEeprom[index] != words[index])
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool APP_CAN_ConfigErase(void)
+{
+    if (APP_CAN_ConfigEepromReady() == false)
+    {
+        return false;
+    }
+    while (NVMCTRL_IsBusy())
+    {
+        /* Wait for the NVM */
+    }
+    configEeprom[0] = 0U;
+    while (NVMCTRL_SmartEEPROM_IsBusy())
+    {
+        /* Wait for the write */
+    }
+    return (configEeprom[0] == 0U);
+}
+
+/*******************************************************************************
+ End of File
+*/
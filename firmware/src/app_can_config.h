@@ -0,0 +1,141 @@
+/*******************************************************************************
+  CAN Sniffer Configuration Header File
+
+  Company:
+    Microchip Technology Inc.
+
+  File Name:
+    app_can_config.h
+
+  Summary:
+    Persistent sniffer configuration, interface.
+
+  Description:
+    This file declares the sniffer configuration record kept in the SmartEEPROM,
+    so that the sniffer starts in its last saved configuration after a reset.
+*******************************************************************************/
+
+//DOM-IGNORE-BEGIN
+/*******************************************************************************
+* Copyright (C) 2024 Microchip Technology Inc. and its subsidiaries.
+*
+* Subject to your compliance with these terms, you may use Microchip software
+* and any derivatives exclusively with Microchip products. It is your
+* responsibility to comply with third party license terms applicable to your
+* use of third party software (including open source software) that may
+* accompany Microchip software.
+*
+* THIS SOFTWARE IS SUPPLIED BY MICROCHIP "AS IS". NO WARRANTIES, WHETHER
+* EXPRESS, IMPLIED OR STATUTORY, APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED
+* WARRANTIES OF NON-INFRINGEMENT, MERCHANTABILITY, AND FITNESS FOR A
+* PARTICULAR PURPOSE.
+*
+* IN NO EVENT WILL MICROCHIP BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE,
+* INCIDENTAL OR CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND
+* WHATSOEVER RELATED TO THE SOFTWARE, HOWEVER CAUSED, EVEN IF MICROCHIP HAS
+* BEEN ADVISED OF THE POSSIBILITY OR THE DAMAGES ARE FORESEEABLE. TO THE
+* FULLEST EXTENT ALLOWED BY LAW, MICROCHIP'S TOTAL LIABILITY ON ALL CLAIMS IN
+* ANY WAY RELATED TO THIS SOFTWARE WILL NOT EXCEED THE AMOUNT OF FEES, IF ANY,
+* THAT YOU HAVE PAID DIRECTLY TO MICROCHIP FOR THIS SOFTWARE.
+*******************************************************************************/
+//DOM-IGNORE-END
+
+
+
+#ifndef APP_CAN_CONFIG_H
+#define APP_CAN_CONFIG_H
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Included Files
+// *****************************************************************************
+// *****************************************************************************
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "definitions.h"
+
+// DOM-IGNORE-BEGIN
+#ifdef __cplusplus  // Provide C++ Compatibility
+    extern "C" {
+#endif
+// DOM-IGNORE-END
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Data Types
+// *****************************************************************************
+// *****************************************************************************
+
+/* Longest stored argument line, including the terminating zero */
+#define APP_CAN_CONFIG_LINE_SIZE                128U
+
+#define APP_CAN_CONFIG_MAGIC                    0x47464353UL
+/* Incremented whenever the layout of APP_CAN_CONFIG changes, records of
+   another version are ignored */
+#define APP_CAN_CONFIG_VERSION                  1U
+
+/* Configuration record at the start of the SmartEEPROM, 408 bytes of the 512
+   bytes configured by the NVMCTRL_SEESBLK and NVMCTRL_SEEPSZ fuses
+   (initialization.c). The argument lines are those of the menu commands and
+   are run again after a reset, an empty line leaves the setting at its
+   default. */
+typedef struct
+{
+    uint32_t magic;
+    uint16_t version;
+    /* Bytes of the record */
+    uint16_t length;
+    /* APP_CAN_BITRATE_PROFILE_xxx */
+    uint8_t bitRateProfile;
+    /* Output format of received frames, 0 = text */
+    uint8_t outputMode;
+    /* Only changed frames are forwarded */
+    uint8_t changedOnly;
+    /* 0 normal, 1 bus monitoring, 2 restricted operation */
+    uint8_t busMode;
+    /* Debug and BLE link baud rates, 0 for the generated baud rate */
+    uint32_t debugBaud;
+    uint32_t bleBaud;
+    /* Hardware acceptance filter, software ID filter and trigger */
+    char hwFilter[APP_CAN_CONFIG_LINE_SIZE];
+    char swFilter[APP_CAN_CONFIG_LINE_SIZE];
+    char trigger[APP_CAN_CONFIG_LINE_SIZE];
+    /* CRC-16/CCITT-FALSE of the bytes before it */
+    uint16_t crc;
+    uint16_t reserved2;
+} APP_CAN_CONFIG;
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Interface Routines
+// *****************************************************************************
+// *****************************************************************************
+
+/* Default configuration: generated bit timing and baud rates, text output,
+   no filters and no trigger */
+void APP_CAN_ConfigDefaultGet(APP_CAN_CONFIG *config);
+
+/* Reads the saved record. Returns false and the default configuration when
+   there is no valid record or the SmartEEPROM is not enabled. Does not need
+   any peripheral initialization, so it can run before SYS_Initialize. */
+bool APP_CAN_ConfigLoad(APP_CAN_CONFIG *config);
+
+/* Saves the record, writing only the words which changed. Blocks until the
+   SmartEEPROM has taken all of them, a few milliseconds at most. */
+bool APP_CAN_ConfigSave(const APP_CAN_CONFIG *config);
+
+/* Invalidates the saved record, the next boot uses the defaults */
+bool APP_CAN_ConfigErase(void);
+
+// DOM-IGNORE-BEGIN
+#ifdef __cplusplus  // Provide C++ Compatibility
+    }
+#endif
+// DOM-IGNORE-END
+
+#endif // APP_CAN_CONFIG_H
+
+/*******************************************************************************
+ End of File
+*/
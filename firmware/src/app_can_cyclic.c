@@ -0,0 +1,435 @@
+/*******************************************************************************
+  CAN Cyclic Transmit Source File
+
+  Company:
+    Microchip Technology Inc.
+
+  File Name:
+    app_can_cyclic.c
+
+  Summary:
+    Periodic CAN message scheduler on the CAN1 Tx FIFO, implementation.
+
+  Description:
+    This file implements the cyclic transmit scheduler. TC1 interrupts every
+    millisecond and advances a timer wheel, whose slots list the messages due
+    in that millisecond. The due messages are built with their counter and
+    checksum and go to the Tx FIFO in one batch, and their Tx events give the
+    measured period of every message.
+*******************************************************************************/
+
+//DOM-IGNORE-BEGIN
+/*******************************************************************************
+* Copyright (C) 2024 Microchip Technology Inc. and its subsidiaries.
+*
+* Subject to your compliance with these terms, you may use Microchip software
+* and any derivatives exclusively with Microchip products. It is your
+* responsibility to comply with third party license terms applicable to your
+* use of third party software (including open source software) that may
+* accompany Microchip software.
+*
+* THIS SOFTWARE IS SUPPLIED BY MICROCHIP "AS IS". NO WARRANTIES, WHETHER
+* EXPRESS, IMPLIED OR STATUTORY, APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED
+* WARRANTIES OF NON-INFRINGEMENT, MERCHANTABILITY, AND FITNESS FOR A
+* PARTICULAR PURPOSE.
+*
+* IN NO EVENT WILL MICROCHIP BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE,
+* INCIDENTAL OR CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND
+* WHATSOEVER RELATED TO THE SOFTWARE, HOWEVER CAUSED, EVEN IF MICROCHIP HAS
+* BEEN ADVISED OF THE POSSIBILITY OR THE DAMAGES ARE FORESEEABLE. TO THE
+* FULLEST EXTENT ALLOWED BY LAW, MICROCHIP'S TOTAL LIABILITY ON ALL CLAIMS IN
+* ANY WAY RELATED TO THIS SOFTWARE WILL NOT EXCEED THE AMOUNT OF FEES, IF ANY,
+* THAT YOU HAVE PAID DIRECTLY TO MICROCHIP FOR THIS SOFTWARE.
+*******************************************************************************/
+//DOM-IGNORE-END
+
+
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Included Files
+// *****************************************************************************
+// *****************************************************************************
+
+#include <string.h>
+#include "app_can_cyclic.h"
+#include "app_can_txevent.h"
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Global Data
+// *****************************************************************************
+// *****************************************************************************
+
+#define APP_CAN_CYCLIC_WHEEL_MASK               (APP_CAN_CYCLIC_WHEEL_SLOTS - 1U)
+/* End of a slot list */
+#define APP_CAN_CYCLIC_NONE                     0xFFU
+#define APP_CAN_CYCLIC_DATA_SIZE                8U
+
+/* The message marker holds the message index */
+#if (APP_CAN_CYCLIC_MESSAGES > (APP_CAN_TXEVENT_MARKER_INDEX_Msk + 1U))
+#error "APP_CAN_CYCLIC_MESSAGES must not exceed 128"
+#endif
+
+static APP_CAN_CYCLIC_MESSAGE cyclicMessages[APP_CAN_CYCLIC_MESSAGES];
+static bool cyclicUsed[APP_CAN_CYCLIC_MESSAGES];
+
+/* Timer wheel, written by the TC1 interrupt and with interrupts disabled.
+   Every slot lists its messages in index order, linked through cyclicNext,
+   so messages due together are sent lowest index first. A message stays in
+   the slot of its due tick until the wheel reaches that tick. */
+static uint8_t cyclicWheel[APP_CAN_CYCLIC_WHEEL_SLOTS];
+static uint8_t cyclicNext[APP_CAN_CYCLIC_MESSAGES];
+static uint8_t cyclicSlot[APP_CAN_CYCLIC_MESSAGES];
+/* Next transmission in TC1 ticks since the start */
+static uint32_t cyclicDue[APP_CAN_CYCLIC_MESSAGES];
+/* Tick the next TC1 interrupt handles */
+static volatile uint32_t cyclicTick = 0U;
+static volatile bool cyclicRunning = false;
+static CAN_TX_BUFFER cyclicBatch[CAN1_TX_FIFO_BUFFER_ELEMENTS];
+
+/* late and skipped are counted by the TC1 interrupt, the rest by
+   APP_CAN_CyclicTxEvent from the main loop */
+static APP_CAN_CYCLIC_STATS cyclicStats[APP_CAN_CYCLIC_MESSAGES];
+/* Request and start of frame times of the last Tx event */
+static bool cyclicMeasured[APP_CAN_CYCLIC_MESSAGES];
+static uint32_t cyclicLastRequest[APP_CAN_CYCLIC_MESSAGES];
+static uint32_t cyclicLastStart[APP_CAN_CYCLIC_MESSAGES];
+static uint32_t cyclicEventsLost = 0U;
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: CAN Cyclic Transmit Routines
+// *****************************************************************************
+// *****************************************************************************
+
+/* Inserts a message into a slot list in index order */
+static void APP_CAN_CyclicLink(uint32_t index, uint32_t slot)
+{
+    uint8_t *link = &cyclicWheel[slot];
+
+    while ((*link != APP_CAN_CYCLIC_NONE) && (*link < index))
+    {
+        link = &cyclicNext[*link];
+    }
+    cyclicNext[index] = *link;
+    *link = (uint8_t)index;
+    cyclicSlot[index] = (uint8_t)slot;
+}
+
+static void APP_CAN_CyclicUnlink(uint32_t index)
+{
+    uint8_t *link = &cyclicWheel[cyclicSlot[index]];
+
+    while ((*link != APP_CAN_CYCLIC_NONE) && (*link != index))
+    {
+        link = &cyclicNext[*link];
+    }
+    if (*link == index)
+    {
+        *link = cyclicNext[index];
+    }
+}
+
+/* Puts a message into the wheel at its first tick from cyclicTick on which
+   keeps the offset to the start */
+static void APP_CAN_CyclicPlan(uint32_t index)
+{
+    const APP_CAN_CYCLIC_MESSAGE *message = &cyclicMessages[index];
+    uint32_t due = message->offset;
+
+    if ((int32_t)(cyclicTick - due) > 0)
+    {
+        due += ((cyclicTick - due + message->period - 1U) / message->period) * message->period;
+    }
+    cyclicDue[index] = due;
+    APP_CAN_CyclicLink(index, due & APP_CAN_CYCLIC_WHEEL_MASK);
+}
+
+static uint8_t APP_CAN_CyclicChecksumGet(const APP_CAN_CYCLIC_MESSAGE *message)
+{
+    uint8_t checksum = (message->checksum == APP_CAN_CYCLIC_CHECKSUM_CRC8) ? 0xFFU : 0U;
+    uint32_t byte = 0U;
+    uint32_t bit = 0U;
+
+    for (byte = 0U; byte < message->frame.dlc; byte++)
+    {
+        if (byte == message->checksumByte)
+        {
+            continue;
+        }
+        if (message->checksum == APP_CAN_CYCLIC_CHECKSUM_SUM)
+        {
+            checksum += message->frame.data[byte];
+        }
+        else if (message->checksum == APP_CAN_CYCLIC_CHECKSUM_XOR)
+        {
+            checksum ^= message->frame.data[byte];
+        }
+        else
+        {
+            checksum ^= message->frame.data[byte];
+            for (bit = 0U; bit < 8U; bit++)
+            {
+                checksum = ((checksum & 0x80U) != 0U) ? (uint8_t)((checksum << 1) ^ 0x1DU) : (uint8_t)(checksum << 1);
+            }
+        }
+    }
+    return (message->checksum == APP_CAN_CYCLIC_CHECKSUM_CRC8) ? (uint8_t)(checksum ^ 0xFFU) : checksum;
+}
+
+/* Builds the Tx FIFO element of a message and advances its counter */
+static void APP_CAN_CyclicBuild(uint32_t index, CAN_TX_BUFFER *txBuf)
+{
+    APP_CAN_CYCLIC_MESSAGE *message = &cyclicMessages[index];
+    uint8_t *data = message->frame.data;
+    uint8_t step = 0U;
+
+    if (message->checksum != APP_CAN_CYCLIC_CHECKSUM_NONE)
+    {
+        data[message->checksumByte] = APP_CAN_CyclicChecksumGet(message);
+    }
+    *txBuf = message->frame;
+    /* Store a Tx event, the marker finds the message again */
+    txBuf->efc = 1U;
+    txBuf->mm = (uint8_t)(APP_CAN_TXEVENT_MARKER_CYCLIC | index);
+
+    if (message->counterMask != 0U)
+    {
+        /* Lowest bit of the mask, carries beyond the mask are dropped */
+        step = (uint8_t)(message->counterMask & (uint8_t)(~message->counterMask + 1U));
+        data[message->counterByte] = (uint8_t)((data[message->counterByte] & (uint8_t)~message->counterMask) |
+                                               ((uint8_t)(data[message->counterByte] + step) & message->counterMask));
+    }
+}
+
+/* Handles one tick of the wheel. The due messages of the slot go to the Tx
+   FIFO with one batch, the ones which do not fit are tried again at the next
+   tick. TC1 interrupt context, the same priority as CAN1. */
+static void APP_CAN_CyclicTimerCallback(TC_TIMER_STATUS status, uintptr_t context)
+{
+    uint32_t tick = cyclicTick;
+    uint32_t slot = tick & APP_CAN_CYCLIC_WHEEL_MASK;
+    uint32_t room = CAN1_TxFifoFreeLevelGet();
+    uint32_t count = 0U;
+    uint32_t period = 0U;
+    uint32_t skip = 0U;
+    uint32_t index = cyclicWheel[slot];
+    uint32_t next = 0U;
+
+    (void)status;
+    (void)context;
+    if (cyclicRunning == false)
+    {
+        return;
+    }
+    /* Every message of the slot is linked again, into this or another slot */
+    cyclicWheel[slot] = APP_CAN_CYCLIC_NONE;
+    while (index != APP_CAN_CYCLIC_NONE)
+    {
+        next = cyclicNext[index];
+        if ((int32_t)(cyclicDue[index] - tick) > 0)
+        {
+            /* Due in a later turn of the wheel */
+            APP_CAN_CyclicLink(index, slot);
+        }
+        else if (count >= room)
+        {
+            cyclicStats[index].late++;
+            APP_CAN_CyclicLink(index, (tick + 1U) & APP_CAN_CYCLIC_WHEEL_MASK);
+        }
+        else
+        {
+            APP_CAN_CyclicBuild(index, &cyclicBatch[count]);
+            count++;
+
+            /* The phase is kept, periods already over are left out */
+            period = cyclicMessages[index].period;
+            cyclicDue[index] += period;
+            if ((int32_t)(cyclicDue[index] - tick) <= 0)
+            {
+                skip = ((tick - cyclicDue[index]) / period) + 1U;
+                cyclicStats[index].skipped += skip;
+                cyclicDue[index] += skip * period;
+            }
+            APP_CAN_CyclicLink(index, cyclicDue[index] & APP_CAN_CYCLIC_WHEEL_MASK);
+        }
+        index = next;
+    }
+    cyclicTick = tick + 1U;
+
+    if (count != 0U)
+    {
+        (void)CAN1_MessageTransmitFifoBatch((uint8_t)count, cyclicBatch);
+    }
+}
+
+void APP_CAN_CyclicInitialize(void)
+{
+    TC1_TimerCallbackRegister(APP_CAN_CyclicTimerCallback, 0U);
+}
+
+bool APP_CAN_CyclicSet(uint32_t index, const APP_CAN_CYCLIC_MESSAGE *message)
+{
+    uint32_t length = message->frame.dlc;
+
+    if ((index >= APP_CAN_CYCLIC_MESSAGES) || (message->period == 0U) || (length > APP_CAN_CYCLIC_DATA_SIZE) ||
+        ((message->frame.rtr != 0U) && ((message->counterMask != 0U) || (message->checksum != APP_CAN_CYCLIC_CHECKSUM_NONE))) ||
+        ((message->counterMask != 0U) && (message->counterByte >= length)) ||
+        ((message->checksum != APP_CAN_CYCLIC_CHECKSUM_NONE) && (message->checksumByte >= length)) ||
+        ((message->counterMask != 0U) && (message->checksum != APP_CAN_CYCLIC_CHECKSUM_NONE) &&
+         (message->counterByte == message->checksumByte)) ||
+        (message->checksum > APP_CAN_CYCLIC_CHECKSUM_CRC8))
+    {
+        return false;
+    }
+
+    __disable_irq();
+    if ((cyclicUsed[index] == true) && (cyclicRunning == true))
+    {
+        APP_CAN_CyclicUnlink(index);
+    }
+    cyclicMessages[index] = *message;
+    cyclicUsed[index] = true;
+    memset(&cyclicStats[index], 0, sizeof(cyclicStats[index]));
+    cyclicMeasured[index] = false;
+    if (cyclicRunning == true)
+    {
+        APP_CAN_CyclicPlan(index);
+    }
+    __enable_irq();
+    return true;
+}
+
+void APP_CAN_CyclicRemove(uint32_t index)
+{
+    if (index >= APP_CAN_CYCLIC_MESSAGES)
+    {
+        return;
+    }
+    __disable_irq();
+    if ((cyclicUsed[index] == true) && (cyclicRunning == true))
+    {
+        APP_CAN_CyclicUnlink(index);
+    }
+    cyclicUsed[index] = false;
+    __enable_irq();
+}
+
+bool APP_CAN_CyclicGet(uint32_t index, APP_CAN_CYCLIC_MESSAGE *message)
+{
+    bool used = false;
+
+    if (index >= APP_CAN_CYCLIC_MESSAGES)
+    {
+        return false;
+    }
+    /* The counter and checksum bytes change at every transmission */
+    __disable_irq();
+    used = cyclicUsed[index];
+    *message = cyclicMessages[index];
+    __enable_irq();
+    return used;
+}
+
+void APP_CAN_CyclicStart(void)
+{
+    uint32_t index = 0U;
+
+    TC1_TimerStop();
+    __disable_irq();
+    cyclicRunning = false;
+    memset(cyclicWheel, APP_CAN_CYCLIC_NONE, sizeof(cyclicWheel));
+    memset(cyclicStats, 0, sizeof(cyclicStats));
+    memset(cyclicMeasured, 0, sizeof(cyclicMeasured));
+    cyclicTick = 0U;
+    for (index = 0U; index < APP_CAN_CYCLIC_MESSAGES; index++)
+    {
+        if (cyclicUsed[index] == true)
+        {
+            APP_CAN_CyclicPlan(index);
+        }
+    }
+    cyclicRunning = true;
+    __enable_irq();
+    /* The first tick, which sends the messages of offset 0, is 1 ms from now */
+    TC1_TimerStart();
+    TC1_TimerCommandSet(TC_COMMAND_START_RETRIGGER);
+}
+
+void APP_CAN_CyclicStop(void)
+{
+    TC1_TimerStop();
+    cyclicRunning = false;
+}
+
+bool APP_CAN_CyclicIsRunning(void)
+{
+    return cyclicRunning;
+}
+
+void APP_CAN_CyclicTxEvent(const CAN_TX_EVENT *event)
+{
+    const CAN_TX_EVENT_FIFO *element = &event->element;
+    uint32_t index = element->mm & APP_CAN_TXEVENT_MARKER_INDEX_Msk;
+    uint32_t lost = CAN1_TxEventLostCountGet();
+    APP_CAN_CYCLIC_STATS *stats = NULL;
+    uint32_t requestPeriod = 0U;
+    uint32_t busPeriod = 0U;
+
+    if (((element->mm & APP_CAN_TXEVENT_MARKER_SOURCE_Msk) != APP_CAN_TXEVENT_MARKER_CYCLIC) ||
+        (index >= APP_CAN_CYCLIC_MESSAGES))
+    {
+        return;
+    }
+    /* A lost event would join two periods into one */
+    if (lost != cyclicEventsLost)
+    {
+        cyclicEventsLost = lost;
+        memset(cyclicMeasured, 0, sizeof(cyclicMeasured));
+    }
+
+    stats = &cyclicStats[index];
+    if (cyclicMeasured[index] == true)
+    {
+        requestPeriod = event->queued - cyclicLastRequest[index];
+        busPeriod = event->timestamp - cyclicLastStart[index];
+        if ((stats->periods == 0U) || (requestPeriod < stats->requestPeriodMin))
+        {
+            stats->requestPeriodMin = requestPeriod;
+        }
+        if ((stats->periods == 0U) || (requestPeriod > stats->requestPeriodMax))
+        {
+            stats->requestPeriodMax = requestPeriod;
+        }
+        if ((stats->periods == 0U) || (busPeriod < stats->busPeriodMin))
+        {
+            stats->busPeriodMin = busPeriod;
+        }
+        if ((stats->periods == 0U) || (busPeriod > stats->busPeriodMax))
+        {
+            stats->busPeriodMax = busPeriod;
+        }
+        stats->periods++;
+    }
+    cyclicLastRequest[index] = event->queued;
+    cyclicLastStart[index] = event->timestamp;
+    cyclicMeasured[index] = true;
+    stats->sent++;
+}
+
+void APP_CAN_CyclicStatsGet(uint32_t index, APP_CAN_CYCLIC_STATS *stats)
+{
+    if (index >= APP_CAN_CYCLIC_MESSAGES)
+    {
+        memset(stats, 0, sizeof(*stats));
+        return;
+    }
+    __disable_irq();
+    *stats = cyclicStats[index];
+    __enable_irq();
+}
+
+/*******************************************************************************
+ End of File
+*/
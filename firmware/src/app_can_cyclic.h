@@ -0,0 +1,179 @@
+/*******************************************************************************
+  CAN Cyclic Transmit Header File
+
+  Company:
+    Microchip Technology Inc.
+
+  File Name:
+    app_can_cyclic.h
+
+  Summary:
+    Periodic CAN message scheduler on the CAN1 Tx FIFO, interface.
+
+  Description:
+    This file declares the cyclic transmit scheduler, which sends up to
+    APP_CAN_CYCLIC_MESSAGES periodic messages, each with its own period, phase
+    offset, payload and optional counter and checksum, for rest-bus simulation.
+*******************************************************************************/
+
+//DOM-IGNORE-BEGIN
+/*******************************************************************************
+* Copyright (C) 2024 Microchip Technology Inc. and its subsidiaries.
+*
+* Subject to your compliance with these terms, you may use Microchip software
+* and any derivatives exclusively with Microchip products. It is your
+* responsibility to comply with third party license terms applicable to your
+* use of third party software (including open source software) that may
+* accompany Microchip software.
+*
+* THIS SOFTWARE IS SUPPLIED BY MICROCHIP "AS IS". NO WARRANTIES, WHETHER
+* EXPRESS, IMPLIED OR STATUTORY, APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED
+* WARRANTIES OF NON-INFRINGEMENT, MERCHANTABILITY, AND FITNESS FOR A
+* PARTICULAR PURPOSE.
+*
+* IN NO EVENT WILL MICROCHIP BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE,
+* INCIDENTAL OR CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND
+* WHATSOEVER RELATED TO THE SOFTWARE, HOWEVER CAUSED, EVEN IF MICROCHIP HAS
+* BEEN ADVISED OF THE POSSIBILITY OR THE DAMAGES ARE FORESEEABLE. TO THE
+* FULLEST EXTENT ALLOWED BY LAW, MICROCHIP'S TOTAL LIABILITY ON ALL CLAIMS IN
+* ANY WAY RELATED TO THIS SOFTWARE WILL NOT EXCEED THE AMOUNT OF FEES, IF ANY,
+* THAT YOU HAVE PAID DIRECTLY TO MICROCHIP FOR THIS SOFTWARE.
+*******************************************************************************/
+//DOM-IGNORE-END
+
+
+
+#ifndef APP_CAN_CYCLIC_H
+#define APP_CAN_CYCLIC_H
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Included Files
+// *****************************************************************************
+// *****************************************************************************
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "definitions.h"
+
+// DOM-IGNORE-BEGIN
+#ifdef __cplusplus  // Provide C++ Compatibility
+    extern "C" {
+#endif
+// DOM-IGNORE-END
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Data Types
+// *****************************************************************************
+// *****************************************************************************
+
+/* Periodic messages, at most 128 */
+#ifndef APP_CAN_CYCLIC_MESSAGES
+#define APP_CAN_CYCLIC_MESSAGES                 64U
+#endif
+
+/* Timer wheel slots of one TC1 tick (1 ms) each, must be a power of two.
+   Longer periods take several turns of the wheel. */
+#ifndef APP_CAN_CYCLIC_WHEEL_SLOTS
+#define APP_CAN_CYCLIC_WHEEL_SLOTS              64U
+#endif
+
+#if ((APP_CAN_CYCLIC_WHEEL_SLOTS & (APP_CAN_CYCLIC_WHEEL_SLOTS - 1U)) != 0U)
+#error "APP_CAN_CYCLIC_WHEEL_SLOTS must be a power of two"
+#endif
+
+typedef enum
+{
+    APP_CAN_CYCLIC_CHECKSUM_NONE,
+    /* Sum of the other data bytes, modulo 256 */
+    APP_CAN_CYCLIC_CHECKSUM_SUM,
+    /* XOR of the other data bytes */
+    APP_CAN_CYCLIC_CHECKSUM_XOR,
+    /* SAE J1850 CRC-8 of the other data bytes: polynomial 0x1D, initial
+       value and final XOR 0xFF */
+    APP_CAN_CYCLIC_CHECKSUM_CRC8
+} APP_CAN_CYCLIC_CHECKSUM;
+
+typedef struct
+{
+    /* Identifier, format and data as sent. The scheduler sets efc and mm. */
+    CAN_TX_BUFFER frame;
+    /* Period in milliseconds, not 0 */
+    uint16_t period;
+    /* Milliseconds from the start of the scheduler to the first transmission */
+    uint16_t offset;
+    /* Data byte of the counter, incremented after every transmission. The
+       counter takes the consecutive bits of counterMask, 0 means none. */
+    uint8_t counterByte;
+    uint8_t counterMask;
+    /* Data byte of the checksum, computed over the other data bytes before
+       every transmission */
+    uint8_t checksumByte;
+    APP_CAN_CYCLIC_CHECKSUM checksum;
+} APP_CAN_CYCLIC_MESSAGE;
+
+/* Timing of one message, periods in extended CAN timestamp units between two
+   transmission requests and between two starts of frame on the bus */
+typedef struct
+{
+    /* Frames reported by a Tx event */
+    uint32_t sent;
+    /* Ticks the message was held back because the Tx FIFO was full */
+    uint32_t late;
+    /* Periods left out because the message was held back for a full period */
+    uint32_t skipped;
+    /* Periods measured between two frames with no Tx event lost in between */
+    uint32_t periods;
+    uint32_t requestPeriodMin;
+    uint32_t requestPeriodMax;
+    uint32_t busPeriodMin;
+    uint32_t busPeriodMax;
+} APP_CAN_CYCLIC_STATS;
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Interface Routines
+// *****************************************************************************
+// *****************************************************************************
+
+/* Registers the TC1 callback, call once after the CAN1 configuration */
+void APP_CAN_CyclicInitialize(void);
+
+/* Sets or replaces message index. A message set while the scheduler runs
+   keeps its phase to the start of the scheduler. Returns false for an invalid
+   index, period, counter or checksum byte. */
+bool APP_CAN_CyclicSet(uint32_t index, const APP_CAN_CYCLIC_MESSAGE *message);
+
+/* Stops sending message index */
+void APP_CAN_CyclicRemove(uint32_t index);
+
+/* Gets message index, false when it is not set */
+bool APP_CAN_CyclicGet(uint32_t index, APP_CAN_CYCLIC_MESSAGE *message);
+
+/* Starts the scheduler, the messages are sent at their offset from now and
+   their statistics are cleared */
+void APP_CAN_CyclicStart(void);
+
+/* Stops the scheduler, frames already in the Tx FIFO are sent */
+void APP_CAN_CyclicStop(void);
+
+bool APP_CAN_CyclicIsRunning(void);
+
+/* Accounts the Tx event of a cyclic message, call for every event in
+   transmission order (CAN1_TxEventGet) from the main loop */
+void APP_CAN_CyclicTxEvent(const CAN_TX_EVENT *event);
+
+void APP_CAN_CyclicStatsGet(uint32_t index, APP_CAN_CYCLIC_STATS *stats);
+
+// DOM-IGNORE-BEGIN
+#ifdef __cplusplus  // Provide C++ Compatibility
+    }
+#endif
+// DOM-IGNORE-END
+
+#endif // APP_CAN_CYCLIC_H
+
+/*******************************************************************************
+ End of File
+*/
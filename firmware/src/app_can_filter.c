@@ -0,0 +1,601 @@
+/*******************************************************************************
+  CAN Acceptance Filter Source File
+
+  Company:
+    Microchip Technology Inc.
+
+  File Name:
+    app_can_filter.c
+
+  Summary:
+    CAN1 hardware acceptance filter manager implementation.
+
+  Description:
+    This file implements the filter manager. The set of wanted IDs is compiled
+    into as few filter elements as possible: runs of three or more IDs become
+    range filters, groups of IDs that differ in a few bit positions become
+    classic (ID and mask) filters and the IDs left over are paired into dual ID
+    filters. All of these accept exactly the wanted IDs. If the list of
+    elements does not fit, the runs separated by the smallest gaps are merged
+    into ranges, which accepts a superset of the wanted IDs.
+*******************************************************************************/
+
+//DOM-IGNORE-BEGIN
+/*******************************************************************************
+* Copyright (C) 2024 Microchip Technology Inc. and its subsidiaries.
+*
+* Subject to your compliance with these terms, you may use Microchip software
+* and any derivatives exclusively with Microchip products. It is your
+* responsibility to comply with third party license terms applicable to your
+* use of third party software (including open source software) that may
+* accompany Microchip software.
+*
+* THIS SOFTWARE IS SUPPLIED BY MICROCHIP "AS IS". NO WARRANTIES, WHETHER
+* EXPRESS, IMPLIED OR STATUTORY, APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED
+* WARRANTIES OF NON-INFRINGEMENT, MERCHANTABILITY, AND FITNESS FOR A
+* PARTICULAR PURPOSE.
+*
+* IN NO EVENT WILL MICROCHIP BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE,
+* INCIDENTAL OR CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND
+* WHATSOEVER RELATED TO THE SOFTWARE, HOWEVER CAUSED, EVEN IF MICROCHIP HAS
+* BEEN ADVISED OF THE POSSIBILITY OR THE DAMAGES ARE FORESEEABLE. TO THE
+* FULLEST EXTENT ALLOWED BY LAW, MICROCHIP'S TOTAL LIABILITY ON ALL CLAIMS IN
+* ANY WAY RELATED TO THIS SOFTWARE WILL NOT EXCEED THE AMOUNT OF FEES, IF ANY,
+* THAT YOU HAVE PAID DIRECTLY TO MICROCHIP FOR THIS SOFTWARE.
+*******************************************************************************/
+//DOM-IGNORE-END
+
+
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Included Files
+// *****************************************************************************
+// *****************************************************************************
+
+#include <string.h>
+#include "app_can_filter.h"
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Global Data
+// *****************************************************************************
+// *****************************************************************************
+
+#define APP_CAN_FILTER_STD_ID_MASK              0x7FFUL
+#define APP_CAN_FILTER_EXT_ID_MASK              0x1FFFFFFFUL
+
+/* Filter types, same encoding for SFT and EFT */
+#define APP_CAN_FILTER_RANGE                    0U
+#define APP_CAN_FILTER_DUAL                     1U
+#define APP_CAN_FILTER_CLASSIC                  2U
+
+/* Store in Rx FIFO0 (standard) and Rx FIFO1 (extended), as the default filters */
+#define APP_CAN_FILTER_STD_CONFIG               1UL
+#define APP_CAN_FILTER_EXT_CONFIG               2UL
+
+/* Access to the ID set being compiled */
+typedef struct
+{
+    uint32_t idMask;
+    bool (*wanted)(uint32_t id);
+    /* Finds the first wanted ID at or above id */
+    bool (*next)(uint32_t id, uint32_t *found);
+    bool (*pending)(uint32_t id);
+    void (*pendingSet)(uint32_t id, bool value);
+    void (*emit)(uint32_t index, uint32_t type, uint32_t id1, uint32_t id2);
+} APP_CAN_FILTER_SET;
+
+/* Wanted IDs */
+static uint8_t filterStdSet[APP_CAN_FILTER_STD_SET_SIZE];
+static uint32_t filterExtId[APP_CAN_FILTER_EXT_IDS];
+static uint32_t filterExtCount = 0U;
+static bool filterActive = false;
+
+/* Elements currently programmed, CAN1_MessageRAMConfigSet programs one each */
+static uint32_t filterStdProgrammed = 1U;
+static uint32_t filterExtProgrammed = 1U;
+
+/* Compiler state */
+static const uint8_t *compileStdSet = NULL;
+static const uint32_t *compileExtId = NULL;
+static uint32_t compileExtCount = 0U;
+static can_sidfe_registers_t *compileStdElement = NULL;
+static can_xidfe_registers_t *compileExtElement = NULL;
+static uint8_t compileStdPending[APP_CAN_FILTER_STD_SET_SIZE];
+static bool compileExtPending[APP_CAN_FILTER_EXT_IDS];
+static uint32_t compileCount = 0U;
+static uint32_t compileMax = 0U;
+
+static can_sidfe_registers_t filterStdElement[APP_CAN_FILTER_STD_ELEMENTS];
+static can_xidfe_registers_t filterExtElement[APP_CAN_FILTER_EXT_ELEMENTS];
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: ID Set Access
+// *****************************************************************************
+// *****************************************************************************
+
+static bool APP_CAN_FilterStdWanted(uint32_t id)
+{
+    return (id <= APP_CAN_FILTER_STD_ID_MASK) && ((compileStdSet[id >> 3] & (1U << (id & 7U))) != 0U);
+}
+
+static bool APP_CAN_FilterStdNext(uint32_t id, uint32_t *found)
+{
+    for (; id <= APP_CAN_FILTER_STD_ID_MASK; id++)
+    {
+        /* Skip empty bytes */
+        if (((id & 7U) == 0U) && (compileStdSet[id >> 3] == 0U))
+        {
+            id += 7U;
+            continue;
+        }
+        if (APP_CAN_FilterStdWanted(id))
+        {
+            *found = id;
+            return true;
+        }
+    }
+    return false;
+}
+
+static bool APP_CAN_FilterStdPending(uint32_t id)
+{
+    return (compileStdPending[id >> 3] & (1U << (id & 7U))) != 0U;
+}
+
+static void APP_CAN_FilterStdPendingSet(uint32_t id, bool value)
+{
+    if (value)
+    {
+        compileStdPending[id >> 3] |= (uint8_t)(1U << (id & 7U));
+    }
+    else
+    {
+        compileStdPending[id >> 3] &= (uint8_t)~(1U << (id & 7U));
+    }
+}
+
+static void APP_CAN_FilterStdEmit(uint32_t index, uint32_t type, uint32_t id1, uint32_t id2)
+{
+    compileStdElement[index].CAN_SIDFE_0 = CAN_SIDFE_0_SFT(type) | CAN_SIDFE_0_SFEC(APP_CAN_FILTER_STD_CONFIG) |
+                                           CAN_SIDFE_0_SFID1(id1) | CAN_SIDFE_0_SFID2(id2);
+}
+
+/* Index of the first extended ID at or above id */
+static uint32_t APP_CAN_FilterExtIndex(uint32_t id)
+{
+    uint32_t low = 0U;
+    uint32_t high = compileExtCount;
+    uint32_t middle = 0U;
+
+    while (low < high)
+    {
+        middle = (low + high) / 2U;
+        if (compileExtId[middle] < id)
+        {
+            low = middle + 1U;
+        }
+        else
+        {
+            high = middle;
+        }
+    }
+    return low;
+}
+
+static bool APP_CAN_FilterExtWanted(uint32_t id)
+{
+    uint32_t index = APP_CAN_FilterExtIndex(id);
+
+    return (index < compileExtCount) && (compileExtId[index] == id);
+}
+
+static bool APP_CAN_FilterExtNext(uint32_t id, uint32_t *found)
+{
+    uint32_t index = APP_CAN_FilterExtIndex(id);
+
+    if (index >= compileExtCount)
+    {
+        return false;
+    }
+    *found = compileExtId[index];
+    return true;
+}
+
+static bool APP_CAN_FilterExtPending(uint32_t id)
+{
+    return compileExtPending[APP_CAN_FilterExtIndex(id)];
+}
+
+static void APP_CAN_FilterExtPendingSet(uint32_t id, bool value)
+{
+    compileExtPending[APP_CAN_FilterExtIndex(id)] = value;
+}
+
+static void APP_CAN_FilterExtEmit(uint32_t index, uint32_t type, uint32_t id1, uint32_t id2)
+{
+    compileExtElement[index].CAN_XIDFE_0 = CAN_XIDFE_0_EFID1(id1) | CAN_XIDFE_0_EFEC(APP_CAN_FILTER_EXT_CONFIG);
+    compileExtElement[index].CAN_XIDFE_1 = CAN_XIDFE_1_EFID2(id2) | CAN_XIDFE_1_EFT(type);
+}
+
+static const APP_CAN_FILTER_SET filterStdAccess =
+{
+    APP_CAN_FILTER_STD_ID_MASK, APP_CAN_FilterStdWanted, APP_CAN_FilterStdNext,
+    APP_CAN_FilterStdPending, APP_CAN_FilterStdPendingSet, APP_CAN_FilterStdEmit
+};
+
+static const APP_CAN_FILTER_SET filterExtAccess =
+{
+    APP_CAN_FILTER_EXT_ID_MASK, APP_CAN_FilterExtWanted, APP_CAN_FilterExtNext,
+    APP_CAN_FilterExtPending, APP_CAN_FilterExtPendingSet, APP_CAN_FilterExtEmit
+};
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Filter Compiler
+// *****************************************************************************
+// *****************************************************************************
+
+static bool APP_CAN_FilterEmit(const APP_CAN_FILTER_SET *set, uint32_t type, uint32_t id1, uint32_t id2)
+{
+    if (compileCount >= compileMax)
+    {
+        return false;
+    }
+    set->emit(compileCount, type, id1, id2);
+    compileCount++;
+    return true;
+}
+
+/* Last ID of the run of wanted IDs starting at first */
+static uint32_t APP_CAN_FilterRunEnd(const APP_CAN_FILTER_SET *set, uint32_t first)
+{
+    while ((first < set->idMask) && set->wanted(first + 1U))
+    {
+        first++;
+    }
+    return first;
+}
+
+/* Largest ID/mask group around id that contains wanted IDs only. Bits are
+   released from the mask one at a time, lowest first, as long as the group
+   mirrored in that bit is wanted as well. */
+static uint32_t APP_CAN_FilterGroupGrow(const APP_CAN_FILTER_SET *set, uint32_t id)
+{
+    uint32_t mask = set->idMask;
+    uint32_t bit = 0U;
+    uint32_t free = 0U;
+    uint32_t member = 0U;
+    bool grow = false;
+
+    for (bit = 1U; (bit & set->idMask) != 0U; bit <<= 1)
+    {
+        free = ~mask & set->idMask;
+        member = 0U;
+        grow = true;
+        do
+        {
+            if (set->wanted(((id & mask) | member) ^ bit) == false)
+            {
+                grow = false;
+                break;
+            }
+            member = (member - free) & free;
+        } while (member != 0U);
+
+        if (grow)
+        {
+            mask &= ~bit;
+        }
+    }
+    return mask;
+}
+
+/* Exact compilation, false when the elements do not fit */
+static bool APP_CAN_FilterCompileExact(const APP_CAN_FILTER_SET *set)
+{
+    uint32_t id = 0U;
+    uint32_t last = 0U;
+    uint32_t mask = 0U;
+    uint32_t free = 0U;
+    uint32_t member = 0U;
+    uint32_t count = 0U;
+    uint32_t single = 0U;
+    bool held = false;
+
+    /* Runs of three or more IDs become range filters, the others are pending */
+    while (set->next(id, &id))
+    {
+        last = APP_CAN_FilterRunEnd(set, id);
+        if ((last - id) >= 2U)
+        {
+            if (APP_CAN_FilterEmit(set, APP_CAN_FILTER_RANGE, id, last) == false)
+            {
+                return false;
+            }
+        }
+        else
+        {
+            set->pendingSet(id, true);
+            set->pendingSet(last, true);
+        }
+        if (last >= set->idMask)
+        {
+            break;
+        }
+        id = last + 1U;
+    }
+
+    /* A classic filter takes three or more pending IDs */
+    id = 0U;
+    while (set->next(id, &id))
+    {
+        if (set->pending(id))
+        {
+            mask = APP_CAN_FilterGroupGrow(set, id);
+            free = ~mask & set->idMask;
+            count = 0U;
+            member = 0U;
+            do
+            {
+                count += set->pending((id & mask) | member) ? 1U : 0U;
+                member = (member - free) & free;
+            } while (member != 0U);
+
+            if (count >= 3U)
+            {
+                if (APP_CAN_FilterEmit(set, APP_CAN_FILTER_CLASSIC, id & mask, mask) == false)
+                {
+                    return false;
+                }
+                do
+                {
+                    set->pendingSet((id & mask) | member, false);
+                    member = (member - free) & free;
+                } while (member != 0U);
+            }
+        }
+        if (id >= set->idMask)
+        {
+            break;
+        }
+        id++;
+    }
+
+    /* The rest are paired into dual ID filters */
+    id = 0U;
+    while (set->next(id, &id))
+    {
+        if (set->pending(id))
+        {
+            if (held)
+            {
+                if (APP_CAN_FilterEmit(set, APP_CAN_FILTER_DUAL, single, id) == false)
+                {
+                    return false;
+                }
+            }
+            single = id;
+            held = !held;
+        }
+        if (id >= set->idMask)
+        {
+            break;
+        }
+        id++;
+    }
+    if (held)
+    {
+        return APP_CAN_FilterEmit(set, APP_CAN_FILTER_DUAL, single, single);
+    }
+    return true;
+}
+
+/* Walks the runs of wanted IDs, merging runs separated by at most gap
+   unwanted IDs. Emits range filters when emit is true, returns the count. */
+static uint32_t APP_CAN_FilterMergedRanges(const APP_CAN_FILTER_SET *set, uint32_t gap, bool emit)
+{
+    uint32_t id = 0U;
+    uint32_t first = 0U;
+    uint32_t last = 0U;
+    uint32_t count = 0U;
+    bool open = false;
+
+    while (set->next(id, &id))
+    {
+        if (open && ((id - last - 1U) > gap))
+        {
+            if (emit)
+            {
+                (void)APP_CAN_FilterEmit(set, APP_CAN_FILTER_RANGE, first, last);
+            }
+            count++;
+            open = false;
+        }
+        if (open == false)
+        {
+            first = id;
+            open = true;
+        }
+        last = APP_CAN_FilterRunEnd(set, id);
+        if (last >= set->idMask)
+        {
+            break;
+        }
+        id = last + 1U;
+    }
+    if (open)
+    {
+        if (emit)
+        {
+            (void)APP_CAN_FilterEmit(set, APP_CAN_FILTER_RANGE, first, last);
+        }
+        count++;
+    }
+    return count;
+}
+
+static uint32_t APP_CAN_FilterCompile(const APP_CAN_FILTER_SET *set, uint32_t maxElements, bool exactPossible, bool *exact)
+{
+    uint32_t low = 0U;
+    uint32_t high = set->idMask;
+    uint32_t middle = 0U;
+
+    compileCount = 0U;
+    compileMax = maxElements;
+    *exact = true;
+
+    if (exactPossible && APP_CAN_FilterCompileExact(set))
+    {
+        return compileCount;
+    }
+
+    /* Smallest gap that leaves no more ranges than elements */
+    while (low < high)
+    {
+        middle = low + ((high - low) / 2U);
+        if (APP_CAN_FilterMergedRanges(set, middle, false) <= maxElements)
+        {
+            high = middle;
+        }
+        else
+        {
+            low = middle + 1U;
+        }
+    }
+    compileCount = 0U;
+    (void)APP_CAN_FilterMergedRanges(set, low, true);
+    *exact = (low == 0U);
+    return compileCount;
+}
+
+uint32_t APP_CAN_FilterStdCompile(const uint8_t *set, can_sidfe_registers_t *element,
+                                  uint32_t maxElements, bool *exact)
+{
+    compileStdSet = set;
+    compileStdElement = element;
+    memset(compileStdPending, 0, sizeof(compileStdPending));
+
+    return APP_CAN_FilterCompile(&filterStdAccess, maxElements, true, exact);
+}
+
+uint32_t APP_CAN_FilterExtCompile(const uint32_t *id, uint32_t count, can_xidfe_registers_t *element,
+                                  uint32_t maxElements, bool *exact)
+{
+    compileExtId = id;
+    compileExtCount = count;
+    compileExtElement = element;
+    memset(compileExtPending, 0, sizeof(compileExtPending));
+
+    /* Pending flags are kept for up to APP_CAN_FILTER_EXT_IDS IDs */
+    return APP_CAN_FilterCompile(&filterExtAccess, maxElements, (count <= APP_CAN_FILTER_EXT_IDS), exact);
+}
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: CAN Acceptance Filter Routines
+// *****************************************************************************
+// *****************************************************************************
+
+void APP_CAN_FilterClear(void)
+{
+    memset(filterStdSet, 0, sizeof(filterStdSet));
+    filterExtCount = 0U;
+    filterActive = false;
+}
+
+bool APP_CAN_FilterIdAdd(uint32_t id, bool xtd)
+{
+    uint32_t index = 0U;
+
+    if (xtd == false)
+    {
+        if (id > APP_CAN_FILTER_STD_ID_MASK)
+        {
+            return false;
+        }
+        filterStdSet[id >> 3] |= (uint8_t)(1U << (id & 7U));
+        filterActive = true;
+        return true;
+    }
+
+    if (id > APP_CAN_FILTER_EXT_ID_MASK)
+    {
+        return false;
+    }
+    /* Kept in ascending order */
+    compileExtId = filterExtId;
+    compileExtCount = filterExtCount;
+    index = APP_CAN_FilterExtIndex(id);
+    if ((index < filterExtCount) && (filterExtId[index] == id))
+    {
+        filterActive = true;
+        return true;
+    }
+    if (filterExtCount >= APP_CAN_FILTER_EXT_IDS)
+    {
+        return false;
+    }
+    memmove(&filterExtId[index + 1U], &filterExtId[index], (filterExtCount - index) * sizeof(filterExtId[0]));
+    filterExtId[index] = id;
+    filterExtCount++;
+    filterActive = true;
+    return true;
+}
+
+void APP_CAN_FilterApply(APP_CAN_FILTER_STATUS *status)
+{
+    can_sidfe_registers_t stdDisabled = {0};
+    can_xidfe_registers_t extDisabled = {0};
+    uint32_t index = 0U;
+
+    if (filterActive == false)
+    {
+        /* Accept all, as CAN1_MessageRAMConfigSet */
+        filterStdElement[0].CAN_SIDFE_0 = CAN_SIDFE_0_SFT(APP_CAN_FILTER_RANGE) | CAN_SIDFE_0_SFID1(0UL) |
+                                          CAN_SIDFE_0_SFID2(APP_CAN_FILTER_STD_ID_MASK) |
+                                          CAN_SIDFE_0_SFEC(APP_CAN_FILTER_STD_CONFIG);
+        filterExtElement[0].CAN_XIDFE_0 = CAN_XIDFE_0_EFID1(0UL) | CAN_XIDFE_0_EFEC(APP_CAN_FILTER_EXT_CONFIG);
+        filterExtElement[0].CAN_XIDFE_1 = CAN_XIDFE_1_EFID2(APP_CAN_FILTER_EXT_ID_MASK) |
+                                          CAN_XIDFE_1_EFT(APP_CAN_FILTER_RANGE);
+        status->stdElements = 1U;
+        status->extElements = 1U;
+        status->stdExact = true;
+        status->extExact = true;
+    }
+    else
+    {
+        status->stdElements = APP_CAN_FilterStdCompile(filterStdSet, filterStdElement,
+                                                       APP_CAN_FILTER_STD_ELEMENTS, &status->stdExact);
+        status->extElements = APP_CAN_FilterExtCompile(filterExtId, filterExtCount, filterExtElement,
+                                                       APP_CAN_FILTER_EXT_ELEMENTS, &status->extExact);
+    }
+
+    /* Filter elements can be written while the CAN is running, the list
+       changes over one element at a time */
+    for (index = 0U; index < status->stdElements; index++)
+    {
+        (void)CAN1_StandardFilterElementSet((uint8_t)(index + 1U), &filterStdElement[index]);
+    }
+    for (; index < filterStdProgrammed; index++)
+    {
+        (void)CAN1_StandardFilterElementSet((uint8_t)(index + 1U), &stdDisabled);
+    }
+    filterStdProgrammed = status->stdElements;
+
+    for (index = 0U; index < status->extElements; index++)
+    {
+        (void)CAN1_ExtendedFilterElementSet((uint8_t)(index + 1U), &filterExtElement[index]);
+    }
+    for (; index < filterExtProgrammed; index++)
+    {
+        (void)CAN1_ExtendedFilterElementSet((uint8_t)(index + 1U), &extDisabled);
+    }
+    filterExtProgrammed = status->extElements;
+}
+
+/*******************************************************************************
+ End of File
+*/
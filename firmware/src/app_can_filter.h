@@ -0,0 +1,126 @@
+/*******************************************************************************
+  CAN Acceptance Filter Header File
+
+  Company:
+    Microchip Technology Inc.
+
+  File Name:
+    app_can_filter.h
+
+  Summary:
+    CAN1 hardware acceptance filter manager interface.
+
+  Description:
+    This file declares the filter manager, which turns a set of wanted CAN IDs
+    into CAN1 standard and extended message ID filter elements at runtime.
+*******************************************************************************/
+
+//DOM-IGNORE-BEGIN
+/*******************************************************************************
+* Copyright (C) 2024 Microchip Technology Inc. and its subsidiaries.
+*
+* Subject to your compliance with these terms, you may use Microchip software
+* and any derivatives exclusively with Microchip products. It is your
+* responsibility to comply with third party license terms applicable to your
+* use of third party software (including open source software) that may
+* accompany Microchip software.
+*
+* THIS SOFTWARE IS SUPPLIED BY MICROCHIP "AS IS". NO WARRANTIES, WHETHER
+* EXPRESS, IMPLIED OR STATUTORY, APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED
+* WARRANTIES OF NON-INFRINGEMENT, MERCHANTABILITY, AND FITNESS FOR A
+* PARTICULAR PURPOSE.
+*
+* IN NO EVENT WILL MICROCHIP BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE,
+* INCIDENTAL OR CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND
+* WHATSOEVER RELATED TO THE SOFTWARE, HOWEVER CAUSED, EVEN IF MICROCHIP HAS
+* BEEN ADVISED OF THE POSSIBILITY OR THE DAMAGES ARE FORESEEABLE. TO THE
+* FULLEST EXTENT ALLOWED BY LAW, MICROCHIP'S TOTAL LIABILITY ON ALL CLAIMS IN
+* ANY WAY RELATED TO THIS SOFTWARE WILL NOT EXCEED THE AMOUNT OF FEES, IF ANY,
+* THAT YOU HAVE PAID DIRECTLY TO MICROCHIP FOR THIS SOFTWARE.
+*******************************************************************************/
+//DOM-IGNORE-END
+
+
+
+#ifndef APP_CAN_FILTER_H
+#define APP_CAN_FILTER_H
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Included Files
+// *****************************************************************************
+// *****************************************************************************
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "definitions.h"
+
+// DOM-IGNORE-BEGIN
+#ifdef __cplusplus  // Provide C++ Compatibility
+    extern "C" {
+#endif
+// DOM-IGNORE-END
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Data Types
+// *****************************************************************************
+// *****************************************************************************
+
+/* Filter elements available to the filter manager */
+#define APP_CAN_FILTER_STD_ELEMENTS             CAN1_STD_MSG_ID_FILTER_ELEMENTS
+#define APP_CAN_FILTER_EXT_ELEMENTS             CAN1_EXT_MSG_ID_FILTER_ELEMENTS
+
+/* Size of the standard ID set in bytes, one bit per ID */
+#define APP_CAN_FILTER_STD_SET_SIZE             256U
+/* Maximum number of wanted extended IDs */
+#define APP_CAN_FILTER_EXT_IDS                  256U
+
+typedef struct
+{
+    /* Filter elements in use */
+    uint32_t stdElements;
+    uint32_t extElements;
+    /* false when a superset of the wanted IDs is accepted */
+    bool stdExact;
+    bool extExact;
+} APP_CAN_FILTER_STATUS;
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Interface Routines
+// *****************************************************************************
+// *****************************************************************************
+
+/* Empties the set of wanted IDs. An empty set accepts all frames. */
+void APP_CAN_FilterClear(void);
+
+/* Adds an ID to the set. Once the set is not empty only the frames with
+   wanted IDs are accepted, of both standard and extended format. Returns
+   false when the ID is invalid or the extended ID set is full. */
+bool APP_CAN_FilterIdAdd(uint32_t id, bool xtd);
+
+/* Compiles the set and programs the CAN1 filter elements */
+void APP_CAN_FilterApply(APP_CAN_FILTER_STATUS *status);
+
+/* Compiles a standard ID set (bit n of byte n / 8 set for wanted ID n) into
+   at most maxElements filter elements. Returns the number of elements. */
+uint32_t APP_CAN_FilterStdCompile(const uint8_t *set, can_sidfe_registers_t *element,
+                                  uint32_t maxElements, bool *exact);
+
+/* Compiles count ascending, unique extended IDs into at most maxElements
+   filter elements. Returns the number of elements. */
+uint32_t APP_CAN_FilterExtCompile(const uint32_t *id, uint32_t count, can_xidfe_registers_t *element,
+                                  uint32_t maxElements, bool *exact);
+
+// DOM-IGNORE-BEGIN
+#ifdef __cplusplus  // Provide C++ Compatibility
+    }
+#endif
+// DOM-IGNORE-END
+
+#endif // APP_CAN_FILTER_H
+
+/*******************************************************************************
+ End of File
+*/
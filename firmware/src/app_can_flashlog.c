@@ -0,0 +1,874 @@
+/*******************************************************************************
+  CAN Flash Recorder Source File
+
+  Company:
+    Microchip Technology Inc.
+
+  File Name:
+    app_can_flashlog.c
+
+  Summary:
+    Black-box recorder of CAN frames in internal flash, implementation.
+
+  Description:
+    This file implements the flash recorder. Frames are packed into 512 byte
+    pages in RAM (page header followed by packed records), and full pages are
+    written through the NVMCTRL page buffer. The log area is reused
+    circularly: the block after the one being written is erased ahead of the
+    write pointer. All NVM operations are started from APP_CAN_FlashLogTasks
+    without waiting, and the log area is in flash bank B so that code in
+    bank A keeps running while a block is erased. After a reset the write
+    position is recovered from the page sequence numbers.
+*******************************************************************************/
+
+//DOM-IGNORE-BEGIN
+/*******************************************************************************
+* Copyright (C) 2024 Microchip Technology Inc. and its subsidiaries.
+*
+* Subject to your compliance with these terms, you may use Microchip software
+* and any derivatives exclusively with Microchip products. It is your
+* responsibility to comply with third party license terms applicable to your
+* use of third party software (including open source software) that may
+* accompany Microchip software.
+*
+* THIS SOFTWARE IS SUPPLIED BY MICROCHIP "AS IS". NO WARRANTIES, WHETHER
+* EXPRESS, IMPLIED OR STATUTORY, APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED
+* WARRANTIES OF NON-INFRINGEMENT, MERCHANTABILITY, AND FITNESS FOR A
+* PARTICULAR PURPOSE.
+*
+* IN NO EVENT WILL MICROCHIP BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE,
+* INCIDENTAL OR CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND
+* WHATSOEVER RELATED TO THE SOFTWARE, HOWEVER CAUSED, EVEN IF MICROCHIP HAS
+* BEEN ADVISED OF THE POSSIBILITY OR THE DAMAGES ARE FORESEEABLE. TO THE
+* FULLEST EXTENT ALLOWED BY LAW, MICROCHIP'S TOTAL LIABILITY ON ALL CLAIMS IN
+* ANY WAY RELATED TO THIS SOFTWARE WILL NOT EXCEED THE AMOUNT OF FEES, IF ANY,
+* THAT YOU HAVE PAID DIRECTLY TO MICROCHIP FOR THIS SOFTWARE.
+*******************************************************************************/
+//DOM-IGNORE-END
+
+
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Included Files
+// *****************************************************************************
+// *****************************************************************************
+
+#include <string.h>
+#include "definitions.h"
+#include "app_can_flashlog.h"
+#include "app_can_record.h"
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Global Data
+// *****************************************************************************
+// *****************************************************************************
+
+/* Pages buffered in RAM while the NVM is busy, must be a power of two */
+#define APP_CAN_FLASHLOG_BUFFER_PAGES           8U
+
+#define APP_CAN_FLASHLOG_PAGE_WORDS             (APP_CAN_FLASHLOG_PAGE_SIZE / 4U)
+#define APP_CAN_FLASHLOG_DATA_SIZE              (APP_CAN_FLASHLOG_PAGE_SIZE - sizeof(APP_CAN_FLASHLOG_PAGE_HEADER))
+/* Checkpoint words: magic, write page | (ready block + 1) << 16 | frozen << 31,
+   sequence, check */
+#define APP_CAN_FLASHLOG_CHECKPOINT_WORDS       4U
+#define APP_CAN_FLASHLOG_CHECKPOINT_MAGIC       0x4B504843UL
+#define APP_CAN_FLASHLOG_CHECKPOINT_FROZEN      0x80000000UL
+
+#define APP_CAN_FLASHLOG_NVM_ERRORS             (NVMCTRL_INTFLAG_ADDRE_Msk | NVMCTRL_INTFLAG_PROGE_Msk | \
+                                                 NVMCTRL_INTFLAG_LOCKE_Msk | NVMCTRL_INTFLAG_NVME_Msk)
+
+static uint32_t flashLogBuffer[APP_CAN_FLASHLOG_BUFFER_PAGES][APP_CAN_FLASHLOG_PAGE_WORDS];
+/* Free running: page being filled, oldest page waiting to be written */
+static uint32_t flashLogBufferHead = 0U;
+static uint32_t flashLogBufferTail = 0U;
+/* Page being filled */
+static uint32_t flashLogFillLength = 0U;
+static uint32_t flashLogFillCount = 0U;
+static uint32_t flashLogFillTimestamp = 0U;
+
+/* Next page to write and its sequence number */
+static uint32_t flashLogWritePage = 0U;
+static uint32_t flashLogSequence = 1U;
+/* Block erased and not written since, -1 for none */
+static int32_t flashLogBlockReady = -1;
+static bool flashLogEraseAhead = false;
+static uint32_t flashLogEraseAheadBlock = 0U;
+/* Next block to erase while erasing the whole log */
+static uint32_t flashLogEraseBlock = 0U;
+static bool flashLogNvmActive = false;
+
+/* Checkpoint read from the RTC backup registers before the RTC is reset */
+static uint32_t flashLogCheckpoint[APP_CAN_FLASHLOG_CHECKPOINT_WORDS];
+
+static APP_CAN_FLASHLOG_STATE flashLogState = APP_CAN_FLASHLOG_STATE_OFF;
+static bool flashLogFreezeEnable = false;
+static uint32_t flashLogFreezePost = 0U;
+static uint32_t flashLogFreezeRemaining = 0U;
+static volatile bool flashLogEventPending = false;
+static uint32_t flashLogDropped = 0U;
+static uint32_t flashLogErrors = 0U;
+
+/* Summary of the block being written, in the layout of its last page */
+static uint32_t flashLogIndexPage[APP_CAN_FLASHLOG_PAGE_WORDS];
+static APP_CAN_FLASHLOG_BLOCK_INDEX * const flashLogIndex = (APP_CAN_FLASHLOG_BLOCK_INDEX *)flashLogIndexPage;
+
+/* Reader */
+static uint32_t flashLogReadBuffer[APP_CAN_FLASHLOG_PAGE_WORDS];
+static uint32_t flashLogReadBlock = 0U;
+/* Next page in the block, APP_CAN_FLASHLOG_PAGES_PER_BLOCK - 1 at its end */
+static uint32_t flashLogReadBlockPage = 0U;
+static uint32_t flashLogReadRemaining = 0U;
+static uint32_t flashLogReadOffset = 0U;
+static uint32_t flashLogReadLength = 0U;
+static APP_CAN_FLASHLOG_QUERY flashLogQuery;
+static bool flashLogQueryActive = false;
+static uint32_t flashLogReadSkipped = 0U;
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: CAN Flash Recorder Routines
+// *****************************************************************************
+// *****************************************************************************
+
+static uint32_t APP_CAN_FlashLogPageAddress(uint32_t page)
+{
+    return APP_CAN_FLASHLOG_START + (page * APP_CAN_FLASHLOG_PAGE_SIZE);
+}
+
+static uint16_t APP_CAN_FlashLogPageCrc(uint32_t *page)
+{
+    APP_CAN_FLASHLOG_PAGE_HEADER *header = (APP_CAN_FLASHLOG_PAGE_HEADER *)page;
+    uint16_t crc = header->crc;
+    uint16_t result = 0U;
+
+    header->crc = 0U;
+    result = APP_CAN_RecordCrc16((const uint8_t *)page, sizeof(APP_CAN_FLASHLOG_PAGE_HEADER) + header->length);
+    header->crc = crc;
+    return result;
+}
+
+static uint32_t APP_CAN_FlashLogLoad32(const uint8_t *data)
+{
+    return (uint32_t)data[0] | ((uint32_t)data[1] << 8) | ((uint32_t)data[2] << 16) | ((uint32_t)data[3] << 24);
+}
+
+/* ID word of a packed record: ID and XTD bit */
+static uint32_t APP_CAN_FlashLogRecordKey(const uint8_t *raw)
+{
+    return APP_CAN_FlashLogLoad32(&raw[4]) & (APP_CAN_RECORD_ID_XTD | 0x1FFFFFFFUL);
+}
+
+/* Three Bloom filter bit numbers of an ID from one mixed hash */
+static uint32_t APP_CAN_FlashLogBloomHash(uint32_t key)
+{
+    uint32_t hash = key * 2654435761UL;
+
+    hash ^= hash >> 15;
+    hash *= 0x2C1B3C6DUL;
+    hash ^= hash >> 12;
+    return hash;
+}
+
+#define APP_CAN_FLASHLOG_BLOOM_BIT(hash, n)     (((hash) >> ((n) * 10U)) & (APP_CAN_FLASHLOG_BLOOM_BITS - 1U))
+
+static void APP_CAN_FlashLogBloomAdd(uint32_t *bloom, uint32_t key)
+{
+    uint32_t hash = APP_CAN_FlashLogBloomHash(key);
+    uint32_t n = 0U;
+    uint32_t bit = 0U;
+
+    for (n = 0U; n < 3U; n++)
+    {
+        bit = APP_CAN_FLASHLOG_BLOOM_BIT(hash, n);
+        bloom[bit / 32U] |= (1UL << (bit % 32U));
+    }
+}
+
+static bool APP_CAN_FlashLogBloomTest(const uint32_t *bloom, uint32_t key)
+{
+    uint32_t hash = APP_CAN_FlashLogBloomHash(key);
+    uint32_t n = 0U;
+    uint32_t bit = 0U;
+
+    for (n = 0U; n < 3U; n++)
+    {
+        bit = APP_CAN_FLASHLOG_BLOOM_BIT(hash, n);
+        if ((bloom[bit / 32U] & (1UL << (bit % 32U))) == 0U)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+/* Starts the summary of a new block, unused bytes of the page stay erased */
+static void APP_CAN_FlashLogIndexReset(void)
+{
+    memset(flashLogIndexPage, 0xFF, sizeof(flashLogIndexPage));
+    flashLogIndex->magic = APP_CAN_FLASHLOG_INDEX_MAGIC;
+    flashLogIndex->firstSequence = 0U;
+    flashLogIndex->frames = 0U;
+    memset(flashLogIndex->bloom, 0, sizeof(flashLogIndex->bloom));
+}
+
+/* Widens the time range of the summary to a timestamp. Timestamps restart
+   after a reset, which may happen within a block, so the range grows at the
+   end nearer to the timestamp, and covers all timestamps once it reaches
+   half of their range. */
+static void APP_CAN_FlashLogIndexTime(uint32_t timestamp)
+{
+    uint32_t first = flashLogIndex->firstTimestamp;
+    uint32_t last = flashLogIndex->lastTimestamp;
+
+    if (flashLogIndex->frames == 0U)
+    {
+        first = timestamp;
+        last = timestamp;
+    }
+    else if ((uint32_t)(timestamp - first) <= (uint32_t)(last - first))
+    {
+        return;
+    }
+    else if ((uint32_t)(timestamp - last) <= (uint32_t)(first - timestamp))
+    {
+        last = timestamp;
+    }
+    else
+    {
+        first = timestamp;
+    }
+    if ((uint32_t)(last - first) >= 0x80000000UL)
+    {
+        last = first - 1U;
+    }
+    flashLogIndex->firstTimestamp = first;
+    flashLogIndex->lastTimestamp = last;
+}
+
+/* Adds the frames of a data page to the summary of its block */
+static void APP_CAN_FlashLogIndexAdd(const uint32_t *page)
+{
+    const APP_CAN_FLASHLOG_PAGE_HEADER *header = (const APP_CAN_FLASHLOG_PAGE_HEADER *)page;
+    const uint8_t *data = (const uint8_t *)page + sizeof(APP_CAN_FLASHLOG_PAGE_HEADER);
+    uint32_t offset = 0U;
+
+    if (flashLogIndex->firstSequence == 0U)
+    {
+        flashLogIndex->firstSequence = header->sequence;
+    }
+    while (offset < header->length)
+    {
+        APP_CAN_FlashLogIndexTime(APP_CAN_FlashLogLoad32(&data[offset]));
+        flashLogIndex->frames++;
+        APP_CAN_FlashLogBloomAdd(flashLogIndex->bloom, APP_CAN_FlashLogRecordKey(&data[offset]));
+        offset += (uint32_t)APP_CAN_RecordPackedSize(&data[offset]);
+    }
+}
+
+static uint16_t APP_CAN_FlashLogIndexCrc(APP_CAN_FLASHLOG_BLOCK_INDEX *index)
+{
+    uint16_t crc = index->crc;
+    uint16_t result = 0U;
+
+    index->crc = 0U;
+    result = APP_CAN_RecordCrc16((const uint8_t *)index, sizeof(*index));
+    index->crc = crc;
+    return result;
+}
+
+/* Reads a page into buffer, true if it holds a valid log page */
+static bool APP_CAN_FlashLogPageRead(uint32_t page, uint32_t *buffer)
+{
+    const APP_CAN_FLASHLOG_PAGE_HEADER *header = (const APP_CAN_FLASHLOG_PAGE_HEADER *)buffer;
+
+    (void)NVMCTRL_Read(buffer, APP_CAN_FLASHLOG_PAGE_SIZE, APP_CAN_FlashLogPageAddress(page));
+    return (header->magic == APP_CAN_FLASHLOG_MAGIC) && (header->length <= APP_CAN_FLASHLOG_DATA_SIZE) &&
+           (header->crc == APP_CAN_FlashLogPageCrc(buffer));
+}
+
+static bool APP_CAN_FlashLogPageBlank(const uint32_t *buffer)
+{
+    uint32_t index = 0U;
+
+    for (index = 0U; index < APP_CAN_FLASHLOG_PAGE_WORDS; index++)
+    {
+        if (buffer[index] != 0xFFFFFFFFUL)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+/* Finishes the page being filled, false if there is none */
+static bool APP_CAN_FlashLogPageClose(uint8_t flags)
+{
+    uint32_t *page = flashLogBuffer[flashLogBufferHead & (APP_CAN_FLASHLOG_BUFFER_PAGES - 1U)];
+    APP_CAN_FLASHLOG_PAGE_HEADER *header = (APP_CAN_FLASHLOG_PAGE_HEADER *)page;
+
+    if ((flashLogBufferHead - flashLogBufferTail) >= APP_CAN_FLASHLOG_BUFFER_PAGES)
+    {
+        return false;
+    }
+
+    header->magic = APP_CAN_FLASHLOG_MAGIC;
+    header->sequence = flashLogSequence++;
+    header->timestamp = flashLogFillTimestamp;
+    header->length = (uint16_t)flashLogFillLength;
+    header->count = (uint8_t)flashLogFillCount;
+    header->flags = flags;
+    header->reserved = 0xFFFFU;
+    header->crc = APP_CAN_FlashLogPageCrc(page);
+    /* Unused bytes stay erased */
+    memset((uint8_t *)page + sizeof(APP_CAN_FLASHLOG_PAGE_HEADER) + flashLogFillLength, 0xFF,
+           APP_CAN_FLASHLOG_DATA_SIZE - flashLogFillLength);
+
+    flashLogBufferHead++;
+    flashLogFillLength = 0U;
+    flashLogFillCount = 0U;
+    return true;
+}
+
+/* Writes the last page with the frozen flag */
+static void APP_CAN_FlashLogFreeze(void)
+{
+    if (APP_CAN_FlashLogPageClose(APP_CAN_FLASHLOG_PAGE_FROZEN))
+    {
+        flashLogState = APP_CAN_FLASHLOG_STATE_FROZEN;
+    }
+}
+
+static void APP_CAN_FlashLogEventCheck(void)
+{
+    if (flashLogEventPending == false)
+    {
+        return;
+    }
+    flashLogEventPending = false;
+    if ((flashLogState == APP_CAN_FLASHLOG_STATE_RECORDING) && flashLogFreezeEnable)
+    {
+        flashLogFreezeRemaining = flashLogFreezePost;
+        flashLogState = APP_CAN_FLASHLOG_STATE_FREEZING;
+    }
+}
+
+static void APP_CAN_FlashLogNvmStart(void)
+{
+    flashLogNvmActive = true;
+}
+
+/* Covers the flash bank mapping as well, after a bank swap the log area is
+   in the other bank and the checkpoint does not apply */
+static uint32_t APP_CAN_FlashLogCheckpointCheck(uint32_t position, uint32_t sequence)
+{
+    uint32_t bank = (uint32_t)NVMCTRL_REGS->NVMCTRL_STATUS & NVMCTRL_STATUS_AFIRST_Msk;
+
+    return ~(APP_CAN_FLASHLOG_CHECKPOINT_MAGIC ^ position ^ sequence ^ APP_CAN_FLASHLOG_START ^ APP_CAN_FLASHLOG_SIZE ^ bank);
+}
+
+/* Records the write position once no NVM operation is in flight. The
+   magic word is written last so that a reset in between leaves no valid
+   checkpoint. */
+static void APP_CAN_FlashLogCheckpointSave(void)
+{
+    uint32_t position = flashLogWritePage | ((uint32_t)(flashLogBlockReady + 1) << 16);
+
+    if (flashLogState == APP_CAN_FLASHLOG_STATE_FROZEN)
+    {
+        position |= APP_CAN_FLASHLOG_CHECKPOINT_FROZEN;
+    }
+    RTC_BackupRegisterSet(APP_CAN_FLASHLOG_BACKUP_REGISTER, 0U);
+    RTC_BackupRegisterSet((BACKUP_REGISTER)(APP_CAN_FLASHLOG_BACKUP_REGISTER + 1U), position);
+    RTC_BackupRegisterSet((BACKUP_REGISTER)(APP_CAN_FLASHLOG_BACKUP_REGISTER + 2U), flashLogSequence);
+    RTC_BackupRegisterSet((BACKUP_REGISTER)(APP_CAN_FLASHLOG_BACKUP_REGISTER + 3U),
+                          APP_CAN_FlashLogCheckpointCheck(position, flashLogSequence));
+    RTC_BackupRegisterSet(APP_CAN_FLASHLOG_BACKUP_REGISTER, APP_CAN_FLASHLOG_CHECKPOINT_MAGIC);
+}
+
+/* Resumes from the checkpoint, false if there is no valid one */
+static bool APP_CAN_FlashLogCheckpointResume(bool *frozen)
+{
+    const APP_CAN_FLASHLOG_PAGE_HEADER *header = (const APP_CAN_FLASHLOG_PAGE_HEADER *)flashLogReadBuffer;
+    uint32_t position = flashLogCheckpoint[1];
+    uint32_t page = position & 0xFFFFU;
+    int32_t ready = (int32_t)((position >> 16) & 0x7FFFU) - 1;
+
+    if ((flashLogCheckpoint[0] != APP_CAN_FLASHLOG_CHECKPOINT_MAGIC) ||
+        (flashLogCheckpoint[3] != APP_CAN_FlashLogCheckpointCheck(position, flashLogCheckpoint[2])) ||
+        (page >= APP_CAN_FLASHLOG_PAGES) || (ready >= (int32_t)APP_CAN_FLASHLOG_BLOCKS))
+    {
+        return false;
+    }
+
+    flashLogWritePage = page;
+    flashLogSequence = flashLogCheckpoint[2];
+    flashLogBlockReady = ready;
+    *frozen = ((position & APP_CAN_FLASHLOG_CHECKPOINT_FROZEN) != 0U);
+
+    /* The write in flight at the reset may have completed, or may have
+       been cut short, then the page is given up */
+    while ((flashLogWritePage % APP_CAN_FLASHLOG_PAGES_PER_BLOCK) != 0U)
+    {
+        if (APP_CAN_FlashLogPageRead(flashLogWritePage, flashLogReadBuffer))
+        {
+            flashLogSequence = header->sequence + 1U;
+        }
+        else if (APP_CAN_FlashLogPageBlank(flashLogReadBuffer))
+        {
+            break;
+        }
+        flashLogWritePage = (flashLogWritePage + 1U) % APP_CAN_FLASHLOG_PAGES;
+    }
+    return true;
+}
+
+/* Finds the write position by scanning the whole log area */
+static void APP_CAN_FlashLogScan(bool *frozen)
+{
+    const APP_CAN_FLASHLOG_PAGE_HEADER *header = (const APP_CAN_FLASHLOG_PAGE_HEADER *)flashLogReadBuffer;
+    uint32_t page = 0U;
+    uint32_t newest = 0U;
+    uint32_t newestSequence = 0U;
+    bool found = false;
+
+    for (page = 0U; page < APP_CAN_FLASHLOG_PAGES; page++)
+    {
+        if (APP_CAN_FlashLogPageRead(page, flashLogReadBuffer) && ((found == false) || (header->sequence > newestSequence)))
+        {
+            found = true;
+            newest = page;
+            newestSequence = header->sequence;
+            *frozen = ((header->flags & APP_CAN_FLASHLOG_PAGE_FROZEN) != 0U);
+        }
+    }
+
+    flashLogSequence = found ? (newestSequence + 1U) : 1U;
+    flashLogWritePage = found ? ((newest + 1U) % APP_CAN_FLASHLOG_PAGES) : 0U;
+    flashLogBlockReady = -1;
+
+    /* Continue in the same block if the rest of it is still erased, a page
+       may have been cut short by a reset */
+    if ((flashLogWritePage % APP_CAN_FLASHLOG_PAGES_PER_BLOCK) != 0U)
+    {
+        for (page = flashLogWritePage; (page % APP_CAN_FLASHLOG_PAGES_PER_BLOCK) != 0U; page++)
+        {
+            (void)NVMCTRL_Read(flashLogReadBuffer, APP_CAN_FLASHLOG_PAGE_SIZE, APP_CAN_FlashLogPageAddress(page));
+            if (APP_CAN_FlashLogPageBlank(flashLogReadBuffer) == false)
+            {
+                break;
+            }
+        }
+        if ((page % APP_CAN_FLASHLOG_PAGES_PER_BLOCK) == 0U)
+        {
+            flashLogBlockReady = (int32_t)(flashLogWritePage / APP_CAN_FLASHLOG_PAGES_PER_BLOCK);
+        }
+        else
+        {
+            flashLogWritePage = (page - (page % APP_CAN_FLASHLOG_PAGES_PER_BLOCK) + APP_CAN_FLASHLOG_PAGES_PER_BLOCK) %
+                                APP_CAN_FLASHLOG_PAGES;
+        }
+    }
+}
+
+void APP_CAN_FlashLogCheckpointLoad(void)
+{
+    uint32_t index = 0U;
+
+    for (index = 0U; index < APP_CAN_FLASHLOG_CHECKPOINT_WORDS; index++)
+    {
+        flashLogCheckpoint[index] = RTC_BackupRegisterGet((BACKUP_REGISTER)(APP_CAN_FLASHLOG_BACKUP_REGISTER + index));
+    }
+}
+
+void APP_CAN_FlashLogInitialize(void)
+{
+    uint32_t page = 0U;
+    bool frozen = false;
+
+    NVMCTRL_SetWriteMode(NVMCTRL_WMODE_MAN);
+
+    flashLogBufferHead = 0U;
+    flashLogBufferTail = 0U;
+    flashLogFillLength = 0U;
+    flashLogFillCount = 0U;
+    flashLogEraseAhead = false;
+    flashLogNvmActive = false;
+    flashLogEventPending = false;
+    APP_CAN_FlashLogIndexReset();
+
+    if (APP_CAN_FlashLogCheckpointResume(&frozen) == false)
+    {
+        APP_CAN_FlashLogScan(&frozen);
+    }
+
+    /* Summarize the pages already written to the current block */
+    for (page = flashLogWritePage - (flashLogWritePage % APP_CAN_FLASHLOG_PAGES_PER_BLOCK); page < flashLogWritePage; page++)
+    {
+        if (APP_CAN_FlashLogPageRead(page, flashLogReadBuffer))
+        {
+            APP_CAN_FlashLogIndexAdd(flashLogReadBuffer);
+        }
+    }
+
+    flashLogState = frozen ? APP_CAN_FLASHLOG_STATE_FROZEN : APP_CAN_FLASHLOG_STATE_RECORDING;
+    APP_CAN_FlashLogCheckpointSave();
+}
+
+void APP_CAN_FlashLogTasks(void)
+{
+    uint32_t page = flashLogWritePage;
+    uint32_t block = page / APP_CAN_FLASHLOG_PAGES_PER_BLOCK;
+    uint32_t *data = NULL;
+
+    if (NVMCTRL_IsBusy())
+    {
+        return;
+    }
+    if (flashLogNvmActive)
+    {
+        flashLogNvmActive = false;
+        if ((NVMCTRL_ErrorGet() & APP_CAN_FLASHLOG_NVM_ERRORS) != 0U)
+        {
+            flashLogErrors++;
+        }
+        if (flashLogState != APP_CAN_FLASHLOG_STATE_ERASING)
+        {
+            APP_CAN_FlashLogCheckpointSave();
+        }
+    }
+
+    if (flashLogState == APP_CAN_FLASHLOG_STATE_ERASING)
+    {
+        if (flashLogEraseBlock < APP_CAN_FLASHLOG_BLOCKS)
+        {
+            (void)NVMCTRL_BlockErase(APP_CAN_FLASHLOG_START + (flashLogEraseBlock * APP_CAN_FLASHLOG_BLOCK_SIZE));
+            APP_CAN_FlashLogNvmStart();
+            flashLogEraseBlock++;
+            return;
+        }
+        flashLogWritePage = 0U;
+        flashLogBlockReady = 0;
+        flashLogEraseAhead = false;
+        APP_CAN_FlashLogIndexReset();
+        flashLogState = APP_CAN_FLASHLOG_STATE_RECORDING;
+        APP_CAN_FlashLogCheckpointSave();
+    }
+
+    APP_CAN_FlashLogEventCheck();
+    if ((flashLogState == APP_CAN_FLASHLOG_STATE_FREEZING) && (flashLogFreezeRemaining == 0U))
+    {
+        APP_CAN_FlashLogFreeze();
+    }
+
+    /* The last page of a block holds its summary */
+    if ((page % APP_CAN_FLASHLOG_PAGES_PER_BLOCK) == (APP_CAN_FLASHLOG_PAGES_PER_BLOCK - 1U))
+    {
+        flashLogIndex->crc = APP_CAN_FlashLogIndexCrc(flashLogIndex);
+        (void)NVMCTRL_PageBufferWrite(flashLogIndexPage, APP_CAN_FlashLogPageAddress(page));
+        (void)NVMCTRL_PageBufferCommit(APP_CAN_FlashLogPageAddress(page));
+        APP_CAN_FlashLogNvmStart();
+        APP_CAN_FlashLogIndexReset();
+        flashLogWritePage = (page + 1U) % APP_CAN_FLASHLOG_PAGES;
+        return;
+    }
+
+    if (flashLogBufferHead != flashLogBufferTail)
+    {
+        /* A block is erased before its first page is written */
+        if (((page % APP_CAN_FLASHLOG_PAGES_PER_BLOCK) == 0U) && (flashLogBlockReady != (int32_t)block))
+        {
+            (void)NVMCTRL_BlockErase(APP_CAN_FLASHLOG_START + (block * APP_CAN_FLASHLOG_BLOCK_SIZE));
+            APP_CAN_FlashLogNvmStart();
+            flashLogBlockReady = (int32_t)block;
+            return;
+        }
+
+        data = flashLogBuffer[flashLogBufferTail & (APP_CAN_FLASHLOG_BUFFER_PAGES - 1U)];
+        (void)NVMCTRL_PageBufferWrite(data, APP_CAN_FlashLogPageAddress(page));
+        (void)NVMCTRL_PageBufferCommit(APP_CAN_FlashLogPageAddress(page));
+        APP_CAN_FlashLogNvmStart();
+        APP_CAN_FlashLogIndexAdd(data);
+        flashLogBufferTail++;
+        flashLogWritePage = (page + 1U) % APP_CAN_FLASHLOG_PAGES;
+
+        /* Entering a block, erase the next one (oldest data) ahead of time */
+        if ((page % APP_CAN_FLASHLOG_PAGES_PER_BLOCK) == 0U)
+        {
+            flashLogEraseAheadBlock = (block + 1U) % APP_CAN_FLASHLOG_BLOCKS;
+            flashLogEraseAhead = true;
+        }
+        return;
+    }
+
+    if (flashLogEraseAhead)
+    {
+        flashLogEraseAhead = false;
+        (void)NVMCTRL_BlockErase(APP_CAN_FLASHLOG_START + (flashLogEraseAheadBlock * APP_CAN_FLASHLOG_BLOCK_SIZE));
+        APP_CAN_FlashLogNvmStart();
+        flashLogBlockReady = (int32_t)flashLogEraseAheadBlock;
+    }
+}
+
+void APP_CAN_FlashLogFrameAdd(const APP_CAN_RING_ENTRY *entry)
+{
+    uint8_t *page = NULL;
+    uint8_t raw[APP_CAN_RECORD_HEADER_SIZE + 64U];
+    uint32_t length = 0U;
+
+    APP_CAN_FlashLogEventCheck();
+    if ((flashLogState != APP_CAN_FLASHLOG_STATE_RECORDING) && (flashLogState != APP_CAN_FLASHLOG_STATE_FREEZING))
+    {
+        return;
+    }
+    if ((flashLogBufferHead - flashLogBufferTail) >= APP_CAN_FLASHLOG_BUFFER_PAGES)
+    {
+        flashLogDropped++;
+        return;
+    }
+
+    length = (uint32_t)APP_CAN_RecordPack(entry, raw);
+    if (((flashLogFillLength + length) > APP_CAN_FLASHLOG_DATA_SIZE) || (flashLogFillCount >= 255U))
+    {
+        (void)APP_CAN_FlashLogPageClose(0U);
+        if ((flashLogBufferHead - flashLogBufferTail) >= APP_CAN_FLASHLOG_BUFFER_PAGES)
+        {
+            flashLogDropped++;
+            return;
+        }
+    }
+
+    page = (uint8_t *)flashLogBuffer[flashLogBufferHead & (APP_CAN_FLASHLOG_BUFFER_PAGES - 1U)];
+    if (flashLogFillCount == 0U)
+    {
+        flashLogFillTimestamp = entry->timestamp;
+    }
+    memcpy(&page[sizeof(APP_CAN_FLASHLOG_PAGE_HEADER) + flashLogFillLength], raw, length);
+    flashLogFillLength += length;
+    flashLogFillCount++;
+
+    if (flashLogState == APP_CAN_FLASHLOG_STATE_FREEZING)
+    {
+        if (flashLogFreezeRemaining > 0U)
+        {
+            flashLogFreezeRemaining--;
+        }
+        if (flashLogFreezeRemaining == 0U)
+        {
+            APP_CAN_FlashLogFreeze();
+        }
+    }
+}
+
+void APP_CAN_FlashLogEnable(bool enable)
+{
+    if (enable)
+    {
+        if (flashLogState == APP_CAN_FLASHLOG_STATE_OFF)
+        {
+            flashLogState = APP_CAN_FLASHLOG_STATE_RECORDING;
+        }
+    }
+    else if ((flashLogState == APP_CAN_FLASHLOG_STATE_RECORDING) || (flashLogState == APP_CAN_FLASHLOG_STATE_FREEZING))
+    {
+        if (flashLogFillCount > 0U)
+        {
+            (void)APP_CAN_FlashLogPageClose(0U);
+        }
+        flashLogState = APP_CAN_FLASHLOG_STATE_OFF;
+    }
+}
+
+void APP_CAN_FlashLogFreezeSet(bool enable, uint32_t postFrames)
+{
+    flashLogFreezeEnable = enable;
+    flashLogFreezePost = postFrames;
+}
+
+void APP_CAN_FlashLogUnfreeze(void)
+{
+    if ((flashLogState == APP_CAN_FLASHLOG_STATE_FROZEN) || (flashLogState == APP_CAN_FLASHLOG_STATE_FREEZING))
+    {
+        flashLogState = APP_CAN_FLASHLOG_STATE_RECORDING;
+    }
+}
+
+void APP_CAN_FlashLogEvent(void)
+{
+    flashLogEventPending = true;
+}
+
+void APP_CAN_FlashLogErase(void)
+{
+    /* Pages not written yet are discarded */
+    flashLogBufferTail = flashLogBufferHead;
+    flashLogFillLength = 0U;
+    flashLogFillCount = 0U;
+    flashLogEraseBlock = 0U;
+    flashLogState = APP_CAN_FLASHLOG_STATE_ERASING;
+    /* A reset while erasing falls back to scanning the log */
+    RTC_BackupRegisterSet(APP_CAN_FLASHLOG_BACKUP_REGISTER, 0U);
+}
+
+void APP_CAN_FlashLogStatusGet(APP_CAN_FLASHLOG_STATUS *status)
+{
+    status->state = flashLogState;
+    status->sequence = flashLogSequence;
+    status->dropped = flashLogDropped;
+    status->errors = flashLogErrors;
+}
+
+bool APP_CAN_FlashLogIdle(void)
+{
+    return (flashLogBufferHead == flashLogBufferTail) && (flashLogState != APP_CAN_FLASHLOG_STATE_ERASING) &&
+           (flashLogEraseAhead == false) &&
+           ((flashLogWritePage % APP_CAN_FLASHLOG_PAGES_PER_BLOCK) != (APP_CAN_FLASHLOG_PAGES_PER_BLOCK - 1U)) &&
+           (NVMCTRL_IsBusy() == false);
+}
+
+/* True if the timestamp lies in the query range */
+static bool APP_CAN_FlashLogTimeMatch(uint32_t timestamp)
+{
+    return (uint32_t)(timestamp - flashLogQuery.start) <= (uint32_t)(flashLogQuery.end - flashLogQuery.start);
+}
+
+static bool APP_CAN_FlashLogQueryKey(uint32_t *key)
+{
+    *key = flashLogQuery.id | (flashLogQuery.xtd ? APP_CAN_RECORD_ID_XTD : 0U);
+    return flashLogQuery.idMatch;
+}
+
+/* True if the summary of the block shows that no frame of it can match.
+   Timestamps restart on reset and wrap around, so the blocks are checked
+   one by one rather than searched by time. */
+static bool APP_CAN_FlashLogBlockSkip(uint32_t block)
+{
+    APP_CAN_FLASHLOG_BLOCK_INDEX *index = (APP_CAN_FLASHLOG_BLOCK_INDEX *)flashLogReadBuffer;
+    uint32_t page = (block * APP_CAN_FLASHLOG_PAGES_PER_BLOCK) + (APP_CAN_FLASHLOG_PAGES_PER_BLOCK - 1U);
+    uint32_t key = 0U;
+
+    (void)NVMCTRL_Read(flashLogReadBuffer, sizeof(*index), APP_CAN_FlashLogPageAddress(page));
+    if ((index->magic != APP_CAN_FLASHLOG_INDEX_MAGIC) || (index->crc != APP_CAN_FlashLogIndexCrc(index)))
+    {
+        return false;
+    }
+    if (index->frames == 0U)
+    {
+        return true;
+    }
+    if (flashLogQueryActive == false)
+    {
+        return false;
+    }
+    /* Time ranges of the block and the query do not overlap */
+    if ((APP_CAN_FlashLogTimeMatch(index->firstTimestamp) == false) &&
+        ((uint32_t)(flashLogQuery.start - index->firstTimestamp) > (uint32_t)(index->lastTimestamp - index->firstTimestamp)))
+    {
+        return true;
+    }
+    return APP_CAN_FlashLogQueryKey(&key) && (APP_CAN_FlashLogBloomTest(index->bloom, key) == false);
+}
+
+static bool APP_CAN_FlashLogFrameMatch(const uint8_t *raw)
+{
+    uint32_t key = 0U;
+
+    if (flashLogQueryActive == false)
+    {
+        return true;
+    }
+    if (APP_CAN_FlashLogTimeMatch(APP_CAN_FlashLogLoad32(raw)) == false)
+    {
+        return false;
+    }
+    return (APP_CAN_FlashLogQueryKey(&key) == false) || (APP_CAN_FlashLogRecordKey(raw) == key);
+}
+
+void APP_CAN_FlashLogReadStart(const APP_CAN_FLASHLOG_QUERY *query)
+{
+    APP_CAN_FlashLogEnable(false);
+
+    flashLogQueryActive = (query != NULL);
+    if (query != NULL)
+    {
+        flashLogQuery = *query;
+    }
+    /* The block after the one being written is the oldest, or erased */
+    flashLogReadBlock = flashLogWritePage / APP_CAN_FLASHLOG_PAGES_PER_BLOCK;
+    flashLogReadBlockPage = APP_CAN_FLASHLOG_PAGES_PER_BLOCK - 1U;
+    flashLogReadRemaining = APP_CAN_FLASHLOG_BLOCKS;
+    flashLogReadOffset = 0U;
+    flashLogReadLength = 0U;
+    flashLogReadSkipped = 0U;
+}
+
+bool APP_CAN_FlashLogFrameGet(APP_CAN_RING_ENTRY *entry)
+{
+    const uint8_t *data = (const uint8_t *)flashLogReadBuffer + sizeof(APP_CAN_FLASHLOG_PAGE_HEADER);
+    uint32_t page = 0U;
+
+    while (true)
+    {
+        while (flashLogReadOffset >= flashLogReadLength)
+        {
+            if (flashLogReadBlockPage >= (APP_CAN_FLASHLOG_PAGES_PER_BLOCK - 1U))
+            {
+                if (flashLogReadRemaining == 0U)
+                {
+                    return false;
+                }
+                flashLogReadRemaining--;
+                flashLogReadBlock = (flashLogReadBlock + 1U) % APP_CAN_FLASHLOG_BLOCKS;
+                flashLogReadBlockPage = 0U;
+                if (APP_CAN_FlashLogBlockSkip(flashLogReadBlock))
+                {
+                    flashLogReadSkipped++;
+                    flashLogReadBlockPage = APP_CAN_FLASHLOG_PAGES_PER_BLOCK - 1U;
+                    continue;
+                }
+            }
+            page = (flashLogReadBlock * APP_CAN_FLASHLOG_PAGES_PER_BLOCK) + flashLogReadBlockPage++;
+            flashLogReadOffset = 0U;
+            flashLogReadLength = 0U;
+            if (APP_CAN_FlashLogPageRead(page, flashLogReadBuffer))
+            {
+                flashLogReadLength = ((const APP_CAN_FLASHLOG_PAGE_HEADER *)flashLogReadBuffer)->length;
+            }
+        }
+
+        if (APP_CAN_FlashLogFrameMatch(&data[flashLogReadOffset]))
+        {
+            APP_CAN_RecordUnpack(&data[flashLogReadOffset], entry);
+            return true;
+        }
+        flashLogReadOffset += (uint32_t)APP_CAN_RecordPackedSize(&data[flashLogReadOffset]);
+    }
+}
+
+void APP_CAN_FlashLogFrameRelease(void)
+{
+    const uint8_t *data = (const uint8_t *)flashLogReadBuffer + sizeof(APP_CAN_FLASHLOG_PAGE_HEADER);
+
+    if (flashLogReadOffset < flashLogReadLength)
+    {
+        flashLogReadOffset += (uint32_t)APP_CAN_RecordPackedSize(&data[flashLogReadOffset]);
+    }
+}
+
+uint32_t APP_CAN_FlashLogBlocksSkippedGet(void)
+{
+    return flashLogReadSkipped;
+}
+
+const void *APP_CAN_FlashLogBlockAddressGet(uint32_t index)
+{
+    /* The block after the one being written is the oldest */
+    uint32_t block = ((flashLogWritePage / APP_CAN_FLASHLOG_PAGES_PER_BLOCK) + 1U + index) % APP_CAN_FLASHLOG_BLOCKS;
+
+    return (const void *)(APP_CAN_FLASHLOG_START + (block * APP_CAN_FLASHLOG_BLOCK_SIZE));
+}
+
+/*******************************************************************************
+ End of File
+*/
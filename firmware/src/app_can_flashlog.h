@@ -0,0 +1,245 @@
+/*******************************************************************************
+  CAN Flash Recorder Header File
+
+  Company:
+    Microchip Technology Inc.
+
+  File Name:
+    app_can_flashlog.h
+
+  Summary:
+    Black-box recorder of CAN frames in internal flash, interface.
+
+  Description:
+    This file declares the flash recorder, which keeps the most recent received
+    frames in a circular log in a reserved area of the internal flash.
+*******************************************************************************/
+
+//DOM-IGNORE-BEGIN
+/*******************************************************************************
+* Copyright (C) 2024 Microchip Technology Inc. and its subsidiaries.
+*
+* Subject to your compliance with these terms, you may use Microchip software
+* and any derivatives exclusively with Microchip products. It is your
+* responsibility to comply with third party license terms applicable to your
+* use of third party software (including open source software) that may
+* accompany Microchip software.
+*
+* THIS SOFTWARE IS SUPPLIED BY MICROCHIP "AS IS". NO WARRANTIES, WHETHER
+* EXPRESS, IMPLIED OR STATUTORY, APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED
+* WARRANTIES OF NON-INFRINGEMENT, MERCHANTABILITY, AND FITNESS FOR A
+* PARTICULAR PURPOSE.
+*
+* IN NO EVENT WILL MICROCHIP BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE,
+* INCIDENTAL OR CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND
+* WHATSOEVER RELATED TO THE SOFTWARE, HOWEVER CAUSED, EVEN IF MICROCHIP HAS
+* BEEN ADVISED OF THE POSSIBILITY OR THE DAMAGES ARE FORESEEABLE. TO THE
+* FULLEST EXTENT ALLOWED BY LAW, MICROCHIP'S TOTAL LIABILITY ON ALL CLAIMS IN
+* ANY WAY RELATED TO THIS SOFTWARE WILL NOT EXCEED THE AMOUNT OF FEES, IF ANY,
+* THAT YOU HAVE PAID DIRECTLY TO MICROCHIP FOR THIS SOFTWARE.
+*******************************************************************************/
+//DOM-IGNORE-END
+
+
+
+#ifndef APP_CAN_FLASHLOG_H
+#define APP_CAN_FLASHLOG_H
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Included Files
+// *****************************************************************************
+// *****************************************************************************
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "app_can_ring.h"
+
+// DOM-IGNORE-BEGIN
+#ifdef __cplusplus  // Provide C++ Compatibility
+    extern "C" {
+#endif
+// DOM-IGNORE-END
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Data Types
+// *****************************************************************************
+// *****************************************************************************
+
+/* Log area, whole NVM blocks in flash bank B. The application is linked
+   below ROM_LENGTH (ATSAME51J20A.ld) and the SmartEEPROM sectors take the
+   top of the bank. */
+#ifndef APP_CAN_FLASHLOG_START
+#define APP_CAN_FLASHLOG_START                  0x000C0000UL
+#endif
+#ifndef APP_CAN_FLASHLOG_SIZE
+#define APP_CAN_FLASHLOG_SIZE                   0x00038000UL
+#endif
+
+/* First of the four RTC backup registers holding the write position
+   checkpoint (APP_CAN_FlashLogCheckpointLoad) */
+#ifndef APP_CAN_FLASHLOG_BACKUP_REGISTER
+#define APP_CAN_FLASHLOG_BACKUP_REGISTER        BACKUP_REGISTER_0
+#endif
+
+#define APP_CAN_FLASHLOG_PAGE_SIZE              NVMCTRL_FLASH_PAGESIZE
+#define APP_CAN_FLASHLOG_BLOCK_SIZE             NVMCTRL_FLASH_BLOCKSIZE
+#define APP_CAN_FLASHLOG_PAGES                  (APP_CAN_FLASHLOG_SIZE / APP_CAN_FLASHLOG_PAGE_SIZE)
+#define APP_CAN_FLASHLOG_BLOCKS                 (APP_CAN_FLASHLOG_SIZE / APP_CAN_FLASHLOG_BLOCK_SIZE)
+#define APP_CAN_FLASHLOG_PAGES_PER_BLOCK        (APP_CAN_FLASHLOG_BLOCK_SIZE / APP_CAN_FLASHLOG_PAGE_SIZE)
+
+#if (((APP_CAN_FLASHLOG_START % NVMCTRL_FLASH_BLOCKSIZE) != 0U) || ((APP_CAN_FLASHLOG_SIZE % NVMCTRL_FLASH_BLOCKSIZE) != 0U) || \
+     (APP_CAN_FLASHLOG_BLOCKS < 2U))
+#error "The flash log must consist of at least two whole NVM blocks"
+#endif
+
+/* Page header, followed by packed records (APP_CAN_RecordPack) */
+typedef struct
+{
+    uint32_t magic;
+    /* Incremented for every page written */
+    uint32_t sequence;
+    /* Timestamp of the first frame */
+    uint32_t timestamp;
+    /* Bytes of records */
+    uint16_t length;
+    /* Frames in the page */
+    uint8_t count;
+    /* APP_CAN_FLASHLOG_PAGE_xxx */
+    uint8_t flags;
+    /* CRC-16/CCITT-FALSE of the header (with crc = 0) and the records */
+    uint16_t crc;
+    uint16_t reserved;
+} APP_CAN_FLASHLOG_PAGE_HEADER;
+
+#define APP_CAN_FLASHLOG_MAGIC                  0x4C4E4143UL
+/* Last page before the log was frozen */
+#define APP_CAN_FLASHLOG_PAGE_FROZEN            0x01U
+
+/* Bits of the per-block ID Bloom filter, a power of two */
+#define APP_CAN_FLASHLOG_BLOOM_BITS             1024U
+
+/* Summary of a block, written to its last page once the other pages are
+   written. Readers skip blocks whose summary cannot match a query, blocks
+   without a valid summary are read. */
+typedef struct
+{
+    uint32_t magic;
+    /* Sequence number of the first page */
+    uint32_t firstSequence;
+    /* Time range of the frames, inclusive and wrapping around. The
+       timestamps of the first and last frame unless they restarted within
+       the block. */
+    uint32_t firstTimestamp;
+    uint32_t lastTimestamp;
+    uint32_t frames;
+    /* Bloom filter of the IDs, 3 bits per ID */
+    uint32_t bloom[APP_CAN_FLASHLOG_BLOOM_BITS / 32U];
+    /* CRC-16/CCITT-FALSE of the summary (with crc = 0) */
+    uint16_t crc;
+    uint16_t reserved;
+} APP_CAN_FLASHLOG_BLOCK_INDEX;
+
+#define APP_CAN_FLASHLOG_INDEX_MAGIC            0x58444E49UL
+
+/* Frames to read back */
+typedef struct
+{
+    /* Timestamp range, inclusive, may wrap around */
+    uint32_t start;
+    uint32_t end;
+    /* Only frames with this ID (standard IDs in id[10:0]) */
+    bool idMatch;
+    bool xtd;
+    uint32_t id;
+} APP_CAN_FLASHLOG_QUERY;
+
+typedef enum
+{
+    /* Not recording */
+    APP_CAN_FLASHLOG_STATE_OFF,
+    APP_CAN_FLASHLOG_STATE_RECORDING,
+    /* Event seen, recording the frames after it */
+    APP_CAN_FLASHLOG_STATE_FREEZING,
+    /* Stopped after an event, survives a reset */
+    APP_CAN_FLASHLOG_STATE_FROZEN,
+    /* Erasing the whole log */
+    APP_CAN_FLASHLOG_STATE_ERASING
+} APP_CAN_FLASHLOG_STATE;
+
+typedef struct
+{
+    APP_CAN_FLASHLOG_STATE state;
+    /* Sequence number of the next page */
+    uint32_t sequence;
+    /* Frames not logged because no page buffer was free */
+    uint32_t dropped;
+    /* NVM operations which reported an error */
+    uint32_t errors;
+} APP_CAN_FLASHLOG_STATUS;
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Interface Routines
+// *****************************************************************************
+// *****************************************************************************
+
+/* Reads the write position checkpoint kept in the RTC backup registers
+   across resets. Call before SYS_Initialize, RTC_Initialize resets the RTC. */
+void APP_CAN_FlashLogCheckpointLoad(void);
+
+/* Resumes at the checkpointed write position, or recovers it by scanning
+   the log area when there is no valid checkpoint (e.g. after power-on),
+   and starts recording unless the log was frozen. Call after
+   NVMCTRL_Initialize and RTC_Initialize. */
+void APP_CAN_FlashLogInitialize(void);
+
+/* Starts NVM operations when the NVM is ready, call from the main loop */
+void APP_CAN_FlashLogTasks(void);
+
+/* Logs a received frame */
+void APP_CAN_FlashLogFrameAdd(const APP_CAN_RING_ENTRY *entry);
+
+/* Starts or stops recording. Stopping writes the partly filled page. */
+void APP_CAN_FlashLogEnable(bool enable);
+
+/* With freeze enabled an event stops recording postFrames frames later,
+   and the log stays frozen until APP_CAN_FlashLogUnfreeze */
+void APP_CAN_FlashLogFreezeSet(bool enable, uint32_t postFrames);
+void APP_CAN_FlashLogUnfreeze(void);
+
+/* Reports an event, may be called from interrupt context */
+void APP_CAN_FlashLogEvent(void);
+
+/* Erases the whole log, recording resumes afterwards */
+void APP_CAN_FlashLogErase(void);
+
+void APP_CAN_FlashLogStatusGet(APP_CAN_FLASHLOG_STATUS *status);
+
+/* Reading: true when no page is waiting to be written, no erase is
+   scheduled and the NVM is ready. ReadStart stops recording and starts at the oldest page, query
+   selects the frames to read (NULL for all). FrameGet returns the next
+   frame without removing it, false at the end. */
+bool APP_CAN_FlashLogIdle(void);
+void APP_CAN_FlashLogReadStart(const APP_CAN_FLASHLOG_QUERY *query);
+bool APP_CAN_FlashLogFrameGet(APP_CAN_RING_ENTRY *entry);
+void APP_CAN_FlashLogFrameRelease(void);
+/* Blocks skipped by the current read using their summary */
+uint32_t APP_CAN_FlashLogBlocksSkippedGet(void);
+
+/* Memory mapped address of a block of the log, index 0 is the oldest.
+   Stays unchanged while recording is stopped and APP_CAN_FlashLogIdle. */
+const void *APP_CAN_FlashLogBlockAddressGet(uint32_t index);
+
+// DOM-IGNORE-BEGIN
+#ifdef __cplusplus  // Provide C++ Compatibility
+    }
+#endif
+// DOM-IGNORE-END
+
+#endif // APP_CAN_FLASHLOG_H
+
+/*******************************************************************************
+ End of File
+*/
@@ -0,0 +1,190 @@
+/*******************************************************************************
+  CAN Line Formatter Source File
+
+  Company:
+    Microchip Technology Inc.
+
+  File Name:
+    app_can_format.c
+
+  Summary:
+    CAN text line formatter implementation.
+
+  Description:
+    This file implements the candump style text line formatter. Hex and decimal
+    digits are produced from lookup tables instead of the C library printf.
+*******************************************************************************/
+
+//DOM-IGNORE-BEGIN
+/*******************************************************************************
+* Copyright (C) 2024 Microchip Technology Inc. and its subsidiaries.
+*
+* Subject to your compliance with these terms, you may use Microchip software
+* and any derivatives exclusively with Microchip products. It is your
+* responsibility to comply with third party license terms applicable to your
+* use of third party software (including open source software) that may
+* accompany Microchip software.
+*
+* THIS SOFTWARE IS SUPPLIED BY MICROCHIP "AS IS". NO WARRANTIES, WHETHER
+* EXPRESS, IMPLIED OR STATUTORY, APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED
+* WARRANTIES OF NON-INFRINGEMENT, MERCHANTABILITY, AND FITNESS FOR A
+* PARTICULAR PURPOSE.
+*
+* IN NO EVENT WILL MICROCHIP BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE,
+* INCIDENTAL OR CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND
+* WHATSOEVER RELATED TO THE SOFTWARE, HOWEVER CAUSED, EVEN IF MICROCHIP HAS
+* BEEN ADVISED OF THE POSSIBILITY OR THE DAMAGES ARE FORESEEABLE. TO THE
+* FULLEST EXTENT ALLOWED BY LAW, MICROCHIP'S TOTAL LIABILITY ON ALL CLAIMS IN
+* ANY WAY RELATED TO THIS SOFTWARE WILL NOT EXCEED THE AMOUNT OF FEES, IF ANY,
+* THAT YOU HAVE PAID DIRECTLY TO MICROCHIP FOR THIS SOFTWARE.
+*******************************************************************************/
+//DOM-IGNORE-END
+
+
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Included Files
+// *****************************************************************************
+// *****************************************************************************
+
+#include "app_can_format.h"
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Global Data
+// *****************************************************************************
+// *****************************************************************************
+
+/* Two upper case hex digits for every byte value */
+static const char formatHexPair[512 + 1] =
+    "000102030405060708090A0B0C0D0E0F"
+    "101112131415161718191A1B1C1D1E1F"
+    "202122232425262728292A2B2C2D2E2F"
+    "303132333435363738393A3B3C3D3E3F"
+    "404142434445464748494A4B4C4D4E4F"
+    "505152535455565758595A5B5C5D5E5F"
+    "606162636465666768696A6B6C6D6E6F"
+    "707172737475767778797A7B7C7D7E7F"
+    "808182838485868788898A8B8C8D8E8F"
+    "909192939495969798999A9B9C9D9E9F"
+    "A0A1A2A3A4A5A6A7A8A9AAABACADAEAF"
+    "B0B1B2B3B4B5B6B7B8B9BABBBCBDBEBF"
+    "C0C1C2C3C4C5C6C7C8C9CACBCCCDCECF"
+    "D0D1D2D3D4D5D6D7D8D9DADBDCDDDEDF"
+    "E0E1E2E3E4E5E6E7E8E9EAEBECEDEEEF"
+    "F0F1F2F3F4F5F6F7F8F9FAFBFCFDFEFF";
+
+/* Two decimal digits for 0 to 99 */
+static const char formatDecPair[200 + 1] =
+    "0001020304050607080910111213141516171819"
+    "2021222324252627282930313233343536373839"
+    "4041424344454647484950515253545556575859"
+    "6061626364656667686970717273747576777879"
+    "8081828384858687888990919293949596979899";
+
+static const uint8_t formatDlcLength[16] = {0U, 1U, 2U, 3U, 4U, 5U, 6U, 7U, 8U, 12U, 16U, 20U, 24U, 32U, 48U, 64U};
+
+#define APP_CAN_FORMAT_US_PER_TICK              (1000000U / APP_CAN_FORMAT_TICKS_PER_SECOND)
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: CAN Line Formatter Routines
+// *****************************************************************************
+// *****************************************************************************
+
+static inline char *APP_CAN_FormatHexByte(char *out, uint8_t value)
+{
+    const char *pair = &formatHexPair[(uint32_t)value << 1];
+
+    out[0] = pair[0];
+    out[1] = pair[1];
+    return out + 2;
+}
+
+/* Writes value as exactly 2 * pairs decimal digits, most significant first */
+static char *APP_CAN_FormatDecimal(char *out, uint32_t value, uint32_t pairs)
+{
+    const char *pair = NULL;
+    char *end = out + (pairs << 1);
+    char *digit = end;
+
+    while (digit != out)
+    {
+        pair = &formatDecPair[(value % 100U) << 1];
+        value /= 100U;
+        *--digit = pair[1];
+        *--digit = pair[0];
+    }
+    return end;
+}
+
+size_t APP_CAN_FormatLine(const APP_CAN_RING_ENTRY *entry, char *line)
+{
+    const CAN_RX_BUFFER *rxBuf = APP_CAN_RING_FRAME(entry);
+    uint32_t seconds = entry->timestamp / APP_CAN_FORMAT_TICKS_PER_SECOND;
+    uint32_t micros = (entry->timestamp % APP_CAN_FORMAT_TICKS_PER_SECOND) * APP_CAN_FORMAT_US_PER_TICK;
+    uint32_t id = 0U;
+    uint32_t index = 0U;
+    uint32_t length = 0U;
+    char *out = line;
+
+    /* "(ssssssssss.uuuuuu) can1 " */
+    *out++ = '(';
+    out = APP_CAN_FormatDecimal(out, seconds, 5U);
+    *out++ = '.';
+    out = APP_CAN_FormatDecimal(out, micros, 3U);
+    *out++ = ')';
+    *out++ = ' ';
+    *out++ = 'c';
+    *out++ = 'a';
+    *out++ = 'n';
+    *out++ = '1';
+    *out++ = ' ';
+
+    /* 3 hex digits for standard, 8 for extended identifiers */
+    if (rxBuf->xtd)
+    {
+        id = rxBuf->id;
+        out = APP_CAN_FormatHexByte(out, (uint8_t)(id >> 24));
+        out = APP_CAN_FormatHexByte(out, (uint8_t)(id >> 16));
+        out = APP_CAN_FormatHexByte(out, (uint8_t)(id >> 8));
+        out = APP_CAN_FormatHexByte(out, (uint8_t)id);
+    }
+    else
+    {
+        id = rxBuf->id >> 18;
+        *out++ = formatHexPair[((id >> 8) << 1) + 1U];
+        out = APP_CAN_FormatHexByte(out, (uint8_t)id);
+    }
+
+    *out++ = '#';
+    if (rxBuf->fdf)
+    {
+        /* "##" followed by the flags nibble: BRS = 1, ESI = 2 */
+        *out++ = '#';
+        *out++ = formatHexPair[(((rxBuf->brs ? 1U : 0U) | (rxBuf->esi ? 2U : 0U)) << 1) + 1U];
+    }
+    else if (rxBuf->rtr)
+    {
+        *out++ = 'R';
+    }
+
+    if (!rxBuf->rtr)
+    {
+        length = formatDlcLength[rxBuf->dlc];
+        for (index = 0U; index < length; index++)
+        {
+            out = APP_CAN_FormatHexByte(out, rxBuf->data[index]);
+        }
+    }
+
+    *out++ = '\r';
+    *out++ = '\n';
+
+    return (size_t)(out - line);
+}
+
+/*******************************************************************************
+ End of File
+*/
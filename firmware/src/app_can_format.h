@@ -0,0 +1,104 @@
+/*******************************************************************************
+  CAN Line Formatter Header File
+
+  Company:
+    Microchip Technology Inc.
+
+  File Name:
+    app_can_format.h
+
+  Summary:
+    CAN text line formatter interface.
+
+  Description:
+    This file declares the table driven formatter for candump style text lines.
+*******************************************************************************/
+
+//DOM-IGNORE-BEGIN
+/*******************************************************************************
+* Copyright (C) 2024 Microchip Technology Inc. and its subsidiaries.
+*
+* Subject to your compliance with these terms, you may use Microchip software
+* and any derivatives exclusively with Microchip products. It is your
+* responsibility to comply with third party license terms applicable to your
+* use of third party software (including open source software) that may
+* accompany Microchip software.
+*
+* THIS SOFTWARE IS SUPPLIED BY MICROCHIP "AS IS". NO WARRANTIES, WHETHER
+* EXPRESS, IMPLIED OR STATUTORY, APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED
+* WARRANTIES OF NON-INFRINGEMENT, MERCHANTABILITY, AND FITNESS FOR A
+* PARTICULAR PURPOSE.
+*
+* IN NO EVENT WILL MICROCHIP BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE,
+* INCIDENTAL OR CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND
+* WHATSOEVER RELATED TO THE SOFTWARE, HOWEVER CAUSED, EVEN IF MICROCHIP HAS
+* BEEN ADVISED OF THE POSSIBILITY OR THE DAMAGES ARE FORESEEABLE. TO THE
+* FULLEST EXTENT ALLOWED BY LAW, MICROCHIP'S TOTAL LIABILITY ON ALL CLAIMS IN
+* ANY WAY RELATED TO THIS SOFTWARE WILL NOT EXCEED THE AMOUNT OF FEES, IF ANY,
+* THAT YOU HAVE PAID DIRECTLY TO MICROCHIP FOR THIS SOFTWARE.
+*******************************************************************************/
+//DOM-IGNORE-END
+
+
+
+#ifndef APP_CAN_FORMAT_H
+#define APP_CAN_FORMAT_H
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Included Files
+// *****************************************************************************
+// *****************************************************************************
+
+#include <stdint.h>
+#include <stddef.h>
+#include "app_can_ring.h"
+
+// DOM-IGNORE-BEGIN
+#ifdef __cplusplus  // Provide C++ Compatibility
+    extern "C" {
+#endif
+// DOM-IGNORE-END
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Data Types
+// *****************************************************************************
+// *****************************************************************************
+
+/* Timestamp ticks per second (one tick per nominal bit, 500 kbit/s) */
+#ifndef APP_CAN_FORMAT_TICKS_PER_SECOND
+#define APP_CAN_FORMAT_TICKS_PER_SECOND         500000U
+#endif
+
+#if ((1000000U % APP_CAN_FORMAT_TICKS_PER_SECOND) != 0U)
+#error "APP_CAN_FORMAT_TICKS_PER_SECOND must divide 1000000"
+#endif
+
+/* Longest line: "(ssssssssss.uuuuuu) can1 IIIIIIII##F" + 128 data digits + "\r\n" */
+#define APP_CAN_FORMAT_LINE_MAX                 168U
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Interface Routines
+// *****************************************************************************
+// *****************************************************************************
+
+/* Writes one candump log line for a captured frame, for example
+     (0000000012.345678) can1 45A#0102
+     (0000000012.345780) can1 100000A5##1000102...
+   line must hold APP_CAN_FORMAT_LINE_MAX bytes, no terminating NUL is
+   written. Returns the line length. */
+size_t APP_CAN_FormatLine(const APP_CAN_RING_ENTRY *entry, char *line);
+
+// DOM-IGNORE-BEGIN
+#ifdef __cplusplus  // Provide C++ Compatibility
+    }
+#endif
+// DOM-IGNORE-END
+
+#endif // APP_CAN_FORMAT_H
+
+/*******************************************************************************
+ End of File
+*/
@@ -0,0 +1,211 @@
+/*******************************************************************************
+  CAN Software ID Filter Source File
+
+  Company:
+    Microchip Technology Inc.
+
+  File Name:
+    app_can_idfilter.c
+
+  Summary:
+    Software CAN ID filter implementation.
+
+  Description:
+    This file implements the software ID filter. Standard IDs are looked up in a
+    2048 bit accept bitmap, extended IDs in an open addressed hash set that is
+    kept at most half full. Edits are made on a second copy of the tables,
+    which is then published with a single pointer write, so the filter can be
+    changed while frames are being received.
+*******************************************************************************/
+
+//DOM-IGNORE-BEGIN
+/*******************************************************************************
+* Copyright (C) 2024 Microchip Technology Inc. and its subsidiaries.
+*
+* Subject to your compliance with these terms, you may use Microchip software
+* and any derivatives exclusively with Microchip products. It is your
+* responsibility to comply with third party license terms applicable to your
+* use of third party software (including open source software) that may
+* accompany Microchip software.
+*
+* THIS SOFTWARE IS SUPPLIED BY MICROCHIP "AS IS". NO WARRANTIES, WHETHER
+* EXPRESS, IMPLIED OR STATUTORY, APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED
+* WARRANTIES OF NON-INFRINGEMENT, MERCHANTABILITY, AND FITNESS FOR A
+* PARTICULAR PURPOSE.
+*
+* IN NO EVENT WILL MICROCHIP BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE,
+* INCIDENTAL OR CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND
+* WHATSOEVER RELATED TO THE SOFTWARE, HOWEVER CAUSED, EVEN IF MICROCHIP HAS
+* BEEN ADVISED OF THE POSSIBILITY OR THE DAMAGES ARE FORESEEABLE. TO THE
+* FULLEST EXTENT ALLOWED BY LAW, MICROCHIP'S TOTAL LIABILITY ON ALL CLAIMS IN
+* ANY WAY RELATED TO THIS SOFTWARE WILL NOT EXCEED THE AMOUNT OF FEES, IF ANY,
+* THAT YOU HAVE PAID DIRECTLY TO MICROCHIP FOR THIS SOFTWARE.
+*******************************************************************************/
+//DOM-IGNORE-END
+
+
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Included Files
+// *****************************************************************************
+// *****************************************************************************
+
+#include <string.h>
+#include "app_can_idfilter.h"
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Global Data
+// *****************************************************************************
+// *****************************************************************************
+
+#define APP_CAN_IDFILTER_STD_ID_MASK            0x7FFUL
+#define APP_CAN_IDFILTER_EXT_ID_MASK            0x1FFFFFFFUL
+
+/* Hash set slots, a power of two at least twice APP_CAN_IDFILTER_EXT_IDS */
+#define APP_CAN_IDFILTER_EXT_SLOTS              512U
+#define APP_CAN_IDFILTER_EXT_SLOT_BITS          9U
+/* Not a valid extended ID */
+#define APP_CAN_IDFILTER_EXT_EMPTY              0xFFFFFFFFUL
+
+typedef struct
+{
+    /* Empty ID list */
+    bool acceptAll;
+    uint32_t extCount;
+    /* Bit n of byte n / 8 is set for accepted standard ID n */
+    uint8_t std[(APP_CAN_IDFILTER_STD_ID_MASK + 1U) / 8U];
+    uint32_t ext[APP_CAN_IDFILTER_EXT_SLOTS];
+} APP_CAN_IDFILTER_TABLE;
+
+static APP_CAN_IDFILTER_TABLE idFilterTable[2];
+/* Table used by the Rx path, the other one is edited */
+static APP_CAN_IDFILTER_TABLE * volatile idFilterActive = &idFilterTable[0];
+static APP_CAN_IDFILTER_TABLE *idFilterEdit = &idFilterTable[1];
+static volatile uint32_t idFilterRejected = 0U;
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: CAN Software ID Filter Routines
+// *****************************************************************************
+// *****************************************************************************
+
+static uint32_t APP_CAN_IdFilterExtSlot(uint32_t id)
+{
+    /* Fibonacci hashing */
+    return (uint32_t)(id * 2654435761UL) >> (32U - APP_CAN_IDFILTER_EXT_SLOT_BITS);
+}
+
+static void APP_CAN_IdFilterTableClear(APP_CAN_IDFILTER_TABLE *table)
+{
+    table->acceptAll = true;
+    table->extCount = 0U;
+    memset(table->std, 0, sizeof(table->std));
+    memset(table->ext, 0xFF, sizeof(table->ext));
+}
+
+void APP_CAN_IdFilterInitialize(void)
+{
+    APP_CAN_IdFilterTableClear(&idFilterTable[0]);
+    APP_CAN_IdFilterTableClear(&idFilterTable[1]);
+    idFilterActive = &idFilterTable[0];
+    idFilterEdit = &idFilterTable[1];
+    idFilterRejected = 0U;
+}
+
+void APP_CAN_IdFilterEditBegin(void)
+{
+    APP_CAN_IdFilterTableClear(idFilterEdit);
+}
+
+bool APP_CAN_IdFilterEditAdd(uint32_t id, bool xtd)
+{
+    APP_CAN_IDFILTER_TABLE *table = idFilterEdit;
+    uint32_t slot = 0U;
+
+    if (xtd == false)
+    {
+        if (id > APP_CAN_IDFILTER_STD_ID_MASK)
+        {
+            return false;
+        }
+        table->std[id >> 3] |= (uint8_t)(1U << (id & 7U));
+        table->acceptAll = false;
+        return true;
+    }
+
+    if (id > APP_CAN_IDFILTER_EXT_ID_MASK)
+    {
+        return false;
+    }
+    /* Linear probing */
+    for (slot = APP_CAN_IdFilterExtSlot(id); table->ext[slot] != APP_CAN_IDFILTER_EXT_EMPTY;
+         slot = (slot + 1U) & (APP_CAN_IDFILTER_EXT_SLOTS - 1U))
+    {
+        if (table->ext[slot] == id)
+        {
+            return true;
+        }
+    }
+    if (table->extCount >= APP_CAN_IDFILTER_EXT_IDS)
+    {
+        return false;
+    }
+    table->ext[slot] = id;
+    table->extCount++;
+    table->acceptAll = false;
+    return true;
+}
+
+void APP_CAN_IdFilterEditCommit(void)
+{
+    APP_CAN_IDFILTER_TABLE *previous = idFilterActive;
+
+    /* A single word write, the Rx interrupt sees either the old or the new
+       table. The interrupt has returned before the old table is edited again. */
+    idFilterActive = idFilterEdit;
+    idFilterEdit = previous;
+}
+
+bool APP_CAN_IdFilterAccept(uint32_t id, bool xtd)
+{
+    const APP_CAN_IDFILTER_TABLE *table = idFilterActive;
+    uint32_t slot = 0U;
+
+    if (table->acceptAll)
+    {
+        return true;
+    }
+
+    if (xtd == false)
+    {
+        if ((table->std[(id >> 3) & (sizeof(table->std) - 1U)] & (1U << (id & 7U))) != 0U)
+        {
+            return true;
+        }
+    }
+    else
+    {
+        for (slot = APP_CAN_IdFilterExtSlot(id); table->ext[slot] != APP_CAN_IDFILTER_EXT_EMPTY;
+             slot = (slot + 1U) & (APP_CAN_IDFILTER_EXT_SLOTS - 1U))
+        {
+            if (table->ext[slot] == id)
+            {
+                return true;
+            }
+        }
+    }
+
+    idFilterRejected++;
+    return false;
+}
+
+uint32_t APP_CAN_IdFilterRejectedGet(void)
+{
+    return idFilterRejected;
+}
+
+/*******************************************************************************
+ End of File
+*/
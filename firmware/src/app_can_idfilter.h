@@ -0,0 +1,109 @@
+/*******************************************************************************
+  CAN Software ID Filter Header File
+
+  Company:
+    Microchip Technology Inc.
+
+  File Name:
+    app_can_idfilter.h
+
+  Summary:
+    Software CAN ID filter interface.
+
+  Description:
+    This file declares the software ID filter, which decides per received frame
+    whether it is kept, after the CAN1 acceptance filters.
+*******************************************************************************/
+
+//DOM-IGNORE-BEGIN
+/*******************************************************************************
+* Copyright (C) 2024 Microchip Technology Inc. and its subsidiaries.
+*
+* Subject to your compliance with these terms, you may use Microchip software
+* and any derivatives exclusively with Microchip products. It is your
+* responsibility to comply with third party license terms applicable to your
+* use of third party software (including open source software) that may
+* accompany Microchip software.
+*
+* THIS SOFTWARE IS SUPPLIED BY MICROCHIP "AS IS". NO WARRANTIES, WHETHER
+* EXPRESS, IMPLIED OR STATUTORY, APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED
+* WARRANTIES OF NON-INFRINGEMENT, MERCHANTABILITY, AND FITNESS FOR A
+* PARTICULAR PURPOSE.
+*
+* IN NO EVENT WILL MICROCHIP BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE,
+* INCIDENTAL OR CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND
+* WHATSOEVER RELATED TO THE SOFTWARE, HOWEVER CAUSED, EVEN IF MICROCHIP HAS
+* BEEN ADVISED OF THE POSSIBILITY OR THE DAMAGES ARE FORESEEABLE. TO THE
+* FULLEST EXTENT ALLOWED BY LAW, MICROCHIP'S TOTAL LIABILITY ON ALL CLAIMS IN
+* ANY WAY RELATED TO THIS SOFTWARE WILL NOT EXCEED THE AMOUNT OF FEES, IF ANY,
+* THAT YOU HAVE PAID DIRECTLY TO MICROCHIP FOR THIS SOFTWARE.
+*******************************************************************************/
+//DOM-IGNORE-END
+
+
+
+#ifndef APP_CAN_IDFILTER_H
+#define APP_CAN_IDFILTER_H
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Included Files
+// *****************************************************************************
+// *****************************************************************************
+
+#include <stdbool.h>
+#include <stdint.h>
+
+// DOM-IGNORE-BEGIN
+#ifdef __cplusplus  // Provide C++ Compatibility
+    extern "C" {
+#endif
+// DOM-IGNORE-END
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Data Types
+// *****************************************************************************
+// *****************************************************************************
+
+/* Maximum number of extended IDs in the filter */
+#define APP_CAN_IDFILTER_EXT_IDS                256U
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Interface Routines
+// *****************************************************************************
+// *****************************************************************************
+
+/* Accept all frames */
+void APP_CAN_IdFilterInitialize(void);
+
+/* Starts a new filter with an empty ID list. An empty list accepts all
+   frames, otherwise only the listed IDs are accepted. */
+void APP_CAN_IdFilterEditBegin(void);
+
+/* Adds an ID to the new filter, false when the ID is invalid or the
+   extended ID list is full */
+bool APP_CAN_IdFilterEditAdd(uint32_t id, bool xtd);
+
+/* Replaces the filter in use by the new filter */
+void APP_CAN_IdFilterEditCommit(void);
+
+/* Returns true if the frame is accepted. May be called from the CAN1
+   interrupt while the filter is being edited. */
+bool APP_CAN_IdFilterAccept(uint32_t id, bool xtd);
+
+/* Number of frames rejected */
+uint32_t APP_CAN_IdFilterRejectedGet(void);
+
+// DOM-IGNORE-BEGIN
+#ifdef __cplusplus  // Provide C++ Compatibility
+    }
+#endif
+// DOM-IGNORE-END
+
+#endif // APP_CAN_IDFILTER_H
+
+/*******************************************************************************
+ End of File
+*/
@@ -0,0 +1,270 @@
+/*******************************************************************************
+  CAN Bus Load Source File
+
+  Company:
+    Microchip Technology Inc.
+
+  File Name:
+    app_can_load.c
+
+  Summary:
+    CAN bus load measurement implementation.
+
+  Description:
+    This file implements the bus load measurement. The bus time of every frame
+    is computed from the nominal and data bit timing programmed into CAN_NBTP
+    and CAN_DBTP, the frame format and its length, assuming the worst case
+    number of stuff bits. Bus time is summed into 100 ms buckets on the frame
+    timestamps, which gives rolling 100 ms, 1 s and 10 s windows.
+*******************************************************************************/
+
+//DOM-IGNORE-BEGIN
+/*******************************************************************************
+* Copyright (C) 2024 Microchip Technology Inc. and its subsidiaries.
+*
+* Subject to your compliance with these terms, you may use Microchip software
+* and any derivatives exclusively with Microchip products. It is your
+* responsibility to comply with third party license terms applicable to your
+* use of third party software (including open source software) that may
+* accompany Microchip software.
+*
+* THIS SOFTWARE IS SUPPLIED BY MICROCHIP "AS IS". NO WARRANTIES, WHETHER
+* EXPRESS, IMPLIED OR STATUTORY, APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED
+* WARRANTIES OF NON-INFRINGEMENT, MERCHANTABILITY, AND FITNESS FOR A
+* PARTICULAR PURPOSE.
+*
+* IN NO EVENT WILL MICROCHIP BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE,
+* INCIDENTAL OR CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND
+* WHATSOEVER RELATED TO THE SOFTWARE, HOWEVER CAUSED, EVEN IF MICROCHIP HAS
+* BEEN ADVISED OF THE POSSIBILITY OR THE DAMAGES ARE FORESEEABLE. TO THE
+* FULLEST EXTENT ALLOWED BY LAW, MICROCHIP'S TOTAL LIABILITY ON ALL CLAIMS IN
+* ANY WAY RELATED TO THIS SOFTWARE WILL NOT EXCEED THE AMOUNT OF FEES, IF ANY,
+* THAT YOU HAVE PAID DIRECTLY TO MICROCHIP FOR THIS SOFTWARE.
+*******************************************************************************/
+//DOM-IGNORE-END
+
+
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Included Files
+// *****************************************************************************
+// *****************************************************************************
+
+#include <string.h>
+#include "app_can_load.h"
+#include "app_can_format.h"
+#include "app_can_bitrate.h"
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Global Data
+// *****************************************************************************
+// *****************************************************************************
+
+/* 100 complete 100 ms buckets (10 s) plus the one being filled */
+#define APP_CAN_LOAD_BUCKETS                    101U
+#define APP_CAN_LOAD_BUCKETS_PER_SECOND         10U
+
+/* CAN clock cycles per extended timestamp tick, the same for every bit
+   timing as CAN1_BitTimingSet rescales the timestamp counter */
+#define APP_CAN_LOAD_CYCLES_PER_TICK            (APP_CAN_BITRATE_CLOCK_HZ / APP_CAN_FORMAT_TICKS_PER_SECOND)
+
+/* Bits after the CRC delimiter: ACK slot, ACK delimiter, EOF, IFS */
+#define APP_CAN_LOAD_FD_TRAILER_BITS            12U
+
+typedef struct
+{
+    /* Bus time in CAN clock cycles */
+    uint32_t arbitration;
+    uint32_t data;
+} APP_CAN_LOAD_BUCKET;
+
+static const uint8_t loadDlcLength[16] = {0U, 1U, 2U, 3U, 4U, 5U, 6U, 7U, 8U, 12U, 16U, 20U, 24U, 32U, 48U, 64U};
+
+static APP_CAN_LOAD_BUCKET loadBucket[APP_CAN_LOAD_BUCKETS];
+static uint32_t loadBucketIndex = 0U;
+static uint32_t loadBucketsComplete = 0U;
+/* Ticks elapsed in the current bucket */
+static uint32_t loadBucketPhase = 0U;
+static uint32_t loadLastTimestamp = 0U;
+static bool loadStarted = false;
+
+/* CAN clock cycles per nominal and data bit, timestamp ticks per bucket */
+static uint32_t loadNominalCycles = 1U;
+static uint32_t loadDataCycles = 1U;
+static uint32_t loadTicksPerBucket = 1U;
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: CAN Bus Load Routines
+// *****************************************************************************
+// *****************************************************************************
+
+void APP_CAN_LoadInitialize(void)
+{
+    uint32_t nbtp = CAN1_REGS->CAN_NBTP;
+    uint32_t dbtp = CAN1_REGS->CAN_DBTP;
+
+    /* Bit time = prescaler * (sync segment + TSEG1 + TSEG2), fields are value - 1 */
+    loadNominalCycles = (((nbtp & CAN_NBTP_NBRP_Msk) >> CAN_NBTP_NBRP_Pos) + 1U) *
+                        (3U + ((nbtp & CAN_NBTP_NTSEG1_Msk) >> CAN_NBTP_NTSEG1_Pos) +
+                         ((nbtp & CAN_NBTP_NTSEG2_Msk) >> CAN_NBTP_NTSEG2_Pos));
+    loadDataCycles = (((dbtp & CAN_DBTP_DBRP_Msk) >> CAN_DBTP_DBRP_Pos) + 1U) *
+                     (3U + ((dbtp & CAN_DBTP_DTSEG1_Msk) >> CAN_DBTP_DTSEG1_Pos) +
+                      ((dbtp & CAN_DBTP_DTSEG2_Msk) >> CAN_DBTP_DTSEG2_Pos));
+
+    /* Extended timestamps keep the unit of the generated nominal bit time
+       whatever bit timing is set (CAN1_BitTimingSet) */
+    loadTicksPerBucket = APP_CAN_FORMAT_TICKS_PER_SECOND / APP_CAN_LOAD_BUCKETS_PER_SECOND;
+
+    memset(loadBucket, 0, sizeof(loadBucket));
+    loadBucketIndex = 0U;
+    loadBucketsComplete = 0U;
+    loadBucketPhase = 0U;
+    loadStarted = false;
+}
+
+void APP_CAN_LoadAdvance(uint32_t timestamp)
+{
+    uint32_t elapsed = 0U;
+    uint32_t steps = 0U;
+
+    if (loadStarted == false)
+    {
+        loadStarted = true;
+        loadLastTimestamp = timestamp;
+        return;
+    }
+
+    /* Frames from the two Rx FIFOs may arrive slightly out of order */
+    elapsed = timestamp - loadLastTimestamp;
+    if ((int32_t)elapsed <= 0)
+    {
+        return;
+    }
+    loadLastTimestamp = timestamp;
+
+    loadBucketPhase += elapsed;
+    while ((loadBucketPhase >= loadTicksPerBucket) && (steps < APP_CAN_LOAD_BUCKETS))
+    {
+        loadBucketPhase -= loadTicksPerBucket;
+        loadBucketIndex = (loadBucketIndex + 1U) % APP_CAN_LOAD_BUCKETS;
+        loadBucket[loadBucketIndex].arbitration = 0U;
+        loadBucket[loadBucketIndex].data = 0U;
+        if (loadBucketsComplete < (APP_CAN_LOAD_BUCKETS - 1U))
+        {
+            loadBucketsComplete++;
+        }
+        steps++;
+    }
+    /* Idle for longer than all buckets */
+    loadBucketPhase %= loadTicksPerBucket;
+}
+
+/* Worst case bus time of a frame in CAN clock cycles, split into the
+   arbitration and the data phase */
+static void APP_CAN_LoadFrameCyclesGet(bool xtd, bool fdf, bool brs, uint32_t length, uint32_t *arbitration, uint32_t *data)
+{
+    uint32_t header = 0U;
+    uint32_t stuffed = 0U;
+    uint32_t arbitrationBits = 0U;
+    uint32_t dataBits = 0U;
+    uint32_t crcBits = 0U;
+
+    if (fdf == false)
+    {
+        /* SOF to CRC: 34 bits standard, 54 bits extended, plus the payload.
+           Worst case one stuff bit per 4 bits after the first, then CRC
+           delimiter, ACK, EOF and IFS (13 bits). */
+        stuffed = (xtd ? 54U : 34U) + (8U * length);
+        arbitrationBits = stuffed + ((stuffed - 1U) / 4U) + 13U;
+    }
+    else
+    {
+        /* SOF to BRS: 17 bits standard, 36 bits extended */
+        header = xtd ? 36U : 17U;
+        /* ESI, DLC and payload follow the bit rate switch */
+        dataBits = 5U + (8U * length);
+        /* Dynamic stuff bits up to the end of the payload, split by phase */
+        stuffed = ((header + dataBits - 1U) / 4U);
+        arbitrationBits = header + (header / 4U) + APP_CAN_LOAD_FD_TRAILER_BITS;
+        /* Stuff count, CRC17/CRC21 and their fixed stuff bits, CRC delimiter */
+        crcBits = (length > 16U) ? 21U : 17U;
+        dataBits += (stuffed - (header / 4U)) + 4U + crcBits + 1U + ((4U + crcBits) / 4U) + 1U;
+    }
+
+    if ((fdf == false) || (brs == false))
+    {
+        *arbitration = (arbitrationBits + dataBits) * loadNominalCycles;
+        *data = 0U;
+    }
+    else
+    {
+        *arbitration = arbitrationBits * loadNominalCycles;
+        *data = dataBits * loadDataCycles;
+    }
+}
+
+void APP_CAN_LoadFrameAdd(const APP_CAN_RING_ENTRY *entry)
+{
+    const CAN_RX_BUFFER *rxBuf = APP_CAN_RING_FRAME(entry);
+    uint32_t arbitration = 0U;
+    uint32_t data = 0U;
+
+    APP_CAN_LoadAdvance(entry->timestamp);
+
+    APP_CAN_LoadFrameCyclesGet((rxBuf->xtd != 0U), (rxBuf->fdf != 0U), (rxBuf->brs != 0U),
+                               rxBuf->rtr ? 0U : loadDlcLength[rxBuf->dlc], &arbitration, &data);
+    loadBucket[loadBucketIndex].arbitration += arbitration;
+    loadBucket[loadBucketIndex].data += data;
+}
+
+uint32_t APP_CAN_LoadFrameTicksGet(bool xtd, bool fdf, bool brs, uint32_t length)
+{
+    uint32_t arbitration = 0U;
+    uint32_t data = 0U;
+
+    APP_CAN_LoadFrameCyclesGet(xtd, fdf, brs, length, &arbitration, &data);
+    return (arbitration + data) / APP_CAN_LOAD_CYCLES_PER_TICK;
+}
+
+void APP_CAN_LoadGet(APP_CAN_LOAD_WINDOW window, APP_CAN_LOAD *load)
+{
+    uint32_t buckets = (window == APP_CAN_LOAD_WINDOW_10S) ? 100U : ((window == APP_CAN_LOAD_WINDOW_1S) ? 10U : 1U);
+    uint32_t index = loadBucketIndex;
+    uint64_t arbitration = 0U;
+    uint64_t data = 0U;
+    uint64_t windowCycles = 0U;
+    uint32_t count = 0U;
+
+    load->arbitration = 0U;
+    load->data = 0U;
+    load->total = 0U;
+
+    if (buckets > loadBucketsComplete)
+    {
+        buckets = loadBucketsComplete;
+    }
+    if (buckets == 0U)
+    {
+        return;
+    }
+
+    /* Complete buckets only, newest first */
+    for (count = 0U; count < buckets; count++)
+    {
+        index = (index + APP_CAN_LOAD_BUCKETS - 1U) % APP_CAN_LOAD_BUCKETS;
+        arbitration += loadBucket[index].arbitration;
+        data += loadBucket[index].data;
+    }
+
+    windowCycles = (uint64_t)buckets * loadTicksPerBucket * APP_CAN_LOAD_CYCLES_PER_TICK;
+    load->arbitration = (uint32_t)((arbitration * 10000U) / windowCycles);
+    load->data = (uint32_t)((data * 10000U) / windowCycles);
+    load->total = load->arbitration + load->data;
+}
+
+/*******************************************************************************
+ End of File
+*/
@@ -0,0 +1,120 @@
+/*******************************************************************************
+  CAN Bus Load Header File
+
+  Company:
+    Microchip Technology Inc.
+
+  File Name:
+    app_can_load.h
+
+  Summary:
+    CAN bus load measurement interface.
+
+  Description:
+    This file declares the bus load measurement, which estimates the time every
+    received frame occupied the bus and reports it over rolling windows.
+*******************************************************************************/
+
+//DOM-IGNORE-BEGIN
+/*******************************************************************************
+* Copyright (C) 2024 Microchip Technology Inc. and its subsidiaries.
+*
+* Subject to your compliance with these terms, you may use Microchip software
+* and any derivatives exclusively with Microchip products. It is your
+* responsibility to comply with third party license terms applicable to your
+* use of third party software (including open source software) that may
+* accompany Microchip software.
+*
+* THIS SOFTWARE IS SUPPLIED BY MICROCHIP "AS IS". NO WARRANTIES, WHETHER
+* EXPRESS, IMPLIED OR STATUTORY, APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED
+* WARRANTIES OF NON-INFRINGEMENT, MERCHANTABILITY, AND FITNESS FOR A
+* PARTICULAR PURPOSE.
+*
+* IN NO EVENT WILL MICROCHIP BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE,
+* INCIDENTAL OR CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND
+* WHATSOEVER RELATED TO THE SOFTWARE, HOWEVER CAUSED, EVEN IF MICROCHIP HAS
+* BEEN ADVISED OF THE POSSIBILITY OR THE DAMAGES ARE FORESEEABLE. TO THE
+* FULLEST EXTENT ALLOWED BY LAW, MICROCHIP'S TOTAL LIABILITY ON ALL CLAIMS IN
+* ANY WAY RELATED TO THIS SOFTWARE WILL NOT EXCEED THE AMOUNT OF FEES, IF ANY,
+* THAT YOU HAVE PAID DIRECTLY TO MICROCHIP FOR THIS SOFTWARE.
+*******************************************************************************/
+//DOM-IGNORE-END
+
+
+
+#ifndef APP_CAN_LOAD_H
+#define APP_CAN_LOAD_H
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Included Files
+// *****************************************************************************
+// *****************************************************************************
+
+#include <stdint.h>
+#include "app_can_ring.h"
+
+// DOM-IGNORE-BEGIN
+#ifdef __cplusplus  // Provide C++ Compatibility
+    extern "C" {
+#endif
+// DOM-IGNORE-END
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Data Types
+// *****************************************************************************
+// *****************************************************************************
+
+typedef enum
+{
+    APP_CAN_LOAD_WINDOW_100MS = 0,
+    APP_CAN_LOAD_WINDOW_1S,
+    APP_CAN_LOAD_WINDOW_10S
+} APP_CAN_LOAD_WINDOW;
+
+/* Bus utilisation in 0.01 % units */
+typedef struct
+{
+    /* Time spent in the arbitration (nominal bit rate) phase */
+    uint32_t arbitration;
+    /* Time spent in the data (data bit rate) phase of CAN FD frames with BRS */
+    uint32_t data;
+    /* Sum of both */
+    uint32_t total;
+} APP_CAN_LOAD;
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Interface Routines
+// *****************************************************************************
+// *****************************************************************************
+
+/* Reads the bit timing from CAN1 and clears all windows. Call after
+   CAN1_Initialize and again whenever the bit timing changes. */
+void APP_CAN_LoadInitialize(void);
+
+/* Accounts one received frame, call once per frame */
+void APP_CAN_LoadFrameAdd(const APP_CAN_RING_ENTRY *entry);
+
+/* Worst case bus time of a frame with length payload bytes at the current
+   bit timing, in extended timestamp ticks */
+uint32_t APP_CAN_LoadFrameTicksGet(bool xtd, bool fdf, bool brs, uint32_t length);
+
+/* Moves the windows forward to timestamp (extended Rx timestamp ticks) */
+void APP_CAN_LoadAdvance(uint32_t timestamp);
+
+/* Load over the most recent complete 100 ms periods of the window */
+void APP_CAN_LoadGet(APP_CAN_LOAD_WINDOW window, APP_CAN_LOAD *load);
+
+// DOM-IGNORE-BEGIN
+#ifdef __cplusplus  // Provide C++ Compatibility
+    }
+#endif
+// DOM-IGNORE-END
+
+#endif // APP_CAN_LOAD_H
+
+/*******************************************************************************
+ End of File
+*/
@@ -0,0 +1,480 @@
+/*******************************************************************************
+  CAN Record Encoder and Decoder Source File
+
+  Company:
+    Microchip Technology Inc.
+
+  File Name:
+    app_can_record.c
+
+  Summary:
+    CAN binary record encoder and decoder implementation.
+
+  Description:
+    This file implements the COBS framed binary CAN record encoder and decoder.
+    The record format is documented in README.md (Binary Record Stream).
+*******************************************************************************/
+
+//DOM-IGNORE-BEGIN
+/*******************************************************************************
+* Copyright (C) 2024 Microchip Technology Inc. and its subsidiaries.
+*
+* Subject to your compliance with these terms, you may use Microchip software
+* and any derivatives exclusively with Microchip products. It is your
+* responsibility to comply with third party license terms applicable to your
+* use of third party software (including open source software) that may
+* accompany Microchip software.
+*
+* THIS SOFTWARE IS SUPPLIED BY MICROCHIP "AS IS". NO WARRANTIES, WHETHER
+* EXPRESS, IMPLIED OR STATUTORY, APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED
+* WARRANTIES OF NON-INFRINGEMENT, MERCHANTABILITY, AND FITNESS FOR A
+* PARTICULAR PURPOSE.
+*
+* IN NO EVENT WILL MICROCHIP BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE,
+* INCIDENTAL OR CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND
+* WHATSOEVER RELATED TO THE SOFTWARE, HOWEVER CAUSED, EVEN IF MICROCHIP HAS
+* BEEN ADVISED OF THE POSSIBILITY OR THE DAMAGES ARE FORESEEABLE. TO THE
+* FULLEST EXTENT ALLOWED BY LAW, MICROCHIP'S TOTAL LIABILITY ON ALL CLAIMS IN
+* ANY WAY RELATED TO THIS SOFTWARE WILL NOT EXCEED THE AMOUNT OF FEES, IF ANY,
+* THAT YOU HAVE PAID DIRECTLY TO MICROCHIP FOR THIS SOFTWARE.
+*******************************************************************************/
+//DOM-IGNORE-END
+
+
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Included Files
+// *****************************************************************************
+// *****************************************************************************
+
+#include <string.h>
+#include "app_can_record.h"
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Global Data
+// *****************************************************************************
+// *****************************************************************************
+
+/* CRC-16/CCITT-FALSE, polynomial 0x1021 */
+static const uint16_t recordCrcTable[256] =
+{
+    0x0000U, 0x1021U, 0x2042U, 0x3063U, 0x4084U, 0x50A5U, 0x60C6U, 0x70E7U,
+    0x8108U, 0x9129U, 0xA14AU, 0xB16BU, 0xC18CU, 0xD1ADU, 0xE1CEU, 0xF1EFU,
+    0x1231U, 0x0210U, 0x3273U, 0x2252U, 0x52B5U, 0x4294U, 0x72F7U, 0x62D6U,
+    0x9339U, 0x8318U, 0xB37BU, 0xA35AU, 0xD3BDU, 0xC39CU, 0xF3FFU, 0xE3DEU,
+    0x2462U, 0x3443U, 0x0420U, 0x1401U, 0x64E6U, 0x74C7U, 0x44A4U, 0x5485U,
+    0xA56AU, 0xB54BU, 0x8528U, 0x9509U, 0xE5EEU, 0xF5CFU, 0xC5ACU, 0xD58DU,
+    0x3653U, 0x2672U, 0x1611U, 0x0630U, 0x76D7U, 0x66F6U, 0x5695U, 0x46B4U,
+    0xB75BU, 0xA77AU, 0x9719U, 0x8738U, 0xF7DFU, 0xE7FEU, 0xD79DU, 0xC7BCU,
+    0x48C4U, 0x58E5U, 0x6886U, 0x78A7U, 0x0840U, 0x1861U, 0x2802U, 0x3823U,
+    0xC9CCU, 0xD9EDU, 0xE98EU, 0xF9AFU, 0x8948U, 0x9969U, 0xA90AU, 0xB92BU,
+    0x5AF5U, 0x4AD4U, 0x7AB7U, 0x6A96U, 0x1A71U, 0x0A50U, 0x3A33U, 0x2A12U,
+    0xDBFDU, 0xCBDCU, 0xFBBFU, 0xEB9EU, 0x9B79U, 0x8B58U, 0xBB3BU, 0xAB1AU,
+    0x6CA6U, 0x7C87U, 0x4CE4U, 0x5CC5U, 0x2C22U, 0x3C03U, 0x0C60U, 0x1C41U,
+    0xEDAEU, 0xFD8FU, 0xCDECU, 0xDDCDU, 0xAD2AU, 0xBD0BU, 0x8D68U, 0x9D49U,
+    0x7E97U, 0x6EB6U, 0x5ED5U, 0x4EF4U, 0x3E13U, 0x2E32U, 0x1E51U, 0x0E70U,
+    0xFF9FU, 0xEFBEU, 0xDFDDU, 0xCFFCU, 0xBF1BU, 0xAF3AU, 0x9F59U, 0x8F78U,
+    0x9188U, 0x81A9U, 0xB1CAU, 0xA1EBU, 0xD10CU, 0xC12DU, 0xF14EU, 0xE16FU,
+    0x1080U, 0x00A1U, 0x30C2U, 0x20E3U, 0x5004U, 0x4025U, 0x7046U, 0x6067U,
+    0x83B9U, 0x9398U, 0xA3FBU, 0xB3DAU, 0xC33DU, 0xD31CU, 0xE37FU, 0xF35EU,
+    0x02B1U, 0x1290U, 0x22F3U, 0x32D2U, 0x4235U, 0x5214U, 0x6277U, 0x7256U,
+    0xB5EAU, 0xA5CBU, 0x95A8U, 0x8589U, 0xF56EU, 0xE54FU, 0xD52CU, 0xC50DU,
+    0x34E2U, 0x24C3U, 0x14A0U, 0x0481U, 0x7466U, 0x6447U, 0x5424U, 0x4405U,
+    0xA7DBU, 0xB7FAU, 0x8799U, 0x97B8U, 0xE75FU, 0xF77EU, 0xC71DU, 0xD73CU,
+    0x26D3U, 0x36F2U, 0x0691U, 0x16B0U, 0x6657U, 0x7676U, 0x4615U, 0x5634U,
+    0xD94CU, 0xC96DU, 0xF90EU, 0xE92FU, 0x99C8U, 0x89E9U, 0xB98AU, 0xA9ABU,
+    0x5844U, 0x4865U, 0x7806U, 0x6827U, 0x18C0U, 0x08E1U, 0x3882U, 0x28A3U,
+    0xCB7DU, 0xDB5CU, 0xEB3FU, 0xFB1EU, 0x8BF9U, 0x9BD8U, 0xABBBU, 0xBB9AU,
+    0x4A75U, 0x5A54U, 0x6A37U, 0x7A16U, 0x0AF1U, 0x1AD0U, 0x2AB3U, 0x3A92U,
+    0xFD2EU, 0xED0FU, 0xDD6CU, 0xCD4DU, 0xBDAAU, 0xAD8BU, 0x9DE8U, 0x8DC9U,
+    0x7C26U, 0x6C07U, 0x5C64U, 0x4C45U, 0x3CA2U, 0x2C83U, 0x1CE0U, 0x0CC1U,
+    0xEF1FU, 0xFF3EU, 0xCF5DU, 0xDF7CU, 0xAF9BU, 0xBFBAU, 0x8FD9U, 0x9FF8U,
+    0x6E17U, 0x7E36U, 0x4E55U, 0x5E74U, 0x2E93U, 0x3EB2U, 0x0ED1U, 0x1EF0U
+};
+
+static const uint8_t recordDlcLength[16] = {0U, 1U, 2U, 3U, 4U, 5U, 6U, 7U, 8U, 12U, 16U, 20U, 24U, 32U, 48U, 64U};
+
+#define APP_CAN_RECORD_DELTA_MASK               (APP_CAN_RECORD_DELTA_IDS - 1U)
+/* Slots probed before an ID is sent without delta encoding */
+#define APP_CAN_RECORD_DELTA_PROBES             8U
+#define APP_CAN_RECORD_DELTA_EMPTY              0xFFFFFFFFUL
+
+/* Last keyframe sent for one ID */
+typedef struct
+{
+    /* ID[28:0] plus XTD bit, APP_CAN_RECORD_DELTA_EMPTY when unused */
+    uint32_t key;
+    uint32_t keyframeTimestamp;
+    /* DLC/flags byte of the keyframe, without the record type */
+    uint8_t dlcFlags;
+    uint8_t data[64];
+} APP_CAN_RECORD_DELTA_ENTRY;
+
+static APP_CAN_RECORD_DELTA_ENTRY recordDelta[APP_CAN_RECORD_DELTA_IDS];
+static bool recordDeltaInitialized = false;
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: CAN Record Encoder and Decoder Routines
+// *****************************************************************************
+// *****************************************************************************
+
+static uint16_t APP_CAN_RecordCrcUpdate(uint16_t crc, const uint8_t *data, size_t length)
+{
+    while (length-- > 0U)
+    {
+        crc = (uint16_t)((crc << 8) ^ recordCrcTable[(uint8_t)((crc >> 8) ^ *data++)]);
+    }
+    return crc;
+}
+
+uint16_t APP_CAN_RecordCrc16(const uint8_t *data, size_t length)
+{
+    return APP_CAN_RecordCrcUpdate(0xFFFFU, data, length);
+}
+
+/* Consistent Overhead Byte Stuffing, output holds no 0x00 bytes */
+static size_t APP_CAN_RecordCobsEncode(const uint8_t *input, size_t length, uint8_t *output)
+{
+    size_t codeIndex = 0U;
+    size_t outIndex = 1U;
+    uint8_t code = 1U;
+
+    while (length-- > 0U)
+    {
+        if (*input == 0U)
+        {
+            output[codeIndex] = code;
+            codeIndex = outIndex++;
+            code = 1U;
+        }
+        else
+        {
+            output[outIndex++] = *input;
+            code++;
+            if (code == 0xFFU)
+            {
+                output[codeIndex] = code;
+                codeIndex = outIndex++;
+                code = 1U;
+            }
+        }
+        input++;
+    }
+    output[codeIndex] = code;
+    return outIndex;
+}
+
+/* Reverses APP_CAN_RecordCobsEncode, returns 0 when the encoding is invalid */
+static size_t APP_CAN_RecordCobsDecode(const uint8_t *input, size_t length, uint8_t *output, size_t size)
+{
+    size_t inIndex = 0U;
+    size_t outIndex = 0U;
+    uint8_t code = 0U;
+
+    while (inIndex < length)
+    {
+        code = input[inIndex++];
+        if ((code == 0U) || ((inIndex + code - 1U) > length) || ((outIndex + code - 1U) > size))
+        {
+            return 0U;
+        }
+        memcpy(&output[outIndex], &input[inIndex], code - 1U);
+        outIndex += code - 1U;
+        inIndex += code - 1U;
+        /* A group shorter than 254 bytes stood for a zero, except at the end */
+        if ((code != 0xFFU) && (inIndex < length))
+        {
+            if (outIndex == size)
+            {
+                return 0U;
+            }
+            output[outIndex++] = 0U;
+        }
+    }
+    return outIndex;
+}
+
+/* Writes the common record header, returns the payload length */
+static uint8_t APP_CAN_RecordHeaderWrite(const APP_CAN_RING_ENTRY *entry, uint8_t *raw, uint32_t type)
+{
+    const CAN_RX_BUFFER *rxBuf = APP_CAN_RING_FRAME(entry);
+    uint32_t idWord = 0U;
+
+    idWord = rxBuf->xtd ? rxBuf->id : (rxBuf->id >> 18);
+    idWord |= rxBuf->xtd ? APP_CAN_RECORD_ID_XTD : 0U;
+    idWord |= rxBuf->rtr ? APP_CAN_RECORD_ID_RTR : 0U;
+    idWord |= rxBuf->esi ? APP_CAN_RECORD_ID_ESI : 0U;
+
+    raw[0] = (uint8_t)entry->timestamp;
+    raw[1] = (uint8_t)(entry->timestamp >> 8);
+    raw[2] = (uint8_t)(entry->timestamp >> 16);
+    raw[3] = (uint8_t)(entry->timestamp >> 24);
+    raw[4] = (uint8_t)idWord;
+    raw[5] = (uint8_t)(idWord >> 8);
+    raw[6] = (uint8_t)(idWord >> 16);
+    raw[7] = (uint8_t)(idWord >> 24);
+    raw[8] = (uint8_t)(rxBuf->dlc | (rxBuf->brs ? APP_CAN_RECORD_DLC_BRS : 0U) |
+             (rxBuf->fdf ? APP_CAN_RECORD_DLC_FDF : 0U) | (type << APP_CAN_RECORD_DLC_TYPE_Pos));
+
+    return rxBuf->rtr ? 0U : recordDlcLength[rxBuf->dlc];
+}
+
+/* Appends the CRC and frames the raw record. The CRC also covers the
+   checkLength bytes at check, which are not sent. */
+static size_t APP_CAN_RecordFinish(uint8_t *raw, size_t rawLength, const uint8_t *check, size_t checkLength,
+                                   uint8_t *record)
+{
+    size_t recordLength = 0U;
+    uint16_t crc = APP_CAN_RecordCrcUpdate(APP_CAN_RecordCrc16(raw, rawLength), check, checkLength);
+
+    raw[rawLength++] = (uint8_t)crc;
+    raw[rawLength++] = (uint8_t)(crc >> 8);
+
+    /* Leading delimiter resynchronises receivers after any text output */
+    record[0] = 0U;
+    recordLength = 1U + APP_CAN_RecordCobsEncode(raw, rawLength, &record[1]);
+    record[recordLength++] = 0U;
+
+    return recordLength;
+}
+
+size_t APP_CAN_RecordEncode(const APP_CAN_RING_ENTRY *entry, uint8_t *record, size_t size)
+{
+    uint8_t raw[APP_CAN_RECORD_RAW_MAX_SIZE];
+    uint8_t length = 0U;
+
+    if ((record == NULL) || (size < APP_CAN_RECORD_MAX_SIZE))
+    {
+        return 0U;
+    }
+
+    length = APP_CAN_RecordHeaderWrite(entry, raw, APP_CAN_RECORD_TYPE_FULL);
+    memcpy(&raw[APP_CAN_RECORD_HEADER_SIZE], APP_CAN_RING_FRAME(entry)->data, length);
+
+    return APP_CAN_RecordFinish(raw, APP_CAN_RECORD_HEADER_SIZE + length, NULL, 0U, record);
+}
+
+size_t APP_CAN_RecordPack(const APP_CAN_RING_ENTRY *entry, uint8_t *raw)
+{
+    uint8_t length = APP_CAN_RecordHeaderWrite(entry, raw, APP_CAN_RECORD_TYPE_FULL);
+
+    memcpy(&raw[APP_CAN_RECORD_HEADER_SIZE], APP_CAN_RING_FRAME(entry)->data, length);
+    return APP_CAN_RECORD_HEADER_SIZE + length;
+}
+
+size_t APP_CAN_RecordPackedSize(const uint8_t *raw)
+{
+    if ((raw[7] & (uint8_t)(APP_CAN_RECORD_ID_RTR >> 24)) != 0U)
+    {
+        return APP_CAN_RECORD_HEADER_SIZE;
+    }
+    return APP_CAN_RECORD_HEADER_SIZE + recordDlcLength[raw[8] & 0x0FU];
+}
+
+void APP_CAN_RecordUnpack(const uint8_t *raw, APP_CAN_RING_ENTRY *entry)
+{
+    CAN_RX_BUFFER *rxBuf = APP_CAN_RING_FRAME(entry);
+    uint32_t idWord = (uint32_t)raw[4] | ((uint32_t)raw[5] << 8) | ((uint32_t)raw[6] << 16) | ((uint32_t)raw[7] << 24);
+
+    memset(entry, 0, sizeof(*entry));
+    entry->timestamp = (uint32_t)raw[0] | ((uint32_t)raw[1] << 8) | ((uint32_t)raw[2] << 16) | ((uint32_t)raw[3] << 24);
+    rxBuf->xtd = ((idWord & APP_CAN_RECORD_ID_XTD) != 0U) ? 1U : 0U;
+    /* Standard IDs are kept in id[28:18] as in Message RAM */
+    rxBuf->id = rxBuf->xtd ? (idWord & 0x1FFFFFFFUL) : ((idWord & 0x7FFUL) << 18);
+    rxBuf->rtr = ((idWord & APP_CAN_RECORD_ID_RTR) != 0U) ? 1U : 0U;
+    rxBuf->esi = ((idWord & APP_CAN_RECORD_ID_ESI) != 0U) ? 1U : 0U;
+    rxBuf->rxts = (uint16_t)entry->timestamp;
+    rxBuf->dlc = raw[8] & 0x0FU;
+    rxBuf->brs = ((raw[8] & APP_CAN_RECORD_DLC_BRS) != 0U) ? 1U : 0U;
+    rxBuf->fdf = ((raw[8] & APP_CAN_RECORD_DLC_FDF) != 0U) ? 1U : 0U;
+    /* Extended frames are received into Rx FIFO1 */
+    entry->source = rxBuf->xtd ? (uint8_t)APP_CAN_RX_SOURCE_FIFO1 : (uint8_t)APP_CAN_RX_SOURCE_FIFO0;
+    memcpy(rxBuf->data, &raw[APP_CAN_RECORD_HEADER_SIZE], APP_CAN_RecordPackedSize(raw) - APP_CAN_RECORD_HEADER_SIZE);
+}
+
+bool APP_CAN_RecordDecode(const uint8_t *record, size_t length, APP_CAN_RING_ENTRY *entry, uint32_t *type)
+{
+    uint8_t raw[APP_CAN_RECORD_RAW_MAX_SIZE];
+    size_t rawLength = APP_CAN_RecordCobsDecode(record, length, raw, sizeof(raw));
+
+    if ((rawLength < (APP_CAN_RECORD_HEADER_SIZE + APP_CAN_RECORD_CRC_SIZE)) ||
+        (APP_CAN_RecordCrc16(raw, rawLength - APP_CAN_RECORD_CRC_SIZE) !=
+         ((uint16_t)raw[rawLength - 2U] | ((uint16_t)raw[rawLength - 1U] << 8))))
+    {
+        return false;
+    }
+    rawLength -= APP_CAN_RECORD_CRC_SIZE;
+
+    *type = (uint32_t)raw[8] >> APP_CAN_RECORD_DLC_TYPE_Pos;
+    switch (*type)
+    {
+        case APP_CAN_RECORD_TYPE_FULL:
+            if (rawLength != APP_CAN_RecordPackedSize(raw))
+            {
+                return false;
+            }
+            APP_CAN_RecordUnpack(raw, entry);
+            break;
+        case APP_CAN_RECORD_TYPE_END:
+            memset(entry, 0, sizeof(*entry));
+            entry->timestamp = (uint32_t)raw[0] | ((uint32_t)raw[1] << 8) | ((uint32_t)raw[2] << 16) | ((uint32_t)raw[3] << 24);
+            break;
+        default:
+            break;
+    }
+    return true;
+}
+
+void APP_CAN_RecordDeltaReset(void)
+{
+    uint32_t index = 0U;
+
+    for (index = 0U; index < APP_CAN_RECORD_DELTA_IDS; index++)
+    {
+        recordDelta[index].key = APP_CAN_RECORD_DELTA_EMPTY;
+    }
+    recordDeltaInitialized = true;
+}
+
+/* Finds or allocates the slot for key, NULL when the probed slots are taken */
+static APP_CAN_RECORD_DELTA_ENTRY *APP_CAN_RecordDeltaLookup(uint32_t key, bool *found)
+{
+    APP_CAN_RECORD_DELTA_ENTRY *slot = NULL;
+    uint32_t index = (key * 2654435761UL) >> 16;
+    uint32_t probe = 0U;
+
+    for (probe = 0U; probe < APP_CAN_RECORD_DELTA_PROBES; probe++)
+    {
+        slot = &recordDelta[(index + probe) & APP_CAN_RECORD_DELTA_MASK];
+        if (slot->key == key)
+        {
+            *found = true;
+            return slot;
+        }
+        if (slot->key == APP_CAN_RECORD_DELTA_EMPTY)
+        {
+            *found = false;
+            slot->key = key;
+            return slot;
+        }
+    }
+    return NULL;
+}
+
+/* Full record, the base of the following delta records of the ID */
+static size_t APP_CAN_RecordKeyframe(const APP_CAN_RING_ENTRY *entry, APP_CAN_RECORD_DELTA_ENTRY *slot,
+                                     uint8_t *record, size_t size)
+{
+    const CAN_RX_BUFFER *rxBuf = APP_CAN_RING_FRAME(entry);
+
+    if (slot != NULL)
+    {
+        slot->keyframeTimestamp = entry->timestamp;
+        slot->dlcFlags = (uint8_t)(rxBuf->dlc | (rxBuf->brs ? APP_CAN_RECORD_DLC_BRS : 0U) |
+                                   (rxBuf->fdf ? APP_CAN_RECORD_DLC_FDF : 0U));
+        memcpy(slot->data, rxBuf->data, rxBuf->rtr ? 0U : recordDlcLength[rxBuf->dlc]);
+    }
+    return APP_CAN_RecordEncode(entry, record, size);
+}
+
+size_t APP_CAN_RecordEncodeDelta(const APP_CAN_RING_ENTRY *entry, uint8_t *record, size_t size)
+{
+    const CAN_RX_BUFFER *rxBuf = APP_CAN_RING_FRAME(entry);
+    APP_CAN_RECORD_DELTA_ENTRY *slot = NULL;
+    /* Room for a full bitmap and every byte changed, trimmed below */
+    uint8_t raw[APP_CAN_RECORD_RAW_MAX_SIZE + 8U];
+    uint8_t *bitmap = &raw[APP_CAN_RECORD_HEADER_SIZE];
+    uint8_t *changed = NULL;
+    uint32_t key = 0U;
+    uint32_t bitmapLength = 0U;
+    uint32_t index = 0U;
+    uint8_t length = 0U;
+    bool found = false;
+
+    if ((record == NULL) || (size < APP_CAN_RECORD_MAX_SIZE))
+    {
+        return 0U;
+    }
+    if (recordDeltaInitialized == false)
+    {
+        APP_CAN_RecordDeltaReset();
+    }
+
+    key = rxBuf->xtd ? (rxBuf->id | APP_CAN_RECORD_ID_XTD) : (rxBuf->id >> 18);
+    slot = APP_CAN_RecordDeltaLookup(key, &found);
+    length = APP_CAN_RecordHeaderWrite(entry, raw, APP_CAN_RECORD_TYPE_DELTA);
+
+    if ((slot == NULL) || (found == false) || (length == 0U) ||
+        (slot->dlcFlags != (raw[8] & ~(3U << APP_CAN_RECORD_DLC_TYPE_Pos))) ||
+        ((entry->timestamp - slot->keyframeTimestamp) >= APP_CAN_RECORD_KEYFRAME_TICKS))
+    {
+        return APP_CAN_RecordKeyframe(entry, slot, record, size);
+    }
+
+    /* Changed against the keyframe rather than the last record, so a lost
+       delta record does not affect the ones after it */
+    bitmapLength = ((uint32_t)length + 7U) >> 3;
+    memset(bitmap, 0, bitmapLength);
+    changed = bitmap + bitmapLength;
+    for (index = 0U; index < length; index++)
+    {
+        if (rxBuf->data[index] != slot->data[index])
+        {
+            bitmap[index >> 3] |= (uint8_t)(1U << (index & 7U));
+            *changed++ = rxBuf->data[index];
+        }
+    }
+
+    /* A delta that is not shorter than the payload is sent as a keyframe */
+    if ((uint32_t)(changed - bitmap) >= length)
+    {
+        return APP_CAN_RecordKeyframe(entry, slot, record, size);
+    }
+
+    /* The CRC also covers the complete payload, a receiver holding another
+       keyframe (the last one was lost) rejects the record */
+    return APP_CAN_RecordFinish(raw, (size_t)(changed - raw), rxBuf->data, length, record);
+}
+
+static uint8_t *APP_CAN_RecordWord(uint8_t *raw, uint32_t value)
+{
+    raw[0] = (uint8_t)value;
+    raw[1] = (uint8_t)(value >> 8);
+    raw[2] = (uint8_t)(value >> 16);
+    raw[3] = (uint8_t)(value >> 24);
+    return raw + 4;
+}
+
+size_t APP_CAN_RecordEncodeStats(const APP_CAN_STATS *stats, uint32_t timestamp, uint8_t *record, size_t size)
+{
+    uint8_t raw[APP_CAN_RECORD_RAW_MAX_SIZE];
+    uint8_t *field = raw;
+
+    if ((stats == NULL) || (record == NULL) || (size < APP_CAN_RECORD_MAX_SIZE))
+    {
+        return 0U;
+    }
+
+    field = APP_CAN_RecordWord(field, timestamp);
+    field = APP_CAN_RecordWord(field, stats->id | (stats->xtd ? APP_CAN_RECORD_ID_XTD : 0U));
+    *field++ = (uint8_t)(APP_CAN_RECORD_TYPE_STATS << APP_CAN_RECORD_DLC_TYPE_Pos);
+    field = APP_CAN_RecordWord(field, stats->count);
+    field = APP_CAN_RecordWord(field, stats->bytes);
+    field = APP_CAN_RecordWord(field, stats->minPeriod);
+    field = APP_CAN_RecordWord(field, stats->avgPeriod);
+    field = APP_CAN_RecordWord(field, stats->maxPeriod);
+    field = APP_CAN_RecordWord(field, stats->jitter);
+    field = APP_CAN_RecordWord(field, stats->fdf);
+    field = APP_CAN_RecordWord(field, stats->brs);
+    field = APP_CAN_RecordWord(field, stats->esi);
+    field = APP_CAN_RecordWord(field, stats->rtr);
+
+    return APP_CAN_RecordFinish(raw, (size_t)(field - raw), NULL, 0U, record);
+}
+
+/*******************************************************************************
+ End of File
+*/
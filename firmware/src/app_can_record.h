@@ -0,0 +1,172 @@
+/*******************************************************************************
+  CAN Record Encoder Header File
+
+  Company:
+    Microchip Technology Inc.
+
+  File Name:
+    app_can_record.h
+
+  Summary:
+    CAN binary record encoder interface.
+
+  Description:
+    This file declares the encoder for the COBS framed binary CAN record stream
+    sent on the debug and BLE links.
+*******************************************************************************/
+
+//DOM-IGNORE-BEGIN
+/*******************************************************************************
+* Copyright (C) 2024 Microchip Technology Inc. and its subsidiaries.
+*
+* Subject to your compliance with these terms, you may use Microchip software
+* and any derivatives exclusively with Microchip products. It is your
+* responsibility to comply with third party license terms applicable to your
+* use of third party software (including open source software) that may
+* accompany Microchip software.
+*
+* THIS SOFTWARE IS SUPPLIED BY MICROCHIP "AS IS". NO WARRANTIES, WHETHER
+* EXPRESS, IMPLIED OR STATUTORY, APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED
+* WARRANTIES OF NON-INFRINGEMENT, MERCHANTABILITY, AND FITNESS FOR A
+* PARTICULAR PURPOSE.
+*
+* IN NO EVENT WILL MICROCHIP BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE,
+* INCIDENTAL OR CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND
+* WHATSOEVER RELATED TO THE SOFTWARE, HOWEVER CAUSED, EVEN IF MICROCHIP HAS
+* BEEN ADVISED OF THE POSSIBILITY OR THE DAMAGES ARE FORESEEABLE. TO THE
+* FULLEST EXTENT ALLOWED BY LAW, MICROCHIP'S TOTAL LIABILITY ON ALL CLAIMS IN
+* ANY WAY RELATED TO THIS SOFTWARE WILL NOT EXCEED THE AMOUNT OF FEES, IF ANY,
+* THAT YOU HAVE PAID DIRECTLY TO MICROCHIP FOR THIS SOFTWARE.
+*******************************************************************************/
+//DOM-IGNORE-END
+
+
+
+#ifndef APP_CAN_RECORD_H
+#define APP_CAN_RECORD_H
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Included Files
+// *****************************************************************************
+// *****************************************************************************
+
+#include <stdint.h>
+#include <stddef.h>
+#include "app_can_ring.h"
+#include "app_can_stats.h"
+
+// DOM-IGNORE-BEGIN
+#ifdef __cplusplus  // Provide C++ Compatibility
+    extern "C" {
+#endif
+// DOM-IGNORE-END
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Data Types
+// *****************************************************************************
+// *****************************************************************************
+
+/* Record layout before COBS encoding (all fields little endian):
+     [0..3]  timestamp, nominal bit times
+     [4..7]  ID word: ID[28:0], XTD bit 29, RTR bit 30, ESI bit 31
+     [8]     DLC[3:0], BRS bit 4, FDF bit 5, record type[7:6]
+     [9..]   full record: valid payload bytes (none for remote frames)
+             delta record: bitmap of the bytes which differ from the last
+             full record of the ID (one bit per payload byte, LSB first)
+             followed by those bytes only
+             statistics record: DLC/flags are 0, the timestamp is the time
+             of the report, followed by ten 32-bit fields: count, bytes,
+             min/avg/max period, jitter, FDF/BRS/ESI/RTR counts
+             end record: header only, ends a stream sent to the sniffer
+             for replay, the timestamp is the end of the trace
+     [last]  CRC-16/CCITT-FALSE over all preceding bytes, for a delta
+             record followed by the complete payload it rebuilds */
+#define APP_CAN_RECORD_HEADER_SIZE              9U
+#define APP_CAN_RECORD_CRC_SIZE                 2U
+#define APP_CAN_RECORD_RAW_MAX_SIZE             (APP_CAN_RECORD_HEADER_SIZE + 64U + APP_CAN_RECORD_CRC_SIZE)
+
+/* Leading and trailing 0x00 delimiter plus one COBS code byte */
+#define APP_CAN_RECORD_MAX_SIZE                 (APP_CAN_RECORD_RAW_MAX_SIZE + 3U)
+
+#define APP_CAN_RECORD_ID_XTD                   (1UL << 29)
+#define APP_CAN_RECORD_ID_RTR                   (1UL << 30)
+#define APP_CAN_RECORD_ID_ESI                   (1UL << 31)
+#define APP_CAN_RECORD_DLC_BRS                  (1U << 4)
+#define APP_CAN_RECORD_DLC_FDF                  (1U << 5)
+#define APP_CAN_RECORD_DLC_TYPE_Pos             6U
+
+#define APP_CAN_RECORD_TYPE_FULL                0U
+#define APP_CAN_RECORD_TYPE_DELTA               1U
+#define APP_CAN_RECORD_TYPE_STATS               2U
+#define APP_CAN_RECORD_TYPE_END                 3U
+
+/* Identifiers remembered for delta records, must be a power of two */
+#ifndef APP_CAN_RECORD_DELTA_IDS
+#define APP_CAN_RECORD_DELTA_IDS                128U
+#endif
+
+#if ((APP_CAN_RECORD_DELTA_IDS & (APP_CAN_RECORD_DELTA_IDS - 1U)) != 0U)
+#error "APP_CAN_RECORD_DELTA_IDS must be a power of two"
+#endif
+
+/* A full record (keyframe) is sent for every ID at least this often,
+   in timestamp ticks (1 s at 500 kbit/s) */
+#ifndef APP_CAN_RECORD_KEYFRAME_TICKS
+#define APP_CAN_RECORD_KEYFRAME_TICKS           500000U
+#endif
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Interface Routines
+// *****************************************************************************
+// *****************************************************************************
+
+/* Encodes one captured frame into a delimited COBS record.
+   Returns the number of bytes written to record, or 0 when size is too small. */
+size_t APP_CAN_RecordEncode(const APP_CAN_RING_ENTRY *entry, uint8_t *record, size_t size);
+
+/* As APP_CAN_RecordEncode, but sends only the payload bytes which differ
+   from the last full record (keyframe) of the same ID whenever that is
+   shorter. IDs not seen before, and every ID once per
+   APP_CAN_RECORD_KEYFRAME_TICKS, get a keyframe so that a receiver joining
+   late or missing a keyframe can resynchronise. */
+size_t APP_CAN_RecordEncodeDelta(const APP_CAN_RING_ENTRY *entry, uint8_t *record, size_t size);
+
+/* Forgets all payloads remembered for delta records */
+void APP_CAN_RecordDeltaReset(void);
+
+/* Encodes the statistics of one ID, reported at timestamp */
+size_t APP_CAN_RecordEncodeStats(const APP_CAN_STATS *stats, uint32_t timestamp, uint8_t *record, size_t size);
+
+uint16_t APP_CAN_RecordCrc16(const uint8_t *data, size_t length);
+
+/* Stores a frame as a raw full record without CRC (header and payload) for
+   local buffering. Returns the length, at most APP_CAN_RECORD_HEADER_SIZE + 64. */
+size_t APP_CAN_RecordPack(const APP_CAN_RING_ENTRY *entry, uint8_t *raw);
+
+/* Length of a packed record, from its header */
+size_t APP_CAN_RecordPackedSize(const uint8_t *raw);
+
+/* Restores a frame stored by APP_CAN_RecordPack */
+void APP_CAN_RecordUnpack(const uint8_t *raw, APP_CAN_RING_ENTRY *entry);
+
+/* Decodes a received record, the bytes between two 0x00 delimiters. Returns
+   false when the COBS encoding, the length or the CRC is invalid, and for
+   delta records, whose CRC cannot be checked without their keyframe. type
+   is the record type, entry gets the frame of a full record and the
+   timestamp of an end record. */
+bool APP_CAN_RecordDecode(const uint8_t *record, size_t length, APP_CAN_RING_ENTRY *entry, uint32_t *type);
+
+// DOM-IGNORE-BEGIN
+#ifdef __cplusplus  // Provide C++ Compatibility
+    }
+#endif
+// DOM-IGNORE-END
+
+#endif // APP_CAN_RECORD_H
+
+/*******************************************************************************
+ End of File
+*/
@@ -0,0 +1,449 @@
+/*******************************************************************************
+  CAN Trace Replay Source File
+
+  Company:
+    Microchip Technology Inc.
+
+  File Name:
+    app_can_replay.c
+
+  Summary:
+    Timed replay of a recorded CAN trace on the CAN1 Tx FIFO, implementation.
+
+  Description:
+    This file implements the trace replay. Frames wait in a queue with their due
+    time in the CAN timestamp time base. TC0 wakes the scheduler when the next
+    frame is due, which puts it into the Tx FIFO, and the Tx Event FIFO gives
+    the timestamp of its start of frame, from which the timing error is taken.
+*******************************************************************************/
+
+//DOM-IGNORE-BEGIN
+/*******************************************************************************
+* Copyright (C) 2024 Microchip Technology Inc. and its subsidiaries.
+*
+* Subject to your compliance with these terms, you may use Microchip software
+* and any derivatives exclusively with Microchip products. It is your
+* responsibility to comply with third party license terms applicable to your
+* use of third party software (including open source software) that may
+* accompany Microchip software.
+*
+* THIS SOFTWARE IS SUPPLIED BY MICROCHIP "AS IS". NO WARRANTIES, WHETHER
+* EXPRESS, IMPLIED OR STATUTORY, APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED
+* WARRANTIES OF NON-INFRINGEMENT, MERCHANTABILITY, AND FITNESS FOR A
+* PARTICULAR PURPOSE.
+*
+* IN NO EVENT WILL MICROCHIP BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE,
+* INCIDENTAL OR CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND
+* WHATSOEVER RELATED TO THE SOFTWARE, HOWEVER CAUSED, EVEN IF MICROCHIP HAS
+* BEEN ADVISED OF THE POSSIBILITY OR THE DAMAGES ARE FORESEEABLE. TO THE
+* FULLEST EXTENT ALLOWED BY LAW, MICROCHIP'S TOTAL LIABILITY ON ALL CLAIMS IN
+* ANY WAY RELATED TO THIS SOFTWARE WILL NOT EXCEED THE AMOUNT OF FEES, IF ANY,
+* THAT YOU HAVE PAID DIRECTLY TO MICROCHIP FOR THIS SOFTWARE.
+*******************************************************************************/
+//DOM-IGNORE-END
+
+
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Included Files
+// *****************************************************************************
+// *****************************************************************************
+
+#include <string.h>
+#include "app_can_replay.h"
+#include "app_can_format.h"
+#include "app_can_record.h"
+#include "app_can_txevent.h"
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Global Data
+// *****************************************************************************
+// *****************************************************************************
+
+#define APP_CAN_REPLAY_FRAMES_MASK              (APP_CAN_REPLAY_FRAMES - 1U)
+#define APP_CAN_REPLAY_RESULTS_MASK             (APP_CAN_REPLAY_RESULTS - 1U)
+#define APP_CAN_REPLAY_START_TICKS              (APP_CAN_REPLAY_START_MS * (APP_CAN_FORMAT_TICKS_PER_SECOND / 1000U))
+
+/* The message marker holds the queue index of a frame */
+#if (APP_CAN_REPLAY_FRAMES > (APP_CAN_TXEVENT_MARKER_INDEX_Msk + 1U))
+#error "APP_CAN_REPLAY_FRAMES must not exceed 128"
+#endif
+
+/* Written by APP_CAN_ReplayFrameAdd at replayHead, read by the scheduler
+   (TC0 and CAN1 interrupts, same priority) at replayTail. An entry is free
+   again when the Tx event of its frame arrives at replayDone. The Tx FIFO
+   elements are built when a frame is added and kept apart from the due
+   times, so frames which are due together go to the Tx FIFO in one batch. */
+static CAN_TX_BUFFER replayBuffers[APP_CAN_REPLAY_FRAMES];
+/* Due time in extended CAN timestamp units */
+static uint32_t replayDue[APP_CAN_REPLAY_FRAMES];
+static volatile uint32_t replayHead = 0U;
+static volatile uint32_t replayTail = 0U;
+static uint32_t replayDone = 0U;
+
+static APP_CAN_REPLAY_RESULT replayResults[APP_CAN_REPLAY_RESULTS];
+static uint32_t replayResultHead = 0U;
+static uint32_t replayResultTail = 0U;
+
+static volatile APP_CAN_REPLAY_STATE replayState = APP_CAN_REPLAY_STATE_IDLE;
+/* TC0 is counting down to the next due frame */
+static volatile bool replayArmed = false;
+static APP_CAN_REPLAY_STATS replayStats;
+static uint32_t replaySequence = 0U;
+
+/* The first frame added gives the trace origin and the start time */
+static bool replayOriginSet = false;
+static uint32_t replayOrigin = 0U;
+static uint32_t replayStartTime = 0U;
+
+/* Record being received by APP_CAN_ReplayStreamReceive */
+static uint8_t replayStream[APP_CAN_RECORD_MAX_SIZE];
+static uint32_t replayStreamLength = 0U;
+static bool replayStreamOverrun = false;
+/* Bytes before the first delimiter, e.g. the end of the command line, are
+   not part of a record */
+static bool replayStreamSynced = false;
+static APP_CAN_RING_ENTRY replayStreamEntry;
+
+static const uint8_t replayDlcLength[16] = {0U, 1U, 2U, 3U, 4U, 5U, 6U, 7U, 8U, 12U, 16U, 20U, 24U, 32U, 48U, 64U};
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: CAN Trace Replay Routines
+// *****************************************************************************
+// *****************************************************************************
+
+/* Current CAN time, see CAN1_RxTimestampExtend. Call from the TC0 or CAN1
+   interrupt context or with interrupts disabled. */
+static uint32_t APP_CAN_ReplayNowGet(void)
+{
+    return CAN1_RxTimestampExtend((uint16_t)CAN1_REGS->CAN_TSCV);
+}
+
+/* Lets TC0 interrupt after wait CAN timestamp units. Longer waits than the
+   16-bit counter covers end early, the scheduler then arms it again. */
+static void APP_CAN_ReplayArm(uint32_t wait)
+{
+    uint64_t counts = ((uint64_t)wait * TC0_TimerFrequencyGet()) / APP_CAN_FORMAT_TICKS_PER_SECOND;
+
+    if (counts == 0U)
+    {
+        counts = 1U;
+    }
+    else if (counts > 0xFFFFU)
+    {
+        counts = 0xFFFFU;
+    }
+    replayArmed = true;
+    TC0_Timer16bitPeriodSet((uint16_t)counts);
+    TC0_TimerCommandSet(TC_COMMAND_START_RETRIGGER);
+}
+
+/* Puts the frames which are due into the Tx FIFO and arms TC0 for the next
+   one. Runs in the TC0 or CAN1 interrupt context or with interrupts disabled. */
+static void APP_CAN_ReplaySchedule(void)
+{
+    uint32_t now = 0U;
+    uint32_t index = 0U;
+    uint32_t count = 0U;
+    uint32_t accepted = 0U;
+    int32_t wait = 0;
+
+    replayArmed = false;
+    while ((replayState != APP_CAN_REPLAY_STATE_IDLE) && (replayTail != replayHead))
+    {
+        now = APP_CAN_ReplayNowGet();
+        index = replayTail & APP_CAN_REPLAY_FRAMES_MASK;
+
+        /* Due frames up to the end of the queue array */
+        count = 0U;
+        while (((replayTail + count) != replayHead) && ((index + count) < APP_CAN_REPLAY_FRAMES) &&
+               ((int32_t)(replayDue[index + count] - now) <= 0))
+        {
+            count++;
+        }
+        if (count == 0U)
+        {
+            wait = (int32_t)(replayDue[index] - now);
+            APP_CAN_ReplayArm((uint32_t)wait);
+            break;
+        }
+
+        /* One Message RAM copy and TXBAR write for as many as fit */
+        accepted = CAN1_MessageTransmitFifoBatch((uint8_t)((count > CAN1_TX_FIFO_BUFFER_ELEMENTS) ? CAN1_TX_FIFO_BUFFER_ELEMENTS : count),
+                                                 &replayBuffers[index]);
+        replayTail += accepted;
+        if (accepted < count)
+        {
+            /* The Tx Event FIFO interrupt schedules again when a frame is sent */
+            replayStats.fifoFull++;
+            break;
+        }
+    }
+}
+
+static void APP_CAN_ReplayTimerCallback(TC_TIMER_STATUS status, uintptr_t context)
+{
+    (void)status;
+    (void)context;
+    APP_CAN_ReplaySchedule();
+}
+
+/* Tx Event FIFO new entry, the Tx FIFO has room again. CAN1 interrupt context. */
+static void APP_CAN_ReplayTxEventCallback(uint8_t numberOfTxEvent, uintptr_t context)
+{
+    (void)numberOfTxEvent;
+    (void)context;
+    if ((replayState != APP_CAN_REPLAY_STATE_IDLE) && (replayArmed == false))
+    {
+        APP_CAN_ReplaySchedule();
+    }
+}
+
+void APP_CAN_ReplayInitialize(void)
+{
+    TC0_TimerCallbackRegister(APP_CAN_ReplayTimerCallback, 0U);
+    CAN1_TxEventFifoCallbackRegister(APP_CAN_ReplayTxEventCallback, 0U);
+    TC0_TimerStart();
+}
+
+bool APP_CAN_ReplayStart(void)
+{
+    if (replayState != APP_CAN_REPLAY_STATE_IDLE)
+    {
+        return false;
+    }
+    __disable_irq();
+    memset(&replayStats, 0, sizeof(replayStats));
+    replayHead = 0U;
+    replayTail = 0U;
+    replayDone = 0U;
+    replayResultHead = 0U;
+    replayResultTail = 0U;
+    replaySequence = 0U;
+    replayOriginSet = false;
+    replayStreamLength = 0U;
+    replayStreamOverrun = false;
+    replayStreamSynced = false;
+    replayState = APP_CAN_REPLAY_STATE_RUNNING;
+    __enable_irq();
+    return true;
+}
+
+bool APP_CAN_ReplayFrameAdd(const APP_CAN_RING_ENTRY *entry)
+{
+    const CAN_RX_BUFFER *rxBuf = APP_CAN_RING_FRAME(entry);
+    uint32_t index = replayHead & APP_CAN_REPLAY_FRAMES_MASK;
+    CAN_TX_BUFFER *txBuf = &replayBuffers[index];
+
+    if (replayState != APP_CAN_REPLAY_STATE_RUNNING)
+    {
+        return false;
+    }
+    if ((replayHead - replayDone) >= APP_CAN_REPLAY_FRAMES)
+    {
+        replayStats.dropped++;
+        return false;
+    }
+
+    memset(txBuf, 0, sizeof(*txBuf));
+    txBuf->id = rxBuf->id;
+    txBuf->rtr = rxBuf->rtr;
+    txBuf->xtd = rxBuf->xtd;
+    txBuf->esi = rxBuf->esi;
+    txBuf->dlc = rxBuf->dlc;
+    txBuf->brs = rxBuf->brs;
+    txBuf->fdf = rxBuf->fdf;
+    /* Store a Tx event, the marker finds the frame again */
+    txBuf->efc = 1U;
+    txBuf->mm = (uint8_t)(APP_CAN_TXEVENT_MARKER_REPLAY | (replayHead & APP_CAN_TXEVENT_MARKER_INDEX_Msk));
+    if (rxBuf->rtr == 0U)
+    {
+        memcpy(txBuf->data, rxBuf->data, replayDlcLength[rxBuf->dlc]);
+    }
+
+    if (replayOriginSet == false)
+    {
+        __disable_irq();
+        replayStartTime = APP_CAN_ReplayNowGet() + APP_CAN_REPLAY_START_TICKS;
+        __enable_irq();
+        replayOrigin = entry->timestamp;
+        replayOriginSet = true;
+    }
+    replayDue[index] = replayStartTime + (entry->timestamp - replayOrigin);
+    replayStats.queued++;
+
+    __disable_irq();
+    replayHead++;
+    if (replayArmed == false)
+    {
+        APP_CAN_ReplaySchedule();
+    }
+    __enable_irq();
+    return true;
+}
+
+uint32_t APP_CAN_ReplayFreeGet(void)
+{
+    if (replayState != APP_CAN_REPLAY_STATE_RUNNING)
+    {
+        return 0U;
+    }
+    return APP_CAN_REPLAY_FRAMES - (replayHead - replayDone);
+}
+
+void APP_CAN_ReplayEnd(void)
+{
+    __disable_irq();
+    if (replayState == APP_CAN_REPLAY_STATE_RUNNING)
+    {
+        replayState = (replayDone == replayHead) ? APP_CAN_REPLAY_STATE_IDLE : APP_CAN_REPLAY_STATE_DRAINING;
+    }
+    __enable_irq();
+}
+
+void APP_CAN_ReplayStop(void)
+{
+    __disable_irq();
+    if (replayState != APP_CAN_REPLAY_STATE_IDLE)
+    {
+        replayState = APP_CAN_REPLAY_STATE_IDLE;
+        replayTail = replayHead;
+        /* Only the replay frames, the cyclic scheduler shares the Tx FIFO.
+           Frames already in transmission complete. */
+        (void)CAN1_TxFifoCancel(APP_CAN_TXEVENT_MARKER_REPLAY, APP_CAN_TXEVENT_MARKER_SOURCE_Msk);
+    }
+    __enable_irq();
+}
+
+void APP_CAN_ReplayStreamReceive(uint8_t data)
+{
+    uint32_t type = 0U;
+
+    if (replayStreamSynced == false)
+    {
+        replayStreamSynced = (data == 0U);
+        return;
+    }
+    if (data != 0U)
+    {
+        if (replayStreamLength < sizeof(replayStream))
+        {
+            replayStream[replayStreamLength++] = data;
+        }
+        else
+        {
+            replayStreamOverrun = true;
+        }
+        return;
+    }
+
+    /* Delimiter, an empty record is the one between two delimiters */
+    if (replayStreamLength != 0U)
+    {
+        if ((replayStreamOverrun == true) ||
+            (APP_CAN_RecordDecode(replayStream, replayStreamLength, &replayStreamEntry, &type) == false))
+        {
+            replayStats.streamErrors++;
+        }
+        else if (type == APP_CAN_RECORD_TYPE_FULL)
+        {
+            /* A full queue counts the frame as dropped */
+            (void)APP_CAN_ReplayFrameAdd(&replayStreamEntry);
+        }
+        else if (type == APP_CAN_RECORD_TYPE_END)
+        {
+            APP_CAN_ReplayEnd();
+        }
+        else
+        {
+            /* Statistics records are not replayed */
+        }
+    }
+    replayStreamLength = 0U;
+    replayStreamOverrun = false;
+}
+
+void APP_CAN_ReplayTxEvent(const CAN_TX_EVENT *event)
+{
+    const CAN_TX_EVENT_FIFO *element = &event->element;
+    APP_CAN_REPLAY_RESULT *result = NULL;
+    uint32_t sequence = 0U;
+    uint32_t due = 0U;
+    int32_t error = 0;
+
+    /* Frames of a stopped replay still finish */
+    if (((element->mm & APP_CAN_TXEVENT_MARKER_SOURCE_Msk) != APP_CAN_TXEVENT_MARKER_REPLAY) ||
+        (replayState == APP_CAN_REPLAY_STATE_IDLE))
+    {
+        return;
+    }
+    /* Frames are sent in queue order, events lost by the driver are skipped */
+    sequence = replayDone + ((element->mm - replayDone) & APP_CAN_TXEVENT_MARKER_INDEX_Msk);
+    if ((int32_t)(replayTail - sequence) <= 0)
+    {
+        return;
+    }
+    due = replayDue[sequence & APP_CAN_REPLAY_FRAMES_MASK];
+    error = (int32_t)(event->timestamp - due);
+    replayDone = sequence + 1U;
+
+    if ((replayStats.sent == 0U) || (error < replayStats.errorMin))
+    {
+        replayStats.errorMin = error;
+    }
+    if ((replayStats.sent == 0U) || (error > replayStats.errorMax))
+    {
+        replayStats.errorMax = error;
+    }
+    replayStats.errorAbsSum += (uint64_t)((error < 0) ? -(int64_t)error : (int64_t)error);
+    replayStats.sent++;
+    if ((replayResultHead - replayResultTail) >= APP_CAN_REPLAY_RESULTS)
+    {
+        replayStats.resultsLost++;
+    }
+    else
+    {
+        result = &replayResults[replayResultHead & APP_CAN_REPLAY_RESULTS_MASK];
+        result->sequence = sequence;
+        result->xtd = (element->xtd != 0U);
+        result->id = (element->xtd != 0U) ? element->id : (element->id >> 18);
+        result->due = due;
+        result->error = error;
+        replayResultHead++;
+    }
+
+    if ((replayState == APP_CAN_REPLAY_STATE_DRAINING) && (replayDone == replayHead))
+    {
+        replayState = APP_CAN_REPLAY_STATE_IDLE;
+    }
+}
+
+APP_CAN_REPLAY_STATE APP_CAN_ReplayStateGet(void)
+{
+    return replayState;
+}
+
+bool APP_CAN_ReplayResultGet(APP_CAN_REPLAY_RESULT *result)
+{
+    if (replayResultTail == replayResultHead)
+    {
+        return false;
+    }
+    *result = replayResults[replayResultTail & APP_CAN_REPLAY_RESULTS_MASK];
+    replayResultTail++;
+    return true;
+}
+
+void APP_CAN_ReplayStatsGet(APP_CAN_REPLAY_STATS *stats)
+{
+    __disable_irq();
+    *stats = replayStats;
+    __enable_irq();
+}
+
+/*******************************************************************************
+ End of File
+*/
@@ -0,0 +1,190 @@
+/*******************************************************************************
+  CAN Trace Replay Header File
+
+  Company:
+    Microchip Technology Inc.
+
+  File Name:
+    app_can_replay.h
+
+  Summary:
+    Timed replay of a recorded CAN trace on the CAN1 Tx FIFO, interface.
+
+  Description:
+    This file declares the trace replay, which retransmits frames from the flash
+    log or from a record stream with their original inter-frame timing and
+    reports the timing error of every frame.
+*******************************************************************************/
+
+//DOM-IGNORE-BEGIN
+/*******************************************************************************
+* Copyright (C) 2024 Microchip Technology Inc. and its subsidiaries.
+*
+* Subject to your compliance with these terms, you may use Microchip software
+* and any derivatives exclusively with Microchip products. It is your
+* responsibility to comply with third party license terms applicable to your
+* use of third party software (including open source software) that may
+* accompany Microchip software.
+*
+* THIS SOFTWARE IS SUPPLIED BY MICROCHIP "AS IS". NO WARRANTIES, WHETHER
+* EXPRESS, IMPLIED OR STATUTORY, APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED
+* WARRANTIES OF NON-INFRINGEMENT, MERCHANTABILITY, AND FITNESS FOR A
+* PARTICULAR PURPOSE.
+*
+* IN NO EVENT WILL MICROCHIP BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE,
+* INCIDENTAL OR CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND
+* WHATSOEVER RELATED TO THE SOFTWARE, HOWEVER CAUSED, EVEN IF MICROCHIP HAS
+* BEEN ADVISED OF THE POSSIBILITY OR THE DAMAGES ARE FORESEEABLE. TO THE
+* FULLEST EXTENT ALLOWED BY LAW, MICROCHIP'S TOTAL LIABILITY ON ALL CLAIMS IN
+* ANY WAY RELATED TO THIS SOFTWARE WILL NOT EXCEED THE AMOUNT OF FEES, IF ANY,
+* THAT YOU HAVE PAID DIRECTLY TO MICROCHIP FOR THIS SOFTWARE.
+*******************************************************************************/
+//DOM-IGNORE-END
+
+
+
+#ifndef APP_CAN_REPLAY_H
+#define APP_CAN_REPLAY_H
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Included Files
+// *****************************************************************************
+// *****************************************************************************
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "definitions.h"
+#include "app_can_ring.h"
+
+// DOM-IGNORE-BEGIN
+#ifdef __cplusplus  // Provide C++ Compatibility
+    extern "C" {
+#endif
+// DOM-IGNORE-END
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Data Types
+// *****************************************************************************
+// *****************************************************************************
+
+/* Frames waiting for their transmission time, must be a power of two */
+#ifndef APP_CAN_REPLAY_FRAMES
+#define APP_CAN_REPLAY_FRAMES                   128U
+#endif
+
+#if ((APP_CAN_REPLAY_FRAMES & (APP_CAN_REPLAY_FRAMES - 1U)) != 0U)
+#error "APP_CAN_REPLAY_FRAMES must be a power of two"
+#endif
+
+/* Timing results waiting to be reported, must be a power of two */
+#ifndef APP_CAN_REPLAY_RESULTS
+#define APP_CAN_REPLAY_RESULTS                  64U
+#endif
+
+#if ((APP_CAN_REPLAY_RESULTS & (APP_CAN_REPLAY_RESULTS - 1U)) != 0U)
+#error "APP_CAN_REPLAY_RESULTS must be a power of two"
+#endif
+
+/* Delay between the first frame added and its transmission, so the queue
+   fills ahead of the schedule */
+#ifndef APP_CAN_REPLAY_START_MS
+#define APP_CAN_REPLAY_START_MS                 100U
+#endif
+
+typedef enum
+{
+    APP_CAN_REPLAY_STATE_IDLE,
+    /* Accepting frames and transmitting them when due */
+    APP_CAN_REPLAY_STATE_RUNNING,
+    /* End of the trace, transmitting the frames left */
+    APP_CAN_REPLAY_STATE_DRAINING
+} APP_CAN_REPLAY_STATE;
+
+/* Timing of one transmitted frame */
+typedef struct
+{
+    /* Position of the frame in the trace, from 0 */
+    uint32_t sequence;
+    uint32_t id;
+    bool xtd;
+    /* Scheduled start of frame, in extended CAN timestamp units */
+    uint32_t due;
+    /* Tx timestamp minus due, positive when late */
+    int32_t error;
+} APP_CAN_REPLAY_RESULT;
+
+typedef struct
+{
+    /* Frames added to the queue */
+    uint32_t queued;
+    /* Frames reported by a Tx event */
+    uint32_t sent;
+    /* Frames not added because the queue was full */
+    uint32_t dropped;
+    /* Stream records with an invalid encoding or CRC */
+    uint32_t streamErrors;
+    /* Frames held back because the Tx FIFO was full when due */
+    uint32_t fifoFull;
+    /* Results not reported because the result queue was full */
+    uint32_t resultsLost;
+    /* Timing error over all sent frames */
+    int32_t errorMin;
+    int32_t errorMax;
+    uint64_t errorAbsSum;
+} APP_CAN_REPLAY_STATS;
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Interface Routines
+// *****************************************************************************
+// *****************************************************************************
+
+/* Registers the TC0 and CAN1 Tx Event FIFO callbacks, call once after the
+   CAN1 configuration */
+void APP_CAN_ReplayInitialize(void);
+
+/* Starts a replay, false when one is already running */
+bool APP_CAN_ReplayStart(void);
+
+/* Queues a frame of the trace. The first frame is sent APP_CAN_REPLAY_START_MS
+   after it is added, the following ones at the same distance from it as in
+   the trace. Returns false when the queue is full. */
+bool APP_CAN_ReplayFrameAdd(const APP_CAN_RING_ENTRY *entry);
+
+/* Free queue entries */
+uint32_t APP_CAN_ReplayFreeGet(void);
+
+/* No more frames follow, the replay ends when the queue is sent */
+void APP_CAN_ReplayEnd(void);
+
+/* Abandons the replay and cancels the frames pending in the Tx FIFO */
+void APP_CAN_ReplayStop(void);
+
+/* Parses a byte of a record stream: full records are queued, an end record
+   ends the replay. Records are delimited by 0x00 bytes, see app_can_record.h. */
+void APP_CAN_ReplayStreamReceive(uint8_t data);
+
+APP_CAN_REPLAY_STATE APP_CAN_ReplayStateGet(void);
+
+/* Accounts the Tx event of a replayed frame, call for every event in
+   transmission order (CAN1_TxEventGet) from the main loop */
+void APP_CAN_ReplayTxEvent(const CAN_TX_EVENT *event);
+
+/* Gets the timing of the next transmitted frame, false when there is none */
+bool APP_CAN_ReplayResultGet(APP_CAN_REPLAY_RESULT *result);
+
+void APP_CAN_ReplayStatsGet(APP_CAN_REPLAY_STATS *stats);
+
+// DOM-IGNORE-BEGIN
+#ifdef __cplusplus  // Provide C++ Compatibility
+    }
+#endif
+// DOM-IGNORE-END
+
+#endif // APP_CAN_REPLAY_H
+
+/*******************************************************************************
+ End of File
+*/
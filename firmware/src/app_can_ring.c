@@ -0,0 +1,157 @@
+/*******************************************************************************
+  CAN Capture Ring Source File
+
+  Company:
+    Microchip Technology Inc.
+
+  File Name:
+    app_can_ring.c
+
+  Summary:
+    CAN capture ring implementation.
+
+  Description:
+    The CAN1 interrupt copies every received frame out of Message RAM into this
+    ring and acknowledges it immediately, so the hardware FIFOs never back up
+    while the main loop is busy printing. The ring is lock-free: the head index
+    is only written by the interrupt, the tail index only by the main loop, and
+    data memory barriers order the entry copy against the index update.
+*******************************************************************************/
+
+//DOM-IGNORE-BEGIN
+/*******************************************************************************
+* Copyright (C) 2024 Microchip Technology Inc. and its subsidiaries.
+*
+* Subject to your compliance with these terms, you may use Microchip software
+* and any derivatives exclusively with Microchip products. It is your
+* responsibility to comply with third party license terms applicable to your
+* use of third party software (including open source software) that may
+* accompany Microchip software.
+*
+* THIS SOFTWARE IS SUPPLIED BY MICROCHIP "AS IS". NO WARRANTIES, WHETHER
+* EXPRESS, IMPLIED OR STATUTORY, APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED
+* WARRANTIES OF NON-INFRINGEMENT, MERCHANTABILITY, AND FITNESS FOR A
+* PARTICULAR PURPOSE.
+*
+* IN NO EVENT WILL MICROCHIP BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE,
+* INCIDENTAL OR CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND
+* WHATSOEVER RELATED TO THE SOFTWARE, HOWEVER CAUSED, EVEN IF MICROCHIP HAS
+* BEEN ADVISED OF THE POSSIBILITY OR THE DAMAGES ARE FORESEEABLE. TO THE
+* FULLEST EXTENT ALLOWED BY LAW, MICROCHIP'S TOTAL LIABILITY ON ALL CLAIMS IN
+* ANY WAY RELATED TO THIS SOFTWARE WILL NOT EXCEED THE AMOUNT OF FEES, IF ANY,
+* THAT YOU HAVE PAID DIRECTLY TO MICROCHIP FOR THIS SOFTWARE.
+*******************************************************************************/
+//DOM-IGNORE-END
+
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Included Files
+// *****************************************************************************
+// *****************************************************************************
+
+#include "app_can_ring.h"
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Global Data
+// *****************************************************************************
+// *****************************************************************************
+
+#define APP_CAN_RING_MASK                       (APP_CAN_RING_SIZE - 1U)
+
+static APP_CAN_RING_ENTRY canRing[APP_CAN_RING_SIZE] __attribute__((aligned (4)));
+
+/* Free running indices, head is owned by the producer, tail by the consumer */
+static volatile uint32_t canRingHead = 0U;
+static volatile uint32_t canRingTail = 0U;
+
+static volatile uint32_t canRingOverflow = 0U;
+static volatile uint32_t canRingHighWater = 0U;
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: CAN Capture Ring Routines
+// *****************************************************************************
+// *****************************************************************************
+
+void APP_CAN_RingInitialize(void)
+{
+    canRingHead = 0U;
+    canRingTail = 0U;
+    canRingOverflow = 0U;
+    canRingHighWater = 0U;
+}
+
+/* Returns the next free entry, or NULL (and counts an overflow) when full */
+APP_CAN_RING_ENTRY *APP_CAN_RingWriteSlotGet(void)
+{
+    uint32_t head = canRingHead;
+
+    if ((head - canRingTail) >= APP_CAN_RING_SIZE)
+    {
+        canRingOverflow++;
+        return NULL;
+    }
+    /* Entry must not be written before the consumer released it */
+    __DMB();
+    return &canRing[head & APP_CAN_RING_MASK];
+}
+
+/* Publishes the entry returned by APP_CAN_RingWriteSlotGet */
+void APP_CAN_RingWriteCommit(void)
+{
+    uint32_t count = 0U;
+
+    /* Entry contents must be visible before the new head */
+    __DMB();
+    canRingHead = canRingHead + 1U;
+
+    count = canRingHead - canRingTail;
+    if (count > canRingHighWater)
+    {
+        canRingHighWater = count;
+    }
+}
+
+/* Returns the oldest committed entry, or NULL when empty */
+APP_CAN_RING_ENTRY *APP_CAN_RingReadSlotGet(void)
+{
+    uint32_t tail = canRingTail;
+
+    if (canRingHead == tail)
+    {
+        return NULL;
+    }
+    /* Entry contents must not be read before the head that published it */
+    __DMB();
+    return &canRing[tail & APP_CAN_RING_MASK];
+}
+
+/* Releases the entry returned by APP_CAN_RingReadSlotGet */
+void APP_CAN_RingReadRelease(void)
+{
+    /* Entry reads must complete before the producer may reuse it */
+    __DMB();
+    canRingTail = canRingTail + 1U;
+}
+
+uint32_t APP_CAN_RingCountGet(void)
+{
+    return (canRingHead - canRingTail);
+}
+
+void APP_CAN_RingStatsGet(APP_CAN_RING_STATS *stats)
+{
+    if (stats == NULL)
+    {
+        return;
+    }
+    stats->produced = canRingHead;
+    stats->overflow = canRingOverflow;
+    stats->highWater = canRingHighWater;
+}
+
+/*******************************************************************************
+ End of File
+*/
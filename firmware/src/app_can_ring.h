@@ -0,0 +1,141 @@
+/*******************************************************************************
+  CAN Capture Ring Header File
+
+  Company:
+    Microchip Technology Inc.
+
+  File Name:
+    app_can_ring.h
+
+  Summary:
+    CAN capture ring interface.
+
+  Description:
+    This file declares the single-producer/single-consumer ring used to hand
+    received CAN frames from the CAN1 interrupt to the main loop.
+*******************************************************************************/
+
+//DOM-IGNORE-BEGIN
+/*******************************************************************************
+* Copyright (C) 2024 Microchip Technology Inc. and its subsidiaries.
+*
+* Subject to your compliance with these terms, you may use Microchip software
+* and any derivatives exclusively with Microchip products. It is your
+* responsibility to comply with third party license terms applicable to your
+* use of third party software (including open source software) that may
+* accompany Microchip software.
+*
+* THIS SOFTWARE IS SUPPLIED BY MICROCHIP "AS IS". NO WARRANTIES, WHETHER
+* EXPRESS, IMPLIED OR STATUTORY, APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED
+* WARRANTIES OF NON-INFRINGEMENT, MERCHANTABILITY, AND FITNESS FOR A
+* PARTICULAR PURPOSE.
+*
+* IN NO EVENT WILL MICROCHIP BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE,
+* INCIDENTAL OR CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND
+* WHATSOEVER RELATED TO THE SOFTWARE, HOWEVER CAUSED, EVEN IF MICROCHIP HAS
+* BEEN ADVISED OF THE POSSIBILITY OR THE DAMAGES ARE FORESEEABLE. TO THE
+* FULLEST EXTENT ALLOWED BY LAW, MICROCHIP'S TOTAL LIABILITY ON ALL CLAIMS IN
+* ANY WAY RELATED TO THIS SOFTWARE WILL NOT EXCEED THE AMOUNT OF FEES, IF ANY,
+* THAT YOU HAVE PAID DIRECTLY TO MICROCHIP FOR THIS SOFTWARE.
+*******************************************************************************/
+//DOM-IGNORE-END
+
+
+#ifndef APP_CAN_RING_H
+#define APP_CAN_RING_H
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Included Files
+// *****************************************************************************
+// *****************************************************************************
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "definitions.h"
+
+// DOM-IGNORE-BEGIN
+#ifdef __cplusplus  // Provide C++ Compatibility
+    extern "C" {
+#endif
+// DOM-IGNORE-END
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Data Types
+// *****************************************************************************
+// *****************************************************************************
+
+/* Number of ring entries, must be a power of two */
+#ifndef APP_CAN_RING_SIZE
+#define APP_CAN_RING_SIZE                       128U
+#endif
+
+#if ((APP_CAN_RING_SIZE & (APP_CAN_RING_SIZE - 1U)) != 0U)
+#error "APP_CAN_RING_SIZE must be a power of two"
+#endif
+
+/* Message RAM area a captured frame was read from */
+typedef enum
+{
+    APP_CAN_RX_SOURCE_FIFO0 = 0,
+    APP_CAN_RX_SOURCE_FIFO1 = 1,
+    APP_CAN_RX_SOURCE_BUFFER = 2
+} APP_CAN_RX_SOURCE;
+
+/* Captured frame: extended timestamp plus a verbatim copy of the
+   Message RAM element (use APP_CAN_RING_FRAME to access its fields) */
+typedef struct
+{
+    /* Rx timestamp extended to 32 bits, in nominal bit times */
+    uint32_t timestamp;
+    /* APP_CAN_RX_SOURCE */
+    uint8_t source;
+    uint8_t reserved[3];
+    /* Rx FIFO/Buffer element (header and up to 64 data bytes) */
+    uint8_t element[CAN1_RX_FIFO0_ELEMENT_SIZE];
+} APP_CAN_RING_ENTRY;
+
+#define APP_CAN_RING_FRAME(entry)               ((CAN_RX_BUFFER *)(void *)((entry)->element))
+
+/* Ring statistics */
+typedef struct
+{
+    /* Frames committed by the producer */
+    uint32_t produced;
+    /* Frames dropped because the ring was full */
+    uint32_t overflow;
+    /* Highest number of entries held at once */
+    uint32_t highWater;
+} APP_CAN_RING_STATS;
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Interface Routines
+// *****************************************************************************
+// *****************************************************************************
+
+void APP_CAN_RingInitialize(void);
+
+/* Producer side, call from the CAN1 interrupt context only */
+APP_CAN_RING_ENTRY *APP_CAN_RingWriteSlotGet(void);
+void APP_CAN_RingWriteCommit(void);
+
+/* Consumer side, call from the main loop only */
+APP_CAN_RING_ENTRY *APP_CAN_RingReadSlotGet(void);
+void APP_CAN_RingReadRelease(void);
+
+uint32_t APP_CAN_RingCountGet(void);
+void APP_CAN_RingStatsGet(APP_CAN_RING_STATS *stats);
+
+// DOM-IGNORE-BEGIN
+#ifdef __cplusplus  // Provide C++ Compatibility
+    }
+#endif
+// DOM-IGNORE-END
+
+#endif // APP_CAN_RING_H
+
+/*******************************************************************************
+ End of File
+*/
@@ -0,0 +1,201 @@
+/*******************************************************************************
+  CAN Traffic Statistics Source File
+
+  Company:
+    Microchip Technology Inc.
+
+  File Name:
+    app_can_stats.c
+
+  Summary:
+    Per-ID CAN traffic statistics implementation.
+
+  Description:
+    This file implements the per-ID traffic statistics. IDs are kept in a fixed
+    size open addressing table; the keys are stored apart from the counters so
+    that a lookup only walks a small contiguous array.
+*******************************************************************************/
+
+//DOM-IGNORE-BEGIN
+/*******************************************************************************
+* Copyright (C) 2024 Microchip Technology Inc. and its subsidiaries.
+*
+* Subject to your compliance with these terms, you may use Microchip software
+* and any derivatives exclusively with Microchip products. It is your
+* responsibility to comply with third party license terms applicable to your
+* use of third party software (including open source software) that may
+* accompany Microchip software.
+*
+* THIS SOFTWARE IS SUPPLIED BY MICROCHIP "AS IS". NO WARRANTIES, WHETHER
+* EXPRESS, IMPLIED OR STATUTORY, APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED
+* WARRANTIES OF NON-INFRINGEMENT, MERCHANTABILITY, AND FITNESS FOR A
+* PARTICULAR PURPOSE.
+*
+* IN NO EVENT WILL MICROCHIP BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE,
+* INCIDENTAL OR CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND
+* WHATSOEVER RELATED TO THE SOFTWARE, HOWEVER CAUSED, EVEN IF MICROCHIP HAS
+* BEEN ADVISED OF THE POSSIBILITY OR THE DAMAGES ARE FORESEEABLE. TO THE
+* FULLEST EXTENT ALLOWED BY LAW, MICROCHIP'S TOTAL LIABILITY ON ALL CLAIMS IN
+* ANY WAY RELATED TO THIS SOFTWARE WILL NOT EXCEED THE AMOUNT OF FEES, IF ANY,
+* THAT YOU HAVE PAID DIRECTLY TO MICROCHIP FOR THIS SOFTWARE.
+*******************************************************************************/
+//DOM-IGNORE-END
+
+
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Included Files
+// *****************************************************************************
+// *****************************************************************************
+
+#include <string.h>
+#include <math.h>
+#include "app_can_stats.h"
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Global Data
+// *****************************************************************************
+// *****************************************************************************
+
+#define APP_CAN_STATS_MASK                      (APP_CAN_STATS_IDS - 1U)
+/* Slots probed before an ID is left untracked */
+#define APP_CAN_STATS_PROBES                    16U
+#define APP_CAN_STATS_KEY_EMPTY                 0xFFFFFFFFUL
+#define APP_CAN_STATS_KEY_XTD                   (1UL << 29)
+
+typedef struct
+{
+    uint32_t count;
+    uint32_t bytes;
+    uint32_t lastTimestamp;
+    uint32_t minPeriod;
+    uint32_t maxPeriod;
+    /* Running mean and sum of squared deviations of the period (Welford) */
+    float meanPeriod;
+    float m2Period;
+    uint32_t fdf;
+    uint32_t brs;
+    uint32_t esi;
+    uint32_t rtr;
+} APP_CAN_STATS_ENTRY;
+
+static const uint8_t statsDlcLength[16] = {0U, 1U, 2U, 3U, 4U, 5U, 6U, 7U, 8U, 12U, 16U, 20U, 24U, 32U, 48U, 64U};
+
+/* ID[28:0] plus XTD bit per slot, APP_CAN_STATS_KEY_EMPTY when unused */
+static uint32_t statsKey[APP_CAN_STATS_IDS];
+static APP_CAN_STATS_ENTRY statsEntry[APP_CAN_STATS_IDS];
+static uint32_t statsUntracked = 0U;
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: CAN Traffic Statistics Routines
+// *****************************************************************************
+// *****************************************************************************
+
+void APP_CAN_StatsReset(void)
+{
+    uint32_t index = 0U;
+
+    for (index = 0U; index < APP_CAN_STATS_IDS; index++)
+    {
+        statsKey[index] = APP_CAN_STATS_KEY_EMPTY;
+    }
+    memset(statsEntry, 0, sizeof(statsEntry));
+    statsUntracked = 0U;
+}
+
+void APP_CAN_StatsUpdate(const APP_CAN_RING_ENTRY *entry)
+{
+    const CAN_RX_BUFFER *rxBuf = APP_CAN_RING_FRAME(entry);
+    APP_CAN_STATS_ENTRY *stats = NULL;
+    uint32_t key = rxBuf->xtd ? (rxBuf->id | APP_CAN_STATS_KEY_XTD) : (rxBuf->id >> 18);
+    uint32_t index = (key * 2654435761UL) >> 16;
+    uint32_t probe = 0U;
+    uint32_t slot = 0U;
+    uint32_t period = 0U;
+    float delta = 0.0f;
+
+    for (probe = 0U; probe < APP_CAN_STATS_PROBES; probe++)
+    {
+        slot = (index + probe) & APP_CAN_STATS_MASK;
+        if (statsKey[slot] == key)
+        {
+            break;
+        }
+        if (statsKey[slot] == APP_CAN_STATS_KEY_EMPTY)
+        {
+            statsKey[slot] = key;
+            break;
+        }
+    }
+    if (probe == APP_CAN_STATS_PROBES)
+    {
+        statsUntracked++;
+        return;
+    }
+
+    stats = &statsEntry[slot];
+    if (stats->count != 0U)
+    {
+        period = entry->timestamp - stats->lastTimestamp;
+        if ((stats->count == 1U) || (period < stats->minPeriod))
+        {
+            stats->minPeriod = period;
+        }
+        if (period > stats->maxPeriod)
+        {
+            stats->maxPeriod = period;
+        }
+        /* stats->count periods after this one */
+        delta = (float)period - stats->meanPeriod;
+        stats->meanPeriod += delta / (float)stats->count;
+        stats->m2Period += delta * ((float)period - stats->meanPeriod);
+    }
+    stats->lastTimestamp = entry->timestamp;
+    stats->count++;
+    stats->bytes += rxBuf->rtr ? 0U : statsDlcLength[rxBuf->dlc];
+    stats->fdf += rxBuf->fdf;
+    stats->brs += rxBuf->brs;
+    stats->esi += rxBuf->esi;
+    stats->rtr += rxBuf->rtr;
+}
+
+bool APP_CAN_StatsGet(uint32_t index, APP_CAN_STATS *stats)
+{
+    const APP_CAN_STATS_ENTRY *entry = NULL;
+    uint32_t periods = 0U;
+
+    if ((index >= APP_CAN_STATS_IDS) || (statsKey[index] == APP_CAN_STATS_KEY_EMPTY) || (stats == NULL))
+    {
+        return false;
+    }
+
+    entry = &statsEntry[index];
+    periods = (entry->count > 0U) ? (entry->count - 1U) : 0U;
+
+    stats->id = statsKey[index] & ~APP_CAN_STATS_KEY_XTD;
+    stats->xtd = ((statsKey[index] & APP_CAN_STATS_KEY_XTD) != 0U);
+    stats->count = entry->count;
+    stats->bytes = entry->bytes;
+    stats->minPeriod = entry->minPeriod;
+    stats->avgPeriod = (uint32_t)(entry->meanPeriod + 0.5f);
+    stats->maxPeriod = entry->maxPeriod;
+    stats->jitter = (periods > 1U) ? (uint32_t)(sqrtf(entry->m2Period / (float)(periods - 1U)) + 0.5f) : 0U;
+    stats->fdf = entry->fdf;
+    stats->brs = entry->brs;
+    stats->esi = entry->esi;
+    stats->rtr = entry->rtr;
+
+    return true;
+}
+
+uint32_t APP_CAN_StatsUntrackedGet(void)
+{
+    return statsUntracked;
+}
+
+/*******************************************************************************
+ End of File
+*/
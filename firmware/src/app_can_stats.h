@@ -0,0 +1,128 @@
+/*******************************************************************************
+  CAN Traffic Statistics Header File
+
+  Company:
+    Microchip Technology Inc.
+
+  File Name:
+    app_can_stats.h
+
+  Summary:
+    Per-ID CAN traffic statistics interface.
+
+  Description:
+    This file declares the per-ID traffic statistics kept for received frames:
+    frame and byte counts, inter-arrival period and jitter, and flag counts.
+*******************************************************************************/
+
+//DOM-IGNORE-BEGIN
+/*******************************************************************************
+* Copyright (C) 2024 Microchip Technology Inc. and its subsidiaries.
+*
+* Subject to your compliance with these terms, you may use Microchip software
+* and any derivatives exclusively with Microchip products. It is your
+* responsibility to comply with third party license terms applicable to your
+* use of third party software (including open source software) that may
+* accompany Microchip software.
+*
+* THIS SOFTWARE IS SUPPLIED BY MICROCHIP "AS IS". NO WARRANTIES, WHETHER
+* EXPRESS, IMPLIED OR STATUTORY, APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED
+* WARRANTIES OF NON-INFRINGEMENT, MERCHANTABILITY, AND FITNESS FOR A
+* PARTICULAR PURPOSE.
+*
+* IN NO EVENT WILL MICROCHIP BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE,
+* INCIDENTAL OR CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND
+* WHATSOEVER RELATED TO THE SOFTWARE, HOWEVER CAUSED, EVEN IF MICROCHIP HAS
+* BEEN ADVISED OF THE POSSIBILITY OR THE DAMAGES ARE FORESEEABLE. TO THE
+* FULLEST EXTENT ALLOWED BY LAW, MICROCHIP'S TOTAL LIABILITY ON ALL CLAIMS IN
+* ANY WAY RELATED TO THIS SOFTWARE WILL NOT EXCEED THE AMOUNT OF FEES, IF ANY,
+* THAT YOU HAVE PAID DIRECTLY TO MICROCHIP FOR THIS SOFTWARE.
+*******************************************************************************/
+//DOM-IGNORE-END
+
+
+
+#ifndef APP_CAN_STATS_H
+#define APP_CAN_STATS_H
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Included Files
+// *****************************************************************************
+// *****************************************************************************
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "app_can_ring.h"
+
+// DOM-IGNORE-BEGIN
+#ifdef __cplusplus  // Provide C++ Compatibility
+    extern "C" {
+#endif
+// DOM-IGNORE-END
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Data Types
+// *****************************************************************************
+// *****************************************************************************
+
+/* IDs tracked at once, must be a power of two */
+#ifndef APP_CAN_STATS_IDS
+#define APP_CAN_STATS_IDS                       256U
+#endif
+
+#if ((APP_CAN_STATS_IDS & (APP_CAN_STATS_IDS - 1U)) != 0U)
+#error "APP_CAN_STATS_IDS must be a power of two"
+#endif
+
+/* Statistics of one ID, periods in timestamp ticks (nominal bit times) */
+typedef struct
+{
+    uint32_t id;
+    bool xtd;
+    /* Frames and valid payload bytes received */
+    uint32_t count;
+    uint32_t bytes;
+    /* Inter-arrival period, 0 until two frames were received */
+    uint32_t minPeriod;
+    uint32_t avgPeriod;
+    uint32_t maxPeriod;
+    /* Standard deviation of the period */
+    uint32_t jitter;
+    /* Frames with the respective flag set */
+    uint32_t fdf;
+    uint32_t brs;
+    uint32_t esi;
+    uint32_t rtr;
+} APP_CAN_STATS;
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Interface Routines
+// *****************************************************************************
+// *****************************************************************************
+
+void APP_CAN_StatsReset(void);
+
+/* Accounts one received frame, call once per frame in arrival order */
+void APP_CAN_StatsUpdate(const APP_CAN_RING_ENTRY *entry);
+
+/* Reads table slot index (0 to APP_CAN_STATS_IDS - 1).
+   Returns false when the slot is unused. */
+bool APP_CAN_StatsGet(uint32_t index, APP_CAN_STATS *stats);
+
+/* Frames not accounted because the table was full */
+uint32_t APP_CAN_StatsUntrackedGet(void);
+
+// DOM-IGNORE-BEGIN
+#ifdef __cplusplus  // Provide C++ Compatibility
+    }
+#endif
+// DOM-IGNORE-END
+
+#endif // APP_CAN_STATS_H
+
+/*******************************************************************************
+ End of File
+*/
@@ -0,0 +1,351 @@
+/*******************************************************************************
+  CAN Trigger Capture Source File
+
+  Company:
+    Microchip Technology Inc.
+
+  File Name:
+    app_can_trigger.c
+
+  Summary:
+    Pre/post trigger capture implementation.
+
+  Description:
+    This file implements the trigger capture engine. Frames are stored in a
+    circular byte buffer as a compact header (timestamp, ID word, DLC and
+    flags as in the binary records) followed by the payload, overwriting the
+    oldest frames. A trigger is either a received frame matching an ID and/or
+    payload pattern, or an event (CAN error state change, EIC pin edge) which
+    is placed in front of the first frame received after it.
+*******************************************************************************/
+
+//DOM-IGNORE-BEGIN
+/*******************************************************************************
+* Copyright (C) 2024 Microchip Technology Inc. and its subsidiaries.
+*
+* Subject to your compliance with these terms, you may use Microchip software
+* and any derivatives exclusively with Microchip products. It is your
+* responsibility to comply with third party license terms applicable to your
+* use of third party software (including open source software) that may
+* accompany Microchip software.
+*
+* THIS SOFTWARE IS SUPPLIED BY MICROCHIP "AS IS". NO WARRANTIES, WHETHER
+* EXPRESS, IMPLIED OR STATUTORY, APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED
+* WARRANTIES OF NON-INFRINGEMENT, MERCHANTABILITY, AND FITNESS FOR A
+* PARTICULAR PURPOSE.
+*
+* IN NO EVENT WILL MICROCHIP BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE,
+* INCIDENTAL OR CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND
+* WHATSOEVER RELATED TO THE SOFTWARE, HOWEVER CAUSED, EVEN IF MICROCHIP HAS
+* BEEN ADVISED OF THE POSSIBILITY OR THE DAMAGES ARE FORESEEABLE. TO THE
+* FULLEST EXTENT ALLOWED BY LAW, MICROCHIP'S TOTAL LIABILITY ON ALL CLAIMS IN
+* ANY WAY RELATED TO THIS SOFTWARE WILL NOT EXCEED THE AMOUNT OF FEES, IF ANY,
+* THAT YOU HAVE PAID DIRECTLY TO MICROCHIP FOR THIS SOFTWARE.
+*******************************************************************************/
+//DOM-IGNORE-END
+
+
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Included Files
+// *****************************************************************************
+// *****************************************************************************
+
+#include <string.h>
+#include "app_can_trigger.h"
+#include "app_can_record.h"
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Global Data
+// *****************************************************************************
+// *****************************************************************************
+
+#define APP_CAN_TRIGGER_BUFFER_MASK             (APP_CAN_TRIGGER_BUFFER_SIZE - 1U)
+
+static const uint8_t triggerDlcLength[16] = {0U, 1U, 2U, 3U, 4U, 5U, 6U, 7U, 8U, 12U, 16U, 20U, 24U, 32U, 48U, 64U};
+
+static uint8_t triggerBuffer[APP_CAN_TRIGGER_BUFFER_SIZE];
+/* Free running byte offsets of the newest and oldest frame and the reader */
+static uint32_t triggerHead = 0U;
+static uint32_t triggerTail = 0U;
+static uint32_t triggerRead = 0U;
+/* Offset of the first frame at or after the trigger */
+static uint32_t triggerMark = 0U;
+/* Frames in the window, frames from the trigger on, frames still to record */
+static uint32_t triggerFrames = 0U;
+static uint32_t triggerPost = 0U;
+static uint32_t triggerRemaining = 0U;
+
+static volatile APP_CAN_TRIGGER_STATE triggerState = APP_CAN_TRIGGER_STATE_IDLE;
+static APP_CAN_TRIGGER_CONFIG triggerConfig;
+static APP_CAN_TRIGGER_INFO triggerInfo;
+
+/* Event reported, possibly from interrupt context */
+static volatile bool triggerEventPending = false;
+static volatile uint32_t triggerEventSource = 0U;
+static volatile uint32_t triggerEventTime = 0U;
+
+/* Last reported CAN error state */
+static bool triggerErrorValid = false;
+static uint32_t triggerErrorState = 0U;
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: CAN Trigger Capture Routines
+// *****************************************************************************
+// *****************************************************************************
+
+static void APP_CAN_TriggerCopyIn(uint32_t offset, const uint8_t *data, size_t length)
+{
+    size_t index = 0U;
+
+    for (index = 0U; index < length; index++)
+    {
+        triggerBuffer[(offset + index) & APP_CAN_TRIGGER_BUFFER_MASK] = data[index];
+    }
+}
+
+static void APP_CAN_TriggerCopyOut(uint32_t offset, uint8_t *data, size_t length)
+{
+    size_t index = 0U;
+
+    for (index = 0U; index < length; index++)
+    {
+        data[index] = triggerBuffer[(offset + index) & APP_CAN_TRIGGER_BUFFER_MASK];
+    }
+}
+
+/* Length of the frame stored at offset */
+static uint32_t APP_CAN_TriggerFrameSize(uint32_t offset)
+{
+    uint8_t header[APP_CAN_RECORD_HEADER_SIZE];
+
+    APP_CAN_TriggerCopyOut(offset, header, sizeof(header));
+    return (uint32_t)APP_CAN_RecordPackedSize(header);
+}
+
+static void APP_CAN_TriggerFreeze(void)
+{
+    triggerInfo.preFrames = triggerFrames - triggerPost;
+    triggerInfo.postFrames = triggerPost;
+    triggerRead = triggerTail;
+    triggerState = APP_CAN_TRIGGER_STATE_FROZEN;
+}
+
+/* Trigger point in front of the frame stored next at triggerMark */
+static void APP_CAN_TriggerFire(uint32_t source, uint32_t timestamp)
+{
+    triggerInfo.source = source;
+    triggerInfo.timestamp = timestamp;
+    triggerMark = triggerHead;
+    triggerPost = 0U;
+    triggerRemaining = triggerConfig.postFrames;
+    triggerState = APP_CAN_TRIGGER_STATE_TRIGGERED;
+}
+
+/* Stores a frame, dropping the oldest pre trigger frames. Returns false if
+   the window is full up to the trigger point. */
+static bool APP_CAN_TriggerStore(const APP_CAN_RING_ENTRY *entry)
+{
+    uint8_t raw[APP_CAN_RECORD_HEADER_SIZE + 64U];
+    uint32_t length = (uint32_t)APP_CAN_RecordPack(entry, raw);
+
+    while ((APP_CAN_TRIGGER_BUFFER_SIZE - (triggerHead - triggerTail)) < length)
+    {
+        if ((triggerState == APP_CAN_TRIGGER_STATE_TRIGGERED) && (triggerTail == triggerMark))
+        {
+            return false;
+        }
+        triggerTail += APP_CAN_TriggerFrameSize(triggerTail);
+        triggerFrames--;
+    }
+
+    APP_CAN_TriggerCopyIn(triggerHead, raw, length);
+    triggerHead += length;
+    triggerFrames++;
+    return true;
+}
+
+static bool APP_CAN_TriggerMatch(const APP_CAN_RING_ENTRY *entry)
+{
+    const CAN_RX_BUFFER *rxBuf = APP_CAN_RING_FRAME(entry);
+    uint32_t id = rxBuf->xtd ? rxBuf->id : (rxBuf->id >> 18);
+    uint32_t length = 0U;
+    uint32_t index = 0U;
+    bool payloadMatch = false;
+
+    if (triggerConfig.idMatch && ((triggerConfig.id != id) || (triggerConfig.xtd != (rxBuf->xtd != 0U))))
+    {
+        return false;
+    }
+
+    length = (rxBuf->rtr != 0U) ? 0U : triggerDlcLength[rxBuf->dlc];
+    for (index = 0U; index < APP_CAN_TRIGGER_PATTERN_SIZE; index++)
+    {
+        if (triggerConfig.mask[index] == 0U)
+        {
+            continue;
+        }
+        payloadMatch = true;
+        if (((triggerConfig.offset + index) >= length) ||
+            ((rxBuf->data[triggerConfig.offset + index] & triggerConfig.mask[index]) !=
+             (triggerConfig.value[index] & triggerConfig.mask[index])))
+        {
+            return false;
+        }
+    }
+
+    /* At least one of the two conditions must be configured */
+    return triggerConfig.idMatch || payloadMatch;
+}
+
+void APP_CAN_TriggerInitialize(void)
+{
+    memset(&triggerConfig, 0, sizeof(triggerConfig));
+    APP_CAN_TriggerDisarm();
+}
+
+void APP_CAN_TriggerArm(const APP_CAN_TRIGGER_CONFIG *config)
+{
+    triggerState = APP_CAN_TRIGGER_STATE_IDLE;
+    triggerConfig = *config;
+    triggerHead = 0U;
+    triggerTail = 0U;
+    triggerRead = 0U;
+    triggerFrames = 0U;
+    triggerPost = 0U;
+    memset(&triggerInfo, 0, sizeof(triggerInfo));
+    triggerEventPending = false;
+    triggerErrorValid = false;
+    triggerState = APP_CAN_TRIGGER_STATE_ARMED;
+}
+
+void APP_CAN_TriggerDisarm(void)
+{
+    triggerState = APP_CAN_TRIGGER_STATE_IDLE;
+    triggerEventPending = false;
+}
+
+APP_CAN_TRIGGER_STATE APP_CAN_TriggerStateGet(void)
+{
+    return triggerState;
+}
+
+void APP_CAN_TriggerEvent(uint32_t source, uint32_t timestamp)
+{
+    if ((triggerState != APP_CAN_TRIGGER_STATE_ARMED) || ((triggerConfig.sources & source) == 0U) ||
+        triggerEventPending)
+    {
+        return;
+    }
+    triggerEventSource = source;
+    triggerEventTime = timestamp;
+    triggerEventPending = true;
+}
+
+void APP_CAN_TriggerErrorStateUpdate(uint32_t errorState, uint32_t timestamp)
+{
+    if (triggerState != APP_CAN_TRIGGER_STATE_ARMED)
+    {
+        return;
+    }
+    if (triggerErrorValid && (errorState != triggerErrorState))
+    {
+        APP_CAN_TriggerEvent(APP_CAN_TRIGGER_SOURCE_ERROR, timestamp);
+    }
+    triggerErrorState = errorState;
+    triggerErrorValid = true;
+}
+
+void APP_CAN_TriggerService(void)
+{
+    if ((triggerState == APP_CAN_TRIGGER_STATE_ARMED) && triggerEventPending)
+    {
+        APP_CAN_TriggerFire(triggerEventSource, triggerEventTime);
+        if (triggerRemaining == 0U)
+        {
+            APP_CAN_TriggerFreeze();
+        }
+    }
+}
+
+void APP_CAN_TriggerFrameAdd(const APP_CAN_RING_ENTRY *entry)
+{
+    bool frameTrigger = false;
+
+    if ((triggerState != APP_CAN_TRIGGER_STATE_ARMED) && (triggerState != APP_CAN_TRIGGER_STATE_TRIGGERED))
+    {
+        return;
+    }
+
+    /* An event fires in front of the first frame received after it */
+    if ((triggerState == APP_CAN_TRIGGER_STATE_ARMED) && triggerEventPending &&
+        ((int32_t)(entry->timestamp - triggerEventTime) >= 0))
+    {
+        APP_CAN_TriggerService();
+        if (triggerState == APP_CAN_TRIGGER_STATE_FROZEN)
+        {
+            return;
+        }
+    }
+
+    frameTrigger = (triggerState == APP_CAN_TRIGGER_STATE_ARMED) &&
+                   ((triggerConfig.sources & APP_CAN_TRIGGER_SOURCE_FRAME) != 0U) && APP_CAN_TriggerMatch(entry);
+    if (frameTrigger)
+    {
+        APP_CAN_TriggerFire(APP_CAN_TRIGGER_SOURCE_FRAME, entry->timestamp);
+    }
+
+    if (APP_CAN_TriggerStore(entry) == false)
+    {
+        /* Window full of post trigger frames */
+        APP_CAN_TriggerFreeze();
+        return;
+    }
+
+    if (triggerState == APP_CAN_TRIGGER_STATE_TRIGGERED)
+    {
+        triggerPost++;
+        /* The trigger frame itself is not counted in postFrames */
+        if (frameTrigger == false)
+        {
+            triggerRemaining--;
+        }
+        if (triggerRemaining == 0U)
+        {
+            APP_CAN_TriggerFreeze();
+        }
+    }
+}
+
+void APP_CAN_TriggerInfoGet(APP_CAN_TRIGGER_INFO *info)
+{
+    *info = triggerInfo;
+}
+
+bool APP_CAN_TriggerFrameGet(APP_CAN_RING_ENTRY *entry)
+{
+    uint8_t raw[APP_CAN_RECORD_HEADER_SIZE + 64U];
+
+    if ((triggerState != APP_CAN_TRIGGER_STATE_FROZEN) || (triggerRead == triggerHead))
+    {
+        return false;
+    }
+    APP_CAN_TriggerCopyOut(triggerRead, raw, APP_CAN_TriggerFrameSize(triggerRead));
+    APP_CAN_RecordUnpack(raw, entry);
+    return true;
+}
+
+void APP_CAN_TriggerFrameRelease(void)
+{
+    if ((triggerState == APP_CAN_TRIGGER_STATE_FROZEN) && (triggerRead != triggerHead))
+    {
+        triggerRead += APP_CAN_TriggerFrameSize(triggerRead);
+    }
+}
+
+/*******************************************************************************
+ End of File
+*/
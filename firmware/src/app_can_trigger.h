@@ -0,0 +1,177 @@
+/*******************************************************************************
+  CAN Trigger Capture Header File
+
+  Company:
+    Microchip Technology Inc.
+
+  File Name:
+    app_can_trigger.h
+
+  Summary:
+    Pre/post trigger capture interface.
+
+  Description:
+    This file declares the trigger capture engine, which records received frames
+    into a RAM window and freezes it a configurable number of frames after a
+    trigger, like a logic analyzer.
+*******************************************************************************/
+
+//DOM-IGNORE-BEGIN
+/*******************************************************************************
+* Copyright (C) 2024 Microchip Technology Inc. and its subsidiaries.
+*
+* Subject to your compliance with these terms, you may use Microchip software
+* and any derivatives exclusively with Microchip products. It is your
+* responsibility to comply with third party license terms applicable to your
+* use of third party software (including open source software) that may
+* accompany Microchip software.
+*
+* THIS SOFTWARE IS SUPPLIED BY MICROCHIP "AS IS". NO WARRANTIES, WHETHER
+* EXPRESS, IMPLIED OR STATUTORY, APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED
+* WARRANTIES OF NON-INFRINGEMENT, MERCHANTABILITY, AND FITNESS FOR A
+* PARTICULAR PURPOSE.
+*
+* IN NO EVENT WILL MICROCHIP BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE,
+* INCIDENTAL OR CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND
+* WHATSOEVER RELATED TO THE SOFTWARE, HOWEVER CAUSED, EVEN IF MICROCHIP HAS
+* BEEN ADVISED OF THE POSSIBILITY OR THE DAMAGES ARE FORESEEABLE. TO THE
+* FULLEST EXTENT ALLOWED BY LAW, MICROCHIP'S TOTAL LIABILITY ON ALL CLAIMS IN
+* ANY WAY RELATED TO THIS SOFTWARE WILL NOT EXCEED THE AMOUNT OF FEES, IF ANY,
+* THAT YOU HAVE PAID DIRECTLY TO MICROCHIP FOR THIS SOFTWARE.
+*******************************************************************************/
+//DOM-IGNORE-END
+
+
+
+#ifndef APP_CAN_TRIGGER_H
+#define APP_CAN_TRIGGER_H
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Included Files
+// *****************************************************************************
+// *****************************************************************************
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "app_can_ring.h"
+
+// DOM-IGNORE-BEGIN
+#ifdef __cplusplus  // Provide C++ Compatibility
+    extern "C" {
+#endif
+// DOM-IGNORE-END
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Data Types
+// *****************************************************************************
+// *****************************************************************************
+
+/* Capture window size in bytes, must be a power of two. A classic frame
+   with 8 data bytes takes 17 bytes. */
+#ifndef APP_CAN_TRIGGER_BUFFER_SIZE
+#define APP_CAN_TRIGGER_BUFFER_SIZE             65536U
+#endif
+
+#if ((APP_CAN_TRIGGER_BUFFER_SIZE & (APP_CAN_TRIGGER_BUFFER_SIZE - 1U)) != 0U)
+#error "APP_CAN_TRIGGER_BUFFER_SIZE must be a power of two"
+#endif
+
+/* Payload bytes compared by a frame trigger */
+#define APP_CAN_TRIGGER_PATTERN_SIZE            8U
+
+/* Trigger sources, may be combined */
+#define APP_CAN_TRIGGER_SOURCE_FRAME            0x01U
+#define APP_CAN_TRIGGER_SOURCE_ERROR            0x02U
+#define APP_CAN_TRIGGER_SOURCE_PIN              0x04U
+
+typedef enum
+{
+    /* Not recording */
+    APP_CAN_TRIGGER_STATE_IDLE,
+    /* Recording, waiting for the trigger */
+    APP_CAN_TRIGGER_STATE_ARMED,
+    /* Recording the post trigger frames */
+    APP_CAN_TRIGGER_STATE_TRIGGERED,
+    /* Window complete, ready to be read */
+    APP_CAN_TRIGGER_STATE_FROZEN
+} APP_CAN_TRIGGER_STATE;
+
+typedef struct
+{
+    /* APP_CAN_TRIGGER_SOURCE_xxx */
+    uint32_t sources;
+    /* Frame trigger: ID match, if enabled */
+    bool idMatch;
+    uint32_t id;
+    bool xtd;
+    /* Frame trigger: (data[offset + n] & mask[n]) == value[n] for all n,
+       an all zero mask disables the payload match */
+    uint8_t offset;
+    uint8_t value[APP_CAN_TRIGGER_PATTERN_SIZE];
+    uint8_t mask[APP_CAN_TRIGGER_PATTERN_SIZE];
+    /* Frames recorded after the trigger frame or event */
+    uint32_t postFrames;
+} APP_CAN_TRIGGER_CONFIG;
+
+typedef struct
+{
+    /* APP_CAN_TRIGGER_SOURCE_xxx which fired */
+    uint32_t source;
+    /* Frame or event time, in timestamp ticks */
+    uint32_t timestamp;
+    /* Frames before the trigger */
+    uint32_t preFrames;
+    /* Frames from the trigger on, including the trigger frame */
+    uint32_t postFrames;
+} APP_CAN_TRIGGER_INFO;
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Interface Routines
+// *****************************************************************************
+// *****************************************************************************
+
+void APP_CAN_TriggerInitialize(void);
+
+/* Clears the window and starts recording with the given trigger */
+void APP_CAN_TriggerArm(const APP_CAN_TRIGGER_CONFIG *config);
+
+/* Stops recording or reading, the window is discarded */
+void APP_CAN_TriggerDisarm(void);
+
+APP_CAN_TRIGGER_STATE APP_CAN_TriggerStateGet(void);
+
+/* Records a received frame, call in reception order from the main loop */
+void APP_CAN_TriggerFrameAdd(const APP_CAN_RING_ENTRY *entry);
+
+/* Reports an event at timestamp (extended Rx timestamp ticks). May be called
+   from interrupt context; only the first event after arming is kept. */
+void APP_CAN_TriggerEvent(uint32_t source, uint32_t timestamp);
+
+/* Reports the CAN error state (CAN_PSR EW, EP and BO), a change after the
+   first call fires an error trigger */
+void APP_CAN_TriggerErrorStateUpdate(uint32_t errorState, uint32_t timestamp);
+
+/* Fires a pending event once all frames received up to now are recorded,
+   call when the capture ring is empty */
+void APP_CAN_TriggerService(void);
+
+/* Frozen window: trigger details, and its frames oldest first. FrameGet
+   returns the next frame without removing it, false at the end. */
+void APP_CAN_TriggerInfoGet(APP_CAN_TRIGGER_INFO *info);
+bool APP_CAN_TriggerFrameGet(APP_CAN_RING_ENTRY *entry);
+void APP_CAN_TriggerFrameRelease(void);
+
+// DOM-IGNORE-BEGIN
+#ifdef __cplusplus  // Provide C++ Compatibility
+    }
+#endif
+// DOM-IGNORE-END
+
+#endif // APP_CAN_TRIGGER_H
+
+/*******************************************************************************
+ End of File
+*/
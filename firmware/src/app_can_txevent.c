@@ -0,0 +1,153 @@
+/*******************************************************************************
+  CAN Transmit Timing Source File
+
+  Company:
+    Microchip Technology Inc.
+
+  File Name:
+    app_can_txevent.c
+
+  Summary:
+    CAN transmit latency and arbitration delay statistics implementation.
+
+  Description:
+    This file builds the transmit latency and arbitration delay histograms from
+    the Tx events collected by the CAN1 driver. Frame lengths are worst case
+    lengths at the current bit timing, see app_can_load.c.
+*******************************************************************************/
+
+//DOM-IGNORE-BEGIN
+/*******************************************************************************
+* Copyright (C) 2024 Microchip Technology Inc. and its subsidiaries.
+*
+* Subject to your compliance with these terms, you may use Microchip software
+* and any derivatives exclusively with Microchip products. It is your
+* responsibility to comply with third party license terms applicable to your
+* use of third party software (including open source software) that may
+* accompany Microchip software.
+*
+* THIS SOFTWARE IS SUPPLIED BY MICROCHIP "AS IS". NO WARRANTIES, WHETHER
+* EXPRESS, IMPLIED OR STATUTORY, APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED
+* WARRANTIES OF NON-INFRINGEMENT, MERCHANTABILITY, AND FITNESS FOR A
+* PARTICULAR PURPOSE.
+*
+* IN NO EVENT WILL MICROCHIP BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE,
+* INCIDENTAL OR CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND
+* WHATSOEVER RELATED TO THE SOFTWARE, HOWEVER CAUSED, EVEN IF MICROCHIP HAS
+* BEEN ADVISED OF THE POSSIBILITY OR THE DAMAGES ARE FORESEEABLE. TO THE
+* FULLEST EXTENT ALLOWED BY LAW, MICROCHIP'S TOTAL LIABILITY ON ALL CLAIMS IN
+* ANY WAY RELATED TO THIS SOFTWARE WILL NOT EXCEED THE AMOUNT OF FEES, IF ANY,
+* THAT YOU HAVE PAID DIRECTLY TO MICROCHIP FOR THIS SOFTWARE.
+*******************************************************************************/
+//DOM-IGNORE-END
+
+
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Included Files
+// *****************************************************************************
+// *****************************************************************************
+
+#include <string.h>
+#include "app_can_txevent.h"
+#include "app_can_format.h"
+#include "app_can_load.h"
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Global Data
+// *****************************************************************************
+// *****************************************************************************
+
+#define APP_CAN_TXEVENT_US_PER_TICK             (1000000U / APP_CAN_FORMAT_TICKS_PER_SECOND)
+
+static const uint8_t txEventDlcLength[16] = {0U, 1U, 2U, 3U, 4U, 5U, 6U, 7U, 8U, 12U, 16U, 20U, 24U, 32U, 48U, 64U};
+
+static APP_CAN_TXEVENT_STATS txEventStats;
+/* Driver lost count at the last reset */
+static uint32_t txEventLostBase = 0U;
+
+/* End of the previous frame of this node */
+static uint32_t txEventLastEnd = 0U;
+static bool txEventLastValid = false;
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: CAN Transmit Timing Routines
+// *****************************************************************************
+// *****************************************************************************
+
+static void APP_CAN_TxEventHistogramAdd(APP_CAN_TXEVENT_HISTOGRAM *histogram, int32_t ticks)
+{
+    uint32_t us = (ticks > 0) ? ((uint32_t)ticks * APP_CAN_TXEVENT_US_PER_TICK) : 0U;
+    uint32_t limit = APP_CAN_TXEVENT_BIN0_US;
+    uint32_t bin = 0U;
+
+    while ((bin < (APP_CAN_TXEVENT_BINS - 1U)) && (us >= limit))
+    {
+        bin++;
+        limit <<= 1;
+    }
+    histogram->bins[bin]++;
+
+    if ((histogram->count == 0U) || (us < histogram->min))
+    {
+        histogram->min = us;
+    }
+    if (us > histogram->max)
+    {
+        histogram->max = us;
+    }
+    histogram->sum += us;
+    histogram->count++;
+}
+
+void APP_CAN_TxEventReset(void)
+{
+    memset(&txEventStats, 0, sizeof(txEventStats));
+    txEventLostBase = CAN1_TxEventLostCountGet();
+    txEventLastValid = false;
+}
+
+void APP_CAN_TxEventAdd(const CAN_TX_EVENT *event)
+{
+    const CAN_TX_EVENT_FIFO *element = &event->element;
+    uint32_t earliest = event->queued;
+    uint32_t end = 0U;
+
+    end = event->timestamp + APP_CAN_LoadFrameTicksGet((element->xtd != 0U), (element->fdf != 0U), (element->brs != 0U),
+                                                       element->rtr ? 0U : txEventDlcLength[element->dlc]);
+
+    /* Frames of this node go out one after the other, the Tx FIFO holds the
+       next one back until the previous one has ended */
+    if ((txEventLastValid == true) && ((int32_t)(txEventLastEnd - earliest) > 0))
+    {
+        earliest = txEventLastEnd;
+    }
+    /* Negative when the previous frame was shorter than its worst case length */
+    APP_CAN_TxEventHistogramAdd(&txEventStats.arbitration, (int32_t)(event->timestamp - earliest));
+    APP_CAN_TxEventHistogramAdd(&txEventStats.latency, (int32_t)(end - event->queued));
+
+    txEventLastEnd = end;
+    txEventLastValid = true;
+}
+
+void APP_CAN_TxEventStatsGet(APP_CAN_TXEVENT_STATS *stats)
+{
+    *stats = txEventStats;
+    stats->lost = CAN1_TxEventLostCountGet() - txEventLostBase;
+}
+
+uint32_t APP_CAN_TxEventBinStartGet(uint32_t bin)
+{
+    if (bin == 0U)
+    {
+        return 0U;
+    }
+    return APP_CAN_TXEVENT_BIN0_US << (bin - 1U);
+}
+
+/*******************************************************************************
+ End of File
+*/
@@ -0,0 +1,132 @@
+/*******************************************************************************
+  CAN Transmit Timing Header File
+
+  Company:
+    Microchip Technology Inc.
+
+  File Name:
+    app_can_txevent.h
+
+  Summary:
+    CAN transmit latency and arbitration delay statistics interface.
+
+  Description:
+    This file declares the histograms built from the Tx events of CAN1: the
+    latency from the transmission request to the end of the frame on the bus,
+    and the delay of the start of frame caused by other nodes.
+*******************************************************************************/
+
+//DOM-IGNORE-BEGIN
+/*******************************************************************************
+* Copyright (C) 2024 Microchip Technology Inc. and its subsidiaries.
+*
+* Subject to your compliance with these terms, you may use Microchip software
+* and any derivatives exclusively with Microchip products. It is your
+* responsibility to comply with third party license terms applicable to your
+* use of third party software (including open source software) that may
+* accompany Microchip software.
+*
+* THIS SOFTWARE IS SUPPLIED BY MICROCHIP "AS IS". NO WARRANTIES, WHETHER
+* EXPRESS, IMPLIED OR STATUTORY, APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED
+* WARRANTIES OF NON-INFRINGEMENT, MERCHANTABILITY, AND FITNESS FOR A
+* PARTICULAR PURPOSE.
+*
+* IN NO EVENT WILL MICROCHIP BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE,
+* INCIDENTAL OR CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND
+* WHATSOEVER RELATED TO THE SOFTWARE, HOWEVER CAUSED, EVEN IF MICROCHIP HAS
+* BEEN ADVISED OF THE POSSIBILITY OR THE DAMAGES ARE FORESEEABLE. TO THE
+* FULLEST EXTENT ALLOWED BY LAW, MICROCHIP'S TOTAL LIABILITY ON ALL CLAIMS IN
+* ANY WAY RELATED TO THIS SOFTWARE WILL NOT EXCEED THE AMOUNT OF FEES, IF ANY,
+* THAT YOU HAVE PAID DIRECTLY TO MICROCHIP FOR THIS SOFTWARE.
+*******************************************************************************/
+//DOM-IGNORE-END
+
+
+
+#ifndef APP_CAN_TXEVENT_H
+#define APP_CAN_TXEVENT_H
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Included Files
+// *****************************************************************************
+// *****************************************************************************
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "definitions.h"
+
+// DOM-IGNORE-BEGIN
+#ifdef __cplusplus  // Provide C++ Compatibility
+    extern "C" {
+#endif
+// DOM-IGNORE-END
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Data Types
+// *****************************************************************************
+// *****************************************************************************
+
+/* Message marker (mm) of transmitted frames: bit 7 tells the sender, bits 6:0
+   are the sender's own frame index, so the markers of pending frames differ */
+#define APP_CAN_TXEVENT_MARKER_SOURCE_Msk       0x80U
+#define APP_CAN_TXEVENT_MARKER_REPLAY           0x00U
+#define APP_CAN_TXEVENT_MARKER_CYCLIC           0x80U
+#define APP_CAN_TXEVENT_MARKER_INDEX_Msk        0x7FU
+
+/* Histogram bins: bin 0 counts below APP_CAN_TXEVENT_BIN0_US, every further
+   bin covers twice the range of the one before, the last one has no limit */
+#define APP_CAN_TXEVENT_BINS                    16U
+#define APP_CAN_TXEVENT_BIN0_US                 16U
+
+/* Distribution of a time in microseconds */
+typedef struct
+{
+    uint32_t count;
+    uint32_t min;
+    uint32_t max;
+    uint64_t sum;
+    uint32_t bins[APP_CAN_TXEVENT_BINS];
+} APP_CAN_TXEVENT_HISTOGRAM;
+
+typedef struct
+{
+    /* Transmission request to the end of the frame (worst case length) */
+    APP_CAN_TXEVENT_HISTOGRAM latency;
+    /* Start of frame after the earliest possible start: the later of the
+       request and the end of the previous frame of this node. The time lost
+       in arbitration or waiting for frames of other nodes. */
+    APP_CAN_TXEVENT_HISTOGRAM arbitration;
+    /* Tx events lost by the driver since the reset */
+    uint32_t lost;
+} APP_CAN_TXEVENT_STATS;
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Interface Routines
+// *****************************************************************************
+// *****************************************************************************
+
+/* Clears the histograms */
+void APP_CAN_TxEventReset(void);
+
+/* Accounts one Tx event, call in transmission order (CAN1_TxEventGet) */
+void APP_CAN_TxEventAdd(const CAN_TX_EVENT *event);
+
+void APP_CAN_TxEventStatsGet(APP_CAN_TXEVENT_STATS *stats);
+
+/* Lower limit of a histogram bin in microseconds */
+uint32_t APP_CAN_TxEventBinStartGet(uint32_t bin);
+
+// DOM-IGNORE-BEGIN
+#ifdef __cplusplus  // Provide C++ Compatibility
+    }
+#endif
+// DOM-IGNORE-END
+
+#endif // APP_CAN_TXEVENT_H
+
+/*******************************************************************************
+ End of File
+*/
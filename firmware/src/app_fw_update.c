@@ -0,0 +1,402 @@
+/*******************************************************************************
+  Firmware Update Source File
+
+  Company:
+    Microchip Technology Inc.
+
+  File Name:
+    app_fw_update.c
+
+  Summary:
+    Dual-bank firmware update over the BLE link, implementation.
+
+  Description:
+    This file implements the firmware update. The image is written with quad-
+    word writes into the inactive flash bank while the application keeps running
+    from the active one, checked with the DMAC CRC engine, and made active with
+    a bank swap, which also resets the device.
+*******************************************************************************/
+
+//DOM-IGNORE-BEGIN
+/*******************************************************************************
+* Copyright (C) 2024 Microchip Technology Inc. and its subsidiaries.
+*
+* Subject to your compliance with these terms, you may use Microchip software
+* and any derivatives exclusively with Microchip products. It is your
+* responsibility to comply with third party license terms applicable to your
+* use of third party software (including open source software) that may
+* accompany Microchip software.
+*
+* THIS SOFTWARE IS SUPPLIED BY MICROCHIP "AS IS". NO WARRANTIES, WHETHER
+* EXPRESS, IMPLIED OR STATUTORY, APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED
+* WARRANTIES OF NON-INFRINGEMENT, MERCHANTABILITY, AND FITNESS FOR A
+* PARTICULAR PURPOSE.
+*
+* IN NO EVENT WILL MICROCHIP BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE,
+* INCIDENTAL OR CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND
+* WHATSOEVER RELATED TO THE SOFTWARE, HOWEVER CAUSED, EVEN IF MICROCHIP HAS
+* BEEN ADVISED OF THE POSSIBILITY OR THE DAMAGES ARE FORESEEABLE. TO THE
+* FULLEST EXTENT ALLOWED BY LAW, MICROCHIP'S TOTAL LIABILITY ON ALL CLAIMS IN
+* ANY WAY RELATED TO THIS SOFTWARE WILL NOT EXCEED THE AMOUNT OF FEES, IF ANY,
+* THAT YOU HAVE PAID DIRECTLY TO MICROCHIP FOR THIS SOFTWARE.
+*******************************************************************************/
+//DOM-IGNORE-END
+
+
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Included Files
+// *****************************************************************************
+// *****************************************************************************
+
+#include <string.h>
+#include "app_fw_update.h"
+#include "app_can_format.h"
+#include "app_can_record.h"
+#include "app_uart_queue.h"
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Global Data
+// *****************************************************************************
+// *****************************************************************************
+
+#define APP_FW_UPDATE_QUAD_WORD                 16U
+/* Type and payload length */
+#define APP_FW_UPDATE_HEADER_SIZE               3U
+#define APP_FW_UPDATE_PAYLOAD_MAX               (4U + APP_FW_UPDATE_DATA_MAX)
+#define APP_FW_UPDATE_RESPONSE_SIZE             12U
+
+typedef enum
+{
+    APP_FW_UPDATE_RX_SYNC0,
+    APP_FW_UPDATE_RX_SYNC1,
+    APP_FW_UPDATE_RX_HEADER,
+    APP_FW_UPDATE_RX_PAYLOAD,
+    APP_FW_UPDATE_RX_CRC
+} APP_FW_UPDATE_RX_STATE;
+
+/* Frame being received: type, payload length, payload, CRC */
+static uint8_t fwUpdateFrame[APP_FW_UPDATE_HEADER_SIZE + APP_FW_UPDATE_PAYLOAD_MAX + 2U];
+static uint32_t fwUpdateFrameLength = 0U;
+static uint32_t fwUpdatePayloadLength = 0U;
+static APP_FW_UPDATE_RX_STATE fwUpdateRxState = APP_FW_UPDATE_RX_SYNC0;
+/* A complete frame waits for APP_FW_UpdateTasks, bytes are ignored */
+static bool fwUpdateFramePending = false;
+
+static APP_FW_UPDATE_STATE fwUpdateState = APP_FW_UPDATE_STATE_IDLE;
+static uint32_t fwUpdateSize = 0U;
+static uint32_t fwUpdateCrc = 0U;
+/* Next image offset expected from the host */
+static uint32_t fwUpdateExpected = 0U;
+/* Image bytes [0, fwUpdateErased) are in erased or written blocks */
+static uint32_t fwUpdateErased = 0U;
+static uint32_t fwUpdateLastFrame = 0U;
+
+/* Data frame being written, whole quad words */
+static uint32_t fwUpdateData[APP_FW_UPDATE_DATA_MAX / 4U];
+static uint32_t fwUpdateDataOffset = 0U;
+static uint32_t fwUpdateDataIndex = 0U;
+static uint32_t fwUpdateDataLength = 0U;
+
+static uint8_t fwUpdateResponse[APP_FW_UPDATE_RESPONSE_SIZE];
+static bool fwUpdateResponsePending = false;
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Firmware Update Routines
+// *****************************************************************************
+// *****************************************************************************
+
+static uint32_t APP_FW_UpdateLoad32(const uint8_t *data)
+{
+    return (uint32_t)data[0] | ((uint32_t)data[1] << 8) | ((uint32_t)data[2] << 16) | ((uint32_t)data[3] << 24);
+}
+
+static void APP_FW_UpdateRespond(uint8_t type, APP_FW_UPDATE_STATUS status)
+{
+    uint8_t *response = fwUpdateResponse;
+    uint16_t crc = 0U;
+
+    response[0] = APP_FW_UPDATE_SYNC0;
+    response[1] = APP_FW_UPDATE_SYNC1;
+    response[2] = type | APP_FW_UPDATE_FRAME_RESPONSE;
+    response[3] = 5U;
+    response[4] = 0U;
+    response[5] = (uint8_t)status;
+    response[6] = (uint8_t)fwUpdateExpected;
+    response[7] = (uint8_t)(fwUpdateExpected >> 8);
+    response[8] = (uint8_t)(fwUpdateExpected >> 16);
+    response[9] = (uint8_t)(fwUpdateExpected >> 24);
+    crc = APP_CAN_RecordCrc16(&response[2], APP_FW_UPDATE_HEADER_SIZE + 5U);
+    response[10] = (uint8_t)crc;
+    response[11] = (uint8_t)(crc >> 8);
+    fwUpdateResponsePending = true;
+}
+
+/* Checks the written image: CRC-32 by the DMAC CRC engine in I/O mode and a
+   plausible vector table, so that the swap cannot start a broken image */
+static bool APP_FW_UpdateVerify(void)
+{
+    const uint32_t *vectors = (const uint32_t *)APP_FW_UPDATE_START;
+    DMAC_CRC_SETUP setup = {DMAC_CRC_TYPE_32, DMAC_CRC_MODE_DEFAULT, 0xFFFFFFFFUL};
+    uint32_t stack = vectors[0];
+    uint32_t reset = vectors[1];
+
+    /* Reads back as the usual CRC-32 (bit reversed and complemented) */
+    if (DMAC_CRCCalculate((void *)APP_FW_UPDATE_START, fwUpdateSize, setup) != fwUpdateCrc)
+    {
+        return false;
+    }
+    return ((stack > HSRAM_ADDR) && (stack <= (HSRAM_ADDR + HSRAM_SIZE)) && ((reset & 1U) != 0U) &&
+            (reset < fwUpdateSize));
+}
+
+static void APP_FW_UpdateFrameProcess(void)
+{
+    uint8_t type = fwUpdateFrame[0];
+    const uint8_t *payload = &fwUpdateFrame[APP_FW_UPDATE_HEADER_SIZE];
+    uint32_t offset = 0U;
+    uint32_t length = 0U;
+
+    fwUpdateFramePending = false;
+    if (fwUpdateState == APP_FW_UPDATE_STATE_SWAPPING)
+    {
+        return;
+    }
+
+    switch (type)
+    {
+        case APP_FW_UPDATE_FRAME_START:
+            if ((fwUpdatePayloadLength != 8U) || (APP_FW_UpdateLoad32(payload) == 0U) ||
+                (APP_FW_UpdateLoad32(payload) > APP_FW_UPDATE_SIZE))
+            {
+                APP_FW_UpdateRespond(type, APP_FW_UPDATE_STATUS_LENGTH);
+                break;
+            }
+            fwUpdateSize = APP_FW_UpdateLoad32(payload);
+            fwUpdateCrc = APP_FW_UpdateLoad32(&payload[4]);
+            fwUpdateExpected = 0U;
+            fwUpdateErased = 0U;
+            fwUpdateState = APP_FW_UPDATE_STATE_RECEIVING;
+            APP_FW_UpdateRespond(type, APP_FW_UPDATE_STATUS_OK);
+            break;
+
+        case APP_FW_UPDATE_FRAME_DATA:
+            if (fwUpdateState != APP_FW_UPDATE_STATE_RECEIVING)
+            {
+                APP_FW_UpdateRespond(type, APP_FW_UPDATE_STATUS_STATE);
+                break;
+            }
+            offset = APP_FW_UpdateLoad32(payload);
+            length = fwUpdatePayloadLength - 4U;
+            if ((fwUpdatePayloadLength < 4U) || (offset != fwUpdateExpected))
+            {
+                /* Also the answer to a frame sent again after a lost response */
+                APP_FW_UpdateRespond(type, APP_FW_UPDATE_STATUS_OFFSET);
+                break;
+            }
+            if ((length == 0U) || (length > (fwUpdateSize - offset)) ||
+                (((length % APP_FW_UPDATE_QUAD_WORD) != 0U) && ((offset + length) != fwUpdateSize)))
+            {
+                APP_FW_UpdateRespond(type, APP_FW_UPDATE_STATUS_LENGTH);
+                break;
+            }
+            /* The tail of the last quad word stays erased */
+            memset(fwUpdateData, 0xFF, sizeof(fwUpdateData));
+            memcpy(fwUpdateData, &payload[4], length);
+            fwUpdateDataOffset = offset;
+            fwUpdateDataIndex = 0U;
+            fwUpdateDataLength = (length + APP_FW_UPDATE_QUAD_WORD - 1U) & ~(APP_FW_UPDATE_QUAD_WORD - 1U);
+            fwUpdateExpected = offset + length;
+            /* Answered once written */
+            break;
+
+        case APP_FW_UPDATE_FRAME_END:
+            /* Sent again after a lost response */
+            if (fwUpdateState == APP_FW_UPDATE_STATE_VERIFIED)
+            {
+                APP_FW_UpdateRespond(type, APP_FW_UPDATE_STATUS_OK);
+                break;
+            }
+            if ((fwUpdateState != APP_FW_UPDATE_STATE_RECEIVING) || (fwUpdateExpected != fwUpdateSize))
+            {
+                APP_FW_UpdateRespond(type, APP_FW_UPDATE_STATUS_STATE);
+                break;
+            }
+            if (APP_FW_UpdateVerify() == false)
+            {
+                fwUpdateState = APP_FW_UPDATE_STATE_IDLE;
+                APP_FW_UpdateRespond(type, APP_FW_UPDATE_STATUS_VERIFY);
+                break;
+            }
+            fwUpdateState = APP_FW_UPDATE_STATE_VERIFIED;
+            APP_FW_UpdateRespond(type, APP_FW_UPDATE_STATUS_OK);
+            break;
+
+        case APP_FW_UPDATE_FRAME_SWAP:
+            if (fwUpdateState != APP_FW_UPDATE_STATE_VERIFIED)
+            {
+                APP_FW_UpdateRespond(type, APP_FW_UPDATE_STATUS_STATE);
+                break;
+            }
+            fwUpdateState = APP_FW_UPDATE_STATE_SWAPPING;
+            APP_FW_UpdateRespond(type, APP_FW_UPDATE_STATUS_OK);
+            break;
+
+        case APP_FW_UPDATE_FRAME_ABORT:
+            fwUpdateState = APP_FW_UPDATE_STATE_IDLE;
+            APP_FW_UpdateRespond(type, APP_FW_UPDATE_STATUS_OK);
+            break;
+
+        default:
+            APP_FW_UpdateRespond(type, APP_FW_UPDATE_STATUS_STATE);
+            break;
+    }
+}
+
+/* One NVM operation for the data frame being written */
+static void APP_FW_UpdateWrite(void)
+{
+    uint32_t offset = fwUpdateDataOffset + fwUpdateDataIndex;
+
+    /* Blocks are erased as the image reaches them */
+    if (offset >= fwUpdateErased)
+    {
+        (void)NVMCTRL_BlockErase(APP_FW_UPDATE_START + fwUpdateErased);
+        fwUpdateErased += NVMCTRL_FLASH_BLOCKSIZE;
+        return;
+    }
+    (void)NVMCTRL_QuadWordWrite(&fwUpdateData[fwUpdateDataIndex / 4U], APP_FW_UPDATE_START + offset);
+    fwUpdateDataIndex += APP_FW_UPDATE_QUAD_WORD;
+    if (fwUpdateDataIndex >= fwUpdateDataLength)
+    {
+        fwUpdateDataLength = 0U;
+        APP_FW_UpdateRespond(APP_FW_UPDATE_FRAME_DATA, APP_FW_UPDATE_STATUS_OK);
+    }
+}
+
+void APP_FW_UpdateReceive(uint8_t data)
+{
+    uint16_t crc = 0U;
+
+    if (fwUpdateFramePending == true)
+    {
+        return;
+    }
+
+    switch (fwUpdateRxState)
+    {
+        case APP_FW_UPDATE_RX_SYNC0:
+            if (data == APP_FW_UPDATE_SYNC0)
+            {
+                fwUpdateRxState = APP_FW_UPDATE_RX_SYNC1;
+            }
+            break;
+        case APP_FW_UPDATE_RX_SYNC1:
+            fwUpdateFrameLength = 0U;
+            fwUpdateRxState = (data == APP_FW_UPDATE_SYNC1) ? APP_FW_UPDATE_RX_HEADER :
+                              ((data == APP_FW_UPDATE_SYNC0) ? APP_FW_UPDATE_RX_SYNC1 : APP_FW_UPDATE_RX_SYNC0);
+            break;
+        case APP_FW_UPDATE_RX_HEADER:
+            fwUpdateFrame[fwUpdateFrameLength++] = data;
+            if (fwUpdateFrameLength == APP_FW_UPDATE_HEADER_SIZE)
+            {
+                fwUpdatePayloadLength = (uint32_t)fwUpdateFrame[1] | ((uint32_t)fwUpdateFrame[2] << 8);
+                if (fwUpdatePayloadLength > APP_FW_UPDATE_PAYLOAD_MAX)
+                {
+                    fwUpdateRxState = APP_FW_UPDATE_RX_SYNC0;
+                }
+                else
+                {
+                    fwUpdateRxState = (fwUpdatePayloadLength == 0U) ? APP_FW_UPDATE_RX_CRC : APP_FW_UPDATE_RX_PAYLOAD;
+                }
+            }
+            break;
+        case APP_FW_UPDATE_RX_PAYLOAD:
+            fwUpdateFrame[fwUpdateFrameLength++] = data;
+            if (fwUpdateFrameLength == (APP_FW_UPDATE_HEADER_SIZE + fwUpdatePayloadLength))
+            {
+                fwUpdateRxState = APP_FW_UPDATE_RX_CRC;
+            }
+            break;
+        case APP_FW_UPDATE_RX_CRC:
+            fwUpdateFrame[fwUpdateFrameLength++] = data;
+            if (fwUpdateFrameLength == (APP_FW_UPDATE_HEADER_SIZE + fwUpdatePayloadLength + 2U))
+            {
+                crc = APP_CAN_RecordCrc16(fwUpdateFrame, APP_FW_UPDATE_HEADER_SIZE + fwUpdatePayloadLength);
+                fwUpdateFramePending = ((fwUpdateFrame[fwUpdateFrameLength - 2U] == (uint8_t)crc) &&
+                                        (fwUpdateFrame[fwUpdateFrameLength - 1U] == (uint8_t)(crc >> 8)));
+                fwUpdateRxState = APP_FW_UPDATE_RX_SYNC0;
+            }
+            break;
+        default:
+            fwUpdateRxState = APP_FW_UPDATE_RX_SYNC0;
+            break;
+    }
+}
+
+void APP_FW_UpdateTasks(uint32_t now)
+{
+    if (fwUpdateResponsePending == true)
+    {
+        if (APP_UART_QueueWrite(APP_UART_QUEUE_BLE, fwUpdateResponse, APP_FW_UPDATE_RESPONSE_SIZE) == false)
+        {
+            return;
+        }
+        fwUpdateResponsePending = false;
+    }
+
+    if (fwUpdateState == APP_FW_UPDATE_STATE_SWAPPING)
+    {
+        /* Capture goes on until the last output has been sent */
+        if (APP_UART_QueueIsBusy(APP_UART_QUEUE_BLE) || APP_UART_QueueIsBusy(APP_UART_QUEUE_DEBUG) || NVMCTRL_IsBusy())
+        {
+            return;
+        }
+        NVMCTRL_BankSwap();
+        return;
+    }
+
+    if (fwUpdateDataLength != 0U)
+    {
+        if (NVMCTRL_IsBusy() == false)
+        {
+            APP_FW_UpdateWrite();
+        }
+        return;
+    }
+
+    if (fwUpdateFramePending == true)
+    {
+        /* The flash must be idle for the CRC check */
+        if (NVMCTRL_IsBusy() == false)
+        {
+            fwUpdateLastFrame = now;
+            APP_FW_UpdateFrameProcess();
+        }
+        return;
+    }
+
+    if ((fwUpdateState != APP_FW_UPDATE_STATE_IDLE) &&
+        ((now - fwUpdateLastFrame) > (APP_FW_UPDATE_TIMEOUT_MS * (APP_CAN_FORMAT_TICKS_PER_SECOND / 1000U))))
+    {
+        fwUpdateState = APP_FW_UPDATE_STATE_IDLE;
+    }
+}
+
+APP_FW_UPDATE_STATE APP_FW_UpdateStateGet(void)
+{
+    return fwUpdateState;
+}
+
+void APP_FW_UpdateProgressGet(uint32_t *size, uint32_t *written)
+{
+    *size = fwUpdateSize;
+    *written = fwUpdateExpected;
+}
+
+/*******************************************************************************
+ End of File
+*/
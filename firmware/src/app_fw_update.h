@@ -0,0 +1,158 @@
+/*******************************************************************************
+  Firmware Update Header File
+
+  Company:
+    Microchip Technology Inc.
+
+  File Name:
+    app_fw_update.h
+
+  Summary:
+    Dual-bank firmware update over the BLE link, interface.
+
+  Description:
+    This file declares the firmware update, which receives a new application
+    image over the RNBD451 UART into the inactive flash bank, verifies it and
+    swaps the banks.
+*******************************************************************************/
+
+//DOM-IGNORE-BEGIN
+/*******************************************************************************
+* Copyright (C) 2024 Microchip Technology Inc. and its subsidiaries.
+*
+* Subject to your compliance with these terms, you may use Microchip software
+* and any derivatives exclusively with Microchip products. It is your
+* responsibility to comply with third party license terms applicable to your
+* use of third party software (including open source software) that may
+* accompany Microchip software.
+*
+* THIS SOFTWARE IS SUPPLIED BY MICROCHIP "AS IS". NO WARRANTIES, WHETHER
+* EXPRESS, IMPLIED OR STATUTORY, APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED
+* WARRANTIES OF NON-INFRINGEMENT, MERCHANTABILITY, AND FITNESS FOR A
+* PARTICULAR PURPOSE.
+*
+* IN NO EVENT WILL MICROCHIP BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE,
+* INCIDENTAL OR CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND
+* WHATSOEVER RELATED TO THE SOFTWARE, HOWEVER CAUSED, EVEN IF MICROCHIP HAS
+* BEEN ADVISED OF THE POSSIBILITY OR THE DAMAGES ARE FORESEEABLE. TO THE
+* FULLEST EXTENT ALLOWED BY LAW, MICROCHIP'S TOTAL LIABILITY ON ALL CLAIMS IN
+* ANY WAY RELATED TO THIS SOFTWARE WILL NOT EXCEED THE AMOUNT OF FEES, IF ANY,
+* THAT YOU HAVE PAID DIRECTLY TO MICROCHIP FOR THIS SOFTWARE.
+*******************************************************************************/
+//DOM-IGNORE-END
+
+
+
+#ifndef APP_FW_UPDATE_H
+#define APP_FW_UPDATE_H
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Included Files
+// *****************************************************************************
+// *****************************************************************************
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "definitions.h"
+
+// DOM-IGNORE-BEGIN
+#ifdef __cplusplus  // Provide C++ Compatibility
+    extern "C" {
+#endif
+// DOM-IGNORE-END
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Data Types
+// *****************************************************************************
+// *****************************************************************************
+
+/* Image area, the first ROM_LENGTH bytes (ATSAME51J20A.ld) of the bank
+   mapped second, i.e. the inactive bank */
+#define APP_FW_UPDATE_START                     0x00080000UL
+#define APP_FW_UPDATE_SIZE                      0x00040000UL
+
+/* Frames in both directions:
+     0xA5 0x5A, type (1 byte), payload length (2 bytes), payload,
+     CRC-16/CCITT-FALSE of type, length and payload (2 bytes)
+   Multi-byte fields are little endian. Every request is answered with a
+   frame of type request | APP_FW_UPDATE_FRAME_RESPONSE and the payload
+   status (1 byte), offset (4 bytes): the next image offset expected. */
+#define APP_FW_UPDATE_SYNC0                     0xA5U
+#define APP_FW_UPDATE_SYNC1                     0x5AU
+
+/* Payload: image size (4 bytes), CRC-32 of the image (4 bytes) */
+#define APP_FW_UPDATE_FRAME_START               0x01U
+/* Payload: image offset (4 bytes), up to APP_FW_UPDATE_DATA_MAX bytes. The
+   offset must be a multiple of 16 and only the last frame may be shorter. */
+#define APP_FW_UPDATE_FRAME_DATA                0x02U
+/* No payload, checks the CRC once all bytes are written */
+#define APP_FW_UPDATE_FRAME_END                 0x03U
+/* No payload, swaps the banks and resets once the image is verified */
+#define APP_FW_UPDATE_FRAME_SWAP                0x04U
+#define APP_FW_UPDATE_FRAME_ABORT               0x05U
+#define APP_FW_UPDATE_FRAME_RESPONSE            0x80U
+
+#define APP_FW_UPDATE_DATA_MAX                  256U
+
+/* An update without frames for this long is abandoned */
+#ifndef APP_FW_UPDATE_TIMEOUT_MS
+#define APP_FW_UPDATE_TIMEOUT_MS                10000U
+#endif
+
+typedef enum
+{
+    APP_FW_UPDATE_STATUS_OK = 0,
+    /* Request not valid in the current state */
+    APP_FW_UPDATE_STATUS_STATE,
+    /* Data frame not at the expected offset, resend from the offset answered */
+    APP_FW_UPDATE_STATUS_OFFSET,
+    /* Image size or frame length not valid */
+    APP_FW_UPDATE_STATUS_LENGTH,
+    /* CRC or vector table of the written image not valid */
+    APP_FW_UPDATE_STATUS_VERIFY
+} APP_FW_UPDATE_STATUS;
+
+typedef enum
+{
+    APP_FW_UPDATE_STATE_IDLE,
+    /* Erasing and writing the image */
+    APP_FW_UPDATE_STATE_RECEIVING,
+    /* Image written and verified, waiting for the swap request */
+    APP_FW_UPDATE_STATE_VERIFIED,
+    /* Waiting for the output to be sent before the swap */
+    APP_FW_UPDATE_STATE_SWAPPING
+} APP_FW_UPDATE_STATE;
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Interface Routines
+// *****************************************************************************
+// *****************************************************************************
+
+/* Parses a byte received on the BLE link. Bytes outside of valid frames are
+   ignored, so the link can carry other traffic while no update runs. */
+void APP_FW_UpdateReceive(uint8_t data);
+
+/* Erases and writes the image a step at a time whenever the NVM is ready,
+   sends the responses and swaps the banks. now is the current extended
+   CAN timestamp, for the timeout. Call from the main loop. */
+void APP_FW_UpdateTasks(uint32_t now);
+
+APP_FW_UPDATE_STATE APP_FW_UpdateStateGet(void);
+
+/* Image size and bytes written so far */
+void APP_FW_UpdateProgressGet(uint32_t *size, uint32_t *written);
+
+// DOM-IGNORE-BEGIN
+#ifdef __cplusplus  // Provide C++ Compatibility
+    }
+#endif
+// DOM-IGNORE-END
+
+#endif // APP_FW_UPDATE_H
+
+/*******************************************************************************
+ End of File
+*/
@@ -0,0 +1,469 @@
+/*******************************************************************************
+  UART Transmit Queue Source File
+
+  Company:
+    Microchip Technology Inc.
+
+  File Name:
+    app_uart_queue.c
+
+  Summary:
+    Non-blocking UART transmit queue implementation.
+
+  Description:
+    This file implements the queues which feed the debug (SERCOM5) and BLE
+    (SERCOM0) USART transmitters. A queue holds a list of segments which
+    either point into the queue's own byte ring (copied data) or straight at
+    caller memory (referenced data). Pending segments are sent as one DMAC
+    linked list transfer with descriptors drawn from a shared pool, and the
+    next list is started from the channel's transfer complete callback.
+    Received bytes are collected into a ring per link by the USART read
+    callback.
+*******************************************************************************/
+
+//DOM-IGNORE-BEGIN
+/*******************************************************************************
+* Copyright (C) 2024 Microchip Technology Inc. and its subsidiaries.
+*
+* Subject to your compliance with these terms, you may use Microchip software
+* and any derivatives exclusively with Microchip products. It is your
+* responsibility to comply with third party license terms applicable to your
+* use of third party software (including open source software) that may
+* accompany Microchip software.
+*
+* THIS SOFTWARE IS SUPPLIED BY MICROCHIP "AS IS". NO WARRANTIES, WHETHER
+* EXPRESS, IMPLIED OR STATUTORY, APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED
+* WARRANTIES OF NON-INFRINGEMENT, MERCHANTABILITY, AND FITNESS FOR A
+* PARTICULAR PURPOSE.
+*
+* IN NO EVENT WILL MICROCHIP BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE,
+* INCIDENTAL OR CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND
+* WHATSOEVER RELATED TO THE SOFTWARE, HOWEVER CAUSED, EVEN IF MICROCHIP HAS
+* BEEN ADVISED OF THE POSSIBILITY OR THE DAMAGES ARE FORESEEABLE. TO THE
+* FULLEST EXTENT ALLOWED BY LAW, MICROCHIP'S TOTAL LIABILITY ON ALL CLAIMS IN
+* ANY WAY RELATED TO THIS SOFTWARE WILL NOT EXCEED THE AMOUNT OF FEES, IF ANY,
+* THAT YOU HAVE PAID DIRECTLY TO MICROCHIP FOR THIS SOFTWARE.
+*******************************************************************************/
+//DOM-IGNORE-END
+
+
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Included Files
+// *****************************************************************************
+// *****************************************************************************
+
+#include <string.h>
+#include "app_uart_queue.h"
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Global Data
+// *****************************************************************************
+// *****************************************************************************
+
+#define APP_UART_QUEUE_MASK                     (APP_UART_QUEUE_SIZE - 1U)
+#define APP_UART_QUEUE_SEGMENT_MASK             (APP_UART_QUEUE_SEGMENTS - 1U)
+
+/* Largest block a single descriptor can move (16-bit BTCNT) */
+#define APP_UART_SEGMENT_MAX_LENGTH             0xFFFFU
+
+/* Byte transfers from memory to the SERCOM DATA register */
+#define APP_UART_DESCRIPTOR_SETTING             (DMAC_BTCTRL_VALID_Msk | DMAC_BTCTRL_BEATSIZE_BYTE | DMAC_BTCTRL_SRCINC_Msk)
+
+typedef struct
+{
+    const uint8_t *data;
+    uint16_t length;
+    /* Segment points into the queue's byte ring */
+    bool inRing;
+    /* Ring head value just after this segment, the ring tail moves here
+       once the segment is sent (covers bytes skipped by a reservation) */
+    uint32_t ringEnd;
+} APP_UART_SEGMENT;
+
+typedef struct
+{
+    uint8_t buffer[APP_UART_QUEUE_SIZE];
+    /* Free running byte ring indices, head is owned by the producer,
+       tail by the DMA callback */
+    volatile uint32_t head;
+    volatile uint32_t tail;
+
+    APP_UART_SEGMENT segment[APP_UART_QUEUE_SEGMENTS];
+    /* Segments [segmentTail, segmentStart) are being sent by the DMAC,
+       segments [segmentStart, segmentHead) are pending */
+    volatile uint32_t segmentHead;
+    volatile uint32_t segmentStart;
+    volatile uint32_t segmentTail;
+
+    /* Bytes skipped at the end of the ring by the open reservation */
+    uint32_t reserveSkip;
+    /* Pool descriptors used by the transfer in progress */
+    uint32_t descriptorMask;
+    uint32_t dropped;
+    DMAC_CHANNEL channel;
+    const void *dataRegister;
+} APP_UART_QUEUE;
+
+static APP_UART_QUEUE uartQueue[APP_UART_QUEUE_COUNT];
+
+#define APP_UART_RECEIVE_MASK                   (APP_UART_RECEIVE_SIZE - 1U)
+
+typedef struct
+{
+    uint8_t buffer[APP_UART_RECEIVE_SIZE];
+    /* Free running indices, head is owned by the read callback, tail by
+       the main loop */
+    volatile uint32_t head;
+    volatile uint32_t tail;
+    /* Target of the USART read in progress */
+    uint8_t data;
+    uint32_t lost;
+} APP_UART_RECEIVE;
+
+static APP_UART_RECEIVE uartReceive[APP_UART_QUEUE_COUNT];
+
+/* Descriptors are fetched by the DMAC and must be 128-bit aligned */
+static dmac_descriptor_registers_t uartDescriptorPool[APP_UART_DESCRIPTOR_POOL_SIZE] __ALIGNED(16);
+static uint32_t uartDescriptorFree = 0U;
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: UART Transmit Queue Routines
+// *****************************************************************************
+// *****************************************************************************
+
+/* The following helpers are called with the DMAC interrupts unable to
+   preempt, i.e. with interrupts masked or from a DMAC callback */
+
+static int32_t APP_UART_DescriptorAllocate(void)
+{
+    uint32_t index = 0U;
+
+    for (index = 0U; index < APP_UART_DESCRIPTOR_POOL_SIZE; index++)
+    {
+        if ((uartDescriptorFree & (1UL << index)) != 0U)
+        {
+            uartDescriptorFree &= ~(1UL << index);
+            return (int32_t)index;
+        }
+    }
+    return -1;
+}
+
+/* Appends data to the pending segments, merging it with the last pending
+   segment when both are contiguous in the byte ring */
+static void APP_UART_SegmentAppend(APP_UART_QUEUE *queue, const uint8_t *data, uint32_t length, bool inRing, uint32_t ringEnd)
+{
+    APP_UART_SEGMENT *last = &queue->segment[(queue->segmentHead - 1U) & APP_UART_QUEUE_SEGMENT_MASK];
+
+    if ((inRing == true) && (queue->segmentHead != queue->segmentStart) && (last->inRing == true) &&
+        ((last->data + last->length) == data) && ((last->length + length) <= APP_UART_SEGMENT_MAX_LENGTH))
+    {
+        last->length += (uint16_t)length;
+        last->ringEnd = ringEnd;
+        return;
+    }
+
+    last = &queue->segment[queue->segmentHead & APP_UART_QUEUE_SEGMENT_MASK];
+    last->data = data;
+    last->length = (uint16_t)length;
+    last->inRing = inRing;
+    last->ringEnd = ringEnd;
+    queue->segmentHead = queue->segmentHead + 1U;
+}
+
+/* Links the pending segments into one descriptor list and hands it to the DMAC */
+static void APP_UART_QueueStart(APP_UART_QUEUE *queue)
+{
+    dmac_descriptor_registers_t *first = NULL;
+    dmac_descriptor_registers_t *previous = NULL;
+    dmac_descriptor_registers_t *current = NULL;
+    APP_UART_SEGMENT *segment = NULL;
+    uint32_t count = 0U;
+    int32_t index = 0;
+
+    /* Busy, or nothing to send */
+    if ((queue->segmentTail != queue->segmentStart) || (queue->segmentStart == queue->segmentHead))
+    {
+        return;
+    }
+
+    while (((queue->segmentStart + count) != queue->segmentHead) && (count < APP_UART_QUEUE_CHAIN_LENGTH))
+    {
+        index = APP_UART_DescriptorAllocate();
+        if (index < 0)
+        {
+            /* Pool exhausted, send what has been linked so far */
+            break;
+        }
+        queue->descriptorMask |= (1UL << (uint32_t)index);
+        current = &uartDescriptorPool[index];
+        segment = &queue->segment[(queue->segmentStart + count) & APP_UART_QUEUE_SEGMENT_MASK];
+
+        DMAC_LinkedListDescriptorSetup(current, APP_UART_DESCRIPTOR_SETTING | DMAC_BTCTRL_BLOCKACT_NOACT,
+                                       segment->data, queue->dataRegister, segment->length, NULL);
+        if (previous != NULL)
+        {
+            previous->DMAC_DESCADDR = (uint32_t)current;
+        }
+        else
+        {
+            first = current;
+        }
+        previous = current;
+        count++;
+    }
+
+    if (count == 0U)
+    {
+        /* Retried when another queue releases its descriptors */
+        return;
+    }
+
+    /* Interrupt on the last block only */
+    current->DMAC_BTCTRL = (current->DMAC_BTCTRL & ~DMAC_BTCTRL_BLOCKACT_Msk) | DMAC_BTCTRL_BLOCKACT_INT;
+    queue->segmentStart = queue->segmentStart + count;
+
+    /* Descriptors must be written before the DMAC fetches them */
+    __DMB();
+    DMAC_ChannelLinkedListTransfer(queue->channel, first);
+}
+
+void APP_UART_QueueInitialize(void)
+{
+    memset(uartQueue, 0, sizeof(uartQueue));
+    uartDescriptorFree = (APP_UART_DESCRIPTOR_POOL_SIZE == 32U) ? 0xFFFFFFFFUL : ((1UL << APP_UART_DESCRIPTOR_POOL_SIZE) - 1U);
+
+    uartQueue[APP_UART_QUEUE_DEBUG].channel = DMAC_CHANNEL_0;
+    uartQueue[APP_UART_QUEUE_DEBUG].dataRegister = (const void *)&(SERCOM5_REGS->USART_INT.SERCOM_DATA);
+    uartQueue[APP_UART_QUEUE_BLE].channel = DMAC_CHANNEL_1;
+    uartQueue[APP_UART_QUEUE_BLE].dataRegister = (const void *)&(SERCOM0_REGS->USART_INT.SERCOM_DATA);
+}
+
+bool APP_UART_QueueWrite(APP_UART_QUEUE_ID id, const void *data, size_t length)
+{
+    APP_UART_QUEUE *queue = &uartQueue[id];
+    uint32_t head = queue->head;
+    uint32_t start = head & APP_UART_QUEUE_MASK;
+    uint32_t first = 0U;
+    uint32_t primask = 0U;
+
+    if (length == 0U)
+    {
+        return true;
+    }
+    if (length > APP_UART_QueueFreeGet(id))
+    {
+        queue->dropped++;
+        return false;
+    }
+
+    first = APP_UART_QUEUE_SIZE - start;
+    if (first > length)
+    {
+        first = length;
+    }
+    memcpy(&queue->buffer[start], data, first);
+    memcpy(&queue->buffer[0], (const uint8_t *)data + first, length - first);
+
+    primask = __get_PRIMASK();
+    __disable_irq();
+    APP_UART_SegmentAppend(queue, &queue->buffer[start], first, true, head + first);
+    if (length > first)
+    {
+        APP_UART_SegmentAppend(queue, &queue->buffer[0], length - first, true, head + length);
+    }
+    queue->head = head + length;
+    APP_UART_QueueStart(queue);
+    __set_PRIMASK(primask);
+
+    return true;
+}
+
+bool APP_UART_QueueWriteReference(APP_UART_QUEUE_ID id, const void *data, size_t length)
+{
+    APP_UART_QUEUE *queue = &uartQueue[id];
+    uint32_t primask = 0U;
+
+    if (length == 0U)
+    {
+        return true;
+    }
+    if ((length > APP_UART_SEGMENT_MAX_LENGTH) ||
+        ((queue->segmentHead - queue->segmentTail) >= APP_UART_QUEUE_SEGMENTS))
+    {
+        queue->dropped++;
+        return false;
+    }
+
+    primask = __get_PRIMASK();
+    __disable_irq();
+    APP_UART_SegmentAppend(queue, (const uint8_t *)data, length, false, 0U);
+    APP_UART_QueueStart(queue);
+    __set_PRIMASK(primask);
+
+    return true;
+}
+
+uint8_t *APP_UART_QueueReserve(APP_UART_QUEUE_ID id, size_t maxLength)
+{
+    APP_UART_QUEUE *queue = &uartQueue[id];
+    uint32_t start = queue->head & APP_UART_QUEUE_MASK;
+    uint32_t contiguous = APP_UART_QUEUE_SIZE - start;
+
+    queue->reserveSkip = 0U;
+    if (contiguous < maxLength)
+    {
+        /* Not enough room before the end of the ring, start over at 0 */
+        queue->reserveSkip = contiguous;
+        start = 0U;
+    }
+    if ((queue->reserveSkip + maxLength) > APP_UART_QueueFreeGet(id))
+    {
+        queue->dropped++;
+        return NULL;
+    }
+    return &queue->buffer[start];
+}
+
+void APP_UART_QueueCommit(APP_UART_QUEUE_ID id, size_t length)
+{
+    APP_UART_QUEUE *queue = &uartQueue[id];
+    uint32_t head = queue->head + queue->reserveSkip;
+    uint32_t primask = 0U;
+
+    queue->reserveSkip = 0U;
+    if (length == 0U)
+    {
+        return;
+    }
+
+    primask = __get_PRIMASK();
+    __disable_irq();
+    APP_UART_SegmentAppend(queue, &queue->buffer[head & APP_UART_QUEUE_MASK], length, true, head + length);
+    queue->head = head + length;
+    APP_UART_QueueStart(queue);
+    __set_PRIMASK(primask);
+}
+
+size_t APP_UART_QueueFreeGet(APP_UART_QUEUE_ID id)
+{
+    APP_UART_QUEUE *queue = &uartQueue[id];
+
+    /* A copied write may wrap around the ring and need two segments */
+    if ((queue->segmentHead - queue->segmentTail) > (APP_UART_QUEUE_SEGMENTS - 2U))
+    {
+        return 0U;
+    }
+    return (APP_UART_QUEUE_SIZE - (queue->head - queue->tail));
+}
+
+uint32_t APP_UART_QueueDroppedGet(APP_UART_QUEUE_ID id)
+{
+    return uartQueue[id].dropped;
+}
+
+bool APP_UART_QueueIsBusy(APP_UART_QUEUE_ID id)
+{
+    return (uartQueue[id].segmentTail != uartQueue[id].segmentHead);
+}
+
+void APP_UART_QueueFlush(APP_UART_QUEUE_ID id)
+{
+    while (uartQueue[id].segmentTail != uartQueue[id].segmentHead)
+    {
+        ;
+    }
+}
+
+void APP_UART_QueueTransferHandler(APP_UART_QUEUE_ID id)
+{
+    APP_UART_QUEUE *queue = &uartQueue[id];
+    APP_UART_SEGMENT *segment = NULL;
+    uint32_t index = 0U;
+
+    /* The segments are released on error as well so that the queue cannot stall */
+    while (queue->segmentTail != queue->segmentStart)
+    {
+        segment = &queue->segment[queue->segmentTail & APP_UART_QUEUE_SEGMENT_MASK];
+        if (segment->inRing == true)
+        {
+            queue->tail = segment->ringEnd;
+        }
+        queue->segmentTail = queue->segmentTail + 1U;
+    }
+    uartDescriptorFree |= queue->descriptorMask;
+    queue->descriptorMask = 0U;
+
+    /* Restart this queue and any queue left waiting for descriptors */
+    for (index = 0U; index < APP_UART_QUEUE_COUNT; index++)
+    {
+        APP_UART_QueueStart(&uartQueue[index]);
+    }
+}
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: UART Receive Routines
+// *****************************************************************************
+// *****************************************************************************
+
+static void APP_UART_ReceiveRead(APP_UART_QUEUE_ID id)
+{
+    if (id == APP_UART_QUEUE_DEBUG)
+    {
+        (void)SERCOM5_USART_Read(&uartReceive[id].data, 1);
+    }
+    else
+    {
+        (void)SERCOM0_USART_Read(&uartReceive[id].data, 1);
+    }
+}
+
+void APP_UART_ReceiveStart(APP_UART_QUEUE_ID id)
+{
+    memset(&uartReceive[id], 0, sizeof(uartReceive[id]));
+    APP_UART_ReceiveRead(id);
+}
+
+void APP_UART_ReceiveHandler(APP_UART_QUEUE_ID id)
+{
+    APP_UART_RECEIVE *receive = &uartReceive[id];
+    USART_ERROR error = (id == APP_UART_QUEUE_DEBUG) ? SERCOM5_USART_ErrorGet() : SERCOM0_USART_ErrorGet();
+
+    if ((error != USART_ERROR_NONE) || ((receive->head - receive->tail) >= APP_UART_RECEIVE_SIZE))
+    {
+        receive->lost++;
+    }
+    else
+    {
+        receive->buffer[receive->head & APP_UART_RECEIVE_MASK] = receive->data;
+        receive->head = receive->head + 1U;
+    }
+    APP_UART_ReceiveRead(id);
+}
+
+bool APP_UART_ReceiveGet(APP_UART_QUEUE_ID id, uint8_t *data)
+{
+    APP_UART_RECEIVE *receive = &uartReceive[id];
+
+    if (receive->tail == receive->head)
+    {
+        return false;
+    }
+    *data = receive->buffer[receive->tail & APP_UART_RECEIVE_MASK];
+    receive->tail = receive->tail + 1U;
+    return true;
+}
+
+uint32_t APP_UART_ReceiveLostGet(APP_UART_QUEUE_ID id)
+{
+    return uartReceive[id].lost;
+}
+
+/*******************************************************************************
+ End of File
+*/
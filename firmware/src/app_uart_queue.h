@@ -0,0 +1,185 @@
+/*******************************************************************************
+  UART Transmit Queue Header File
+
+  Company:
+    Microchip Technology Inc.
+
+  File Name:
+    app_uart_queue.h
+
+  Summary:
+    Non-blocking UART transmit queue interface.
+
+  Description:
+    This file declares the queues which feed the debug (SERCOM5) and BLE
+    (SERCOM0) USART transmitters through DMAC channels 0 and 1, and the
+    buffers for the bytes received on the same links.
+*******************************************************************************/
+
+//DOM-IGNORE-BEGIN
+/*******************************************************************************
+* Copyright (C) 2024 Microchip Technology Inc. and its subsidiaries.
+*
+* Subject to your compliance with these terms, you may use Microchip software
+* and any derivatives exclusively with Microchip products. It is your
+* responsibility to comply with third party license terms applicable to your
+* use of third party software (including open source software) that may
+* accompany Microchip software.
+*
+* THIS SOFTWARE IS SUPPLIED BY MICROCHIP "AS IS". NO WARRANTIES, WHETHER
+* EXPRESS, IMPLIED OR STATUTORY, APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED
+* WARRANTIES OF NON-INFRINGEMENT, MERCHANTABILITY, AND FITNESS FOR A
+* PARTICULAR PURPOSE.
+*
+* IN NO EVENT WILL MICROCHIP BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE,
+* INCIDENTAL OR CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND
+* WHATSOEVER RELATED TO THE SOFTWARE, HOWEVER CAUSED, EVEN IF MICROCHIP HAS
+* BEEN ADVISED OF THE POSSIBILITY OR THE DAMAGES ARE FORESEEABLE. TO THE
+* FULLEST EXTENT ALLOWED BY LAW, MICROCHIP'S TOTAL LIABILITY ON ALL CLAIMS IN
+* ANY WAY RELATED TO THIS SOFTWARE WILL NOT EXCEED THE AMOUNT OF FEES, IF ANY,
+* THAT YOU HAVE PAID DIRECTLY TO MICROCHIP FOR THIS SOFTWARE.
+*******************************************************************************/
+//DOM-IGNORE-END
+
+
+
+#ifndef APP_UART_QUEUE_H
+#define APP_UART_QUEUE_H
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Included Files
+// *****************************************************************************
+// *****************************************************************************
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+#include "definitions.h"
+
+// DOM-IGNORE-BEGIN
+#ifdef __cplusplus  // Provide C++ Compatibility
+    extern "C" {
+#endif
+// DOM-IGNORE-END
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Data Types
+// *****************************************************************************
+// *****************************************************************************
+
+/* Bytes per queue, must be a power of two */
+#ifndef APP_UART_QUEUE_SIZE
+#define APP_UART_QUEUE_SIZE                     4096U
+#endif
+
+#if ((APP_UART_QUEUE_SIZE & (APP_UART_QUEUE_SIZE - 1U)) != 0U)
+#error "APP_UART_QUEUE_SIZE must be a power of two"
+#endif
+
+/* Pending segments per queue, must be a power of two */
+#ifndef APP_UART_QUEUE_SEGMENTS
+#define APP_UART_QUEUE_SEGMENTS                 32U
+#endif
+
+#if ((APP_UART_QUEUE_SEGMENTS & (APP_UART_QUEUE_SEGMENTS - 1U)) != 0U)
+#error "APP_UART_QUEUE_SEGMENTS must be a power of two"
+#endif
+
+/* Most segments sent in one linked list transfer */
+#ifndef APP_UART_QUEUE_CHAIN_LENGTH
+#define APP_UART_QUEUE_CHAIN_LENGTH             8U
+#endif
+
+/* DMAC descriptors shared by all queues */
+#ifndef APP_UART_DESCRIPTOR_POOL_SIZE
+#define APP_UART_DESCRIPTOR_POOL_SIZE           16U
+#endif
+
+#if (APP_UART_DESCRIPTOR_POOL_SIZE > 32U)
+#error "APP_UART_DESCRIPTOR_POOL_SIZE must not exceed 32"
+#endif
+
+/* Received bytes buffered per link, must be a power of two */
+#ifndef APP_UART_RECEIVE_SIZE
+#define APP_UART_RECEIVE_SIZE                   512U
+#endif
+
+#if ((APP_UART_RECEIVE_SIZE & (APP_UART_RECEIVE_SIZE - 1U)) != 0U)
+#error "APP_UART_RECEIVE_SIZE must be a power of two"
+#endif
+
+typedef enum
+{
+    /* SERCOM5 debug terminal, DMAC channel 0 */
+    APP_UART_QUEUE_DEBUG = 0,
+    /* SERCOM0 RNBD451 BLE module, DMAC channel 1 */
+    APP_UART_QUEUE_BLE = 1,
+    APP_UART_QUEUE_COUNT
+} APP_UART_QUEUE_ID;
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Interface Routines
+// *****************************************************************************
+// *****************************************************************************
+
+void APP_UART_QueueInitialize(void);
+
+/* Copies length bytes into the queue and starts the DMA if it is idle.
+   Returns false without queueing anything when there is not enough room.
+   Call from the main loop only. */
+bool APP_UART_QueueWrite(APP_UART_QUEUE_ID id, const void *data, size_t length);
+
+/* Queues a segment which is sent straight from data, without a copy.
+   data must stay unchanged until sent (e.g. string constants or flash). */
+bool APP_UART_QueueWriteReference(APP_UART_QUEUE_ID id, const void *data, size_t length);
+
+/* Returns a contiguous area of at least maxLength bytes in the queue's ring
+   for the caller to write into, or NULL when there is not enough room.
+   APP_UART_QueueCommit then queues the bytes actually written. */
+uint8_t *APP_UART_QueueReserve(APP_UART_QUEUE_ID id, size_t maxLength);
+void APP_UART_QueueCommit(APP_UART_QUEUE_ID id, size_t length);
+
+/* Bytes which APP_UART_QueueWrite can accept right now */
+size_t APP_UART_QueueFreeGet(APP_UART_QUEUE_ID id);
+
+/* Number of writes rejected because the queue was full */
+uint32_t APP_UART_QueueDroppedGet(APP_UART_QUEUE_ID id);
+
+/* True while queued data has not been sent completely */
+bool APP_UART_QueueIsBusy(APP_UART_QUEUE_ID id);
+
+/* Blocks until everything queued so far has been sent */
+void APP_UART_QueueFlush(APP_UART_QUEUE_ID id);
+
+/* Call from the DMAC channel callback on transfer complete or error */
+void APP_UART_QueueTransferHandler(APP_UART_QUEUE_ID id);
+
+/* Starts buffering the bytes received on the link, one interrupt driven
+   USART read at a time. Register a USART read callback which calls
+   APP_UART_ReceiveHandler first. */
+void APP_UART_ReceiveStart(APP_UART_QUEUE_ID id);
+
+/* Call from the USART read callback, stores the byte and reads the next */
+void APP_UART_ReceiveHandler(APP_UART_QUEUE_ID id);
+
+/* Takes the oldest received byte, false when there is none. Call from the
+   main loop only. */
+bool APP_UART_ReceiveGet(APP_UART_QUEUE_ID id, uint8_t *data);
+
+/* Bytes lost to a full buffer or a USART error */
+uint32_t APP_UART_ReceiveLostGet(APP_UART_QUEUE_ID id);
+
+// DOM-IGNORE-BEGIN
+#ifdef __cplusplus  // Provide C++ Compatibility
+    }
+#endif
+// DOM-IGNORE-END
+
+#endif // APP_UART_QUEUE_H
+
+/*******************************************************************************
+ End of File
+*/
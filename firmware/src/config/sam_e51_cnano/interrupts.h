@@ -67,6 +67,8 @@ void DMAC_1_InterruptHandler (void);
 void SERCOM0_USART_InterruptHandler (void);
 void SERCOM5_USART_InterruptHandler (void);
 void CAN1_InterruptHandler (void);
+void TC0_TimerInterruptHandler (void);
+void TC1_TimerInterruptHandler (void);
 
 
 
@@ -66,6 +66,31 @@ static CAN_TXRX_BUFFERS_CALLBACK_OBJ can1RxBufferCallbackObj;
 static CAN_RX_FIFO_CALLBACK_OBJ can1RxFifoCallbackObj[2];
 static CAN_OBJ can1Obj;
 
+/* Tx events collected by the interrupt handler, read by CAN1_TxEventGet */
+static CAN_TX_EVENT can1TxEventRing[CAN1_TX_EVENT_RING_ELEMENTS];
+static volatile uint32_t can1TxEventHead = 0U;
+static volatile uint32_t can1TxEventTail = 0U;
+/* Extended timestamp of the last transmission request per message marker */
+static uint32_t can1TxQueued[256];
+
+/* Bit timing generated for CAN1, its nominal bit time is the unit of the
+   extended timestamps whatever bit timing is set later */
+#define CAN1_NBTP_INIT        (CAN_NBTP_NTSEG2(4UL) | CAN_NBTP_NTSEG1(13UL) | CAN_NBTP_NBRP(5UL) | CAN_NBTP_NSJW(3UL))
+#define CAN1_DBTP_INIT        (CAN_DBTP_DTSEG2(7UL) | CAN_DBTP_DTSEG1(20UL) | CAN_DBTP_DBRP(0UL) | CAN_DBTP_DSJW(6UL))
+#define CAN1_TIMESTAMP_CLOCKS (6UL * (1UL + 14UL + 5UL))
+
+/* Bit timing and timestamp configuration applied by CAN1_Initialize */
+static uint32_t can1Nbtp = CAN1_NBTP_INIT;
+static uint32_t can1Dbtp = CAN1_DBTP_INIT;
+static uint32_t can1Tscc = CAN_TSCC_TCP(0UL) | CAN_TSCC_TSS_INC;
+/* Timestamp counter ticks to extended timestamp ticks */
+static uint32_t can1TimestampScale = 1U;
+static bool can1Initialized = false;
+/* Bus monitoring and restricted operation bits of CCCR, applied whenever
+   the controller is configured */
+#define CAN1_CCCR_MODE_Msk    (CAN_CCCR_MON_Msk | CAN_CCCR_ASM_Msk)
+static uint32_t can1Mode = 0U;
+
 static const can_sidfe_registers_t can1StdFilter[] =
 {
     {
@@ -117,11 +142,14 @@ void CAN1_Initialize(void)
     /* Set CCE to unlock the configuration registers */
     CAN1_REGS->CAN_CCCR |= CAN_CCCR_CCE_Msk;
 
+    /* Bus monitoring and restricted operation, see CAN1_BusMonitoringSet */
+    CAN1_REGS->CAN_CCCR |= can1Mode;
+
     /* Set Data Bit Timing and Prescaler Register */
-    CAN1_REGS->CAN_DBTP = CAN_DBTP_DTSEG2(7UL) | CAN_DBTP_DTSEG1(20UL) | CAN_DBTP_DBRP(0UL) | CAN_DBTP_DSJW(6UL);
+    CAN1_REGS->CAN_DBTP = can1Dbtp;
 
     /* Set Nominal Bit timing and Prescaler Register */
-    CAN1_REGS->CAN_NBTP  = CAN_NBTP_NTSEG2(4UL) | CAN_NBTP_NTSEG1(13UL) | CAN_NBTP_NBRP(5UL) | CAN_NBTP_NSJW(3UL);
+    CAN1_REGS->CAN_NBTP  = can1Nbtp;
 
     /* Receive Buffer / FIFO Element Size Configuration Register */
     CAN1_REGS->CAN_RXESC = 0UL  | CAN_RXESC_F0DS(7UL) | CAN_RXESC_F1DS(7UL) | CAN_RXESC_RBDS(7UL);
@@ -140,7 +168,7 @@ void CAN1_Initialize(void)
     CAN1_REGS->CAN_XIDAM = CAN_XIDAM_Msk;
 
     /* Timestamp Counter Configuration Register */
-    CAN1_REGS->CAN_TSCC = CAN_TSCC_TCP(0UL) | CAN_TSCC_TSS_INC;
+    CAN1_REGS->CAN_TSCC = can1Tscc;
 
     /* Set the operation mode */
     CAN1_REGS->CAN_CCCR = (CAN1_REGS->CAN_CCCR & ~CAN_CCCR_INIT_Msk) | CAN_CCCR_FDOE_Msk | CAN_CCCR_BRSE_Msk;
@@ -156,9 +184,123 @@ void CAN1_Initialize(void)
     CAN1_REGS->CAN_ILE = CAN_ILE_EINT0_Msk;
 
     /* Enable CAN interrupts */
-    CAN1_REGS->CAN_IE = CAN_IE_BOE_Msk | CAN_IE_TFEE_Msk | CAN_IE_TEFNE_Msk | CAN_IE_RF0NE_Msk | CAN_IE_RF1NE_Msk | CAN_IE_DRXE_Msk;
+    CAN1_REGS->CAN_IE = CAN_IE_BOE_Msk | CAN_IE_TFEE_Msk | CAN_IE_TEFNE_Msk | CAN_IE_RF0NE_Msk | CAN_IE_RF1NE_Msk | CAN_IE_DRXE_Msk
+                      | CAN_IE_RF0LE_Msk | CAN_IE_RF1LE_Msk | CAN_IE_TSWE_Msk | CAN_IE_TEFLE_Msk | CAN_IE_PEAE_Msk
+                      | CAN_IE_PEDE_Msk;
+#if (CAN1_RX_FIFO0_WATERMARK != 0U)
+    CAN1_REGS->CAN_IE |= CAN_IE_RF0WE_Msk;
+#endif
+#if (CAN1_RX_FIFO1_WATERMARK != 0U)
+    CAN1_REGS->CAN_IE |= CAN_IE_RF1WE_Msk;
+#endif
+
+    memset(&can1Obj, 0x00, sizeof(CAN_OBJ));
+    can1TxEventHead = 0U;
+    can1TxEventTail = 0U;
+    can1Initialized = true;
+}
+
+// *****************************************************************************
+/* Function:
+    bool CAN1_BitTimingSet(const CAN_BIT_TIMING *bitTiming)
 
-    memset(&can1Obj.msgRAMConfig, 0x00, sizeof(CAN_MSG_RAM_CONFIG));
+   Summary:
+    Sets the nominal and/or data bit timing.
+
+   Precondition:
+    None.
+
+   Parameters:
+    bitTiming - Register field values of the bit timing to set
+
+   Returns:
+    true  - Bit timing set.
+    false - A field is out of range, nothing is changed.
+
+   Remarks:
+    Called before CAN1_Initialize, the bit timing is only recorded and
+    CAN1_Initialize starts the controller with it. Called afterwards, the
+    controller is stopped for the change, keeping the operation mode set in
+    CCCR, and messages in transfer are lost.
+
+    The timestamp counter prescaler is adapted so that extended timestamps
+    (CAN1_RxTimestampExtend) keep the unit of the generated nominal bit time.
+    Timestamps taken before and after the change are not comparable.
+*/
+bool CAN1_BitTimingSet(const CAN_BIT_TIMING *bitTiming)
+{
+    const CAN_NOMINAL_BIT_TIMING *nominal = &bitTiming->nominalBitTiming;
+    const CAN_DATA_BIT_TIMING *data = &bitTiming->dataBitTiming;
+    uint32_t nbtp = can1Nbtp;
+    uint32_t dbtp = can1Dbtp;
+    uint32_t clocks = 0U;
+    uint32_t prescaler = 1U;
+    uint32_t scale = 1U;
+    uint32_t cccr = 0U;
+
+    if (bitTiming->nominalBitTimingSet == true)
+    {
+        if ((nominal->nominalBaudRatePrescaler > 0x1FFU) || (nominal->nominalTimeSegment2 > 0x7FU) ||
+            (nominal->nominalSJW > 0x7FU))
+        {
+            return false;
+        }
+        nbtp = CAN_NBTP_NBRP((uint32_t)nominal->nominalBaudRatePrescaler) | CAN_NBTP_NTSEG1((uint32_t)nominal->nominalTimeSegment1) |
+               CAN_NBTP_NTSEG2((uint32_t)nominal->nominalTimeSegment2) | CAN_NBTP_NSJW((uint32_t)nominal->nominalSJW);
+    }
+    if (bitTiming->dataBitTimingSet == true)
+    {
+        if ((data->dataBaudRatePrescaler > 0x1FU) || (data->dataTimeSegment1 > 0x1FU) ||
+            (data->dataTimeSegment2 > 0xFU) || (data->dataSJW > 0xFU))
+        {
+            return false;
+        }
+        dbtp = CAN_DBTP_DBRP((uint32_t)data->dataBaudRatePrescaler) | CAN_DBTP_DTSEG1((uint32_t)data->dataTimeSegment1) |
+               CAN_DBTP_DTSEG2((uint32_t)data->dataTimeSegment2) | CAN_DBTP_DSJW((uint32_t)data->dataSJW);
+    }
+
+    /* CAN clocks per nominal bit */
+    clocks = (((nbtp & CAN_NBTP_NBRP_Msk) >> CAN_NBTP_NBRP_Pos) + 1U) *
+             (((nbtp & CAN_NBTP_NTSEG1_Msk) >> CAN_NBTP_NTSEG1_Pos) + ((nbtp & CAN_NBTP_NTSEG2_Msk) >> CAN_NBTP_NTSEG2_Pos) + 3U);
+    if (clocks < CAN1_TIMESTAMP_CLOCKS)
+    {
+        /* Count every few bits, the prescaler is at most 16 */
+        prescaler = (CAN1_TIMESTAMP_CLOCKS + (clocks / 2U)) / clocks;
+        prescaler = (prescaler > 16U) ? 16U : prescaler;
+    }
+    else
+    {
+        scale = (clocks + (CAN1_TIMESTAMP_CLOCKS / 2U)) / CAN1_TIMESTAMP_CLOCKS;
+    }
+
+    can1Nbtp = nbtp;
+    can1Dbtp = dbtp;
+    can1Tscc = CAN_TSCC_TCP(prescaler - 1U) | CAN_TSCC_TSS_INC;
+
+    if (can1Initialized == true)
+    {
+        cccr = CAN1_REGS->CAN_CCCR & ~(CAN_CCCR_INIT_Msk | CAN_CCCR_CCE_Msk);
+
+        CAN1_REGS->CAN_CCCR |= CAN_CCCR_INIT_Msk;
+        while ((CAN1_REGS->CAN_CCCR & CAN_CCCR_INIT_Msk) != CAN_CCCR_INIT_Msk)
+        {
+            /* Wait for initialization complete */
+        }
+        CAN1_REGS->CAN_CCCR |= CAN_CCCR_CCE_Msk;
+
+        CAN1_REGS->CAN_DBTP = can1Dbtp;
+        CAN1_REGS->CAN_NBTP = can1Nbtp;
+        CAN1_REGS->CAN_TSCC = can1Tscc;
+
+        CAN1_REGS->CAN_CCCR = cccr;
+        while ((CAN1_REGS->CAN_CCCR & CAN_CCCR_INIT_Msk) == CAN_CCCR_INIT_Msk)
+        {
+            /* Wait for initialization complete */
+        }
+    }
+    can1TimestampScale = scale;
+
+    return true;
 }
 
 
@@ -173,48 +315,102 @@ void CAN1_Initialize(void)
     CAN1_Initialize must have been called for the associated CAN instance.
 
    Parameters:
-    numberOfMessage - Total number of message.
+    numberOfMessage - Total number of message, 1 to CAN1_TX_FIFO_BUFFER_ELEMENTS.
     txBuffer        - Pointer to Tx buffer
 
    Returns:
     Request status.
     true  - Request was successful.
-    false - Request has failed.
+    false - Request has failed, nothing was queued because the Tx FIFO
+            has fewer free elements than numberOfMessage.
 */
 bool CAN1_MessageTransmitFifo(uint8_t numberOfMessage, CAN_TX_BUFFER *txBuffer)
+{
+    if (((numberOfMessage < 1U) || (numberOfMessage > CAN1_TX_FIFO_BUFFER_ELEMENTS)) || (txBuffer == NULL))
+    {
+        return false;
+    }
+    if (numberOfMessage > CAN1_TxFifoFreeLevelGet())
+    {
+        return false;
+    }
+
+    return (CAN1_MessageTransmitFifoBatch(numberOfMessage, txBuffer) == numberOfMessage);
+}
+
+// *****************************************************************************
+/* Function:
+    uint8_t CAN1_MessageTransmitFifoBatch(uint8_t numberOfMessage, CAN_TX_BUFFER *txBuffer)
+
+   Summary:
+    Transmit as many of the given messages as the Tx FIFO has room for.
+
+   Precondition:
+    CAN1_Initialize must have been called for the associated CAN instance.
+
+   Parameters:
+    numberOfMessage - Number of messages in txBuffer.
+    txBuffer        - Pointer to consecutive Tx buffer elements
+
+   Returns:
+    Number of messages queued, the first ones of txBuffer. 0 when the Tx FIFO
+    is full.
+
+   Remarks:
+    All accepted elements are requested with a single TXBAR write, so they
+    are transmitted back to back in FIFO order. Every message stores a Tx
+    event (efc is set) and the time of the request is kept per message marker
+    (mm) for CAN1_TxEventGet, so markers of messages pending at the same time
+    should differ. Call from the CAN1 interrupt context, an interrupt of the
+    same priority, or with interrupts disabled.
+*/
+uint8_t CAN1_MessageTransmitFifoBatch(uint8_t numberOfMessage, CAN_TX_BUFFER *txBuffer)
 {
     uint8_t  *txFifo = NULL;
     uint8_t  *txBuf = (uint8_t *)txBuffer;
     uint32_t bufferNumber = 0U;
+    uint32_t txfqs = 0U;
+    uint32_t now = 0U;
     uint8_t  tfqpi = 0U;
     uint8_t  count = 0U;
 
-    if (((numberOfMessage < 1U) || (numberOfMessage > 1U)) || (txBuffer == NULL))
+    if (txBuffer == NULL)
     {
-        return false;
+        return 0U;
     }
+    now = CAN1_RxTimestampExtend((uint16_t)CAN1_REGS->CAN_TSCV);
 
-    tfqpi = (uint8_t)((CAN1_REGS->CAN_TXFQS & CAN_TXFQS_TFQPI_Msk) >> CAN_TXFQS_TFQPI_Pos);
+    txfqs = CAN1_REGS->CAN_TXFQS;
+    if (numberOfMessage > (uint8_t)(txfqs & CAN_TXFQS_TFFL_Msk))
+    {
+        numberOfMessage = (uint8_t)(txfqs & CAN_TXFQS_TFFL_Msk);
+    }
+    tfqpi = (uint8_t)((txfqs & CAN_TXFQS_TFQPI_Msk) >> CAN_TXFQS_TFQPI_Pos);
 
     for (count = 0; count < numberOfMessage; count++)
     {
         txFifo = (uint8_t *)((uint8_t*)can1Obj.msgRAMConfig.txBuffersAddress + ((uint32_t)tfqpi * CAN1_TX_FIFO_BUFFER_ELEMENT_SIZE));
 
         memcpy(txFifo, txBuf, CAN1_TX_FIFO_BUFFER_ELEMENT_SIZE);
+        ((CAN_TX_BUFFER *)txFifo)->efc = 1U;
+        can1TxQueued[txBuffer[count].mm] = now;
 
         txBuf += CAN1_TX_FIFO_BUFFER_ELEMENT_SIZE;
         bufferNumber |= (1UL << tfqpi);
         tfqpi++;
-        if (tfqpi == 1U)
+        if (tfqpi == CAN1_TX_FIFO_BUFFER_ELEMENTS)
         {
             tfqpi = 0U;
         }
     }
 
     /* Set Transmission request */
-    CAN1_REGS->CAN_TXBAR = bufferNumber;
+    if (bufferNumber != 0U)
+    {
+        CAN1_REGS->CAN_TXBAR = bufferNumber;
+    }
 
-    return true;
+    return numberOfMessage;
 }
 
 // *****************************************************************************
@@ -260,6 +456,58 @@ bool CAN1_TxBufferIsBusy(uint8_t bufferNumber)
     return ((CAN1_REGS->CAN_TXBRP & (1UL << bufferNumber)) != 0U);
 }
 
+// *****************************************************************************
+/* Function:
+    uint8_t CAN1_TxFifoCancel(uint8_t messageMarker, uint8_t messageMarkerMask)
+
+   Summary:
+    Cancels the pending Tx FIFO requests of the messages with a marker.
+
+   Precondition:
+    CAN1_Initialize must have been called for the associated CAN instance.
+
+   Parameters:
+    messageMarker     - Message marker (mm) bits of the messages to cancel
+    messageMarkerMask - Message marker bits to compare
+
+   Returns:
+    Number of transmission requests cancelled.
+
+   Remarks:
+    The other messages stay queued in their order. A message already being
+    transmitted completes. Call from the CAN1 interrupt context, an interrupt
+    of the same priority, or with interrupts disabled, so no element is
+    queued again while the Message RAM is read.
+*/
+uint8_t CAN1_TxFifoCancel(uint8_t messageMarker, uint8_t messageMarkerMask)
+{
+    const CAN_TX_BUFFER *txFifo = NULL;
+    uint32_t pending = CAN1_REGS->CAN_TXBRP;
+    uint32_t bufferNumber = 0U;
+    uint32_t cancel = 0U;
+    uint8_t  count = 0U;
+
+    for (bufferNumber = 0U; bufferNumber < CAN1_TX_FIFO_BUFFER_ELEMENTS; bufferNumber++)
+    {
+        if ((pending & (1UL << bufferNumber)) == 0U)
+        {
+            continue;
+        }
+        txFifo = (const CAN_TX_BUFFER *)((uint8_t*)can1Obj.msgRAMConfig.txBuffersAddress + (bufferNumber * CAN1_TX_FIFO_BUFFER_ELEMENT_SIZE));
+        if ((txFifo->mm & messageMarkerMask) == (messageMarker & messageMarkerMask))
+        {
+            cancel |= (1UL << bufferNumber);
+            count++;
+        }
+    }
+
+    if (cancel != 0U)
+    {
+        CAN1_REGS->CAN_TXBCR = cancel;
+    }
+    return count;
+}
+
 // *****************************************************************************
 /* Function:
     bool CAN1_TxEventFifoRead(uint8_t numberOfTxEvent, CAN_TX_EVENT_FIFO *txEventFifo)
@@ -278,6 +526,10 @@ bool CAN1_TxBufferIsBusy(uint8_t bufferNumber)
     Request status.
     true  - Request was successful.
     false - Request has failed.
+
+   Remarks:
+    The interrupt handler empties the Tx Event FIFO into the Tx event ring,
+    use CAN1_TxEventGet instead while the CAN1 interrupt is enabled.
 */
 bool CAN1_TxEventFifoRead(uint8_t numberOfTxEvent, CAN_TX_EVENT_FIFO *txEventFifo)
 {
@@ -286,12 +538,12 @@ bool CAN1_TxEventFifoRead(uint8_t numberOfTxEvent, CAN_TX_EVENT_FIFO *txEventFif
     uint8_t *txEvent   = NULL;
     uint8_t *txEvtFifo = (uint8_t *)txEventFifo;
 
-    if (txEventFifo == NULL)
+    if ((txEventFifo == NULL) || (numberOfTxEvent == 0U))
     {
         return false;
     }
 
-    /* Read data from the Rx FIFO0 */
+    /* Read data from the Tx Event FIFO */
     txefgi = (uint8_t)((CAN1_REGS->CAN_TXEFS & CAN_TXEFS_EFGI_Msk) >> CAN_TXEFS_EFGI_Pos);
     for (count = 0; count < numberOfTxEvent; count++)
     {
@@ -305,7 +557,7 @@ bool CAN1_TxEventFifoRead(uint8_t numberOfTxEvent, CAN_TX_EVENT_FIFO *txEventFif
         }
         txEvtFifo += sizeof(CAN_TX_EVENT_FIFO);
         txefgi++;
-        if (txefgi == 1U)
+        if (txefgi == CAN1_TX_EVENT_FIFO_ELEMENTS)
         {
             txefgi = 0U;
         }
@@ -317,6 +569,106 @@ bool CAN1_TxEventFifoRead(uint8_t numberOfTxEvent, CAN_TX_EVENT_FIFO *txEventFif
     return true;
 }
 
+/* Moves the Tx Event FIFO elements into the Tx event ring, extending the Tx
+   timestamps. Returns the number of events added. CAN1 interrupt context. */
+static uint8_t CAN1_TxEventCollect(void)
+{
+    const CAN_TX_EVENT_FIFO *txEventFifo = NULL;
+    CAN_TX_EVENT *txEvent = NULL;
+    uint32_t txefs = CAN1_REGS->CAN_TXEFS;
+    uint8_t numberOfTxEvent = (uint8_t)(txefs & CAN_TXEFS_EFFL_Msk);
+    uint8_t txefgi = (uint8_t)((txefs & CAN_TXEFS_EFGI_Msk) >> CAN_TXEFS_EFGI_Pos);
+    uint8_t added = 0U;
+    uint8_t count = 0U;
+
+    for (count = 0U; count < numberOfTxEvent; count++)
+    {
+        txEventFifo = (const CAN_TX_EVENT_FIFO *)((uint8_t *)can1Obj.msgRAMConfig.txEventFIFOAddress + ((uint32_t)txefgi * CAN1_TX_EVENT_FIFO_ELEMENT_SIZE));
+
+        if ((can1TxEventHead - can1TxEventTail) >= CAN1_TX_EVENT_RING_ELEMENTS)
+        {
+            can1Obj.txEventLostCount++;
+        }
+        else
+        {
+            txEvent = &can1TxEventRing[can1TxEventHead & (CAN1_TX_EVENT_RING_ELEMENTS - 1U)];
+            memcpy(&txEvent->element, txEventFifo, sizeof(CAN_TX_EVENT_FIFO));
+            txEvent->timestamp = CAN1_RxTimestampExtend((uint16_t)txEvent->element.txts);
+            txEvent->queued = can1TxQueued[txEvent->element.mm];
+            can1TxEventHead++;
+            added++;
+        }
+
+        if ((count + 1U) == numberOfTxEvent)
+        {
+            /* Ack the last element read */
+            CAN1_REGS->CAN_TXEFA = CAN_TXEFA_EFAI((uint32_t)txefgi);
+            break;
+        }
+        txefgi++;
+        if (txefgi == CAN1_TX_EVENT_FIFO_ELEMENTS)
+        {
+            txefgi = 0U;
+        }
+    }
+    return added;
+}
+
+// *****************************************************************************
+/* Function:
+    bool CAN1_TxEventGet(CAN_TX_EVENT *txEvent)
+
+   Summary:
+    Reads the oldest Tx event collected by the interrupt handler.
+
+   Precondition:
+    CAN1_Initialize must have been called for the associated CAN instance.
+
+   Parameters:
+    txEvent - Pointer to the Tx event to fill
+
+   Returns:
+    true  - An event was read.
+    false - No event is pending.
+
+   Remarks:
+    Events are collected in transmission order. The queued timestamp is the
+    last request of a message with the same marker (mm). Call from a single
+    context, e.g. the main loop.
+*/
+bool CAN1_TxEventGet(CAN_TX_EVENT *txEvent)
+{
+    if ((txEvent == NULL) || (can1TxEventTail == can1TxEventHead))
+    {
+        return false;
+    }
+    *txEvent = can1TxEventRing[can1TxEventTail & (CAN1_TX_EVENT_RING_ELEMENTS - 1U)];
+    can1TxEventTail++;
+    return true;
+}
+
+// *****************************************************************************
+/* Function:
+    uint32_t CAN1_TxEventLostCountGet(void)
+
+   Summary:
+    Returns the number of Tx events discarded.
+
+   Precondition:
+    CAN1_Initialize must have been called for the associated CAN instance.
+
+   Parameters:
+    None.
+
+   Returns:
+    Number of Tx events lost because the Tx Event FIFO or the Tx event ring
+    was full, since initialization.
+*/
+uint32_t CAN1_TxEventLostCountGet(void)
+{
+    return can1Obj.txEventLostCount;
+}
+
 // *****************************************************************************
 /* Function:
     bool CAN1_MessageReceive(uint8_t bufferNumber, CAN_RX_BUFFER *rxBuffer)
@@ -390,7 +742,7 @@ bool CAN1_MessageReceiveFifo(CAN_RX_FIFO_NUM rxFifoNum, uint8_t numberOfMessage,
     uint8_t *rxBuf = (uint8_t *)rxBuffer;
     bool status = false;
 
-    if (rxBuffer == NULL)
+    if ((rxBuffer == NULL) || (numberOfMessage == 0U))
     {
         return status;
     }
@@ -412,7 +764,7 @@ bool CAN1_MessageReceiveFifo(CAN_RX_FIFO_NUM rxFifoNum, uint8_t numberOfMessage,
                 }
                 rxBuf += CAN1_RX_FIFO0_ELEMENT_SIZE;
                 rxgi++;
-                if (rxgi == 1U)
+                if (rxgi == CAN1_RX_FIFO0_ELEMENTS)
                 {
                     rxgi = 0U;
                 }
@@ -438,7 +790,7 @@ bool CAN1_MessageReceiveFifo(CAN_RX_FIFO_NUM rxFifoNum, uint8_t numberOfMessage,
                 }
                 rxBuf += CAN1_RX_FIFO1_ELEMENT_SIZE;
                 rxgi++;
-                if (rxgi == 1U)
+                if (rxgi == CAN1_RX_FIFO1_ELEMENTS)
                 {
                     rxgi = 0U;
                 }
@@ -455,6 +807,117 @@ bool CAN1_MessageReceiveFifo(CAN_RX_FIFO_NUM rxFifoNum, uint8_t numberOfMessage,
     return status;
 }
 
+// *****************************************************************************
+/* Function:
+    uint8_t CAN1_RxFifoFillLevelGet(CAN_RX_FIFO_NUM rxFifoNum)
+
+   Summary:
+    Returns Rx FIFO0/FIFO1 Fill Level.
+
+   Precondition:
+    CAN1_Initialize must have been called for the associated CAN instance.
+
+   Parameters:
+    rxFifoNum - Rx FIFO number
+
+   Returns:
+    Number of elements stored in the Rx FIFO.
+*/
+uint8_t CAN1_RxFifoFillLevelGet(CAN_RX_FIFO_NUM rxFifoNum)
+{
+    uint8_t fillLevel = 0U;
+
+    if (rxFifoNum == CAN_RX_FIFO_0)
+    {
+        fillLevel = (uint8_t)(CAN1_REGS->CAN_RXF0S & CAN_RXF0S_F0FL_Msk);
+    }
+    else if (rxFifoNum == CAN_RX_FIFO_1)
+    {
+        fillLevel = (uint8_t)(CAN1_REGS->CAN_RXF1S & CAN_RXF1S_F1FL_Msk);
+    }
+    else
+    {
+        /* Do nothing */
+    }
+    return fillLevel;
+}
+
+// *****************************************************************************
+/* Function:
+    uint32_t CAN1_RxFifoLostCountGet(CAN_RX_FIFO_NUM rxFifoNum)
+
+   Summary:
+    Returns the number of messages discarded because the Rx FIFO was full.
+
+   Precondition:
+    CAN1_Initialize must have been called for the associated CAN instance.
+
+   Parameters:
+    rxFifoNum - Rx FIFO number
+
+   Returns:
+    Number of Rx FIFO message lost events since initialization.
+*/
+uint32_t CAN1_RxFifoLostCountGet(CAN_RX_FIFO_NUM rxFifoNum)
+{
+    if (rxFifoNum > CAN_RX_FIFO_1)
+    {
+        return 0U;
+    }
+    return can1Obj.rxFifoLostCount[rxFifoNum];
+}
+
+// *****************************************************************************
+/* Function:
+    uint32_t CAN1_RxTimestampExtend(uint16_t rxts)
+
+   Summary:
+    Extends a 16-bit Rx/Tx timestamp to 32 bits using the timestamp
+    wraparound count.
+
+   Precondition:
+    CAN1_Initialize must have been called for the associated CAN instance.
+
+   Parameters:
+    rxts - Rx Timestamp (rxts) or Tx Timestamp (txts) of a Message RAM element
+
+   Returns:
+    32-bit timestamp in nominal bit times of the generated bit timing
+    (see CAN1_BitTimingSet).
+
+   Remarks:
+    Must be called from the CAN1 interrupt context, or with the CAN1
+    interrupt disabled, before the timestamp counter wraps twice.
+*/
+uint32_t CAN1_RxTimestampExtend(uint16_t rxts)
+{
+    uint32_t wrapCount = 0U;
+    uint16_t tscv = 0U;
+
+    /* Counter first: a wraparound after this read is not counted yet, one
+       before it is flagged by TSW below */
+    tscv = (uint16_t)(CAN1_REGS->CAN_TSCV & CAN_TSCV_TSC_Msk);
+
+    /* Account for a wraparound which is not yet serviced by the interrupt
+       handler, the counter is read again as it may have wrapped after the
+       read above */
+    if ((CAN1_REGS->CAN_IR & CAN_IR_TSW_Msk) != 0U)
+    {
+        CAN1_REGS->CAN_IR = CAN_IR_TSW_Msk;
+        can1Obj.timestampWrapCount++;
+        tscv = (uint16_t)(CAN1_REGS->CAN_TSCV & CAN_TSCV_TSC_Msk);
+    }
+    wrapCount = can1Obj.timestampWrapCount;
+
+    /* Element was time stamped before the last wraparound */
+    if (rxts > tscv)
+    {
+        wrapCount--;
+    }
+
+    return ((wrapCount << 16U) | (uint32_t)rxts) * can1TimestampScale;
+}
+
 // *****************************************************************************
 /* Function:
     CAN_ERROR CAN1_ErrorGet(void)
@@ -515,6 +978,169 @@ void CAN1_ErrorCountGet(uint8_t *txErrorCount, uint8_t *rxErrorCount)
     *rxErrorCount = (uint8_t)((CAN1_REGS->CAN_ECR & CAN_ECR_REC_Msk) >> CAN_ECR_REC_Pos);
 }
 
+// *****************************************************************************
+/* Function:
+    void CAN1_ProtocolErrorCountGet(uint32_t *nominalErrorCount, uint32_t *dataErrorCount)
+
+   Summary:
+    Returns the number of protocol errors detected since initialization.
+
+   Precondition:
+    CAN1_Initialize must have been called for the associated CAN instance.
+
+   Parameters:
+    nominalErrorCount - Errors in the arbitration phase (PSR.LEC), nominal bit rate
+    dataErrorCount    - Errors in the data phase of CAN FD frames with bit rate
+                        switching (PSR.DLEC)
+
+   Returns:
+    None.
+
+   Remarks:
+    The counters are incremented by the interrupt handler on IR.PEA and
+    IR.PED, which are set whenever LEC or DLEC records an error. Errors
+    following each other before the interrupt is served count once.
+*/
+void CAN1_ProtocolErrorCountGet(uint32_t *nominalErrorCount, uint32_t *dataErrorCount)
+{
+    *nominalErrorCount = can1Obj.nominalErrorCount;
+    *dataErrorCount = can1Obj.dataErrorCount;
+}
+
+/* Stops the controller, sets the recorded CCCR mode bits and restarts it */
+static void CAN1_ModeApply(void)
+{
+    uint32_t cccr = CAN1_REGS->CAN_CCCR & ~(CAN_CCCR_INIT_Msk | CAN_CCCR_CCE_Msk | CAN1_CCCR_MODE_Msk);
+
+    CAN1_REGS->CAN_CCCR |= CAN_CCCR_INIT_Msk;
+    while ((CAN1_REGS->CAN_CCCR & CAN_CCCR_INIT_Msk) != CAN_CCCR_INIT_Msk)
+    {
+        /* Wait for initialization complete */
+    }
+    CAN1_REGS->CAN_CCCR |= CAN_CCCR_CCE_Msk;
+    CAN1_REGS->CAN_CCCR = cccr | can1Mode | CAN_CCCR_INIT_Msk | CAN_CCCR_CCE_Msk;
+
+    CAN1_REGS->CAN_CCCR = cccr | can1Mode;
+    while ((CAN1_REGS->CAN_CCCR & CAN_CCCR_INIT_Msk) == CAN_CCCR_INIT_Msk)
+    {
+        /* Wait for initialization complete */
+    }
+}
+
+// *****************************************************************************
+/* Function:
+    void CAN1_BusMonitoringSet(bool enable)
+
+   Summary:
+    Enters or leaves bus monitoring mode.
+
+   Precondition:
+    None.
+
+   Parameters:
+    enable - true to receive without sending any dominant bit, false for
+             normal operation
+
+   Returns:
+    None.
+
+   Remarks:
+    In bus monitoring mode (CCCR.MON) frames are received but neither
+    acknowledged nor answered with error frames, and transmit requests wait
+    until the mode is left.
+
+    Called before CAN1_Initialize, the mode is only recorded and the
+    controller starts in it. Called afterwards, the controller is stopped
+    for the change and messages in transfer are lost, the Message RAM
+    configuration is kept. CAN1_MessageRAMConfigSet keeps the mode as well.
+*/
+void CAN1_BusMonitoringSet(bool enable)
+{
+    can1Mode = (enable == true) ? (can1Mode | CAN_CCCR_MON_Msk) : (can1Mode & ~CAN_CCCR_MON_Msk);
+    if (can1Initialized == true)
+    {
+        CAN1_ModeApply();
+    }
+}
+
+// *****************************************************************************
+/* Function:
+    bool CAN1_BusMonitoringGet(void)
+
+   Summary:
+    Returns whether the controller is in bus monitoring mode.
+
+   Precondition:
+    None.
+
+   Parameters:
+    None.
+
+   Returns:
+    true  - Bus monitoring mode, see CAN1_BusMonitoringSet.
+    false - Normal operation.
+*/
+bool CAN1_BusMonitoringGet(void)
+{
+    return ((can1Mode & CAN_CCCR_MON_Msk) != 0U);
+}
+
+// *****************************************************************************
+/* Function:
+    void CAN1_RestrictedOperationSet(bool enable)
+
+   Summary:
+    Enters or leaves restricted operation mode.
+
+   Precondition:
+    None.
+
+   Parameters:
+    enable - true to receive and acknowledge frames without sending frames
+             or error frames, false for normal operation
+
+   Returns:
+    None.
+
+   Remarks:
+    In restricted operation mode (CCCR.ASM) valid frames are received and
+    acknowledged, but no data, remote, error or overload frames are sent and
+    transmit requests wait until the mode is left. Errors do not change the
+    error counters. The mode is recorded and applied as for
+    CAN1_BusMonitoringSet, both may be set together, and the controller
+    also enters it by itself when a Message RAM access failed (IR.MRAF).
+*/
+void CAN1_RestrictedOperationSet(bool enable)
+{
+    can1Mode = (enable == true) ? (can1Mode | CAN_CCCR_ASM_Msk) : (can1Mode & ~CAN_CCCR_ASM_Msk);
+    if (can1Initialized == true)
+    {
+        CAN1_ModeApply();
+    }
+}
+
+// *****************************************************************************
+/* Function:
+    bool CAN1_RestrictedOperationGet(void)
+
+   Summary:
+    Returns whether restricted operation mode was set.
+
+   Precondition:
+    None.
+
+   Parameters:
+    None.
+
+   Returns:
+    true  - Restricted operation mode, see CAN1_RestrictedOperationSet.
+    false - Normal operation.
+*/
+bool CAN1_RestrictedOperationGet(void)
+{
+    return ((can1Mode & CAN_CCCR_ASM_Msk) != 0U);
+}
+
 // *****************************************************************************
 /* Function:
     void CAN1_MessageRAMConfigSet(uint8_t *msgRAMConfigBaseAddress)
@@ -550,16 +1176,19 @@ void CAN1_MessageRAMConfigSet(uint8_t *msgRAMConfigBaseAddress)
     /* Set CCE to unlock the configuration registers */
     CAN1_REGS->CAN_CCCR |= CAN_CCCR_CCE_Msk;
 
+    /* Bus monitoring and restricted operation, see CAN1_BusMonitoringSet */
+    CAN1_REGS->CAN_CCCR |= can1Mode;
+
     can1Obj.msgRAMConfig.rxFIFO0Address = (can_rxf0e_registers_t *)msgRAMConfigBaseAddress;
     offset = CAN1_RX_FIFO0_SIZE;
     /* Receive FIFO 0 Configuration Register */
-    CAN1_REGS->CAN_RXF0C = CAN_RXF0C_F0S(1UL) | CAN_RXF0C_F0WM(0UL) | CAN_RXF0C_F0OM_Msk |
+    CAN1_REGS->CAN_RXF0C = CAN_RXF0C_F0S((uint32_t)CAN1_RX_FIFO0_ELEMENTS) | CAN_RXF0C_F0WM((uint32_t)CAN1_RX_FIFO0_WATERMARK) |
             CAN_RXF0C_F0SA((uint32_t)can1Obj.msgRAMConfig.rxFIFO0Address);
 
     can1Obj.msgRAMConfig.rxFIFO1Address = (can_rxf1e_registers_t *)(msgRAMConfigBaseAddress + offset);
     offset += CAN1_RX_FIFO1_SIZE;
     /* Receive FIFO 1 Configuration Register */
-    CAN1_REGS->CAN_RXF1C = CAN_RXF1C_F1S(1UL) | CAN_RXF1C_F1WM(0UL) | CAN_RXF1C_F1OM_Msk |
+    CAN1_REGS->CAN_RXF1C = CAN_RXF1C_F1S((uint32_t)CAN1_RX_FIFO1_ELEMENTS) | CAN_RXF1C_F1WM((uint32_t)CAN1_RX_FIFO1_WATERMARK) |
             CAN_RXF1C_F1SA((uint32_t)can1Obj.msgRAMConfig.rxFIFO1Address);
 
     can1Obj.msgRAMConfig.rxBuffersAddress = (can_rxbe_registers_t *)(msgRAMConfigBaseAddress + offset);
@@ -569,30 +1198,30 @@ void CAN1_MessageRAMConfigSet(uint8_t *msgRAMConfigBaseAddress)
     can1Obj.msgRAMConfig.txBuffersAddress = (can_txbe_registers_t *)(msgRAMConfigBaseAddress + offset);
     offset += CAN1_TX_FIFO_BUFFER_SIZE;
     /* Transmit Buffer/FIFO Configuration Register */
-    CAN1_REGS->CAN_TXBC = CAN_TXBC_TFQS(1UL) |
+    CAN1_REGS->CAN_TXBC = CAN_TXBC_TFQS((uint32_t)CAN1_TX_FIFO_BUFFER_ELEMENTS) |
             CAN_TXBC_TBSA((uint32_t)can1Obj.msgRAMConfig.txBuffersAddress);
 
     can1Obj.msgRAMConfig.txEventFIFOAddress =  (can_txefe_registers_t *)(msgRAMConfigBaseAddress + offset);
     offset += CAN1_TX_EVENT_FIFO_SIZE;
     /* Transmit Event FIFO Configuration Register */
-    CAN1_REGS->CAN_TXEFC = CAN_TXEFC_EFWM(0UL) | CAN_TXEFC_EFS(1UL) |
+    CAN1_REGS->CAN_TXEFC = CAN_TXEFC_EFWM(0UL) | CAN_TXEFC_EFS((uint32_t)CAN1_TX_EVENT_FIFO_ELEMENTS) |
             CAN_TXEFC_EFSA((uint32_t)can1Obj.msgRAMConfig.txEventFIFOAddress);
 
     can1Obj.msgRAMConfig.stdMsgIDFilterAddress = (can_sidfe_registers_t *)(msgRAMConfigBaseAddress + offset);
     memcpy(can1Obj.msgRAMConfig.stdMsgIDFilterAddress,
            (const void *)can1StdFilter,
-           CAN1_STD_MSG_ID_FILTER_SIZE);
+           sizeof(can1StdFilter));
     offset += CAN1_STD_MSG_ID_FILTER_SIZE;
     /* Standard ID Filter Configuration Register */
-    CAN1_REGS->CAN_SIDFC = CAN_SIDFC_LSS(1UL) |
+    CAN1_REGS->CAN_SIDFC = CAN_SIDFC_LSS((uint32_t)CAN1_STD_MSG_ID_FILTER_ELEMENTS) |
             CAN_SIDFC_FLSSA((uint32_t)can1Obj.msgRAMConfig.stdMsgIDFilterAddress);
 
     can1Obj.msgRAMConfig.extMsgIDFilterAddress = (can_xidfe_registers_t *)(msgRAMConfigBaseAddress + offset);
     memcpy(can1Obj.msgRAMConfig.extMsgIDFilterAddress,
            (const void *)can1ExtFilter,
-           CAN1_EXT_MSG_ID_FILTER_SIZE);
+           sizeof(can1ExtFilter));
     /* Extended ID Filter Configuration Register */
-    CAN1_REGS->CAN_XIDFC = CAN_XIDFC_LSE(1UL) |
+    CAN1_REGS->CAN_XIDFC = CAN_XIDFC_LSE((uint32_t)CAN1_EXT_MSG_ID_FILTER_ELEMENTS) |
             CAN_XIDFC_FLESA((uint32_t)can1Obj.msgRAMConfig.extMsgIDFilterAddress);
 
     /* Reference offset variable once to remove warning about the variable not being used after increment */
@@ -618,7 +1247,7 @@ void CAN1_MessageRAMConfigSet(uint8_t *msgRAMConfigBaseAddress)
     for the associated CAN instance.
 
    Parameters:
-    filterNumber          - Standard Filter number to be configured.
+    filterNumber          - Standard Filter number to be configured, 1 to CAN1_STD_MSG_ID_FILTER_ELEMENTS.
     stdMsgIDFilterElement - Pointer to Standard Filter Element configuration to be set on specific filterNumber.
 
    Returns:
@@ -628,7 +1257,7 @@ void CAN1_MessageRAMConfigSet(uint8_t *msgRAMConfigBaseAddress)
 */
 bool CAN1_StandardFilterElementSet(uint8_t filterNumber, can_sidfe_registers_t *stdMsgIDFilterElement)
 {
-    if ((filterNumber > 1U) || (stdMsgIDFilterElement == NULL))
+    if ((filterNumber == 0U) || (filterNumber > CAN1_STD_MSG_ID_FILTER_ELEMENTS) || (stdMsgIDFilterElement == NULL))
     {
         return false;
     }
@@ -649,7 +1278,7 @@ bool CAN1_StandardFilterElementSet(uint8_t filterNumber, can_sidfe_registers_t *
     for the associated CAN instance.
 
    Parameters:
-    filterNumber          - Standard Filter number to get filter configuration.
+    filterNumber          - Standard Filter number to get filter configuration, 1 to CAN1_STD_MSG_ID_FILTER_ELEMENTS.
     stdMsgIDFilterElement - Pointer to Standard Filter Element configuration for storing filter configuration.
 
    Returns:
@@ -659,7 +1288,7 @@ bool CAN1_StandardFilterElementSet(uint8_t filterNumber, can_sidfe_registers_t *
 */
 bool CAN1_StandardFilterElementGet(uint8_t filterNumber, can_sidfe_registers_t *stdMsgIDFilterElement)
 {
-    if ((filterNumber > 1U) || (stdMsgIDFilterElement == NULL))
+    if ((filterNumber == 0U) || (filterNumber > CAN1_STD_MSG_ID_FILTER_ELEMENTS) || (stdMsgIDFilterElement == NULL))
     {
         return false;
     }
@@ -680,7 +1309,7 @@ bool CAN1_StandardFilterElementGet(uint8_t filterNumber, can_sidfe_registers_t *
     for the associated CAN instance.
 
    Parameters:
-    filterNumber          - Extended Filter number to be configured.
+    filterNumber          - Extended Filter number to be configured, 1 to CAN1_EXT_MSG_ID_FILTER_ELEMENTS.
     extMsgIDFilterElement - Pointer to Extended Filter Element configuration to be set on specific filterNumber.
 
    Returns:
@@ -690,7 +1319,7 @@ bool CAN1_StandardFilterElementGet(uint8_t filterNumber, can_sidfe_registers_t *
 */
 bool CAN1_ExtendedFilterElementSet(uint8_t filterNumber, can_xidfe_registers_t *extMsgIDFilterElement)
 {
-    if ((filterNumber > 1U) || (extMsgIDFilterElement == NULL))
+    if ((filterNumber == 0U) || (filterNumber > CAN1_EXT_MSG_ID_FILTER_ELEMENTS) || (extMsgIDFilterElement == NULL))
     {
         return false;
     }
@@ -712,7 +1341,7 @@ bool CAN1_ExtendedFilterElementSet(uint8_t filterNumber, can_xidfe_registers_t *
     for the associated CAN instance.
 
    Parameters:
-    filterNumber          - Extended Filter number to get filter configuration.
+    filterNumber          - Extended Filter number to get filter configuration, 1 to CAN1_EXT_MSG_ID_FILTER_ELEMENTS.
     extMsgIDFilterElement - Pointer to Extended Filter Element configuration for storing filter configuration.
 
    Returns:
@@ -722,7 +1351,7 @@ bool CAN1_ExtendedFilterElementSet(uint8_t filterNumber, can_xidfe_registers_t *
 */
 bool CAN1_ExtendedFilterElementGet(uint8_t filterNumber, can_xidfe_registers_t *extMsgIDFilterElement)
 {
-    if ((filterNumber > 1U) || (extMsgIDFilterElement == NULL))
+    if ((filterNumber == 0U) || (filterNumber > CAN1_EXT_MSG_ID_FILTER_ELEMENTS) || (extMsgIDFilterElement == NULL))
     {
         return false;
     }
@@ -808,6 +1437,10 @@ void CAN1_TxFifoCallbackRegister(CAN_TX_FIFO_CALLBACK callback, uintptr_t contex
 
    Returns:
     None.
+
+   Remarks:
+    The callback is called after the new Tx Event FIFO elements were moved
+    into the Tx event ring, with the number of events added.
 */
 void CAN1_TxEventFifoCallbackRegister(CAN_TX_EVENT_FIFO_CALLBACK callback, uintptr_t contextHandle)
 {
@@ -920,15 +1553,33 @@ void CAN1_InterruptHandler(void)
 
     uint32_t ir = CAN1_REGS->CAN_IR;
 
+    /* Timestamp counter wraparound */
+    if ((ir & CAN_IR_TSW_Msk) != 0U)
+    {
+        CAN1_REGS->CAN_IR = CAN_IR_TSW_Msk;
+        can1Obj.timestampWrapCount++;
+    }
     /* Check if error occurred */
     if ((ir & CAN_IR_BO_Msk) != 0U)
     {
         CAN1_REGS->CAN_IR = CAN_IR_BO_Msk;
     }
-    /* New Message in Rx FIFO 0 */
-    if ((ir & CAN_IR_RF0N_Msk) != 0U)
+    /* Rx FIFO 0 message lost, FIFO was full (blocking mode) */
+    if ((ir & CAN_IR_RF0L_Msk) != 0U)
+    {
+        CAN1_REGS->CAN_IR = CAN_IR_RF0L_Msk;
+        can1Obj.rxFifoLostCount[CAN_RX_FIFO_0]++;
+    }
+    /* Rx FIFO 1 message lost, FIFO was full (blocking mode) */
+    if ((ir & CAN_IR_RF1L_Msk) != 0U)
+    {
+        CAN1_REGS->CAN_IR = CAN_IR_RF1L_Msk;
+        can1Obj.rxFifoLostCount[CAN_RX_FIFO_1]++;
+    }
+    /* New Message or watermark reached in Rx FIFO 0 */
+    if ((ir & (CAN_IR_RF0N_Msk | CAN_IR_RF0W_Msk)) != 0U)
     {
-        CAN1_REGS->CAN_IR = CAN_IR_RF0N_Msk;
+        CAN1_REGS->CAN_IR = (ir & (CAN_IR_RF0N_Msk | CAN_IR_RF0W_Msk));
 
         numberOfMessage = (uint8_t)(CAN1_REGS->CAN_RXF0S & CAN_RXF0S_F0FL_Msk);
 
@@ -937,10 +1588,10 @@ void CAN1_InterruptHandler(void)
             can1RxFifoCallbackObj[CAN_RX_FIFO_0].callback(numberOfMessage, can1RxFifoCallbackObj[CAN_RX_FIFO_0].context);
         }
     }
-    /* New Message in Rx FIFO 1 */
-    if ((ir & CAN_IR_RF1N_Msk) != 0U)
+    /* New Message or watermark reached in Rx FIFO 1 */
+    if ((ir & (CAN_IR_RF1N_Msk | CAN_IR_RF1W_Msk)) != 0U)
     {
-        CAN1_REGS->CAN_IR = CAN_IR_RF1N_Msk;
+        CAN1_REGS->CAN_IR = (ir & (CAN_IR_RF1N_Msk | CAN_IR_RF1W_Msk));
 
         numberOfMessage = (uint8_t)(CAN1_REGS->CAN_RXF1S & CAN_RXF1S_F1FL_Msk);
 
@@ -979,12 +1630,31 @@ void CAN1_InterruptHandler(void)
             can1TxFifoCallbackObj.callback(can1TxFifoCallbackObj.context);
         }
     }
+    /* Protocol error, PSR.LEC or PSR.DLEC holds its code */
+    if ((ir & (CAN_IR_PEA_Msk | CAN_IR_PED_Msk)) != 0U)
+    {
+        CAN1_REGS->CAN_IR = (ir & (CAN_IR_PEA_Msk | CAN_IR_PED_Msk));
+        if ((ir & CAN_IR_PEA_Msk) != 0U)
+        {
+            can1Obj.nominalErrorCount++;
+        }
+        if ((ir & CAN_IR_PED_Msk) != 0U)
+        {
+            can1Obj.dataErrorCount++;
+        }
+    }
+    /* Tx Event FIFO element lost, FIFO was full */
+    if ((ir & CAN_IR_TEFL_Msk) != 0U)
+    {
+        CAN1_REGS->CAN_IR = CAN_IR_TEFL_Msk;
+        can1Obj.txEventLostCount++;
+    }
     /* Tx Event FIFO new entry */
     if ((ir & CAN_IR_TEFN_Msk) != 0U)
     {
         CAN1_REGS->CAN_IR = CAN_IR_TEFN_Msk;
 
-        numberOfTxEvent = (uint8_t)(CAN1_REGS->CAN_TXEFS & CAN_TXEFS_EFFL_Msk);
+        numberOfTxEvent = CAN1_TxEventCollect();
 
         if (can1TxEventFifoCallbackObj.callback != NULL)
         {
@@ -73,22 +73,92 @@
 // Section: Data Types
 // *****************************************************************************
 // *****************************************************************************
+/* CAN1 Rx FIFO0/FIFO1, Tx FIFO and Tx Event FIFO depth (number of elements).
+   Override on the compiler command line to resize the Message RAM layout.
+   Rx FIFOs accept 1 to 64 elements, the Tx FIFO and the Tx Event FIFO 1 to
+   32 elements. */
+#ifndef CAN1_RX_FIFO0_ELEMENTS
+#define CAN1_RX_FIFO0_ELEMENTS           32U
+#endif
+#ifndef CAN1_RX_FIFO1_ELEMENTS
+#define CAN1_RX_FIFO1_ELEMENTS           32U
+#endif
+#ifndef CAN1_TX_FIFO_BUFFER_ELEMENTS
+#define CAN1_TX_FIFO_BUFFER_ELEMENTS     16U
+#endif
+#ifndef CAN1_TX_EVENT_FIFO_ELEMENTS
+#define CAN1_TX_EVENT_FIFO_ELEMENTS      16U
+#endif
+/* CAN1 Tx events held for CAN1_TxEventGet, a power of two */
+#ifndef CAN1_TX_EVENT_RING_ELEMENTS
+#define CAN1_TX_EVENT_RING_ELEMENTS      64U
+#endif
+
+/* CAN1 standard and extended message ID filter list length (number of
+   elements), 1 to 128 standard and 1 to 64 extended elements. Unused
+   elements are left disabled. */
+#ifndef CAN1_STD_MSG_ID_FILTER_ELEMENTS
+#define CAN1_STD_MSG_ID_FILTER_ELEMENTS  128U
+#endif
+#ifndef CAN1_EXT_MSG_ID_FILTER_ELEMENTS
+#define CAN1_EXT_MSG_ID_FILTER_ELEMENTS  64U
+#endif
+
+/* CAN1 Rx FIFO0/FIFO1 watermark level (RF0W/RF1W interrupt), 0 disables */
+#ifndef CAN1_RX_FIFO0_WATERMARK
+#define CAN1_RX_FIFO0_WATERMARK          24U
+#endif
+#ifndef CAN1_RX_FIFO1_WATERMARK
+#define CAN1_RX_FIFO1_WATERMARK          24U
+#endif
+
+#if ((CAN1_RX_FIFO0_ELEMENTS < 1U) || (CAN1_RX_FIFO0_ELEMENTS > 64U))
+#error "CAN1_RX_FIFO0_ELEMENTS must be in the range 1 to 64"
+#endif
+#if ((CAN1_RX_FIFO1_ELEMENTS < 1U) || (CAN1_RX_FIFO1_ELEMENTS > 64U))
+#error "CAN1_RX_FIFO1_ELEMENTS must be in the range 1 to 64"
+#endif
+#if ((CAN1_TX_FIFO_BUFFER_ELEMENTS < 1U) || (CAN1_TX_FIFO_BUFFER_ELEMENTS > 32U))
+#error "CAN1_TX_FIFO_BUFFER_ELEMENTS must be in the range 1 to 32"
+#endif
+#if ((CAN1_TX_EVENT_FIFO_ELEMENTS < 1U) || (CAN1_TX_EVENT_FIFO_ELEMENTS > 32U))
+#error "CAN1_TX_EVENT_FIFO_ELEMENTS must be in the range 1 to 32"
+#endif
+#if ((CAN1_TX_EVENT_RING_ELEMENTS & (CAN1_TX_EVENT_RING_ELEMENTS - 1U)) != 0U)
+#error "CAN1_TX_EVENT_RING_ELEMENTS must be a power of two"
+#endif
+#if ((CAN1_STD_MSG_ID_FILTER_ELEMENTS < 1U) || (CAN1_STD_MSG_ID_FILTER_ELEMENTS > 128U))
+#error "CAN1_STD_MSG_ID_FILTER_ELEMENTS must be in the range 1 to 128"
+#endif
+#if ((CAN1_EXT_MSG_ID_FILTER_ELEMENTS < 1U) || (CAN1_EXT_MSG_ID_FILTER_ELEMENTS > 64U))
+#error "CAN1_EXT_MSG_ID_FILTER_ELEMENTS must be in the range 1 to 64"
+#endif
+#if ((CAN1_RX_FIFO0_WATERMARK >= CAN1_RX_FIFO0_ELEMENTS) && (CAN1_RX_FIFO0_WATERMARK != 0U))
+#error "CAN1_RX_FIFO0_WATERMARK must be below CAN1_RX_FIFO0_ELEMENTS"
+#endif
+#if ((CAN1_RX_FIFO1_WATERMARK >= CAN1_RX_FIFO1_ELEMENTS) && (CAN1_RX_FIFO1_WATERMARK != 0U))
+#error "CAN1_RX_FIFO1_WATERMARK must be below CAN1_RX_FIFO1_ELEMENTS"
+#endif
+
 /* CAN1 Message RAM Configuration Size */
 #define CAN1_RX_FIFO0_ELEMENT_SIZE       72U
-#define CAN1_RX_FIFO0_SIZE               72U
+#define CAN1_RX_FIFO0_SIZE               (CAN1_RX_FIFO0_ELEMENTS * CAN1_RX_FIFO0_ELEMENT_SIZE)
 #define CAN1_RX_FIFO1_ELEMENT_SIZE       72U
-#define CAN1_RX_FIFO1_SIZE               72U
+#define CAN1_RX_FIFO1_SIZE               (CAN1_RX_FIFO1_ELEMENTS * CAN1_RX_FIFO1_ELEMENT_SIZE)
 #define CAN1_RX_BUFFER_ELEMENT_SIZE      72U
 #define CAN1_RX_BUFFER_SIZE              72U
 #define CAN1_TX_FIFO_BUFFER_ELEMENT_SIZE 72U
-#define CAN1_TX_FIFO_BUFFER_SIZE         72U
-#define CAN1_TX_EVENT_FIFO_SIZE          8U
-#define CAN1_STD_MSG_ID_FILTER_SIZE      4U
-#define CAN1_EXT_MSG_ID_FILTER_SIZE      8U
+#define CAN1_TX_FIFO_BUFFER_SIZE         (CAN1_TX_FIFO_BUFFER_ELEMENTS * CAN1_TX_FIFO_BUFFER_ELEMENT_SIZE)
+#define CAN1_TX_EVENT_FIFO_ELEMENT_SIZE  8U
+#define CAN1_TX_EVENT_FIFO_SIZE          (CAN1_TX_EVENT_FIFO_ELEMENTS * CAN1_TX_EVENT_FIFO_ELEMENT_SIZE)
+#define CAN1_STD_MSG_ID_FILTER_SIZE      (CAN1_STD_MSG_ID_FILTER_ELEMENTS * 4U)
+#define CAN1_EXT_MSG_ID_FILTER_SIZE      (CAN1_EXT_MSG_ID_FILTER_ELEMENTS * 8U)
 
 /* CAN1_MESSAGE_RAM_CONFIG_SIZE to be used by application or driver
    for allocating buffer from non-cached contiguous memory */
-#define CAN1_MESSAGE_RAM_CONFIG_SIZE     308U
+#define CAN1_MESSAGE_RAM_CONFIG_SIZE     (CAN1_RX_FIFO0_SIZE + CAN1_RX_FIFO1_SIZE + CAN1_RX_BUFFER_SIZE + \
+                                          CAN1_TX_FIFO_BUFFER_SIZE + CAN1_TX_EVENT_FIFO_SIZE + \
+                                          CAN1_STD_MSG_ID_FILTER_SIZE + CAN1_EXT_MSG_ID_FILTER_SIZE)
 
 // *****************************************************************************
 // *****************************************************************************
@@ -96,14 +166,27 @@
 // *****************************************************************************
 // *****************************************************************************
 void CAN1_Initialize(void);
+bool CAN1_BitTimingSet(const CAN_BIT_TIMING *bitTiming);
 bool CAN1_MessageTransmitFifo(uint8_t numberOfMessage, CAN_TX_BUFFER *txBuffer);
+uint8_t CAN1_MessageTransmitFifoBatch(uint8_t numberOfMessage, CAN_TX_BUFFER *txBuffer);
 uint8_t CAN1_TxFifoFreeLevelGet(void);
 bool CAN1_TxBufferIsBusy(uint8_t bufferNumber);
+uint8_t CAN1_TxFifoCancel(uint8_t messageMarker, uint8_t messageMarkerMask);
 bool CAN1_TxEventFifoRead(uint8_t numberOfTxEvent, CAN_TX_EVENT_FIFO *txEventFifo);
+bool CAN1_TxEventGet(CAN_TX_EVENT *txEvent);
+uint32_t CAN1_TxEventLostCountGet(void);
 bool CAN1_MessageReceive(uint8_t bufferNumber, CAN_RX_BUFFER *rxBuffer);
 bool CAN1_MessageReceiveFifo(CAN_RX_FIFO_NUM rxFifoNum, uint8_t numberOfMessage, CAN_RX_BUFFER *rxBuffer);
+uint8_t CAN1_RxFifoFillLevelGet(CAN_RX_FIFO_NUM rxFifoNum);
+uint32_t CAN1_RxFifoLostCountGet(CAN_RX_FIFO_NUM rxFifoNum);
+uint32_t CAN1_RxTimestampExtend(uint16_t rxts);
 CAN_ERROR CAN1_ErrorGet(void);
 void CAN1_ErrorCountGet(uint8_t *txErrorCount, uint8_t *rxErrorCount);
+void CAN1_ProtocolErrorCountGet(uint32_t *nominalErrorCount, uint32_t *dataErrorCount);
+void CAN1_BusMonitoringSet(bool enable);
+bool CAN1_BusMonitoringGet(void);
+void CAN1_RestrictedOperationSet(bool enable);
+bool CAN1_RestrictedOperationGet(void);
 void CAN1_MessageRAMConfigSet(uint8_t *msgRAMConfigBaseAddress);
 bool CAN1_StandardFilterElementSet(uint8_t filterNumber, can_sidfe_registers_t *stdMsgIDFilterElement);
 bool CAN1_StandardFilterElementGet(uint8_t filterNumber, can_sidfe_registers_t *stdMsgIDFilterElement);
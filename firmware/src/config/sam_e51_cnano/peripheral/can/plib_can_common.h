@@ -271,6 +271,86 @@ typedef struct
     can_xidfe_registers_t *extMsgIDFilterAddress;
 } CAN_MSG_RAM_CONFIG;
 
+// *****************************************************************************
+/* CAN Nominal Bit Timing Parameters
+
+   Summary:
+    CAN nominal bit timing register field values.
+
+   Description:
+    Register field values of NBTP: the prescaler and segments are one less
+    than the number of clocks/time quanta.
+
+   Remarks:
+    None.
+*/
+typedef struct
+{
+    /* Nominal Baud Rate Prescaler */
+    uint16_t nominalBaudRatePrescaler;
+
+    /* Nominal Time segment before sample point */
+    uint8_t nominalTimeSegment1;
+
+    /* Nominal Time segment after sample point */
+    uint8_t nominalTimeSegment2;
+
+    /* Nominal (Re)Synchronization Jump Width */
+    uint8_t nominalSJW;
+} CAN_NOMINAL_BIT_TIMING;
+
+// *****************************************************************************
+/* CAN Data Bit Timing Parameters
+
+   Summary:
+    CAN data bit timing register field values.
+
+   Description:
+    Register field values of DBTP: the prescaler and segments are one less
+    than the number of clocks/time quanta.
+
+   Remarks:
+    None.
+*/
+typedef struct
+{
+    /* Data Baud Rate Prescaler */
+    uint8_t dataBaudRatePrescaler;
+
+    /* Data Time segment before sample point */
+    uint8_t dataTimeSegment1;
+
+    /* Data Time segment after sample point */
+    uint8_t dataTimeSegment2;
+
+    /* Data (Re)Synchronization Jump Width */
+    uint8_t dataSJW;
+} CAN_DATA_BIT_TIMING;
+
+// *****************************************************************************
+/* CAN Bit Timing Parameters
+
+   Summary:
+    CAN bit timing to set.
+
+   Description:
+    Nominal and/or data bit timing, each applied only when its Set flag is
+    true.
+
+   Remarks:
+    None.
+*/
+typedef struct
+{
+    bool nominalBitTimingSet;
+
+    CAN_NOMINAL_BIT_TIMING nominalBitTiming;
+
+    bool dataBitTimingSet;
+
+    CAN_DATA_BIT_TIMING dataBitTiming;
+} CAN_BIT_TIMING;
+
 // *****************************************************************************
 /* CAN Rx Buffer and FIFO Element
 
@@ -395,6 +475,33 @@ typedef struct
 
 } CAN_TX_EVENT_FIFO;
 
+// *****************************************************************************
+/* CAN Tx Event
+
+   Summary:
+    CAN Tx Event FIFO Element with extended timestamps.
+
+   Description:
+    This data structure defines a Tx Event FIFO Element collected by the
+    interrupt handler, together with the extended Tx timestamp and the time
+    the message was requested for transmission.
+
+   Remarks:
+    Both timestamps are in the unit of the Rx/Tx timestamp extension.
+*/
+typedef struct
+{
+    /* Tx Event FIFO Element */
+    CAN_TX_EVENT_FIFO element;
+
+    /* Tx Timestamp (start of frame) extended to 32 bits */
+    uint32_t timestamp;
+
+    /* Extended timestamp of the transmission request of the message */
+    uint32_t queued;
+
+} CAN_TX_EVENT;
+
 // *****************************************************************************
 /* CAN Tx FIFO Callback Object
 
@@ -496,6 +603,19 @@ typedef struct
     /* Message RAM Configuration */
     CAN_MSG_RAM_CONFIG msgRAMConfig;
 
+    /* Rx FIFO0/FIFO1 message lost count */
+    uint32_t rxFifoLostCount[2];
+
+    /* Tx events lost, Tx Event FIFO or Tx event ring was full */
+    uint32_t txEventLostCount;
+
+    /* Protocol errors in the arbitration phase and in the data phase */
+    uint32_t nominalErrorCount;
+    uint32_t dataErrorCount;
+
+    /* Timestamp counter wraparound count */
+    volatile uint32_t timestampWrapCount;
+
 } CAN_OBJ;
 
 // DOM-IGNORE-BEGIN
@@ -156,6 +156,10 @@ bool DMAC_ChannelTransfer( DMAC_CHANNEL channel, const void *srcAddr, const void
         /* Get a pointer to the module hardware instance */
         dmac_descriptor_registers_t *const dmacDescReg = &descriptor_section[channel];
 
+        /* Single block transfer, undo any linked list transfer set up before */
+        dmacDescReg->DMAC_BTCTRL = (dmacDescReg->DMAC_BTCTRL & ~DMAC_BTCTRL_BLOCKACT_Msk) | DMAC_BTCTRL_BLOCKACT_INT;
+        dmacDescReg->DMAC_DESCADDR = 0;
+
        /*Set source address */
         if ( dmacDescReg->DMAC_BTCTRL & DMAC_BTCTRL_SRCINC_Msk)
         {
@@ -206,6 +210,87 @@ bool DMAC_ChannelTransfer( DMAC_CHANNEL channel, const void *srcAddr, const void
     return returnStatus;
 }
 
+/*******************************************************************************
+This function submits a list of DMA transfers. The first descriptor is copied
+into the channel's descriptor section, the remaining descriptors are fetched
+by the DMAC through DMAC_DESCADDR and must stay valid until the transfer
+complete (or error) callback.
+********************************************************************************/
+
+bool DMAC_ChannelLinkedListTransfer (DMAC_CHANNEL channel, dmac_descriptor_registers_t *channelDesc)
+{
+    bool returnStatus = false;
+
+    if ((dmacChannelObj[channel].busyStatus == false) || (DMAC_REGS->CHANNEL[channel].DMAC_CHINTFLAG & (DMAC_CHINTENCLR_TCMPL_Msk | DMAC_CHINTENCLR_TERR_Msk)))
+    {
+        /* Clear the transfer complete flag */
+        DMAC_REGS->CHANNEL[channel].DMAC_CHINTFLAG = DMAC_CHINTENCLR_TCMPL_Msk | DMAC_CHINTENCLR_TERR_Msk;
+
+        dmacChannelObj[channel].busyStatus = true;
+
+        memcpy(&descriptor_section[channel], channelDesc, sizeof(dmac_descriptor_registers_t));
+
+        /* Enable the channel */
+        DMAC_REGS->CHANNEL[channel].DMAC_CHCTRLA |= DMAC_CHCTRLA_ENABLE_Msk;
+
+        /* Verify if Trigger source is Software Trigger */
+        if ((((DMAC_REGS->CHANNEL[channel].DMAC_CHCTRLA & DMAC_CHCTRLA_TRIGSRC_Msk) >> DMAC_CHCTRLA_TRIGSRC_Pos) == 0x00)
+                                                && (((DMAC_REGS->CHANNEL[channel].DMAC_CHEVCTRL & DMAC_CHEVCTRL_EVIE_Msk)) != DMAC_CHEVCTRL_EVIE_Msk))
+        {
+            /* Trigger the DMA transfer */
+            DMAC_REGS->DMAC_SWTRIGCTRL |= (1 << channel);
+        }
+        returnStatus = true;
+    }
+
+    return returnStatus;
+}
+
+/*******************************************************************************
+This function fills one descriptor of a linked list. nextDescriptor is NULL
+for the last descriptor of the list.
+********************************************************************************/
+
+void DMAC_LinkedListDescriptorSetup (dmac_descriptor_registers_t *currentDescriptor,
+                                     DMAC_CHANNEL_CONFIG setting,
+                                     const void *srcAddr,
+                                     const void *destAddr,
+                                     size_t blockSize,
+                                     dmac_descriptor_registers_t *nextDescriptor)
+{
+    uint8_t beat_size = 0;
+
+    currentDescriptor->DMAC_BTCTRL = (uint16_t)setting;
+
+    /* Calculate the beat size and then set the BTCNT value */
+    beat_size = (currentDescriptor->DMAC_BTCTRL & DMAC_BTCTRL_BEATSIZE_Msk) >> DMAC_BTCTRL_BEATSIZE_Pos;
+    currentDescriptor->DMAC_BTCNT = blockSize / (1 << beat_size);
+
+    /* Set source address */
+    if (currentDescriptor->DMAC_BTCTRL & DMAC_BTCTRL_SRCINC_Msk)
+    {
+        currentDescriptor->DMAC_SRCADDR = (uint32_t) ((intptr_t)srcAddr + blockSize);
+    }
+    else
+    {
+        currentDescriptor->DMAC_SRCADDR = (uint32_t) (srcAddr);
+    }
+
+    /* Set destination address */
+    if (currentDescriptor->DMAC_BTCTRL & DMAC_BTCTRL_DSTINC_Msk)
+    {
+        currentDescriptor->DMAC_DSTADDR = (uint32_t) ((intptr_t)destAddr + blockSize);
+    }
+    else
+    {
+        currentDescriptor->DMAC_DSTADDR = (uint32_t) (destAddr);
+    }
+
+    /* Set next descriptor address */
+    currentDescriptor->DMAC_DESCADDR = (uint32_t) nextDescriptor;
+}
+
+
 /*******************************************************************************
     This function returns the status of the channel.
 ********************************************************************************/
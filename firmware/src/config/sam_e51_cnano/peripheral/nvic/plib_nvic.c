@@ -85,6 +85,10 @@ void NVIC_Initialize( void )
     NVIC_EnableIRQ(SERCOM5_OTHER_IRQn);
     NVIC_SetPriority(CAN1_IRQn, 7);
     NVIC_EnableIRQ(CAN1_IRQn);
+    NVIC_SetPriority(TC0_IRQn, 7);
+    NVIC_EnableIRQ(TC0_IRQn);
+    NVIC_SetPriority(TC1_IRQn, 7);
+    NVIC_EnableIRQ(TC1_IRQn);
 
 
 
@@ -0,0 +1,164 @@
+/*******************************************************************************
+  TC Peripheral Library Interface Header File
+
+  Company:
+    Microchip Technology Inc.
+
+  File Name:
+    plib_tc_common.h
+
+  Summary:
+    TC PLIB Common Header File
+
+  Description:
+    This file has prototype of all the interfaces which are common for all the
+    TC peripherals.
+
+*******************************************************************************/
+
+// DOM-IGNORE-BEGIN
+/*******************************************************************************
+* Copyright (C) 2018 Microchip Technology Inc. and its subsidiaries.
+*
+* Subject to your compliance with these terms, you may use Microchip software
+* and any derivatives exclusively with Microchip products. It is your
+* responsibility to comply with third party license terms applicable to your
+* use of third party software (including open source software) that may
+* accompany Microchip software.
+*
+* THIS SOFTWARE IS SUPPLIED BY MICROCHIP "AS IS". NO WARRANTIES, WHETHER
+* EXPRESS, IMPLIED OR STATUTORY, APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED
+* WARRANTIES OF NON-INFRINGEMENT, MERCHANTABILITY, AND FITNESS FOR A
+* PARTICULAR PURPOSE.
+*
+* IN NO EVENT WILL MICROCHIP BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE,
+* INCIDENTAL OR CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND
+* WHATSOEVER RELATED TO THE SOFTWARE, HOWEVER CAUSED, EVEN IF MICROCHIP HAS
+* BEEN ADVISED OF THE POSSIBILITY OR THE DAMAGES ARE FORESEEABLE. TO THE
+* FULLEST EXTENT ALLOWED BY LAW, MICROCHIP'S TOTAL LIABILITY ON ALL CLAIMS IN
+* ANY WAY RELATED TO THIS SOFTWARE WILL NOT EXCEED THE AMOUNT OF FEES, IF ANY,
+* THAT YOU HAVE PAID DIRECTLY TO MICROCHIP FOR THIS SOFTWARE.
+*******************************************************************************/
+// DOM-IGNORE-END
+
+#ifndef PLIB_TC_COMMON_H    // Guards against multiple inclusion
+#define PLIB_TC_COMMON_H
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Included Files
+// *****************************************************************************
+// *****************************************************************************
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+// DOM-IGNORE-BEGIN
+#ifdef __cplusplus  // Provide C++ Compatibility
+
+    extern "C" {
+
+#endif
+// DOM-IGNORE-END
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Data Types
+// *****************************************************************************
+// *****************************************************************************
+
+// *****************************************************************************
+/* TC Timer Status
+
+   Summary:
+    Identifies TC timer interrupt source mask
+
+   Description:
+    This enumeration identifies TC timer interrupt source mask.
+
+   Remarks:
+    None.
+*/
+
+typedef enum
+{
+    TC_TIMER_STATUS_NONE = 0,
+    /* overflow */
+    TC_TIMER_STATUS_OVERFLOW = TC_INTFLAG_OVF_Msk,
+    /* match compare 1 */
+    TC_TIMER_STATUS_MATCH1 = TC_INTFLAG_MC1_Msk,
+
+    TC_TIMER_STATUS_MSK = TC_INTFLAG_Msk
+} TC_TIMER_STATUS;
+
+// *****************************************************************************
+/* TC Commands
+
+   Summary:
+    Identifies the command to be written to the TC.
+
+   Description:
+    This enumeration identifies the command written to the CTRLB register of
+    the TC.
+
+   Remarks:
+    None.
+*/
+
+typedef enum
+{
+    TC_COMMAND_NONE = 0,
+    TC_COMMAND_START_RETRIGGER = 1,
+    TC_COMMAND_STOP = 2,
+    TC_COMMAND_FORCE_UPDATE = 3,
+    TC_COMMAND_READ_SYNC = 4
+} TC_COMMAND;
+
+// *****************************************************************************
+/* TC Timer Callback Function Pointer
+
+   Summary:
+    Pointer to a TC Timer callback function
+
+   Description:
+    This data type defines the required function signature for the TC timer
+    event handling callback function. The callback receives the interrupt
+    flags which were set and the context registered with
+    TCx_TimerCallbackRegister.
+
+   Remarks:
+    The callback is called from the TC interrupt context.
+*/
+
+typedef void (*TC_TIMER_CALLBACK) (TC_TIMER_STATUS status, uintptr_t context);
+
+// *****************************************************************************
+/* TC Timer Callback Object
+
+   Summary:
+    Holds the registered timer callback and its context.
+
+   Remarks:
+    None.
+*/
+
+typedef struct
+{
+    TC_TIMER_CALLBACK callback;
+    uintptr_t context;
+} TC_TIMER_CALLBACK_OBJ;
+
+// DOM-IGNORE-BEGIN
+#ifdef __cplusplus  // Provide C++ Compatibility
+
+    }
+
+#endif
+// DOM-IGNORE-END
+
+#endif //PLIB_TC_COMMON_H
+
+/**
+ End of File
+*/
@@ -52,7 +52,25 @@
 #include <stdbool.h>                    // Defines true
 #include <stdlib.h>                     // Defines EXIT_FAILURE
 #include <string.h>
+#include <ctype.h>
 #include "definitions.h"                // SYS function prototypes
+#include "app_can_ring.h"
+#include "app_can_record.h"
+#include "app_can_format.h"
+#include "app_can_change.h"
+#include "app_can_stats.h"
+#include "app_can_load.h"
+#include "app_can_filter.h"
+#include "app_can_idfilter.h"
+#include "app_can_trigger.h"
+#include "app_can_flashlog.h"
+#include "app_can_bitrate.h"
+#include "app_can_config.h"
+#include "app_fw_update.h"
+#include "app_can_replay.h"
+#include "app_can_txevent.h"
+#include "app_can_cyclic.h"
+#include "app_uart_queue.h"
 
 /* RTC Time period match values for input clock of 1 KHz */
 #define PERIOD_500MS                            512
@@ -60,9 +78,25 @@
 #define PERIOD_2S                               2048
 #define PERIOD_4S                               4096
 
-/* UART Tx & Rx Buffer Sizes */
+/* UART Tx Buffer Size */
 #define UART_BUF_NUMBYTES_TX                    512
-#define UART_BUF_NUMBYTES_RX                    256
+
+/* Worst case output for one received CAN frame */
+#define APP_CAN_OUTPUT_MAX_SIZE                 APP_CAN_FORMAT_LINE_MAX
+
+/* Longest argument line of a menu command, saved as typed in the
+   configuration */
+#define APP_CAN_LINE_SIZE                       APP_CAN_CONFIG_LINE_SIZE
+
+/* CAN timestamp tick length */
+#define APP_CAN_US_PER_TICK                     (1000000U / APP_CAN_FORMAT_TICKS_PER_SECOND)
+
+/* Room kept in the debug queue for one replay result line */
+#define APP_CAN_REPLAY_LINE_MAX                 80U
+/* A streamed replay ends when no byte arrives for this long */
+#define APP_CAN_REPLAY_STREAM_TIMEOUT_MS        2000U
+/* Room kept in the debug queue for one cyclic message report line */
+#define APP_CAN_CYCLIC_LINE_MAX                 144U
 
 typedef enum
 {
@@ -73,14 +107,58 @@ typedef enum
 } RTC_INTERRUPT_RATE;
 
 /* Standard identifier id[28:18]*/
-#define WRITE_ID(id) (id << 18)
 #define READ_ID(id)  (id >> 18)
 
+/* Format of received CAN frames on the debug and BLE links */
+typedef enum
+{
+    APP_CAN_OUTPUT_TEXT,
+    APP_CAN_OUTPUT_BINARY,
+    /* Binary records, payload delta encoded per ID */
+    APP_CAN_OUTPUT_DELTA
+} APP_CAN_OUTPUT_MODE;
+
+/* Operation of CAN1 on the bus, saved as APP_CAN_CONFIG busMode */
+typedef enum
+{
+    APP_CAN_BUS_NORMAL,
+    /* Bus monitoring: no acknowledge, no error frames, nothing sent */
+    APP_CAN_BUS_LISTEN,
+    /* Restricted operation: acknowledges, no error frames, nothing sent */
+    APP_CAN_BUS_RESTRICTED
+} APP_CAN_BUS_MODE;
+
+/* Menu command waiting for its argument line */
+typedef enum
+{
+    APP_CAN_LINE_NONE,
+    APP_CAN_LINE_HW_FILTER,
+    APP_CAN_LINE_SW_FILTER,
+    APP_CAN_LINE_TRIGGER,
+    APP_CAN_LINE_FLASHLOG,
+    APP_CAN_LINE_CONFIG,
+    APP_CAN_LINE_REPLAY,
+    APP_CAN_LINE_TXEVENT,
+    APP_CAN_LINE_CYCLIC
+} APP_CAN_LINE_MODE;
+
+/* Flash recorder dump progress */
+typedef enum
+{
+    APP_CAN_DUMP_NONE,
+    /* Waiting for the pages buffered in RAM to be written */
+    APP_CAN_DUMP_FLUSH,
+    APP_CAN_DUMP_OUTPUT,
+    /* Log blocks sent by the DMAC straight from flash */
+    APP_CAN_DUMP_RAW,
+    /* Recorded frames handed to the trace replay */
+    APP_CAN_DUMP_REPLAY
+} APP_CAN_DUMP_STATE;
+
 /* Application's state machine enum */
 typedef enum
 {
     APP_CAN_STATE_RECEIVE,
-    APP_CAN_STATE_TRANSMIT,
     APP_CAN_STATE_IDLE,
     APP_CAN_STATE_XFER_SUCCESSFUL,
     APP_CAN_STATE_XFER_ERROR,
@@ -91,33 +169,65 @@ static RTC_INTERRUPT_RATE tempSampleRate = RTC_INTERRUPT_RATE_500MS;
 static const char timeouts[4][20] = {"500 milliSeconds", "1 second",  "2 seconds",  "4 seconds"};
 
 static uint8_t uartTxBuffer[UART_BUF_NUMBYTES_TX] = {0};
-static uint8_t uartRxBuffer[UART_BUF_NUMBYTES_RX] = {0};
 
 static volatile bool isRTCExpired = false;
 static volatile bool changeTempSamplingRate = false;
-static volatile bool isUSART0TxComplete = true;
-static volatile bool isUSART5TxComplete = true;
-static volatile bool APP_CAN_rxFifo0Callback = false;
-static volatile bool APP_CAN_rxFifo1Callback = false;
-static volatile bool APP_CAN_rxBufferCallback = false;
 
-/* Variable to save Tx/Rx transfer status and context */
+/* Variable to save Rx transfer status */
 static uint32_t status = 0;
-static uint32_t xferContext = 0;
-/* Variable to save Tx/Rx message */
-static uint8_t loop_count = 0;
-//static uint8_t user_input = 0;
 /* Variable to save application state */
 volatile static APP_CAN_STATES state = APP_CAN_STATE_USER_INPUT;
-uint8_t APP_CAN_numberOfMessage;
-
-static uint8_t txFiFo[CAN1_TX_FIFO_BUFFER_SIZE];
-static uint8_t rxFiFo0[CAN1_RX_FIFO0_SIZE];
-static uint8_t rxFiFo1[CAN1_RX_FIFO1_SIZE];
-static uint8_t rxBuffer[CAN1_RX_BUFFER_SIZE];
-
-uint8_t Can1MessageRAM[CAN1_MESSAGE_RAM_CONFIG_SIZE] __attribute__((aligned (32)));
-CAN_TX_BUFFER *txBuffer = NULL;
+/* Capture ring overflow count already reported to the terminal */
+static uint32_t APP_CAN_overflowReported = 0;
+static APP_CAN_OUTPUT_MODE APP_CAN_outputMode = APP_CAN_OUTPUT_TEXT;
+static APP_CAN_BUS_MODE APP_CAN_busMode = APP_CAN_BUS_NORMAL;
+static const char * const APP_CAN_busModeName[] = {"normal", "listen", "restricted"};
+/* Forward only frames which differ from the last frame with the same ID */
+static bool APP_CAN_changedOnly = false;
+/* Oldest capture ring entry has been accounted in the statistics */
+static bool APP_CAN_statsAccounted = false;
+/* Next statistics table slot to report, -1 when no report is running */
+static int32_t APP_CAN_statsDumpIndex = -1;
+/* Argument line being typed */
+static APP_CAN_LINE_MODE APP_CAN_lineMode = APP_CAN_LINE_NONE;
+static char APP_CAN_line[APP_CAN_LINE_SIZE];
+static uint32_t APP_CAN_lineLength = 0;
+/* Header of the frozen trigger window has been output */
+static bool APP_CAN_triggerReported = false;
+static APP_CAN_DUMP_STATE APP_CAN_dumpState = APP_CAN_DUMP_NONE;
+/* Flash recorder was recording before the dump */
+static bool APP_CAN_dumpResume = false;
+/* Raw flash image instead of messages, next block to queue */
+static bool APP_CAN_dumpRaw = false;
+/* Recorded frames are replayed instead of output */
+static bool APP_CAN_dumpReplay = false;
+static uint32_t APP_CAN_dumpBlock = 0;
+/* Frames selected for the dump */
+static APP_CAN_FLASHLOG_QUERY APP_CAN_dumpQuery;
+static bool APP_CAN_dumpQueryActive = false;
+/* Last error state seen by the flash recorder */
+static uint32_t APP_CAN_flashLogErrorState = 0;
+/* Configuration saved by the K command, loaded before CAN1 starts */
+static APP_CAN_CONFIG APP_CAN_config;
+static bool APP_CAN_configLoaded = false;
+/* Firmware update state last reported */
+static APP_FW_UPDATE_STATE APP_CAN_updateState = APP_FW_UPDATE_STATE_IDLE;
+/* Bytes typed on the debug link are records for the trace replay */
+static bool APP_CAN_replayStream = false;
+static uint32_t APP_CAN_replayStreamTime = 0;
+/* Trace replay state last reported */
+static APP_CAN_REPLAY_STATE APP_CAN_replayState = APP_CAN_REPLAY_STATE_IDLE;
+/* Next cyclic message to report, -1 when no report is running */
+static int32_t APP_CAN_cyclicReportIndex = -1;
+/* Bit rate detection state last reported */
+static APP_CAN_BITRATE_AUTO_STATE APP_CAN_bitRateAutoState = APP_CAN_BITRATE_AUTO_STATE_IDLE;
+
+/* Sink for frames which do not fit into the capture ring */
+static uint8_t rxDiscard[CAN1_RX_FIFO0_ELEMENT_SIZE] __attribute__((aligned (4)));
+
+/* Placed at the start of SRAM by the linker script, the CAN start address
+   fields only reach the first 64 KB */
+uint8_t Can1MessageRAM[CAN1_MESSAGE_RAM_CONFIG_SIZE] __attribute__((aligned (32), section(".can_message_ram")));
 
 #define CAN_STD_FILTER_ID_MIN 0x0UL
 #define CAN_STD_FILTER_ID_MAX (CAN_SIDFE_0_SFT(0UL)|CAN_SIDFE_0_SFID1(0x0UL)|CAN_SIDFE_0_SFID2(0x7ffUL)|CAN_SIDFE_0_SFEC(1UL))
@@ -132,6 +242,9 @@ CAN_TX_BUFFER *txBuffer = NULL;
 
 static void EIC_User_Handler(uintptr_t context)
 {
+    /* Same interrupt priority as CAN1, see CAN1_RxTimestampExtend */
+    APP_CAN_TriggerEvent(APP_CAN_TRIGGER_SOURCE_PIN, CAN1_RxTimestampExtend((uint16_t)CAN1_REGS->CAN_TSCV));
+    APP_CAN_FlashLogEvent();
     changeTempSamplingRate = true;
 }
 
@@ -145,18 +258,26 @@ static void rtcEventHandler (RTC_TIMER32_INT_MASK intCause, uintptr_t context)
 
 static void usart0DmaChannelHandler(DMAC_TRANSFER_EVENT event, uintptr_t contextHandle)
 {
-    if (event == DMAC_TRANSFER_EVENT_COMPLETE)
-    {
-        isUSART0TxComplete = true;
-    }
+    /* Start the next queued chunk for the BLE module */
+    APP_UART_QueueTransferHandler(APP_UART_QUEUE_BLE);
+}
+
+static void usart0ReadHandler(uintptr_t context)
+{
+    /* Keep the byte from the BLE module and read the next one */
+    APP_UART_ReceiveHandler(APP_UART_QUEUE_BLE);
+}
+
+static void usart5ReadHandler(uintptr_t context)
+{
+    /* Keep the byte typed or streamed on the debug link and read the next one */
+    APP_UART_ReceiveHandler(APP_UART_QUEUE_DEBUG);
 }
 
 static void usart5DmaChannelHandler(DMAC_TRANSFER_EVENT event, uintptr_t contextHandle)
 {
-    if (event == DMAC_TRANSFER_EVENT_COMPLETE)
-    {
-        isUSART5TxComplete = true;
-    }
+    /* Start the next queued chunk for the debug terminal */
+    APP_UART_QueueTransferHandler(APP_UART_QUEUE_DEBUG);
 }
 
 // *****************************************************************************
@@ -168,30 +289,19 @@ static void usart5DmaChannelHandler(DMAC_TRANSFER_EVENT event, uintptr_t context
 
 void DEBUG_OUTPUT(char *buffer, char *mesg)
 {
-    isUSART5TxComplete = false;
     sprintf(buffer, mesg);
-    DMAC_ChannelTransfer(DMAC_CHANNEL_0, buffer, \
-            (const void *)&(SERCOM5_REGS->USART_INT.SERCOM_DATA), \
-            strlen((const char*)buffer));
-    while (isUSART5TxComplete == false);
+    APP_UART_QueueWrite(APP_UART_QUEUE_DEBUG, buffer, strlen((const char*)buffer));
 }
 
 void DEBUG_OUTPUT2(char *buffer)
 {
-    isUSART5TxComplete = false;
-    DMAC_ChannelTransfer(DMAC_CHANNEL_0, buffer, \
-            (const void *)&(SERCOM5_REGS->USART_INT.SERCOM_DATA), \
-            strlen((const char*)buffer));
-    while (isUSART5TxComplete == false);
+    APP_UART_QueueWrite(APP_UART_QUEUE_DEBUG, buffer, strlen((const char*)buffer));
 }
 
+/* mesg must be a string constant, it is sent without a copy */
 void DEBUG_OUTPUT3(char *mesg)
 {
-    isUSART5TxComplete = false;
-    DMAC_ChannelTransfer(DMAC_CHANNEL_0, mesg, \
-            (const void *)&(SERCOM5_REGS->USART_INT.SERCOM_DATA), \
-            strlen((const char*)mesg));
-    while (isUSART5TxComplete == false);
+    APP_UART_QueueWriteReference(APP_UART_QUEUE_DEBUG, mesg, strlen((const char*)mesg));
 }
 
 // *****************************************************************************
@@ -203,30 +313,19 @@ void DEBUG_OUTPUT3(char *mesg)
 
 void BLE_OUTPUT(char *buffer, char *mesg)
 {
-    isUSART0TxComplete = false;
     sprintf(buffer, mesg);
-    DMAC_ChannelTransfer(DMAC_CHANNEL_1, buffer, \
-            (const void *)&(SERCOM0_REGS->USART_INT.SERCOM_DATA), \
-            strlen((const char*)buffer));
-    while (isUSART0TxComplete == false);
+    APP_UART_QueueWrite(APP_UART_QUEUE_BLE, buffer, strlen((const char*)buffer));
 }
 
 void BLE_OUTPUT2(char *buffer)
 {
-    isUSART0TxComplete = false;
-    DMAC_ChannelTransfer(DMAC_CHANNEL_1, buffer, \
-            (const void *)&(SERCOM0_REGS->USART_INT.SERCOM_DATA), \
-            strlen((const char*)buffer));
-    while (isUSART0TxComplete == false);
+    APP_UART_QueueWrite(APP_UART_QUEUE_BLE, buffer, strlen((const char*)buffer));
 }
 
+/* mesg must be a string constant, it is sent without a copy */
 void BLE_OUTPUT3(char *mesg)
 {
-    isUSART0TxComplete = false;
-    DMAC_ChannelTransfer(DMAC_CHANNEL_1, mesg, \
-            (const void *)&(SERCOM0_REGS->USART_INT.SERCOM_DATA), \
-            strlen((const char*)mesg));
-    while (isUSART0TxComplete == false);
+    APP_UART_QueueWriteReference(APP_UART_QUEUE_BLE, mesg, strlen((const char*)mesg));
 }
 
 // *****************************************************************************
@@ -235,441 +334,1763 @@ void BLE_OUTPUT3(char *mesg)
 // *****************************************************************************
 // *****************************************************************************
 
-/* Message Length to Data length code */
-static uint8_t CANLengthToDlcGet(uint8_t length)
-{
-    uint8_t dlc = 0;
+static void APP_CAN_menu(void)
+{   
+	DEBUG_OUTPUT3("\r\n\r\n[CAN] Demo Menu Options :\r\n"
+	       "  --> Enter a key to select one of the following actions:\r\n"
+	       "  [P/p] Replay a trace with its original timing \r\n"
+	       "  [X/x] Report transmit latency and arbitration delay \r\n"
+	       "  [G/g] Send periodic messages (rest-bus simulation) \r\n"
+	       "  [B/b] Output received messages as binary COBS records \r\n"
+	       "  [D/d] Output received messages as delta encoded binary records \r\n"
+	       "  [T/t] Output received messages as text \r\n"
+	       "  [C/c] Toggle forwarding of changed messages only \r\n"
+	       "  [S/s] Report per-ID traffic statistics \r\n"
+	       "  [L/l] Report bus load \r\n"
+	       "  [F/f] Set hardware acceptance filter \r\n"
+	       "  [I/i] Set software ID filter \r\n"
+	       "  [A/a] Arm trigger capture \r\n"
+	       "  [W/w] Control the flash recorder \r\n"
+	       "  [K/k] Save the configuration, set bit rates and baud rates \r\n"
+	       "  [U/u] Report firmware update progress \r\n"
+	       "  [M/m] Display options in this menu \r\n"
+	       "  [R/r] Reset MCU \r\n\r\n");
+}
 
-    if (length <= 8U)
-    {
-        dlc = length;
-    }
-    else if (length <= 12U)
+/* Returns room for APP_CAN_OUTPUT_MAX_SIZE bytes in the debug queue, or NULL
+   when either the debug or the BLE queue is short of room. The BLE link is
+   left to a firmware update while one is in progress. */
+static uint8_t *APP_CAN_outputReserve(void)
+{
+    if ((APP_FW_UpdateStateGet() == APP_FW_UPDATE_STATE_IDLE) &&
+        (APP_UART_QueueFreeGet(APP_UART_QUEUE_BLE) < APP_CAN_OUTPUT_MAX_SIZE))
     {
-        dlc = 0x9U;
+        return NULL;
     }
-    else if (length <= 16U)
+    return APP_UART_QueueReserve(APP_UART_QUEUE_DEBUG, APP_CAN_OUTPUT_MAX_SIZE);
+}
+
+/* Sends what was written to the reserved room on both links */
+static void APP_CAN_outputCommit(const uint8_t *output, size_t length)
+{
+    APP_UART_QueueCommit(APP_UART_QUEUE_DEBUG, length);
+    if (APP_FW_UpdateStateGet() == APP_FW_UPDATE_STATE_IDLE)
     {
-        dlc = 0xAU;
+        APP_UART_QueueWrite(APP_UART_QUEUE_BLE, output, length);
     }
-    else if (length <= 20U)
+}
+
+/* Print Rx message received by the CAN controller. The text line or binary
+   record is built in place in the debug queue and copied to the BLE queue.
+   Returns false, without output, when either queue is short of room. */
+static bool APP_CAN_outputMessage(const APP_CAN_RING_ENTRY *entry)
+{
+    uint8_t *output = APP_CAN_outputReserve();
+    size_t length = 0;
+
+    if (output == NULL)
     {
-        dlc = 0xBU;
+        return false;
     }
-    else if (length <= 24U)
+
+    /* Checked only once there is room, a retried frame would look unchanged */
+    if ((APP_CAN_changedOnly == true) && (APP_CAN_ChangeCheck(APP_CAN_RING_FRAME(entry)) == false))
     {
-        dlc = 0xCU;
+        APP_UART_QueueCommit(APP_UART_QUEUE_DEBUG, 0);
+        return true;
     }
-    else if (length <= 32U)
+
+    if (APP_CAN_outputMode == APP_CAN_OUTPUT_BINARY)
     {
-        dlc = 0xDU;
+        /* One framed record per frame */
+        length = APP_CAN_RecordEncode(entry, output, APP_CAN_OUTPUT_MAX_SIZE);
     }
-    else if (length <= 48U)
+    else if (APP_CAN_outputMode == APP_CAN_OUTPUT_DELTA)
     {
-        dlc = 0xEU;
+        /* Only the changed payload bytes, with periodic keyframes */
+        length = APP_CAN_RecordEncodeDelta(entry, output, APP_CAN_OUTPUT_MAX_SIZE);
     }
     else
     {
-        dlc = 0xFU;
+        /* One candump style line per frame */
+        length = APP_CAN_FormatLine(entry, (char *)output);
     }
-    return dlc;
-}
-
-/* Data length code to Message Length */
-static uint8_t CANDlcToLengthGet(uint8_t dlc)
-{
-    uint8_t msgLength[] = {0U, 1U, 2U, 3U, 4U, 5U, 6U, 7U, 8U, 12U, 16U, 20U, 24U, 32U, 48U, 64U};
-    return msgLength[dlc];
-}
 
-static void APP_CAN_menu(void)
-{   
-	DEBUG_OUTPUT3("\r\n\r\n[CAN] Demo Menu Options :\r\n"
-	       "  --> Enter a key to select one of the following actions:\r\n"
-	       "  [1] Send FD standard message with ID: 0x45A and 64 byte data 0 to 63 \r\n"
-	       "  [2] Send FD standard message with ID: 0x469 and 64 byte data 128 to 191 \r\n"
-	       "  [3] Send FD extended message with ID: 0x100000A5 and 64 byte data 0 to 63 \r\n"
-	       "  [4] Send FD extended message with ID: 0x10000096 and 64 byte data 128 to 191 \r\n"
-	       "  [5] Send normal standard message with ID: 0x469 and 8 byte data 0 to 7 \r\n"
-	       "  [M/m] Display options in this menu \r\n"
-	       "  [R/r] Reset MCU \r\n\r\n");
+    APP_CAN_outputCommit(output, length);
+    return true;
 }
 
-/* Print Rx message received by the CAN controller */
-static void APP_CAN_outputMessage(uint8_t numberOfMessage, CAN_RX_BUFFER *rxBuf, uint8_t rxBufLen, uint8_t rxFifoBuf)
+/* Reports one statistics table slot per call while a report is running */
+static void APP_CAN_statsService(void)
 {
-    uint8_t length = 0;
-    uint8_t msgLength = 0;
-    uint32_t id = 0;
+    APP_CAN_STATS stats;
+    uint8_t *output = NULL;
+    size_t length = 0;
+    uint32_t now = 0;
 
-    if (rxFifoBuf == 0)
-    {
-        sprintf((char*)uartTxBuffer, "[CAN] Rx FIFO0 (Standard Frames) >");
-        DEBUG_OUTPUT2((char*)uartTxBuffer);
-        BLE_OUTPUT2((char*)uartTxBuffer);
-    }
-    else if (rxFifoBuf == 1)
-    {
-        sprintf((char*)uartTxBuffer, "[CAN] Rx FIFO1 (Extended Frames) >");
-        DEBUG_OUTPUT2((char*)uartTxBuffer);
-        BLE_OUTPUT2((char*)uartTxBuffer);
-    }
-    else if (rxFifoBuf == 2)
+    while (APP_CAN_statsDumpIndex >= 0)
     {
-        sprintf((char*)uartTxBuffer, "[CAN] Rx Buffer >");
-        DEBUG_OUTPUT2((char*)uartTxBuffer);
-        BLE_OUTPUT2((char*)uartTxBuffer);
-    }
-    
-    for (uint8_t count = 0; count < numberOfMessage; count++)
-    {
-        /* Print message to Console */
-        sprintf((char*)uartTxBuffer, " New Message Received: ");
-        DEBUG_OUTPUT2((char*)uartTxBuffer);
-        BLE_OUTPUT2((char*)uartTxBuffer);
-        id = rxBuf->xtd ? rxBuf->id : READ_ID(rxBuf->id);
-        msgLength = CANDlcToLengthGet(rxBuf->dlc);
-        length = msgLength;
-        sprintf((char*)uartTxBuffer, "[ Timestamp = 0x%x | ID = 0x%x | Length = %d | Data : ", (unsigned int)rxBuf->rxts, (unsigned int)id, (unsigned int)msgLength);
-        DEBUG_OUTPUT2((char*)uartTxBuffer);
-        BLE_OUTPUT2((char*)uartTxBuffer);
-        while(length)
+        if (APP_CAN_statsDumpIndex >= (int32_t)APP_CAN_STATS_IDS)
         {
-            sprintf((char*)uartTxBuffer, "0x%x ", rxBuf->data[msgLength - length--]);
-            DEBUG_OUTPUT2((char*)uartTxBuffer);
-            BLE_OUTPUT2((char*)uartTxBuffer);
+            APP_CAN_statsDumpIndex = -1;
+            if (APP_CAN_outputMode == APP_CAN_OUTPUT_TEXT)
+            {
+                sprintf((char*)uartTxBuffer, "[STATS] End of report, %u frames not tracked\r\n",
+                        (unsigned int)APP_CAN_StatsUntrackedGet());
+                DEBUG_OUTPUT2((char*)uartTxBuffer);
+                BLE_OUTPUT2((char*)uartTxBuffer);
+            }
+            break;
+        }
+        if (APP_CAN_StatsGet((uint32_t)APP_CAN_statsDumpIndex, &stats) == false)
+        {
+            APP_CAN_statsDumpIndex++;
+            continue;
+        }
+        output = APP_CAN_outputReserve();
+        if (output == NULL)
+        {
+            break;
         }
-        sprintf((char*)uartTxBuffer, " ]\r\n");
-        DEBUG_OUTPUT2((char*)uartTxBuffer);
-        BLE_OUTPUT2((char*)uartTxBuffer);
-        rxBuf += rxBufLen;
-    }
-}
-
-/* This function will be called by CAN PLIB when transfer is completed from Tx FIFO */
-void APP_CAN_TxFifoCallback(uintptr_t context)
-{
-    xferContext = context;
-
-    /* Check CAN Status */
-    status = CAN1_ErrorGet();
 
-    if (((status & CAN_PSR_LEC_Msk) == CAN_ERROR_NONE) || ((status & CAN_PSR_LEC_Msk) == CAN_ERROR_LEC_NC))
-    {
-        switch ((APP_CAN_STATES)context)
+        if (APP_CAN_outputMode == APP_CAN_OUTPUT_TEXT)
         {
-            case APP_CAN_STATE_TRANSMIT:
+            length = snprintf((char*)output, APP_CAN_OUTPUT_MAX_SIZE, "[STATS] %0*X count=%u bytes=%u period(us) min=%u avg=%u max=%u jitter=%u fd=%u brs=%u esi=%u rtr=%u\r\n",
+                             stats.xtd ? 8 : 3, (unsigned int)stats.id, (unsigned int)stats.count, (unsigned int)stats.bytes,
+                             (unsigned int)(stats.minPeriod * APP_CAN_US_PER_TICK), (unsigned int)(stats.avgPeriod * APP_CAN_US_PER_TICK),
+                             (unsigned int)(stats.maxPeriod * APP_CAN_US_PER_TICK), (unsigned int)(stats.jitter * APP_CAN_US_PER_TICK),
+                             (unsigned int)stats.fdf, (unsigned int)stats.brs, (unsigned int)stats.esi, (unsigned int)stats.rtr);
+            if (length >= APP_CAN_OUTPUT_MAX_SIZE)
             {
-                state = APP_CAN_STATE_XFER_SUCCESSFUL;
-                break;
+                /* Truncated, very large counters only */
+                length = APP_CAN_OUTPUT_MAX_SIZE - 1U;
             }
-            default:
-                break;
         }
-    }
-    else
-    {
-        state = APP_CAN_STATE_XFER_ERROR;
+        else
+        {
+            /* Current CAN time, see CAN1_RxTimestampExtend */
+            __disable_irq();
+            now = CAN1_RxTimestampExtend((uint16_t)CAN1_REGS->CAN_TSCV);
+            __enable_irq();
+            length = APP_CAN_RecordEncodeStats(&stats, now, output, APP_CAN_OUTPUT_MAX_SIZE);
+        }
+        APP_CAN_outputCommit(output, length);
+        APP_CAN_statsDumpIndex++;
     }
 }
 
-void APP_CAN_RxBufferCallback(uint8_t numberOfMessage, uintptr_t context)
+/* Reports the firmware update state and progress */
+static void APP_CAN_updateReport(void)
 {
-    APP_CAN_numberOfMessage = numberOfMessage;
-    xferContext = context;
-    APP_CAN_rxBufferCallback = true;
+    static const char * const stateName[] = {"idle", "receiving", "verified, waiting for the swap", "swapping banks"};
+    uint32_t size = 0;
+    uint32_t written = 0;
+
+    APP_FW_UpdateProgressGet(&size, &written);
+    sprintf((char*)uartTxBuffer, "\r\n[UPDATE] Firmware update %s, %u of %u bytes, %u bytes from the BLE module lost\r\n",
+            stateName[APP_FW_UpdateStateGet()], (unsigned int)written, (unsigned int)size,
+            (unsigned int)APP_UART_ReceiveLostGet(APP_UART_QUEUE_BLE));
+    DEBUG_OUTPUT2((char*)uartTxBuffer);
 }
 
-/* This function will be called by CAN PLIB when Message received in Rx Buffer */
-void APP_CAN_RxBufferProcess(uint8_t bufferNumber, uintptr_t context)
+/* Prints the bus load of the 100 ms, 1 s and 10 s windows */
+static void APP_CAN_loadReport(void)
 {
-    xferContext = context;
+    static const char * const windowName[] = {"100 ms", "1 s", "10 s"};
+    APP_CAN_LOAD load;
+    uint32_t now = 0;
+    uint32_t window = 0;
+
+    /* Windows end at the current CAN time, not at the last received frame */
+    __disable_irq();
+    now = CAN1_RxTimestampExtend((uint16_t)CAN1_REGS->CAN_TSCV);
+    __enable_irq();
+    APP_CAN_LoadAdvance(now);
+
+    DEBUG_OUTPUT3("\r\n[LOAD] Bus load (arbitration + data phase):\r\n");
+    for (window = APP_CAN_LOAD_WINDOW_100MS; window <= APP_CAN_LOAD_WINDOW_10S; window++)
+    {
+        APP_CAN_LoadGet((APP_CAN_LOAD_WINDOW)window, &load);
+        sprintf((char*)uartTxBuffer, "[LOAD] %6s: %3u.%02u%% (%u.%02u%% + %u.%02u%%)\r\n", windowName[window],
+                (unsigned int)(load.total / 100U), (unsigned int)(load.total % 100U),
+                (unsigned int)(load.arbitration / 100U), (unsigned int)(load.arbitration % 100U),
+                (unsigned int)(load.data / 100U), (unsigned int)(load.data % 100U));
+        DEBUG_OUTPUT2((char*)uartTxBuffer);
+        BLE_OUTPUT2((char*)uartTxBuffer);
+    }
+}
 
-    /* Check CAN Status */
-    status = CAN1_ErrorGet();
+/* Copy one element out of Message RAM into the capture ring.
+   Called by CAN PLIB from the CAN1 interrupt context. */
+static void APP_CAN_capture(APP_CAN_RX_SOURCE source, uint8_t bufferNumber)
+{
+    APP_CAN_RING_ENTRY *entry = APP_CAN_RingWriteSlotGet();
+    CAN_RX_BUFFER *rxBuf = (entry != NULL) ? APP_CAN_RING_FRAME(entry) : (CAN_RX_BUFFER *)rxDiscard;
+    bool received = false;
 
-    if (((status & CAN_PSR_LEC_Msk) == CAN_ERROR_NONE) || ((status & CAN_PSR_LEC_Msk) == CAN_ERROR_LEC_NC))
+    /* Always read the element so that the hardware slot is acknowledged */
+    if (source == APP_CAN_RX_SOURCE_FIFO0)
     {
-        switch ((APP_CAN_STATES)context)
-        {
-            case APP_CAN_STATE_RECEIVE:
-            {
-                memset(rxBuffer, 0x00, CAN1_RX_BUFFER_ELEMENT_SIZE);
-                if (CAN1_MessageReceive(bufferNumber, (CAN_RX_BUFFER *)rxBuffer) == true)
-                {
-                    APP_CAN_outputMessage(1, (CAN_RX_BUFFER *)rxBuffer, CAN1_RX_BUFFER_ELEMENT_SIZE, 2);
-                    state = APP_CAN_STATE_XFER_SUCCESSFUL;
-                }
-                else
-                {
-                    state = APP_CAN_STATE_XFER_ERROR;
-                }
-                break;
-            }
-            default:
-                break;
-        }
+        received = CAN1_MessageReceiveFifo(CAN_RX_FIFO_0, 1, rxBuf);
+    }
+    else if (source == APP_CAN_RX_SOURCE_FIFO1)
+    {
+        received = CAN1_MessageReceiveFifo(CAN_RX_FIFO_1, 1, rxBuf);
     }
     else
     {
-        state = APP_CAN_STATE_XFER_ERROR;
+        received = CAN1_MessageReceive(bufferNumber, rxBuf);
+    }
+
+    if (received == true)
+    {
+        APP_CAN_BitRateAutoFrameAdd(rxBuf);
+    }
+    if ((entry != NULL) && (received == true) &&
+        (APP_CAN_IdFilterAccept(rxBuf->xtd ? rxBuf->id : READ_ID(rxBuf->id), rxBuf->xtd) == true))
+    {
+        entry->timestamp = CAN1_RxTimestampExtend((uint16_t)rxBuf->rxts);
+        entry->source = (uint8_t)source;
+        APP_CAN_RingWriteCommit();
     }
 }
 
-void APP_CAN_RxFifo0Callback(uint8_t numberOfMessage, uintptr_t context)
+/* This function will be called by CAN PLIB when Message received in Rx Buffer */
+void APP_CAN_RxBufferCallback(uint8_t bufferNumber, uintptr_t context)
 {
-    APP_CAN_numberOfMessage = numberOfMessage;
-    xferContext = context;
-    APP_CAN_rxFifo0Callback = true;
+    APP_CAN_capture(APP_CAN_RX_SOURCE_BUFFER, bufferNumber);
 }
 
 /* This function will be called by CAN PLIB when Message received in Rx FIFO0 */
-void APP_CAN_RxFifo0Process(uint8_t numberOfMessage, uintptr_t context)
+void APP_CAN_RxFifo0Callback(uint8_t numberOfMessage, uintptr_t context)
 {
-    xferContext = context;
-
-    /* Check CAN Status */
-    status = CAN1_ErrorGet();
-
-    if (((status & CAN_PSR_LEC_Msk) == CAN_ERROR_NONE) || ((status & CAN_PSR_LEC_Msk) == CAN_ERROR_LEC_NC))
-    {
-        switch ((APP_CAN_STATES)context)
-        {
-            case APP_CAN_STATE_RECEIVE:
-            {
-                memset(rxFiFo0, 0x00, (numberOfMessage * CAN1_RX_FIFO0_ELEMENT_SIZE));
-                if (CAN1_MessageReceiveFifo(CAN_RX_FIFO_0, numberOfMessage, (CAN_RX_BUFFER *)rxFiFo0) == true)
-                {
-                    APP_CAN_outputMessage(numberOfMessage, (CAN_RX_BUFFER *)rxFiFo0, CAN1_RX_FIFO0_ELEMENT_SIZE, 0);
-                    state = APP_CAN_STATE_XFER_SUCCESSFUL;
-                }
-                else
-                {
-                    state = APP_CAN_STATE_XFER_ERROR;
-                }
-                break;
-            }
-            default:
-                break;
-        }
-    }
-    else
+    while (numberOfMessage-- > 0U)
     {
-        state = APP_CAN_STATE_XFER_ERROR;
+        APP_CAN_capture(APP_CAN_RX_SOURCE_FIFO0, 0);
     }
 }
 
+/* This function will be called by CAN PLIB when Message received in Rx FIFO1 */
 void APP_CAN_RxFifo1Callback(uint8_t numberOfMessage, uintptr_t context)
 {
-    APP_CAN_numberOfMessage = numberOfMessage;
-    xferContext = context;
-    APP_CAN_rxFifo1Callback = true;
+    while (numberOfMessage-- > 0U)
+    {
+        APP_CAN_capture(APP_CAN_RX_SOURCE_FIFO1, 0);
+    }
 }
 
-/* This function will be called by CAN PLIB when Message received in Rx FIFO1 */
-void APP_CAN_RxFifo1Process(uint8_t numberOfMessage, uintptr_t context)
+/* Parses a list of hex IDs separated by spaces or commas. An ID followed
+   by x is extended, first-last adds a range of IDs. */
+static bool APP_CAN_idListParse(const char *line, bool (*add)(uint32_t id, bool xtd))
 {
-    xferContext = context;
-
-    /* Check CAN Status */
-    status = CAN1_ErrorGet();
+    char *end = NULL;
+    uint32_t first = 0;
+    uint32_t last = 0;
+    bool xtd = false;
 
-    if (((status & CAN_PSR_LEC_Msk) == CAN_ERROR_NONE) || ((status & CAN_PSR_LEC_Msk) == CAN_ERROR_LEC_NC))
+    while (*line != '\0')
     {
-        switch ((APP_CAN_STATES)context)
+        if ((*line == ' ') || (*line == ','))
+        {
+            line++;
+            continue;
+        }
+        first = strtoul(line, &end, 16);
+        if (end == line)
         {
-            case APP_CAN_STATE_RECEIVE:
+            return false;
+        }
+        last = first;
+        line = end;
+        if (*line == '-')
+        {
+            line++;
+            last = strtoul(line, &end, 16);
+            if ((end == line) || (last < first))
             {
-                memset(rxFiFo1, 0x00, (numberOfMessage * CAN1_RX_FIFO1_ELEMENT_SIZE));
-                if (CAN1_MessageReceiveFifo(CAN_RX_FIFO_1, numberOfMessage, (CAN_RX_BUFFER *)rxFiFo1) == true)
-                {
-                    APP_CAN_outputMessage(numberOfMessage, (CAN_RX_BUFFER *)rxFiFo1, CAN1_RX_FIFO1_ELEMENT_SIZE, 1);
-                    state = APP_CAN_STATE_XFER_SUCCESSFUL;
-                }
-                else
-                {
-                    state = APP_CAN_STATE_XFER_ERROR;
-                }
-                break;
+                return false;
             }
-            default:
+            line = end;
+        }
+        xtd = false;
+        if ((*line == 'x') || (*line == 'X'))
+        {
+            xtd = true;
+            line++;
+        }
+        for (; first <= last; first++)
+        {
+            if (add(first, xtd) == false)
+            {
+                return false;
+            }
+            if (first == last)
+            {
                 break;
+            }
         }
     }
-    else
-    {
-        state = APP_CAN_STATE_XFER_ERROR;
-    }
+    return true;
 }
 
-void APP_CAN_command(char user_input)
-{       
-    /* Check for user input on the CAN FD demo terminal window and process command */
-    if (state == APP_CAN_STATE_USER_INPUT) {
-        /* Read user input */
-        //scanf("%c", (char *) &user_input);
+/* Parses up to size hex bytes, returns the number of bytes */
+static uint32_t APP_CAN_hexBytesParse(const char *text, uint8_t *bytes, uint32_t size, const char **end)
+{
+    char pair[3] = {0};
+    char *pairEnd = NULL;
+    uint32_t count = 0;
 
-        switch (user_input) {
-            case '1':
-                memset(txFiFo, 0x00, CAN1_TX_FIFO_BUFFER_ELEMENT_SIZE);
-                txBuffer = (CAN_TX_BUFFER *) txFiFo;
-                txBuffer->id = WRITE_ID(0x45A);
-                txBuffer->dlc = CANLengthToDlcGet(64);
-                txBuffer->fdf = 1;
-                txBuffer->brs = 1;
-                for (loop_count = 0; loop_count < 64; loop_count++) {
-                    txBuffer->data[loop_count] = loop_count;
-                }
-                DEBUG_OUTPUT3("\r\n[CAN] Send FD standard message with ID: 0x45A and 64 byte data 0 to 63.\r\n");
-                CAN1_TxFifoCallbackRegister(APP_CAN_TxFifoCallback, (uintptr_t) APP_CAN_STATE_TRANSMIT);
-                state = APP_CAN_STATE_IDLE;
-                if (CAN1_MessageTransmitFifo(1, txBuffer) == false) {
-                    DEBUG_OUTPUT3("[CAN] Message send failed!!! \r\n");
-                }
-                break;
-            case '2':
-                memset(txFiFo, 0x00, CAN1_TX_FIFO_BUFFER_ELEMENT_SIZE);
-                txBuffer = (CAN_TX_BUFFER *) txFiFo;
-                txBuffer->id = WRITE_ID(0x469);
-                txBuffer->dlc = CANLengthToDlcGet(64);
-                txBuffer->fdf = 1;
-                txBuffer->brs = 1;
-                for (loop_count = 128; loop_count < 192; loop_count++) {
-                    txBuffer->data[loop_count - 128] = loop_count;
-                }
-                DEBUG_OUTPUT3("\r\n[CAN] Send FD standard message with ID: 0x469 and 64 byte data 128 to 191.\r\n");
-                CAN1_TxFifoCallbackRegister(APP_CAN_TxFifoCallback, (uintptr_t) APP_CAN_STATE_TRANSMIT);
-                state = APP_CAN_STATE_IDLE;
-                if (CAN1_MessageTransmitFifo(1, txBuffer) == false) {
-                    DEBUG_OUTPUT3("[CAN] Message send failed!!! \r\n");
-                }
-                break;
-            case '3':
-                memset(txFiFo, 0x00, CAN1_TX_FIFO_BUFFER_ELEMENT_SIZE);
-                txBuffer = (CAN_TX_BUFFER *) txFiFo;
-                txBuffer->id = 0x100000A5;
-                txBuffer->dlc = CANLengthToDlcGet(64);
-                txBuffer->xtd = 1;
-                txBuffer->fdf = 1;
-                txBuffer->brs = 1;
-                for (loop_count = 0; loop_count < 64; loop_count++) {
-                    txBuffer->data[loop_count] = loop_count;
-                }
-                DEBUG_OUTPUT3("\r\n[CAN] Send FD extended message with ID: 0x100000A5 and 64 byte data 0 to 63.\r\n");
-                CAN1_TxFifoCallbackRegister(APP_CAN_TxFifoCallback, (uintptr_t) APP_CAN_STATE_TRANSMIT);
-                state = APP_CAN_STATE_IDLE;
-                if (CAN1_MessageTransmitFifo(1, txBuffer) == false) {
-                    DEBUG_OUTPUT3("[CAN] Message send failed!!! \r\n");
-                }
-                break;
-            case '4':
-                memset(txFiFo, 0x00, CAN1_TX_FIFO_BUFFER_ELEMENT_SIZE);
-                txBuffer = (CAN_TX_BUFFER *) txFiFo;
-                txBuffer->id = 0x10000096;
-                txBuffer->dlc = CANLengthToDlcGet(64);
-                txBuffer->xtd = 1;
-                txBuffer->fdf = 1;
-                txBuffer->brs = 1;
-                for (loop_count = 128; loop_count < 192; loop_count++) {
-                    txBuffer->data[loop_count - 128] = loop_count;
-                }
-                DEBUG_OUTPUT3("\r\n[CAN] Send FD extended message with ID: 0x10000096 and 64 byte data 128 to 191.\r\n");
-                CAN1_TxFifoCallbackRegister(APP_CAN_TxFifoCallback, (uintptr_t) APP_CAN_STATE_TRANSMIT);
-                state = APP_CAN_STATE_IDLE;
-                if (CAN1_MessageTransmitFifo(1, txBuffer) == false) {
-                    DEBUG_OUTPUT3("[CAN] Message send failed!!! \r\n");
-                }
-                break;
-            case '5':
-                memset(txFiFo, 0x00, CAN1_TX_FIFO_BUFFER_ELEMENT_SIZE);
-                txBuffer = (CAN_TX_BUFFER *) txFiFo;
-                txBuffer->id = WRITE_ID(0x469);
-                txBuffer->dlc = 8;
-                for (loop_count = 0; loop_count < 8; loop_count++) {
-                    txBuffer->data[loop_count] = loop_count;
-                }
-                DEBUG_OUTPUT3("\r\n[CAN] Send normal standard message with ID: 0x469 and 8 byte data 0 to 7.\r\n");
-                CAN1_TxFifoCallbackRegister(APP_CAN_TxFifoCallback, (uintptr_t) APP_CAN_STATE_TRANSMIT);
-                state = APP_CAN_STATE_IDLE;
-                if (CAN1_MessageTransmitFifo(1, txBuffer) == false) {
-                    DEBUG_OUTPUT3("[CAN] Message send failed!!! \r\n");
-                }
-                break;
-            case 'm': case 'M':
-                APP_CAN_menu();
-                break;
-            case 'r': case 'R':
-                NVIC_SystemReset();
-                break;
-            default:
-                DEBUG_OUTPUT3("\r\n[***ERROR***] An invalid menu item was selected... \r\n");
-                break;
-        }
+    while ((count < size) && isxdigit((unsigned char)text[0]) && isxdigit((unsigned char)text[1]))
+    {
+        pair[0] = text[0];
+        pair[1] = text[1];
+        bytes[count++] = (uint8_t)strtoul(pair, &pairEnd, 16);
+        text += 2;
     }
+    *end = text;
+    return count;
 }
 
-void APP_CAN_state(void)
+/* Parses a trigger description: any of "id <hex ID>[x]",
+   "data <byte offset> <hex bytes>[/<hex mask>]", "error", "pin" and
+   "post <frames after the trigger>" */
+static bool APP_CAN_triggerParse(char *line, APP_CAN_TRIGGER_CONFIG *config)
 {
-    /* Check the application's current state. */
-    switch (state) {
-        case APP_CAN_STATE_IDLE:
+    char *token = strtok(line, " ");
+    char *end = NULL;
+    const char *next = NULL;
+    uint32_t count = 0;
+
+    memset(config, 0, sizeof(*config));
+    while (token != NULL)
+    {
+        if (strcmp(token, "id") == 0)
         {
-            /* Application can do other task here */
-            break;
+            token = strtok(NULL, " ");
+            if (token == NULL)
+            {
+                return false;
+            }
+            config->id = strtoul(token, &end, 16);
+            config->xtd = ((*end == 'x') || (*end == 'X'));
+            if ((end == token) || (config->id > (config->xtd ? 0x1FFFFFFFUL : 0x7FFUL)))
+            {
+                return false;
+            }
+            config->idMatch = true;
+            config->sources |= APP_CAN_TRIGGER_SOURCE_FRAME;
         }
-        case APP_CAN_STATE_XFER_SUCCESSFUL:
+        else if (strcmp(token, "data") == 0)
         {
-            if ((APP_CAN_STATES) xferContext == APP_CAN_STATE_TRANSMIT) {
-                DEBUG_OUTPUT3("[CAN] Message sent successfully!\r\n");
+            token = strtok(NULL, " ");
+            if (token == NULL)
+            {
+                return false;
             }
-            state = APP_CAN_STATE_USER_INPUT;
-            break;
+            config->offset = (uint8_t)strtoul(token, &end, 10);
+            token = strtok(NULL, " ");
+            if ((token == NULL) || (config->offset >= 64U))
+            {
+                return false;
+            }
+            count = APP_CAN_hexBytesParse(token, config->value, APP_CAN_TRIGGER_PATTERN_SIZE, &next);
+            if (count == 0U)
+            {
+                return false;
+            }
+            memset(config->mask, 0xFF, count);
+            if (*next == '/')
+            {
+                memset(config->mask, 0, sizeof(config->mask));
+                (void)APP_CAN_hexBytesParse(next + 1, config->mask, count, &next);
+            }
+            config->sources |= APP_CAN_TRIGGER_SOURCE_FRAME;
         }
-        case APP_CAN_STATE_XFER_ERROR:
+        else if (strcmp(token, "post") == 0)
         {
-            if ((APP_CAN_STATES) xferContext == APP_CAN_STATE_RECEIVE) {
-                DEBUG_OUTPUT3("[CAN] Error in received message!\r\n");
-            } else {
-                DEBUG_OUTPUT3("[CAN] Message send failed!\r\n");
+            token = strtok(NULL, " ");
+            if (token == NULL)
+            {
+                return false;
             }
-            state = APP_CAN_STATE_USER_INPUT;
-            break;
+            config->postFrames = strtoul(token, &end, 10);
         }
-        default:
+        else if (strcmp(token, "error") == 0)
         {
-            break;
+            config->sources |= APP_CAN_TRIGGER_SOURCE_ERROR;
         }
+        else if (strcmp(token, "pin") == 0)
+        {
+            config->sources |= APP_CAN_TRIGGER_SOURCE_PIN;
+        }
+        else
+        {
+            return false;
+        }
+        token = strtok(NULL, " ");
     }
-    
-    if (APP_CAN_rxFifo0Callback == true)
-    {
-        APP_CAN_rxFifo0Callback = false;
-        APP_CAN_RxFifo0Process(APP_CAN_numberOfMessage, xferContext);
-    }
-    if (APP_CAN_rxFifo1Callback == true)
-    {
-        APP_CAN_rxFifo1Callback = false;
-        APP_CAN_RxFifo1Process(APP_CAN_numberOfMessage, xferContext);
-    }
-    if (APP_CAN_rxBufferCallback == true)
-    {
-        APP_CAN_rxBufferCallback = false;
-        APP_CAN_RxBufferProcess(APP_CAN_numberOfMessage, xferContext);
-    }
+    return (config->sources != 0U);
 }
 
-void APP_LED_toggle(void)
+/* Runs flash recorder commands: "on", "off", "freeze <frames after the
+   event>", "nofreeze", "unfreeze", "erase" and "dump", nothing for the
+   status. "time <from ms> <to ms>" and "id <hex ID>[x]" select the frames
+   to dump, "raw" sends the log area as it is in flash. */
+static bool APP_CAN_flashLogParse(char *line)
 {
-    if (isRTCExpired == true) {
-        isRTCExpired = false;
-        LED0_Toggle();       
-    }
-    /* Maintain state machines of all polled MPLAB Harmony modules */
-    if (changeTempSamplingRate == true) {
-        changeTempSamplingRate = false;
-        if (tempSampleRate == RTC_INTERRUPT_RATE_500MS) {
-            tempSampleRate = RTC_INTERRUPT_RATE_1S;
-            RTC_Timer32Compare0Set(PERIOD_1S);
+    static const char * const stateName[] = {"off", "recording", "freezing", "frozen", "erasing"};
+    APP_CAN_FLASHLOG_STATUS status;
+    APP_CAN_FLASHLOG_STATE current = APP_CAN_FLASHLOG_STATE_OFF;
+    char *token = strtok(line, " ");
+    char *end = NULL;
+
+    memset(&APP_CAN_dumpQuery, 0, sizeof(APP_CAN_dumpQuery));
+    APP_CAN_dumpQuery.end = UINT32_MAX;
+    APP_CAN_dumpQueryActive = false;
+    while (token != NULL)
+    {
+        if (strcmp(token, "on") == 0)
+        {
+            APP_CAN_FlashLogEnable(true);
+        }
+        else if (strcmp(token, "off") == 0)
+        {
+            APP_CAN_FlashLogEnable(false);
+        }
+        else if (strcmp(token, "freeze") == 0)
+        {
+            token = strtok(NULL, " ");
+            if (token == NULL)
+            {
+                return false;
+            }
+            APP_CAN_FlashLogFreezeSet(true, strtoul(token, &end, 10));
+        }
+        else if (strcmp(token, "nofreeze") == 0)
+        {
+            APP_CAN_FlashLogFreezeSet(false, 0);
+        }
+        else if (strcmp(token, "unfreeze") == 0)
+        {
+            APP_CAN_FlashLogUnfreeze();
+        }
+        else if (strcmp(token, "erase") == 0)
+        {
+            APP_CAN_FlashLogErase();
+        }
+        else if (strcmp(token, "time") == 0)
+        {
+            token = strtok(NULL, " ");
+            if (token == NULL)
+            {
+                return false;
+            }
+            APP_CAN_dumpQuery.start = strtoul(token, &end, 10) * (APP_CAN_FORMAT_TICKS_PER_SECOND / 1000U);
+            token = strtok(NULL, " ");
+            if (token == NULL)
+            {
+                return false;
+            }
+            APP_CAN_dumpQuery.end = strtoul(token, &end, 10) * (APP_CAN_FORMAT_TICKS_PER_SECOND / 1000U);
+            APP_CAN_dumpQueryActive = true;
+        }
+        else if (strcmp(token, "id") == 0)
+        {
+            token = strtok(NULL, " ");
+            if (token == NULL)
+            {
+                return false;
+            }
+            APP_CAN_dumpQuery.id = strtoul(token, &end, 16);
+            APP_CAN_dumpQuery.xtd = ((*end == 'x') || (*end == 'X'));
+            if ((end == token) || (APP_CAN_dumpQuery.id > (APP_CAN_dumpQuery.xtd ? 0x1FFFFFFFUL : 0x7FFUL)))
+            {
+                return false;
+            }
+            APP_CAN_dumpQuery.idMatch = true;
+            APP_CAN_dumpQueryActive = true;
+        }
+        else if ((strcmp(token, "dump") == 0) || (strcmp(token, "raw") == 0) || (strcmp(token, "replay") == 0))
+        {
+            APP_CAN_dumpRaw = (strcmp(token, "raw") == 0);
+            APP_CAN_dumpReplay = (strcmp(token, "replay") == 0);
+            APP_CAN_FlashLogStatusGet(&status);
+            current = status.state;
+            APP_CAN_dumpResume = ((current == APP_CAN_FLASHLOG_STATE_RECORDING) ||
+                                  (current == APP_CAN_FLASHLOG_STATE_FREEZING));
+            APP_CAN_FlashLogEnable(false);
+            APP_CAN_dumpState = APP_CAN_DUMP_FLUSH;
+        }
+        else
+        {
+            return false;
+        }
+        token = strtok(NULL, " ");
+    }
+
+    APP_CAN_FlashLogStatusGet(&status);
+    sprintf((char*)uartTxBuffer, "\r\n[FLASH] Recorder %s, page sequence %u, %u messages dropped, %u write errors\r\n",
+            stateName[status.state], (unsigned int)status.sequence, (unsigned int)status.dropped,
+            (unsigned int)status.errors);
+    DEBUG_OUTPUT2((char*)uartTxBuffer);
+    return true;
+}
+
+/* Sets the operation of CAN1 on the bus. A passive mode is entered before
+   the other one is left, so nothing is sent in between. */
+static void APP_CAN_busModeSet(APP_CAN_BUS_MODE mode)
+{
+    if ((mode == APP_CAN_BUS_RESTRICTED) && (CAN1_RestrictedOperationGet() == false))
+    {
+        CAN1_RestrictedOperationSet(true);
+    }
+    if ((mode == APP_CAN_BUS_LISTEN) != CAN1_BusMonitoringGet())
+    {
+        CAN1_BusMonitoringSet(mode == APP_CAN_BUS_LISTEN);
+    }
+    if ((mode == APP_CAN_BUS_RESTRICTED) != CAN1_RestrictedOperationGet())
+    {
+        CAN1_RestrictedOperationSet(mode == APP_CAN_BUS_RESTRICTED);
+    }
+    APP_CAN_busMode = mode;
+}
+
+/* Why nothing can be sent now, NULL when frames can be sent */
+static const char *APP_CAN_transmitBlockGet(void)
+{
+    if (APP_CAN_BitRateAutoStateGet() != APP_CAN_BITRATE_AUTO_STATE_IDLE)
+    {
+        return "The bit rate detection is running, wait for its result.";
+    }
+    if (APP_CAN_busMode != APP_CAN_BUS_NORMAL)
+    {
+        return "CAN1 only listens, set mode normal with K first.";
+    }
+    return NULL;
+}
+
+/* Runs configuration commands: "save", "clear", "profile <n>", "profile
+   auto", "mode <normal|listen|restricted>" and "baud <debug baud> <BLE
+   baud>", nothing for the current settings. The bit rate profile and the
+   mode apply at once, a detected profile when the detection ends, the baud
+   rates after a save and a reset. */
+static bool APP_CAN_configParse(char *line)
+{
+    char *token = strtok(line, " ");
+    char *end = NULL;
+    uint32_t profile = 0;
+    uint32_t mode = 0;
+
+    while (token != NULL)
+    {
+        if (strcmp(token, "save") == 0)
+        {
+            APP_CAN_config.bitRateProfile = (uint8_t)APP_CAN_BitRateProfileGet();
+            APP_CAN_config.outputMode = (uint8_t)APP_CAN_outputMode;
+            APP_CAN_config.changedOnly = (uint8_t)APP_CAN_changedOnly;
+            APP_CAN_config.busMode = (uint8_t)APP_CAN_busMode;
+            if (APP_CAN_ConfigSave(&APP_CAN_config) == false)
+            {
+                DEBUG_OUTPUT3("\r\n[CONFIG] Save failed, check the SmartEEPROM fuses.\r\n");
+                return true;
+            }
+            DEBUG_OUTPUT3("\r\n[CONFIG] Saved, restored after every reset.\r\n");
+        }
+        else if (strcmp(token, "clear") == 0)
+        {
+            if (APP_CAN_ConfigErase() == false)
+            {
+                DEBUG_OUTPUT3("\r\n[CONFIG] Clear failed, check the SmartEEPROM fuses.\r\n");
+                return true;
+            }
+            DEBUG_OUTPUT3("\r\n[CONFIG] Cleared, the defaults are used after a reset.\r\n");
+        }
+        else if (strcmp(token, "profile") == 0)
+        {
+            token = strtok(NULL, " ");
+            if (token == NULL)
+            {
+                return false;
+            }
+            if (APP_CAN_BitRateAutoStateGet() != APP_CAN_BITRATE_AUTO_STATE_IDLE)
+            {
+                DEBUG_OUTPUT3("\r\n[CONFIG] The bit rate detection is running, wait for its result.\r\n");
+                return true;
+            }
+            if (strcmp(token, "auto") == 0)
+            {
+                if ((APP_CAN_ReplayStateGet() != APP_CAN_REPLAY_STATE_IDLE) || (APP_CAN_CyclicIsRunning() == true))
+                {
+                    DEBUG_OUTPUT3("\r\n[CONFIG] Stop the replay and the cyclic messages first, CAN1 only listens while detecting.\r\n");
+                    return true;
+                }
+                APP_CAN_BitRateAutoStart();
+                DEBUG_OUTPUT3("\r\n[CONFIG] Detecting the bit rates, CAN1 is listening only.\r\n");
+                return true;
+            }
+            profile = strtoul(token, &end, 10);
+            if ((end == token) || (APP_CAN_BitRateProfileSet(profile) == false))
+            {
+                return false;
+            }
+            APP_CAN_LoadInitialize();
+        }
+        else if (strcmp(token, "mode") == 0)
+        {
+            token = strtok(NULL, " ");
+            for (mode = APP_CAN_BUS_NORMAL; mode <= APP_CAN_BUS_RESTRICTED; mode++)
+            {
+                if ((token != NULL) && (strcmp(token, APP_CAN_busModeName[mode]) == 0))
+                {
+                    break;
+                }
+            }
+            if (mode > APP_CAN_BUS_RESTRICTED)
+            {
+                return false;
+            }
+            if (APP_CAN_BitRateAutoStateGet() != APP_CAN_BITRATE_AUTO_STATE_IDLE)
+            {
+                DEBUG_OUTPUT3("\r\n[CONFIG] The bit rate detection is running, wait for its result.\r\n");
+                return true;
+            }
+            if ((mode != APP_CAN_BUS_NORMAL) &&
+                ((APP_CAN_ReplayStateGet() != APP_CAN_REPLAY_STATE_IDLE) || (APP_CAN_CyclicIsRunning() == true)))
+            {
+                DEBUG_OUTPUT3("\r\n[CONFIG] Stop the replay and the cyclic messages first, CAN1 will only listen.\r\n");
+                return true;
+            }
+            APP_CAN_busModeSet((APP_CAN_BUS_MODE)mode);
+        }
+        else if (strcmp(token, "baud") == 0)
+        {
+            token = strtok(NULL, " ");
+            if (token == NULL)
+            {
+                return false;
+            }
+            APP_CAN_config.debugBaud = strtoul(token, &end, 10);
+            token = strtok(NULL, " ");
+            if (token == NULL)
+            {
+                return false;
+            }
+            APP_CAN_config.bleBaud = strtoul(token, &end, 10);
+        }
+        else
+        {
+            return false;
+        }
+        token = strtok(NULL, " ");
+    }
+
+    profile = APP_CAN_BitRateProfileGet();
+    sprintf((char*)uartTxBuffer, "\r\n[CONFIG] Profile %u: %u kbit/s nominal, %u kbit/s data, mode %s. Baud rates after reset: debug %u, BLE %u (0 = default)\r\n",
+            (unsigned int)profile, (unsigned int)(APP_CAN_BitRateNominalGet(profile) / 1000U),
+            (unsigned int)(APP_CAN_BitRateDataGet(profile) / 1000U), APP_CAN_busModeName[APP_CAN_busMode],
+            (unsigned int)APP_CAN_config.debugBaud, (unsigned int)APP_CAN_config.bleBaud);
+    DEBUG_OUTPUT2((char*)uartTxBuffer);
+    return true;
+}
+
+/* Reports the trace replay counters and timing errors */
+static void APP_CAN_replayReport(void)
+{
+    static const char * const stateName[] = {"idle", "running", "draining"};
+    APP_CAN_REPLAY_STATS stats;
+    int32_t errorMin = 0;
+    int32_t errorMax = 0;
+    uint32_t errorMean = 0;
+
+    APP_CAN_ReplayStatsGet(&stats);
+    if (stats.sent != 0U)
+    {
+        errorMin = stats.errorMin * (int32_t)APP_CAN_US_PER_TICK;
+        errorMax = stats.errorMax * (int32_t)APP_CAN_US_PER_TICK;
+        errorMean = (uint32_t)((stats.errorAbsSum * APP_CAN_US_PER_TICK) / stats.sent);
+    }
+    sprintf((char*)uartTxBuffer, "[REPLAY] Replay %s, %u queued, %u sent, %u dropped, %u invalid records, "
+            "%u Tx FIFO full. Error min %d us, max %d us, mean absolute %u us\r\n",
+            stateName[APP_CAN_ReplayStateGet()], (unsigned int)stats.queued, (unsigned int)stats.sent,
+            (unsigned int)stats.dropped, (unsigned int)stats.streamErrors, (unsigned int)stats.fifoFull,
+            (int)errorMin, (int)errorMax, (unsigned int)errorMean);
+    DEBUG_OUTPUT2((char*)uartTxBuffer);
+}
+
+/* Runs replay commands: "stream" takes the following bytes on the debug link
+   as records to replay, "stop" abandons the replay, nothing reports it */
+static bool APP_CAN_replayParse(char *line)
+{
+    char *token = strtok(line, " ");
+
+    if (token == NULL)
+    {
+        DEBUG_OUTPUT3("\r\n");
+        APP_CAN_replayReport();
+    }
+    else if (strcmp(token, "stream") == 0)
+    {
+        if (APP_CAN_transmitBlockGet() != NULL)
+        {
+            sprintf((char*)uartTxBuffer, "\r\n[REPLAY] %s\r\n", APP_CAN_transmitBlockGet());
+            DEBUG_OUTPUT2((char*)uartTxBuffer);
+            return true;
+        }
+        if (APP_CAN_ReplayStart() == false)
+        {
+            DEBUG_OUTPUT3("\r\n[REPLAY] A replay is running, stop it first.\r\n");
+            return true;
+        }
+        __disable_irq();
+        APP_CAN_replayStreamTime = CAN1_RxTimestampExtend((uint16_t)CAN1_REGS->CAN_TSCV);
+        __enable_irq();
+        APP_CAN_replayStream = true;
+        DEBUG_OUTPUT3("\r\n[REPLAY] Send the records, an end record or 2 s without data ends the stream.\r\n");
+    }
+    else if (strcmp(token, "stop") == 0)
+    {
+        APP_CAN_ReplayStop();
+        APP_CAN_replayStream = false;
+        DEBUG_OUTPUT3("\r\n[REPLAY] Stopped.\r\n");
+    }
+    else
+    {
+        return false;
+    }
+    return true;
+}
+
+/* Prints the transmit latency and arbitration delay histograms up to the
+   last bin used */
+static void APP_CAN_txEventReport(void)
+{
+    APP_CAN_TXEVENT_STATS stats;
+    uint32_t bins = 0;
+    uint32_t bin = 0;
+
+    APP_CAN_TxEventStatsGet(&stats);
+    sprintf((char*)uartTxBuffer, "[TX] %u frames sent, %u Tx events lost. Latency min %u us, mean %u us, max %u us. "
+            "Arbitration delay min %u us, mean %u us, max %u us\r\n",
+            (unsigned int)stats.latency.count, (unsigned int)stats.lost, (unsigned int)stats.latency.min,
+            (unsigned int)((stats.latency.count != 0U) ? (stats.latency.sum / stats.latency.count) : 0U),
+            (unsigned int)stats.latency.max, (unsigned int)stats.arbitration.min,
+            (unsigned int)((stats.arbitration.count != 0U) ? (stats.arbitration.sum / stats.arbitration.count) : 0U),
+            (unsigned int)stats.arbitration.max);
+    DEBUG_OUTPUT2((char*)uartTxBuffer);
+
+    for (bin = 0; bin < APP_CAN_TXEVENT_BINS; bin++)
+    {
+        if ((stats.latency.bins[bin] != 0U) || (stats.arbitration.bins[bin] != 0U))
+        {
+            bins = bin + 1U;
+        }
+    }
+    if (bins == 0U)
+    {
+        return;
+    }
+    DEBUG_OUTPUT3("[TX]  from (us)    latency  arbitration\r\n");
+    for (bin = 0; bin < bins; bin++)
+    {
+        sprintf((char*)uartTxBuffer, "[TX] %10u %10u %12u\r\n", (unsigned int)APP_CAN_TxEventBinStartGet(bin),
+                (unsigned int)stats.latency.bins[bin], (unsigned int)stats.arbitration.bins[bin]);
+        DEBUG_OUTPUT2((char*)uartTxBuffer);
+    }
+}
+
+/* Runs transmit timing commands: "reset" clears the histograms, nothing
+   reports them */
+static bool APP_CAN_txEventParse(char *line)
+{
+    char *token = strtok(line, " ");
+
+    if (token == NULL)
+    {
+        DEBUG_OUTPUT3("\r\n");
+        APP_CAN_txEventReport();
+    }
+    else if (strcmp(token, "reset") == 0)
+    {
+        APP_CAN_TxEventReset();
+        DEBUG_OUTPUT3("\r\n[TX] Histograms cleared.\r\n");
+    }
+    else
+    {
+        return false;
+    }
+    return true;
+}
+
+/* Cyclic message parameter keywords, which end an optional value */
+static bool APP_CAN_cyclicKeyword(const char *token)
+{
+    static const char * const keywords[] = {"offset", "data", "counter", "checksum", "fd", "brs"};
+    uint32_t keyword = 0;
+
+    for (keyword = 0; keyword < (sizeof(keywords) / sizeof(keywords[0])); keyword++)
+    {
+        if (strcmp(token, keywords[keyword]) == 0)
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+/* Parses "<hex ID>[x] <period ms>" and any of "offset <ms>",
+   "data <hex bytes>", "counter <byte> [<hex mask>]",
+   "checksum <byte> [sum|xor|crc8]", "fd" and "brs" */
+static bool APP_CAN_cyclicMessageParse(APP_CAN_CYCLIC_MESSAGE *message)
+{
+    char *token = strtok(NULL, " ");
+    char *end = NULL;
+    const char *next = NULL;
+    uint32_t value = 0;
+
+    memset(message, 0, sizeof(*message));
+    if (token == NULL)
+    {
+        return false;
+    }
+    value = strtoul(token, &end, 16);
+    message->frame.xtd = ((*end == 'x') || (*end == 'X'));
+    if ((end == token) || (value > (message->frame.xtd ? 0x1FFFFFFFUL : 0x7FFUL)))
+    {
+        return false;
+    }
+    message->frame.id = message->frame.xtd ? value : (value << 18);
+
+    token = strtok(NULL, " ");
+    if (token == NULL)
+    {
+        return false;
+    }
+    value = strtoul(token, &end, 10);
+    if ((end == token) || (*end != '\0') || (value == 0U) || (value > 0xFFFFU))
+    {
+        return false;
+    }
+    message->period = (uint16_t)value;
+
+    token = strtok(NULL, " ");
+    while (token != NULL)
+    {
+        if (strcmp(token, "offset") == 0)
+        {
+            token = strtok(NULL, " ");
+            if (token == NULL)
+            {
+                return false;
+            }
+            value = strtoul(token, &end, 10);
+            if ((end == token) || (value > 0xFFFFU))
+            {
+                return false;
+            }
+            message->offset = (uint16_t)value;
+        }
+        else if (strcmp(token, "data") == 0)
+        {
+            token = strtok(NULL, " ");
+            if (token == NULL)
+            {
+                return false;
+            }
+            message->frame.dlc = APP_CAN_hexBytesParse(token, message->frame.data, sizeof(message->frame.data), &next);
+            if (*next != '\0')
+            {
+                return false;
+            }
+        }
+        else if (strcmp(token, "counter") == 0)
+        {
+            token = strtok(NULL, " ");
+            if (token == NULL)
+            {
+                return false;
+            }
+            message->counterByte = (uint8_t)strtoul(token, &end, 10);
+            message->counterMask = 0xFFU;
+            if (end == token)
+            {
+                return false;
+            }
+            token = strtok(NULL, " ");
+            if ((token != NULL) && (APP_CAN_cyclicKeyword(token) == false))
+            {
+                value = strtoul(token, &end, 16);
+                if ((end == token) || (value == 0U) || (value > 0xFFU))
+                {
+                    return false;
+                }
+                message->counterMask = (uint8_t)value;
+                token = strtok(NULL, " ");
+            }
+            continue;
+        }
+        else if (strcmp(token, "checksum") == 0)
+        {
+            token = strtok(NULL, " ");
+            if (token == NULL)
+            {
+                return false;
+            }
+            message->checksumByte = (uint8_t)strtoul(token, &end, 10);
+            message->checksum = APP_CAN_CYCLIC_CHECKSUM_CRC8;
+            if (end == token)
+            {
+                return false;
+            }
+            token = strtok(NULL, " ");
+            if ((token != NULL) && (strcmp(token, "sum") == 0))
+            {
+                message->checksum = APP_CAN_CYCLIC_CHECKSUM_SUM;
+            }
+            else if ((token != NULL) && (strcmp(token, "xor") == 0))
+            {
+                message->checksum = APP_CAN_CYCLIC_CHECKSUM_XOR;
+            }
+            else if ((token == NULL) || (strcmp(token, "crc8") != 0))
+            {
+                continue;
+            }
+        }
+        else if (strcmp(token, "fd") == 0)
+        {
+            message->frame.fdf = 1U;
+        }
+        else if (strcmp(token, "brs") == 0)
+        {
+            message->frame.fdf = 1U;
+            message->frame.brs = 1U;
+        }
+        else
+        {
+            return false;
+        }
+        token = strtok(NULL, " ");
+    }
+    return true;
+}
+
+/* Runs cyclic transmit commands: "set <n> <message>" sets message n, see
+   APP_CAN_cyclicMessageParse, "del <n>" removes it, "start" and "stop" run
+   the scheduler, nothing reports the messages */
+static bool APP_CAN_cyclicParse(char *line)
+{
+    APP_CAN_CYCLIC_MESSAGE message;
+    char *token = strtok(line, " ");
+    const char *command = token;
+    char *end = NULL;
+    uint32_t index = 0;
+
+    if (token == NULL)
+    {
+        DEBUG_OUTPUT3("\r\n");
+        sprintf((char*)uartTxBuffer, "[CYCLIC] Scheduler %s\r\n", APP_CAN_CyclicIsRunning() ? "running" : "stopped");
+        DEBUG_OUTPUT2((char*)uartTxBuffer);
+        APP_CAN_cyclicReportIndex = 0;
+    }
+    else if ((strcmp(token, "set") == 0) || (strcmp(token, "del") == 0))
+    {
+        token = strtok(NULL, " ");
+        if (token == NULL)
+        {
+            return false;
+        }
+        index = strtoul(token, &end, 10);
+        if ((end == token) || (index >= APP_CAN_CYCLIC_MESSAGES))
+        {
+            return false;
+        }
+        if (strcmp(command, "del") == 0)
+        {
+            APP_CAN_CyclicRemove(index);
+            sprintf((char*)uartTxBuffer, "\r\n[CYCLIC] Message %u removed.\r\n", (unsigned int)index);
+        }
+        else if ((APP_CAN_cyclicMessageParse(&message) == false) || (APP_CAN_CyclicSet(index, &message) == false))
+        {
+            return false;
+        }
+        else
+        {
+            sprintf((char*)uartTxBuffer, "\r\n[CYCLIC] Message %u set%s.\r\n", (unsigned int)index,
+                    APP_CAN_CyclicIsRunning() ? "" : ", start the scheduler to send it");
+        }
+        DEBUG_OUTPUT2((char*)uartTxBuffer);
+    }
+    else if (strcmp(token, "start") == 0)
+    {
+        if (APP_CAN_transmitBlockGet() != NULL)
+        {
+            sprintf((char*)uartTxBuffer, "\r\n[CYCLIC] %s\r\n", APP_CAN_transmitBlockGet());
+            DEBUG_OUTPUT2((char*)uartTxBuffer);
+            return true;
+        }
+        APP_CAN_CyclicStart();
+        DEBUG_OUTPUT3("\r\n[CYCLIC] Started.\r\n");
+    }
+    else if (strcmp(token, "stop") == 0)
+    {
+        APP_CAN_CyclicStop();
+        DEBUG_OUTPUT3("\r\n[CYCLIC] Stopped.\r\n");
+    }
+    else
+    {
+        return false;
+    }
+    return true;
+}
+
+/* Runs the command which requested the argument line */
+static void APP_CAN_lineExecute(void)
+{
+    APP_CAN_FILTER_STATUS filterStatus;
+    APP_CAN_TRIGGER_CONFIG triggerConfig;
+
+    switch (APP_CAN_lineMode)
+    {
+        case APP_CAN_LINE_HW_FILTER:
+            memcpy(APP_CAN_config.hwFilter, APP_CAN_line, sizeof(APP_CAN_config.hwFilter));
+            APP_CAN_FilterClear();
+            if (APP_CAN_idListParse(APP_CAN_line, APP_CAN_FilterIdAdd) == false)
+            {
+                APP_CAN_config.hwFilter[0] = '\0';
+                APP_CAN_FilterClear();
+                DEBUG_OUTPUT3("\r\n[FILTER] Invalid ID list, all messages are accepted.\r\n");
+            }
+            APP_CAN_FilterApply(&filterStatus);
+            sprintf((char*)uartTxBuffer, "\r\n[FILTER] %u standard and %u extended filter elements%s\r\n",
+                    (unsigned int)filterStatus.stdElements, (unsigned int)filterStatus.extElements,
+                    (filterStatus.stdExact && filterStatus.extExact) ? "" : ", more IDs than requested are accepted");
+            DEBUG_OUTPUT2((char*)uartTxBuffer);
+            break;
+        case APP_CAN_LINE_SW_FILTER:
+            memcpy(APP_CAN_config.swFilter, APP_CAN_line, sizeof(APP_CAN_config.swFilter));
+            APP_CAN_IdFilterEditBegin();
+            if (APP_CAN_idListParse(APP_CAN_line, APP_CAN_IdFilterEditAdd) == false)
+            {
+                APP_CAN_config.swFilter[0] = '\0';
+                APP_CAN_IdFilterEditBegin();
+                DEBUG_OUTPUT3("\r\n[FILTER] Invalid ID list, all messages are kept.\r\n");
+            }
+            APP_CAN_IdFilterEditCommit();
+            sprintf((char*)uartTxBuffer, "\r\n[FILTER] Software filter updated, %u messages rejected so far\r\n",
+                    (unsigned int)APP_CAN_IdFilterRejectedGet());
+            DEBUG_OUTPUT2((char*)uartTxBuffer);
+            break;
+        case APP_CAN_LINE_TRIGGER:
+            /* Copied first, the parser splits the line */
+            memcpy(APP_CAN_config.trigger, APP_CAN_line, sizeof(APP_CAN_config.trigger));
+            if (APP_CAN_triggerParse(APP_CAN_line, &triggerConfig) == false)
+            {
+                APP_CAN_config.trigger[0] = '\0';
+                APP_CAN_TriggerDisarm();
+                DEBUG_OUTPUT3("\r\n[TRIGGER] Disarmed, received messages are output.\r\n");
+                break;
+            }
+            APP_CAN_triggerReported = false;
+            APP_CAN_TriggerArm(&triggerConfig);
+            sprintf((char*)uartTxBuffer, "\r\n[TRIGGER] Armed, recording until %u messages after the trigger\r\n",
+                    (unsigned int)triggerConfig.postFrames);
+            DEBUG_OUTPUT2((char*)uartTxBuffer);
+            break;
+        case APP_CAN_LINE_FLASHLOG:
+            if (APP_CAN_flashLogParse(APP_CAN_line) == false)
+            {
+                DEBUG_OUTPUT3("\r\n[FLASH] Invalid command.\r\n");
+            }
+            break;
+        case APP_CAN_LINE_CONFIG:
+            if (APP_CAN_configParse(APP_CAN_line) == false)
+            {
+                DEBUG_OUTPUT3("\r\n[CONFIG] Invalid command.\r\n");
+            }
+            break;
+        case APP_CAN_LINE_REPLAY:
+            if (APP_CAN_replayParse(APP_CAN_line) == false)
+            {
+                DEBUG_OUTPUT3("\r\n[REPLAY] Invalid command.\r\n");
+            }
+            break;
+        case APP_CAN_LINE_TXEVENT:
+            if (APP_CAN_txEventParse(APP_CAN_line) == false)
+            {
+                DEBUG_OUTPUT3("\r\n[TX] Invalid command.\r\n");
+            }
+            break;
+        case APP_CAN_LINE_CYCLIC:
+            if (APP_CAN_cyclicParse(APP_CAN_line) == false)
+            {
+                DEBUG_OUTPUT3("\r\n[CYCLIC] Invalid command.\r\n");
+            }
+            break;
+        default:
+            break;
+    }
+}
+
+/* Collects the argument line of a menu command, echoed on the debug link */
+static void APP_CAN_lineInput(char user_input)
+{
+    if ((user_input == '\r') || (user_input == '\n'))
+    {
+        APP_CAN_line[APP_CAN_lineLength] = '\0';
+        APP_CAN_lineExecute();
+        APP_CAN_lineMode = APP_CAN_LINE_NONE;
+        APP_CAN_lineLength = 0;
+    }
+    else if ((user_input == '\b') || (user_input == 0x7F))
+    {
+        if (APP_CAN_lineLength > 0U)
+        {
+            APP_CAN_lineLength--;
+            DEBUG_OUTPUT3("\b \b");
+        }
+    }
+    else if (APP_CAN_lineLength < (APP_CAN_LINE_SIZE - 1U))
+    {
+        APP_CAN_line[APP_CAN_lineLength++] = user_input;
+        (void)APP_UART_QueueWrite(APP_UART_QUEUE_DEBUG, &user_input, 1);
+    }
+}
+
+/* Runs a saved argument line as if it had been typed */
+static void APP_CAN_configLineRun(APP_CAN_LINE_MODE mode, const char *line)
+{
+    if (line[0] == '\0')
+    {
+        return;
+    }
+    memcpy(APP_CAN_line, line, APP_CAN_LINE_SIZE);
+    APP_CAN_lineMode = mode;
+    APP_CAN_lineExecute();
+    APP_CAN_lineMode = APP_CAN_LINE_NONE;
+}
+
+/* Sets the saved baud rates, call before anything is sent */
+static void APP_CAN_configBaudApply(void)
+{
+    USART_SERIAL_SETUP setup = {0, USART_PARITY_NONE, USART_DATA_8_BIT, USART_STOP_1_BIT};
+
+    if (APP_CAN_config.debugBaud != 0U)
+    {
+        setup.baudRate = APP_CAN_config.debugBaud;
+        (void)SERCOM5_USART_SerialSetup(&setup, 0);
+    }
+    if (APP_CAN_config.bleBaud != 0U)
+    {
+        setup.baudRate = APP_CAN_config.bleBaud;
+        (void)SERCOM0_USART_SerialSetup(&setup, 0);
+    }
+}
+
+/* Restores the saved output format, filters and trigger, the bit timing was
+   set before CAN1 started */
+static void APP_CAN_configRestore(void)
+{
+    if (APP_CAN_configLoaded == false)
+    {
+        return;
+    }
+    sprintf((char*)uartTxBuffer, "[CONFIG] Saved configuration restored, profile %u, mode %s\r\n",
+            (unsigned int)APP_CAN_BitRateProfileGet(), APP_CAN_busModeName[APP_CAN_busMode]);
+    DEBUG_OUTPUT2((char*)uartTxBuffer);
+
+    if (APP_CAN_config.outputMode == (uint8_t)APP_CAN_OUTPUT_DELTA)
+    {
+        APP_CAN_RecordDeltaReset();
+        APP_CAN_outputMode = APP_CAN_OUTPUT_DELTA;
+    }
+    else if (APP_CAN_config.outputMode == (uint8_t)APP_CAN_OUTPUT_BINARY)
+    {
+        APP_CAN_outputMode = APP_CAN_OUTPUT_BINARY;
+    }
+    if (APP_CAN_config.changedOnly != 0U)
+    {
+        APP_CAN_ChangeReset();
+        APP_CAN_changedOnly = true;
+    }
+    APP_CAN_configLineRun(APP_CAN_LINE_HW_FILTER, APP_CAN_config.hwFilter);
+    APP_CAN_configLineRun(APP_CAN_LINE_SW_FILTER, APP_CAN_config.swFilter);
+    APP_CAN_configLineRun(APP_CAN_LINE_TRIGGER, APP_CAN_config.trigger);
+}
+
+void APP_CAN_command(char user_input)
+{       
+    if (APP_CAN_lineMode != APP_CAN_LINE_NONE)
+    {
+        APP_CAN_lineInput(user_input);
+        return;
+    }
+
+    /* Check for user input on the CAN FD demo terminal window and process command */
+    if (state == APP_CAN_STATE_USER_INPUT) {
+        /* Read user input */
+        //scanf("%c", (char *) &user_input);
+
+        switch (user_input) {
+            case 'b': case 'B':
+                DEBUG_OUTPUT3("\r\n[CAN] Received messages are now output as binary records.\r\n");
+                APP_CAN_outputMode = APP_CAN_OUTPUT_BINARY;
+                break;
+            case 'd': case 'D':
+                DEBUG_OUTPUT3("\r\n[CAN] Received messages are now output as delta encoded binary records.\r\n");
+                APP_CAN_RecordDeltaReset();
+                APP_CAN_outputMode = APP_CAN_OUTPUT_DELTA;
+                break;
+            case 'c': case 'C':
+                if (APP_CAN_changedOnly == false)
+                {
+                    APP_CAN_ChangeReset();
+                    APP_CAN_changedOnly = true;
+                    DEBUG_OUTPUT3("\r\n[CAN] Only changed messages are forwarded.\r\n");
+                }
+                else
+                {
+                    APP_CAN_changedOnly = false;
+                    sprintf((char*)uartTxBuffer, "\r\n[CAN] All messages are forwarded, %u duplicates were suppressed.\r\n",
+                            (unsigned int)APP_CAN_ChangeSuppressedTotalGet());
+                    DEBUG_OUTPUT2((char*)uartTxBuffer);
+                }
+                break;
+            case 's': case 'S':
+                if (APP_CAN_statsDumpIndex < 0)
+                {
+                    DEBUG_OUTPUT3("\r\n[STATS] Per-ID traffic statistics:\r\n");
+                    APP_CAN_statsDumpIndex = 0;
+                }
+                break;
+            case 'f': case 'F':
+                DEBUG_OUTPUT3("\r\n[FILTER] Enter hex IDs to accept, e.g. 100 7E0-7EF 18DAF110x, or nothing to accept all:\r\n");
+                APP_CAN_lineMode = APP_CAN_LINE_HW_FILTER;
+                break;
+            case 'i': case 'I':
+                DEBUG_OUTPUT3("\r\n[FILTER] Enter hex IDs to keep, e.g. 100 7E0-7EF 18DAF110x, or nothing to keep all:\r\n");
+                APP_CAN_lineMode = APP_CAN_LINE_SW_FILTER;
+                break;
+            case 'a': case 'A':
+                DEBUG_OUTPUT3("\r\n[TRIGGER] Enter trigger, e.g. id 7E8 data 1 62F1/FFFF post 500 error pin, or nothing to disarm:\r\n");
+                APP_CAN_lineMode = APP_CAN_LINE_TRIGGER;
+                break;
+            case 'w': case 'W':
+                DEBUG_OUTPUT3("\r\n[FLASH] Enter on, off, freeze <messages after event>, nofreeze, unfreeze, erase, dump or replay [time <from ms> <to ms>] [id <hex ID>[x]], or raw:\r\n");
+                APP_CAN_lineMode = APP_CAN_LINE_FLASHLOG;
+                break;
+            case 'k': case 'K':
+                DEBUG_OUTPUT3("\r\n[CONFIG] Enter save, clear, profile <0-15, nominal 125k/250k/500k/1M x data 1M/2M/4M/5M> or profile auto, mode normal/listen/restricted, baud <debug> <BLE>, or nothing for the settings:\r\n");
+                APP_CAN_lineMode = APP_CAN_LINE_CONFIG;
+                break;
+            case 'p': case 'P':
+                DEBUG_OUTPUT3("\r\n[REPLAY] Enter stream to send records on this link, stop, or nothing for the status. W replay replays the flash recorder:\r\n");
+                APP_CAN_lineMode = APP_CAN_LINE_REPLAY;
+                break;
+            case 'x': case 'X':
+                DEBUG_OUTPUT3("\r\n[TX] Enter reset to clear the transmit timing histograms, or nothing to report them:\r\n");
+                APP_CAN_lineMode = APP_CAN_LINE_TXEVENT;
+                break;
+            case 'g': case 'G':
+                DEBUG_OUTPUT3("\r\n[CYCLIC] Enter set <0-63> <hex ID>[x] <period ms> [offset <ms>] [data <hex bytes>] [counter <byte> [<hex mask>]] "
+                              "[checksum <byte> [sum|xor|crc8]] [fd] [brs], del <0-63>, start, stop, or nothing for the messages:\r\n");
+                APP_CAN_lineMode = APP_CAN_LINE_CYCLIC;
+                break;
+            case 'l': case 'L':
+                APP_CAN_loadReport();
+                break;
+            case 'u': case 'U':
+                APP_CAN_updateReport();
+                break;
+            case 't': case 'T':
+                APP_CAN_outputMode = APP_CAN_OUTPUT_TEXT;
+                DEBUG_OUTPUT3("\r\n[CAN] Received messages are now output as text.\r\n");
+                break;
+            case 'm': case 'M':
+                APP_CAN_menu();
+                break;
+            case 'r': case 'R':
+                APP_UART_QueueFlush(APP_UART_QUEUE_DEBUG);
+                APP_UART_QueueFlush(APP_UART_QUEUE_BLE);
+                NVIC_SystemReset();
+                break;
+            default:
+                DEBUG_OUTPUT3("\r\n[***ERROR***] An invalid menu item was selected... \r\n");
+                break;
+        }
+    }
+}
+
+/* Drain frames captured by the CAN1 interrupt */
+static void APP_CAN_ringService(void)
+{
+    APP_CAN_RING_ENTRY *entry = NULL;
+    APP_CAN_RING_STATS stats;
+    bool received = false;
+
+    while ((entry = APP_CAN_RingReadSlotGet()) != NULL)
+    {
+        /* Once per frame, even if its output has to be retried */
+        if (APP_CAN_statsAccounted == false)
+        {
+            APP_CAN_StatsUpdate(entry);
+            APP_CAN_LoadFrameAdd(entry);
+            APP_CAN_FlashLogFrameAdd(entry);
+            APP_CAN_statsAccounted = true;
+        }
+        if (APP_CAN_TriggerStateGet() != APP_CAN_TRIGGER_STATE_IDLE)
+        {
+            /* Recorded instead of output, dropped while a frozen window is output */
+            APP_CAN_TriggerFrameAdd(entry);
+        }
+        else if (APP_CAN_dumpState == APP_CAN_DUMP_RAW)
+        {
+            /* Counted but not output, the debug link is busy with the raw dump */
+        }
+        /* Leave frames in the capture ring until both links have room */
+        else if (APP_CAN_outputMessage(entry) == false)
+        {
+            break;
+        }
+        APP_CAN_RingReadRelease();
+        APP_CAN_statsAccounted = false;
+        received = true;
+    }
+
+    if (received == true)
+    {
+        /* Check CAN Status */
+        status = CAN1_ErrorGet();
+
+        if (((status & CAN_PSR_LEC_Msk) == CAN_ERROR_NONE) || ((status & CAN_PSR_LEC_Msk) == CAN_ERROR_LEC_NC))
+        {
+            state = APP_CAN_STATE_XFER_SUCCESSFUL;
+        }
+        else
+        {
+            state = APP_CAN_STATE_XFER_ERROR;
+        }
+    }
+
+    APP_CAN_RingStatsGet(&stats);
+    if (stats.overflow != APP_CAN_overflowReported)
+    {
+        sprintf((char*)uartTxBuffer, "[CAN] Capture ring overflow, %u frames dropped\r\n",
+                (unsigned int)(stats.overflow - APP_CAN_overflowReported));
+        APP_CAN_overflowReported = stats.overflow;
+        DEBUG_OUTPUT2((char*)uartTxBuffer);
+    }
+}
+
+/* Polls the trigger events while armed and outputs the frozen window */
+static void APP_CAN_triggerService(void)
+{
+    static const char * const sourceName[] = {"", "message", "error state change", "", "pin"};
+    APP_CAN_TRIGGER_INFO info;
+    APP_CAN_RING_ENTRY entry;
+    uint32_t now = 0;
+
+    switch (APP_CAN_TriggerStateGet())
+    {
+        case APP_CAN_TRIGGER_STATE_ARMED:
+            __disable_irq();
+            now = CAN1_RxTimestampExtend((uint16_t)CAN1_REGS->CAN_TSCV);
+            __enable_irq();
+            APP_CAN_TriggerErrorStateUpdate((uint32_t)CAN1_ErrorGet() & (CAN_PSR_EW_Msk | CAN_PSR_EP_Msk | CAN_PSR_BO_Msk), now);
+            /* A pending event fires once every frame received before it is recorded */
+            if ((APP_CAN_RingCountGet() == 0U) && (CAN1_RxFifoFillLevelGet(CAN_RX_FIFO_0) == 0U) &&
+                (CAN1_RxFifoFillLevelGet(CAN_RX_FIFO_1) == 0U))
+            {
+                APP_CAN_TriggerService();
+            }
+            break;
+        case APP_CAN_TRIGGER_STATE_FROZEN:
+            if (APP_CAN_triggerReported == false)
+            {
+                APP_CAN_TriggerInfoGet(&info);
+                sprintf((char*)uartTxBuffer, "[TRIGGER] Triggered by %s at %u.%06u s, %u messages before and %u from the trigger on\r\n",
+                        sourceName[info.source], (unsigned int)(info.timestamp / APP_CAN_FORMAT_TICKS_PER_SECOND),
+                        (unsigned int)((info.timestamp % APP_CAN_FORMAT_TICKS_PER_SECOND) * APP_CAN_US_PER_TICK),
+                        (unsigned int)info.preFrames, (unsigned int)info.postFrames);
+                if (APP_UART_QueueWrite(APP_UART_QUEUE_DEBUG, uartTxBuffer, strlen((char*)uartTxBuffer)) == false)
+                {
+                    break;
+                }
+                BLE_OUTPUT2((char*)uartTxBuffer);
+                APP_CAN_triggerReported = true;
+            }
+            while (APP_CAN_TriggerFrameGet(&entry))
+            {
+                if (APP_CAN_outputMessage(&entry) == false)
+                {
+                    return;
+                }
+                APP_CAN_TriggerFrameRelease();
+            }
+            APP_CAN_TriggerDisarm();
+            DEBUG_OUTPUT3("[TRIGGER] End of capture, received messages are output.\r\n");
+            break;
+        default:
+            break;
+    }
+}
+
+/* Runs the firmware update and reports its state changes */
+static void APP_CAN_updateService(void)
+{
+    APP_FW_UPDATE_STATE updateState;
+    uint32_t now = 0;
+
+    __disable_irq();
+    now = CAN1_RxTimestampExtend((uint16_t)CAN1_REGS->CAN_TSCV);
+    __enable_irq();
+    APP_FW_UpdateTasks(now);
+
+    updateState = APP_FW_UpdateStateGet();
+    if (updateState != APP_CAN_updateState)
+    {
+        if ((updateState == APP_FW_UPDATE_STATE_IDLE) && (APP_CAN_updateState != APP_FW_UPDATE_STATE_SWAPPING))
+        {
+            DEBUG_OUTPUT3("\r\n[UPDATE] Firmware update ended without a swap.\r\n");
+        }
+        else
+        {
+            APP_CAN_updateReport();
+        }
+        APP_CAN_updateState = updateState;
+    }
+}
+
+/* Writes the flash recorder, reports error state changes to it and outputs
+   its content on request */
+static void APP_CAN_flashLogService(void)
+{
+    static const char dumpHeader[] = "[FLASH] Recorded messages:\r\n";
+    APP_CAN_RING_ENTRY entry;
+    uint32_t errorState = (uint32_t)CAN1_ErrorGet() & (CAN_PSR_EW_Msk | CAN_PSR_EP_Msk | CAN_PSR_BO_Msk);
+
+    if (errorState != APP_CAN_flashLogErrorState)
+    {
+        APP_CAN_flashLogErrorState = errorState;
+        APP_CAN_FlashLogEvent();
+    }
+    APP_CAN_FlashLogTasks();
+
+    switch (APP_CAN_dumpState)
+    {
+        case APP_CAN_DUMP_FLUSH:
+            if (APP_CAN_FlashLogIdle() == false)
+            {
+                break;
+            }
+            if (APP_CAN_dumpRaw)
+            {
+                sprintf((char*)uartTxBuffer, "[FLASH] Raw dump of %u bytes\r\n", (unsigned int)APP_CAN_FLASHLOG_SIZE);
+                if (APP_UART_QueueWrite(APP_UART_QUEUE_DEBUG, uartTxBuffer, strlen((char*)uartTxBuffer)) == true)
+                {
+                    APP_CAN_dumpBlock = 0;
+                    APP_CAN_dumpState = APP_CAN_DUMP_RAW;
+                }
+                break;
+            }
+            if (APP_CAN_dumpReplay)
+            {
+                if ((APP_CAN_transmitBlockGet() != NULL) || (APP_CAN_ReplayStart() == false))
+                {
+                    sprintf((char*)uartTxBuffer, "[REPLAY] %s\r\n",
+                            (APP_CAN_transmitBlockGet() != NULL) ? APP_CAN_transmitBlockGet() : "A replay is running, stop it first.");
+                    DEBUG_OUTPUT2((char*)uartTxBuffer);
+                    APP_CAN_dumpState = APP_CAN_DUMP_NONE;
+                    APP_CAN_FlashLogEnable(APP_CAN_dumpResume);
+                    break;
+                }
+                DEBUG_OUTPUT3("[REPLAY] Replaying the flash recording.\r\n");
+                APP_CAN_FlashLogReadStart(APP_CAN_dumpQueryActive ? &APP_CAN_dumpQuery : NULL);
+                APP_CAN_dumpState = APP_CAN_DUMP_REPLAY;
+                break;
+            }
+            if (APP_UART_QueueWrite(APP_UART_QUEUE_DEBUG, (const uint8_t *)dumpHeader, strlen(dumpHeader)) == false)
+            {
+                break;
+            }
+            APP_CAN_FlashLogReadStart(APP_CAN_dumpQueryActive ? &APP_CAN_dumpQuery : NULL);
+            APP_CAN_dumpState = APP_CAN_DUMP_OUTPUT;
+            /* Fall through */
+        case APP_CAN_DUMP_OUTPUT:
+            while (APP_CAN_FlashLogFrameGet(&entry))
+            {
+                if (APP_CAN_outputMessage(&entry) == false)
+                {
+                    return;
+                }
+                APP_CAN_FlashLogFrameRelease();
+            }
+            APP_CAN_dumpState = APP_CAN_DUMP_NONE;
+            APP_CAN_FlashLogEnable(APP_CAN_dumpResume);
+            sprintf((char*)uartTxBuffer, "[FLASH] End of recording, %u of %u blocks skipped.\r\n",
+                    (unsigned int)APP_CAN_FlashLogBlocksSkippedGet(), (unsigned int)APP_CAN_FLASHLOG_BLOCKS);
+            DEBUG_OUTPUT2((char*)uartTxBuffer);
+            break;
+        case APP_CAN_DUMP_RAW:
+            /* One queue segment and DMAC descriptor per block, the CPU copies nothing */
+            while ((APP_CAN_dumpBlock < APP_CAN_FLASHLOG_BLOCKS) &&
+                   APP_UART_QueueWriteReference(APP_UART_QUEUE_DEBUG, APP_CAN_FlashLogBlockAddressGet(APP_CAN_dumpBlock),
+                                                APP_CAN_FLASHLOG_BLOCK_SIZE))
+            {
+                APP_CAN_dumpBlock++;
+            }
+            /* Flash must not change until the last block has been sent */
+            if ((APP_CAN_dumpBlock < APP_CAN_FLASHLOG_BLOCKS) || APP_UART_QueueIsBusy(APP_UART_QUEUE_DEBUG))
+            {
+                break;
+            }
+            APP_CAN_dumpState = APP_CAN_DUMP_NONE;
+            APP_CAN_FlashLogEnable(APP_CAN_dumpResume);
+            DEBUG_OUTPUT3("\r\n[FLASH] End of raw dump.\r\n");
+            break;
+        case APP_CAN_DUMP_REPLAY:
+            /* Queued as far ahead as the replay has room, a stopped replay
+               ends the dump */
+            while ((APP_CAN_ReplayFreeGet() != 0U) && APP_CAN_FlashLogFrameGet(&entry))
+            {
+                (void)APP_CAN_ReplayFrameAdd(&entry);
+                APP_CAN_FlashLogFrameRelease();
+            }
+            if (APP_CAN_ReplayStateGet() == APP_CAN_REPLAY_STATE_RUNNING)
+            {
+                if (APP_CAN_ReplayFreeGet() == 0U)
+                {
+                    break;
+                }
+                APP_CAN_ReplayEnd();
+            }
+            APP_CAN_dumpState = APP_CAN_DUMP_NONE;
+            APP_CAN_FlashLogEnable(APP_CAN_dumpResume);
+            break;
+        default:
+            break;
+    }
+}
+
+/* Hands the Tx events collected by the CAN1 driver to the replay, the
+   cyclic transmit scheduler and the transmit timing histograms */
+static void APP_CAN_txEventService(void)
+{
+    CAN_TX_EVENT event;
+
+    while (CAN1_TxEventGet(&event) == true)
+    {
+        APP_CAN_ReplayTxEvent(&event);
+        APP_CAN_CyclicTxEvent(&event);
+        APP_CAN_TxEventAdd(&event);
+    }
+}
+
+/* Reports the timing of every replayed frame while the debug link has room,
+   ends a stream which stopped sending and reports the end of a replay */
+static void APP_CAN_replayService(void)
+{
+    APP_CAN_REPLAY_RESULT result;
+    APP_CAN_REPLAY_STATE replayState = APP_CAN_ReplayStateGet();
+    uint32_t now = 0;
+    bool drained = false;
+
+    if (APP_CAN_replayStream == true)
+    {
+        __disable_irq();
+        now = CAN1_RxTimestampExtend((uint16_t)CAN1_REGS->CAN_TSCV);
+        __enable_irq();
+        if (replayState != APP_CAN_REPLAY_STATE_RUNNING)
+        {
+            APP_CAN_replayStream = false;
+        }
+        else if ((now - APP_CAN_replayStreamTime) >= (APP_CAN_REPLAY_STREAM_TIMEOUT_MS * (APP_CAN_FORMAT_TICKS_PER_SECOND / 1000U)))
+        {
+            APP_CAN_replayStream = false;
+            APP_CAN_ReplayEnd();
+            DEBUG_OUTPUT3("[REPLAY] No data, end of stream.\r\n");
+        }
+    }
+
+    while (APP_UART_QueueFreeGet(APP_UART_QUEUE_DEBUG) >= APP_CAN_REPLAY_LINE_MAX)
+    {
+        if (APP_CAN_ReplayResultGet(&result) == false)
+        {
+            drained = true;
+            break;
+        }
+        sprintf((char*)uartTxBuffer, "[REPLAY] %u ID %X%s due %u.%06u s error %d us\r\n",
+                (unsigned int)result.sequence, (unsigned int)result.id, result.xtd ? "x" : "",
+                (unsigned int)(result.due / APP_CAN_FORMAT_TICKS_PER_SECOND),
+                (unsigned int)((result.due % APP_CAN_FORMAT_TICKS_PER_SECOND) * APP_CAN_US_PER_TICK),
+                (int)(result.error * (int32_t)APP_CAN_US_PER_TICK));
+        DEBUG_OUTPUT2((char*)uartTxBuffer);
+    }
+
+    /* The summary follows the results of the last frames */
+    if ((replayState != APP_CAN_replayState) && (drained == true) &&
+        (APP_UART_QueueFreeGet(APP_UART_QUEUE_DEBUG) >= (2U * APP_CAN_REPLAY_LINE_MAX)))
+    {
+        if (replayState == APP_CAN_REPLAY_STATE_IDLE)
+        {
+            APP_CAN_replayReport();
+        }
+        APP_CAN_replayState = replayState;
+    }
+}
+
+/* Largest deviation of a measured period from the nominal one, in us */
+static uint32_t APP_CAN_cyclicJitterGet(uint32_t nominal, uint32_t min, uint32_t max)
+{
+    uint32_t early = (min < nominal) ? (nominal - min) : 0U;
+    uint32_t late = (max > nominal) ? (max - nominal) : 0U;
+
+    return ((early > late) ? early : late) * APP_CAN_US_PER_TICK;
+}
+
+/* Reports one cyclic message per line while the debug link has room */
+static void APP_CAN_cyclicService(void)
+{
+    APP_CAN_CYCLIC_MESSAGE message;
+    APP_CAN_CYCLIC_STATS stats;
+    uint32_t nominal = 0;
+
+    while ((APP_CAN_cyclicReportIndex >= 0) && (APP_UART_QueueFreeGet(APP_UART_QUEUE_DEBUG) >= APP_CAN_CYCLIC_LINE_MAX))
+    {
+        if (APP_CAN_cyclicReportIndex >= (int32_t)APP_CAN_CYCLIC_MESSAGES)
+        {
+            APP_CAN_cyclicReportIndex = -1;
+            DEBUG_OUTPUT3("[CYCLIC] End of report\r\n");
+            break;
+        }
+        if (APP_CAN_CyclicGet((uint32_t)APP_CAN_cyclicReportIndex, &message) == false)
+        {
+            APP_CAN_cyclicReportIndex++;
+            continue;
+        }
+        APP_CAN_CyclicStatsGet((uint32_t)APP_CAN_cyclicReportIndex, &stats);
+        nominal = message.period * (APP_CAN_FORMAT_TICKS_PER_SECOND / 1000U);
+        sprintf((char*)uartTxBuffer, "[CYCLIC] %2u %0*X period %u ms offset %u ms: %u sent, %u late, %u skipped",
+                (unsigned int)APP_CAN_cyclicReportIndex, message.frame.xtd ? 8 : 3,
+                (unsigned int)(message.frame.xtd ? message.frame.id : (message.frame.id >> 18)),
+                (unsigned int)message.period, (unsigned int)message.offset, (unsigned int)stats.sent,
+                (unsigned int)stats.late, (unsigned int)stats.skipped);
+        DEBUG_OUTPUT2((char*)uartTxBuffer);
+        if (stats.periods != 0U)
+        {
+            sprintf((char*)uartTxBuffer, ", jitter request %u us, bus %u us",
+                    (unsigned int)APP_CAN_cyclicJitterGet(nominal, stats.requestPeriodMin, stats.requestPeriodMax),
+                    (unsigned int)APP_CAN_cyclicJitterGet(nominal, stats.busPeriodMin, stats.busPeriodMax));
+            DEBUG_OUTPUT2((char*)uartTxBuffer);
+        }
+        DEBUG_OUTPUT3("\r\n");
+        APP_CAN_cyclicReportIndex++;
+    }
+}
+
+/* Runs the bit rate detection and reports what every candidate received
+   once it ends */
+static void APP_CAN_bitRateAutoService(void)
+{
+    static const char * const resultName[] = {"none", "nominal and data bit rate detected",
+        "nominal bit rate detected, no bit rate switching seen so the data bit rate is kept",
+        "no bit rate received frames, the profile was restored"};
+    APP_CAN_BITRATE_AUTO_STATE autoState;
+    APP_CAN_BITRATE_SCORE score;
+    uint32_t profile = 0;
+    uint32_t index = 0;
+
+    APP_CAN_BitRateAutoTasks();
+    autoState = APP_CAN_BitRateAutoStateGet();
+    if ((autoState == APP_CAN_bitRateAutoState) ||
+        (APP_UART_QueueFreeGet(APP_UART_QUEUE_DEBUG) < ((APP_CAN_BITRATE_NOMINAL_RATES + APP_CAN_BITRATE_DATA_RATES + 1U) * 120U)))
+    {
+        return;
+    }
+    APP_CAN_bitRateAutoState = autoState;
+    if (autoState != APP_CAN_BITRATE_AUTO_STATE_IDLE)
+    {
+        return;
+    }
+
+    /* The bit rate and with it the timestamps changed, as for "profile <n>" */
+    APP_CAN_LoadInitialize();
+    for (index = 0; index < APP_CAN_BITRATE_NOMINAL_RATES; index++)
+    {
+        APP_CAN_BitRateAutoScoreGet(false, index, &score);
+        if (score.tried == true)
+        {
+            sprintf((char*)uartTxBuffer, "[CONFIG] Nominal %4u kbit/s: %u frames, %u arbitration and %u data phase errors\r\n",
+                    (unsigned int)(APP_CAN_BitRateNominalGet(index * APP_CAN_BITRATE_DATA_RATES) / 1000U),
+                    (unsigned int)score.frames, (unsigned int)score.nominalErrors, (unsigned int)score.dataErrors);
+            DEBUG_OUTPUT2((char*)uartTxBuffer);
+        }
+    }
+    for (index = 0; index < APP_CAN_BITRATE_DATA_RATES; index++)
+    {
+        APP_CAN_BitRateAutoScoreGet(true, index, &score);
+        if (score.tried == true)
+        {
+            sprintf((char*)uartTxBuffer, "[CONFIG] Data    %4u kbit/s: %u frames with bit rate switching, %u data phase errors\r\n",
+                    (unsigned int)(APP_CAN_BitRateDataGet(index) / 1000U),
+                    (unsigned int)score.brsFrames, (unsigned int)score.dataErrors);
+            DEBUG_OUTPUT2((char*)uartTxBuffer);
+        }
+    }
+    profile = APP_CAN_BitRateProfileGet();
+    sprintf((char*)uartTxBuffer, "[CONFIG] Profile %u: %u kbit/s nominal, %u kbit/s data, %s. Save to keep it.\r\n",
+            (unsigned int)profile, (unsigned int)(APP_CAN_BitRateNominalGet(profile) / 1000U),
+            (unsigned int)(APP_CAN_BitRateDataGet(profile) / 1000U), resultName[APP_CAN_BitRateAutoResultGet()]);
+    DEBUG_OUTPUT2((char*)uartTxBuffer);
+}
+
+void APP_CAN_state(void)
+{
+    /* Check the application's current state. */
+    switch (state) {
+        case APP_CAN_STATE_IDLE:
+        {
+            /* Application can do other task here */
+            break;
+        }
+        case APP_CAN_STATE_XFER_SUCCESSFUL:
+        {
+            state = APP_CAN_STATE_USER_INPUT;
+            break;
+        }
+        case APP_CAN_STATE_XFER_ERROR:
+        {
+            DEBUG_OUTPUT3("[CAN] Error in received message!\r\n");
+            state = APP_CAN_STATE_USER_INPUT;
+            break;
+        }
+        default:
+        {
+            break;
+        }
+    }
+    
+    APP_CAN_ringService();
+    APP_CAN_triggerService();
+    APP_CAN_flashLogService();
+    APP_CAN_txEventService();
+    APP_CAN_replayService();
+    APP_CAN_cyclicService();
+    APP_CAN_bitRateAutoService();
+    APP_CAN_updateService();
+    APP_CAN_statsService();
+}
+
+void APP_LED_toggle(void)
+{
+    if (isRTCExpired == true) {
+        isRTCExpired = false;
+        LED0_Toggle();       
+    }
+    /* Maintain state machines of all polled MPLAB Harmony modules */
+    if (changeTempSamplingRate == true) {
+        changeTempSamplingRate = false;
+        if (tempSampleRate == RTC_INTERRUPT_RATE_500MS) {
+            tempSampleRate = RTC_INTERRUPT_RATE_1S;
+            RTC_Timer32Compare0Set(PERIOD_1S);
         } else if (tempSampleRate == RTC_INTERRUPT_RATE_1S) {
             tempSampleRate = RTC_INTERRUPT_RATE_2S;
             RTC_Timer32Compare0Set(PERIOD_2S);
@@ -695,16 +2116,32 @@ void APP_LED_toggle(void)
 
 void APP_BLE_demo(void)
 {
-    /* Check for user input typed in the debug terminal window */
-    if (SERCOM5_USART_Read(uartRxBuffer, 1)) // USART read should be non-blocking
+    uint8_t data = 0;
+
+    /* Check for user input typed in the debug terminal window, a streamed
+       trace goes to the replay instead */
+    while (APP_UART_ReceiveGet(APP_UART_QUEUE_DEBUG, &data))
     {
-        SERCOM0_USART_Write(uartRxBuffer, 1); // Send to BLE module for Tx
-        APP_CAN_command(uartRxBuffer[0]); // See if need to execute CAN command
+        if (APP_CAN_replayStream == true)
+        {
+            APP_CAN_ReplayStreamReceive(data);
+            __disable_irq();
+            APP_CAN_replayStreamTime = CAN1_RxTimestampExtend((uint16_t)CAN1_REGS->CAN_TSCV);
+            __enable_irq();
+            continue;
+        }
+        APP_UART_QueueWrite(APP_UART_QUEUE_BLE, &data, 1); // Send to BLE module for Tx
+        APP_CAN_command((char)data); // See if need to execute CAN command
     }
-    /* Check for incoming received character from the BLE module */
-    if (SERCOM0_USART_Read(uartRxBuffer, 1)) // USART read should be non-blocking
+    /* Check for incoming received characters from the BLE module, firmware
+       update frames are not displayed */
+    while (APP_UART_ReceiveGet(APP_UART_QUEUE_BLE, &data))
     {
-        SERCOM5_USART_Write(uartRxBuffer, 1); // Display received character on terminal
+        APP_FW_UpdateReceive(data);
+        if (APP_FW_UpdateStateGet() == APP_FW_UPDATE_STATE_IDLE)
+        {
+            APP_UART_QueueWrite(APP_UART_QUEUE_DEBUG, &data, 1); // Display received character on terminal
+        }
     }
 }
 
@@ -719,21 +2156,48 @@ int main ( void )
     //can_sidfe_registers_t stdMsgIDFilterElement;
     //can_xidfe_registers_t extMsgIDFilterElement;
 
+    /* Before the RTC is reset by its initialization */
+    APP_CAN_FlashLogCheckpointLoad();
+
+    /* CAN1 starts with the saved bit timing and mode, a passive one keeps
+       it off the bus from the start */
+    APP_CAN_configLoaded = APP_CAN_ConfigLoad(&APP_CAN_config);
+    (void)APP_CAN_BitRateProfileSet(APP_CAN_config.bitRateProfile);
+    if (APP_CAN_config.busMode <= (uint8_t)APP_CAN_BUS_RESTRICTED)
+    {
+        APP_CAN_busModeSet((APP_CAN_BUS_MODE)APP_CAN_config.busMode);
+    }
+
     /* Initialize all modules */
     SYS_Initialize ( NULL );
 
+    APP_CAN_configBaudApply();
+    APP_UART_QueueInitialize();
     DMAC_ChannelCallbackRegister(DMAC_CHANNEL_0, usart5DmaChannelHandler, 0);
     DMAC_ChannelCallbackRegister(DMAC_CHANNEL_1, usart0DmaChannelHandler, 0);
+    SERCOM0_USART_ReadCallbackRegister(usart0ReadHandler, 0);
+    APP_UART_ReceiveStart(APP_UART_QUEUE_BLE);
+    SERCOM5_USART_ReadCallbackRegister(usart5ReadHandler, 0);
+    APP_UART_ReceiveStart(APP_UART_QUEUE_DEBUG);
     EIC_CallbackRegister(EIC_PIN_15, EIC_User_Handler, 0);
     RTC_Timer32CallbackRegister(rtcEventHandler, 0);
     RTC_Timer32Start();
     
     /* Set CAN Message RAM Configuration */
     CAN1_MessageRAMConfigSet(Can1MessageRAM);
+    APP_CAN_RingInitialize();
+    APP_CAN_IdFilterInitialize();
+    APP_CAN_TriggerInitialize();
+    APP_CAN_StatsReset();
+    APP_CAN_LoadInitialize();
+    APP_CAN_TxEventReset();
+    APP_CAN_FlashLogInitialize();
 
     CAN1_RxFifoCallbackRegister(CAN_RX_FIFO_0, APP_CAN_RxFifo0Callback, APP_CAN_STATE_RECEIVE);
     CAN1_RxFifoCallbackRegister(CAN_RX_FIFO_1, APP_CAN_RxFifo1Callback, APP_CAN_STATE_RECEIVE);
     CAN1_RxBuffersCallbackRegister(APP_CAN_RxBufferCallback, APP_CAN_STATE_RECEIVE);
+    APP_CAN_ReplayInitialize();
+    APP_CAN_CyclicInitialize();
 
     sprintf((char*)uartTxBuffer, "\r\n ------------------------------------------------ \r\n");
     DEBUG_OUTPUT2((char*)uartTxBuffer);
@@ -744,6 +2208,7 @@ int main ( void )
     sprintf((char*)uartTxBuffer, " ------------------------------------------------ \r\n\r\n");
     DEBUG_OUTPUT2((char*)uartTxBuffer);
     BLE_OUTPUT2((char*)uartTxBuffer);
+    APP_CAN_configRestore();
 #ifdef _ELIMINATE
     /* Set Filter Address Range for Standard Filter */
     stdMsgIDFilterElement.CAN_SIDFE_0 = CAN_STD_FILTER_ID_MAX;
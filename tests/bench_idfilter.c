@@ -0,0 +1,169 @@
+/*******************************************************************************
+  CAN Software ID Filter Host Benchmark
+
+  File Name:
+    bench_idfilter.c
+
+  Summary:
+    Compares the software ID filter with a linear list of 100 rules.
+
+  Description:
+    Both are loaded with the same rules and must agree on every frame of the
+    test traffic. The time per frame of each is then measured over the same
+    traffic and reported. Only a disagreement fails the test, the timings
+    depend on the host.
+*******************************************************************************/
+
+#include <string.h>
+#include <time.h>
+#include "test_common.h"
+#include "app_can_idfilter.h"
+
+#define RULES               100U
+#define FRAMES              4096U
+#define PASSES              400U
+
+#define EXT_ID_MASK         0x1FFFFFFFUL
+
+typedef struct
+{
+    uint32_t id;
+    bool xtd;
+} RULE;
+
+typedef struct
+{
+    const char *name;
+    uint32_t stdRules;
+    /* Extended IDs in a J1939 style cluster, otherwise spread */
+    bool cluster;
+} SCENARIO;
+
+static RULE rule[RULES];
+static RULE frame[FRAMES];
+static volatile uint32_t sink = 0U;
+
+static bool LinearAccept(uint32_t id, bool xtd)
+{
+    uint32_t index = 0U;
+
+    for (index = 0U; index < RULES; index++)
+    {
+        if ((rule[index].id == id) && (rule[index].xtd == xtd))
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+static double Seconds(void)
+{
+    struct timespec now;
+
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (double)now.tv_sec + ((double)now.tv_nsec * 1e-9);
+}
+
+static uint32_t ExtId(bool cluster, uint32_t base)
+{
+    return cluster ? (base | TEST_RandomBelow(0x10000U)) : (TEST_Random() & EXT_ID_MASK);
+}
+
+static void Load(const SCENARIO *scenario)
+{
+    uint32_t base = 0x18000000UL | ((TEST_Random() & 0xFFUL) << 16);
+    uint32_t index = 0U;
+
+    APP_CAN_IdFilterInitialize();
+    APP_CAN_IdFilterEditBegin();
+    for (index = 0U; index < RULES; index++)
+    {
+        rule[index].xtd = (index >= scenario->stdRules);
+        rule[index].id = rule[index].xtd ? ExtId(scenario->cluster, base) : TEST_RandomBelow(0x800U);
+        TEST_CHECK(APP_CAN_IdFilterEditAdd(rule[index].id, rule[index].xtd));
+    }
+    APP_CAN_IdFilterEditCommit();
+
+    /* Half the traffic matches a rule, the rest mostly misses near the rules */
+    for (index = 0U; index < FRAMES; index++)
+    {
+        if ((index & 1U) == 0U)
+        {
+            frame[index] = rule[TEST_RandomBelow(RULES)];
+        }
+        else
+        {
+            frame[index].xtd = (TEST_RandomBelow(RULES) >= scenario->stdRules);
+            frame[index].id = frame[index].xtd ? ExtId(scenario->cluster, base) : TEST_RandomBelow(0x800U);
+        }
+    }
+}
+
+static void Run(const SCENARIO *scenario)
+{
+    uint32_t index = 0U;
+    uint32_t pass = 0U;
+    uint32_t rejected = 0U;
+    uint32_t accepted = 0U;
+    double start = 0.0;
+    double filterTime = 0.0;
+    double linearTime = 0.0;
+
+    Load(scenario);
+
+    for (index = 0U; index < FRAMES; index++)
+    {
+        bool expected = LinearAccept(frame[index].id, frame[index].xtd);
+
+        TEST_CHECK(APP_CAN_IdFilterAccept(frame[index].id, frame[index].xtd) == expected);
+        rejected += expected ? 0U : 1U;
+    }
+    TEST_CHECK(APP_CAN_IdFilterRejectedGet() == rejected);
+
+    start = Seconds();
+    for (pass = 0U; pass < PASSES; pass++)
+    {
+        for (index = 0U; index < FRAMES; index++)
+        {
+            accepted += APP_CAN_IdFilterAccept(frame[index].id, frame[index].xtd) ? 1U : 0U;
+        }
+    }
+    filterTime = Seconds() - start;
+
+    start = Seconds();
+    for (pass = 0U; pass < PASSES; pass++)
+    {
+        for (index = 0U; index < FRAMES; index++)
+        {
+            accepted += LinearAccept(frame[index].id, frame[index].xtd) ? 1U : 0U;
+        }
+    }
+    linearTime = Seconds() - start;
+    sink = accepted;
+
+    printf("%-26s id filter %7.2f ns/frame, linear list %7.2f ns/frame, %5.1fx\n", scenario->name,
+           (filterTime * 1e9) / ((double)FRAMES * PASSES), (linearTime * 1e9) / ((double)FRAMES * PASSES),
+           (filterTime > 0.0) ? (linearTime / filterTime) : 0.0);
+}
+
+int main(void)
+{
+    static const SCENARIO scenario[] =
+    {
+        { "100 standard",              100U, false },
+        { "50 standard, 50 extended",   50U, false },
+        { "100 extended",                0U, false },
+        { "100 extended, clustered",     0U, true  },
+    };
+    uint32_t index = 0U;
+
+    TEST_RandomSeed(12U);
+    for (index = 0U; index < (sizeof(scenario) / sizeof(scenario[0])); index++)
+    {
+        Run(&scenario[index]);
+    }
+
+    printf("bench_idfilter: %u failures\n", testFailures);
+    return TEST_RESULT();
+}
@@ -0,0 +1,15 @@
+# Runs a decoder script on INPUT and compares its output with EXPECTED.
+#   cmake -DPYTHON=... -DDECODER=... -DINPUT=... -DEXPECTED=... -P decode_check.cmake
+
+execute_process(COMMAND ${PYTHON} ${DECODER} ${ARGS} ${INPUT}
+                OUTPUT_FILE ${INPUT}.decoded
+                RESULT_VARIABLE result)
+if(NOT result EQUAL 0)
+    message(FATAL_ERROR "${DECODER} failed: ${result}")
+endif()
+
+execute_process(COMMAND ${CMAKE_COMMAND} -E compare_files ${INPUT}.decoded ${EXPECTED}
+                RESULT_VARIABLE result)
+if(NOT result EQUAL 0)
+    message(FATAL_ERROR "${INPUT}.decoded differs from ${EXPECTED}")
+endif()
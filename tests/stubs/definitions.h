@@ -0,0 +1,28 @@
+/*******************************************************************************
+  Host Test System Definitions
+
+  File Name:
+    definitions.h
+
+  Summary:
+    Stands in for the project definitions when the application modules are
+    built on the host.
+
+  Description:
+    Includes the peripheral library interfaces used by the modules under test.
+    The functions are implemented by the test that needs them.
+*******************************************************************************/
+
+#ifndef DEFINITIONS_H
+#define DEFINITIONS_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+#include "peripheral/nvmctrl/plib_nvmctrl.h"
+#include "peripheral/can/plib_can1.h"
+#include "peripheral/rtc/plib_rtc.h"
+#include "peripheral/tc/plib_tc0.h"
+#include "peripheral/tc/plib_tc1.h"
+
+#endif /* DEFINITIONS_H */
@@ -0,0 +1,54 @@
+/*******************************************************************************
+  Host Test Device Header File
+
+  File Name:
+    device.h
+
+  Summary:
+    Stands in for the device header when the application modules are built
+    on the host.
+
+  Description:
+    Takes the register layout and bit field macros from the device pack, so
+    the modules under test encode their register values as on the target.
+    The peripheral instances are plain host structures the tests can inspect,
+    and the core intrinsics do nothing.
+*******************************************************************************/
+
+#ifndef DEVICE_H
+#define DEVICE_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+#define _UINT8_(x)                  ((uint8_t)(x))
+#define _UINT16_(x)                 ((uint16_t)(x))
+#define _UINT32_(x)                 ((uint32_t)(x))
+
+#define __I                         volatile const
+#define __O                         volatile
+#define __IO                        volatile
+
+#include "component/can.h"
+#include "component/nvmctrl.h"
+#include "component/rtc.h"
+#include "component/tc.h"
+
+extern can_registers_t hostCan1Regs;
+extern nvmctrl_registers_t hostNvmctrlRegs;
+extern rtc_registers_t hostRtcRegs;
+extern tc_registers_t hostTc1Regs;
+
+#define CAN1_REGS                   (&hostCan1Regs)
+#define NVMCTRL_REGS                (&hostNvmctrlRegs)
+#define RTC_REGS                    (&hostRtcRegs)
+#define TC1_REGS                    (&hostTc1Regs)
+
+/* Interrupts are run by the tests. test_ring runs the producer of the
+   capture ring in a thread of its own, so the barrier is a real fence. */
+#define __disable_irq()             do { } while (0)
+#define __enable_irq()              do { } while (0)
+#define __DMB()                     __atomic_thread_fence(__ATOMIC_SEQ_CST)
+
+#endif //DEVICE_H
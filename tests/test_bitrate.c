@@ -0,0 +1,1097 @@
+/*******************************************************************************
+  Bit Rate Detection Host Test
+
+  File Name:
+    test_bitrate.c
+
+  Summary:
+    Runs the automatic bit rate detection against the edges of simulated bus
+    traffic at the standard nominal and data bit rates and checks the bit
+    timing it settles on.
+
+  Description:
+    Frames are encoded bit by bit as on the bus, with bit stuffing, the stuff
+    count and fixed stuff bits of CAN FD, CRC-15/17/21 and the bit rate switch
+    at the sample points, and turned into the times of their edges with clock
+    deviation and jitter. A simulated receiver samples the edges with the bit
+    timing set by CAN1_BitTimingSet: hard synchronization at the start of
+    frame, resynchronization within the jump width, and a decoder which finds
+    the stuff, form and CRC errors and counts them for the arbitration or
+    data phase as PSR LEC/DLEC would. Received frames go to
+    APP_CAN_BitRateAutoFrameAdd.
+*******************************************************************************/
+
+#include <math.h>
+#include <string.h>
+#include "test_common.h"
+#include "app_can_bitrate.h"
+#include "app_can_format.h"
+
+#define NS_PER_MS               1000000.0
+#define CLOCK_NS                (1.0e9 / (double)APP_CAN_BITRATE_CLOCK_HZ)
+#define EDGES_MAX               3000000U
+#define FRAME_BITS_MAX          1024U
+/* Simulated bus traffic, the detection has to end well before */
+#define RUN_MS                  2500U
+#define DETECT_MS_MAX           1000U
+
+/* Standard bit rates, independent of the profile table */
+static const uint32_t nominalRates[APP_CAN_BITRATE_NOMINAL_RATES] = { 125000U, 250000U, 500000U, 1000000U };
+static const uint32_t dataRates[APP_CAN_BITRATE_DATA_RATES] = { 1000000U, 2000000U, 4000000U, 5000000U };
+static const uint8_t fdLength[16] = { 0U, 1U, 2U, 3U, 4U, 5U, 6U, 7U, 8U, 12U, 16U, 20U, 24U, 32U, 48U, 64U };
+
+typedef enum
+{
+    PHASE_NOMINAL,
+    PHASE_DATA
+} PHASE;
+
+/* How long a bit lasts on the bus. The bit rate switches at the sample
+   point of the BRS bit and back at the one of the CRC delimiter. */
+typedef enum
+{
+    BIT_NOMINAL,
+    BIT_DATA,
+    BIT_BRS,
+    BIT_CRC_DELIMITER
+} BIT_KIND;
+
+typedef struct
+{
+    uint32_t id;
+    bool xtd;
+    bool rtr;
+    bool fdf;
+    bool brs;
+    uint32_t dlc;
+    uint8_t data[64];
+} FRAME;
+
+typedef struct
+{
+    double tq;
+    uint32_t tseg1;
+    uint32_t tseg2;
+    uint32_t sjw;
+} PHASE_TIMING;
+
+/* Traffic on the bus */
+typedef struct
+{
+    uint32_t profile;
+    /* Share of CAN FD frames and of those with bit rate switching, bus load */
+    double fdShare;
+    double brsShare;
+    double load;
+    /* Mean time between frames with bit rate switching in ns instead of the
+       share, 0 for none */
+    double brsInterval;
+    /* Share of the frames without bit rate switching in which a disturbance
+       inverts a bit of the identifier */
+    double disturbed;
+    /* Relative clock deviation of the transmitters and edge jitter in ns */
+    double deviation;
+    double jitter;
+} TRAFFIC;
+
+typedef struct
+{
+    uint8_t level[FRAME_BITS_MAX];
+    uint8_t kind[FRAME_BITS_MAX];
+    uint32_t count;
+    BIT_KIND next;
+    uint32_t run;
+    uint32_t runLevel;
+    uint32_t stuffCount;
+    uint32_t crc15;
+    uint32_t crc17;
+    uint32_t crc21;
+} ENCODER;
+
+typedef struct
+{
+    PHASE_TIMING timing[2];
+    PHASE phase;
+    bool first;
+    double sample;
+    uint32_t level;
+    uint32_t run;
+    uint32_t runLevel;
+    uint32_t stuffCount;
+    uint32_t crc15;
+    uint32_t crc17;
+    uint32_t crc21;
+} RECEIVER;
+
+/* Edges of the bus level, idle recessive: falling edges at even indices */
+static double edges[EDGES_MAX];
+static uint32_t edgeCount = 0U;
+static uint32_t framesSent = 0U;
+
+/* Controller state: bit timing, error counters, bus monitoring */
+static CAN_BIT_TIMING timingSet;
+static uint32_t timingSets = 0U;
+static uint32_t nominalErrors = 0U;
+static uint32_t dataErrors = 0U;
+static bool monitoring = false;
+static double simNow = 0.0;
+can_registers_t hostCan1Regs;
+
+/* Receiver: start of frame search from ready on, result of the frame being
+   received at pendingTime */
+static RECEIVER receiver;
+static double ready = 0.0;
+static bool pending = false;
+static double pendingTime = 0.0;
+static bool pendingOk = false;
+static PHASE pendingPhase = PHASE_NOMINAL;
+static bool pendingBrs = false;
+static uint32_t framesReceived = 0U;
+/* The acceptance filter rejects every frame */
+static bool rejectAll = false;
+
+// *****************************************************************************
+// Section: Bus Level
+// *****************************************************************************
+
+/* Index of the first edge after time */
+static uint32_t EdgeAfter(double time)
+{
+    uint32_t low = 0U;
+    uint32_t high = edgeCount;
+    uint32_t middle = 0U;
+
+    while (low < high)
+    {
+        middle = low + ((high - low) / 2U);
+        if (edges[middle] <= time)
+        {
+            low = middle + 1U;
+        }
+        else
+        {
+            high = middle;
+        }
+    }
+    return low;
+}
+
+static uint32_t LevelAt(double time)
+{
+    return ((EdgeAfter(time) & 1U) != 0U) ? 0U : 1U;
+}
+
+static double FallingAfter(double time)
+{
+    uint32_t index = EdgeAfter(time);
+
+    index += index & 1U;
+    return (index < edgeCount) ? edges[index] : INFINITY;
+}
+
+static double RisingAfter(double time)
+{
+    uint32_t index = EdgeAfter(time);
+
+    index += (~index) & 1U;
+    return (index < edgeCount) ? edges[index] : INFINITY;
+}
+
+// *****************************************************************************
+// Section: Encoder
+// *****************************************************************************
+
+static uint32_t CrcUpdate(uint32_t crc, uint32_t bit, uint32_t polynomial, uint32_t width)
+{
+    uint32_t top = ((crc >> (width - 1U)) ^ bit) & 1U;
+
+    crc = (crc << 1) & ((1UL << width) - 1U);
+    return (top != 0U) ? (crc ^ polynomial) : crc;
+}
+
+static void CrcFd(uint32_t *crc17, uint32_t *crc21, uint32_t bit)
+{
+    *crc17 = CrcUpdate(*crc17, bit, 0x1685BUL, 17U);
+    *crc21 = CrcUpdate(*crc21, bit, 0x102899UL, 21U);
+}
+
+static void EncodeRaw(ENCODER *encoder, uint32_t level)
+{
+    TEST_CHECK(encoder->count < FRAME_BITS_MAX);
+    encoder->level[encoder->count % FRAME_BITS_MAX] = (uint8_t)level;
+    encoder->kind[encoder->count % FRAME_BITS_MAX] = (uint8_t)encoder->next;
+    encoder->count++;
+    if (encoder->next == BIT_BRS)
+    {
+        encoder->next = BIT_DATA;
+    }
+    else if (encoder->next == BIT_CRC_DELIMITER)
+    {
+        encoder->next = BIT_NOMINAL;
+    }
+    else
+    {
+        /* The phase goes on */
+    }
+}
+
+/* A bit of the stuffed part, followed by a stuff bit after five equal ones */
+static void EncodeBit(ENCODER *encoder, uint32_t bit)
+{
+    EncodeRaw(encoder, bit);
+    CrcFd(&encoder->crc17, &encoder->crc21, bit);
+    encoder->crc15 = CrcUpdate(encoder->crc15, bit, 0x4599U, 15U);
+    encoder->run = (bit == encoder->runLevel) ? (encoder->run + 1U) : 1U;
+    encoder->runLevel = bit;
+    if (encoder->run == 5U)
+    {
+        EncodeRaw(encoder, bit ^ 1U);
+        CrcFd(&encoder->crc17, &encoder->crc21, bit ^ 1U);
+        encoder->stuffCount++;
+        encoder->run = 1U;
+        encoder->runLevel = bit ^ 1U;
+    }
+}
+
+static void EncodeBits(ENCODER *encoder, uint32_t value, uint32_t width)
+{
+    while (width > 0U)
+    {
+        width--;
+        EncodeBit(encoder, (value >> width) & 1U);
+    }
+}
+
+/* Bits of the stuff count and CAN FD CRC with a fixed stuff bit before
+   every fourth */
+static void EncodeFixed(ENCODER *encoder, uint32_t value, uint32_t width, uint32_t *position)
+{
+    while (width > 0U)
+    {
+        width--;
+        if ((*position % 4U) == 0U)
+        {
+            EncodeRaw(encoder, encoder->level[(encoder->count - 1U) % FRAME_BITS_MAX] ^ 1U);
+        }
+        EncodeRaw(encoder, (value >> width) & 1U);
+        (*position)++;
+    }
+}
+
+static uint32_t FrameLength(const FRAME *frame)
+{
+    if (frame->fdf)
+    {
+        return fdLength[frame->dlc];
+    }
+    return frame->rtr ? 0U : ((frame->dlc < 8U) ? frame->dlc : 8U);
+}
+
+/* Bits of a frame from the start of frame to the end of the interframe
+   space, acknowledged by another node */
+static void Encode(ENCODER *encoder, const FRAME *frame)
+{
+    uint32_t length = FrameLength(frame);
+    uint32_t index = 0U;
+    uint32_t count = 0U;
+    uint32_t crc = 0U;
+    uint32_t position = 0U;
+
+    memset(encoder, 0, sizeof(*encoder));
+    encoder->next = BIT_NOMINAL;
+    encoder->runLevel = 2U;
+    encoder->crc17 = 1UL << 16;
+    encoder->crc21 = 1UL << 20;
+
+    EncodeBit(encoder, 0U);
+    if (frame->xtd)
+    {
+        EncodeBits(encoder, frame->id >> 18, 11U);
+        /* SRR, IDE */
+        EncodeBits(encoder, 3U, 2U);
+        EncodeBits(encoder, frame->id & 0x3FFFFUL, 18U);
+        /* RTR or RRS, r1 or FDF, r0 of classic frames */
+        EncodeBit(encoder, (frame->rtr && !frame->fdf) ? 1U : 0U);
+        EncodeBit(encoder, frame->fdf ? 1U : 0U);
+        if (!frame->fdf)
+        {
+            EncodeBit(encoder, 0U);
+        }
+    }
+    else
+    {
+        EncodeBits(encoder, frame->id, 11U);
+        /* RTR or RRS, IDE, r0 or FDF */
+        EncodeBit(encoder, (frame->rtr && !frame->fdf) ? 1U : 0U);
+        EncodeBit(encoder, 0U);
+        EncodeBit(encoder, frame->fdf ? 1U : 0U);
+    }
+    if (frame->fdf)
+    {
+        /* res, BRS, ESI */
+        EncodeBit(encoder, 0U);
+        encoder->next = frame->brs ? BIT_BRS : BIT_NOMINAL;
+        EncodeBit(encoder, frame->brs ? 1U : 0U);
+        EncodeBit(encoder, 0U);
+    }
+    EncodeBits(encoder, frame->dlc, 4U);
+    for (index = 0U; index < length; index++)
+    {
+        EncodeBits(encoder, frame->data[index], 8U);
+    }
+
+    if (frame->fdf)
+    {
+        /* Stuff count in Gray code with even parity */
+        count = encoder->stuffCount % 8U;
+        count = ((count ^ (count >> 1)) << 1) | (((count ^ (count >> 1) ^ (count >> 2)) & 1U));
+        for (index = 0U; index < 4U; index++)
+        {
+            CrcFd(&encoder->crc17, &encoder->crc21, (count >> (3U - index)) & 1U);
+        }
+        crc = (length <= 16U) ? encoder->crc17 : encoder->crc21;
+        EncodeFixed(encoder, count, 4U, &position);
+        EncodeFixed(encoder, crc, (length <= 16U) ? 17U : 21U, &position);
+    }
+    else
+    {
+        EncodeBits(encoder, encoder->crc15, 15U);
+    }
+    encoder->next = (frame->fdf && frame->brs) ? BIT_CRC_DELIMITER : BIT_NOMINAL;
+    EncodeRaw(encoder, 1U);
+    /* ACK slot, ACK delimiter, end of frame and interframe space */
+    EncodeRaw(encoder, 0U);
+    for (index = 0U; index < 11U; index++)
+    {
+        EncodeRaw(encoder, 1U);
+    }
+}
+
+static void RandomFrame(FRAME *frame, const TRAFFIC *traffic)
+{
+    uint32_t index = 0U;
+
+    memset(frame, 0, sizeof(*frame));
+    frame->xtd = TEST_RandomBelow(10U) < 3U;
+    frame->id = frame->xtd ? (TEST_Random() & 0x1FFFFFFFUL) : TEST_RandomBelow(0x800U);
+    frame->fdf = TEST_RandomBelow(1000U) < (uint32_t)(traffic->fdShare * 1000.0);
+    frame->brs = frame->fdf && (TEST_RandomBelow(1000U) < (uint32_t)(traffic->brsShare * 1000.0));
+    frame->rtr = !frame->fdf && (TEST_RandomBelow(20U) == 0U);
+    frame->dlc = frame->fdf ? TEST_RandomBelow(16U) : TEST_RandomBelow(9U);
+    for (index = 0U; index < sizeof(frame->data); index++)
+    {
+        frame->data[index] = (uint8_t)TEST_Random();
+    }
+}
+
+/* Bus traffic until the given time in ns. The transmitters use the bit
+   timing of the profile at a deviating clock. */
+static void Generate(const TRAFFIC *traffic, double until)
+{
+    static ENCODER encoder;
+    CAN_BIT_TIMING timing;
+    FRAME frame;
+    double nominalBit = (1.0e9 / nominalRates[traffic->profile / APP_CAN_BITRATE_DATA_RATES]) * (1.0 + traffic->deviation);
+    double dataBit = (1.0e9 / dataRates[traffic->profile % APP_CAN_BITRATE_DATA_RATES]) * (1.0 + traffic->deviation);
+    double nominalPoint = 0.0;
+    double dataPoint = 0.0;
+    double duration[4];
+    double time = 0.0;
+    double start = 0.0;
+    double brsNext = 0.0;
+    uint32_t level = 1U;
+    uint32_t index = 0U;
+
+    TEST_CHECK(APP_CAN_BitRateTimingGet(traffic->profile, &timing));
+    nominalPoint = (2.0 + timing.nominalBitTiming.nominalTimeSegment1) /
+                   (3.0 + timing.nominalBitTiming.nominalTimeSegment1 + timing.nominalBitTiming.nominalTimeSegment2);
+    dataPoint = (2.0 + timing.dataBitTiming.dataTimeSegment1) /
+                (3.0 + timing.dataBitTiming.dataTimeSegment1 + timing.dataBitTiming.dataTimeSegment2);
+    duration[BIT_NOMINAL] = nominalBit;
+    duration[BIT_DATA] = dataBit;
+    duration[BIT_BRS] = (nominalPoint * nominalBit) + ((1.0 - dataPoint) * dataBit);
+    duration[BIT_CRC_DELIMITER] = (dataPoint * dataBit) + ((1.0 - nominalPoint) * nominalBit);
+
+    edgeCount = 0U;
+    framesSent = 0U;
+    /* After the integration of the receiver */
+    time = nominalBit * (20U + TEST_RandomBelow(100U));
+    while ((traffic->load > 0.0) && (time < until))
+    {
+        RandomFrame(&frame, traffic);
+        if (traffic->brsInterval > 0.0)
+        {
+            frame.brs = (time >= brsNext);
+            frame.fdf = frame.fdf || frame.brs;
+            frame.rtr = frame.rtr && !frame.fdf;
+            if (frame.brs)
+            {
+                brsNext = time + (traffic->brsInterval * (0.5 + (TEST_RandomBelow(1001U) / 1000.0)));
+            }
+        }
+        Encode(&encoder, &frame);
+        if (!frame.brs && (TEST_RandomBelow(1000U) < (uint32_t)(traffic->disturbed * 1000.0)))
+        {
+            encoder.level[1U + TEST_RandomBelow(11U)] ^= 1U;
+        }
+        start = time;
+        for (index = 0U; index < encoder.count; index++)
+        {
+            if ((encoder.level[index] != level) && (edgeCount < EDGES_MAX))
+            {
+                edges[edgeCount++] = time + (traffic->jitter * ((TEST_RandomBelow(2001U) / 1000.0) - 1.0));
+                level = encoder.level[index];
+            }
+            time += duration[encoder.kind[index]];
+        }
+        TEST_CHECK(edgeCount < EDGES_MAX);
+        framesSent++;
+        /* Idle time for the load */
+        time += (time - start) * ((1.0 / traffic->load) - 1.0) * (TEST_RandomBelow(2001U) / 1000.0);
+    }
+}
+
+// *****************************************************************************
+// Section: Receiver
+// *****************************************************************************
+
+static void TimingConvert(const CAN_BIT_TIMING *timing, PHASE_TIMING *phases)
+{
+    phases[PHASE_NOMINAL].tq = CLOCK_NS * (timing->nominalBitTiming.nominalBaudRatePrescaler + 1U);
+    phases[PHASE_NOMINAL].tseg1 = timing->nominalBitTiming.nominalTimeSegment1 + 1U;
+    phases[PHASE_NOMINAL].tseg2 = timing->nominalBitTiming.nominalTimeSegment2 + 1U;
+    phases[PHASE_NOMINAL].sjw = timing->nominalBitTiming.nominalSJW + 1U;
+    phases[PHASE_DATA].tq = CLOCK_NS * (timing->dataBitTiming.dataBaudRatePrescaler + 1U);
+    phases[PHASE_DATA].tseg1 = timing->dataBitTiming.dataTimeSegment1 + 1U;
+    phases[PHASE_DATA].tseg2 = timing->dataBitTiming.dataTimeSegment2 + 1U;
+    phases[PHASE_DATA].sjw = timing->dataBitTiming.dataSJW + 1U;
+}
+
+static double NominalBit(const RECEIVER *rx)
+{
+    const PHASE_TIMING *phase = &rx->timing[PHASE_NOMINAL];
+
+    return phase->tq * (1U + phase->tseg1 + phase->tseg2);
+}
+
+/* Samples the next bit. A falling edge after the sample point of a recessive
+   bit shortens phase segment 2, one after the synchronization segment
+   lengthens phase segment 1, by the jump width at most. The phase error is
+   measured in CAN clocks. */
+static uint32_t ReceiveRaw(RECEIVER *rx)
+{
+    const PHASE_TIMING *phase = &rx->timing[rx->phase];
+    double start = 0.0;
+    double edge = 0.0;
+    double error = 0.0;
+
+    if (!rx->first)
+    {
+        start = rx->sample + (phase->tseg2 * phase->tq);
+        edge = FallingAfter(rx->sample);
+        if ((rx->level == 1U) && (edge < start))
+        {
+            start = fmax(start - (ceil((start - edge) / CLOCK_NS) * CLOCK_NS), start - (phase->sjw * phase->tq));
+        }
+        rx->sample = start + ((1U + phase->tseg1) * phase->tq);
+        edge = FallingAfter(start);
+        if ((rx->level == 1U) && (edge < rx->sample))
+        {
+            error = floor((edge - start) / CLOCK_NS) * CLOCK_NS;
+            rx->sample += fmin(error, phase->sjw * phase->tq);
+        }
+    }
+    rx->first = false;
+    rx->level = LevelAt(rx->sample);
+    return rx->level;
+}
+
+/* A stuff bit due after five equal bits */
+static bool ReceiveStuff(RECEIVER *rx)
+{
+    uint32_t level = 0U;
+
+    if (rx->run != 5U)
+    {
+        return true;
+    }
+    level = ReceiveRaw(rx);
+    if (level == rx->runLevel)
+    {
+        return false;
+    }
+    CrcFd(&rx->crc17, &rx->crc21, level);
+    rx->stuffCount++;
+    rx->run = 1U;
+    rx->runLevel = level;
+    return true;
+}
+
+static bool ReceiveBits(RECEIVER *rx, uint32_t width, uint32_t *value)
+{
+    uint32_t bit = 0U;
+
+    *value = 0U;
+    while (width > 0U)
+    {
+        width--;
+        if (!ReceiveStuff(rx))
+        {
+            return false;
+        }
+        bit = ReceiveRaw(rx);
+        CrcFd(&rx->crc17, &rx->crc21, bit);
+        rx->crc15 = CrcUpdate(rx->crc15, bit, 0x4599U, 15U);
+        rx->run = (bit == rx->runLevel) ? (rx->run + 1U) : 1U;
+        rx->runLevel = bit;
+        *value = (*value << 1) | bit;
+    }
+    return true;
+}
+
+static bool ReceiveFixed(RECEIVER *rx, uint32_t width, uint32_t *position, uint32_t *value)
+{
+    uint32_t previous = 0U;
+
+    *value = 0U;
+    while (width > 0U)
+    {
+        width--;
+        if ((*position % 4U) == 0U)
+        {
+            previous = rx->level;
+            if (ReceiveRaw(rx) == previous)
+            {
+                return false;
+            }
+        }
+        *value = (*value << 1) | ReceiveRaw(rx);
+        (*position)++;
+    }
+    return true;
+}
+
+/* Receives a frame from the start of frame at sof. Returns false at the
+   first error, which rx->phase locates. */
+static bool Receive(RECEIVER *rx, double sof, bool *brs)
+{
+    uint32_t value = 0U;
+    uint32_t xtd = 0U;
+    uint32_t rtr = 0U;
+    uint32_t fdf = 0U;
+    uint32_t dlc = 0U;
+    uint32_t length = 0U;
+    uint32_t index = 0U;
+    uint32_t crc = 0U;
+    uint32_t count = 0U;
+    uint32_t position = 0U;
+
+    rx->phase = PHASE_NOMINAL;
+    rx->first = true;
+    rx->sample = sof + ((1U + rx->timing[PHASE_NOMINAL].tseg1) * rx->timing[PHASE_NOMINAL].tq);
+    rx->level = 1U;
+    rx->run = 0U;
+    rx->runLevel = 2U;
+    rx->stuffCount = 0U;
+    rx->crc15 = 0U;
+    rx->crc17 = 1UL << 16;
+    rx->crc21 = 1UL << 20;
+    *brs = false;
+
+    /* Start of frame, base identifier, RTR, SRR or RRS, IDE */
+    if (!ReceiveBits(rx, 1U, &value) || (value != 0U) || !ReceiveBits(rx, 12U, &value) ||
+        !ReceiveBits(rx, 1U, &xtd))
+    {
+        return false;
+    }
+    rtr = value & 1U;
+    if (xtd != 0U)
+    {
+        if (!ReceiveBits(rx, 18U, &value) || !ReceiveBits(rx, 1U, &rtr))
+        {
+            return false;
+        }
+    }
+    if (!ReceiveBits(rx, 1U, &fdf))
+    {
+        return false;
+    }
+    if (fdf != 0U)
+    {
+        /* res must be dominant */
+        if (!ReceiveBits(rx, 1U, &value) || (value != 0U) || !ReceiveBits(rx, 1U, &value))
+        {
+            return false;
+        }
+        if (value != 0U)
+        {
+            *brs = true;
+            rx->phase = PHASE_DATA;
+        }
+        if (!ReceiveBits(rx, 1U, &value))
+        {
+            return false;
+        }
+    }
+    else if ((xtd != 0U) && !ReceiveBits(rx, 1U, &value))
+    {
+        return false;
+    }
+    if (!ReceiveBits(rx, 4U, &dlc))
+    {
+        return false;
+    }
+    length = (fdf != 0U) ? fdLength[dlc] : ((rtr != 0U) ? 0U : ((dlc < 8U) ? dlc : 8U));
+    for (index = 0U; index < length; index++)
+    {
+        if (!ReceiveBits(rx, 8U, &value))
+        {
+            return false;
+        }
+    }
+
+    if (fdf != 0U)
+    {
+        if (!ReceiveStuff(rx) || !ReceiveFixed(rx, 4U, &position, &value))
+        {
+            return false;
+        }
+        count = rx->stuffCount % 8U;
+        count = ((count ^ (count >> 1)) << 1) | (((count ^ (count >> 1) ^ (count >> 2)) & 1U));
+        for (index = 0U; index < 4U; index++)
+        {
+            CrcFd(&rx->crc17, &rx->crc21, (value >> (3U - index)) & 1U);
+        }
+        crc = (length <= 16U) ? rx->crc17 : rx->crc21;
+        if ((value != count) || !ReceiveFixed(rx, (length <= 16U) ? 17U : 21U, &position, &value) || (value != crc))
+        {
+            return false;
+        }
+    }
+    else
+    {
+        crc = rx->crc15;
+        if (!ReceiveBits(rx, 15U, &value) || (value != crc) || !ReceiveStuff(rx))
+        {
+            return false;
+        }
+    }
+
+    /* CRC delimiter, back to the nominal bit rate after its sample point */
+    if (ReceiveRaw(rx) != 1U)
+    {
+        return false;
+    }
+    rx->phase = PHASE_NOMINAL;
+    /* ACK slot, ACK delimiter, end of frame but its last bit */
+    (void)ReceiveRaw(rx);
+    for (index = 0U; index < 7U; index++)
+    {
+        if (ReceiveRaw(rx) != 1U)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+/* After an error the controller waits for 11 recessive bits */
+static double Integrate(const RECEIVER *rx, double time)
+{
+    double bits = 11.0 * NominalBit(rx);
+    double falling = 0.0;
+
+    for (;;)
+    {
+        if (LevelAt(time) == 0U)
+        {
+            time = RisingAfter(time);
+        }
+        falling = FallingAfter(time);
+        if ((falling - time) >= bits)
+        {
+            return time + bits;
+        }
+        time = falling;
+    }
+}
+
+/* Receives until the given time, the results of the frames count when their
+   end of frame has been sampled */
+static void ReceiverRun(double until)
+{
+    CAN_RX_BUFFER rxBuf;
+    double sof = 0.0;
+
+    for (;;)
+    {
+        if (pending)
+        {
+            if (pendingTime > until)
+            {
+                return;
+            }
+            pending = false;
+            if (pendingOk)
+            {
+                if (!rejectAll)
+                {
+                    memset(&rxBuf, 0, sizeof(rxBuf));
+                    rxBuf.brs = pendingBrs ? 1U : 0U;
+                    APP_CAN_BitRateAutoFrameAdd(&rxBuf);
+                    framesReceived++;
+                }
+            }
+            else if (pendingPhase == PHASE_DATA)
+            {
+                dataErrors++;
+            }
+            else
+            {
+                nominalErrors++;
+            }
+            continue;
+        }
+        sof = FallingAfter(ready);
+        if (sof > until)
+        {
+            return;
+        }
+        pending = true;
+        pendingOk = Receive(&receiver, sof, &pendingBrs);
+        pendingPhase = receiver.phase;
+        pendingTime = receiver.sample;
+        /* End of frame and intermission, or integration */
+        ready = pendingOk ? (receiver.sample + (3.0 * NominalBit(&receiver))) : Integrate(&receiver, receiver.sample);
+    }
+}
+
+// *****************************************************************************
+// Section: CAN1 Peripheral Library Stubs
+// *****************************************************************************
+
+/* The controller restarts with the new bit timing, a frame being received
+   is lost */
+bool CAN1_BitTimingSet(const CAN_BIT_TIMING *bitTiming)
+{
+    timingSet = *bitTiming;
+    timingSets++;
+    TimingConvert(bitTiming, receiver.timing);
+    pending = false;
+    ready = Integrate(&receiver, simNow);
+    return true;
+}
+
+void CAN1_ProtocolErrorCountGet(uint32_t *nominalErrorCount, uint32_t *dataErrorCount)
+{
+    *nominalErrorCount = nominalErrors;
+    *dataErrorCount = dataErrors;
+}
+
+uint32_t CAN1_RxTimestampExtend(uint16_t rxts)
+{
+    (void)rxts;
+    return (uint32_t)(simNow / (1.0e9 / APP_CAN_FORMAT_TICKS_PER_SECOND));
+}
+
+void CAN1_BusMonitoringSet(bool enable)
+{
+    monitoring = enable;
+}
+
+bool CAN1_BusMonitoringGet(void)
+{
+    return monitoring;
+}
+
+// *****************************************************************************
+// Section: Tests
+// *****************************************************************************
+
+static bool TimingEqual(const CAN_BIT_TIMING *a, const CAN_BIT_TIMING *b)
+{
+    return (a->nominalBitTimingSet == b->nominalBitTimingSet) && (a->dataBitTimingSet == b->dataBitTimingSet) &&
+           (a->nominalBitTiming.nominalBaudRatePrescaler == b->nominalBitTiming.nominalBaudRatePrescaler) &&
+           (a->nominalBitTiming.nominalTimeSegment1 == b->nominalBitTiming.nominalTimeSegment1) &&
+           (a->nominalBitTiming.nominalTimeSegment2 == b->nominalBitTiming.nominalTimeSegment2) &&
+           (a->nominalBitTiming.nominalSJW == b->nominalBitTiming.nominalSJW) &&
+           (a->dataBitTiming.dataBaudRatePrescaler == b->dataBitTiming.dataBaudRatePrescaler) &&
+           (a->dataBitTiming.dataTimeSegment1 == b->dataBitTiming.dataTimeSegment1) &&
+           (a->dataBitTiming.dataTimeSegment2 == b->dataBitTiming.dataTimeSegment2) &&
+           (a->dataBitTiming.dataSJW == b->dataBitTiming.dataSJW);
+}
+
+static TRAFFIC Traffic(uint32_t profile, double fdShare, double brsShare)
+{
+    TRAFFIC traffic;
+
+    traffic.profile = profile;
+    traffic.fdShare = fdShare;
+    traffic.brsShare = brsShare;
+    traffic.load = 0.1 + (TEST_RandomBelow(30U) / 100.0);
+    /* Up to 0.3 % clock deviation and 5 ns of jitter */
+    traffic.deviation = ((double)TEST_RandomBelow(601U) - 300.0) * 1e-5;
+    traffic.jitter = 5.0;
+    traffic.brsInterval = 0.0;
+    traffic.disturbed = 0.0;
+    return traffic;
+}
+
+/* Runs a detection from the profile start on the traffic. Returns the
+   milliseconds it took, run when it did not end. */
+static uint32_t Detect(const TRAFFIC *traffic, uint32_t start, bool wasMonitoring, uint32_t run)
+{
+    uint32_t ms = 0U;
+
+    TEST_CHECK(run <= RUN_MS);
+    Generate(traffic, run * NS_PER_MS);
+    simNow = 0.0;
+    nominalErrors = 0U;
+    dataErrors = 0U;
+    framesReceived = 0U;
+    monitoring = wasMonitoring;
+    TEST_CHECK(APP_CAN_BitRateProfileSet(start));
+    TEST_CHECK(APP_CAN_BitRateAutoStart());
+    TEST_CHECK(APP_CAN_BitRateAutoStart() == false);
+    TEST_CHECK(monitoring);
+
+    for (ms = 1U; ms <= run; ms++)
+    {
+        simNow = ms * NS_PER_MS;
+        ReceiverRun(simNow);
+        APP_CAN_BitRateAutoTasks();
+        if (APP_CAN_BitRateAutoStateGet() == APP_CAN_BITRATE_AUTO_STATE_IDLE)
+        {
+            break;
+        }
+    }
+    TEST_CHECK(monitoring == wasMonitoring);
+    return ms;
+}
+
+/* The bit rates of the profiles are the standard ones */
+static void TestRates(void)
+{
+    CAN_BIT_TIMING timing;
+    uint32_t profile = 0U;
+
+    for (profile = 0U; profile < APP_CAN_BITRATE_PROFILES; profile++)
+    {
+        TEST_CHECK(APP_CAN_BitRateNominalGet(profile) == nominalRates[profile / APP_CAN_BITRATE_DATA_RATES]);
+        TEST_CHECK(APP_CAN_BitRateDataGet(profile) == dataRates[profile % APP_CAN_BITRATE_DATA_RATES]);
+        TEST_CHECK(APP_CAN_BitRateTimingGet(profile, &timing));
+    }
+    TEST_CHECK(APP_CAN_BitRateNominalGet(APP_CAN_BITRATE_PROFILES) == 0U);
+    TEST_CHECK(APP_CAN_BitRateDataGet(APP_CAN_BITRATE_PROFILES) == 0U);
+    TEST_CHECK(APP_CAN_BitRateTimingGet(APP_CAN_BITRATE_PROFILES, &timing) == false);
+    TEST_CHECK(APP_CAN_BitRateProfileSet(APP_CAN_BITRATE_PROFILES) == false);
+}
+
+/* The simulated receiver takes every frame without an error at the bit
+   timing of the bus, so errors at other bit rates come from the bit rate */
+static void TestReceiver(void)
+{
+    TRAFFIC traffic;
+    uint32_t profile = 0U;
+
+    for (profile = 0U; profile < APP_CAN_BITRATE_PROFILES; profile++)
+    {
+        traffic = Traffic(profile, 0.6, 0.7);
+        Generate(&traffic, 200.0 * NS_PER_MS);
+        simNow = 0.0;
+        nominalErrors = 0U;
+        dataErrors = 0U;
+        framesReceived = 0U;
+        TEST_CHECK(APP_CAN_BitRateProfileSet(profile));
+        ReceiverRun(2.0 * RUN_MS * NS_PER_MS);
+        TEST_CHECK((nominalErrors == 0U) && (dataErrors == 0U));
+        TEST_CHECK((framesReceived == framesSent) && (framesSent > 20U));
+        if ((framesReceived != framesSent) || (nominalErrors != 0U) || (dataErrors != 0U))
+        {
+            printf("  profile %lu: %lu of %lu frames, %lu nominal and %lu data errors\n", (unsigned long)profile,
+                   (unsigned long)framesReceived, (unsigned long)framesSent, (unsigned long)nominalErrors,
+                   (unsigned long)dataErrors);
+        }
+    }
+}
+
+/* Every profile from the default one and from a random one: the bit timing
+   of the bus in under a second */
+static void TestDetect(void)
+{
+    CAN_BIT_TIMING expected;
+    TRAFFIC traffic;
+    uint32_t profile = 0U;
+    uint32_t round = 0U;
+    uint32_t start = 0U;
+    uint32_t ms = 0U;
+
+    for (profile = 0U; profile < APP_CAN_BITRATE_PROFILES; profile++)
+    {
+        for (round = 0U; round < 3U; round++)
+        {
+            start = (round == 0U) ? APP_CAN_BITRATE_PROFILE_DEFAULT : TEST_RandomBelow(APP_CAN_BITRATE_PROFILES);
+            traffic = Traffic(profile, 0.3 + (TEST_RandomBelow(70U) / 100.0), 0.5);
+            ms = Detect(&traffic, start, round == 2U, DETECT_MS_MAX);
+            TEST_CHECK(APP_CAN_BitRateAutoResultGet() == APP_CAN_BITRATE_AUTO_RESULT_DETECTED);
+            TEST_CHECK(APP_CAN_BitRateProfileGet() == profile);
+            TEST_CHECK(APP_CAN_BitRateTimingGet(profile, &expected) && TimingEqual(&timingSet, &expected));
+            TEST_CHECK(ms < DETECT_MS_MAX);
+            if ((APP_CAN_BitRateProfileGet() != profile) || (ms >= DETECT_MS_MAX))
+            {
+                printf("  profile %lu from %lu: %lu after %lu ms\n", (unsigned long)profile, (unsigned long)start,
+                       (unsigned long)APP_CAN_BitRateProfileGet(), (unsigned long)ms);
+            }
+        }
+    }
+}
+
+/* CAN FD frames with bit rate switching only, from a profile of another
+   data bit rate: at the right nominal bit rate they all fail in the data
+   phase, which still tells the nominal bit rate */
+static void TestBrsOnly(void)
+{
+    CAN_BIT_TIMING expected;
+    TRAFFIC traffic;
+    uint32_t profile = 0U;
+    uint32_t start = 0U;
+    uint32_t ms = 0U;
+    APP_CAN_BITRATE_SCORE score;
+
+    for (profile = 0U; profile < APP_CAN_BITRATE_PROFILES; profile++)
+    {
+        start = (TEST_RandomBelow(APP_CAN_BITRATE_NOMINAL_RATES) * APP_CAN_BITRATE_DATA_RATES) +
+                ((profile + 1U + TEST_RandomBelow(APP_CAN_BITRATE_DATA_RATES - 1U)) % APP_CAN_BITRATE_DATA_RATES);
+        traffic = Traffic(profile, 1.0, 1.0);
+        ms = Detect(&traffic, start, false, DETECT_MS_MAX);
+        TEST_CHECK(APP_CAN_BitRateAutoResultGet() == APP_CAN_BITRATE_AUTO_RESULT_DETECTED);
+        TEST_CHECK(APP_CAN_BitRateProfileGet() == profile);
+        TEST_CHECK(APP_CAN_BitRateTimingGet(profile, &expected) && TimingEqual(&timingSet, &expected));
+        TEST_CHECK(ms < DETECT_MS_MAX);
+        APP_CAN_BitRateAutoScoreGet(false, profile / APP_CAN_BITRATE_DATA_RATES, &score);
+        TEST_CHECK((score.frames == 0U) && (score.dataErrors != 0U) && (score.nominalErrors == 0U));
+    }
+}
+
+/* A frame with bit rate switching every 150 ms on average and disturbed
+   frames, so that no bit rate is free of errors: the bit timing is still
+   found, it only takes longer */
+static void TestSparse(void)
+{
+    CAN_BIT_TIMING expected;
+    TRAFFIC traffic;
+    uint32_t profile = 0U;
+    uint32_t round = 0U;
+    uint32_t start = 0U;
+
+    for (round = 0U; round < (2U * APP_CAN_BITRATE_PROFILES); round++)
+    {
+        profile = round % APP_CAN_BITRATE_PROFILES;
+        start = TEST_RandomBelow(APP_CAN_BITRATE_PROFILES);
+        traffic = Traffic(profile, 0.5, 0.0);
+        traffic.brsInterval = 150.0 * NS_PER_MS;
+        traffic.disturbed = 0.05;
+        (void)Detect(&traffic, start, false, RUN_MS);
+        /* Kept when too few frames confirmed it, which is right here */
+        TEST_CHECK((APP_CAN_BitRateAutoResultGet() == APP_CAN_BITRATE_AUTO_RESULT_DETECTED) ||
+                   ((APP_CAN_BitRateAutoResultGet() == APP_CAN_BITRATE_AUTO_RESULT_NOMINAL) &&
+                    ((start % APP_CAN_BITRATE_DATA_RATES) == (profile % APP_CAN_BITRATE_DATA_RATES))));
+        TEST_CHECK(APP_CAN_BitRateProfileGet() == profile);
+        TEST_CHECK(APP_CAN_BitRateTimingGet(profile, &expected) && TimingEqual(&timingSet, &expected));
+        if (APP_CAN_BitRateProfileGet() != profile)
+        {
+            printf("  profile %lu from %lu: %lu, result %u\n", (unsigned long)profile, (unsigned long)start,
+                   (unsigned long)APP_CAN_BitRateProfileGet(), (unsigned)APP_CAN_BitRateAutoResultGet());
+        }
+    }
+}
+
+/* Classic frames only: the nominal bit rate is detected, the data bit rate
+   is kept */
+static void TestClassic(void)
+{
+    CAN_BIT_TIMING expected;
+    TRAFFIC traffic;
+    uint32_t nominal = 0U;
+    uint32_t start = 0U;
+    uint32_t ms = 0U;
+    APP_CAN_BITRATE_SCORE score;
+
+    for (nominal = 0U; nominal < APP_CAN_BITRATE_NOMINAL_RATES; nominal++)
+    {
+        start = TEST_RandomBelow(APP_CAN_BITRATE_PROFILES);
+        traffic = Traffic((nominal * APP_CAN_BITRATE_DATA_RATES) + TEST_RandomBelow(APP_CAN_BITRATE_DATA_RATES), 0.0, 0.0);
+        ms = Detect(&traffic, start, false, DETECT_MS_MAX);
+        TEST_CHECK(APP_CAN_BitRateAutoResultGet() == APP_CAN_BITRATE_AUTO_RESULT_NOMINAL);
+        TEST_CHECK(APP_CAN_BitRateProfileGet() ==
+                   ((nominal * APP_CAN_BITRATE_DATA_RATES) + (start % APP_CAN_BITRATE_DATA_RATES)));
+        TEST_CHECK(APP_CAN_BitRateTimingGet(APP_CAN_BitRateProfileGet(), &expected) && TimingEqual(&timingSet, &expected));
+        TEST_CHECK(ms < DETECT_MS_MAX);
+        APP_CAN_BitRateAutoScoreGet(false, nominal, &score);
+        TEST_CHECK(score.tried && (score.frames != 0U) && (score.nominalErrors == 0U) && (score.brsFrames == 0U));
+    }
+}
+
+/* Every frame rejected by the acceptance filter: the only nominal bit rate
+   without errors is taken */
+static void TestRejected(void)
+{
+    TRAFFIC traffic;
+    uint32_t nominal = 0U;
+    uint32_t start = 0U;
+    uint32_t ms = 0U;
+
+    rejectAll = true;
+    for (nominal = 0U; nominal < APP_CAN_BITRATE_NOMINAL_RATES; nominal++)
+    {
+        start = TEST_RandomBelow(APP_CAN_BITRATE_PROFILES);
+        traffic = Traffic((nominal * APP_CAN_BITRATE_DATA_RATES) + TEST_RandomBelow(APP_CAN_BITRATE_DATA_RATES), 0.0, 0.0);
+        ms = Detect(&traffic, start, false, DETECT_MS_MAX);
+        TEST_CHECK(APP_CAN_BitRateAutoResultGet() == APP_CAN_BITRATE_AUTO_RESULT_NOMINAL);
+        TEST_CHECK(APP_CAN_BitRateProfileGet() ==
+                   ((nominal * APP_CAN_BITRATE_DATA_RATES) + (start % APP_CAN_BITRATE_DATA_RATES)));
+        TEST_CHECK(ms < DETECT_MS_MAX);
+    }
+    rejectAll = false;
+}
+
+/* No traffic, or traffic at a bit rate of no profile: the profile in use is
+   restored */
+static void TestFailed(void)
+{
+    CAN_BIT_TIMING expected;
+    TRAFFIC traffic = Traffic(0U, 0.5, 0.5);
+    uint32_t start = 0U;
+
+    start = TEST_RandomBelow(APP_CAN_BITRATE_PROFILES);
+    traffic.load = 0.0;
+    (void)Detect(&traffic, start, false, DETECT_MS_MAX);
+    TEST_CHECK(APP_CAN_BitRateAutoResultGet() == APP_CAN_BITRATE_AUTO_RESULT_FAILED);
+    TEST_CHECK(APP_CAN_BitRateProfileGet() == start);
+    TEST_CHECK(APP_CAN_BitRateTimingGet(start, &expected) && TimingEqual(&timingSet, &expected));
+
+    /* 83.3 kbit/s, between none of the candidates */
+    traffic = Traffic(0U, 0.0, 0.0);
+    traffic.deviation = 0.5;
+    start = TEST_RandomBelow(APP_CAN_BITRATE_PROFILES);
+    (void)Detect(&traffic, start, true, DETECT_MS_MAX);
+    TEST_CHECK(APP_CAN_BitRateAutoResultGet() == APP_CAN_BITRATE_AUTO_RESULT_FAILED);
+    TEST_CHECK(APP_CAN_BitRateProfileGet() == start);
+    TEST_CHECK(nominalErrors != 0U);
+}
+
+int main(void)
+{
+    TEST_RandomSeed(24U);
+    TestRates();
+    TestReceiver();
+    TestDetect();
+    TestBrsOnly();
+    TestSparse();
+    TestClassic();
+    TestRejected();
+    TestFailed();
+
+    printf("test_bitrate: %u failures\n", testFailures);
+    return TEST_RESULT();
+}
@@ -0,0 +1,520 @@
+/*******************************************************************************
+  CAN1 FIFO Host Test
+
+  File Name:
+    test_can1_fifo.c
+
+  Summary:
+    Drives the Rx FIFO and Tx Event FIFO routines of the CAN1 peripheral
+    library against a simulated controller.
+
+  Description:
+    The controller is a register block and a Message RAM on the host. It
+    stores frames at the put index, drops them while a FIFO is full
+    (blocking mode) and flags the loss in IR, and moves the get index on the
+    acknowledge writes of the library. The FIFO depths are compile time
+    constants of the library, the test is built once per depth (see
+    CMakeLists.txt) so the get index wraps at 1, 7, 32 and 64 elements.
+*******************************************************************************/
+
+#include <string.h>
+#include "test_common.h"
+#include "definitions.h"
+#include "interrupts.h"
+
+/* Value of an acknowledge register the library has not written */
+#define ACK_NONE            0xFFFFFFFFUL
+#define ROUNDS              3000U
+/* The Tx event ring is not read for the first rounds of every period */
+#define STALL_PERIOD        300U
+#define STALL_ROUNDS        100U
+#define ID_Msk              0x1FFFFFFFUL
+
+typedef struct
+{
+    volatile uint32_t *status;
+    volatile uint32_t *ack;
+    uint8_t *elements;
+    uint32_t elementSize;
+    uint32_t depth;
+    bool txEvent;
+    /* IR flags of a new element and of a lost one */
+    uint32_t newMask;
+    uint32_t lostMask;
+    uint32_t get;
+    uint32_t put;
+    uint32_t fill;
+    /* Sequence number of the frame in each element */
+    uint32_t sequence[64];
+    uint32_t nextSequence;
+    bool newPending;
+    bool lostPending;
+    uint32_t framesLost;
+    /* Interrupts served with the loss flagged */
+    uint32_t lostEvents;
+    uint32_t framesRead;
+    uint32_t lastRead;
+    /* Reads of the library which crossed the end of the FIFO */
+    uint32_t wrapReads;
+} SIM_FIFO;
+
+can_registers_t hostCan1Regs;
+
+static uint32_t messageRam[(CAN1_MESSAGE_RAM_CONFIG_SIZE + 3U) / 4U];
+/* Frames read by the library, whole Message RAM elements one after another */
+static uint32_t rxElements[(64U * CAN1_RX_FIFO0_ELEMENT_SIZE) / 4U];
+static SIM_FIFO rxFifo[2];
+static SIM_FIFO txEventFifo;
+/* Frames given to the library, whole Tx FIFO elements one after another */
+static uint32_t txElements[CAN1_TX_FIFO_BUFFER_SIZE / 4U];
+
+/* Tx events the interrupt handler moved into the Tx event ring */
+static uint32_t ringSequence[CAN1_TX_EVENT_RING_ELEMENTS];
+static uint32_t ringHead = 0U;
+static uint32_t ringTail = 0U;
+static uint32_t ringLost = 0U;
+static uint32_t ringAdded = 0U;
+static uint32_t txEventsRead = 0U;
+
+// *****************************************************************************
+// Section: Simulated Controller
+// *****************************************************************************
+
+/* RXF1S and TXEFS have the fields of RXF0S at the same positions */
+static void SimStatus(SIM_FIFO *fifo)
+{
+    if (fifo->txEvent)
+    {
+        *fifo->status = CAN_TXEFS_EFFL(fifo->fill) | CAN_TXEFS_EFGI(fifo->get) | CAN_TXEFS_EFPI(fifo->put) |
+                        CAN_TXEFS_EFF((fifo->fill == fifo->depth) ? 1U : 0U) | CAN_TXEFS_TEFL(fifo->lostPending ? 1U : 0U);
+    }
+    else
+    {
+        *fifo->status = CAN_RXF0S_F0FL(fifo->fill) | CAN_RXF0S_F0GI(fifo->get) | CAN_RXF0S_F0PI(fifo->put) |
+                        CAN_RXF0S_F0F((fifo->fill == fifo->depth) ? 1U : 0U) | CAN_RXF0S_RF0L(fifo->lostPending ? 1U : 0U);
+    }
+}
+
+static void SimReset(SIM_FIFO *fifo, volatile uint32_t *status, volatile uint32_t *ack, uint32_t offset,
+                     uint32_t elementSize, uint32_t depth, bool txEvent, uint32_t newMask, uint32_t lostMask)
+{
+    memset(fifo, 0, sizeof(*fifo));
+    fifo->status = status;
+    fifo->ack = ack;
+    fifo->elements = (uint8_t *)messageRam + offset;
+    fifo->elementSize = elementSize;
+    fifo->depth = depth;
+    fifo->txEvent = txEvent;
+    fifo->newMask = newMask;
+    fifo->lostMask = lostMask;
+    *fifo->ack = ACK_NONE;
+    SimStatus(fifo);
+}
+
+/* A frame received, or a Tx event, at the put index */
+static void SimStore(SIM_FIFO *fifo)
+{
+    uint8_t *element = fifo->elements + (fifo->put * fifo->elementSize);
+    CAN_RX_BUFFER *rxBuffer = (CAN_RX_BUFFER *)element;
+    CAN_TX_EVENT_FIFO *txEvent = (CAN_TX_EVENT_FIFO *)element;
+    uint32_t sequence = fifo->nextSequence++;
+
+    if (fifo->fill == fifo->depth)
+    {
+        fifo->framesLost++;
+        fifo->lostPending = true;
+        SimStatus(fifo);
+        return;
+    }
+    memset(element, 0, fifo->elementSize);
+    if (fifo->txEvent)
+    {
+        txEvent->id = sequence & ID_Msk;
+        txEvent->xtd = 1U;
+        txEvent->et = 1U;
+        txEvent->mm = (uint8_t)sequence;
+    }
+    else
+    {
+        rxBuffer->id = sequence & ID_Msk;
+        rxBuffer->xtd = 1U;
+        rxBuffer->dlc = 8U;
+        memcpy(rxBuffer->data, &sequence, sizeof(sequence));
+    }
+    fifo->sequence[fifo->put] = sequence;
+    fifo->put = (fifo->put + 1U) % fifo->depth;
+    fifo->fill++;
+    fifo->newPending = true;
+    SimStatus(fifo);
+}
+
+/* Applies an acknowledge write of the library, the elements up to the index
+   are freed. Returns the number freed. */
+static uint32_t SimAck(SIM_FIFO *fifo)
+{
+    uint32_t index = 0U;
+    uint32_t count = 0U;
+
+    if (*fifo->ack == ACK_NONE)
+    {
+        return 0U;
+    }
+    index = *fifo->ack;
+    *fifo->ack = ACK_NONE;
+    TEST_CHECK(index < fifo->depth);
+    count = ((index + fifo->depth - fifo->get) % fifo->depth) + 1U;
+    TEST_CHECK(count <= fifo->fill);
+    if ((fifo->get + count) > fifo->depth)
+    {
+        fifo->wrapReads++;
+    }
+    fifo->get = (index + 1U) % fifo->depth;
+    fifo->fill -= count;
+    SimStatus(fifo);
+    return count;
+}
+
+/* The Tx events the interrupt handler is going to move into the ring */
+static void SimRingCollect(void)
+{
+    uint32_t index = 0U;
+
+    ringAdded = 0U;
+    for (index = 0U; index < txEventFifo.fill; index++)
+    {
+        if ((ringHead - ringTail) >= CAN1_TX_EVENT_RING_ELEMENTS)
+        {
+            ringLost++;
+            continue;
+        }
+        ringSequence[ringHead % CAN1_TX_EVENT_RING_ELEMENTS] =
+            txEventFifo.sequence[(txEventFifo.get + index) % txEventFifo.depth];
+        ringHead++;
+        ringAdded++;
+    }
+}
+
+/* Raises the pending flags in IR and runs the interrupt handler */
+static void SimInterrupt(void)
+{
+    SIM_FIFO *fifos[3] = { &rxFifo[0], &rxFifo[1], &txEventFifo };
+    uint32_t ir = 0U;
+    uint32_t collected = 0U;
+    uint32_t index = 0U;
+
+    for (index = 0U; index < 3U; index++)
+    {
+        if (fifos[index]->newPending)
+        {
+            ir |= fifos[index]->newMask;
+        }
+        if (fifos[index]->lostPending)
+        {
+            ir |= fifos[index]->lostMask;
+            fifos[index]->lostEvents++;
+        }
+        fifos[index]->newPending = false;
+        fifos[index]->lostPending = false;
+        SimStatus(fifos[index]);
+    }
+    if ((ir & CAN_IR_TEFN_Msk) != 0U)
+    {
+        collected = txEventFifo.fill;
+        SimRingCollect();
+    }
+
+    hostCan1Regs.CAN_IR = ir;
+    CAN1_InterruptHandler();
+    hostCan1Regs.CAN_IR = 0U;
+
+    /* All Tx events are read and acknowledged at once */
+    TEST_CHECK(SimAck(&txEventFifo) == collected);
+}
+
+// *****************************************************************************
+// Section: Library Side
+// *****************************************************************************
+
+/* Checks frames read from the FIFO before the acknowledge is applied */
+static void ReadCheck(SIM_FIFO *fifo, const uint32_t *sequences, uint32_t count)
+{
+    uint32_t index = 0U;
+    uint32_t expected = 0U;
+
+    for (index = 0U; index < count; index++)
+    {
+        expected = fifo->sequence[(fifo->get + index) % fifo->depth];
+        TEST_CHECK(sequences[index] == (expected & ID_Msk));
+        TEST_CHECK((fifo->framesRead == 0U) || (expected > fifo->lastRead));
+        fifo->lastRead = expected;
+        fifo->framesRead++;
+    }
+}
+
+/* Reads all frames in chunks of random size, so reads start at every get
+   index and cross the end of the FIFO */
+static void RxFifoCallback(uint8_t numberOfMessage, uintptr_t context)
+{
+    SIM_FIFO *fifo = &rxFifo[context];
+    const CAN_RX_BUFFER *rxBuffer = NULL;
+    uint32_t sequences[64];
+    uint32_t remaining = numberOfMessage;
+    uint32_t sequence = 0U;
+    uint32_t count = 0U;
+    uint32_t index = 0U;
+
+    TEST_CHECK(numberOfMessage == fifo->fill);
+    TEST_CHECK(CAN1_RxFifoFillLevelGet((CAN_RX_FIFO_NUM)context) == numberOfMessage);
+    while (remaining > 0U)
+    {
+        count = 1U + TEST_RandomBelow(remaining);
+        TEST_CHECK(CAN1_MessageReceiveFifo((CAN_RX_FIFO_NUM)context, (uint8_t)count, (CAN_RX_BUFFER *)rxElements));
+        for (index = 0U; index < count; index++)
+        {
+            rxBuffer = (const CAN_RX_BUFFER *)((uint8_t *)rxElements + (index * CAN1_RX_FIFO0_ELEMENT_SIZE));
+            sequences[index] = rxBuffer->id;
+            memcpy(&sequence, rxBuffer->data, sizeof(sequence));
+            TEST_CHECK((sequence & ID_Msk) == rxBuffer->id);
+        }
+        ReadCheck(fifo, sequences, count);
+        TEST_CHECK(SimAck(fifo) == count);
+        remaining -= count;
+    }
+}
+
+static void TxEventCallback(uint8_t numberOfTxEvent, uintptr_t context)
+{
+    (void)context;
+    TEST_CHECK(numberOfTxEvent == ringAdded);
+}
+
+/* Reads up to count Tx events from the ring */
+static void TxEventRead(uint32_t count)
+{
+    CAN_TX_EVENT event;
+    uint32_t sequence = 0U;
+
+    while (count > 0U)
+    {
+        if (ringTail == ringHead)
+        {
+            TEST_CHECK(CAN1_TxEventGet(&event) == false);
+            return;
+        }
+        sequence = ringSequence[ringTail % CAN1_TX_EVENT_RING_ELEMENTS];
+        ringTail++;
+        TEST_CHECK(CAN1_TxEventGet(&event));
+        TEST_CHECK(event.element.id == (sequence & ID_Msk));
+        TEST_CHECK(event.element.mm == (uint8_t)sequence);
+        txEventsRead++;
+        count--;
+    }
+}
+
+/* Controller with empty FIFOs and the Message RAM layout of the library */
+static void Setup(void)
+{
+    uint32_t txEventOffset = CAN1_RX_FIFO0_SIZE + CAN1_RX_FIFO1_SIZE + CAN1_RX_BUFFER_SIZE + CAN1_TX_FIFO_BUFFER_SIZE;
+
+    memset(&hostCan1Regs, 0, sizeof(hostCan1Regs));
+    CAN1_Initialize();
+    CAN1_MessageRAMConfigSet((uint8_t *)messageRam);
+    CAN1_RxFifoCallbackRegister(CAN_RX_FIFO_0, RxFifoCallback, 0U);
+    CAN1_RxFifoCallbackRegister(CAN_RX_FIFO_1, RxFifoCallback, 1U);
+    CAN1_TxEventFifoCallbackRegister(TxEventCallback, 0U);
+
+    SimReset(&rxFifo[0], (volatile uint32_t *)&hostCan1Regs.CAN_RXF0S, &hostCan1Regs.CAN_RXF0A, 0U,
+             CAN1_RX_FIFO0_ELEMENT_SIZE, CAN1_RX_FIFO0_ELEMENTS, false, CAN_IR_RF0N_Msk, CAN_IR_RF0L_Msk);
+    SimReset(&rxFifo[1], (volatile uint32_t *)&hostCan1Regs.CAN_RXF1S, &hostCan1Regs.CAN_RXF1A, CAN1_RX_FIFO0_SIZE,
+             CAN1_RX_FIFO1_ELEMENT_SIZE, CAN1_RX_FIFO1_ELEMENTS, false, CAN_IR_RF1N_Msk, CAN_IR_RF1L_Msk);
+    SimReset(&txEventFifo, (volatile uint32_t *)&hostCan1Regs.CAN_TXEFS, &hostCan1Regs.CAN_TXEFA, txEventOffset,
+             CAN1_TX_EVENT_FIFO_ELEMENT_SIZE, CAN1_TX_EVENT_FIFO_ELEMENTS, true, CAN_IR_TEFN_Msk, CAN_IR_TEFL_Msk);
+    ringHead = 0U;
+    ringTail = 0U;
+    ringLost = 0U;
+    txEventsRead = 0U;
+}
+
+// *****************************************************************************
+// Section: Tests
+// *****************************************************************************
+
+/* The FIFO sizes configured are the ones the library was built with */
+static void TestConfiguration(void)
+{
+    Setup();
+    TEST_CHECK(((hostCan1Regs.CAN_RXF0C & CAN_RXF0C_F0S_Msk) >> CAN_RXF0C_F0S_Pos) == CAN1_RX_FIFO0_ELEMENTS);
+    TEST_CHECK(((hostCan1Regs.CAN_RXF1C & CAN_RXF1C_F1S_Msk) >> CAN_RXF1C_F1S_Pos) == CAN1_RX_FIFO1_ELEMENTS);
+    TEST_CHECK(((hostCan1Regs.CAN_TXEFC & CAN_TXEFC_EFS_Msk) >> CAN_TXEFC_EFS_Pos) == CAN1_TX_EVENT_FIFO_ELEMENTS);
+    TEST_CHECK(CAN1_RxFifoLostCountGet(CAN_RX_FIFO_0) == 0U);
+    TEST_CHECK(CAN1_RxFifoLostCountGet(CAN_RX_FIFO_1) == 0U);
+    TEST_CHECK(CAN1_TxEventLostCountGet() == 0U);
+}
+
+/* Bursts of up to one and a half FIFO depths between interrupts, on both Rx
+   FIFOs and the Tx Event FIFO, with the Tx event ring read slower than it
+   fills during stalls */
+static void TestInterrupt(void)
+{
+    SIM_FIFO *fifo = NULL;
+    uint32_t round = 0U;
+    uint32_t frames = 0U;
+    uint32_t index = 0U;
+    uint32_t fifoIndex = 0U;
+
+    Setup();
+    for (round = 0U; round < ROUNDS; round++)
+    {
+        for (fifoIndex = 0U; fifoIndex < 2U; fifoIndex++)
+        {
+            fifo = &rxFifo[fifoIndex];
+            frames = TEST_RandomBelow(fifo->depth + (fifo->depth / 2U) + 2U);
+            for (index = 0U; index < frames; index++)
+            {
+                SimStore(fifo);
+            }
+        }
+        frames = TEST_RandomBelow(txEventFifo.depth + 3U);
+        for (index = 0U; index < frames; index++)
+        {
+            SimStore(&txEventFifo);
+        }
+
+        SimInterrupt();
+        TEST_CHECK(rxFifo[0].fill == 0U);
+        TEST_CHECK(rxFifo[1].fill == 0U);
+        TEST_CHECK(txEventFifo.fill == 0U);
+        TEST_CHECK(CAN1_RxFifoLostCountGet(CAN_RX_FIFO_0) == rxFifo[0].lostEvents);
+        TEST_CHECK(CAN1_RxFifoLostCountGet(CAN_RX_FIFO_1) == rxFifo[1].lostEvents);
+        TEST_CHECK(CAN1_TxEventLostCountGet() == (txEventFifo.lostEvents + ringLost));
+
+        if ((round % STALL_PERIOD) >= STALL_ROUNDS)
+        {
+            TxEventRead(TEST_RandomBelow(2U * (txEventFifo.depth + 3U)));
+        }
+    }
+    TxEventRead(CAN1_TX_EVENT_RING_ELEMENTS + 1U);
+
+    for (fifoIndex = 0U; fifoIndex < 2U; fifoIndex++)
+    {
+        fifo = &rxFifo[fifoIndex];
+        TEST_CHECK((fifo->framesRead + fifo->framesLost) == fifo->nextSequence);
+        TEST_CHECK(fifo->framesLost != 0U);
+        TEST_CHECK(fifo->lostEvents != 0U);
+        TEST_CHECK((fifo->depth == 1U) || (fifo->wrapReads != 0U));
+    }
+    TEST_CHECK((txEventsRead + txEventFifo.framesLost + ringLost) == txEventFifo.nextSequence);
+    TEST_CHECK(txEventFifo.framesLost != 0U);
+    TEST_CHECK(ringLost != 0U);
+    TEST_CHECK((txEventFifo.depth == 1U) || (txEventFifo.wrapReads != 0U));
+}
+
+/* CAN1_TxEventFifoRead with the interrupt handler not involved, reading part
+   of the elements at a time */
+static void TestTxEventFifoRead(void)
+{
+    CAN_TX_EVENT_FIFO events[32];
+    uint32_t sequences[32];
+    uint32_t round = 0U;
+    uint32_t frames = 0U;
+    uint32_t count = 0U;
+    uint32_t index = 0U;
+
+    Setup();
+    TEST_CHECK(CAN1_TxEventFifoRead(0U, events) == false);
+    TEST_CHECK(CAN1_TxEventFifoRead(1U, NULL) == false);
+    for (round = 0U; round < ROUNDS; round++)
+    {
+        frames = TEST_RandomBelow(txEventFifo.depth + 2U);
+        for (index = 0U; index < frames; index++)
+        {
+            SimStore(&txEventFifo);
+        }
+        if (txEventFifo.fill == 0U)
+        {
+            continue;
+        }
+        count = 1U + TEST_RandomBelow(txEventFifo.fill);
+        TEST_CHECK(CAN1_TxEventFifoRead((uint8_t)count, events));
+        for (index = 0U; index < count; index++)
+        {
+            sequences[index] = events[index].id;
+            TEST_CHECK(events[index].mm == (uint8_t)txEventFifo.sequence[(txEventFifo.get + index) % txEventFifo.depth]);
+        }
+        ReadCheck(&txEventFifo, sequences, count);
+        TEST_CHECK(SimAck(&txEventFifo) == count);
+    }
+    TEST_CHECK((txEventFifo.depth == 1U) || (txEventFifo.wrapReads != 0U));
+    TEST_CHECK(txEventFifo.framesLost != 0U);
+}
+
+/* CAN1_TxFifoCancel against the message markers in the Message RAM: only
+   the buffers still pending with the marker are cancelled, also when the
+   put index wraps around in the middle of the batch */
+static void TestTxFifoCancel(void)
+{
+    static const uint8_t masks[2] = { 0x80U, 0xFFU };
+    CAN_TX_BUFFER *txBuffer = NULL;
+    uint32_t round = 0U;
+    uint32_t index = 0U;
+    uint32_t put = 0U;
+    uint32_t count = 0U;
+    uint32_t buffer = 0U;
+    uint32_t pending = 0U;
+    uint32_t expected = 0U;
+    uint32_t cancelled = 0U;
+    uint8_t marker = 0U;
+    uint8_t mask = 0U;
+
+    Setup();
+    for (round = 0U; round < ROUNDS; round++)
+    {
+        put = TEST_RandomBelow(CAN1_TX_FIFO_BUFFER_ELEMENTS);
+        count = 1U + TEST_RandomBelow(CAN1_TX_FIFO_BUFFER_ELEMENTS);
+        memset(txElements, 0, sizeof(txElements));
+        for (index = 0U; index < count; index++)
+        {
+            txBuffer = (CAN_TX_BUFFER *)((uint8_t *)txElements + (index * CAN1_TX_FIFO_BUFFER_ELEMENT_SIZE));
+            txBuffer->id = index;
+            txBuffer->dlc = 8U;
+            txBuffer->mm = (uint8_t)((TEST_Random() & 0x80U) | TEST_RandomBelow(4U));
+        }
+        *(volatile uint32_t *)&hostCan1Regs.CAN_TXFQS = CAN_TXFQS_TFFL(CAN1_TX_FIFO_BUFFER_ELEMENTS) |
+                                                      CAN_TXFQS_TFQPI(put);
+        hostCan1Regs.CAN_TXBAR = 0U;
+        TEST_CHECK(CAN1_MessageTransmitFifoBatch((uint8_t)count, (CAN_TX_BUFFER *)txElements) == count);
+
+        /* Some of the requests have been sent already */
+        pending = hostCan1Regs.CAN_TXBAR & TEST_Random();
+        *(volatile uint32_t *)&hostCan1Regs.CAN_TXBRP = pending;
+        hostCan1Regs.CAN_TXBCR = 0U;
+        marker = (uint8_t)((TEST_Random() & 0x80U) | TEST_RandomBelow(4U));
+        mask = masks[TEST_RandomBelow(2U)];
+        expected = 0U;
+        cancelled = 0U;
+        for (index = 0U; index < count; index++)
+        {
+            buffer = (put + index) % CAN1_TX_FIFO_BUFFER_ELEMENTS;
+            txBuffer = (CAN_TX_BUFFER *)((uint8_t *)txElements + (index * CAN1_TX_FIFO_BUFFER_ELEMENT_SIZE));
+            if (((pending & (1UL << buffer)) != 0U) && ((txBuffer->mm & mask) == (marker & mask)))
+            {
+                expected |= 1UL << buffer;
+                cancelled++;
+            }
+        }
+        TEST_CHECK(CAN1_TxFifoCancel(marker, mask) == cancelled);
+        TEST_CHECK(hostCan1Regs.CAN_TXBCR == expected);
+    }
+}
+
+int main(void)
+{
+    TEST_RandomSeed(1U);
+    TestConfiguration();
+    TestInterrupt();
+    TestTxEventFifoRead();
+    TestTxFifoCancel();
+
+    printf("test_can1_fifo (%u elements): %u failures\n", (unsigned int)CAN1_RX_FIFO0_ELEMENTS, testFailures);
+    return TEST_RESULT();
+}
@@ -0,0 +1,53 @@
+/*******************************************************************************
+  Host Test Helpers
+
+  File Name:
+    test_common.h
+
+  Summary:
+    Checks and a repeatable random number source shared by the host tests.
+*******************************************************************************/
+
+#ifndef TEST_COMMON_H
+#define TEST_COMMON_H
+
+#include <stdint.h>
+#include <stdio.h>
+
+static unsigned int testFailures = 0U;
+static uint32_t testRandomState = 0x2545F491UL;
+
+/* Reports a failed condition and carries on, main returns TEST_RESULT() */
+#define TEST_CHECK(condition)                                                       \
+    do                                                                              \
+    {                                                                               \
+        if (!(condition))                                                           \
+        {                                                                           \
+            testFailures++;                                                         \
+            printf("%s:%d: check failed: %s\n", __FILE__, __LINE__, #condition);    \
+        }                                                                           \
+    } while (0)
+
+#define TEST_RESULT()   ((testFailures == 0U) ? 0 : 1)
+
+static inline void TEST_RandomSeed(uint32_t seed)
+{
+    testRandomState = (seed != 0U) ? seed : 0x2545F491UL;
+}
+
+/* xorshift32, the same sequence on every host */
+static inline uint32_t TEST_Random(void)
+{
+    testRandomState ^= testRandomState << 13;
+    testRandomState ^= testRandomState >> 17;
+    testRandomState ^= testRandomState << 5;
+    return testRandomState;
+}
+
+/* Uniform enough for test data, 0 to range - 1 */
+static inline uint32_t TEST_RandomBelow(uint32_t range)
+{
+    return (range != 0U) ? (TEST_Random() % range) : 0U;
+}
+
+#endif /* TEST_COMMON_H */
@@ -0,0 +1,1091 @@
+/*******************************************************************************
+  Cyclic Transmit Host Test
+
+  File Name:
+    test_cyclic.c
+
+  Summary:
+    Runs the cyclic scheduler against a simulated Tx FIFO, TC1 tick and
+    500 kbit/s bus and checks when and what it sends.
+
+  Description:
+    The TC1 interrupt comes every millisecond with up to 10 us of latency. The
+    Tx FIFO sends its frames back to back and loses arbitration to foreign
+    traffic now and then; every frame on the bus gives a Tx event. Covers the
+    request jitter against the ideal schedule, the counter and checksum bytes,
+    more messages due in one tick than the Tx FIFO holds, a stalled bus, long
+    and 1 ms periods, messages set and removed while running, lost Tx events
+    and a trace replay stopped while cyclic frames share the Tx FIFO with it.
+*******************************************************************************/
+
+#include <string.h>
+#include "test_common.h"
+#include "app_can_cyclic.h"
+#include "app_can_replay.h"
+#include "test_frame.h"
+#include "app_can_txevent.h"
+
+/* Extended timestamp ticks of 2 us, one bit time at 500 kbit/s */
+#define TICKS_PER_MS        500U
+#define LATENCY_MAX         5U
+#define FIFO_SIZE           CAN1_TX_FIFO_BUFFER_ELEMENTS
+#define EVENTS_MAX          64U
+#define LOG_MAX             4000U
+
+typedef struct
+{
+    CAN_TX_BUFFER frame;
+    uint32_t queued;
+    /* Cancelled, left out when the get index reaches it */
+    bool cancelled;
+} PENDING;
+
+/* What the test saw of one message */
+typedef struct
+{
+    APP_CAN_CYCLIC_MESSAGE message;
+    /* Transmission requests: TC1 tick and time */
+    uint32_t requests;
+    uint32_t tick[LOG_MAX];
+    uint32_t queued[LOG_MAX];
+    /* Frames on the bus and their Tx events which were not lost */
+    uint32_t frames;
+    uint32_t events;
+    /* Periods between Tx events which were both delivered, no event lost
+       in between */
+    uint32_t periods;
+    uint32_t requestPeriodMin;
+    uint32_t requestPeriodMax;
+    uint32_t busPeriodMin;
+    uint32_t busPeriodMax;
+    bool measured;
+    uint32_t lastQueued;
+    uint32_t lastStart;
+    uint8_t counter;
+} MESSAGE_LOG;
+
+static MESSAGE_LOG messageLog[APP_CAN_CYCLIC_MESSAGES];
+
+static uint32_t simMs = 0U;
+static uint32_t simTime = 0U;
+
+static TC_TIMER_CALLBACK timerCallback = NULL;
+static uintptr_t timerContext = 0U;
+static bool timerRunning = false;
+static uint32_t timerTick = 0U;
+static uint32_t timerStartMs = 0U;
+
+static PENDING fifo[FIFO_SIZE];
+static uint32_t fifoHead = 0U;
+static uint32_t fifoCount = 0U;
+
+/* The bus is idle from busIdle on. Nothing is sent before busStallEnd, as
+   with a bus-off or a missing acknowledge. */
+static uint32_t busIdle = 0U;
+static uint32_t busStallEnd = 0U;
+/* Foreign frames arrive with a random gap of up to foreignGap bit times,
+   0 for none */
+static uint32_t foreignGap = 0U;
+static uint32_t foreignNext = 0U;
+
+static CAN_TX_EVENT events[EVENTS_MAX];
+static uint32_t eventCount = 0U;
+static uint32_t eventsLost = 0U;
+static uint32_t eventsLostSeen = 0U;
+/* The next events to lose */
+static uint32_t eventsToLose = 0U;
+/* Index of the last frame of the scheduler on the bus, to check the order */
+static uint32_t lastSentIndex = 0U;
+static uint32_t lastSentQueued = 0U;
+static uint32_t lastSentRequests = 0U;
+static uint32_t orderErrors = 0U;
+
+/* TC0 of the trace replay counts extended timestamp ticks */
+static TC_TIMER_CALLBACK replayTimerCallback = NULL;
+static uintptr_t replayTimerContext = 0U;
+static uint32_t replayTimerPeriod = 0U;
+static uint32_t replayTimerDue = 0U;
+static bool replayTimerArmed = false;
+static CAN_TX_EVENT_FIFO_CALLBACK txEventCallback = NULL;
+static uintptr_t txEventContext = 0U;
+/* Replay frames queued and sent on the bus */
+static uint32_t replayRequests = 0U;
+static uint32_t replayFrames = 0U;
+
+can_registers_t hostCan1Regs;
+
+// *****************************************************************************
+// Section: TC1 and CAN1 Peripheral Library Stubs
+// *****************************************************************************
+
+void TC1_TimerCallbackRegister(TC_TIMER_CALLBACK callback, uintptr_t context)
+{
+    timerCallback = callback;
+    timerContext = context;
+}
+
+void TC1_TimerStart(void)
+{
+    timerRunning = true;
+    timerTick = 0U;
+    timerStartMs = simMs;
+}
+
+void TC1_TimerStop(void)
+{
+    timerRunning = false;
+}
+
+void TC1_TimerCommandSet(TC_COMMAND command)
+{
+    (void)command;
+}
+
+void TC0_TimerCallbackRegister(TC_TIMER_CALLBACK callback, uintptr_t context)
+{
+    replayTimerCallback = callback;
+    replayTimerContext = context;
+}
+
+void TC0_TimerStart(void)
+{
+}
+
+uint32_t TC0_TimerFrequencyGet(void)
+{
+    return TICKS_PER_MS * 1000U;
+}
+
+void TC0_Timer16bitPeriodSet(uint16_t period)
+{
+    replayTimerPeriod = period;
+}
+
+void TC0_TimerCommandSet(TC_COMMAND command)
+{
+    (void)command;
+    replayTimerDue = simTime + replayTimerPeriod;
+    replayTimerArmed = true;
+}
+
+void CAN1_TxEventFifoCallbackRegister(CAN_TX_EVENT_FIFO_CALLBACK callback, uintptr_t contextHandle)
+{
+    txEventCallback = callback;
+    txEventContext = contextHandle;
+}
+
+uint32_t CAN1_RxTimestampExtend(uint16_t rxts)
+{
+    (void)rxts;
+    return simTime;
+}
+
+uint8_t CAN1_TxFifoFreeLevelGet(void)
+{
+    return (uint8_t)(FIFO_SIZE - fifoCount);
+}
+
+uint32_t CAN1_TxEventLostCountGet(void)
+{
+    return eventsLost;
+}
+
+/* Bits of the counter below the mask */
+static uint32_t CounterShift(uint8_t mask)
+{
+    uint32_t shift = 0U;
+
+    while ((mask & (1U << shift)) == 0U)
+    {
+        shift++;
+    }
+    return shift;
+}
+
+static uint8_t CounterGet(const APP_CAN_CYCLIC_MESSAGE *message, const uint8_t *data)
+{
+    return (uint8_t)((data[message->counterByte] & message->counterMask) >> CounterShift(message->counterMask));
+}
+
+/* Written from the definitions: SAE J1850 is CRC-8 with polynomial 0x1D,
+   initial value and final XOR 0xFF, not reflected */
+static uint8_t ChecksumGet(APP_CAN_CYCLIC_CHECKSUM checksum, const uint8_t *data, uint32_t length, uint32_t skip)
+{
+    uint32_t value = (checksum == APP_CAN_CYCLIC_CHECKSUM_CRC8) ? 0xFFU : 0U;
+    uint32_t byte = 0U;
+    uint32_t bit = 0U;
+
+    for (byte = 0U; byte < length; byte++)
+    {
+        if (byte == skip)
+        {
+            continue;
+        }
+        if (checksum == APP_CAN_CYCLIC_CHECKSUM_SUM)
+        {
+            value = (value + data[byte]) & 0xFFU;
+        }
+        else if (checksum == APP_CAN_CYCLIC_CHECKSUM_XOR)
+        {
+            value ^= data[byte];
+        }
+        else
+        {
+            for (bit = 0U; bit < 8U; bit++)
+            {
+                value = ((((value >> 7) ^ (data[byte] >> (7U - bit))) & 1U) != 0U) ? (((value << 1) ^ 0x1DU) & 0xFFU)
+                                                                                   : ((value << 1) & 0xFFU);
+            }
+        }
+    }
+    return (uint8_t)((checksum == APP_CAN_CYCLIC_CHECKSUM_CRC8) ? (value ^ 0xFFU) : value);
+}
+
+/* Checks the frame of a request against the message: marker, identifier,
+   payload, counter and checksum */
+static void RequestCheck(MESSAGE_LOG *log, uint32_t index, const CAN_TX_BUFFER *frame)
+{
+    const APP_CAN_CYCLIC_MESSAGE *message = &log->message;
+    uint32_t byte = 0U;
+    bool payload = true;
+
+    TEST_CHECK(frame->mm == (APP_CAN_TXEVENT_MARKER_CYCLIC | index));
+    TEST_CHECK(frame->efc == 1U);
+    TEST_CHECK((frame->id == message->frame.id) && (frame->xtd == message->frame.xtd) &&
+               (frame->rtr == message->frame.rtr) && (frame->dlc == message->frame.dlc));
+    for (byte = 0U; byte < frame->dlc; byte++)
+    {
+        if ((message->checksum != APP_CAN_CYCLIC_CHECKSUM_NONE) && (byte == message->checksumByte))
+        {
+            continue;
+        }
+        if ((message->counterMask != 0U) && (byte == message->counterByte))
+        {
+            payload = payload && ((frame->data[byte] & (uint8_t)~message->counterMask) ==
+                                  (message->frame.data[byte] & (uint8_t)~message->counterMask));
+            continue;
+        }
+        payload = payload && (frame->data[byte] == message->frame.data[byte]);
+    }
+    TEST_CHECK(payload);
+    if (message->counterMask != 0U)
+    {
+        TEST_CHECK(CounterGet(message, frame->data) == log->counter);
+        log->counter = (uint8_t)((log->counter + 1U) & (message->counterMask >> CounterShift(message->counterMask)));
+    }
+    if (message->checksum != APP_CAN_CYCLIC_CHECKSUM_NONE)
+    {
+        TEST_CHECK(frame->data[message->checksumByte] ==
+                   ChecksumGet(message->checksum, frame->data, frame->dlc, message->checksumByte));
+    }
+}
+
+/* TXBRP: the Tx FIFO buffers between the get and the put index which are
+   not cancelled */
+static void TxbrpUpdate(void)
+{
+    uint32_t pending = 0U;
+    uint32_t index = 0U;
+
+    for (index = 0U; index < fifoCount; index++)
+    {
+        if (!fifo[(fifoHead + index) % FIFO_SIZE].cancelled)
+        {
+            pending |= 1UL << ((fifoHead + index) % FIFO_SIZE);
+        }
+    }
+    *(volatile uint32_t *)&hostCan1Regs.CAN_TXBRP = pending;
+}
+
+/* TXBCR: a cancelled buffer at the get index frees it at once, others stay
+   in the Tx FIFO until the get index passes them */
+static void FifoCancel(uint32_t buffers)
+{
+    uint32_t index = 0U;
+
+    for (index = 0U; index < fifoCount; index++)
+    {
+        if ((buffers & (1UL << ((fifoHead + index) % FIFO_SIZE))) != 0U)
+        {
+            fifo[(fifoHead + index) % FIFO_SIZE].cancelled = true;
+        }
+    }
+    while ((fifoCount != 0U) && fifo[fifoHead].cancelled)
+    {
+        fifoHead = (fifoHead + 1U) % FIFO_SIZE;
+        fifoCount--;
+    }
+    TxbrpUpdate();
+}
+
+/* Takes as many messages as there is room for, like the peripheral library */
+uint8_t CAN1_MessageTransmitFifoBatch(uint8_t numberOfMessage, CAN_TX_BUFFER *txBuffer)
+{
+    uint32_t count = 0U;
+    uint32_t index = 0U;
+    MESSAGE_LOG *log = NULL;
+
+    for (count = 0U; (count < numberOfMessage) && (fifoCount < FIFO_SIZE); count++)
+    {
+        fifo[(fifoHead + fifoCount) % FIFO_SIZE].frame = txBuffer[count];
+        fifo[(fifoHead + fifoCount) % FIFO_SIZE].queued = simTime;
+        fifo[(fifoHead + fifoCount) % FIFO_SIZE].cancelled = false;
+        fifoCount++;
+        if ((txBuffer[count].mm & APP_CAN_TXEVENT_MARKER_SOURCE_Msk) == APP_CAN_TXEVENT_MARKER_REPLAY)
+        {
+            replayRequests++;
+            continue;
+        }
+
+        index = txBuffer[count].mm & APP_CAN_TXEVENT_MARKER_INDEX_Msk;
+        TEST_CHECK(index < APP_CAN_CYCLIC_MESSAGES);
+        log = &messageLog[index % APP_CAN_CYCLIC_MESSAGES];
+        RequestCheck(log, index, &txBuffer[count]);
+        if (log->requests < LOG_MAX)
+        {
+            log->tick[log->requests] = timerTick;
+            log->queued[log->requests] = simTime;
+        }
+        log->requests++;
+    }
+    /* The scheduler never gives more than there is room for, the replay
+       leaves the rest to the next Tx event */
+    TEST_CHECK((count == numberOfMessage) ||
+               ((txBuffer[0].mm & APP_CAN_TXEVENT_MARKER_SOURCE_Msk) == APP_CAN_TXEVENT_MARKER_REPLAY));
+    TxbrpUpdate();
+    return (uint8_t)count;
+}
+
+/* Cancels the buffers of the pending messages with the marker */
+uint8_t CAN1_TxFifoCancel(uint8_t messageMarker, uint8_t messageMarkerMask)
+{
+    uint32_t buffers = 0U;
+    uint32_t index = 0U;
+    uint8_t count = 0U;
+
+    for (index = 0U; index < fifoCount; index++)
+    {
+        if (((fifo[(fifoHead + index) % FIFO_SIZE].frame.mm & messageMarkerMask) == messageMarker) &&
+            !fifo[(fifoHead + index) % FIFO_SIZE].cancelled)
+        {
+            buffers |= 1UL << ((fifoHead + index) % FIFO_SIZE);
+            count++;
+        }
+    }
+    FifoCancel(buffers);
+    return count;
+}
+
+// *****************************************************************************
+// Section: Simulation
+// *****************************************************************************
+
+/* Bit times of a classic frame with interframe space and random stuffing */
+static uint32_t FrameBits(bool xtd, uint32_t dlc)
+{
+    uint32_t bits = (xtd ? 67U : 47U) + (8U * dlc);
+
+    return bits + TEST_RandomBelow(((bits - 13U) / 4U) + 1U);
+}
+
+/* Accounts a Tx event as the module should. Events are read after the lost
+   count, which may already include a later event, so any change of the count
+   ends all measurements. */
+static void EventAccount(const CAN_TX_EVENT *event)
+{
+    MESSAGE_LOG *log = &messageLog[event->element.mm & APP_CAN_TXEVENT_MARKER_INDEX_Msk];
+    uint32_t requestPeriod = event->queued - log->lastQueued;
+    uint32_t busPeriod = event->timestamp - log->lastStart;
+    uint32_t index = 0U;
+
+    if (eventsLost != eventsLostSeen)
+    {
+        eventsLostSeen = eventsLost;
+        for (index = 0U; index < APP_CAN_CYCLIC_MESSAGES; index++)
+        {
+            messageLog[index].measured = false;
+        }
+    }
+
+    if (log->measured)
+    {
+        log->requestPeriodMin = ((log->periods == 0U) || (requestPeriod < log->requestPeriodMin)) ? requestPeriod
+                                                                                                   : log->requestPeriodMin;
+        log->requestPeriodMax = ((log->periods == 0U) || (requestPeriod > log->requestPeriodMax)) ? requestPeriod
+                                                                                                   : log->requestPeriodMax;
+        log->busPeriodMin = ((log->periods == 0U) || (busPeriod < log->busPeriodMin)) ? busPeriod : log->busPeriodMin;
+        log->busPeriodMax = ((log->periods == 0U) || (busPeriod > log->busPeriodMax)) ? busPeriod : log->busPeriodMax;
+        log->periods++;
+    }
+    log->measured = true;
+    log->events++;
+    log->lastQueued = event->queued;
+    log->lastStart = event->timestamp;
+}
+
+/* Sends frames until the given time. The Tx FIFO and the foreign node start
+   as soon as the bus is idle; when both are ready the winner is random. */
+static void BusRun(uint32_t until)
+{
+    uint32_t start = 0U;
+    uint32_t index = 0U;
+    bool ours = false;
+    bool foreign = false;
+    PENDING *pending = NULL;
+    CAN_TX_EVENT *event = NULL;
+
+    for (;;)
+    {
+        start = (busIdle > busStallEnd) ? busIdle : busStallEnd;
+        ours = (fifoCount != 0U) && (fifo[fifoHead].queued <= start);
+        foreign = (foreignGap != 0U) && (foreignNext <= start);
+        if (!ours && !foreign)
+        {
+            /* Idle until the first frame becomes ready */
+            if ((fifoCount != 0U) && ((foreignGap == 0U) || (fifo[fifoHead].queued <= foreignNext)))
+            {
+                start = fifo[fifoHead].queued;
+                ours = true;
+            }
+            else if (foreignGap != 0U)
+            {
+                start = foreignNext;
+                foreign = true;
+            }
+        }
+        if ((!ours && !foreign) || (start >= until))
+        {
+            busIdle = (busIdle > until) ? busIdle : until;
+            return;
+        }
+        if (ours && foreign)
+        {
+            ours = (TEST_Random() & 1U) != 0U;
+        }
+        if (!ours)
+        {
+            busIdle = start + FrameBits(false, 8U);
+            foreignNext = busIdle + TEST_RandomBelow(foreignGap);
+            continue;
+        }
+
+        pending = &fifo[fifoHead];
+        fifoHead = (fifoHead + 1U) % FIFO_SIZE;
+        fifoCount--;
+        /* Cancelled buffers behind it are passed over */
+        FifoCancel(0U);
+        busIdle = start + FrameBits(pending->frame.xtd != 0U, pending->frame.dlc);
+
+        index = pending->frame.mm & APP_CAN_TXEVENT_MARKER_INDEX_Msk;
+        if ((pending->frame.mm & APP_CAN_TXEVENT_MARKER_SOURCE_Msk) == APP_CAN_TXEVENT_MARKER_REPLAY)
+        {
+            replayFrames++;
+        }
+        else
+        {
+            /* Frames requested in the same tick leave in index order */
+            if ((pending->queued == lastSentQueued) && (index <= lastSentIndex) && (lastSentRequests != 0U))
+            {
+                orderErrors++;
+            }
+            lastSentQueued = pending->queued;
+            lastSentIndex = index;
+            lastSentRequests++;
+            messageLog[index].frames++;
+        }
+
+        if (eventsToLose != 0U)
+        {
+            eventsToLose--;
+            eventsLost++;
+            continue;
+        }
+        TEST_CHECK(eventCount < EVENTS_MAX);
+        event = &events[eventCount % EVENTS_MAX];
+        memset(event, 0, sizeof(*event));
+        event->element.id = pending->frame.id;
+        event->element.xtd = pending->frame.xtd;
+        event->element.rtr = pending->frame.rtr;
+        event->element.dlc = pending->frame.dlc;
+        event->element.et = 1U;
+        event->element.mm = pending->frame.mm;
+        event->element.txts = (uint16_t)start;
+        event->timestamp = start;
+        event->queued = pending->queued;
+        eventCount++;
+    }
+}
+
+/* Runs the given milliseconds: the bus up to the TC1 interrupt, the
+   interrupt, then the main loop with the Tx events */
+static void Run(uint32_t ms)
+{
+    uint32_t index = 0U;
+
+    for (; ms > 0U; ms--)
+    {
+        simMs++;
+        simTime = (simMs * TICKS_PER_MS) + TEST_RandomBelow(LATENCY_MAX + 1U);
+        BusRun(simTime);
+        if ((eventCount != 0U) && (txEventCallback != NULL))
+        {
+            txEventCallback((uint8_t)eventCount, txEventContext);
+        }
+        if (replayTimerArmed && ((int32_t)(simTime - replayTimerDue) >= 0) && (replayTimerCallback != NULL))
+        {
+            replayTimerArmed = false;
+            replayTimerCallback(TC_TIMER_STATUS_OVERFLOW, replayTimerContext);
+        }
+        if (timerRunning && (timerCallback != NULL))
+        {
+            timerCallback(TC_TIMER_STATUS_OVERFLOW, timerContext);
+            timerTick++;
+        }
+        for (index = 0U; index < eventCount; index++)
+        {
+            APP_CAN_CyclicTxEvent(&events[index]);
+            APP_CAN_ReplayTxEvent(&events[index]);
+            if ((events[index].element.mm & APP_CAN_TXEVENT_MARKER_SOURCE_Msk) == APP_CAN_TXEVENT_MARKER_CYCLIC)
+            {
+                EventAccount(&events[index]);
+            }
+        }
+        eventCount = 0U;
+    }
+}
+
+/* Sends everything still in the Tx FIFO */
+static void Drain(void)
+{
+    while (fifoCount != 0U)
+    {
+        Run(1U);
+    }
+}
+
+/* APP_CAN_ReplayStop, and the cancellations it may have written to TXBCR */
+static void ReplayStop(void)
+{
+    hostCan1Regs.CAN_TXBCR = 0U;
+    APP_CAN_ReplayStop();
+    FifoCancel(hostCan1Regs.CAN_TXBCR);
+}
+
+static void Reset(uint32_t gap)
+{
+    uint32_t index = 0U;
+
+    APP_CAN_CyclicStop();
+    Drain();
+    for (index = 0U; index < APP_CAN_CYCLIC_MESSAGES; index++)
+    {
+        APP_CAN_CyclicRemove(index);
+    }
+    memset(messageLog, 0, sizeof(messageLog));
+    foreignGap = gap;
+    foreignNext = busIdle;
+    busStallEnd = 0U;
+    eventsToLose = 0U;
+    lastSentRequests = 0U;
+    orderErrors = 0U;
+}
+
+static void Start(void)
+{
+    uint32_t index = 0U;
+
+    for (index = 0U; index < APP_CAN_CYCLIC_MESSAGES; index++)
+    {
+        messageLog[index].requests = 0U;
+        messageLog[index].frames = 0U;
+        messageLog[index].events = 0U;
+        messageLog[index].periods = 0U;
+        messageLog[index].measured = false;
+    }
+    APP_CAN_CyclicStart();
+}
+
+static APP_CAN_CYCLIC_MESSAGE Message(uint32_t id, bool xtd, uint32_t dlc, uint32_t period, uint32_t offset)
+{
+    APP_CAN_CYCLIC_MESSAGE message;
+    uint32_t byte = 0U;
+
+    memset(&message, 0, sizeof(message));
+    message.frame.id = id;
+    message.frame.xtd = xtd ? 1U : 0U;
+    message.frame.dlc = dlc;
+    for (byte = 0U; byte < 8U; byte++)
+    {
+        message.frame.data[byte] = (uint8_t)TEST_Random();
+    }
+    message.period = (uint16_t)period;
+    message.offset = (uint16_t)offset;
+    return message;
+}
+
+/* Sets a message, which also clears its statistics */
+static void Set(uint32_t index, const APP_CAN_CYCLIC_MESSAGE *message)
+{
+    TEST_CHECK(APP_CAN_CyclicSet(index, message));
+    memset(&messageLog[index], 0, sizeof(messageLog[index]));
+    messageLog[index].message = *message;
+    messageLog[index].counter = (message->counterMask != 0U) ? CounterGet(message, message->frame.data) : 0U;
+}
+
+/* The requests from the given one on fall on the ticks offset + n * period,
+   n counting up without gaps, each within the interrupt latency of its tick */
+static bool OnGrid(uint32_t index, uint32_t first)
+{
+    const MESSAGE_LOG *log = &messageLog[index];
+    uint32_t period = log->message.period;
+    uint32_t request = 0U;
+    uint32_t ideal = 0U;
+
+    for (request = first; (request < log->requests) && (request < LOG_MAX); request++)
+    {
+        ideal = log->message.offset + ((((log->tick[first] - log->message.offset) / period) + (request - first)) * period);
+        if ((log->tick[request] != ideal) ||
+            ((log->queued[request] - ((timerStartMs + ideal + 1U) * TICKS_PER_MS)) > LATENCY_MAX))
+        {
+            printf("  message %lu request %lu at tick %lu, expected %lu\n", (unsigned long)index,
+                   (unsigned long)request, (unsigned long)log->tick[request], (unsigned long)ideal);
+            return false;
+        }
+    }
+    return true;
+}
+
+/* The statistics of the module agree with what the test measured */
+static void StatsCheck(uint32_t index)
+{
+    APP_CAN_CYCLIC_STATS stats;
+    const MESSAGE_LOG *log = &messageLog[index];
+
+    APP_CAN_CyclicStatsGet(index, &stats);
+    TEST_CHECK(stats.sent == log->events);
+    TEST_CHECK(stats.periods == log->periods);
+    if (log->periods != 0U)
+    {
+        TEST_CHECK((stats.requestPeriodMin == log->requestPeriodMin) && (stats.requestPeriodMax == log->requestPeriodMax));
+        TEST_CHECK((stats.busPeriodMin == log->busPeriodMin) && (stats.busPeriodMax == log->busPeriodMax));
+    }
+}
+
+// *****************************************************************************
+// Section: Tests
+// *****************************************************************************
+
+/* Rest-bus simulation of 64 messages with counters and checksums and about
+   25 % foreign traffic: every request comes in its tick */
+static void TestRestBus(void)
+{
+    static const uint32_t periods[4] = { 10U, 20U, 50U, 100U };
+    APP_CAN_CYCLIC_MESSAGE message;
+    APP_CAN_CYCLIC_STATS stats;
+    uint32_t index = 0U;
+    uint32_t period = 0U;
+    uint32_t expected = 0U;
+
+    Reset(780U);
+    for (index = 0U; index < APP_CAN_CYCLIC_MESSAGES; index++)
+    {
+        period = periods[(index < 4U) ? 0U : ((index < 16U) ? 1U : ((index < 40U) ? 2U : 3U))];
+        message = Message(0x100U + index, (index % 3U) == 0U, 1U + (index % 8U), period, (index * 7U) % period);
+        if (message.frame.dlc >= 2U)
+        {
+            message.checksum = (APP_CAN_CYCLIC_CHECKSUM)(index % 4U);
+            message.checksumByte = (uint8_t)(message.frame.dlc - 1U);
+            message.counterByte = (uint8_t)(index % (message.frame.dlc - 1U));
+            message.counterMask = (uint8_t)((index & 1U) ? 0x0FU : 0xF0U);
+        }
+        else
+        {
+            message.counterMask = 0xFFU;
+        }
+        Set(index, &message);
+    }
+    Start();
+    Run(10000U);
+
+    for (index = 0U; index < APP_CAN_CYCLIC_MESSAGES; index++)
+    {
+        period = messageLog[index].message.period;
+        expected = ((10000U - messageLog[index].message.offset - 1U) / period) + 1U;
+        APP_CAN_CyclicStatsGet(index, &stats);
+        TEST_CHECK(messageLog[index].requests == expected);
+        TEST_CHECK(messageLog[index].tick[0] == messageLog[index].message.offset);
+        TEST_CHECK(OnGrid(index, 0U));
+        TEST_CHECK((stats.late == 0U) && (stats.skipped == 0U));
+        TEST_CHECK(stats.sent == messageLog[index].frames);
+        StatsCheck(index);
+        /* Requests within 100 us of the ideal period */
+        TEST_CHECK((stats.requestPeriodMin >= ((period * TICKS_PER_MS) - LATENCY_MAX)) &&
+                   (stats.requestPeriodMax <= ((period * TICKS_PER_MS) + LATENCY_MAX)));
+        /* The bus adds a few frames of delay at most */
+        TEST_CHECK((stats.busPeriodMin > ((period - 1U) * TICKS_PER_MS)) &&
+                   (stats.busPeriodMax < ((period + 1U) * TICKS_PER_MS)));
+    }
+    TEST_CHECK(orderErrors == 0U);
+}
+
+/* 32 messages due in the same tick, twice the Tx FIFO: the ones which do not
+   fit follow in the next ticks in index order and the period is kept */
+static void TestSlotOverflow(void)
+{
+    APP_CAN_CYCLIC_MESSAGE message;
+    APP_CAN_CYCLIC_STATS stats;
+    uint32_t index = 0U;
+    uint32_t request = 0U;
+    uint32_t late = 0U;
+
+    Reset(0U);
+    for (index = 0U; index < 32U; index++)
+    {
+        message = Message(0x200U + index, false, 8U, 10U, 0U);
+        message.counterMask = 0xFFU;
+        message.checksum = APP_CAN_CYCLIC_CHECKSUM_CRC8;
+        message.checksumByte = 7U;
+        Set(index, &message);
+    }
+    Start();
+    Run(1000U);
+    APP_CAN_CyclicStop();
+    Drain();
+
+    for (index = 0U; index < 32U; index++)
+    {
+        APP_CAN_CyclicStatsGet(index, &stats);
+        TEST_CHECK(messageLog[index].requests == 100U);
+        TEST_CHECK(messageLog[index].frames == 100U);
+        TEST_CHECK(stats.sent == 100U);
+        TEST_CHECK(stats.skipped == 0U);
+        for (request = 0U; request < messageLog[index].requests; request++)
+        {
+            /* Within the period it is due in */
+            TEST_CHECK((messageLog[index].tick[request] / 10U) == request);
+        }
+        if (index < FIFO_SIZE)
+        {
+            TEST_CHECK(stats.late == 0U);
+            TEST_CHECK(OnGrid(index, 0U));
+        }
+        else
+        {
+            TEST_CHECK(stats.late >= 100U);
+        }
+        late += stats.late;
+        StatsCheck(index);
+    }
+    TEST_CHECK(late != 0U);
+    TEST_CHECK(orderErrors == 0U);
+    /* The requests of each period in index order */
+    for (request = 0U; request < 100U; request++)
+    {
+        for (index = 1U; index < 32U; index++)
+        {
+            TEST_CHECK(messageLog[index].queued[request] >= messageLog[index - 1U].queued[request]);
+        }
+    }
+}
+
+/* The bus stalls for 200 ms: the Tx FIFO fills, the messages are held back,
+   whole periods are left out and afterwards the old phase holds */
+static void TestStall(void)
+{
+    APP_CAN_CYCLIC_MESSAGE message;
+    APP_CAN_CYCLIC_STATS stats;
+    uint32_t index = 0U;
+    uint32_t request = 0U;
+    uint32_t late = 0U;
+
+    Reset(1000U);
+    for (index = 0U; index < 6U; index++)
+    {
+        message = Message(0x300U + index, true, 4U, 10U + (index * 5U), index);
+        message.counterMask = 0x3CU;
+        message.counterByte = 1U;
+        Set(index, &message);
+    }
+    Start();
+    Run(100U);
+    busStallEnd = simTime + (200U * TICKS_PER_MS);
+    Run(400U);
+    APP_CAN_CyclicStop();
+    Drain();
+
+    for (index = 0U; index < 6U; index++)
+    {
+        APP_CAN_CyclicStatsGet(index, &stats);
+        late += stats.late;
+        TEST_CHECK(stats.skipped != 0U);
+        /* Each period is either requested or left out */
+        TEST_CHECK((messageLog[index].requests + stats.skipped) ==
+                   (((timerTick - 1U - index) / messageLog[index].message.period) + 1U));
+        TEST_CHECK(messageLog[index].frames == messageLog[index].requests);
+        TEST_CHECK(stats.sent == messageLog[index].frames);
+        /* Back on the old phase once the bus runs again */
+        for (request = 0U; (request < messageLog[index].requests) && (messageLog[index].tick[request] < 350U); request++)
+        {
+        }
+        TEST_CHECK(request < messageLog[index].requests);
+        TEST_CHECK(OnGrid(index, request));
+        TEST_CHECK(((messageLog[index].tick[request] - index) % messageLog[index].message.period) == 0U);
+        StatsCheck(index);
+    }
+    TEST_CHECK(late != 0U);
+}
+
+/* Periods of 1 ms, of the wheel size, one more and longer than the wheel,
+   messages set and removed while running and a stop and restart */
+static void TestPeriods(void)
+{
+    static const uint32_t periods[5] = { 1U, 64U, 65U, 1000U, 3U };
+    static const uint32_t offsets[5] = { 0U, 63U, 64U, 999U, 2U };
+    APP_CAN_CYCLIC_MESSAGE message;
+    APP_CAN_CYCLIC_STATS stats;
+    uint32_t index = 0U;
+    uint32_t removed = 0U;
+
+    Reset(2000U);
+    for (index = 0U; index < 5U; index++)
+    {
+        message = Message(0x400U + index, false, 8U, periods[index], offsets[index]);
+        Set(index * 9U, &message);
+    }
+    Start();
+    Run(1500U);
+
+    /* Set at tick 1500 with offset 5 and period 10: first due at 1505 */
+    message = Message(0x410U, false, 2U, 10U, 5U);
+    message.checksum = APP_CAN_CYCLIC_CHECKSUM_XOR;
+    message.checksumByte = 0U;
+    Set(60U, &message);
+    /* Replaced while running: the new period from the next tick on grid */
+    message = Message(0x412U, true, 8U, 7U, 3U);
+    Set(36U, &message);
+    Run(500U);
+    APP_CAN_CyclicRemove(0U);
+    removed = messageLog[0].requests;
+    Run(1000U);
+
+    TEST_CHECK(messageLog[60].tick[0] == 1505U);
+    TEST_CHECK(OnGrid(60U, 0U));
+    TEST_CHECK(messageLog[60].requests == 150U);
+    TEST_CHECK(messageLog[36].tick[0] == 1501U);
+    TEST_CHECK(OnGrid(36U, 0U));
+    TEST_CHECK(messageLog[0].requests == removed);
+    TEST_CHECK(removed == 2000U);
+    TEST_CHECK(messageLog[9].requests == ((3000U - 63U - 1U) / 64U) + 1U);
+    TEST_CHECK(messageLog[18].requests == ((3000U - 64U - 1U) / 65U) + 1U);
+    TEST_CHECK(messageLog[27].requests == 3U);
+    for (index = 0U; index < 4U; index++)
+    {
+        TEST_CHECK(messageLog[index * 9U].tick[0] == offsets[index]);
+        TEST_CHECK(OnGrid(index * 9U, 0U));
+        APP_CAN_CyclicStatsGet(index * 9U, &stats);
+        TEST_CHECK((stats.late == 0U) && (stats.skipped == 0U));
+    }
+
+    /* Stopped nothing is requested, a restart begins at the offsets again */
+    APP_CAN_CyclicStop();
+    TEST_CHECK(APP_CAN_CyclicIsRunning() == false);
+    removed = messageLog[27].requests;
+    Run(100U);
+    TEST_CHECK(messageLog[27].requests == removed);
+    Drain();
+    Start();
+    TEST_CHECK(APP_CAN_CyclicIsRunning());
+    Run(1000U);
+    TEST_CHECK(messageLog[27].requests == 1U);
+    TEST_CHECK(messageLog[27].tick[0] == 999U);
+    TEST_CHECK(messageLog[0].requests == 0U);
+    TEST_CHECK((messageLog[9].requests == 15U) && (messageLog[9].tick[0] == 63U) && OnGrid(9U, 0U));
+    TEST_CHECK((messageLog[60].tick[0] == 5U) && OnGrid(60U, 0U));
+    /* The statistics restart with the scheduler */
+    for (index = 0U; index < APP_CAN_CYCLIC_MESSAGES; index++)
+    {
+        StatsCheck(index);
+    }
+}
+
+/* A lost Tx event must not show up as a period twice as long */
+static void TestEventLost(void)
+{
+    APP_CAN_CYCLIC_MESSAGE message;
+    APP_CAN_CYCLIC_STATS stats;
+    uint32_t round = 0U;
+
+    Reset(0U);
+    message = Message(0x500U, false, 8U, 10U, 0U);
+    Set(0U, &message);
+    message = Message(0x501U, false, 8U, 20U, 5U);
+    Set(1U, &message);
+    Start();
+    for (round = 0U; round < 5U; round++)
+    {
+        Run(100U + TEST_RandomBelow(100U));
+        eventsToLose = 1U + TEST_RandomBelow(3U);
+    }
+    Run(100U);
+    APP_CAN_CyclicStop();
+    Drain();
+
+    APP_CAN_CyclicStatsGet(0U, &stats);
+    TEST_CHECK(eventsLost != 0U);
+    TEST_CHECK(stats.sent < messageLog[0].frames);
+    TEST_CHECK((stats.requestPeriodMax <= ((10U * TICKS_PER_MS) + LATENCY_MAX)) &&
+               (stats.busPeriodMax < (11U * TICKS_PER_MS)));
+    StatsCheck(0U);
+    APP_CAN_CyclicStatsGet(1U, &stats);
+    TEST_CHECK(stats.requestPeriodMax <= ((20U * TICKS_PER_MS) + LATENCY_MAX));
+    StatsCheck(1U);
+}
+
+static void TestInvalid(void)
+{
+    APP_CAN_CYCLIC_MESSAGE valid = Message(0x600U, false, 4U, 10U, 0U);
+    APP_CAN_CYCLIC_MESSAGE message;
+    APP_CAN_CYCLIC_MESSAGE stored;
+    static const uint8_t crc8Check[9] = { '1', '2', '3', '4', '5', '6', '7', '8', '9' };
+
+    /* Check value of CRC-8/SAE-J1850 */
+    TEST_CHECK(ChecksumGet(APP_CAN_CYCLIC_CHECKSUM_CRC8, crc8Check, 9U, 9U) == 0x4BU);
+
+    Reset(0U);
+    valid.counterByte = 0U;
+    valid.counterMask = 0x0FU;
+    valid.checksumByte = 3U;
+    valid.checksum = APP_CAN_CYCLIC_CHECKSUM_SUM;
+    TEST_CHECK(APP_CAN_CyclicSet(APP_CAN_CYCLIC_MESSAGES, &valid) == false);
+    message = valid;
+    message.period = 0U;
+    TEST_CHECK(APP_CAN_CyclicSet(0U, &message) == false);
+    message = valid;
+    message.frame.dlc = 9U;
+    TEST_CHECK(APP_CAN_CyclicSet(0U, &message) == false);
+    message = valid;
+    message.counterByte = 4U;
+    TEST_CHECK(APP_CAN_CyclicSet(0U, &message) == false);
+    message = valid;
+    message.checksumByte = 4U;
+    TEST_CHECK(APP_CAN_CyclicSet(0U, &message) == false);
+    message = valid;
+    message.checksumByte = 0U;
+    TEST_CHECK(APP_CAN_CyclicSet(0U, &message) == false);
+    message = valid;
+    message.checksum = (APP_CAN_CYCLIC_CHECKSUM)(APP_CAN_CYCLIC_CHECKSUM_CRC8 + 1U);
+    TEST_CHECK(APP_CAN_CyclicSet(0U, &message) == false);
+    message = valid;
+    message.frame.rtr = 1U;
+    TEST_CHECK(APP_CAN_CyclicSet(0U, &message) == false);
+    TEST_CHECK(APP_CAN_CyclicGet(0U, &stored) == false);
+
+    /* An RTR frame without counter and checksum, and the valid one */
+    message = valid;
+    message.frame.rtr = 1U;
+    message.counterMask = 0U;
+    message.checksum = APP_CAN_CYCLIC_CHECKSUM_NONE;
+    TEST_CHECK(APP_CAN_CyclicSet(1U, &message));
+    TEST_CHECK(APP_CAN_CyclicSet(0U, &valid));
+    TEST_CHECK(APP_CAN_CyclicGet(0U, &stored) && (stored.frame.id == valid.frame.id) && (stored.period == valid.period));
+    APP_CAN_CyclicRemove(0U);
+    APP_CAN_CyclicRemove(1U);
+    TEST_CHECK(APP_CAN_CyclicGet(0U, &stored) == false);
+}
+
+/* A replay stopped while its frames wait in the Tx FIFO of a stalled bus
+   between cyclic frames: only the replay frames are cancelled, the cyclic
+   ones go out in their order once the bus runs again */
+static void TestReplayStop(void)
+{
+    static const uint8_t data[8] = { 0x10U, 0x32U, 0x54U, 0x76U, 0x98U, 0xBAU, 0xDCU, 0xFEU };
+    APP_CAN_CYCLIC_MESSAGE message;
+    APP_CAN_CYCLIC_STATS stats;
+    APP_CAN_REPLAY_STATS replayStats;
+    APP_CAN_RING_ENTRY entry;
+    uint32_t index = 0U;
+    uint32_t cyclicPending = 0U;
+    uint32_t replayPending = 0U;
+
+    Reset(0U);
+    for (index = 0U; index < 4U; index++)
+    {
+        message = Message(0x600U + index, false, 8U, 50U, index * 10U);
+        Set(index, &message);
+    }
+    Start();
+    Run(105U);
+
+    /* Due about 100 ms on, between the cyclic messages 0 and 1 */
+    replayRequests = 0U;
+    replayFrames = 0U;
+    TEST_CHECK(APP_CAN_ReplayStart());
+    for (index = 0U; index < 10U; index++)
+    {
+        TEST_FrameMake(&entry, 1000U + (2U * index), 0x700U + index, false, 8U, false, false, false, false, data);
+        TEST_CHECK(APP_CAN_ReplayFrameAdd(&entry));
+    }
+    Run(90U);
+    busStallEnd = simTime + (1000U * TICKS_PER_MS);
+    Run(45U);
+
+    TEST_CHECK(replayRequests == 10U);
+    ReplayStop();
+    TEST_CHECK(APP_CAN_ReplayStateGet() == APP_CAN_REPLAY_STATE_IDLE);
+    for (index = 0U; index < fifoCount; index++)
+    {
+        if (fifo[(fifoHead + index) % FIFO_SIZE].cancelled)
+        {
+            continue;
+        }
+        if ((fifo[(fifoHead + index) % FIFO_SIZE].frame.mm & APP_CAN_TXEVENT_MARKER_SOURCE_Msk) ==
+            APP_CAN_TXEVENT_MARKER_CYCLIC)
+        {
+            cyclicPending++;
+        }
+        else
+        {
+            replayPending++;
+        }
+    }
+    TEST_CHECK((cyclicPending == 4U) && (replayPending == 0U));
+
+    busStallEnd = simTime;
+    Run(100U);
+    APP_CAN_CyclicStop();
+    Drain();
+
+    TEST_CHECK(replayFrames == 0U);
+    APP_CAN_ReplayStatsGet(&replayStats);
+    TEST_CHECK((replayStats.queued == 10U) && (replayStats.sent == 0U));
+    for (index = 0U; index < 4U; index++)
+    {
+        APP_CAN_CyclicStatsGet(index, &stats);
+        TEST_CHECK(messageLog[index].requests == (((timerTick - 1U - (index * 10U)) / 50U) + 1U));
+        TEST_CHECK(messageLog[index].frames == messageLog[index].requests);
+        TEST_CHECK((stats.late == 0U) && (stats.skipped == 0U));
+        TEST_CHECK(stats.sent == messageLog[index].frames);
+        TEST_CHECK(OnGrid(index, 0U));
+        StatsCheck(index);
+    }
+    TEST_CHECK(orderErrors == 0U);
+}
+
+int main(void)
+{
+    TEST_RandomSeed(23U);
+    APP_CAN_CyclicInitialize();
+    APP_CAN_ReplayInitialize();
+    TEST_CHECK(timerCallback != NULL);
+    TEST_CHECK(replayTimerCallback != NULL);
+    TestInvalid();
+    TestRestBus();
+    TestSlotOverflow();
+    TestStall();
+    TestPeriods();
+    TestEventLost();
+    TestReplayStop();
+
+    printf("test_cyclic: %u failures\n", testFailures);
+    return TEST_RESULT();
+}
@@ -0,0 +1,527 @@
+/*******************************************************************************
+  CAN Acceptance Filter Compiler Host Test
+
+  File Name:
+    test_filter.c
+
+  Summary:
+    Compiles random and adversarial ID sets and expands the emitted filter
+    elements back into the IDs they accept.
+
+  Description:
+    A compilation reported exact must accept the wanted IDs and nothing else,
+    any other compilation must accept at least the wanted IDs. The standard ID
+    space is expanded in full, extended elements are checked against the
+    sorted ID list.
+*******************************************************************************/
+
+#include <stdlib.h>
+#include <string.h>
+#include "test_common.h"
+#include "app_can_filter.h"
+
+#define STD_IDS             2048U
+#define EXT_ID_MASK         0x1FFFFFFFUL
+#define EXT_IDS_MAX         400U
+
+#define FILTER_RANGE        0U
+#define FILTER_DUAL         1U
+#define FILTER_CLASSIC      2U
+
+static can_sidfe_registers_t stdProgrammed[APP_CAN_FILTER_STD_ELEMENTS + 1U];
+static can_xidfe_registers_t extProgrammed[APP_CAN_FILTER_EXT_ELEMENTS + 1U];
+
+// *****************************************************************************
+// Section: CAN1 Peripheral Library Stubs
+// *****************************************************************************
+
+bool CAN1_StandardFilterElementSet(uint8_t filterNumber, can_sidfe_registers_t *stdMsgIDFilterElement)
+{
+    if ((filterNumber < 1U) || (filterNumber > APP_CAN_FILTER_STD_ELEMENTS))
+    {
+        return false;
+    }
+    stdProgrammed[filterNumber] = *stdMsgIDFilterElement;
+    return true;
+}
+
+bool CAN1_ExtendedFilterElementSet(uint8_t filterNumber, can_xidfe_registers_t *extMsgIDFilterElement)
+{
+    if ((filterNumber < 1U) || (filterNumber > APP_CAN_FILTER_EXT_ELEMENTS))
+    {
+        return false;
+    }
+    extProgrammed[filterNumber] = *extMsgIDFilterElement;
+    return true;
+}
+
+// *****************************************************************************
+// Section: Element Expansion
+// *****************************************************************************
+
+static bool StdAccepts(const can_sidfe_registers_t *element, uint32_t id)
+{
+    uint32_t type = (element->CAN_SIDFE_0 & CAN_SIDFE_0_SFT_Msk) >> CAN_SIDFE_0_SFT_Pos;
+    uint32_t config = (element->CAN_SIDFE_0 & CAN_SIDFE_0_SFEC_Msk) >> CAN_SIDFE_0_SFEC_Pos;
+    uint32_t id1 = (element->CAN_SIDFE_0 & CAN_SIDFE_0_SFID1_Msk) >> CAN_SIDFE_0_SFID1_Pos;
+    uint32_t id2 = (element->CAN_SIDFE_0 & CAN_SIDFE_0_SFID2_Msk) >> CAN_SIDFE_0_SFID2_Pos;
+
+    if (config == 0U)
+    {
+        return false;
+    }
+    switch (type)
+    {
+        case FILTER_RANGE:
+            return (id >= id1) && (id <= id2);
+        case FILTER_DUAL:
+            return (id == id1) || (id == id2);
+        case FILTER_CLASSIC:
+            return (id & id2) == (id1 & id2);
+        default:
+            return false;
+    }
+}
+
+static bool ExtAccepts(const can_xidfe_registers_t *element, uint32_t id)
+{
+    uint32_t type = (element->CAN_XIDFE_1 & CAN_XIDFE_1_EFT_Msk) >> CAN_XIDFE_1_EFT_Pos;
+    uint32_t config = (element->CAN_XIDFE_0 & CAN_XIDFE_0_EFEC_Msk) >> CAN_XIDFE_0_EFEC_Pos;
+    uint32_t id1 = (element->CAN_XIDFE_0 & CAN_XIDFE_0_EFID1_Msk) >> CAN_XIDFE_0_EFID1_Pos;
+    uint32_t id2 = (element->CAN_XIDFE_1 & CAN_XIDFE_1_EFID2_Msk) >> CAN_XIDFE_1_EFID2_Pos;
+
+    if (config == 0U)
+    {
+        return false;
+    }
+    switch (type)
+    {
+        case FILTER_RANGE:
+            return (id >= id1) && (id <= id2);
+        case FILTER_DUAL:
+            return (id == id1) || (id == id2);
+        case FILTER_CLASSIC:
+            return (id & id2) == (id1 & id2);
+        default:
+            return false;
+    }
+}
+
+static bool StdWanted(const uint8_t *set, uint32_t id)
+{
+    return (set[id >> 3] & (1U << (id & 7U))) != 0U;
+}
+
+/* Number of listed IDs in first..last */
+static uint32_t ExtCountIn(const uint32_t *id, uint32_t count, uint32_t first, uint32_t last)
+{
+    uint32_t index = 0U;
+    uint32_t found = 0U;
+
+    for (index = 0U; index < count; index++)
+    {
+        found += ((id[index] >= first) && (id[index] <= last)) ? 1U : 0U;
+    }
+    return found;
+}
+
+static bool ExtListed(const uint32_t *id, uint32_t count, uint32_t value)
+{
+    return ExtCountIn(id, count, value, value) != 0U;
+}
+
+/* True when every ID the element accepts is listed */
+static bool ExtElementWithin(const can_xidfe_registers_t *element, const uint32_t *id, uint32_t count)
+{
+    uint32_t type = (element->CAN_XIDFE_1 & CAN_XIDFE_1_EFT_Msk) >> CAN_XIDFE_1_EFT_Pos;
+    uint32_t id1 = (element->CAN_XIDFE_0 & CAN_XIDFE_0_EFID1_Msk) >> CAN_XIDFE_0_EFID1_Pos;
+    uint32_t id2 = (element->CAN_XIDFE_1 & CAN_XIDFE_1_EFID2_Msk) >> CAN_XIDFE_1_EFID2_Pos;
+    uint32_t free = 0U;
+    uint32_t member = 0U;
+
+    switch (type)
+    {
+        case FILTER_RANGE:
+            return (id1 <= id2) && (ExtCountIn(id, count, id1, id2) == (id2 - id1 + 1U));
+        case FILTER_DUAL:
+            return ExtListed(id, count, id1) && ExtListed(id, count, id2);
+        case FILTER_CLASSIC:
+            free = ~id2 & EXT_ID_MASK;
+            if ((uint32_t)__builtin_popcount(free) > 9U)
+            {
+                return false;
+            }
+            do
+            {
+                if (ExtListed(id, count, (id1 & id2) | member) == false)
+                {
+                    return false;
+                }
+                member = (member - free) & free;
+            } while (member != 0U);
+            return true;
+        default:
+            return false;
+    }
+}
+
+// *****************************************************************************
+// Section: Checks
+// *****************************************************************************
+
+static void CheckStdSet(const uint8_t *set, uint32_t maxElements)
+{
+    can_sidfe_registers_t element[APP_CAN_FILTER_STD_ELEMENTS];
+    uint32_t count = 0U;
+    uint32_t index = 0U;
+    uint32_t id = 0U;
+    bool exact = false;
+    bool accepted = false;
+    unsigned int missing = 0U;
+    unsigned int extra = 0U;
+
+    memset(element, 0, sizeof(element));
+    count = APP_CAN_FilterStdCompile(set, element, maxElements, &exact);
+    TEST_CHECK(count <= maxElements);
+
+    for (id = 0U; id < STD_IDS; id++)
+    {
+        accepted = false;
+        for (index = 0U; (index < count) && (accepted == false); index++)
+        {
+            accepted = StdAccepts(&element[index], id);
+        }
+        missing += (StdWanted(set, id) && !accepted) ? 1U : 0U;
+        extra += (!StdWanted(set, id) && accepted) ? 1U : 0U;
+    }
+    TEST_CHECK(missing == 0U);
+    if (exact)
+    {
+        TEST_CHECK(extra == 0U);
+    }
+    /* Stored in Rx FIFO0 */
+    for (index = 0U; index < count; index++)
+    {
+        TEST_CHECK(((element[index].CAN_SIDFE_0 & CAN_SIDFE_0_SFEC_Msk) >> CAN_SIDFE_0_SFEC_Pos) == 1U);
+    }
+}
+
+static void CheckExtSet(const uint32_t *id, uint32_t idCount, uint32_t maxElements)
+{
+    can_xidfe_registers_t element[APP_CAN_FILTER_EXT_ELEMENTS];
+    uint32_t count = 0U;
+    uint32_t index = 0U;
+    uint32_t listed = 0U;
+    bool exact = false;
+    bool accepted = false;
+
+    memset(element, 0, sizeof(element));
+    count = APP_CAN_FilterExtCompile(id, idCount, element, maxElements, &exact);
+    TEST_CHECK(count <= maxElements);
+
+    for (listed = 0U; listed < idCount; listed++)
+    {
+        accepted = false;
+        for (index = 0U; (index < count) && (accepted == false); index++)
+        {
+            accepted = ExtAccepts(&element[index], id[listed]);
+        }
+        TEST_CHECK(accepted);
+    }
+    for (index = 0U; index < count; index++)
+    {
+        /* Stored in Rx FIFO1 */
+        TEST_CHECK(((element[index].CAN_XIDFE_0 & CAN_XIDFE_0_EFEC_Msk) >> CAN_XIDFE_0_EFEC_Pos) == 2U);
+        if (exact)
+        {
+            TEST_CHECK(ExtElementWithin(&element[index], id, idCount));
+        }
+    }
+}
+
+static void CheckStdAllSizes(const uint8_t *set)
+{
+    static const uint32_t sizes[] = { 1U, 2U, 3U, 8U, 31U, APP_CAN_FILTER_STD_ELEMENTS };
+    uint32_t index = 0U;
+
+    for (index = 0U; index < (sizeof(sizes) / sizeof(sizes[0])); index++)
+    {
+        CheckStdSet(set, sizes[index]);
+    }
+}
+
+static void CheckExtAllSizes(uint32_t *id, uint32_t idCount)
+{
+    static const uint32_t sizes[] = { 1U, 2U, 5U, 16U, APP_CAN_FILTER_EXT_ELEMENTS };
+    uint32_t index = 0U;
+    uint32_t sorted = 0U;
+    uint32_t value = 0U;
+    uint32_t unique = 0U;
+
+    /* Ascending and unique, as APP_CAN_FilterIdAdd keeps them */
+    for (index = 1U; index < idCount; index++)
+    {
+        value = id[index];
+        for (sorted = index; (sorted > 0U) && (id[sorted - 1U] > value); sorted--)
+        {
+            id[sorted] = id[sorted - 1U];
+        }
+        id[sorted] = value;
+    }
+    for (index = 0U; index < idCount; index++)
+    {
+        if ((unique == 0U) || (id[unique - 1U] != id[index]))
+        {
+            id[unique++] = id[index];
+        }
+    }
+    for (index = 0U; index < (sizeof(sizes) / sizeof(sizes[0])); index++)
+    {
+        CheckExtSet(id, unique, sizes[index]);
+    }
+}
+
+// *****************************************************************************
+// Section: ID Sets
+// *****************************************************************************
+
+static void StdSetAdd(uint8_t *set, uint32_t id)
+{
+    set[id >> 3] |= (uint8_t)(1U << (id & 7U));
+}
+
+static void TestStdAdversarial(void)
+{
+    uint8_t set[APP_CAN_FILTER_STD_SET_SIZE];
+    uint32_t id = 0U;
+    uint32_t step = 0U;
+
+    /* Empty, full and the ends of the ID space */
+    memset(set, 0, sizeof(set));
+    CheckStdAllSizes(set);
+    memset(set, 0xFF, sizeof(set));
+    CheckStdAllSizes(set);
+    memset(set, 0, sizeof(set));
+    StdSetAdd(set, 0U);
+    StdSetAdd(set, STD_IDS - 1U);
+    CheckStdAllSizes(set);
+    memset(set, 0, sizeof(set));
+    StdSetAdd(set, STD_IDS - 3U);
+    StdSetAdd(set, STD_IDS - 2U);
+    StdSetAdd(set, STD_IDS - 1U);
+    CheckStdAllSizes(set);
+
+    /* Every step-th ID: no runs, classic filters only where the step is a power of two */
+    for (step = 2U; step <= 7U; step++)
+    {
+        memset(set, 0, sizeof(set));
+        for (id = 0U; id < STD_IDS; id += step)
+        {
+            StdSetAdd(set, id);
+        }
+        CheckStdAllSizes(set);
+    }
+
+    /* Pairs of IDs with a one ID gap, the worst case for ranges */
+    memset(set, 0, sizeof(set));
+    for (id = 0U; (id + 1U) < STD_IDS; id += 3U)
+    {
+        StdSetAdd(set, id);
+        StdSetAdd(set, id + 1U);
+    }
+    CheckStdAllSizes(set);
+
+    /* Masked groups missing one member */
+    memset(set, 0, sizeof(set));
+    for (id = 0U; id < STD_IDS; id++)
+    {
+        if (((id & 0x0F0U) == 0x050U) && ((id & 0x00FU) != 0x00AU))
+        {
+            StdSetAdd(set, id);
+        }
+    }
+    CheckStdAllSizes(set);
+
+    /* Single bit IDs */
+    memset(set, 0, sizeof(set));
+    for (id = 1U; id < STD_IDS; id <<= 1)
+    {
+        StdSetAdd(set, id);
+    }
+    CheckStdAllSizes(set);
+}
+
+static void TestStdRandom(void)
+{
+    uint8_t set[APP_CAN_FILTER_STD_SET_SIZE];
+    uint32_t round = 0U;
+    uint32_t count = 0U;
+    uint32_t index = 0U;
+    uint32_t base = 0U;
+    uint32_t run = 0U;
+
+    for (round = 0U; round < 200U; round++)
+    {
+        memset(set, 0, sizeof(set));
+        count = 1U + TEST_RandomBelow(300U);
+        for (index = 0U; index < count; index++)
+        {
+            /* Mix of lone IDs and short runs */
+            base = TEST_RandomBelow(STD_IDS);
+            run = ((round & 1U) != 0U) ? TEST_RandomBelow(6U) : 0U;
+            while ((run-- > 0U) && (base < STD_IDS))
+            {
+                StdSetAdd(set, base++);
+            }
+            if (base < STD_IDS)
+            {
+                StdSetAdd(set, base);
+            }
+        }
+        CheckStdAllSizes(set);
+    }
+}
+
+static void TestExtAdversarial(void)
+{
+    static uint32_t id[EXT_IDS_MAX];
+    uint32_t count = 0U;
+    uint32_t bit = 0U;
+
+    /* Top of the ID space */
+    id[0] = EXT_ID_MASK - 2U;
+    id[1] = EXT_ID_MASK - 1U;
+    id[2] = EXT_ID_MASK;
+    CheckExtAllSizes(id, 3U);
+    id[0] = 0U;
+    id[1] = EXT_ID_MASK;
+    CheckExtAllSizes(id, 2U);
+    id[0] = EXT_ID_MASK;
+    CheckExtAllSizes(id, 1U);
+
+    /* Single bit IDs, far apart */
+    count = 0U;
+    for (bit = 0U; bit < 29U; bit++)
+    {
+        id[count++] = 1UL << bit;
+    }
+    CheckExtAllSizes(id, count);
+
+    /* A full masked group and one with a member missing */
+    count = 0U;
+    for (bit = 0U; bit < 16U; bit++)
+    {
+        id[count++] = 0x18FEF000UL | (bit << 4);
+    }
+    for (bit = 0U; bit < 16U; bit++)
+    {
+        if (bit != 9U)
+        {
+            id[count++] = 0x0CF00400UL | (bit << 8);
+        }
+    }
+    CheckExtAllSizes(id, count);
+
+    /* More IDs than the exact compiler keeps pending flags for */
+    count = 0U;
+    for (bit = 0U; bit < 300U; bit++)
+    {
+        id[count++] = 0x10000000UL + (bit * 3U);
+    }
+    CheckExtAllSizes(id, count);
+}
+
+static void TestExtRandom(void)
+{
+    static uint32_t id[EXT_IDS_MAX];
+    uint32_t round = 0U;
+    uint32_t count = 0U;
+    uint32_t index = 0U;
+    uint32_t base = 0U;
+
+    for (round = 0U; round < 200U; round++)
+    {
+        count = 1U + TEST_RandomBelow(APP_CAN_FILTER_EXT_IDS);
+        /* J1939 style clusters on odd rounds, spread over the space on even */
+        base = TEST_Random() & EXT_ID_MASK & ~0xFFFFUL;
+        for (index = 0U; index < count; index++)
+        {
+            id[index] = ((round & 1U) != 0U) ? (base | TEST_RandomBelow(0x400U)) : (TEST_Random() & EXT_ID_MASK);
+        }
+        CheckExtAllSizes(id, count);
+    }
+}
+
+// *****************************************************************************
+// Section: Filter Programming
+// *****************************************************************************
+
+static void TestApply(void)
+{
+    APP_CAN_FILTER_STATUS status;
+    APP_CAN_FILTER_STATUS previous;
+    uint32_t id = 0U;
+
+    /* Empty set, accept all */
+    memset(stdProgrammed, 0xA5, sizeof(stdProgrammed));
+    memset(extProgrammed, 0xA5, sizeof(extProgrammed));
+    APP_CAN_FilterClear();
+    APP_CAN_FilterApply(&status);
+    TEST_CHECK(status.stdElements == 1U);
+    TEST_CHECK(status.extElements == 1U);
+    TEST_CHECK(StdAccepts(&stdProgrammed[1], 0x7FFU));
+    TEST_CHECK(ExtAccepts(&extProgrammed[1], EXT_ID_MASK));
+
+    TEST_CHECK(APP_CAN_FilterIdAdd(0x800U, false) == false);
+    TEST_CHECK(APP_CAN_FilterIdAdd(EXT_ID_MASK + 1U, true) == false);
+    for (id = 0U; id < 40U; id++)
+    {
+        TEST_CHECK(APP_CAN_FilterIdAdd(id * 37U, false));
+        TEST_CHECK(APP_CAN_FilterIdAdd(0x18DA0000UL + (id * 1001U), true));
+    }
+    TEST_CHECK(APP_CAN_FilterIdAdd(0x18DA0000UL, true));
+    APP_CAN_FilterApply(&status);
+    TEST_CHECK(status.stdExact && status.extExact);
+    TEST_CHECK(ExtAccepts(&extProgrammed[1], 0x18DA0000UL) || ExtAccepts(&extProgrammed[2], 0x18DA0000UL));
+
+    /* Shrinking the set disables the elements no longer used, and only those */
+    previous = status;
+    memset(stdProgrammed, 0xA5, sizeof(stdProgrammed));
+    memset(extProgrammed, 0xA5, sizeof(extProgrammed));
+    APP_CAN_FilterClear();
+    TEST_CHECK(APP_CAN_FilterIdAdd(0x123U, false));
+    APP_CAN_FilterApply(&status);
+    TEST_CHECK(status.stdElements == 1U);
+    TEST_CHECK(status.extElements == 0U);
+    TEST_CHECK(StdAccepts(&stdProgrammed[1], 0x123U) && !StdAccepts(&stdProgrammed[1], 0x124U));
+    for (id = 2U; id <= APP_CAN_FILTER_STD_ELEMENTS; id++)
+    {
+        TEST_CHECK(stdProgrammed[id].CAN_SIDFE_0 == ((id <= previous.stdElements) ? 0U : 0xA5A5A5A5UL));
+    }
+    for (id = 1U; id <= APP_CAN_FILTER_EXT_ELEMENTS; id++)
+    {
+        TEST_CHECK(extProgrammed[id].CAN_XIDFE_1 == ((id <= previous.extElements) ? 0U : 0xA5A5A5A5UL));
+    }
+
+    /* The extended list is bounded */
+    APP_CAN_FilterClear();
+    for (id = 0U; id < APP_CAN_FILTER_EXT_IDS; id++)
+    {
+        TEST_CHECK(APP_CAN_FilterIdAdd(id * 5U, true));
+    }
+    TEST_CHECK(APP_CAN_FilterIdAdd(1U, true) == false);
+    TEST_CHECK(APP_CAN_FilterIdAdd(5U, true));
+}
+
+int main(void)
+{
+    TEST_RandomSeed(11U);
+    TestStdAdversarial();
+    TestStdRandom();
+    TestExtAdversarial();
+    TestExtRandom();
+    TestApply();
+
+    printf("test_filter: %u failures\n", testFailures);
+    return TEST_RESULT();
+}
@@ -0,0 +1,568 @@
+/*******************************************************************************
+  CAN Flash Recorder Host Test
+
+  File Name:
+    test_flashlog.c
+
+  Summary:
+    Runs the flash recorder on a simulated NVM and reads the log back.
+
+  Description:
+    Covers the log wrapping around several times with the erase ahead of
+    the write pointer, full page buffers, freezing on an event across resets
+    and erasing the log. Power is cut during page writes and block erases,
+    with and without the checkpoint in the RTC backup registers, and the
+    recorder must recover without losing or reordering any frame which had
+    reached the flash.
+*******************************************************************************/
+
+#include <string.h>
+#include "test_common.h"
+#include "test_frame.h"
+#include "test_nvm.h"
+#include "app_can_flashlog.h"
+#include "app_can_record.h"
+
+#define TICKS_PER_FRAME     100U
+#define READ_MAX            65536U
+#define LOST_MAX            256U
+#define POWER_CUTS          200U
+
+#define PAGE_HEADER_SIZE    sizeof(APP_CAN_FLASHLOG_PAGE_HEADER)
+
+typedef struct
+{
+    uint32_t first;
+    uint32_t end;
+} RANGE;
+
+/* Next frame number */
+static uint32_t next = 0U;
+static uint32_t readFrame[READ_MAX];
+static RANGE lost[LOST_MAX];
+static uint32_t lostCount = 0U;
+
+// *****************************************************************************
+// Section: Frames
+// *****************************************************************************
+
+/* Frame n, mostly classical with every eighth an FD frame */
+static void FrameOf(uint32_t n, APP_CAN_RING_ENTRY *entry)
+{
+    uint8_t data[64];
+    uint32_t index = 0U;
+    bool xtd = ((n % 5U) == 4U);
+    bool fdf = ((n % 8U) == 7U);
+
+    for (index = 0U; index < sizeof(data); index++)
+    {
+        data[index] = (uint8_t)((n * 7U) + (index * 13U));
+    }
+    TEST_FrameMake(entry, n * TICKS_PER_FRAME, xtd ? (0x18FF0000UL | (n & 0xFFFFU)) : (n % 0x800U), xtd,
+                   fdf ? (9U + (n % 7U)) : (n % 9U), fdf, fdf, false, !fdf && ((n % 17U) == 0U), data);
+}
+
+/* Adds frames, the main loop runs once per frame */
+static void Record(uint32_t frames)
+{
+    APP_CAN_RING_ENTRY entry;
+    uint32_t index = 0U;
+
+    for (index = 0U; index < frames; index++)
+    {
+        FrameOf(next++, &entry);
+        APP_CAN_FlashLogFrameAdd(&entry);
+        APP_CAN_FlashLogTasks();
+    }
+}
+
+static void Drain(void)
+{
+    uint32_t polls = 0U;
+
+    while ((APP_CAN_FlashLogIdle() == false) && (polls < 1000000U))
+    {
+        APP_CAN_FlashLogTasks();
+        polls++;
+    }
+    TEST_CHECK(APP_CAN_FlashLogIdle());
+}
+
+/* Reset of the device, the checkpoint survives unless power is lost */
+static void Restart(bool powerLoss)
+{
+    if (powerLoss)
+    {
+        TEST_NvmBackupClear();
+    }
+    APP_CAN_FlashLogCheckpointLoad();
+    APP_CAN_FlashLogInitialize();
+}
+
+static APP_CAN_FLASHLOG_STATE State(void)
+{
+    APP_CAN_FLASHLOG_STATUS status;
+
+    APP_CAN_FlashLogStatusGet(&status);
+    return status.state;
+}
+
+/* Reads the whole log into readFrame, every frame must be intact */
+static uint32_t ReadBack(void)
+{
+    APP_CAN_RING_ENTRY entry;
+    APP_CAN_RING_ENTRY expected;
+    uint32_t count = 0U;
+
+    APP_CAN_FlashLogEnable(false);
+    Drain();
+    APP_CAN_FlashLogReadStart(NULL);
+    while (APP_CAN_FlashLogFrameGet(&entry) && (count < READ_MAX))
+    {
+        TEST_CHECK((entry.timestamp % TICKS_PER_FRAME) == 0U);
+        FrameOf(entry.timestamp / TICKS_PER_FRAME, &expected);
+        TEST_CHECK(TEST_FrameEqual(&entry, &expected));
+        readFrame[count++] = entry.timestamp / TICKS_PER_FRAME;
+        APP_CAN_FlashLogFrameRelease();
+    }
+    TEST_CHECK(count < READ_MAX);
+    APP_CAN_FlashLogEnable(true);
+    return count;
+}
+
+/* readFrame[offset...] holds the frames first to end - 1 */
+static uint32_t CheckRun(uint32_t count, uint32_t offset, uint32_t first, uint32_t end)
+{
+    uint32_t index = 0U;
+
+    TEST_CHECK((count >= offset) && ((count - offset) >= (end - first)));
+    for (index = 0U; (index < (end - first)) && ((offset + index) < count); index++)
+    {
+        if (readFrame[offset + index] != (first + index))
+        {
+            printf("  frame %lu read at %lu, expected %lu\n", (unsigned long)readFrame[offset + index],
+                   (unsigned long)(offset + index), (unsigned long)(first + index));
+            TEST_CHECK(readFrame[offset + index] == (first + index));
+            break;
+        }
+    }
+    return offset + (end - first);
+}
+
+// *****************************************************************************
+// Section: Reference view of the flash
+// *****************************************************************************
+
+static uint32_t Word(const uint8_t *raw)
+{
+    return (uint32_t)raw[0] | ((uint32_t)raw[1] << 8) | ((uint32_t)raw[2] << 16) | ((uint32_t)raw[3] << 24);
+}
+
+static const APP_CAN_FLASHLOG_PAGE_HEADER *PageHeader(uint32_t page)
+{
+    return (const APP_CAN_FLASHLOG_PAGE_HEADER *)&testNvmFlash[page * APP_CAN_FLASHLOG_PAGE_SIZE];
+}
+
+/* A complete data page, checked as documented in the header file */
+static bool PageValid(uint32_t page)
+{
+    APP_CAN_FLASHLOG_PAGE_HEADER header = *PageHeader(page);
+    uint8_t copy[APP_CAN_FLASHLOG_PAGE_SIZE];
+
+    if ((header.magic != APP_CAN_FLASHLOG_MAGIC) || (header.length > (APP_CAN_FLASHLOG_PAGE_SIZE - PAGE_HEADER_SIZE)))
+    {
+        return false;
+    }
+    memcpy(copy, PageHeader(page), APP_CAN_FLASHLOG_PAGE_SIZE);
+    ((APP_CAN_FLASHLOG_PAGE_HEADER *)copy)->crc = 0U;
+    return (APP_CAN_RecordCrc16(copy, PAGE_HEADER_SIZE + header.length) == header.crc);
+}
+
+/* Frames in complete pages, and the newest of them */
+static uint32_t StoredFrames(uint32_t *newest)
+{
+    const uint8_t *data = NULL;
+    uint32_t page = 0U;
+    uint32_t offset = 0U;
+    uint32_t frames = 0U;
+    uint32_t timestamp = 0U;
+
+    *newest = 0U;
+    for (page = 0U; page < APP_CAN_FLASHLOG_PAGES; page++)
+    {
+        if (PageValid(page) == false)
+        {
+            continue;
+        }
+        data = (const uint8_t *)PageHeader(page) + PAGE_HEADER_SIZE;
+        for (offset = 0U; offset < PageHeader(page)->length; offset += (uint32_t)APP_CAN_RecordPackedSize(&data[offset]))
+        {
+            timestamp = Word(&data[offset]);
+            *newest = ((frames == 0U) || ((timestamp / TICKS_PER_FRAME) > *newest)) ? (timestamp / TICKS_PER_FRAME) : *newest;
+            frames++;
+        }
+    }
+    return frames;
+}
+
+static uint32_t StoredPages(void)
+{
+    uint32_t page = 0U;
+    uint32_t pages = 0U;
+
+    for (page = 0U; page < APP_CAN_FLASHLOG_PAGES; page++)
+    {
+        pages += PageValid(page) ? 1U : 0U;
+    }
+    return pages;
+}
+
+static void CheckNvm(void)
+{
+    APP_CAN_FLASHLOG_STATUS status;
+
+    APP_CAN_FlashLogStatusGet(&status);
+    TEST_CHECK(status.errors == 0U);
+    TEST_CHECK(testNvm.overwrites == 0U);
+    TEST_CHECK(testNvm.collisions == 0U);
+    TEST_CHECK(testNvm.outOfRange == 0U);
+}
+
+/* Cuts the power during the operation in flight and resets. Frames which
+   had not reached the flash are lost, returns the first of them. */
+static uint32_t PowerCut(uint32_t bytes, bool powerLoss)
+{
+    uint32_t newest = 0U;
+
+    TEST_NvmPowerCut(bytes);
+    Restart(powerLoss);
+    TEST_CHECK(State() == APP_CAN_FLASHLOG_STATE_RECORDING);
+    (void)StoredFrames(&newest);
+    if ((lostCount < LOST_MAX) && ((newest + 1U) < next))
+    {
+        lost[lostCount].first = newest + 1U;
+        lost[lostCount].end = next;
+        lostCount++;
+    }
+    return newest + 1U;
+}
+
+static bool Lost(uint32_t n)
+{
+    uint32_t index = 0U;
+
+    for (index = 0U; index < lostCount; index++)
+    {
+        if ((n >= lost[index].first) && (n < lost[index].end))
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+/* Starts every test with an erased log after power-on */
+static void Start(void)
+{
+    TEST_NvmReset();
+    next = 0U;
+    lostCount = 0U;
+    APP_CAN_FlashLogFreezeSet(false, 0U);
+    Restart(true);
+    TEST_CHECK(State() == APP_CAN_FLASHLOG_STATE_RECORDING);
+}
+
+// *****************************************************************************
+// Section: Tests
+// *****************************************************************************
+
+/* About four times around the log */
+static void TestWrapAround(void)
+{
+    APP_CAN_FLASHLOG_STATUS status;
+    uint32_t count = 0U;
+    uint32_t newest = 0U;
+
+    Start();
+    Record(50000U);
+    count = ReadBack();
+
+    /* The newest frames in order, as many as the complete pages hold */
+    TEST_CHECK(count == StoredFrames(&newest));
+    TEST_CHECK(newest == (next - 1U));
+    (void)CheckRun(count, 0U, next - count, next);
+    TEST_CHECK(testNvm.writes > (4U * APP_CAN_FLASHLOG_PAGES));
+    /* Only the block being written and the one erased ahead of it hold no
+       complete data pages */
+    TEST_CHECK(StoredPages() >= ((APP_CAN_FLASHLOG_BLOCKS - 2U) * (APP_CAN_FLASHLOG_PAGES_PER_BLOCK - 1U)));
+
+    /* Every block erased once per pass, ahead of the write pointer except the
+       first one */
+    TEST_CHECK(testNvm.erases <= ((testNvm.writes / APP_CAN_FLASHLOG_PAGES_PER_BLOCK) + 2U));
+    TEST_CHECK(testNvm.entryErases == 1U);
+    APP_CAN_FlashLogStatusGet(&status);
+    TEST_CHECK(status.dropped == 0U);
+    CheckNvm();
+}
+
+/* Without the main loop the page buffers fill up and frames are dropped */
+static void TestBufferFull(void)
+{
+    APP_CAN_FLASHLOG_STATUS status;
+    APP_CAN_RING_ENTRY entry;
+    uint32_t first = 0U;
+    uint32_t index = 0U;
+    uint32_t count = 0U;
+    uint32_t dropped = 0U;
+
+    Start();
+    Record(5000U);
+    APP_CAN_FlashLogStatusGet(&status);
+    dropped = status.dropped;
+    first = next;
+    for (index = 0U; index < 2000U; index++)
+    {
+        FrameOf(next++, &entry);
+        APP_CAN_FlashLogFrameAdd(&entry);
+    }
+    APP_CAN_FlashLogStatusGet(&status);
+    dropped = status.dropped - dropped;
+    TEST_CHECK((dropped > 0U) && (dropped < 2000U));
+
+    /* The frames up to the full buffers are kept */
+    count = ReadBack();
+    TEST_CHECK(count == (next - dropped));
+    (void)CheckRun(count, 0U, 0U, next - dropped);
+    TEST_CHECK(readFrame[count - 1U] == ((first + 2000U) - dropped - 1U));
+    CheckNvm();
+}
+
+static void TestFrozen(void)
+{
+    uint32_t event = 0U;
+    uint32_t resume = 0U;
+    uint32_t count = 0U;
+
+    Start();
+    APP_CAN_FlashLogFreezeSet(true, 100U);
+    Record(3000U);
+    APP_CAN_FlashLogEvent();
+    event = next;
+    Record(1000U);
+    Drain();
+    TEST_CHECK(State() == APP_CAN_FLASHLOG_STATE_FROZEN);
+
+    /* The frames before the event and 100 after it */
+    count = ReadBack();
+    TEST_CHECK(count == (event + 100U));
+    (void)CheckRun(count, 0U, 0U, event + 100U);
+    TEST_CHECK(State() == APP_CAN_FLASHLOG_STATE_FROZEN);
+
+    /* Stays frozen across a reset, with and without the checkpoint */
+    Record(500U);
+    Restart(false);
+    TEST_CHECK(State() == APP_CAN_FLASHLOG_STATE_FROZEN);
+    Record(500U);
+    Restart(true);
+    TEST_CHECK(State() == APP_CAN_FLASHLOG_STATE_FROZEN);
+    TEST_CHECK(ReadBack() == count);
+
+    /* Recording continues after the frozen frames */
+    APP_CAN_FlashLogUnfreeze();
+    TEST_CHECK(State() == APP_CAN_FLASHLOG_STATE_RECORDING);
+    resume = next;
+    Record(200U);
+    count = ReadBack();
+    (void)CheckRun(count, CheckRun(count, 0U, 0U, event + 100U), resume, next);
+    TEST_CHECK(count == (event + 100U + 200U));
+
+    /* An event without freeze enabled changes nothing */
+    APP_CAN_FlashLogFreezeSet(false, 0U);
+    APP_CAN_FlashLogEvent();
+    Record(200U);
+    Drain();
+    TEST_CHECK(State() == APP_CAN_FLASHLOG_STATE_RECORDING);
+    TEST_CHECK(ReadBack() == (count + 200U));
+    CheckNvm();
+}
+
+static void TestErase(void)
+{
+    uint32_t first = 0U;
+    uint32_t count = 0U;
+
+    Start();
+    Record(20000U);
+    APP_CAN_FlashLogErase();
+    TEST_CHECK(State() == APP_CAN_FLASHLOG_STATE_ERASING);
+    TEST_CHECK(APP_CAN_FlashLogIdle() == false);
+    Drain();
+    TEST_CHECK(State() == APP_CAN_FLASHLOG_STATE_RECORDING);
+    TEST_CHECK(StoredPages() == 0U);
+    TEST_CHECK(ReadBack() == 0U);
+
+    first = next;
+    Record(1000U);
+    count = ReadBack();
+    TEST_CHECK(count == 1000U);
+    (void)CheckRun(count, 0U, first, next);
+
+    /* And after a reset */
+    Restart(false);
+    TEST_CHECK(ReadBack() == count);
+    CheckNvm();
+}
+
+/* Power cut while a data page is written: part of the page, only some
+   header bytes or nothing at all reached the flash */
+static void TestPartialPage(bool powerLoss)
+{
+    const uint8_t *page = NULL;
+    uint32_t address = 0U;
+    uint32_t cut = 0U;
+    uint32_t lostFirst = 0U;
+    uint32_t resume = 0U;
+    uint32_t count = 0U;
+    uint32_t pageFirst = 0U;
+    uint32_t bytes[3] = { 0U, 8U, 0U };
+    uint32_t pageInBlock = 0U;
+
+    for (cut = 0U; cut < 3U; cut++)
+    {
+        Start();
+        Record(2000U);
+        page = NULL;
+        while (page == NULL)
+        {
+            Record(1U);
+            page = TEST_NvmPendingWrite(&address);
+            pageInBlock = ((address - APP_CAN_FLASHLOG_START) / APP_CAN_FLASHLOG_PAGE_SIZE) % APP_CAN_FLASHLOG_PAGES_PER_BLOCK;
+            page = ((pageInBlock > 0U) && (pageInBlock < (APP_CAN_FLASHLOG_PAGES_PER_BLOCK - 1U))) ? page : NULL;
+        }
+        pageFirst = Word(&page[PAGE_HEADER_SIZE]) / TICKS_PER_FRAME;
+        bytes[2] = PAGE_HEADER_SIZE + (((const APP_CAN_FLASHLOG_PAGE_HEADER *)page)->length / 2U);
+
+        /* The page in flight and the frames after it are lost */
+        lostFirst = PowerCut(bytes[cut], powerLoss);
+        TEST_CHECK(lostFirst == pageFirst);
+
+        resume = next;
+        Record(2000U);
+        count = ReadBack();
+        (void)CheckRun(count, CheckRun(count, 0U, 0U, lostFirst), resume, next);
+        TEST_CHECK(count == (lostFirst + (next - resume)));
+        CheckNvm();
+    }
+}
+
+/* Power cut while the summary page of a block is written */
+static void TestPartialSummary(bool powerLoss)
+{
+    uint32_t address = 0U;
+    uint32_t pageInBlock = 0U;
+    uint32_t lostFirst = 0U;
+    uint32_t resume = 0U;
+    uint32_t count = 0U;
+
+    Start();
+    Record(2000U);
+    pageInBlock = 0U;
+    while (pageInBlock != (APP_CAN_FLASHLOG_PAGES_PER_BLOCK - 1U))
+    {
+        APP_CAN_FlashLogTasks();
+        Record(1U);
+        pageInBlock = (TEST_NvmPendingWrite(&address) == NULL) ? 0U :
+                      (((address - APP_CAN_FLASHLOG_START) / APP_CAN_FLASHLOG_PAGE_SIZE) % APP_CAN_FLASHLOG_PAGES_PER_BLOCK);
+    }
+    lostFirst = PowerCut(100U, powerLoss);
+
+    resume = next;
+    Record(2000U);
+    count = ReadBack();
+    (void)CheckRun(count, CheckRun(count, 0U, 0U, lostFirst), resume, next);
+    CheckNvm();
+}
+
+/* Power cut while the block after the write pointer is erased, on the
+   second pass when it holds the oldest frames */
+static void TestPartialErase(bool powerLoss)
+{
+    uint32_t lostFirst = 0U;
+    uint32_t resume = 0U;
+    uint32_t count = 0U;
+
+    Start();
+    Record(20000U);
+    while (TEST_NvmErasePending() == false)
+    {
+        Record(1U);
+    }
+    lostFirst = PowerCut(3U * APP_CAN_FLASHLOG_PAGE_SIZE, powerLoss);
+
+    resume = next;
+    Record(2000U);
+    count = ReadBack();
+    TEST_CHECK(count > (lostFirst - readFrame[0]));
+    (void)CheckRun(count, CheckRun(count, 0U, readFrame[0], lostFirst), resume, next);
+    CheckNvm();
+}
+
+/* Power cuts at random points. Every frame which had reached the flash
+   and was not overwritten since must be read back, in order. */
+static void TestPowerCuts(void)
+{
+    uint32_t round = 0U;
+    uint32_t index = 0U;
+    uint32_t count = 0U;
+    uint32_t expected = 0U;
+    uint32_t gaps = 0U;
+
+    Start();
+    for (round = 0U; round < POWER_CUTS; round++)
+    {
+        Record(TEST_RandomBelow(3000U));
+        for (index = TEST_RandomBelow(50U); index > 0U; index--)
+        {
+            APP_CAN_FlashLogTasks();
+        }
+        (void)PowerCut(TEST_RandomBelow(APP_CAN_FLASHLOG_BLOCK_SIZE), (TEST_Random() & 1U) != 0U);
+    }
+    Record(1000U);
+    count = ReadBack();
+
+    TEST_CHECK(readFrame[count - 1U] == (next - 1U));
+    for (index = 0U; index < count; index++)
+    {
+        TEST_CHECK(Lost(readFrame[index]) == false);
+        if (index == 0U)
+        {
+            continue;
+        }
+        TEST_CHECK(readFrame[index] > readFrame[index - 1U]);
+        for (expected = readFrame[index - 1U] + 1U; expected < readFrame[index]; expected++)
+        {
+            gaps += Lost(expected) ? 0U : 1U;
+        }
+    }
+    TEST_CHECK(gaps == 0U);
+    CheckNvm();
+}
+
+int main(void)
+{
+    TEST_RandomSeed(14U);
+    TestWrapAround();
+    TestBufferFull();
+    TestFrozen();
+    TestErase();
+    TestPartialPage(false);
+    TestPartialPage(true);
+    TestPartialSummary(false);
+    TestPartialSummary(true);
+    TestPartialErase(false);
+    TestPartialErase(true);
+    TestPowerCuts();
+
+    printf("test_flashlog: %u failures\n", testFailures);
+    return TEST_RESULT();
+}
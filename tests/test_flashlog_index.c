@@ -0,0 +1,568 @@
+/*******************************************************************************
+  CAN Flash Recorder Block Index Host Test
+
+  File Name:
+    test_flashlog_index.c
+
+  Summary:
+    Checks the block summaries of the flash recorder and the queries which
+    use them to skip blocks.
+
+  Description:
+    Periodic traffic with a few rare IDs is recorded on the simulated NVM.
+    The summary of every complete block is compared with its pages, and the
+    frames returned by random time and ID queries must be exactly the ones a
+    filter over the whole log selects, in the same order. Covers timestamps
+    wrapping around, timestamps restarting after a reset within a block and
+    blocks with a damaged or missing summary.
+*******************************************************************************/
+
+#include <string.h>
+#include "test_common.h"
+#include "test_frame.h"
+#include "test_nvm.h"
+#include "app_can_flashlog.h"
+#include "app_can_record.h"
+
+#define TICKS_PER_MS        500U
+#define SOURCES             40U
+#define FRAMES_MAX          16384U
+#define QUERIES             300U
+/* One frame with a rare ID among this many */
+#define RARE_INTERVAL       2000U
+#define RARE_ID_BASE        0x7F0U
+
+#define PAGE_HEADER_SIZE    sizeof(APP_CAN_FLASHLOG_PAGE_HEADER)
+#define INDEX_PAGE          (APP_CAN_FLASHLOG_PAGES_PER_BLOCK - 1U)
+
+typedef struct
+{
+    uint32_t id;
+    bool xtd;
+    uint32_t period;
+    uint32_t due;
+} SOURCE;
+
+static SOURCE source[SOURCES];
+static uint32_t now = 0U;
+static uint32_t frames = 0U;
+static uint32_t rareId = 0U;
+/* The whole log, oldest first */
+static APP_CAN_RING_ENTRY logFrame[FRAMES_MAX];
+static uint32_t logCount = 0U;
+static APP_CAN_RING_ENTRY result[FRAMES_MAX];
+
+// *****************************************************************************
+// Section: Traffic
+// *****************************************************************************
+
+static void SourcesStart(void)
+{
+    uint32_t index = 0U;
+
+    for (index = 0U; index < SOURCES; index++)
+    {
+        source[index].xtd = (index % 3U) == 2U;
+        source[index].id = source[index].xtd ? (0x18FEF000UL + (index * 0x101U)) : (0x100U + (index * 9U));
+        source[index].period = (10U + TEST_RandomBelow(490U)) * TICKS_PER_MS;
+        source[index].due = now + TEST_RandomBelow(source[index].period);
+    }
+}
+
+/* Adds the next frames in time order, the main loop runs once per frame */
+static void Record(uint32_t count)
+{
+    APP_CAN_RING_ENTRY entry;
+    uint8_t data[8];
+    uint32_t index = 0U;
+    uint32_t pick = 0U;
+
+    while (count-- > 0U)
+    {
+        pick = 0U;
+        for (index = 1U; index < SOURCES; index++)
+        {
+            pick = ((int32_t)(source[index].due - source[pick].due) < 0) ? index : pick;
+        }
+        now = source[pick].due;
+        source[pick].due += source[pick].period - (TICKS_PER_MS / 2U) + TEST_RandomBelow(TICKS_PER_MS);
+        for (index = 0U; index < sizeof(data); index++)
+        {
+            data[index] = (uint8_t)TEST_Random();
+        }
+        if ((++frames % RARE_INTERVAL) == 0U)
+        {
+            TEST_FrameMake(&entry, now, RARE_ID_BASE + (rareId++ % 8U), false, 8U, false, false, false, false, data);
+        }
+        else
+        {
+            TEST_FrameMake(&entry, now, source[pick].id, source[pick].xtd, 8U, false, false, false, false, data);
+        }
+        APP_CAN_FlashLogFrameAdd(&entry);
+        APP_CAN_FlashLogTasks();
+    }
+}
+
+static void Drain(void)
+{
+    uint32_t polls = 0U;
+
+    while ((APP_CAN_FlashLogIdle() == false) && (polls < 1000000U))
+    {
+        APP_CAN_FlashLogTasks();
+        polls++;
+    }
+    TEST_CHECK(APP_CAN_FlashLogIdle());
+}
+
+/* Reset of the device, the checkpoint survives unless power is lost */
+static void Restart(bool powerLoss)
+{
+    if (powerLoss)
+    {
+        TEST_NvmBackupClear();
+    }
+    APP_CAN_FlashLogCheckpointLoad();
+    APP_CAN_FlashLogInitialize();
+}
+
+/* Power-on with an erased log, the timestamps start at time */
+static void Start(uint32_t time)
+{
+    TEST_NvmReset();
+    now = time;
+    frames = 0U;
+    SourcesStart();
+    APP_CAN_FlashLogFreezeSet(false, 0U);
+    Restart(true);
+}
+
+/* Stops recording and runs a query, returns the frames */
+static uint32_t Read(const APP_CAN_FLASHLOG_QUERY *query, APP_CAN_RING_ENTRY *frame)
+{
+    uint32_t count = 0U;
+
+    APP_CAN_FlashLogEnable(false);
+    Drain();
+    APP_CAN_FlashLogReadStart(query);
+    while ((count < FRAMES_MAX) && APP_CAN_FlashLogFrameGet(&frame[count]))
+    {
+        APP_CAN_FlashLogFrameRelease();
+        count++;
+    }
+    TEST_CHECK(count < FRAMES_MAX);
+    return count;
+}
+
+static void CheckNvm(void)
+{
+    APP_CAN_FLASHLOG_STATUS status;
+
+    APP_CAN_FlashLogStatusGet(&status);
+    TEST_CHECK((status.errors == 0U) && (status.dropped == 0U));
+    TEST_CHECK((testNvm.overwrites == 0U) && (testNvm.collisions == 0U) && (testNvm.outOfRange == 0U));
+}
+
+static void ReadLog(void)
+{
+    logCount = Read(NULL, logFrame);
+    TEST_CHECK(APP_CAN_FlashLogBlocksSkippedGet() == 0U);
+}
+
+// *****************************************************************************
+// Section: Queries
+// *****************************************************************************
+
+static bool Match(const APP_CAN_FLASHLOG_QUERY *query, const APP_CAN_RING_ENTRY *entry)
+{
+    const CAN_RX_BUFFER *rxBuf = APP_CAN_RING_FRAME(entry);
+
+    if ((uint32_t)(entry->timestamp - query->start) > (uint32_t)(query->end - query->start))
+    {
+        return false;
+    }
+    return (query->idMatch == false) ||
+           (((rxBuf->xtd != 0U) == query->xtd) && ((rxBuf->xtd ? rxBuf->id : (rxBuf->id >> 18)) == query->id));
+}
+
+/* The query must return the frames of the log it matches, in order.
+   Returns the blocks skipped. */
+static uint32_t Query(const APP_CAN_FLASHLOG_QUERY *query)
+{
+    uint32_t count = Read(query, result);
+    uint32_t index = 0U;
+    uint32_t matched = 0U;
+    bool equal = true;
+
+    for (index = 0U; index < logCount; index++)
+    {
+        if (Match(query, &logFrame[index]))
+        {
+            equal = equal && (matched < count) && TEST_FrameEqual(&logFrame[index], &result[matched]);
+            matched++;
+        }
+    }
+    TEST_CHECK(equal && (matched == count));
+    if ((equal == false) || (matched != count))
+    {
+        printf("  query %lu to %lu, ID %lX%s: %lu frames, expected %lu\n", (unsigned long)query->start,
+               (unsigned long)query->end, (unsigned long)query->id, query->idMatch ? "" : " (any)",
+               (unsigned long)count, (unsigned long)matched);
+    }
+    return APP_CAN_FlashLogBlocksSkippedGet();
+}
+
+static void QuerySet(APP_CAN_FLASHLOG_QUERY *query, uint32_t start, uint32_t end, bool idMatch, uint32_t id, bool xtd)
+{
+    query->start = start;
+    query->end = end;
+    query->idMatch = idMatch;
+    query->id = id;
+    query->xtd = xtd;
+}
+
+/* Random queries within and around the log */
+static void QueryRandom(uint32_t rounds)
+{
+    APP_CAN_FLASHLOG_QUERY query;
+    const CAN_RX_BUFFER *rxBuf = NULL;
+    uint32_t round = 0U;
+    uint32_t first = 0U;
+    uint32_t span = 0U;
+    uint32_t pick = 0U;
+
+    for (round = 0U; (round < rounds) && (logCount > 0U); round++)
+    {
+        first = logFrame[TEST_RandomBelow(logCount)].timestamp;
+        span = (TEST_Random() & 1U) ? TEST_RandomBelow(200U * TICKS_PER_MS) : TEST_Random();
+        QuerySet(&query, first - TEST_RandomBelow(50U * TICKS_PER_MS), first + span, false, 0U, false);
+        pick = TEST_RandomBelow(4U);
+        if (pick == 1U)
+        {
+            rxBuf = APP_CAN_RING_FRAME(&logFrame[TEST_RandomBelow(logCount)]);
+            query.idMatch = true;
+            query.xtd = (rxBuf->xtd != 0U);
+            query.id = query.xtd ? rxBuf->id : (rxBuf->id >> 18);
+        }
+        else if (pick == 2U)
+        {
+            query.idMatch = true;
+            query.xtd = (TEST_Random() & 1U) != 0U;
+            query.id = query.xtd ? (TEST_Random() & 0x1FFFFFFFUL) : TEST_RandomBelow(0x800U);
+        }
+        (void)Query(&query);
+    }
+}
+
+// *****************************************************************************
+// Section: Reference view of the flash
+// *****************************************************************************
+
+static uint32_t Word(const uint8_t *raw)
+{
+    return (uint32_t)raw[0] | ((uint32_t)raw[1] << 8) | ((uint32_t)raw[2] << 16) | ((uint32_t)raw[3] << 24);
+}
+
+static uint8_t *Page(uint32_t block, uint32_t page)
+{
+    return &testNvmFlash[((block * APP_CAN_FLASHLOG_PAGES_PER_BLOCK) + page) * APP_CAN_FLASHLOG_PAGE_SIZE];
+}
+
+static bool IndexValid(uint32_t block)
+{
+    APP_CAN_FLASHLOG_BLOCK_INDEX index;
+
+    memcpy(&index, Page(block, INDEX_PAGE), sizeof(index));
+    index.crc = 0U;
+    return (index.magic == APP_CAN_FLASHLOG_INDEX_MAGIC) &&
+           (APP_CAN_RecordCrc16((const uint8_t *)&index, sizeof(index)) ==
+            ((const APP_CAN_FLASHLOG_BLOCK_INDEX *)Page(block, INDEX_PAGE))->crc);
+}
+
+/* The summary of every complete block against its pages */
+static uint32_t CheckSummaries(void)
+{
+    const APP_CAN_FLASHLOG_BLOCK_INDEX *index = NULL;
+    const APP_CAN_FLASHLOG_PAGE_HEADER *header = NULL;
+    const uint8_t *data = NULL;
+    uint32_t block = 0U;
+    uint32_t page = 0U;
+    uint32_t offset = 0U;
+    uint32_t count = 0U;
+    uint32_t first = 0U;
+    uint32_t last = 0U;
+    uint32_t timestamp = 0U;
+    uint32_t valid = 0U;
+    bool ordered = true;
+
+    for (block = 0U; block < APP_CAN_FLASHLOG_BLOCKS; block++)
+    {
+        if (IndexValid(block) == false)
+        {
+            continue;
+        }
+        index = (const APP_CAN_FLASHLOG_BLOCK_INDEX *)Page(block, INDEX_PAGE);
+        header = (const APP_CAN_FLASHLOG_PAGE_HEADER *)Page(block, 0U);
+        TEST_CHECK(index->firstSequence == header->sequence);
+
+        count = 0U;
+        ordered = true;
+        for (page = 0U; page < INDEX_PAGE; page++)
+        {
+            header = (const APP_CAN_FLASHLOG_PAGE_HEADER *)Page(block, page);
+            data = Page(block, page) + PAGE_HEADER_SIZE;
+            TEST_CHECK(header->magic == APP_CAN_FLASHLOG_MAGIC);
+            for (offset = 0U; offset < header->length; offset += (uint32_t)APP_CAN_RecordPackedSize(&data[offset]))
+            {
+                timestamp = Word(&data[offset]);
+                ordered = ordered && ((count == 0U) || ((int32_t)(timestamp - last) >= 0));
+                first = (count == 0U) ? timestamp : first;
+                last = timestamp;
+                count++;
+                /* The time range covers every frame */
+                TEST_CHECK((uint32_t)(timestamp - index->firstTimestamp) <=
+                           (uint32_t)(index->lastTimestamp - index->firstTimestamp));
+            }
+        }
+        TEST_CHECK(index->frames == count);
+        /* and is exact when the timestamps run forward over less than half
+           their range */
+        if (ordered && ((uint32_t)(last - first) < 0x80000000UL))
+        {
+            TEST_CHECK((index->firstTimestamp == first) && (index->lastTimestamp == last));
+        }
+        else if (ordered)
+        {
+            TEST_CHECK((uint32_t)(index->lastTimestamp - index->firstTimestamp) == 0xFFFFFFFFUL);
+        }
+        valid++;
+    }
+    return valid;
+}
+
+/* Ranges which end at the first or start at the last frame of a block */
+static void QueryEdges(void)
+{
+    APP_CAN_FLASHLOG_QUERY query;
+    const APP_CAN_FLASHLOG_BLOCK_INDEX *index = NULL;
+    uint32_t block = 0U;
+
+    for (block = 0U; block < APP_CAN_FLASHLOG_BLOCKS; block++)
+    {
+        if (IndexValid(block) == false)
+        {
+            continue;
+        }
+        index = (const APP_CAN_FLASHLOG_BLOCK_INDEX *)Page(block, INDEX_PAGE);
+        QuerySet(&query, index->firstTimestamp - 100U, index->firstTimestamp, false, 0U, false);
+        (void)Query(&query);
+        QuerySet(&query, index->lastTimestamp, index->lastTimestamp + 100U, false, 0U, false);
+        (void)Query(&query);
+    }
+}
+
+// *****************************************************************************
+// Section: Tests
+// *****************************************************************************
+
+/* Skipping: the number of blocks read follows the result, not the log */
+static void TestSkip(void)
+{
+    APP_CAN_FLASHLOG_QUERY query;
+    uint32_t summaries = 0U;
+    uint32_t skipped = 0U;
+    uint32_t readBytes = 0U;
+    uint32_t start = 0U;
+
+    Start(1000U * TICKS_PER_MS);
+    Record(18000U);
+    ReadLog();
+
+    /* All but the block being written and the erased one have a summary */
+    summaries = CheckSummaries();
+    TEST_CHECK(summaries >= (APP_CAN_FLASHLOG_BLOCKS - 2U));
+
+    /* An ID which is not in the log */
+    QuerySet(&query, 0U, 0xFFFFFFFFUL, true, 0x7FFU, false);
+    TEST_CHECK(Query(&query) >= (summaries - 1U));
+    QuerySet(&query, 0U, 0xFFFFFFFFUL, true, 0x100U, true);
+    TEST_CHECK(Query(&query) >= (summaries - 1U));
+
+    /* A rare ID is in a few blocks only */
+    QuerySet(&query, 0U, 0xFFFFFFFFUL, true, RARE_ID_BASE + 1U, false);
+    TEST_CHECK(Query(&query) >= (summaries - 4U));
+
+    /* A periodic ID is in every block */
+    QuerySet(&query, 0U, 0xFFFFFFFFUL, true, source[0].id, source[0].xtd);
+    TEST_CHECK(Query(&query) == 0U);
+
+    /* 100 ms in the middle of the log reads one or two blocks */
+    start = logFrame[logCount / 2U].timestamp;
+    QuerySet(&query, start, start + (100U * TICKS_PER_MS), false, 0U, false);
+    readBytes = testNvm.readBytes;
+    skipped = Query(&query);
+    readBytes = testNvm.readBytes - readBytes;
+    TEST_CHECK(skipped >= (summaries - 2U));
+    TEST_CHECK(readBytes <= ((APP_CAN_FLASHLOG_BLOCKS * sizeof(APP_CAN_FLASHLOG_BLOCK_INDEX)) +
+                             (4U * APP_CAN_FLASHLOG_BLOCK_SIZE)));
+
+    /* Before and after the log */
+    QuerySet(&query, 0U, 999U * TICKS_PER_MS, false, 0U, false);
+    TEST_CHECK(Query(&query) >= summaries);
+    QuerySet(&query, now + 1U, now + (1000U * TICKS_PER_MS), false, 0U, false);
+    TEST_CHECK(Query(&query) >= summaries);
+
+    QueryRandom(QUERIES);
+    QueryEdges();
+    CheckNvm();
+}
+
+/* Timestamps running through zero */
+static void TestWrap(void)
+{
+    APP_CAN_FLASHLOG_QUERY query;
+
+    uint32_t summaries = 0U;
+
+    Start(0U - (40000U * TICKS_PER_MS));
+    Record(18000U);
+    ReadLog();
+    summaries = CheckSummaries();
+    TEST_CHECK(summaries >= (APP_CAN_FLASHLOG_BLOCKS - 2U));
+    TEST_CHECK(logFrame[0].timestamp > logFrame[logCount - 1U].timestamp);
+
+    QuerySet(&query, 0U - (200U * TICKS_PER_MS), 200U * TICKS_PER_MS, false, 0U, false);
+    TEST_CHECK(Query(&query) >= (summaries - 2U));
+    QueryRandom(QUERIES);
+    CheckNvm();
+}
+
+/* A frame every 12.5 s: a block spans more than half the timestamp range,
+   about 2.4 hours, and is never skipped for its time */
+static void TestSparse(void)
+{
+    uint32_t index = 0U;
+
+    Start(0U);
+    for (index = 0U; index < SOURCES; index++)
+    {
+        source[index].period = 500000U * TICKS_PER_MS;
+        source[index].due = index * 12500U * TICKS_PER_MS;
+    }
+    Record(1200U);
+    ReadLog();
+    TEST_CHECK(CheckSummaries() >= 2U);
+    QueryRandom(QUERIES);
+    QueryEdges();
+    CheckNvm();
+}
+
+/* Records until the write of the given page of a block is in flight,
+   returns the block */
+static uint32_t RecordToPage(uint32_t pageInBlock)
+{
+    uint32_t address = 0U;
+
+    do
+    {
+        Record(1U);
+    } while ((TEST_NvmPendingWrite(&address) == NULL) ||
+             ((((address - APP_CAN_FLASHLOG_START) / APP_CAN_FLASHLOG_PAGE_SIZE) % APP_CAN_FLASHLOG_PAGES_PER_BLOCK) !=
+              pageInBlock));
+    return (address - APP_CAN_FLASHLOG_START) / APP_CAN_FLASHLOG_BLOCK_SIZE;
+}
+
+/* Timestamps restart after a reset, in the middle of a block. The block
+   holds frames from both sides of the reset, those after it may be older
+   and newer than those before it. */
+static void TestRestart(bool powerLoss, uint32_t startTime, uint32_t before)
+{
+    APP_CAN_FLASHLOG_QUERY query;
+    uint32_t summaries = 0U;
+
+    Start(startTime);
+    Record(before);
+    (void)RecordToPage(3U);
+    TEST_NvmPowerCut(APP_CAN_FLASHLOG_PAGE_SIZE);
+    Restart(powerLoss);
+    now = 0U;
+    SourcesStart();
+    Record(5000U);
+    ReadLog();
+    summaries = CheckSummaries();
+
+    /* Times only the frames after the reset have, and both have */
+    QuerySet(&query, 0U, startTime / 2U, false, 0U, false);
+    (void)Query(&query);
+    QuerySet(&query, 0U, startTime + (1000U * TICKS_PER_MS), false, 0U, false);
+    (void)Query(&query);
+    QuerySet(&query, 5000U * TICKS_PER_MS, 5100U * TICKS_PER_MS, false, 0U, false);
+    TEST_CHECK(Query(&query) >= (summaries - 3U));
+    QuerySet(&query, 0U, 0xFFFFFFFFUL, true, source[1].id, source[1].xtd);
+    (void)Query(&query);
+    QueryRandom(QUERIES);
+    CheckNvm();
+}
+
+/* A damaged summary, and one cut short by a power cut, make the block read */
+static void TestDamaged(void)
+{
+    APP_CAN_FLASHLOG_QUERY query;
+    APP_CAN_FLASHLOG_BLOCK_INDEX *index = NULL;
+    uint32_t summaries = 0U;
+    uint32_t skipped = 0U;
+    uint32_t block = 0U;
+
+    Start(1000U * TICKS_PER_MS);
+    Record(18000U);
+    ReadLog();
+    summaries = CheckSummaries();
+    QuerySet(&query, 0U, 0xFFFFFFFFUL, true, 0x7FFU, false);
+    skipped = Query(&query);
+    TEST_CHECK(skipped >= (summaries - 1U));
+
+    /* Bloom filter bits lost in one summary, and a wrong frame count in
+       another: the CRC no longer matches */
+    for (block = 0U; (block < (APP_CAN_FLASHLOG_BLOCKS - 1U)) && (IndexValid(block) == false); block++)
+    {
+    }
+    index = (APP_CAN_FLASHLOG_BLOCK_INDEX *)Page(block, INDEX_PAGE);
+    memset(index->bloom, 0, sizeof(index->bloom));
+    for (block++; (block < (APP_CAN_FLASHLOG_BLOCKS - 1U)) && (IndexValid(block) == false); block++)
+    {
+    }
+    index = (APP_CAN_FLASHLOG_BLOCK_INDEX *)Page(block, INDEX_PAGE);
+    index->frames = 0U;
+    TEST_CHECK(CheckSummaries() == (summaries - 2U));
+    TEST_CHECK(Query(&query) == (skipped - 2U));
+    QuerySet(&query, 0U, 0xFFFFFFFFUL, true, source[0].id, source[0].xtd);
+    (void)Query(&query);
+    QueryRandom(QUERIES / 4U);
+
+    /* Power cut while a summary is written */
+    APP_CAN_FlashLogEnable(true);
+    block = RecordToPage(INDEX_PAGE);
+    TEST_NvmPowerCut(64U);
+    Restart(false);
+    Record(3000U);
+    ReadLog();
+    TEST_CHECK(IndexValid(block) == false);
+    TEST_CHECK(((const APP_CAN_FLASHLOG_PAGE_HEADER *)Page(block, 0U))->magic == APP_CAN_FLASHLOG_MAGIC);
+    QueryRandom(QUERIES / 4U);
+    CheckNvm();
+}
+
+int main(void)
+{
+    TEST_RandomSeed(15U);
+    TestSkip();
+    TestWrap();
+    TestSparse();
+    TestRestart(false, 300U * TICKS_PER_MS, 0U);
+    TestRestart(true, 300U * TICKS_PER_MS, 0U);
+    TestRestart(false, 10000U * TICKS_PER_MS, 6000U);
+    TestDamaged();
+
+    printf("test_flashlog_index: %u failures\n", testFailures);
+    return TEST_RESULT();
+}
@@ -0,0 +1,163 @@
+/*******************************************************************************
+  candump Line Formatter Host Test
+
+  File Name:
+    test_format.c
+
+  Summary:
+    Compares the table driven line formatter with the same line written by
+    snprintf.
+
+  Description:
+    Covers the ends of the timestamp range, every DLC of classical and CAN FD
+    frames, the ends of the standard and extended ID ranges, every flag
+    combination and random frames.
+*******************************************************************************/
+
+#include <string.h>
+#include "test_common.h"
+#include "test_frame.h"
+#include "app_can_format.h"
+
+#define ROUNDS              20000U
+
+/* The line as the former sprintf based output path wrote it */
+static size_t ReferenceLine(const APP_CAN_RING_ENTRY *entry, char *line, size_t size)
+{
+    const CAN_RX_BUFFER *rxBuf = APP_CAN_RING_FRAME(entry);
+    unsigned long seconds = entry->timestamp / APP_CAN_FORMAT_TICKS_PER_SECOND;
+    unsigned long micros = (entry->timestamp % APP_CAN_FORMAT_TICKS_PER_SECOND) *
+                           (1000000UL / APP_CAN_FORMAT_TICKS_PER_SECOND);
+    uint32_t index = 0U;
+    int length = 0;
+
+    length = snprintf(line, size, "(%010lu.%06lu) can1 ", seconds, micros);
+    if (rxBuf->xtd)
+    {
+        length += snprintf(&line[length], size - (size_t)length, "%08lX", (unsigned long)rxBuf->id);
+    }
+    else
+    {
+        length += snprintf(&line[length], size - (size_t)length, "%03lX", (unsigned long)(rxBuf->id >> 18));
+    }
+    if (rxBuf->fdf)
+    {
+        length += snprintf(&line[length], size - (size_t)length, "##%X",
+                           (rxBuf->brs ? 1U : 0U) | (rxBuf->esi ? 2U : 0U));
+    }
+    else if (rxBuf->rtr)
+    {
+        length += snprintf(&line[length], size - (size_t)length, "#R");
+    }
+    else
+    {
+        length += snprintf(&line[length], size - (size_t)length, "#");
+    }
+    for (index = 0U; index < TEST_FrameLength(entry); index++)
+    {
+        length += snprintf(&line[length], size - (size_t)length, "%02X", entry->element[8U + index]);
+    }
+    length += snprintf(&line[length], size - (size_t)length, "\r\n");
+    return (size_t)length;
+}
+
+static void CheckLine(const APP_CAN_RING_ENTRY *entry)
+{
+    char line[APP_CAN_FORMAT_LINE_MAX + 1U];
+    char expected[512];
+    size_t length = 0U;
+    size_t expectedLength = 0U;
+
+    memset(line, '?', sizeof(line));
+    length = APP_CAN_FormatLine(entry, line);
+    expectedLength = ReferenceLine(entry, expected, sizeof(expected));
+
+    TEST_CHECK(length <= APP_CAN_FORMAT_LINE_MAX);
+    TEST_CHECK(line[APP_CAN_FORMAT_LINE_MAX] == '?');
+    TEST_CHECK((length == expectedLength) && (memcmp(line, expected, length) == 0));
+    if ((length != expectedLength) || (memcmp(line, expected, length) != 0))
+    {
+        printf("  got      %.*s  expected %s", (int)length, line, expected);
+    }
+}
+
+static void TestBoundaries(void)
+{
+    static const uint32_t timestamp[] =
+    {
+        0U, 1U, APP_CAN_FORMAT_TICKS_PER_SECOND - 1U, APP_CAN_FORMAT_TICKS_PER_SECOND,
+        (100U * APP_CAN_FORMAT_TICKS_PER_SECOND) - 1U, 0x7FFFFFFFUL, 0xFFFFFFFEUL, 0xFFFFFFFFUL
+    };
+    static const uint32_t stdId[] = { 0U, 1U, 0x0FFU, 0x100U, 0x7FFU };
+    static const uint32_t extId[] = { 0U, 0x7FFU, 0x800U, 0x0FFFFFFFUL, 0x10000000UL, 0x1FFFFFFFUL };
+    APP_CAN_RING_ENTRY entry;
+    uint8_t data[64];
+    uint32_t index = 0U;
+    uint32_t dlc = 0U;
+    uint32_t flags = 0U;
+
+    for (index = 0U; index < sizeof(data); index++)
+    {
+        data[index] = (uint8_t)((index * 0x11U) ^ 0xF0U);
+    }
+    data[0] = 0x00U;
+    data[1] = 0xFFU;
+
+    for (index = 0U; index < (sizeof(timestamp) / sizeof(timestamp[0])); index++)
+    {
+        TEST_FrameMake(&entry, timestamp[index], 0x123U, false, 8U, false, false, false, false, data);
+        CheckLine(&entry);
+    }
+    for (index = 0U; index < (sizeof(stdId) / sizeof(stdId[0])); index++)
+    {
+        TEST_FrameMake(&entry, 0xFFFFFFFFUL, stdId[index], false, 1U, false, false, false, false, data);
+        CheckLine(&entry);
+        TEST_FrameMake(&entry, 0U, stdId[index], false, 0U, false, false, false, true, NULL);
+        CheckLine(&entry);
+    }
+    for (index = 0U; index < (sizeof(extId) / sizeof(extId[0])); index++)
+    {
+        TEST_FrameMake(&entry, 0U, extId[index], true, 2U, false, false, false, false, data);
+        CheckLine(&entry);
+        TEST_FrameMake(&entry, 0U, extId[index], true, 15U, true, true, true, false, data);
+        CheckLine(&entry);
+    }
+
+    /* Every DLC, classical and FD with every flag */
+    for (dlc = 0U; dlc < 16U; dlc++)
+    {
+        if (dlc <= 8U)
+        {
+            TEST_FrameMake(&entry, 0xFFFFFFFFUL, 0x7FFU, false, dlc, false, false, false, false, data);
+            CheckLine(&entry);
+        }
+        for (flags = 0U; flags < 4U; flags++)
+        {
+            TEST_FrameMake(&entry, 0xFFFFFFFFUL, 0x1FFFFFFFUL, true, dlc, true, (flags & 1U) != 0U,
+                           (flags & 2U) != 0U, false, data);
+            CheckLine(&entry);
+        }
+    }
+}
+
+static void TestRandom(void)
+{
+    APP_CAN_RING_ENTRY entry;
+    uint32_t round = 0U;
+
+    for (round = 0U; round < ROUNDS; round++)
+    {
+        TEST_FrameRandom(&entry, TEST_Random());
+        CheckLine(&entry);
+    }
+}
+
+int main(void)
+{
+    TEST_RandomSeed(6U);
+    TestBoundaries();
+    TestRandom();
+
+    printf("test_format: %u failures\n", testFailures);
+    return TEST_RESULT();
+}
@@ -0,0 +1,80 @@
+/*******************************************************************************
+  Host Test Frames
+
+  File Name:
+    test_frame.h
+
+  Summary:
+    Builds captured frames as the CAN1 Rx path stores them in the ring.
+*******************************************************************************/
+
+#ifndef TEST_FRAME_H
+#define TEST_FRAME_H
+
+#include <string.h>
+#include "test_common.h"
+#include "app_can_ring.h"
+
+static const uint8_t testDlcLength[16] = {0U, 1U, 2U, 3U, 4U, 5U, 6U, 7U, 8U, 12U, 16U, 20U, 24U, 32U, 48U, 64U};
+
+/* Standard IDs are stored in id[28:18], as in Message RAM */
+static inline void TEST_FrameMake(APP_CAN_RING_ENTRY *entry, uint32_t timestamp, uint32_t id, bool xtd,
+                                  uint32_t dlc, bool fdf, bool brs, bool esi, bool rtr, const uint8_t *data)
+{
+    CAN_RX_BUFFER *rxBuf = APP_CAN_RING_FRAME(entry);
+
+    memset(entry, 0, sizeof(*entry));
+    entry->timestamp = timestamp;
+    entry->source = xtd ? (uint8_t)APP_CAN_RX_SOURCE_FIFO1 : (uint8_t)APP_CAN_RX_SOURCE_FIFO0;
+    rxBuf->id = xtd ? id : (id << 18);
+    rxBuf->xtd = xtd ? 1U : 0U;
+    rxBuf->rtr = rtr ? 1U : 0U;
+    rxBuf->esi = esi ? 1U : 0U;
+    rxBuf->rxts = (uint16_t)timestamp;
+    rxBuf->dlc = dlc & 0x0FU;
+    rxBuf->fdf = fdf ? 1U : 0U;
+    rxBuf->brs = brs ? 1U : 0U;
+    if ((data != NULL) && !rtr)
+    {
+        memcpy(&entry->element[8], data, testDlcLength[dlc & 0x0FU]);
+    }
+}
+
+/* A random frame: classical or FD, standard or extended, any DLC */
+static inline void TEST_FrameRandom(APP_CAN_RING_ENTRY *entry, uint32_t timestamp)
+{
+    uint8_t data[64];
+    uint32_t index = 0U;
+    bool xtd = (TEST_Random() & 1U) != 0U;
+    bool fdf = (TEST_Random() & 1U) != 0U;
+    uint32_t dlc = fdf ? TEST_RandomBelow(16U) : TEST_RandomBelow(9U);
+
+    for (index = 0U; index < sizeof(data); index++)
+    {
+        data[index] = (uint8_t)TEST_Random();
+    }
+    TEST_FrameMake(entry, timestamp, xtd ? (TEST_Random() & 0x1FFFFFFFUL) : TEST_RandomBelow(0x800U), xtd, dlc,
+                   fdf, fdf && ((TEST_Random() & 1U) != 0U), (TEST_RandomBelow(8U) == 0U),
+                   !fdf && (TEST_RandomBelow(8U) == 0U), data);
+}
+
+/* Payload bytes of a frame */
+static inline uint32_t TEST_FrameLength(const APP_CAN_RING_ENTRY *entry)
+{
+    const CAN_RX_BUFFER *rxBuf = APP_CAN_RING_FRAME(entry);
+
+    return rxBuf->rtr ? 0U : testDlcLength[rxBuf->dlc];
+}
+
+/* Same frame, header fields and valid payload bytes */
+static inline bool TEST_FrameEqual(const APP_CAN_RING_ENTRY *a, const APP_CAN_RING_ENTRY *b)
+{
+    const CAN_RX_BUFFER *x = APP_CAN_RING_FRAME(a);
+    const CAN_RX_BUFFER *y = APP_CAN_RING_FRAME(b);
+
+    return (a->timestamp == b->timestamp) && (x->id == y->id) && (x->xtd == y->xtd) && (x->rtr == y->rtr) &&
+           (x->esi == y->esi) && (x->dlc == y->dlc) && (x->fdf == y->fdf) && (x->brs == y->brs) &&
+           (memcmp(&a->element[8], &b->element[8], TEST_FrameLength(a)) == 0);
+}
+
+#endif /* TEST_FRAME_H */
@@ -0,0 +1,206 @@
+/*******************************************************************************
+  Bus Load Host Test
+
+  File Name:
+    test_load.c
+
+  Summary:
+    Checks the bus load figures for the same traffic under every bit rate
+    profile.
+
+  Description:
+    The profiles are set with APP_CAN_BitRateProfileSet, the CAN1 stub below
+    puts their bit timing into NBTP and DBTP as the peripheral library does.
+    The traffic is a mix of classic and CAN FD frames spaced in bit times, so
+    it keeps the bus busy for the same share of the time whatever the bit
+    rate, and its timestamps are in extended timestamp ticks, which do not
+    depend on the bit timing. Every profile must then give the same load.
+*******************************************************************************/
+
+#include <string.h>
+#include "test_common.h"
+#include "test_frame.h"
+#include "app_can_load.h"
+#include "app_can_bitrate.h"
+#include "app_can_format.h"
+
+#define RUN_SECONDS             10.5
+
+/* A frame of the mix with its worst case length in the load model:
+   nominal bits, and data phase bits for bit rate switching */
+typedef struct
+{
+    bool xtd;
+    bool fdf;
+    bool brs;
+    uint8_t dlc;
+    uint32_t nominalBits;
+    uint32_t dataBits;
+} FRAME_KIND;
+
+static const FRAME_KIND frameKinds[] =
+{
+    /* 34 + 64 bits, 24 stuff bits, 13 bits trailer */
+    { false, false, false, 8U, 135U, 0U },
+    /* 54 + 64 bits, 29 stuff bits, 13 bits trailer */
+    { true, false, false, 8U, 160U, 0U },
+    /* 17 + 4 + 12 bits arbitration, 517 + 129 stuff + 4 + 21 + 1 + 6 + 1
+       bits data phase */
+    { false, true, false, 15U, 712U, 0U },
+    { false, true, true, 15U, 33U, 679U },
+    /* 5 + 1 stuff + 4 + 17 + 1 + 5 + 1 bits data phase */
+    { false, true, true, 0U, 33U, 34U },
+};
+
+#define FRAME_KINDS             (sizeof(frameKinds) / sizeof(frameKinds[0]))
+
+can_registers_t hostCan1Regs;
+
+// *****************************************************************************
+// Section: CAN1 Peripheral Library Stubs
+// *****************************************************************************
+
+bool CAN1_BitTimingSet(const CAN_BIT_TIMING *bitTiming)
+{
+    const CAN_NOMINAL_BIT_TIMING *nominal = &bitTiming->nominalBitTiming;
+    const CAN_DATA_BIT_TIMING *data = &bitTiming->dataBitTiming;
+
+    hostCan1Regs.CAN_NBTP = CAN_NBTP_NBRP((uint32_t)nominal->nominalBaudRatePrescaler) |
+                            CAN_NBTP_NTSEG1((uint32_t)nominal->nominalTimeSegment1) |
+                            CAN_NBTP_NTSEG2((uint32_t)nominal->nominalTimeSegment2) |
+                            CAN_NBTP_NSJW((uint32_t)nominal->nominalSJW);
+    hostCan1Regs.CAN_DBTP = CAN_DBTP_DBRP((uint32_t)data->dataBaudRatePrescaler) |
+                            CAN_DBTP_DTSEG1((uint32_t)data->dataTimeSegment1) |
+                            CAN_DBTP_DTSEG2((uint32_t)data->dataTimeSegment2) |
+                            CAN_DBTP_DSJW((uint32_t)data->dataSJW);
+    return true;
+}
+
+void CAN1_ProtocolErrorCountGet(uint32_t *nominalErrorCount, uint32_t *dataErrorCount)
+{
+    *nominalErrorCount = 0U;
+    *dataErrorCount = 0U;
+}
+
+uint32_t CAN1_RxTimestampExtend(uint16_t rxts)
+{
+    return rxts;
+}
+
+void CAN1_BusMonitoringSet(bool enable)
+{
+    (void)enable;
+}
+
+bool CAN1_BusMonitoringGet(void)
+{
+    return false;
+}
+
+// *****************************************************************************
+// Section: Tests
+// *****************************************************************************
+
+static uint32_t LoadUnits(double share)
+{
+    return (uint32_t)((share * 10000.0) + 0.5);
+}
+
+static bool Near(uint32_t value, uint32_t expected, uint32_t tolerance)
+{
+    return (value <= (expected + tolerance)) && ((value + tolerance) >= expected);
+}
+
+/* The mix at duty percent of the bus time, every frame followed by idle
+   time in proportion to its own length */
+static void TestProfile(uint32_t profile, uint32_t duty)
+{
+    APP_CAN_RING_ENTRY entry;
+    APP_CAN_LOAD load;
+    uint8_t data[64];
+    double nominalRate = (double)APP_CAN_BitRateNominalGet(profile);
+    double dataRate = (double)APP_CAN_BitRateDataGet(profile);
+    double kindTime[FRAME_KINDS];
+    double arbitrationTime = 0.0;
+    double dataTime = 0.0;
+    double period = 0.0;
+    double now = 0.0;
+    double longest = 0.0;
+    uint32_t tolerance = 0U;
+    uint32_t kind = 0U;
+    uint32_t window = 0U;
+    const double windowSeconds[] = { 0.1, 1.0, 10.0 };
+
+    memset(data, 0x55, sizeof(data));
+    TEST_CHECK(APP_CAN_BitRateProfileSet(profile));
+    APP_CAN_LoadInitialize();
+
+    for (kind = 0U; kind < FRAME_KINDS; kind++)
+    {
+        kindTime[kind] = ((double)frameKinds[kind].nominalBits / nominalRate) +
+                         ((double)frameKinds[kind].dataBits / dataRate);
+        arbitrationTime += (double)frameKinds[kind].nominalBits / nominalRate;
+        dataTime += (double)frameKinds[kind].dataBits / dataRate;
+        longest = (kindTime[kind] > longest) ? kindTime[kind] : longest;
+    }
+    period = ((arbitrationTime + dataTime) * 100.0) / (double)duty;
+
+    kind = 0U;
+    while (now < RUN_SECONDS)
+    {
+        TEST_FrameMake(&entry, (uint32_t)(now * (double)APP_CAN_FORMAT_TICKS_PER_SECOND), 0x123U,
+                       frameKinds[kind].xtd, frameKinds[kind].dlc, frameKinds[kind].fdf, frameKinds[kind].brs,
+                       false, false, data);
+        APP_CAN_LoadFrameAdd(&entry);
+        now += (kindTime[kind] * 100.0) / (double)duty;
+        kind = (kind + 1U) % FRAME_KINDS;
+    }
+    APP_CAN_LoadAdvance((uint32_t)(now * (double)APP_CAN_FORMAT_TICKS_PER_SECOND));
+
+    for (window = 0U; window < 3U; window++)
+    {
+        APP_CAN_LoadGet((APP_CAN_LOAD_WINDOW)window, &load);
+        /* A frame more or less at each end of the window, and rounding */
+        tolerance = LoadUnits((2.0 * longest) / windowSeconds[window]) + 2U;
+        TEST_CHECK(Near(load.total, duty * 100U, tolerance));
+        TEST_CHECK(Near(load.arbitration, LoadUnits((arbitrationTime / period)), tolerance));
+        TEST_CHECK(Near(load.data, LoadUnits((dataTime / period)), tolerance));
+        TEST_CHECK(load.total == (load.arbitration + load.data));
+    }
+}
+
+/* A frame takes its worst case length in ticks at every profile */
+static void TestFrameTicks(uint32_t profile)
+{
+    double nominalRate = (double)APP_CAN_BitRateNominalGet(profile);
+    double dataRate = (double)APP_CAN_BitRateDataGet(profile);
+    double ticks = 0.0;
+    uint32_t kind = 0U;
+    static const uint8_t dlcLength[16] = {0U, 1U, 2U, 3U, 4U, 5U, 6U, 7U, 8U, 12U, 16U, 20U, 24U, 32U, 48U, 64U};
+
+    TEST_CHECK(APP_CAN_BitRateProfileSet(profile));
+    APP_CAN_LoadInitialize();
+    for (kind = 0U; kind < FRAME_KINDS; kind++)
+    {
+        ticks = (((double)frameKinds[kind].nominalBits / nominalRate) +
+                 ((double)frameKinds[kind].dataBits / dataRate)) * (double)APP_CAN_FORMAT_TICKS_PER_SECOND;
+        TEST_CHECK(APP_CAN_LoadFrameTicksGet(frameKinds[kind].xtd, frameKinds[kind].fdf, frameKinds[kind].brs,
+                                             dlcLength[frameKinds[kind].dlc]) == (uint32_t)(ticks + 1.0e-6));
+    }
+}
+
+int main(void)
+{
+    uint32_t profile = 0U;
+
+    TEST_RandomSeed(18U);
+    for (profile = 0U; profile < APP_CAN_BITRATE_PROFILES; profile++)
+    {
+        TestFrameTicks(profile);
+        TestProfile(profile, 100U);
+        TestProfile(profile, 35U);
+    }
+
+    printf("test_load: %u failures\n", testFailures);
+    return TEST_RESULT();
+}
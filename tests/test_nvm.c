@@ -0,0 +1,235 @@
+/*******************************************************************************
+  Host Test NVM
+
+  File Name:
+    test_nvm.c
+
+  Summary:
+    Simulated NVMCTRL and RTC backup registers for the flash recorder tests.
+*******************************************************************************/
+
+#include <string.h>
+#include "definitions.h"
+#include "test_nvm.h"
+
+#define TEST_NVM_ERASE_TIME     40U
+#define TEST_NVM_WRITE_TIME     3U
+#define TEST_NVM_BACKUP_WORDS   8U
+
+typedef enum
+{
+    TEST_NVM_IDLE,
+    TEST_NVM_WRITE,
+    TEST_NVM_ERASE
+} TEST_NVM_OPERATION;
+
+TEST_NVM testNvm;
+uint8_t testNvmFlash[APP_CAN_FLASHLOG_SIZE];
+nvmctrl_registers_t hostNvmctrlRegs;
+
+static uint32_t testNvmPageBuffer[NVMCTRL_FLASH_PAGESIZE / 4U];
+static TEST_NVM_OPERATION testNvmOperation = TEST_NVM_IDLE;
+static uint32_t testNvmOffset = 0U;
+static uint32_t testNvmBusy = 0U;
+static uint16_t testNvmError = 0U;
+/* Block of the last erase, -1 after any other operation */
+static int32_t testNvmErasedBlock = -1;
+static uint32_t testNvmBackup[TEST_NVM_BACKUP_WORDS];
+
+/* Offset in the log area, false if the range is outside or not aligned */
+static bool TEST_NvmOffset(uint32_t address, uint32_t alignment, uint32_t *offset)
+{
+    if ((address < APP_CAN_FLASHLOG_START) || ((address - APP_CAN_FLASHLOG_START) >= APP_CAN_FLASHLOG_SIZE) ||
+        ((address % alignment) != 0U))
+    {
+        testNvm.outOfRange++;
+        return false;
+    }
+    *offset = address - APP_CAN_FLASHLOG_START;
+    return true;
+}
+
+static bool TEST_NvmStart(TEST_NVM_OPERATION operation, uint32_t offset, uint32_t time)
+{
+    if (testNvmOperation != TEST_NVM_IDLE)
+    {
+        testNvm.collisions++;
+        return false;
+    }
+    testNvmOperation = operation;
+    testNvmOffset = offset;
+    testNvmBusy = time;
+    return true;
+}
+
+/* Programs the first bytes of the page write in flight */
+static void TEST_NvmProgram(uint32_t bytes)
+{
+    const uint8_t *data = (const uint8_t *)testNvmPageBuffer;
+    uint32_t index = 0U;
+
+    for (index = 0U; index < bytes; index++)
+    {
+        if ((data[index] & ~testNvmFlash[testNvmOffset + index]) != 0U)
+        {
+            testNvm.overwrites++;
+            testNvmError |= NVMCTRL_INTFLAG_PROGE_Msk;
+        }
+        testNvmFlash[testNvmOffset + index] &= data[index];
+    }
+}
+
+static void TEST_NvmComplete(void)
+{
+    if (testNvmOperation == TEST_NVM_WRITE)
+    {
+        TEST_NvmProgram(NVMCTRL_FLASH_PAGESIZE);
+        testNvm.writes++;
+        if (((testNvmOffset % NVMCTRL_FLASH_BLOCKSIZE) == 0U) &&
+            (testNvmErasedBlock == (int32_t)(testNvmOffset / NVMCTRL_FLASH_BLOCKSIZE)))
+        {
+            testNvm.entryErases++;
+        }
+        testNvmErasedBlock = -1;
+    }
+    else if (testNvmOperation == TEST_NVM_ERASE)
+    {
+        memset(&testNvmFlash[testNvmOffset], 0xFF, NVMCTRL_FLASH_BLOCKSIZE);
+        testNvm.erases++;
+        testNvmErasedBlock = (int32_t)(testNvmOffset / NVMCTRL_FLASH_BLOCKSIZE);
+    }
+    testNvmOperation = TEST_NVM_IDLE;
+}
+
+void TEST_NvmReset(void)
+{
+    memset(&testNvm, 0, sizeof(testNvm));
+    testNvm.eraseTime = TEST_NVM_ERASE_TIME;
+    testNvm.writeTime = TEST_NVM_WRITE_TIME;
+    memset(testNvmFlash, 0xFF, sizeof(testNvmFlash));
+    memset(testNvmPageBuffer, 0xFF, sizeof(testNvmPageBuffer));
+    memset(&hostNvmctrlRegs, 0, sizeof(hostNvmctrlRegs));
+    testNvmOperation = TEST_NVM_IDLE;
+    testNvmError = 0U;
+    testNvmErasedBlock = -1;
+    TEST_NvmBackupClear();
+}
+
+const uint8_t *TEST_NvmPendingWrite(uint32_t *address)
+{
+    if (testNvmOperation != TEST_NVM_WRITE)
+    {
+        return NULL;
+    }
+    *address = APP_CAN_FLASHLOG_START + testNvmOffset;
+    return (const uint8_t *)testNvmPageBuffer;
+}
+
+bool TEST_NvmErasePending(void)
+{
+    return (testNvmOperation == TEST_NVM_ERASE);
+}
+
+void TEST_NvmPowerCut(uint32_t bytes)
+{
+    if (testNvmOperation == TEST_NVM_WRITE)
+    {
+        TEST_NvmProgram((bytes < NVMCTRL_FLASH_PAGESIZE) ? bytes : NVMCTRL_FLASH_PAGESIZE);
+    }
+    else if (testNvmOperation == TEST_NVM_ERASE)
+    {
+        bytes -= bytes % NVMCTRL_FLASH_PAGESIZE;
+        memset(&testNvmFlash[testNvmOffset], 0xFF, (bytes < NVMCTRL_FLASH_BLOCKSIZE) ? bytes : NVMCTRL_FLASH_BLOCKSIZE);
+    }
+    testNvmOperation = TEST_NVM_IDLE;
+    testNvmErasedBlock = -1;
+    testNvmError = 0U;
+    memset(testNvmPageBuffer, 0xFF, sizeof(testNvmPageBuffer));
+}
+
+void TEST_NvmBackupClear(void)
+{
+    memset(testNvmBackup, 0, sizeof(testNvmBackup));
+}
+
+// *****************************************************************************
+// Section: Peripheral library functions
+// *****************************************************************************
+
+void NVMCTRL_SetWriteMode(NVMCTRL_WRITEMODE mode)
+{
+    (void)mode;
+}
+
+bool NVMCTRL_Read(uint32_t *data, uint32_t length, uint32_t address)
+{
+    if ((address < APP_CAN_FLASHLOG_START) || ((address - APP_CAN_FLASHLOG_START) > (APP_CAN_FLASHLOG_SIZE - length)))
+    {
+        testNvm.outOfRange++;
+        return false;
+    }
+    memcpy(data, &testNvmFlash[address - APP_CAN_FLASHLOG_START], length);
+    testNvm.readBytes += length;
+    return true;
+}
+
+bool NVMCTRL_PageBufferWrite(uint32_t *data, const uint32_t address)
+{
+    uint32_t offset = 0U;
+
+    if (TEST_NvmOffset(address, NVMCTRL_FLASH_PAGESIZE, &offset) == false)
+    {
+        return false;
+    }
+    memcpy(testNvmPageBuffer, data, sizeof(testNvmPageBuffer));
+    return true;
+}
+
+bool NVMCTRL_PageBufferCommit(const uint32_t address)
+{
+    uint32_t offset = 0U;
+
+    return TEST_NvmOffset(address, NVMCTRL_FLASH_PAGESIZE, &offset) &&
+           TEST_NvmStart(TEST_NVM_WRITE, offset, testNvm.writeTime);
+}
+
+bool NVMCTRL_BlockErase(uint32_t address)
+{
+    uint32_t offset = 0U;
+
+    return TEST_NvmOffset(address, NVMCTRL_FLASH_BLOCKSIZE, &offset) &&
+           TEST_NvmStart(TEST_NVM_ERASE, offset, testNvm.eraseTime);
+}
+
+uint16_t NVMCTRL_ErrorGet(void)
+{
+    uint16_t error = testNvmError;
+
+    testNvmError = 0U;
+    return error;
+}
+
+bool NVMCTRL_IsBusy(void)
+{
+    if (testNvmOperation == TEST_NVM_IDLE)
+    {
+        return false;
+    }
+    if (testNvmBusy > 0U)
+    {
+        testNvmBusy--;
+        return true;
+    }
+    TEST_NvmComplete();
+    return false;
+}
+
+uint32_t RTC_BackupRegisterGet(BACKUP_REGISTER reg)
+{
+    return testNvmBackup[reg];
+}
+
+void RTC_BackupRegisterSet(BACKUP_REGISTER reg, uint32_t value)
+{
+    testNvmBackup[reg] = value;
+}
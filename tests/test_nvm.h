@@ -0,0 +1,63 @@
+/*******************************************************************************
+  Host Test NVM
+
+  File Name:
+    test_nvm.h
+
+  Summary:
+    Simulated flash of the log area and RTC backup registers behind the
+    NVMCTRL and RTC peripheral library functions used by the flash recorder.
+
+  Description:
+    Erases and page writes take a number of NVMCTRL_IsBusy polls and reach
+    the flash when they complete, so a power cut can leave the page or block
+    in flight partly written. Programming can only clear bits, as on the
+    device.
+*******************************************************************************/
+
+#ifndef TEST_NVM_H
+#define TEST_NVM_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "app_can_flashlog.h"
+
+typedef struct
+{
+    /* Polls of NVMCTRL_IsBusy an operation takes */
+    uint32_t eraseTime;
+    uint32_t writeTime;
+    uint32_t erases;
+    uint32_t writes;
+    uint32_t readBytes;
+    /* Erases of a block right before the write of its first page, the ones
+       not done ahead of time */
+    uint32_t entryErases;
+    /* Writes which would have to set a cleared bit */
+    uint32_t overwrites;
+    /* Operations started while another one was in flight */
+    uint32_t collisions;
+    /* Writes and erases outside the log area or not aligned */
+    uint32_t outOfRange;
+} TEST_NVM;
+
+extern TEST_NVM testNvm;
+/* Contents of the log area */
+extern uint8_t testNvmFlash[APP_CAN_FLASHLOG_SIZE];
+
+/* Erased log area, cleared backup registers and counters, default timing */
+void TEST_NvmReset(void);
+
+/* The page write in flight and its address, NULL if there is none */
+const uint8_t *TEST_NvmPendingWrite(uint32_t *address);
+bool TEST_NvmErasePending(void);
+
+/* Ends the operation in flight as a power cut would: only the first bytes
+   of a page write are programmed, only the pages of a block erase before
+   bytes / page size are erased */
+void TEST_NvmPowerCut(uint32_t bytes);
+
+/* Loss of the RTC backup registers with the supply */
+void TEST_NvmBackupClear(void);
+
+#endif /* TEST_NVM_H */
@@ -0,0 +1,244 @@
+/*******************************************************************************
+  Binary Record Encoder Host Test
+
+  File Name:
+    test_record.c
+
+  Summary:
+    Round trip of captured frames through the binary record encoder and
+    decoder.
+
+  Description:
+    Every record is also decoded by an independent COBS decoder and a bitwise
+    CRC, and parsed field by field as documented in the README, so a change
+    of the format breaks the test rather than passing both directions.
+*******************************************************************************/
+
+#include <string.h>
+#include "test_common.h"
+#include "test_frame.h"
+#include "app_can_record.h"
+
+#define ROUNDS              20000U
+
+/* Record overhead: two delimiters, the COBS code byte, 9 header and 2 CRC bytes */
+#define RECORD_OVERHEAD     14U
+
+static uint16_t ReferenceCrc16(const uint8_t *data, size_t length)
+{
+    uint16_t crc = 0xFFFFU;
+    size_t index = 0U;
+    uint32_t bit = 0U;
+
+    for (index = 0U; index < length; index++)
+    {
+        crc ^= (uint16_t)data[index] << 8;
+        for (bit = 0U; bit < 8U; bit++)
+        {
+            crc = ((crc & 0x8000U) != 0U) ? (uint16_t)((crc << 1) ^ 0x1021U) : (uint16_t)(crc << 1);
+        }
+    }
+    return crc;
+}
+
+/* Decodes the bytes between the delimiters, 0 when the encoding is invalid */
+static size_t ReferenceCobsDecode(const uint8_t *input, size_t length, uint8_t *output)
+{
+    size_t in = 0U;
+    size_t out = 0U;
+    uint8_t code = 0U;
+    uint8_t index = 0U;
+
+    while (in < length)
+    {
+        code = input[in++];
+        if (code == 0U)
+        {
+            return 0U;
+        }
+        for (index = 1U; index < code; index++)
+        {
+            if ((in >= length) || (input[in] == 0U))
+            {
+                return 0U;
+            }
+            output[out++] = input[in++];
+        }
+        if ((code != 0xFFU) && (in < length))
+        {
+            output[out++] = 0U;
+        }
+    }
+    return out;
+}
+
+static uint32_t Word(const uint8_t *raw)
+{
+    return (uint32_t)raw[0] | ((uint32_t)raw[1] << 8) | ((uint32_t)raw[2] << 16) | ((uint32_t)raw[3] << 24);
+}
+
+/* Checks a record against the documented format */
+static void CheckFormat(const APP_CAN_RING_ENTRY *entry, const uint8_t *record, size_t length)
+{
+    const CAN_RX_BUFFER *rxBuf = APP_CAN_RING_FRAME(entry);
+    uint8_t raw[APP_CAN_RECORD_RAW_MAX_SIZE + 8U];
+    uint32_t payload = TEST_FrameLength(entry);
+    uint32_t idWord = 0U;
+    size_t rawLength = 0U;
+    size_t index = 0U;
+
+    TEST_CHECK(length == (payload + RECORD_OVERHEAD));
+    TEST_CHECK((record[0] == 0U) && (record[length - 1U] == 0U));
+    for (index = 1U; index < (length - 1U); index++)
+    {
+        TEST_CHECK(record[index] != 0U);
+    }
+
+    rawLength = ReferenceCobsDecode(&record[1], length - 2U, raw);
+    TEST_CHECK(rawLength == (APP_CAN_RECORD_HEADER_SIZE + payload + APP_CAN_RECORD_CRC_SIZE));
+    if (rawLength != (APP_CAN_RECORD_HEADER_SIZE + payload + APP_CAN_RECORD_CRC_SIZE))
+    {
+        return;
+    }
+    TEST_CHECK(ReferenceCrc16(raw, rawLength - 2U) == ((uint16_t)raw[rawLength - 2U] | ((uint16_t)raw[rawLength - 1U] << 8)));
+
+    idWord = Word(&raw[4]);
+    TEST_CHECK(Word(raw) == entry->timestamp);
+    TEST_CHECK((idWord & 0x1FFFFFFFUL) == (rxBuf->xtd ? rxBuf->id : (rxBuf->id >> 18)));
+    TEST_CHECK(((idWord & APP_CAN_RECORD_ID_XTD) != 0U) == (rxBuf->xtd != 0U));
+    TEST_CHECK(((idWord & APP_CAN_RECORD_ID_RTR) != 0U) == (rxBuf->rtr != 0U));
+    TEST_CHECK(((idWord & APP_CAN_RECORD_ID_ESI) != 0U) == (rxBuf->esi != 0U));
+    TEST_CHECK((raw[8] & 0x0FU) == rxBuf->dlc);
+    TEST_CHECK(((raw[8] & APP_CAN_RECORD_DLC_BRS) != 0U) == (rxBuf->brs != 0U));
+    TEST_CHECK(((raw[8] & APP_CAN_RECORD_DLC_FDF) != 0U) == (rxBuf->fdf != 0U));
+    TEST_CHECK((raw[8] >> APP_CAN_RECORD_DLC_TYPE_Pos) == APP_CAN_RECORD_TYPE_FULL);
+    TEST_CHECK(memcmp(&raw[APP_CAN_RECORD_HEADER_SIZE], &entry->element[8], payload) == 0);
+}
+
+static void CheckRoundTrip(const APP_CAN_RING_ENTRY *entry)
+{
+    APP_CAN_RING_ENTRY decoded;
+    uint8_t record[APP_CAN_RECORD_MAX_SIZE];
+    uint8_t raw[APP_CAN_RECORD_HEADER_SIZE + 64U];
+    size_t length = 0U;
+    size_t position = 0U;
+    uint32_t type = 0xFFU;
+
+    length = APP_CAN_RecordEncode(entry, record, sizeof(record));
+    CheckFormat(entry, record, length);
+
+    TEST_CHECK(APP_CAN_RecordDecode(&record[1], length - 2U, &decoded, &type));
+    TEST_CHECK(type == APP_CAN_RECORD_TYPE_FULL);
+    TEST_CHECK(TEST_FrameEqual(entry, &decoded));
+    TEST_CHECK(decoded.source == entry->source);
+
+    /* Any corrupted byte is rejected: a COBS error or a burst the CRC detects */
+    position = 1U + TEST_RandomBelow((uint32_t)length - 2U);
+    record[position] ^= (uint8_t)(1U + TEST_RandomBelow(255U));
+    if (record[position] != 0U)
+    {
+        TEST_CHECK(APP_CAN_RecordDecode(&record[1], length - 2U, &decoded, &type) == false);
+    }
+
+    /* Local buffering keeps the same header, without CRC */
+    length = APP_CAN_RecordPack(entry, raw);
+    TEST_CHECK(length == (APP_CAN_RECORD_HEADER_SIZE + TEST_FrameLength(entry)));
+    TEST_CHECK(APP_CAN_RecordPackedSize(raw) == length);
+    APP_CAN_RecordUnpack(raw, &decoded);
+    TEST_CHECK(TEST_FrameEqual(entry, &decoded));
+}
+
+static void TestBoundaries(void)
+{
+    APP_CAN_RING_ENTRY entry;
+    uint8_t data[64];
+    uint8_t record[APP_CAN_RECORD_MAX_SIZE];
+    uint32_t dlc = 0U;
+
+    /* Zero bytes everywhere, the COBS worst case */
+    memset(data, 0, sizeof(data));
+    for (dlc = 0U; dlc < 16U; dlc++)
+    {
+        TEST_FrameMake(&entry, 0U, 0U, false, dlc, true, false, false, false, data);
+        CheckRoundTrip(&entry);
+        TEST_FrameMake(&entry, 0xFFFFFFFFUL, 0x1FFFFFFFUL, true, dlc, true, true, true, false, data);
+        CheckRoundTrip(&entry);
+    }
+    memset(data, 0xFF, sizeof(data));
+    TEST_FrameMake(&entry, 0x00FF00FFUL, 0x7FFU, false, 15U, true, true, false, false, data);
+    CheckRoundTrip(&entry);
+    TEST_FrameMake(&entry, 12345U, 0x123U, false, 8U, false, false, false, true, NULL);
+    CheckRoundTrip(&entry);
+
+    /* The buffer must hold the largest record */
+    TEST_CHECK(APP_CAN_RecordEncode(&entry, record, APP_CAN_RECORD_MAX_SIZE - 1U) == 0U);
+    TEST_CHECK(APP_CAN_RecordEncode(&entry, NULL, APP_CAN_RECORD_MAX_SIZE) == 0U);
+}
+
+static void TestRandom(void)
+{
+    APP_CAN_RING_ENTRY entry;
+    uint32_t round = 0U;
+
+    for (round = 0U; round < ROUNDS; round++)
+    {
+        TEST_FrameRandom(&entry, TEST_Random());
+        CheckRoundTrip(&entry);
+    }
+}
+
+static void TestEnd(void)
+{
+    APP_CAN_RING_ENTRY entry;
+    uint8_t raw[APP_CAN_RECORD_HEADER_SIZE + APP_CAN_RECORD_CRC_SIZE];
+    uint8_t record[APP_CAN_RECORD_MAX_SIZE];
+    uint32_t type = 0U;
+    uint16_t crc = 0U;
+    size_t length = 1U;
+    size_t in = 0U;
+    size_t block = 0U;
+    uint8_t code = 1U;
+
+    /* End of a replayed trace, as the host tool sends it */
+    memset(raw, 0, sizeof(raw));
+    raw[0] = 0x78U;
+    raw[1] = 0x56U;
+    raw[2] = 0x34U;
+    raw[3] = 0x12U;
+    raw[8] = (uint8_t)(APP_CAN_RECORD_TYPE_END << APP_CAN_RECORD_DLC_TYPE_Pos);
+    crc = ReferenceCrc16(raw, APP_CAN_RECORD_HEADER_SIZE);
+    raw[9] = (uint8_t)crc;
+    raw[10] = (uint8_t)(crc >> 8);
+
+    /* Plain COBS encoding, no block is longer than 254 bytes */
+    for (in = 0U; in < sizeof(raw); in++)
+    {
+        if (raw[in] == 0U)
+        {
+            record[block] = code;
+            block = length++;
+            code = 1U;
+        }
+        else
+        {
+            record[length++] = raw[in];
+            code++;
+        }
+    }
+    record[block] = code;
+
+    TEST_CHECK(APP_CAN_RecordDecode(record, length, &entry, &type));
+    TEST_CHECK(type == APP_CAN_RECORD_TYPE_END);
+    TEST_CHECK(entry.timestamp == 0x12345678UL);
+}
+
+int main(void)
+{
+    TEST_RandomSeed(3U);
+    TestBoundaries();
+    TestRandom();
+    TestEnd();
+
+    printf("test_record: %u failures\n", testFailures);
+    return TEST_RESULT();
+}
@@ -0,0 +1,518 @@
+/*******************************************************************************
+  Delta Record Encoder Host Test
+
+  File Name:
+    test_record_delta.c
+
+  Summary:
+    Round trip of simulated bus traffic through the delta record encoder and
+    a lossy link.
+
+  Description:
+    Periodic IDs with counters, slowly changing signals, random payloads and
+    DLC changes are encoded with APP_CAN_RecordEncodeDelta. Records are
+    dropped at random on the way to a decoder written from the README, and
+    text output is mixed into the stream. Every payload the decoder outputs
+    must match the frame sent, every record whose keyframe arrived must be
+    decoded, and the decoder must resynchronise at the next keyframe of an
+    ID that lost one.
+
+    The stream received and the lines decoded are written to
+    record_delta.bin and record_delta.txt, for the check of
+    tools/can_record_decode.py.
+*******************************************************************************/
+
+#include <string.h>
+#include "test_common.h"
+#include "test_frame.h"
+#include "app_can_record.h"
+
+#define IDS                 24U
+/* 2 us ticks, 40 s of traffic */
+#define TICKS_PER_MS        500U
+#define DURATION_TICKS      (40000U * TICKS_PER_MS)
+/* One record in DROP_RATE is lost */
+#define DROP_RATE           40U
+
+#define BIT_TIME_US         2.0
+
+typedef struct
+{
+    uint32_t id;
+    bool xtd;
+    uint32_t period;
+    uint32_t due;
+    uint32_t dlc;
+    bool fdf;
+    /* 0: counter and slow signal, 1: random payload, 2: static */
+    uint32_t kind;
+    uint8_t data[64];
+    /* Test side knowledge of the link */
+    bool keyframeLost;
+    bool seen;
+    uint32_t lastKeyframe;
+    uint32_t maxKeyframeGap;
+} SOURCE;
+
+/* Decoder state of one ID, from the README */
+typedef struct
+{
+    uint32_t key;
+    bool valid;
+    uint8_t dlcFlags;
+    uint8_t data[64];
+} KEYFRAME;
+
+typedef struct
+{
+    uint32_t timestamp;
+    uint32_t idWord;
+    uint8_t dlcFlags;
+    bool delta;
+    uint32_t length;
+    uint8_t data[64];
+} DECODED;
+
+static SOURCE source[IDS];
+static KEYFRAME keyframe[IDS * 2U];
+static FILE *captureFile = NULL;
+static FILE *expectedFile = NULL;
+
+static unsigned int fullRecords = 0U;
+static unsigned int deltaRecords = 0U;
+static unsigned int droppedFull = 0U;
+static unsigned int droppedDelta = 0U;
+static unsigned int undecoded = 0U;
+static unsigned long streamBytes = 0U;
+static unsigned long fullBytes = 0U;
+
+// *****************************************************************************
+// Section: Reference Decoder
+// *****************************************************************************
+
+/* CRC-16/CCITT-FALSE, continued from crc */
+static uint16_t Crc16(uint16_t crc, const uint8_t *data, size_t length)
+{
+    uint32_t bit = 0U;
+
+    while (length-- > 0U)
+    {
+        crc ^= (uint16_t)(*data++) << 8;
+        for (bit = 0U; bit < 8U; bit++)
+        {
+            crc = ((crc & 0x8000U) != 0U) ? (uint16_t)((crc << 1) ^ 0x1021U) : (uint16_t)(crc << 1);
+        }
+    }
+    return crc;
+}
+
+static size_t CobsDecode(const uint8_t *input, size_t length, uint8_t *output, size_t size)
+{
+    size_t in = 0U;
+    size_t out = 0U;
+    uint8_t code = 0U;
+    uint8_t index = 0U;
+
+    while (in < length)
+    {
+        code = input[in++];
+        if ((code == 0U) || ((in + code - 1U) > length) || ((out + code) > size))
+        {
+            return 0U;
+        }
+        for (index = 1U; index < code; index++)
+        {
+            output[out++] = input[in++];
+        }
+        if ((code != 0xFFU) && (in < length))
+        {
+            output[out++] = 0U;
+        }
+    }
+    return out;
+}
+
+static KEYFRAME *KeyframeFind(uint32_t key)
+{
+    uint32_t index = 0U;
+
+    for (index = 0U; index < (sizeof(keyframe) / sizeof(keyframe[0])); index++)
+    {
+        if (keyframe[index].valid && (keyframe[index].key == key))
+        {
+            return &keyframe[index];
+        }
+    }
+    for (index = 0U; index < (sizeof(keyframe) / sizeof(keyframe[0])); index++)
+    {
+        if (keyframe[index].valid == false)
+        {
+            keyframe[index].key = key;
+            return &keyframe[index];
+        }
+    }
+    return NULL;
+}
+
+/* Decodes the bytes between two delimiters, false for anything but a valid
+   full or delta record */
+static bool Decode(const uint8_t *frame, size_t length, DECODED *decoded)
+{
+    static const uint8_t dlcLength[16] = {0U, 1U, 2U, 3U, 4U, 5U, 6U, 7U, 8U, 12U, 16U, 20U, 24U, 32U, 48U, 64U};
+    uint8_t raw[256];
+    size_t rawLength = CobsDecode(frame, length, raw, sizeof(raw));
+    KEYFRAME *base = NULL;
+    const uint8_t *changed = NULL;
+    uint32_t index = 0U;
+    uint32_t bitmapLength = 0U;
+    uint16_t crc = 0U;
+
+    if (rawLength < (APP_CAN_RECORD_HEADER_SIZE + APP_CAN_RECORD_CRC_SIZE))
+    {
+        return false;
+    }
+    rawLength -= APP_CAN_RECORD_CRC_SIZE;
+    crc = (uint16_t)raw[rawLength] | ((uint16_t)raw[rawLength + 1U] << 8);
+
+    decoded->timestamp = (uint32_t)raw[0] | ((uint32_t)raw[1] << 8) | ((uint32_t)raw[2] << 16) | ((uint32_t)raw[3] << 24);
+    decoded->idWord = (uint32_t)raw[4] | ((uint32_t)raw[5] << 8) | ((uint32_t)raw[6] << 16) | ((uint32_t)raw[7] << 24);
+    decoded->dlcFlags = raw[8] & 0x3FU;
+    decoded->delta = ((raw[8] >> APP_CAN_RECORD_DLC_TYPE_Pos) == APP_CAN_RECORD_TYPE_DELTA);
+    decoded->length = ((decoded->idWord & APP_CAN_RECORD_ID_RTR) != 0U) ? 0U : dlcLength[raw[8] & 0x0FU];
+
+    if ((raw[8] >> APP_CAN_RECORD_DLC_TYPE_Pos) == APP_CAN_RECORD_TYPE_FULL)
+    {
+        if ((Crc16(0xFFFFU, raw, rawLength) != crc) ||
+            (rawLength != (APP_CAN_RECORD_HEADER_SIZE + decoded->length)))
+        {
+            return false;
+        }
+        memcpy(decoded->data, &raw[APP_CAN_RECORD_HEADER_SIZE], decoded->length);
+        base = KeyframeFind(decoded->idWord & (APP_CAN_RECORD_ID_XTD | 0x1FFFFFFFUL));
+        TEST_CHECK(base != NULL);
+        if (base == NULL)
+        {
+            return false;
+        }
+        base->valid = true;
+        base->dlcFlags = decoded->dlcFlags;
+        memcpy(base->data, decoded->data, decoded->length);
+        return true;
+    }
+    if (decoded->delta == false)
+    {
+        return false;
+    }
+
+    base = KeyframeFind(decoded->idWord & (APP_CAN_RECORD_ID_XTD | 0x1FFFFFFFUL));
+    bitmapLength = (decoded->length + 7U) / 8U;
+    if ((base == NULL) || (base->valid == false) || (base->dlcFlags != decoded->dlcFlags) ||
+        (rawLength < (APP_CAN_RECORD_HEADER_SIZE + bitmapLength)))
+    {
+        return false;
+    }
+    memcpy(decoded->data, base->data, decoded->length);
+    changed = &raw[APP_CAN_RECORD_HEADER_SIZE + bitmapLength];
+    for (index = 0U; index < decoded->length; index++)
+    {
+        if ((raw[APP_CAN_RECORD_HEADER_SIZE + (index >> 3)] & (1U << (index & 7U))) != 0U)
+        {
+            if (changed >= &raw[rawLength])
+            {
+                return false;
+            }
+            decoded->data[index] = *changed++;
+        }
+    }
+    /* The CRC covers the record and the rebuilt payload */
+    if ((changed != &raw[rawLength]) ||
+        (Crc16(Crc16(0xFFFFU, raw, rawLength), decoded->data, decoded->length) != crc))
+    {
+        /* Corrupted, or the keyframe it refers to was lost */
+        base->valid = false;
+        return false;
+    }
+    return true;
+}
+
+/* The line tools/can_record_decode.py prints for a record */
+static void ExpectedLine(const DECODED *decoded)
+{
+    uint32_t index = 0U;
+    char flags[5];
+    char *flag = flags;
+
+    if ((decoded->dlcFlags & APP_CAN_RECORD_DLC_FDF) != 0U)
+    {
+        *flag++ = 'F';
+    }
+    if ((decoded->dlcFlags & APP_CAN_RECORD_DLC_BRS) != 0U)
+    {
+        *flag++ = 'B';
+    }
+    if ((decoded->idWord & APP_CAN_RECORD_ID_ESI) != 0U)
+    {
+        *flag++ = 'E';
+    }
+    if ((decoded->idWord & APP_CAN_RECORD_ID_RTR) != 0U)
+    {
+        *flag++ = 'R';
+    }
+    *flag = '\0';
+
+    fprintf(expectedFile, ((decoded->idWord & APP_CAN_RECORD_ID_XTD) != 0U) ? "(%12.6f) %s %08lX [%2u] %-4s " :
+            "(%12.6f) %s %03lX [%2u] %-4s ", (double)decoded->timestamp * BIT_TIME_US / 1e6,
+            decoded->delta ? "D" : " ", (unsigned long)(decoded->idWord & 0x1FFFFFFFUL),
+            (unsigned int)decoded->length, flags);
+    for (index = 0U; index < decoded->length; index++)
+    {
+        fprintf(expectedFile, (index == 0U) ? "%02X" : " %02X", decoded->data[index]);
+    }
+    fprintf(expectedFile, "\n");
+}
+
+// *****************************************************************************
+// Section: Traffic
+// *****************************************************************************
+
+static void SourcesCreate(void)
+{
+    uint32_t index = 0U;
+    uint32_t byte = 0U;
+    SOURCE *src = NULL;
+
+    memset(source, 0, sizeof(source));
+    for (index = 0U; index < IDS; index++)
+    {
+        src = &source[index];
+        src->xtd = (index % 3U) == 2U;
+        src->id = src->xtd ? (0x18FF0000UL | (index << 8) | 0x17U) : (0x100U + (index * 0x21U));
+        /* 10 ms to 500 ms */
+        src->period = (10U + TEST_RandomBelow(491U)) * TICKS_PER_MS;
+        src->due = TEST_RandomBelow(src->period);
+        src->fdf = (index % 4U) == 1U;
+        src->dlc = src->fdf ? (9U + TEST_RandomBelow(7U)) : 8U;
+        src->kind = index % 3U;
+        for (byte = 0U; byte < sizeof(src->data); byte++)
+        {
+            src->data[byte] = (uint8_t)TEST_Random();
+        }
+    }
+}
+
+/* Next payload of a source */
+static void SourceStep(SOURCE *src)
+{
+    uint32_t length = testDlcLength[src->dlc];
+    uint32_t byte = 0U;
+
+    switch (src->kind)
+    {
+        case 0U:
+            /* Rolling counter, a slowly rising signal, a rarely changing status byte */
+            src->data[0]++;
+            if (TEST_RandomBelow(4U) == 0U)
+            {
+                src->data[1]++;
+                src->data[2] = (src->data[1] == 0U) ? (uint8_t)(src->data[2] + 1U) : src->data[2];
+            }
+            if (TEST_RandomBelow(50U) == 0U)
+            {
+                src->data[TEST_RandomBelow(length)] = (uint8_t)TEST_Random();
+            }
+            break;
+        case 1U:
+            for (byte = 0U; byte < length; byte++)
+            {
+                src->data[byte] = (uint8_t)TEST_Random();
+            }
+            break;
+        default:
+            break;
+    }
+
+    /* Now and then a different DLC */
+    if (src->fdf && (TEST_RandomBelow(200U) == 0U))
+    {
+        src->dlc = 9U + TEST_RandomBelow(7U);
+    }
+}
+
+// *****************************************************************************
+// Section: Link
+// *****************************************************************************
+
+/* Sends one frame over the link and checks what the receiver makes of it */
+static void Transfer(SOURCE *src, const APP_CAN_RING_ENTRY *entry)
+{
+    static const char text[] = "\r\n[CAN] Menu output between records\r\n";
+    const CAN_RX_BUFFER *rxBuf = APP_CAN_RING_FRAME(entry);
+    uint8_t record[APP_CAN_RECORD_MAX_SIZE];
+    uint8_t raw[256];
+    size_t length = 0U;
+    bool full = false;
+    bool decodable = false;
+    DECODED decoded;
+
+    length = APP_CAN_RecordEncodeDelta(entry, record, sizeof(record));
+    TEST_CHECK((length >= (APP_CAN_RECORD_HEADER_SIZE + 5U)) && (length <= APP_CAN_RECORD_MAX_SIZE));
+    TEST_CHECK(CobsDecode(&record[1], length - 2U, raw, sizeof(raw)) >= APP_CAN_RECORD_HEADER_SIZE);
+    full = ((raw[8] >> APP_CAN_RECORD_DLC_TYPE_Pos) == APP_CAN_RECORD_TYPE_FULL);
+    fullRecords += full ? 1U : 0U;
+    deltaRecords += full ? 0U : 1U;
+    /* Random payloads cannot be delta encoded */
+    if (src->kind != 1U)
+    {
+        streamBytes += length;
+        fullBytes += TEST_FrameLength(entry) + 14U;
+    }
+
+    if (full)
+    {
+        if (src->seen && ((entry->timestamp - src->lastKeyframe) > src->maxKeyframeGap))
+        {
+            src->maxKeyframeGap = entry->timestamp - src->lastKeyframe;
+        }
+        src->lastKeyframe = entry->timestamp;
+        src->seen = true;
+    }
+    else
+    {
+        /* The first record of an ID is a keyframe */
+        TEST_CHECK(src->seen);
+    }
+
+    if (TEST_RandomBelow(DROP_RATE) == 0U)
+    {
+        src->keyframeLost = src->keyframeLost || full;
+        droppedFull += full ? 1U : 0U;
+        droppedDelta += full ? 0U : 1U;
+        return;
+    }
+    if (full)
+    {
+        src->keyframeLost = false;
+    }
+
+    /* Menu output now and then */
+    if (TEST_RandomBelow(500U) == 0U)
+    {
+        fwrite(text, 1U, sizeof(text) - 1U, captureFile);
+        TEST_CHECK(Decode((const uint8_t *)text, sizeof(text) - 1U, &decoded) == false);
+    }
+    fwrite(record, 1U, length, captureFile);
+
+    decodable = Decode(&record[1], length - 2U, &decoded);
+    /* Lost delta records do not matter, only a lost keyframe does */
+    if (src->keyframeLost == false)
+    {
+        TEST_CHECK(decodable);
+    }
+    if (decodable == false)
+    {
+        undecoded++;
+        return;
+    }
+    ExpectedLine(&decoded);
+
+    TEST_CHECK(decoded.timestamp == entry->timestamp);
+    TEST_CHECK((decoded.idWord & 0x1FFFFFFFUL) == src->id);
+    TEST_CHECK(((decoded.idWord & APP_CAN_RECORD_ID_XTD) != 0U) == src->xtd);
+    TEST_CHECK((decoded.dlcFlags & 0x0FU) == rxBuf->dlc);
+    TEST_CHECK(decoded.length == TEST_FrameLength(entry));
+    TEST_CHECK(memcmp(decoded.data, &entry->element[8], decoded.length) == 0);
+}
+
+static void TestTraffic(void)
+{
+    APP_CAN_RING_ENTRY entry;
+    uint32_t now = 0U;
+    uint32_t index = 0U;
+    uint32_t next = 0U;
+    SOURCE *src = NULL;
+
+    SourcesCreate();
+    APP_CAN_RecordDeltaReset();
+    memset(keyframe, 0, sizeof(keyframe));
+
+    while (now < DURATION_TICKS)
+    {
+        /* Earliest due source, ties in index order */
+        src = &source[0];
+        for (index = 1U; index < IDS; index++)
+        {
+            src = ((int32_t)(source[index].due - src->due) < 0) ? &source[index] : src;
+        }
+        /* A frame takes at least 100 us on the bus */
+        now = ((int32_t)(src->due - now) > 50) ? src->due : (now + 50U);
+
+        SourceStep(src);
+        TEST_FrameMake(&entry, now, src->id, src->xtd, src->dlc, src->fdf, src->fdf, false, false, src->data);
+        Transfer(src, &entry);
+
+        /* Period jitter of up to 1 ms */
+        next = src->due + src->period + TEST_RandomBelow(TICKS_PER_MS);
+        src->due = next;
+    }
+
+    for (index = 0U; index < IDS; index++)
+    {
+        /* A keyframe at least every APP_CAN_RECORD_KEYFRAME_TICKS plus one period */
+        TEST_CHECK(source[index].maxKeyframeGap <=
+                   (APP_CAN_RECORD_KEYFRAME_TICKS + source[index].period + (2U * TICKS_PER_MS)));
+    }
+    TEST_CHECK((droppedFull > 0U) && (droppedDelta > 0U));
+    /* Delta records pay off on the IDs with repeating payloads */
+    TEST_CHECK((deltaRecords > fullRecords) && ((streamBytes * 10U) < (fullBytes * 7U)));
+
+    printf("%u full and %u delta records, %u and %u dropped, %u not decodable, repeating payloads in %lu bytes instead of %lu\n",
+           fullRecords, deltaRecords, droppedFull, droppedDelta, undecoded, streamBytes, fullBytes);
+}
+
+/* A corrupted delta record is rejected and its ID waits for a keyframe */
+static void TestCorrupted(void)
+{
+    APP_CAN_RING_ENTRY entry;
+    uint8_t data[8] = {1U, 2U, 3U, 4U, 5U, 6U, 7U, 8U};
+    uint8_t record[APP_CAN_RECORD_MAX_SIZE];
+    size_t length = 0U;
+    DECODED decoded;
+
+    APP_CAN_RecordDeltaReset();
+    memset(keyframe, 0, sizeof(keyframe));
+    TEST_FrameMake(&entry, 1000U, 0x321U, false, 8U, false, false, false, false, data);
+    length = APP_CAN_RecordEncodeDelta(&entry, record, sizeof(record));
+    TEST_CHECK(Decode(&record[1], length - 2U, &decoded) && !decoded.delta);
+
+    data[3] = 0x40U;
+    TEST_FrameMake(&entry, 2000U, 0x321U, false, 8U, false, false, false, false, data);
+    length = APP_CAN_RecordEncodeDelta(&entry, record, sizeof(record));
+    record[length - 4U] ^= 0x01U;
+    TEST_CHECK(Decode(&record[1], length - 2U, &decoded) == false);
+    record[length - 4U] ^= 0x01U;
+    TEST_CHECK(Decode(&record[1], length - 2U, &decoded) == false);
+
+    /* The firmware decoder cannot check delta records */
+    TEST_CHECK(APP_CAN_RecordDecode(&record[1], length - 2U, &entry, &(uint32_t){0U}) == false);
+}
+
+int main(void)
+{
+    TEST_RandomSeed(7U);
+
+    captureFile = fopen("record_delta.bin", "wb");
+    expectedFile = fopen("record_delta.txt", "w");
+    TEST_CHECK((captureFile != NULL) && (expectedFile != NULL));
+    if ((captureFile == NULL) || (expectedFile == NULL))
+    {
+        return TEST_RESULT();
+    }
+    TestTraffic();
+    fclose(captureFile);
+    fclose(expectedFile);
+
+    TestCorrupted();
+
+    printf("test_record_delta: %u failures\n", testFailures);
+    return TEST_RESULT();
+}
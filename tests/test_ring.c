@@ -0,0 +1,238 @@
+/*******************************************************************************
+  CAN Capture Ring Host Test
+
+  File Name:
+    test_ring.c
+
+  Summary:
+    Runs the capture ring with the producer in a thread of its own, standing
+    in for the CAN1 interrupt, against a consumer in the main thread.
+
+  Description:
+    The producer writes frames numbered in sequence with a payload derived
+    from the number, in bursts of random length, and yields after each burst
+    as the interrupt returns. The consumer reads a random number of frames
+    before it yields and stalls until the ring is full now and then, so
+    frames are dropped. On a single core the threads still preempt each
+    other in the middle of the ring routines. Every frame must come out once, whole and in
+    order, and the overflow count and high-water mark must match what both
+    sides saw.
+*******************************************************************************/
+
+#include <pthread.h>
+#include <sched.h>
+#include <string.h>
+#include "test_common.h"
+#include "app_can_ring.h"
+
+#define FRAMES              1000000U
+/* The consumer stalls until the ring is full once every so many frames */
+#define STALL_FRAMES        50000U
+
+typedef struct
+{
+    /* Frames offered to the ring, committed and dropped */
+    uint32_t offered;
+    uint32_t committed;
+    uint32_t dropped;
+} PRODUCER;
+
+static PRODUCER producer;
+static volatile bool producerDone = false;
+
+static uint8_t PayloadByte(uint32_t sequence, uint32_t index)
+{
+    return (uint8_t)((sequence * 7U) + index);
+}
+
+/* xorshift32 of its own, TEST_Random belongs to the main thread */
+static uint32_t ProducerRandom(uint32_t *state)
+{
+    *state ^= *state << 13;
+    *state ^= *state >> 17;
+    *state ^= *state << 5;
+    return *state;
+}
+
+/* Frames in bursts, one burst per interrupt */
+static void *ProducerRun(void *argument)
+{
+    APP_CAN_RING_ENTRY *entry = NULL;
+    uint32_t state = 0x13579BDFUL;
+    uint32_t burst = 0U;
+    uint32_t index = 0U;
+
+    (void)argument;
+    while (producer.offered < FRAMES)
+    {
+        burst = 1U + (ProducerRandom(&state) % 32U);
+        while ((burst > 0U) && (producer.offered < FRAMES))
+        {
+            entry = APP_CAN_RingWriteSlotGet();
+            if (entry == NULL)
+            {
+                producer.dropped++;
+            }
+            else
+            {
+                entry->timestamp = producer.offered;
+                entry->source = (uint8_t)(producer.offered % 3U);
+                for (index = 0U; index < sizeof(entry->element); index++)
+                {
+                    entry->element[index] = PayloadByte(producer.offered, index);
+                }
+                APP_CAN_RingWriteCommit();
+                producer.committed++;
+            }
+            producer.offered++;
+            burst--;
+        }
+        (void)sched_yield();
+    }
+    __atomic_store_n(&producerDone, true, __ATOMIC_SEQ_CST);
+    return NULL;
+}
+
+/* Two threads: order, integrity, overflow count and high-water mark */
+static void TestConcurrent(void)
+{
+    pthread_t thread;
+    APP_CAN_RING_STATS stats;
+    APP_CAN_RING_ENTRY *entry = NULL;
+    uint32_t consumed = 0U;
+    uint32_t last = 0U;
+    uint32_t count = 0U;
+    uint32_t maxCount = 0U;
+    uint32_t stalls = 0U;
+    uint32_t reads = 0U;
+    uint32_t index = 0U;
+    bool whole = true;
+
+    APP_CAN_RingInitialize();
+    memset(&producer, 0, sizeof(producer));
+    producerDone = false;
+    TEST_CHECK(pthread_create(&thread, NULL, ProducerRun, NULL) == 0);
+
+    while (true)
+    {
+        count = APP_CAN_RingCountGet();
+        TEST_CHECK(count <= APP_CAN_RING_SIZE);
+        maxCount = (count > maxCount) ? count : maxCount;
+
+        entry = APP_CAN_RingReadSlotGet();
+        if (entry == NULL)
+        {
+            if (__atomic_load_n(&producerDone, __ATOMIC_SEQ_CST) && (APP_CAN_RingCountGet() == 0U))
+            {
+                break;
+            }
+            (void)sched_yield();
+            continue;
+        }
+        TEST_CHECK((consumed == 0U) || (entry->timestamp > last));
+        TEST_CHECK(entry->source == (uint8_t)(entry->timestamp % 3U));
+        whole = true;
+        for (index = 0U; index < sizeof(entry->element); index++)
+        {
+            whole = whole && (entry->element[index] == PayloadByte(entry->timestamp, index));
+        }
+        TEST_CHECK(whole);
+        last = entry->timestamp;
+        APP_CAN_RingReadRelease();
+        consumed++;
+
+        /* Stalled until full at times, otherwise about as fast */
+        if ((consumed % STALL_FRAMES) == 0U)
+        {
+            while ((APP_CAN_RingCountGet() < APP_CAN_RING_SIZE) && !__atomic_load_n(&producerDone, __ATOMIC_SEQ_CST))
+            {
+                (void)sched_yield();
+            }
+            stalls++;
+        }
+        if (reads == 0U)
+        {
+            (void)sched_yield();
+            reads = 1U + TEST_RandomBelow(48U);
+        }
+        reads--;
+    }
+    TEST_CHECK(pthread_join(thread, NULL) == 0);
+
+    APP_CAN_RingStatsGet(&stats);
+    TEST_CHECK(producer.offered == FRAMES);
+    TEST_CHECK(consumed == producer.committed);
+    TEST_CHECK((consumed + producer.dropped) == FRAMES);
+    TEST_CHECK(stats.produced == producer.committed);
+    TEST_CHECK(stats.overflow == producer.dropped);
+    TEST_CHECK(stats.overflow != 0U);
+    TEST_CHECK(stalls != 0U);
+    /* The ring was full when a frame was dropped, and held every count the
+       consumer saw at a commit */
+    TEST_CHECK(stats.highWater == APP_CAN_RING_SIZE);
+    TEST_CHECK(maxCount <= stats.highWater);
+}
+
+/* Single threaded: exact counts at the ends of the ring */
+static void TestBounds(void)
+{
+    APP_CAN_RING_STATS stats;
+    APP_CAN_RING_ENTRY *entry = NULL;
+    uint32_t round = 0U;
+    uint32_t index = 0U;
+
+    APP_CAN_RingInitialize();
+    TEST_CHECK(APP_CAN_RingReadSlotGet() == NULL);
+    APP_CAN_RingStatsGet(NULL);
+
+    /* Offset the indices so the ring wraps within each round */
+    for (index = 0U; index < (APP_CAN_RING_SIZE / 2U) + 3U; index++)
+    {
+        TEST_CHECK(APP_CAN_RingWriteSlotGet() != NULL);
+        APP_CAN_RingWriteCommit();
+        TEST_CHECK(APP_CAN_RingReadSlotGet() != NULL);
+        APP_CAN_RingReadRelease();
+    }
+    for (round = 0U; round < 3U; round++)
+    {
+        for (index = 0U; index < APP_CAN_RING_SIZE; index++)
+        {
+            entry = APP_CAN_RingWriteSlotGet();
+            TEST_CHECK(entry != NULL);
+            if (entry != NULL)
+            {
+                entry->timestamp = index;
+                APP_CAN_RingWriteCommit();
+            }
+        }
+        TEST_CHECK(APP_CAN_RingCountGet() == APP_CAN_RING_SIZE);
+        TEST_CHECK(APP_CAN_RingWriteSlotGet() == NULL);
+        TEST_CHECK(APP_CAN_RingWriteSlotGet() == NULL);
+        for (index = 0U; index < APP_CAN_RING_SIZE; index++)
+        {
+            entry = APP_CAN_RingReadSlotGet();
+            TEST_CHECK((entry != NULL) && (entry->timestamp == index));
+            APP_CAN_RingReadRelease();
+        }
+        TEST_CHECK(APP_CAN_RingReadSlotGet() == NULL);
+        TEST_CHECK(APP_CAN_RingCountGet() == 0U);
+    }
+    APP_CAN_RingStatsGet(&stats);
+    TEST_CHECK(stats.produced == ((APP_CAN_RING_SIZE / 2U) + 3U + (3U * APP_CAN_RING_SIZE)));
+    TEST_CHECK(stats.overflow == 6U);
+    TEST_CHECK(stats.highWater == APP_CAN_RING_SIZE);
+
+    APP_CAN_RingInitialize();
+    APP_CAN_RingStatsGet(&stats);
+    TEST_CHECK((stats.produced == 0U) && (stats.overflow == 0U) && (stats.highWater == 0U));
+}
+
+int main(void)
+{
+    TEST_RandomSeed(2U);
+    TestBounds();
+    TestConcurrent();
+
+    printf("test_ring: %u failures\n", testFailures);
+    return TEST_RESULT();
+}
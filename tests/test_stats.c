@@ -0,0 +1,296 @@
+/*******************************************************************************
+  Traffic Statistics Host Test
+
+  File Name:
+    test_stats.c
+
+  Summary:
+    Checks the per-ID counters and period statistics against a reference
+    computed in double precision.
+
+  Description:
+    Covers mixed traffic of standard and extended IDs with every flag,
+    periodic IDs with known jitter, timestamps wrapping around, long runs,
+    and a table with more IDs than slots.
+*******************************************************************************/
+
+#include <math.h>
+#include <string.h>
+#include "test_common.h"
+#include "test_frame.h"
+#include "app_can_stats.h"
+
+#define TICKS_PER_MS        500U
+#define REFERENCE_IDS       (APP_CAN_STATS_IDS * 2U)
+
+typedef struct
+{
+    uint32_t id;
+    bool xtd;
+    uint32_t count;
+    uint32_t bytes;
+    uint32_t last;
+    uint32_t minPeriod;
+    uint32_t maxPeriod;
+    double sum;
+    double sumSquares;
+    uint32_t fdf;
+    uint32_t brs;
+    uint32_t esi;
+    uint32_t rtr;
+    bool matched;
+} REFERENCE;
+
+static REFERENCE reference[REFERENCE_IDS];
+static uint32_t referenceCount = 0U;
+static uint32_t frames = 0U;
+
+static REFERENCE *ReferenceFind(uint32_t id, bool xtd)
+{
+    uint32_t index = 0U;
+
+    for (index = 0U; index < referenceCount; index++)
+    {
+        if ((reference[index].id == id) && (reference[index].xtd == xtd))
+        {
+            return &reference[index];
+        }
+    }
+    TEST_CHECK(referenceCount < REFERENCE_IDS);
+    memset(&reference[referenceCount], 0, sizeof(reference[0]));
+    reference[referenceCount].id = id;
+    reference[referenceCount].xtd = xtd;
+    return &reference[referenceCount++];
+}
+
+static void Reset(void)
+{
+    APP_CAN_StatsReset();
+    referenceCount = 0U;
+    frames = 0U;
+}
+
+/* Accounts the frame in both */
+static void Frame(uint32_t timestamp, uint32_t id, bool xtd, uint32_t dlc, bool fdf, bool brs, bool esi, bool rtr)
+{
+    APP_CAN_RING_ENTRY entry;
+    REFERENCE *ref = ReferenceFind(id, xtd);
+    uint32_t period = 0U;
+
+    TEST_FrameMake(&entry, timestamp, id, xtd, dlc, fdf, brs, esi, rtr, NULL);
+    APP_CAN_StatsUpdate(&entry);
+    frames++;
+
+    if (ref->count != 0U)
+    {
+        period = timestamp - ref->last;
+        ref->minPeriod = ((ref->count == 1U) || (period < ref->minPeriod)) ? period : ref->minPeriod;
+        ref->maxPeriod = (period > ref->maxPeriod) ? period : ref->maxPeriod;
+        ref->sum += (double)period;
+        ref->sumSquares += (double)period * (double)period;
+    }
+    ref->last = timestamp;
+    ref->count++;
+    ref->bytes += TEST_FrameLength(&entry);
+    ref->fdf += fdf ? 1U : 0U;
+    ref->brs += brs ? 1U : 0U;
+    ref->esi += esi ? 1U : 0U;
+    ref->rtr += rtr ? 1U : 0U;
+}
+
+/* Compares every used slot with the reference. jitterTolerance is relative,
+   with at least one tick. Returns the frames accounted. */
+static uint32_t Compare(double jitterTolerance)
+{
+    APP_CAN_STATS stats;
+    REFERENCE *ref = NULL;
+    uint32_t index = 0U;
+    uint32_t accounted = 0U;
+    uint32_t periods = 0U;
+    double mean = 0.0;
+    double deviation = 0.0;
+
+    for (index = 0U; index < referenceCount; index++)
+    {
+        reference[index].matched = false;
+    }
+    for (index = 0U; index < APP_CAN_STATS_IDS; index++)
+    {
+        if (APP_CAN_StatsGet(index, &stats) == false)
+        {
+            continue;
+        }
+        ref = ReferenceFind(stats.id, stats.xtd);
+        TEST_CHECK(ref->matched == false);
+        ref->matched = true;
+        accounted += stats.count;
+
+        TEST_CHECK(stats.count == ref->count);
+        TEST_CHECK(stats.bytes == ref->bytes);
+        TEST_CHECK((stats.fdf == ref->fdf) && (stats.brs == ref->brs) && (stats.esi == ref->esi) &&
+                   (stats.rtr == ref->rtr));
+        TEST_CHECK(stats.minPeriod == ((ref->count > 1U) ? ref->minPeriod : 0U));
+        TEST_CHECK(stats.maxPeriod == ((ref->count > 1U) ? ref->maxPeriod : 0U));
+
+        periods = ref->count - 1U;
+        mean = (periods > 0U) ? (ref->sum / periods) : 0.0;
+        TEST_CHECK(fabs((double)stats.avgPeriod - mean) <= (1.0 + (mean * 1e-6)));
+        if (periods > 1U)
+        {
+            deviation = sqrt(fmax(0.0, (ref->sumSquares - (ref->sum * mean)) / (periods - 1U)));
+            TEST_CHECK(fabs((double)stats.jitter - deviation) <= fmax(1.0, deviation * jitterTolerance));
+            if (fabs((double)stats.jitter - deviation) > fmax(1.0, deviation * jitterTolerance))
+            {
+                printf("  ID %lX: jitter %lu, expected %.1f over %lu periods of %.1f\n", (unsigned long)ref->id,
+                       (unsigned long)stats.jitter, deviation, (unsigned long)periods, mean);
+            }
+        }
+        else
+        {
+            TEST_CHECK(stats.jitter == 0U);
+        }
+    }
+    return accounted;
+}
+
+static void TestMixed(void)
+{
+    static const uint32_t id[] = { 0x000U, 0x123U, 0x7FFU };
+    uint32_t now = 1000U;
+    uint32_t round = 0U;
+    uint32_t pick = 0U;
+    bool xtd = false;
+    bool fdf = false;
+
+    Reset();
+    for (round = 0U; round < 20000U; round++)
+    {
+        /* The same numbers as standard and extended IDs are different IDs */
+        pick = TEST_RandomBelow(8U);
+        xtd = (pick & 4U) != 0U;
+        fdf = (TEST_Random() & 1U) != 0U;
+        now += 50U + TEST_RandomBelow(2000U);
+        Frame(now, (pick < 3U) ? id[pick] : ((pick < 6U) ? id[pick - 3U] : (0x1FFFFFFFUL - pick)), xtd,
+              fdf ? TEST_RandomBelow(16U) : TEST_RandomBelow(9U), fdf, fdf && ((TEST_Random() & 1U) != 0U),
+              TEST_RandomBelow(10U) == 0U, !fdf && (TEST_RandomBelow(10U) == 0U));
+    }
+    TEST_CHECK(Compare(1e-3) == frames);
+    TEST_CHECK(APP_CAN_StatsUntrackedGet() == 0U);
+}
+
+static void TestPeriodic(void)
+{
+    /* 10 ms +-1 ms uniform, 100 ms exact, 1 s with one late frame */
+    uint32_t due[3] = { 0U, 7U, 13U };
+    uint32_t now = 0U;
+    uint32_t index = 0U;
+    APP_CAN_STATS stats;
+
+    Reset();
+    for (index = 0U; index < 10000U; index++)
+    {
+        Frame(due[0] + TEST_RandomBelow(2U * TICKS_PER_MS), 0x0CF00400UL, true, 8U, false, false, false, false);
+        due[0] += 10U * TICKS_PER_MS;
+    }
+    for (index = 0U; index < 1000U; index++)
+    {
+        Frame(due[1], 0x3E8U, false, 8U, false, false, false, false);
+        due[1] += 100U * TICKS_PER_MS;
+    }
+    for (index = 0U; index < 100U; index++)
+    {
+        now = due[2] + ((index == 50U) ? (300U * TICKS_PER_MS) : 0U);
+        Frame(now, 0x7E8U, false, 3U, false, false, false, false);
+        due[2] += 1000U * TICKS_PER_MS;
+    }
+    TEST_CHECK(Compare(1e-3) == frames);
+
+    for (index = 0U; index < APP_CAN_STATS_IDS; index++)
+    {
+        if (APP_CAN_StatsGet(index, &stats) && (stats.id == 0x3E8U))
+        {
+            TEST_CHECK((stats.minPeriod == (100U * TICKS_PER_MS)) && (stats.maxPeriod == (100U * TICKS_PER_MS)));
+            TEST_CHECK((stats.avgPeriod == (100U * TICKS_PER_MS)) && (stats.jitter == 0U));
+        }
+        if (APP_CAN_StatsGet(index, &stats) && (stats.id == 0x7E8U))
+        {
+            TEST_CHECK((stats.minPeriod == (700U * TICKS_PER_MS)) && (stats.maxPeriod == (1300U * TICKS_PER_MS)));
+        }
+        if (APP_CAN_StatsGet(index, &stats) && stats.xtd)
+        {
+            /* Uniform over 2 ms: 1 ms / sqrt(3) per timestamp, sqrt(2) for the difference */
+            TEST_CHECK(fabs((double)stats.jitter - (TICKS_PER_MS * sqrt(2.0 / 3.0))) < (0.05 * TICKS_PER_MS));
+        }
+    }
+}
+
+static void TestWrap(void)
+{
+    uint32_t now = 0xFFFFFFFFUL - (50U * 5000U);
+    uint32_t index = 0U;
+
+    Reset();
+    for (index = 0U; index < 100U; index++)
+    {
+        Frame(now + TEST_RandomBelow(100U), 0x100U, false, 8U, false, false, false, false);
+        now += 5000U;
+    }
+    TEST_CHECK(Compare(1e-3) == frames);
+}
+
+/* A long run at 1 kHz with jitter: 2 million frames, 33 minutes */
+static void TestLongRun(void)
+{
+    uint32_t now = 0U;
+    uint32_t index = 0U;
+
+    Reset();
+    for (index = 0U; index < 2000000U; index++)
+    {
+        Frame(now + TEST_RandomBelow(100U), 0x080U, false, 8U, false, false, false, false);
+        now += TICKS_PER_MS;
+    }
+    TEST_CHECK(Compare(0.005) == frames);
+}
+
+static void TestFull(void)
+{
+    APP_CAN_STATS stats;
+    uint32_t index = 0U;
+    uint32_t round = 0U;
+
+    Reset();
+    for (round = 0U; round < 4U; round++)
+    {
+        for (index = 0U; index < (APP_CAN_STATS_IDS + 100U); index++)
+        {
+            Frame((round * 100000U) + index, 0x10000000UL + (index * 7U), true, 1U, false, false, false, false);
+        }
+    }
+    /* Every frame is either accounted or counted as untracked */
+    TEST_CHECK((Compare(1e-3) + APP_CAN_StatsUntrackedGet()) == frames);
+    TEST_CHECK(APP_CAN_StatsUntrackedGet() >= (4U * 100U));
+
+    TEST_CHECK(APP_CAN_StatsGet(APP_CAN_STATS_IDS, &stats) == false);
+    TEST_CHECK(APP_CAN_StatsGet(0U, NULL) == false);
+
+    APP_CAN_StatsReset();
+    TEST_CHECK(APP_CAN_StatsUntrackedGet() == 0U);
+    for (index = 0U; index < APP_CAN_STATS_IDS; index++)
+    {
+        TEST_CHECK(APP_CAN_StatsGet(index, &stats) == false);
+    }
+}
+
+int main(void)
+{
+    TEST_RandomSeed(9U);
+    TestMixed();
+    TestPeriodic();
+    TestWrap();
+    TestLongRun();
+    TestFull();
+
+    printf("test_stats: %u failures\n", testFailures);
+    return TEST_RESULT();
+}
@@ -0,0 +1,426 @@
+/*******************************************************************************
+  Trigger Capture Host Test
+
+  File Name:
+    test_trigger.c
+
+  Summary:
+    Checks the position of the trigger in the frozen window, and the pre and
+    post trigger counts, against a reference of the window.
+
+  Description:
+    The window is built with a small buffer (see CMakeLists.txt), so it wraps
+    around many times in every run. The reference keeps every frame fed in:
+    the window holds the longest run of frames up to the last one recorded
+    which fits in the buffer, unless the frames from the trigger on do not
+    fit, then it freezes full of them. Covers frame triggers on an ID and a
+    payload pattern, pin and error events reported while frames older than
+    the event are still to be recorded, events fired by
+    APP_CAN_TriggerService, and post counts larger than the window.
+*******************************************************************************/
+
+#include <string.h>
+#include "test_common.h"
+#include "test_frame.h"
+#include "app_can_trigger.h"
+#include "app_can_record.h"
+
+#define FRAMES_MAX          4000U
+#define ROUNDS              400U
+#define TRIGGER_ID          0x7ABU
+
+typedef struct
+{
+    /* Window frames [start, end) */
+    uint32_t start;
+    uint32_t end;
+    uint32_t pre;
+    uint32_t post;
+    /* Frame whose APP_CAN_TriggerFrameAdd freezes the window */
+    uint32_t frozenAt;
+} EXPECTED;
+
+static APP_CAN_RING_ENTRY frames[FRAMES_MAX];
+/* Bytes each frame takes in the window */
+static uint32_t frameSize[FRAMES_MAX];
+static uint32_t frameCount = 0U;
+static uint32_t frameTime = 0U;
+
+static void FrameAppend(const APP_CAN_RING_ENTRY *entry)
+{
+    uint8_t raw[APP_CAN_RECORD_HEADER_SIZE + 64U];
+
+    frames[frameCount] = *entry;
+    frameSize[frameCount] = (uint32_t)APP_CAN_RecordPack(entry, raw);
+    frameCount++;
+}
+
+/* Random frames, none of them a standard frame with TRIGGER_ID */
+static void FramesRandom(uint32_t count)
+{
+    APP_CAN_RING_ENTRY entry;
+    const CAN_RX_BUFFER *rxBuf = APP_CAN_RING_FRAME(&entry);
+
+    while (count > 0U)
+    {
+        frameTime += 1U + TEST_RandomBelow(50U);
+        do
+        {
+            TEST_FrameRandom(&entry, frameTime);
+        } while ((rxBuf->xtd == 0U) && ((rxBuf->id >> 18) == TRIGGER_ID));
+        FrameAppend(&entry);
+        count--;
+    }
+}
+
+/* Standard frame with TRIGGER_ID, data[2] = value and data[3] = low */
+static void FrameTriggerId(uint8_t value, uint8_t low)
+{
+    APP_CAN_RING_ENTRY entry;
+    uint8_t data[8] = { 0x11U, 0x22U, value, (uint8_t)(0xA0U | low), 0x55U, 0x66U, 0x77U, 0x88U };
+
+    frameTime += 1U + TEST_RandomBelow(50U);
+    TEST_FrameMake(&entry, frameTime, TRIGGER_ID, false, 8U, false, false, false, false, data);
+    FrameAppend(&entry);
+}
+
+static void Reset(void)
+{
+    frameCount = 0U;
+    frameTime = TEST_Random();
+}
+
+/* Window once mark is the first frame at or after the trigger and
+   postTotal frames are to be recorded from it */
+static EXPECTED Expect(uint32_t mark, uint32_t postTotal)
+{
+    EXPECTED expected;
+    uint32_t bytes = 0U;
+    uint32_t index = mark;
+
+    while ((index < (mark + postTotal)) && ((bytes + frameSize[index]) <= APP_CAN_TRIGGER_BUFFER_SIZE))
+    {
+        bytes += frameSize[index];
+        index++;
+    }
+    if (index < (mark + postTotal))
+    {
+        /* Full up to the trigger, the frame which does not fit freezes it */
+        expected.start = mark;
+        expected.end = index;
+        expected.pre = 0U;
+        expected.post = index - mark;
+        expected.frozenAt = index;
+        return expected;
+    }
+
+    expected.end = mark + postTotal;
+    expected.start = expected.end;
+    bytes = 0U;
+    while ((expected.start > 0U) && ((bytes + frameSize[expected.start - 1U]) <= APP_CAN_TRIGGER_BUFFER_SIZE))
+    {
+        bytes += frameSize[expected.start - 1U];
+        expected.start--;
+    }
+    expected.pre = mark - expected.start;
+    expected.post = postTotal;
+    expected.frozenAt = (postTotal == 0U) ? mark : (expected.end - 1U);
+    return expected;
+}
+
+/* Feeds frames [from, to), returns the frame whose addition froze the
+   window, to if it did not freeze */
+static uint32_t Feed(uint32_t from, uint32_t to)
+{
+    uint32_t index = 0U;
+
+    for (index = from; index < to; index++)
+    {
+        APP_CAN_TriggerFrameAdd(&frames[index]);
+        if (APP_CAN_TriggerStateGet() == APP_CAN_TRIGGER_STATE_FROZEN)
+        {
+            return index;
+        }
+    }
+    return to;
+}
+
+/* The frozen window against the expected one, read twice as FrameGet does
+   not remove the frame */
+static void WindowCheck(const EXPECTED *expected, uint32_t source, uint32_t timestamp)
+{
+    APP_CAN_TRIGGER_INFO info;
+    APP_CAN_RING_ENTRY entry;
+    uint32_t index = expected->start;
+
+    TEST_CHECK(APP_CAN_TriggerStateGet() == APP_CAN_TRIGGER_STATE_FROZEN);
+    APP_CAN_TriggerInfoGet(&info);
+    TEST_CHECK(info.source == source);
+    TEST_CHECK(info.timestamp == timestamp);
+    TEST_CHECK(info.preFrames == expected->pre);
+    TEST_CHECK(info.postFrames == expected->post);
+
+    while (APP_CAN_TriggerFrameGet(&entry))
+    {
+        TEST_CHECK(index < expected->end);
+        if (index < expected->end)
+        {
+            TEST_CHECK(TEST_FrameEqual(&entry, &frames[index]));
+        }
+        TEST_CHECK(APP_CAN_TriggerFrameGet(&entry) && TEST_FrameEqual(&entry, &frames[index]));
+        APP_CAN_TriggerFrameRelease();
+        index++;
+    }
+    TEST_CHECK(index == expected->end);
+    APP_CAN_TriggerFrameRelease();
+    TEST_CHECK(APP_CAN_TriggerFrameGet(&entry) == false);
+}
+
+static uint32_t WindowBytes(uint32_t from, uint32_t to)
+{
+    uint32_t bytes = 0U;
+
+    while (from < to)
+    {
+        bytes += frameSize[from++];
+    }
+    return bytes;
+}
+
+// *****************************************************************************
+// Section: Tests
+// *****************************************************************************
+
+/* ID trigger, with and without a payload pattern; a frame with the ID and
+   another payload in front of the trigger frame must not fire */
+static void TestFrameTrigger(void)
+{
+    APP_CAN_TRIGGER_CONFIG config;
+    EXPECTED expected;
+    uint32_t round = 0U;
+    uint32_t mark = 0U;
+    uint32_t wrapped = 0U;
+    bool pattern = false;
+
+    for (round = 0U; round < ROUNDS; round++)
+    {
+        pattern = ((round % 2U) != 0U);
+        memset(&config, 0, sizeof(config));
+        config.sources = APP_CAN_TRIGGER_SOURCE_FRAME;
+        config.idMatch = true;
+        config.id = TRIGGER_ID;
+        config.xtd = false;
+        if (pattern)
+        {
+            config.offset = 2U;
+            config.value[0] = 0x5AU;
+            config.mask[0] = 0xFFU;
+            config.value[1] = 0x03U;
+            config.mask[1] = 0x0FU;
+        }
+        config.postFrames = TEST_RandomBelow(60U);
+
+        Reset();
+        FramesRandom(TEST_RandomBelow(200U));
+        if (pattern)
+        {
+            FrameTriggerId(0x5AU, 0x04U);
+            FramesRandom(TEST_RandomBelow(5U));
+        }
+        mark = frameCount;
+        FrameTriggerId(0x5AU, 0x03U);
+        FramesRandom(config.postFrames + 5U);
+
+        APP_CAN_TriggerArm(&config);
+        expected = Expect(mark, config.postFrames + 1U);
+        TEST_CHECK(Feed(0U, frameCount) == expected.frozenAt);
+        WindowCheck(&expected, APP_CAN_TRIGGER_SOURCE_FRAME, frames[mark].timestamp);
+        if (WindowBytes(0U, expected.end) > (2U * APP_CAN_TRIGGER_BUFFER_SIZE))
+        {
+            wrapped++;
+        }
+    }
+    TEST_CHECK(wrapped > (ROUNDS / 4U));
+}
+
+/* A pin event at the time of a frame still to be recorded: the frames
+   received before it are pre trigger frames, also those recorded after the
+   event was reported */
+static void TestEventTrigger(void)
+{
+    APP_CAN_TRIGGER_CONFIG config;
+    EXPECTED expected;
+    uint32_t round = 0U;
+    uint32_t reported = 0U;
+    uint32_t mark = 0U;
+    uint32_t frozenAt = 0U;
+
+    for (round = 0U; round < ROUNDS; round++)
+    {
+        memset(&config, 0, sizeof(config));
+        config.sources = APP_CAN_TRIGGER_SOURCE_PIN;
+        config.postFrames = (TEST_RandomBelow(8U) == 0U) ? 0U : TEST_RandomBelow(60U);
+
+        Reset();
+        FramesRandom(TEST_RandomBelow(200U) + 10U + config.postFrames);
+        reported = TEST_RandomBelow(frameCount - config.postFrames - 5U);
+        mark = reported + TEST_RandomBelow(5U);
+
+        APP_CAN_TriggerArm(&config);
+        TEST_CHECK(Feed(0U, reported) == reported);
+        /* Sources not configured are ignored */
+        APP_CAN_TriggerEvent(APP_CAN_TRIGGER_SOURCE_ERROR, frames[reported].timestamp);
+        APP_CAN_TriggerEvent(APP_CAN_TRIGGER_SOURCE_PIN, frames[mark].timestamp);
+        /* Only the first event counts */
+        APP_CAN_TriggerEvent(APP_CAN_TRIGGER_SOURCE_PIN, frames[reported].timestamp);
+        TEST_CHECK(APP_CAN_TriggerStateGet() == APP_CAN_TRIGGER_STATE_ARMED);
+
+        expected = Expect(mark, config.postFrames);
+        frozenAt = Feed(reported, frameCount);
+        TEST_CHECK(frozenAt == expected.frozenAt);
+        WindowCheck(&expected, APP_CAN_TRIGGER_SOURCE_PIN, frames[mark].timestamp);
+    }
+}
+
+/* An event after the last frame received fires on APP_CAN_TriggerService,
+   in front of the next frame */
+static void TestServiceTrigger(void)
+{
+    APP_CAN_TRIGGER_CONFIG config;
+    EXPECTED expected;
+    uint32_t round = 0U;
+    uint32_t mark = 0U;
+    uint32_t eventTime = 0U;
+
+    for (round = 0U; round < ROUNDS; round++)
+    {
+        memset(&config, 0, sizeof(config));
+        config.sources = APP_CAN_TRIGGER_SOURCE_PIN;
+        config.postFrames = (TEST_RandomBelow(8U) == 0U) ? 0U : TEST_RandomBelow(60U);
+
+        Reset();
+        FramesRandom(TEST_RandomBelow(200U) + 1U);
+        mark = frameCount;
+        eventTime = frameTime + 1U;
+        FramesRandom(config.postFrames + 5U);
+
+        APP_CAN_TriggerArm(&config);
+        TEST_CHECK(Feed(0U, mark) == mark);
+        APP_CAN_TriggerEvent(APP_CAN_TRIGGER_SOURCE_PIN, eventTime);
+        APP_CAN_TriggerService();
+
+        expected = Expect(mark, config.postFrames);
+        if (config.postFrames == 0U)
+        {
+            TEST_CHECK(APP_CAN_TriggerStateGet() == APP_CAN_TRIGGER_STATE_FROZEN);
+        }
+        else
+        {
+            TEST_CHECK(APP_CAN_TriggerStateGet() == APP_CAN_TRIGGER_STATE_TRIGGERED);
+            TEST_CHECK(Feed(mark, frameCount) == expected.frozenAt);
+        }
+        WindowCheck(&expected, APP_CAN_TRIGGER_SOURCE_PIN, eventTime);
+    }
+}
+
+/* A change of the error state, not the first report, is an event */
+static void TestErrorTrigger(void)
+{
+    APP_CAN_TRIGGER_CONFIG config;
+    EXPECTED expected;
+    uint32_t mark = 0U;
+
+    memset(&config, 0, sizeof(config));
+    config.sources = APP_CAN_TRIGGER_SOURCE_ERROR;
+    config.postFrames = 10U;
+
+    Reset();
+    FramesRandom(100U);
+    mark = 60U;
+    APP_CAN_TriggerArm(&config);
+    APP_CAN_TriggerErrorStateUpdate(CAN_PSR_EW_Msk, frames[10].timestamp);
+    TEST_CHECK(Feed(0U, 40U) == 40U);
+    APP_CAN_TriggerErrorStateUpdate(CAN_PSR_EW_Msk, frames[40].timestamp);
+    TEST_CHECK(Feed(40U, 50U) == 50U);
+    APP_CAN_TriggerErrorStateUpdate(CAN_PSR_EW_Msk | CAN_PSR_EP_Msk, frames[mark].timestamp);
+    expected = Expect(mark, config.postFrames);
+    TEST_CHECK(Feed(50U, frameCount) == expected.frozenAt);
+    WindowCheck(&expected, APP_CAN_TRIGGER_SOURCE_ERROR, frames[mark].timestamp);
+}
+
+/* More post trigger frames than the window holds: it freezes full of
+   frames from the trigger on */
+static void TestPostOverflow(void)
+{
+    APP_CAN_TRIGGER_CONFIG config;
+    EXPECTED expected;
+    uint32_t round = 0U;
+    uint32_t mark = 0U;
+
+    for (round = 0U; round < 20U; round++)
+    {
+        memset(&config, 0, sizeof(config));
+        config.sources = APP_CAN_TRIGGER_SOURCE_FRAME;
+        config.idMatch = true;
+        config.id = TRIGGER_ID;
+        config.postFrames = 100000U;
+
+        Reset();
+        FramesRandom(TEST_RandomBelow(300U));
+        mark = frameCount;
+        FrameTriggerId(0U, 0U);
+        FramesRandom(FRAMES_MAX - frameCount);
+
+        APP_CAN_TriggerArm(&config);
+        expected = Expect(mark, config.postFrames + 1U);
+        TEST_CHECK(expected.end < frameCount);
+        TEST_CHECK(Feed(0U, frameCount) == expected.frozenAt);
+        WindowCheck(&expected, APP_CAN_TRIGGER_SOURCE_FRAME, frames[mark].timestamp);
+        TEST_CHECK(expected.pre == 0U);
+        TEST_CHECK((WindowBytes(expected.start, expected.end + 1U)) > APP_CAN_TRIGGER_BUFFER_SIZE);
+    }
+}
+
+/* Nothing is recorded unless armed, disarming discards the window */
+static void TestDisarm(void)
+{
+    APP_CAN_TRIGGER_CONFIG config;
+    APP_CAN_RING_ENTRY entry;
+
+    memset(&config, 0, sizeof(config));
+    config.sources = APP_CAN_TRIGGER_SOURCE_FRAME | APP_CAN_TRIGGER_SOURCE_PIN;
+    config.idMatch = true;
+    config.id = TRIGGER_ID;
+
+    APP_CAN_TriggerInitialize();
+    Reset();
+    FrameTriggerId(0U, 0U);
+    FramesRandom(10U);
+    TEST_CHECK(Feed(0U, frameCount) == frameCount);
+    APP_CAN_TriggerEvent(APP_CAN_TRIGGER_SOURCE_PIN, 0U);
+    APP_CAN_TriggerService();
+    TEST_CHECK(APP_CAN_TriggerStateGet() == APP_CAN_TRIGGER_STATE_IDLE);
+    TEST_CHECK(APP_CAN_TriggerFrameGet(&entry) == false);
+
+    APP_CAN_TriggerArm(&config);
+    TEST_CHECK(Feed(1U, frameCount) == frameCount);
+    TEST_CHECK(Feed(0U, 1U) == 0U);
+    APP_CAN_TriggerDisarm();
+    TEST_CHECK(APP_CAN_TriggerStateGet() == APP_CAN_TRIGGER_STATE_IDLE);
+    TEST_CHECK(APP_CAN_TriggerFrameGet(&entry) == false);
+}
+
+int main(void)
+{
+    TEST_RandomSeed(13U);
+    APP_CAN_TriggerInitialize();
+    TestFrameTrigger();
+    TestEventTrigger();
+    TestServiceTrigger();
+    TestErrorTrigger();
+    TestPostOverflow();
+    TestDisarm();
+
+    printf("test_trigger: %u failures\n", testFailures);
+    return TEST_RESULT();
+}
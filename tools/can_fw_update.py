@@ -0,0 +1,278 @@
+#!/usr/bin/env python3
+"""Upload a firmware image to the SAME51 BLE CAN Sniffer over the BLE link.
+
+The image is a raw binary of the application linked at address 0 (for
+example from xc32-objcopy -O binary). It is written into the inactive flash
+bank while the sniffer keeps capturing, checked with CRC-32 and made active by
+a bank swap, which resets the sniffer. See "Firmware Update" in README.md for
+the frame format. The serial port is the one of the BLE link on the host
+(requires pyserial). --simulate runs the transfer against a stand-in of the
+sniffer which loses bytes at the given rate, to check the protocol.
+
+    python can_fw_update.py --port COM7 sniffer.bin
+    python can_fw_update.py --no-swap --port COM7 sniffer.bin
+    python can_fw_update.py --simulate 0.01 sniffer.bin
+"""
+
+import argparse
+import random
+import struct
+import sys
+import time
+import zlib
+
+SYNC = b"\xA5\x5A"
+FRAME_START = 0x01
+FRAME_DATA = 0x02
+FRAME_END = 0x03
+FRAME_SWAP = 0x04
+FRAME_ABORT = 0x05
+FRAME_RESPONSE = 0x80
+DATA_MAX = 256
+IMAGE_MAX = 0x40000
+STATUS_OK = 0
+STATUS_STATE = 1
+STATUS_OFFSET = 2
+STATUS_LENGTH = 3
+STATUS_VERIFY = 4
+STATUS_NAME = ("ok", "not valid in this state", "unexpected offset", "size not valid", "verification failed")
+
+
+def crc16_ccitt_false(data):
+    crc = 0xFFFF
+    for byte in data:
+        crc ^= byte << 8
+        for _ in range(8):
+            crc = ((crc << 1) ^ 0x1021) if crc & 0x8000 else (crc << 1)
+            crc &= 0xFFFF
+    return crc
+
+
+def build_frame(frame_type, payload=b""):
+    body = struct.pack("<BH", frame_type, len(payload)) + payload
+    return SYNC + body + struct.pack("<H", crc16_ccitt_false(body))
+
+
+class FrameParser:
+    """Finds valid frames in a byte stream, other bytes are skipped."""
+
+    def __init__(self):
+        self.buffer = bytearray()
+
+    def feed(self, data):
+        self.buffer += data
+        frames = []
+        while True:
+            start = self.buffer.find(SYNC)
+            if start < 0:
+                del self.buffer[:max(0, len(self.buffer) - 1)]
+                return frames
+            del self.buffer[:start]
+            if len(self.buffer) < 5:
+                return frames
+            frame_type, length = struct.unpack_from("<BH", self.buffer, 2)
+            if length > 4 + DATA_MAX:
+                del self.buffer[:1]
+                continue
+            if len(self.buffer) < 7 + length:
+                return frames
+            body = bytes(self.buffer[2:5 + length])
+            crc, = struct.unpack_from("<H", self.buffer, 5 + length)
+            if crc != crc16_ccitt_false(body):
+                del self.buffer[:1]
+                continue
+            del self.buffer[:7 + length]
+            frames.append((frame_type, body[3:]))
+
+
+class SerialLink:
+    def __init__(self, port, baud):
+        import serial
+        self.serial = serial.Serial(port, baud, timeout=0.05)
+
+    def write(self, data):
+        self.serial.write(data)
+
+    def read(self):
+        return self.serial.read(4096)
+
+
+class SimulatedLink:
+    """Stand-in of the sniffer side: same states and answers as app_fw_update.c,
+    bytes are lost in both directions at the given rate."""
+
+    def __init__(self, loss, seed=1):
+        self.loss = loss
+        self.random = random.Random(seed)
+        self.parser = FrameParser()
+        self.output = bytearray()
+        self.flash = bytearray(b"\xFF" * IMAGE_MAX)
+        self.state = "idle"
+        self.size = 0
+        self.crc = 0
+        self.expected = 0
+        self.swapped = False
+
+    def lossy(self, data):
+        return bytes(b for b in data if self.random.random() >= self.loss)
+
+    def write(self, data):
+        for frame_type, payload in self.parser.feed(self.lossy(data)):
+            status = self.process(frame_type, payload)
+            response = build_frame(frame_type | FRAME_RESPONSE, struct.pack("<BI", status, self.expected))
+            self.output += self.lossy(response)
+
+    def read(self):
+        data = bytes(self.output)
+        self.output.clear()
+        if not data:
+            time.sleep(0.001)
+        return data
+
+    def process(self, frame_type, payload):
+        if self.state == "swapping":
+            return STATUS_STATE
+        if frame_type == FRAME_START:
+            size, crc = struct.unpack("<II", payload) if len(payload) == 8 else (0, 0)
+            if size == 0 or size > IMAGE_MAX:
+                return STATUS_LENGTH
+            self.state, self.size, self.crc, self.expected = "receiving", size, crc, 0
+            self.flash[:] = b"\xFF" * IMAGE_MAX
+            return STATUS_OK
+        if frame_type == FRAME_DATA:
+            if self.state != "receiving":
+                return STATUS_STATE
+            if len(payload) < 4 or struct.unpack_from("<I", payload)[0] != self.expected:
+                return STATUS_OFFSET
+            data = payload[4:]
+            end = self.expected + len(data)
+            if not data or end > self.size or (len(data) % 16 and end != self.size):
+                return STATUS_LENGTH
+            self.flash[self.expected:end] = data
+            self.expected = end
+            return STATUS_OK
+        if frame_type == FRAME_END:
+            if self.state == "verified":
+                return STATUS_OK
+            if self.state != "receiving" or self.expected != self.size:
+                return STATUS_STATE
+            if zlib.crc32(self.flash[:self.size]) != self.crc:
+                self.state = "idle"
+                return STATUS_VERIFY
+            self.state = "verified"
+            return STATUS_OK
+        if frame_type == FRAME_SWAP:
+            if self.state != "verified":
+                return STATUS_STATE
+            self.state = "swapping"
+            self.swapped = True
+            return STATUS_OK
+        if frame_type == FRAME_ABORT:
+            self.state = "idle"
+            return STATUS_OK
+        return STATUS_STATE
+
+
+class UpdateError(Exception):
+    pass
+
+
+class Uploader:
+    """Sends one frame at a time and waits for its answer, frames without an
+    answer are sent again."""
+
+    def __init__(self, link, timeout=1.0, retries=10):
+        self.link = link
+        self.timeout = timeout
+        self.retries = retries
+        self.parser = FrameParser()
+        self.resent = 0
+
+    def request(self, frame_type, payload=b"", timeout=None):
+        frame = build_frame(frame_type, payload)
+        for attempt in range(self.retries + 1):
+            if attempt:
+                self.resent += 1
+            # Answers to earlier attempts are stale
+            self.parser.feed(self.link.read())
+            self.parser.buffer.clear()
+            self.link.write(frame)
+            deadline = time.monotonic() + (timeout or self.timeout)
+            while time.monotonic() < deadline:
+                for response_type, response in self.parser.feed(self.link.read()):
+                    if response_type == frame_type | FRAME_RESPONSE and len(response) == 5:
+                        return struct.unpack("<BI", response)
+        raise UpdateError("no answer to frame type %d after %d attempts" % (frame_type, self.retries + 1))
+
+    def upload(self, image, swap=True, progress=None):
+        if not image or len(image) > IMAGE_MAX:
+            raise UpdateError("image size %d not in 1..%d" % (len(image), IMAGE_MAX))
+        status, _ = self.request(FRAME_START, struct.pack("<II", len(image), zlib.crc32(image)))
+        if status != STATUS_OK:
+            raise UpdateError("start refused: %s" % STATUS_NAME[status])
+        offset = 0
+        while offset < len(image):
+            status, expected = self.request(FRAME_DATA, struct.pack("<I", offset) + image[offset:offset + DATA_MAX])
+            if status not in (STATUS_OK, STATUS_OFFSET) or expected > len(image):
+                raise UpdateError("data at 0x%X refused: %s" % (offset, STATUS_NAME[status]))
+            # An offset answer after a lost response moves on as well
+            offset = expected
+            if progress:
+                progress(offset, len(image))
+        # The CRC of 256 KB takes a few milliseconds on the sniffer
+        status, _ = self.request(FRAME_END, timeout=self.timeout * 2)
+        if status != STATUS_OK:
+            raise UpdateError("image not accepted: %s" % STATUS_NAME[status])
+        if swap:
+            status, _ = self.request(FRAME_SWAP)
+            if status != STATUS_OK:
+                raise UpdateError("swap refused: %s" % STATUS_NAME[status])
+
+    def abort(self):
+        self.request(FRAME_ABORT)
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("image", help="raw binary firmware image")
+    parser.add_argument("--port", help="serial port of the BLE link")
+    parser.add_argument("--baud", type=int, default=115200)
+    parser.add_argument("--timeout", type=float, default=1.0, help="seconds to wait for an answer")
+    parser.add_argument("--retries", type=int, default=10)
+    parser.add_argument("--no-swap", action="store_true", help="write and verify the image only")
+    parser.add_argument("--abort", action="store_true", help="abandon an update in progress")
+    parser.add_argument("--simulate", type=float, metavar="LOSS",
+                        help="upload to a stand-in of the sniffer losing this fraction of bytes")
+    args = parser.parse_args()
+
+    if args.simulate is not None:
+        link = SimulatedLink(args.simulate)
+        args.timeout = min(args.timeout, 0.02)
+        args.retries = max(args.retries, 1000)
+    elif args.port:
+        link = SerialLink(args.port, args.baud)
+    else:
+        parser.error("--port or --simulate is required")
+    uploader = Uploader(link, args.timeout, args.retries)
+
+    try:
+        if args.abort:
+            uploader.abort()
+            return
+        with open(args.image, "rb") as stream:
+            image = stream.read()
+        started = time.monotonic()
+        uploader.upload(image, not args.no_swap,
+                        lambda done, total: print("\r%d of %d bytes" % (done, total), end="", flush=True))
+        print("\n%s, %d frames sent again, %.1f s" % (
+            "Image verified" if args.no_swap else "Image verified, banks swapped",
+            uploader.resent, time.monotonic() - started))
+        if args.simulate is not None and (link.flash[:len(image)] != image or link.swapped == args.no_swap):
+            raise UpdateError("stand-in image differs")
+    except UpdateError as error:
+        print("\nUpdate failed: %s" % error, file=sys.stderr)
+        sys.exit(1)
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,259 @@
+#!/usr/bin/env python3
+"""Decode the binary CAN record stream of the SAME51 BLE CAN Sniffer.
+
+Reads the stream from a serial port (requires pyserial) or from a file / stdin
+and prints one candump-like line per record. Both full and delta encoded
+records are understood. See "Binary Record Stream" in README.md for the
+record format. With --flash, a raw dump of the flash recorder ("Flash
+Recorder" in README.md) is decoded instead.
+
+    python can_record_decode.py --port COM5
+    python can_record_decode.py capture.bin
+    python can_record_decode.py --stats capture.bin
+    python can_record_decode.py --flash flashdump.bin
+"""
+
+import re
+
+import argparse
+import struct
+import sys
+
+DLC_LENGTH = (0, 1, 2, 3, 4, 5, 6, 7, 8, 12, 16, 20, 24, 32, 48, 64)
+HEADER_SIZE = 9
+TYPE_FULL = 0
+TYPE_DELTA = 1
+TYPE_STATS = 2
+STATS_FIELDS = ("count", "bytes", "min", "avg", "max", "jitter", "fd", "brs", "esi", "rtr")
+BIT_TIME_US = 2.0  # timestamp unit, the nominal bit time at 500 kbit/s
+FLASH_PAGE_SIZE = 512
+FLASH_PAGE_HEADER = struct.Struct("<IIIHBBHH")
+FLASH_PAGE_MAGIC = 0x4C4E4143
+
+
+def crc16_ccitt_false(data):
+    crc = 0xFFFF
+    for byte in data:
+        crc ^= byte << 8
+        for _ in range(8):
+            crc = ((crc << 1) ^ 0x1021) if crc & 0x8000 else (crc << 1)
+            crc &= 0xFFFF
+    return crc
+
+
+def cobs_decode(frame):
+    out = bytearray()
+    index = 0
+    while index < len(frame):
+        code = frame[index]
+        if code == 0 or index + code > len(frame):
+            return None
+        out += frame[index + 1:index + code]
+        index += code
+        if code != 0xFF and index < len(frame):
+            out.append(0)
+    return bytes(out)
+
+
+def parse_record(raw, payloads):
+    """Returns a dict for a valid record, None otherwise.
+
+    payloads maps (ID, XTD) to the payload of the last full record
+    (keyframe), delta records are applied on top of it. The CRC of a delta
+    record also covers the payload it rebuilds: when it does not match, the
+    record was corrupted or the last keyframe was lost, and the ID is dropped
+    until its next keyframe.
+    """
+    if len(raw) < HEADER_SIZE + 2:
+        return None
+    body, crc = raw[:-2], struct.unpack("<H", raw[-2:])[0]
+    if len(body) < HEADER_SIZE:
+        return None
+    timestamp, id_word, dlc_flags = struct.unpack("<IIB", body[:HEADER_SIZE])
+    dlc = dlc_flags & 0x0F
+    rtr = bool(id_word & (1 << 30))
+    kind = dlc_flags >> 6
+    length = 0 if rtr else DLC_LENGTH[dlc]
+    key = (id_word & 0x1FFFFFFF, bool(id_word & (1 << 29)))
+    data = body[HEADER_SIZE:]
+    if kind != TYPE_DELTA and crc16_ccitt_false(body) != crc:
+        return None
+    if kind == TYPE_STATS:
+        if len(data) != 4 * len(STATS_FIELDS):
+            return None
+        return {
+            "timestamp": timestamp,
+            "id": key[0],
+            "xtd": key[1],
+            "stats": dict(zip(STATS_FIELDS, struct.unpack("<%dI" % len(STATS_FIELDS), data))),
+        }
+    if kind == TYPE_DELTA:
+        base = payloads.get(key)
+        bitmap_length = (length + 7) // 8
+        if base is None or len(base) != length or len(data) < bitmap_length:
+            # No keyframe seen yet for this ID
+            return None
+        bitmap, changed = data[:bitmap_length], iter(data[bitmap_length:])
+        data = bytearray(base)
+        try:
+            for index in range(length):
+                if bitmap[index >> 3] & (1 << (index & 7)):
+                    data[index] = next(changed)
+        except StopIteration:
+            return None
+        if next(changed, None) is not None:
+            return None
+        data = bytes(data)
+        if crc16_ccitt_false(body + data) != crc:
+            del payloads[key]
+            return None
+    elif kind != TYPE_FULL or len(data) != length:
+        return None
+    else:
+        payloads[key] = data
+    return {
+        "timestamp": timestamp,
+        "id": id_word & 0x1FFFFFFF,
+        "xtd": bool(id_word & (1 << 29)),
+        "rtr": rtr,
+        "esi": bool(id_word & (1 << 31)),
+        "dlc": dlc,
+        "brs": bool(dlc_flags & 0x10),
+        "fdf": bool(dlc_flags & 0x20),
+        "delta": kind == TYPE_DELTA,
+        "data": data,
+    }
+
+
+def parse_flash(image):
+    """Yields the records of a raw flash recorder dump, oldest page first.
+
+    The dump may start with the "[FLASH] Raw dump of <n> bytes" line. Pages
+    which are erased, cut short or hold a block summary are skipped.
+    """
+    match = re.search(rb"\[FLASH\] Raw dump of (\d+) bytes\r\n", image)
+    if match:
+        image = image[match.end():match.end() + int(match.group(1))]
+    pages = []
+    for offset in range(0, len(image) - FLASH_PAGE_SIZE + 1, FLASH_PAGE_SIZE):
+        page = image[offset:offset + FLASH_PAGE_SIZE]
+        magic, sequence, _, length, _, _, crc, _ = FLASH_PAGE_HEADER.unpack_from(page)
+        end = FLASH_PAGE_HEADER.size + length
+        if magic != FLASH_PAGE_MAGIC or end > FLASH_PAGE_SIZE:
+            continue
+        header = bytearray(page[:FLASH_PAGE_HEADER.size])
+        header[16:18] = b"\0\0"
+        if crc16_ccitt_false(bytes(header) + page[FLASH_PAGE_HEADER.size:end]) != crc:
+            continue
+        pages.append((sequence, page[FLASH_PAGE_HEADER.size:end]))
+    for _, data in sorted(pages):
+        offset = 0
+        while offset + HEADER_SIZE <= len(data):
+            id_word, dlc_flags = struct.unpack_from("<IB", data, offset + 4)
+            length = 0 if id_word & (1 << 30) else DLC_LENGTH[dlc_flags & 0x0F]
+            raw = data[offset:offset + HEADER_SIZE + length]
+            offset += len(raw)
+            record = parse_record(raw + struct.pack("<H", crc16_ccitt_false(raw)), {})
+            if record is not None:
+                yield record
+
+
+class Decoder:
+    """Splits a byte stream on 0x00 delimiters and yields decoded records."""
+
+    def __init__(self):
+        self.buffer = bytearray()
+        self.payloads = {}
+        self.errors = 0
+        self.records = 0
+        self.stream_bytes = 0
+        self.full_bytes = 0
+
+    def feed(self, chunk):
+        for byte in chunk:
+            if byte != 0:
+                self.buffer.append(byte)
+                continue
+            frame, self.buffer = bytes(self.buffer), bytearray()
+            if not frame:
+                continue
+            raw = cobs_decode(frame)
+            record = parse_record(raw, self.payloads) if raw is not None else None
+            if record is None:
+                # Text output interleaved with records, a corrupted record,
+                # or a delta record without its keyframe
+                self.errors += 1
+                continue
+            if "stats" in record:
+                yield record
+                continue
+            self.records += 1
+            # Both delimiters, the COBS code byte, header, payload and CRC
+            self.stream_bytes += len(frame) + 2
+            self.full_bytes += HEADER_SIZE + len(record["data"]) + 2 + 3
+            yield record
+
+
+def format_record(record):
+    can_id = ("%08X" if record["xtd"] else "%03X") % record["id"]
+    if "stats" in record:
+        stats = dict(record["stats"])
+        for field in ("min", "avg", "max", "jitter"):
+            stats[field] = "%.0fus" % (stats[field] * BIT_TIME_US)
+        return "(%12.6f) S %s %s" % (record["timestamp"] * BIT_TIME_US / 1e6, can_id,
+                                     " ".join("%s=%s" % (f, stats[f]) for f in STATS_FIELDS))
+    flags = "".join(flag for flag, on in (("F", record["fdf"]), ("B", record["brs"]),
+                                          ("E", record["esi"]), ("R", record["rtr"])) if on)
+    return "(%12.6f) %s %s [%2d] %-4s %s" % (
+        record["timestamp"] * BIT_TIME_US / 1e6, "D" if record["delta"] else " ", can_id,
+        len(record["data"]), flags, record["data"].hex(" ").upper())
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("input", nargs="?", help="capture file (default: stdin)")
+    parser.add_argument("--port", help="serial port to read from")
+    parser.add_argument("--baud", type=int, default=115200)
+    parser.add_argument("--stats", action="store_true",
+                        help="print only the size of the stream versus full records")
+    parser.add_argument("--flash", action="store_true",
+                        help="decode a raw flash recorder dump file")
+    args = parser.parse_args()
+
+    if args.flash:
+        with (open(args.input, "rb") if args.input else sys.stdin.buffer) as stream:
+            for record in parse_flash(stream.read()):
+                print(format_record(record))
+        return
+
+    if args.port:
+        import serial
+        stream = serial.Serial(args.port, args.baud, timeout=0.1)
+        read = lambda: stream.read(4096)
+    else:
+        stream = open(args.input, "rb") if args.input else sys.stdin.buffer
+        read = lambda: stream.read1(4096) if hasattr(stream, "read1") else stream.read(4096)
+
+    decoder = Decoder()
+    try:
+        while True:
+            chunk = read()
+            if not chunk:
+                if args.port:
+                    continue
+                break
+            for record in decoder.feed(chunk):
+                if not args.stats:
+                    print(format_record(record), flush=True)
+    except KeyboardInterrupt:
+        pass
+    if args.stats and decoder.stream_bytes:
+        print("%d records, %d bytes received, %d bytes as full records (%.2fx)" % (
+            decoder.records, decoder.stream_bytes, decoder.full_bytes,
+            decoder.full_bytes / decoder.stream_bytes))
+    if decoder.errors:
+        print("%d frames discarded" % decoder.errors, file=sys.stderr)
+
+
+if __name__ == "__main__":
+    main()
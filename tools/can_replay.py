@@ -0,0 +1,168 @@
+#!/usr/bin/env python3
+"""Replay a recorded CAN trace through the SAME51 BLE CAN Sniffer.
+
+Reads a binary record capture (see can_record_decode.py) or, with --flash, a
+raw flash recorder dump, and streams its frames as full records to the debug
+link of the sniffer, which retransmits them on the bus with their original
+inter-frame timing. Records are sent ahead of their transmission time by at
+most --lead seconds, so the queue of the sniffer never overflows. The timing
+error reported by the sniffer for every frame is printed as it arrives. See
+"Trace Replay" in README.md. --output writes the stream to a file instead.
+
+    python can_replay.py --port COM5 capture.bin
+    python can_replay.py --port COM5 --flash flashdump.bin
+    python can_replay.py --output stream.bin capture.bin
+"""
+
+import argparse
+import struct
+import sys
+import time
+
+from can_record_decode import BIT_TIME_US, DLC_LENGTH, Decoder, crc16_ccitt_false, parse_flash
+
+TYPE_FULL = 0
+TYPE_END = 3
+START_DELAY = 0.1  # APP_CAN_REPLAY_START_MS
+STREAM_TIMEOUT = 2.0  # APP_CAN_REPLAY_STREAM_TIMEOUT_MS
+
+
+def cobs_encode(data):
+    out = bytearray()
+    block = bytearray()
+    for byte in data:
+        if byte == 0:
+            out.append(len(block) + 1)
+            out += block
+            block.clear()
+            continue
+        block.append(byte)
+        if len(block) == 0xFE:
+            out.append(0xFF)
+            out += block
+            block.clear()
+    out.append(len(block) + 1)
+    out += block
+    return bytes(out)
+
+
+def encode_record(timestamp, id_word=0, dlc_flags=0, data=b""):
+    raw = struct.pack("<IIB", timestamp & 0xFFFFFFFF, id_word, dlc_flags) + data
+    return b"\0" + cobs_encode(raw + struct.pack("<H", crc16_ccitt_false(raw))) + b"\0"
+
+
+def encode_frame(record):
+    id_word = record["id"] | (record["xtd"] << 29) | (record["rtr"] << 30) | (record["esi"] << 31)
+    dlc_flags = record["dlc"] | (record["brs"] << 4) | (record["fdf"] << 5) | (TYPE_FULL << 6)
+    data = b"" if record["rtr"] else record["data"].ljust(DLC_LENGTH[record["dlc"]], b"\0")
+    return encode_record(record["timestamp"], id_word, dlc_flags, data)
+
+
+def load_trace(path, flash):
+    with open(path, "rb") as stream:
+        content = stream.read()
+    if flash:
+        return list(parse_flash(content))
+    # Delta records are expanded by the decoder, statistics records are skipped
+    return [record for record in Decoder().feed(content) if "stats" not in record]
+
+
+class SerialLink:
+    def __init__(self, port, baud):
+        import serial
+        self.serial = serial.Serial(port, baud, timeout=0)
+
+    def write(self, data):
+        self.serial.write(data)
+
+    def read(self):
+        return self.serial.read(4096)
+
+
+class FileLink:
+    def __init__(self, path):
+        self.stream = open(path, "wb")
+
+    def write(self, data):
+        self.stream.write(data)
+
+    def read(self):
+        return b""
+
+
+class Output:
+    """Prints the complete text lines received from the sniffer."""
+
+    def __init__(self, link):
+        self.link = link
+        self.buffer = b""
+        self.done = False
+
+    def poll(self):
+        self.buffer += self.link.read()
+        *lines, self.buffer = self.buffer.split(b"\n")
+        for line in lines:
+            text = line.decode("ascii", "replace").strip()
+            if text.startswith("[REPLAY]"):
+                print(text, flush=True)
+                self.done = self.done or text.startswith("[REPLAY] Replay idle")
+
+
+def replay(link, trace, lead, paced=True):
+    output = Output(link)
+    # Menu command and its argument line, the stream starts at the first 0x00
+    link.write(b"P")
+    time.sleep(0.05 if paced else 0)
+    link.write(b"stream\r")
+    time.sleep(0.1 if paced else 0)
+    output.poll()
+
+    origin = trace[0]["timestamp"]
+    started = time.monotonic()
+    for record in trace:
+        due = ((record["timestamp"] - origin) & 0xFFFFFFFF) * BIT_TIME_US / 1e6
+        while paced and time.monotonic() - started < due + START_DELAY - lead:
+            output.poll()
+            time.sleep(0.001)
+        link.write(encode_frame(record))
+    link.write(encode_record(trace[-1]["timestamp"], dlc_flags=TYPE_END << 6))
+
+    if not paced:
+        return
+    # Results keep coming until the last frame has been sent
+    deadline = time.monotonic() + START_DELAY + lead + STREAM_TIMEOUT
+    while not output.done and time.monotonic() < deadline:
+        output.poll()
+        time.sleep(0.01)
+    output.poll()
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("input", help="binary record capture, or raw flash dump with --flash")
+    parser.add_argument("--flash", action="store_true", help="input is a raw flash recorder dump")
+    parser.add_argument("--port", help="serial port of the debug link")
+    parser.add_argument("--baud", type=int, default=115200)
+    parser.add_argument("--lead", type=float, default=0.05,
+                        help="seconds a record is sent ahead of its transmission, below %.1f" % START_DELAY)
+    parser.add_argument("--output", help="write the stream to this file instead of a serial port")
+    args = parser.parse_args()
+
+    if not 0 <= args.lead < START_DELAY:
+        parser.error("--lead must be at least 0 and below %.1f" % START_DELAY)
+    trace = load_trace(args.input, args.flash)
+    if not trace:
+        print("No frames in %s" % args.input, file=sys.stderr)
+        sys.exit(1)
+    if args.output:
+        replay(FileLink(args.output), trace, args.lead, paced=False)
+    elif args.port:
+        replay(SerialLink(args.port, args.baud), trace, args.lead)
+    else:
+        parser.error("--port or --output is required")
+    print("%d frames streamed, %.3f s of trace" % (
+        len(trace), ((trace[-1]["timestamp"] - trace[0]["timestamp"]) & 0xFFFFFFFF) * BIT_TIME_US / 1e6))
+
+
+if __name__ == "__main__":
+    main()